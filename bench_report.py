@@ -0,0 +1,104 @@
+"""
+Report of the benchmarks in test/test_bench, checked against a baseline.
+
+The benchmarks print a line per function to the test output (See test/test_bench/bench.h):
+
+    BENCH,<name>,<calls>,<nanoseconds per call>,<CPU cycles per call>
+
+This collects those lines into a JSON report, and optionally compares the cycles per call with a previously saved
+report. It fails if any function is slower than its baseline by more than the tolerance, or is missing, so that a
+performance regression stops a firmware update in CI:
+
+    pio test -e megaatmega2560_sim_unittest -f test_bench -v > bench_output.txt
+    python bench_report.py bench_output.txt --baseline bench_baseline.json --tolerance 5
+
+Use --save to write the report, eg to record a new baseline.
+"""
+
+import argparse
+import json
+import re
+import sys
+
+BENCH_RE = re.compile(r"BENCH,([A-Za-z0-9_]+),(\d+),(\d+),(\d+(?:\.\d+)?)")
+
+
+def parse_results(lines):
+    """Returns a dict of name -> {calls, ns, cycles} for every BENCH line"""
+    results = {}
+    for line in lines:
+        match = BENCH_RE.search(line)
+        if match is None:
+            continue
+        results[match.group(1)] = {
+            "calls": int(match.group(2)),
+            "ns": int(match.group(3)),
+            "cycles": float(match.group(4)),
+        }
+    return results
+
+
+def print_results(results, baseline):
+    print("%-30s %10s %12s %10s" % ("Function", "ns/call", "cycles/call", "change"))
+    for name in sorted(results):
+        result = results[name]
+        change = ""
+        if baseline is not None and name in baseline and baseline[name]["cycles"] > 0:
+            change = "%+.1f%%" % (((result["cycles"] / baseline[name]["cycles"]) - 1.0) * 100.0)
+        print("%-30s %10d %12.2f %10s" % (name, result["ns"], result["cycles"], change))
+    print("")
+
+
+def check_baseline(results, baseline, tolerance):
+    """Returns True if no function is missing or slower than the baseline by more than tolerance percent"""
+    passed = True
+    for name in sorted(baseline):
+        if name not in results:
+            print("%s is in the baseline but was not benchmarked" % name)
+            passed = False
+            continue
+        limit = baseline[name]["cycles"] * (1.0 + (tolerance / 100.0))
+        if results[name]["cycles"] > limit:
+            print("%s takes %.2f cycles, above the limit of %.2f (Baseline %.2f +%g%%)"
+                  % (name, results[name]["cycles"], limit, baseline[name]["cycles"], tolerance))
+            passed = False
+    return passed
+
+
+def bench_report(output, baseline_file, tolerance, save_file):
+    """Prints the report and returns 0 if within the baseline, 1 otherwise"""
+    results = parse_results(output)
+    if not results:
+        print("No benchmark results found")
+        return 1
+
+    baseline = None
+    if baseline_file is not None:
+        with open(baseline_file) as f:
+            baseline = json.load(f)
+    print_results(results, baseline)
+
+    if save_file is not None:
+        with open(save_file, "w") as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+            f.write("\n")
+
+    if baseline is not None and not check_baseline(results, baseline, tolerance):
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Report of the test_bench benchmarks, checked against a baseline")
+    parser.add_argument("output", nargs="?", default="-", help="Test output to read (Default is stdin)")
+    parser.add_argument("--baseline", default=None, help="Report to compare the cycles per call against")
+    parser.add_argument("--tolerance", type=float, default=5.0, help="Allowed increase over the baseline (Percent)")
+    parser.add_argument("--save", default=None, help="Write the report (JSON) to this file")
+    args = parser.parse_args()
+
+    if args.output == "-":
+        lines = sys.stdin.readlines()
+    else:
+        with open(args.output) as f:
+            lines = f.readlines()
+    sys.exit(bench_report(lines, args.baseline, args.tolerance, args.save))
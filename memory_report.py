@@ -0,0 +1,156 @@
+"""
+Per symbol RAM and flash usage report for a firmware ELF.
+
+As a PlatformIO extra script this adds a 'memreport' target to the environment:
+
+    pio run -e megaatmega2560 -t memreport
+
+The limits are set (in bytes) by the custom_max_ram and custom_max_flash options of the environment. The
+target fails if the static RAM (.data + .bss) or flash (code, constants and the .data initial values) is above
+its limit, so that CI catches a change that leaves too little RAM for the stack.
+
+It can also be run directly on an ELF:
+
+    python memory_report.py .pio/build/megaatmega2560/firmware.elf --tool-prefix avr- --max-ram 7000
+"""
+
+import argparse
+import re
+import subprocess
+import sys
+
+TOP_SYMBOLS = 25
+# Allocated sections that are neither RAM nor program flash (AVR EEPROM and fuse settings)
+IGNORED_SECTIONS = (".eeprom", ".fuse", ".lock", ".signature", ".user_signatures")
+
+# objdump -h prints the section flags on the line after the section
+SECTION_RE = re.compile(r"^\s*\d+\s+(\S+)\s+([0-9a-fA-F]+)\s+([0-9a-fA-F]+)\s+([0-9a-fA-F]+)\s+([0-9a-fA-F]+)")
+# nm -S: address size type name
+SYMBOL_RE = re.compile(r"^([0-9a-fA-F]+)\s+([0-9a-fA-F]+)\s+(\S)\s+(.+)$")
+
+
+def read_sections(objdump, elf):
+    """Returns a list of (name, start, end, ram, flash) for every allocated section"""
+    lines = subprocess.check_output([objdump, "-h", elf], universal_newlines=True).splitlines()
+    sections = []
+    for index, line in enumerate(lines):
+        match = SECTION_RE.match(line)
+        if match is None or index + 1 >= len(lines):
+            continue
+        flags = lines[index + 1]
+        if "ALLOC" not in flags:
+            continue
+        name = match.group(1)
+        if name in IGNORED_SECTIONS:
+            continue
+        size = int(match.group(2), 16)
+        start = int(match.group(3), 16)
+        readonly = "READONLY" in flags
+        loaded = "LOAD" in flags
+        # Writable sections are in RAM. Those that are loaded (eg .data) also hold their initial values in flash
+        sections.append((name, start, start + size, not readonly, loaded))
+    return sections
+
+
+def read_symbols(nm, elf):
+    lines = subprocess.check_output([nm, "-S", "-C", "--size-sort", elf], universal_newlines=True).splitlines()
+    symbols = []
+    for line in lines:
+        match = SYMBOL_RE.match(line)
+        if match is None:
+            continue
+        symbols.append((int(match.group(1), 16), int(match.group(2), 16), match.group(4)))
+    return symbols
+
+
+def section_of(sections, address):
+    for section in sections:
+        if section[1] <= address < section[2]:
+            return section
+    return None
+
+
+def build_report(elf, tool_prefix):
+    sections = read_sections(tool_prefix + "objdump", elf)
+    ram_total = sum(end - start for (_, start, end, ram, _) in sections if ram)
+    flash_total = sum(end - start for (_, start, end, ram, loaded) in sections if (not ram) or loaded)
+
+    ram_symbols = []
+    flash_symbols = []
+    for (address, size, name) in read_symbols(tool_prefix + "nm", elf):
+        section = section_of(sections, address)
+        if section is None:
+            continue
+        if section[3]:
+            ram_symbols.append((size, name, section[0]))
+        else:
+            flash_symbols.append((size, name, section[0]))
+    ram_symbols.sort(reverse=True)
+    flash_symbols.sort(reverse=True)
+    return ram_total, flash_total, ram_symbols, flash_symbols
+
+
+def print_symbols(title, total, symbols):
+    print("%s: %d bytes" % (title, total))
+    for (size, name, section) in symbols[:TOP_SYMBOLS]:
+        print("  %7d  %-10s %s" % (size, section, name))
+    print("")
+
+
+def check_limit(title, total, limit):
+    if limit is None:
+        return True
+    if total > limit:
+        print("%s usage of %d bytes is above the limit of %d bytes" % (title, total, limit))
+        return False
+    print("%s usage of %d bytes is within the limit of %d bytes (%d free)" % (title, total, limit, limit - total))
+    return True
+
+
+def memory_report(elf, tool_prefix, max_ram, max_flash):
+    """Prints the report and returns 0 if within the limits, 1 otherwise"""
+    ram_total, flash_total, ram_symbols, flash_symbols = build_report(elf, tool_prefix)
+    print_symbols("RAM (static)", ram_total, ram_symbols)
+    print_symbols("Flash", flash_total, flash_symbols)
+    ram_ok = check_limit("RAM", ram_total, max_ram)
+    flash_ok = check_limit("Flash", flash_total, max_flash)
+    return 0 if (ram_ok and flash_ok) else 1
+
+
+def optional_int(value):
+    if value is None or str(value).strip() == "":
+        return None
+    return int(str(value).strip(), 0)
+
+
+try:
+    Import("env")  # noqa: F821 - Provided by PlatformIO
+except NameError:
+    env = None
+
+if env is not None:
+    def memreport_action(*args, **kwargs):
+        # The toolchain prefix (eg 'avr-' or 'arm-none-eabi-') is taken from the compiler name
+        tool_prefix = re.sub(r"g?cc$", "", env.subst("$CC"))
+        elf = env.subst("$BUILD_DIR/${PROGNAME}.elf")
+        result = memory_report(elf, tool_prefix,
+                               optional_int(env.GetProjectOption("custom_max_ram", None)),
+                               optional_int(env.GetProjectOption("custom_max_flash", None)))
+        if result != 0:
+            env.Exit(result)
+
+    env.AddCustomTarget(
+        name="memreport",
+        dependencies="$BUILD_DIR/${PROGNAME}.elf",
+        actions=[memreport_action],
+        title="Memory report",
+        description="Per symbol RAM and flash usage, checked against custom_max_ram and custom_max_flash")
+
+elif __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Per symbol RAM and flash usage report for a firmware ELF")
+    parser.add_argument("elf")
+    parser.add_argument("--tool-prefix", default="", help="Toolchain prefix, eg avr- or arm-none-eabi-")
+    parser.add_argument("--max-ram", type=optional_int, default=None, help="Static RAM limit in bytes")
+    parser.add_argument("--max-flash", type=optional_int, default=None, help="Flash limit in bytes")
+    args = parser.parse_args()
+    sys.exit(memory_report(args.elf, args.tool_prefix, args.max_ram, args.max_flash))
@@ -0,0 +1,274 @@
+"""
+Generates the realtime data (output channel) tables from the single channel definition in
+speeduino/output_channels.csv:
+
+    speeduino/logger_channels.h    Sizes of the packet and the logs
+    speeduino/logger_channels.cpp  The tables used by getTSLogEntry(), getReadableLogEntry() and the SD log header
+    reference/speeduino.ini        The byte channels of the [OutputChannels] section, between the generated markers
+
+After changing the csv file, regenerate with:
+
+    python output_channels.py
+
+With --check nothing is written and the script fails if any of the generated files are out of date. As a PlatformIO
+extra script it runs this check before every build, so a build can never use tables that don't match the ini file.
+
+The csv columns are:
+    kind       channel: A value in the packet with a scalar entry in the ini file
+               hidden: A value in the packet that only has bits entries in the ini file
+               bits: A bits entry in the ini file for the channel above it
+               gap: An unused field in the readable log that has no bytes in the packet
+    name       ini channel name
+    type       ini data type (U08, S08, U16, S16). This sets the number of bytes in the packet
+    bits       Bit range of a bits entry, eg [0:3]
+    source     The variable that the channel is read from. Empty for a channel that is always 0
+    transform  How the value is changed for the packet (none, temperature, half, div100, loops or freeram)
+    units, scale, translate  ini scalar entry fields. Units starting with { are an expression and are not quoted
+    log        SD log header. Empty if the channel is not in the readable log, - if it is in the readable log but not the SD log
+    divisor    The value is divided by this in the floating point readable log
+    comment    Added to the ini entry
+"""
+
+import argparse
+import csv
+import io
+import os
+import sys
+
+CHANNEL_TYPES = {"U08": 1, "S08": 1, "U16": 2, "S16": 2}
+TRANSFORMS = ("none", "temperature", "half", "div100", "loops", "freeram")
+KINDS = ("channel", "hidden", "bits", "gap")
+
+INI_BEGIN = "  ; The channels from here to the end marker are generated from speeduino/output_channels.csv by output_channels.py. Do not edit them here"
+INI_END = "  ; End of generated output channels"
+
+GENERATED_NOTICE = "Generated from output_channels.csv by output_channels.py. Do not edit, change the csv file and regenerate"
+
+
+class Channel(object):
+    def __init__(self, row, line):
+        self.line = line
+        self.kind = row["kind"]
+        self.name = row["name"]
+        self.type = row["type"]
+        self.source = row["source"]
+        self.transform = row["transform"] or "none"
+        self.units = row["units"]
+        self.scale = row["scale"]
+        self.translate = row["translate"]
+        self.log = row["log"]
+        self.divisor = row["divisor"]
+        self.comment = row["comment"]
+        self.size = CHANNEL_TYPES.get(self.type, 0) if self.kind != "gap" else 0
+        self.offset = 0
+        self.bits = []
+
+
+def fail(line, message):
+    raise ValueError("output_channels.csv line %d: %s" % (line, message))
+
+
+def read_channels(path):
+    """Returns the list of packet channels (including log gaps), each with its bits entries"""
+    channels = []
+    with io.open(path, encoding="utf-8", newline="") as csv_file:
+        for line, row in enumerate(csv.DictReader(csv_file), start=2):
+            kind = row["kind"]
+            if kind not in KINDS:
+                fail(line, "unknown kind '%s'" % kind)
+            if kind == "bits":
+                if not channels or channels[-1].kind == "gap":
+                    fail(line, "bits entry '%s' is not after a channel" % row["name"])
+                channels[-1].bits.append(row)
+                continue
+            channel = Channel(row, line)
+            if kind != "gap" and channel.size == 0:
+                fail(line, "unknown type '%s'" % channel.type)
+            if channel.transform not in TRANSFORMS:
+                fail(line, "unknown transform '%s'" % channel.transform)
+            channels.append(channel)
+
+    offset = 0
+    readable_ended = False
+    sd_ended = False
+    for channel in channels:
+        channel.offset = offset
+        offset += channel.size
+        # The readable and SD logs are indexed by channel number, so their channels must come first
+        readable = (channel.kind == "gap") or (channel.log != "")
+        sd = readable and (channel.log != "-")
+        if readable and readable_ended:
+            fail(channel.line, "'%s' is in the readable log after a channel that is not" % channel.name)
+        if sd and sd_ended:
+            fail(channel.line, "'%s' is in the SD log after a channel that is not" % channel.name)
+        readable_ended = readable_ended or not readable
+        sd_ended = sd_ended or not sd
+        channel.readable = readable
+        channel.sd = sd
+    if offset > 256 or len(channels) > 255:
+        raise ValueError("output_channels.csv: the packet must be at most 256 bytes and 255 channels")
+    return channels
+
+
+def c_string(value):
+    return '"' + value.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def generate_header(channels):
+    packet_size = sum(channel.size for channel in channels)
+    divisors = [channel for channel in channels if channel.readable and channel.divisor]
+    lines = [
+        "/** \\file logger_channels.h",
+        " * @brief Sizes of the output channel tables. " + GENERATED_NOTICE,
+        " */",
+        "#ifndef LOGGER_CHANNELS_H",
+        "#define LOGGER_CHANNELS_H",
+        "",
+        "#define LOG_CHANNEL_BYTES       %d /**< The size of the TunerStudio realtime data packet (ochBlockSize) */" % packet_size,
+        "#define LOG_CHANNEL_COUNT       %d" % len(channels),
+        "#define LOG_READABLE_FIELDS     %d /**< The first channels are the readable log, in order */" % sum(1 for channel in channels if channel.readable),
+        "#define LOG_SD_FIELDS           %d /**< The first readable log fields are written to the SD log */" % sum(1 for channel in channels if channel.sd),
+        "#define LOG_FLOAT_DIVISOR_COUNT %d" % len(divisors),
+        "",
+        "#endif // LOGGER_CHANNELS_H",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def generate_source(channels):
+    lines = [
+        "// " + GENERATED_NOTICE,
+        "#include \"globals.h\"",
+        "#include BOARD_H //Must be before logger.h for SD_LOGGING",
+        "#include \"logger.h\"",
+        "",
+        "const log_channel_t logChannels[LOG_CHANNEL_COUNT] PROGMEM = {",
+    ]
+    for channel in channels:
+        transform = "LOG_TRANSFORM_" + channel.transform.upper()
+        if channel.source:
+            entry = "LOG_CHANNEL(%s, %s, %d, %d)" % (channel.source, transform, channel.offset, channel.size)
+        else:
+            entry = "LOG_CHANNEL_ZERO(%d, %d)" % (channel.offset, channel.size)
+        lines.append("  %s, //%s" % (entry, channel.name if channel.kind != "gap" else "Unused"))
+    lines.append("};")
+    lines.append("")
+
+    channel_bytes = []
+    for index, channel in enumerate(channels):
+        channel_bytes += [str(index)] * channel.size
+    lines.append("const uint8_t logChannelBytes[LOG_CHANNEL_BYTES] PROGMEM = {")
+    for start in range(0, len(channel_bytes), 20):
+        lines.append("  " + ", ".join(channel_bytes[start:start + 20]) + ",")
+    lines.append("};")
+    lines.append("")
+
+    lines.append("#if defined(FPU_MAX_SIZE) && FPU_MAX_SIZE >= 32 //cppcheck-suppress misra-c2012-20.9")
+    lines.append("const log_float_divisor_t logFloatDivisors[LOG_FLOAT_DIVISOR_COUNT] PROGMEM = {")
+    for index, channel in enumerate(channels):
+        if channel.readable and channel.divisor:
+            lines.append("  { %d, %s }, //%s" % (index, channel.divisor, channel.name))
+    lines.append("};")
+    lines.append("#endif")
+    lines.append("")
+
+    lines.append("#if defined(SD_LOGGING)")
+    sd_channels = [channel for channel in channels if channel.sd]
+    for index, channel in enumerate(sd_channels):
+        lines.append("static constexpr char logSDHeader_%d[] PROGMEM = %s;" % (index, c_string(channel.log)))
+    lines.append("const char * const logSDHeaders[LOG_SD_FIELDS] PROGMEM = {")
+    for index in range(len(sd_channels)):
+        lines.append("  logSDHeader_%d," % index)
+    lines.append("};")
+    lines.append("#endif")
+    lines.append("")
+    return "\n".join(lines)
+
+
+def ini_value(value):
+    if value.startswith("{"):
+        return value
+    return '"%s"' % value
+
+
+def generate_ini_block(channels):
+    lines = [INI_BEGIN, "  ochBlockSize     =  %d" % sum(channel.size for channel in channels), ""]
+    for channel in channels:
+        if channel.kind == "channel":
+            line = "  %-17s= scalar, %s, %4d, %s, %s, %s" % (channel.name, channel.type, channel.offset,
+                                                           ini_value(channel.units), channel.scale, channel.translate)
+            if channel.comment:
+                line += " ; " + channel.comment
+            lines.append(line)
+        for bits in channel.bits:
+            line = "    %-19s= bits,   %s, %4d, %s" % (bits["name"], bits["type"], channel.offset, bits["bits"])
+            if bits["comment"]:
+                line += " ; " + bits["comment"]
+            lines.append(line)
+    lines.append(INI_END)
+    return lines
+
+
+def generate_ini(path, channels):
+    with io.open(path, encoding="utf-8", newline="") as ini_file:
+        text = ini_file.read()
+    lines = text.split("\n")
+    try:
+        begin = lines.index(INI_BEGIN)
+        end = lines.index(INI_END, begin)
+    except ValueError:
+        raise ValueError("%s: the generated output channel markers were not found" % path)
+    lines[begin:end + 1] = generate_ini_block(channels)
+    return "\n".join(lines)
+
+
+def generated_files(root):
+    channels = read_channels(os.path.join(root, "speeduino", "output_channels.csv"))
+    ini_path = os.path.join(root, "reference", "speeduino.ini")
+    return [
+        (os.path.join(root, "speeduino", "logger_channels.h"), generate_header(channels)),
+        (os.path.join(root, "speeduino", "logger_channels.cpp"), generate_source(channels)),
+        (ini_path, generate_ini(ini_path, channels)),
+    ]
+
+
+def read_text(path):
+    if not os.path.exists(path):
+        return None
+    with io.open(path, encoding="utf-8", newline="") as existing:
+        return existing.read()
+
+
+def output_channels(root, check):
+    """Writes (or with check, compares) the generated files. Returns 0 if they are up to date"""
+    stale = []
+    for (path, content) in generated_files(root):
+        if read_text(path) == content:
+            continue
+        stale.append(path)
+        if not check:
+            with io.open(path, "w", encoding="utf-8", newline="") as output:
+                output.write(content)
+            print("Generated %s" % path)
+    if check and stale:
+        for path in stale:
+            print("%s does not match speeduino/output_channels.csv. Run: python output_channels.py" % path)
+        return 1
+    return 0
+
+
+try:
+    Import("env")  # noqa: F821 - Provided by PlatformIO
+except NameError:
+    env = None
+
+if env is not None:
+    if output_channels(env.subst("$PROJECT_DIR"), True) != 0:
+        env.Exit(1)
+
+elif __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Generates the output channel tables and ini entries from speeduino/output_channels.csv")
+    parser.add_argument("--check", action="store_true", help="Fail if the generated files are out of date instead of writing them")
+    args = parser.parse_args()
+    sys.exit(output_channels(os.path.dirname(os.path.abspath(__file__)), args.check))
@@ -9,6 +9,7 @@
   #include "SdFat.h"
 #endif
 #include "RingBuf.h"
+#include "logger_channels.h"
 
 
 #define SD_STATUS_OFF               0 /**< SD system is inactive. FS and file remain closed */
@@ -21,6 +22,10 @@
 #define SD_STATUS_ERROR_WRITE_FAIL  7 /**< Log file created and opened, but a sector write failed during logging */
 #define SD_STATUS_ERROR_FORMAT_FAIL 8 /**< Attempted formatting of SD card failed */
 
+#define SD_FORMAT_DONE              0 /**< Returned by formatExFatStep() once the card is formatted and ready */
+#define SD_FORMAT_IN_PROGRESS       1 /**< Returned by formatExFatStep() when there are further steps to run */
+#define SD_FORMAT_FAILED            2 /**< Returned by formatExFatStep() if formatting failed */
+
 #define SD_STATUS_CARD_PRESENT      0 //0=no card, 1=card present
 #define SD_STATUS_CARD_TYPE         1 //0=SD, 1=SDHC
 #define SD_STATUS_CARD_READY        2 //0=not ready, 1=ready
@@ -41,7 +46,7 @@
     #define SD_CS_PIN 10 //This is a made up value for now
 #endif
 
-#define SD_LOG_NUM_FIELDS   91 /**< The number of fields that are in the log. This is always smaller than the entry size due to some fields being 2 bytes */
+#define SD_LOG_NUM_FIELDS   LOG_SD_FIELDS /**< The number of fields that are in the log. This is always smaller than the entry size due to some fields being 2 bytes */
 #ifndef UNIT_TEST // Scope guard for unit testing
   #define SD_LOG_ENTRY_SIZE   127 /**< The size of the live data packet used by the SD card.*/
 #else
@@ -78,6 +83,7 @@ void endSDLogging();
 void syncSDLog();
 void setTS_SD_status();
 void formatExFat();
+uint8_t formatExFatStep(uint8_t step);
 void deleteLogFile(char, char, char, char);
 bool createLogFile();
 void dateTime(uint16_t*, uint16_t*, uint8_t*); //Used for timestamping with RTC
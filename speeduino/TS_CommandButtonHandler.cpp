@@ -11,27 +11,70 @@
 #include "sensors.h"
 #include "storage.h"
 #include "SD_logger.h"
+#include "scheduler.h"
+#include "veLearn.h"
 #ifdef USE_MC33810
   #include "acc_mc33810.h"
 #endif
 
+static uint16_t commandQueue[TS_CMD_QUEUE_SIZE]; //Ring buffer of commands waiting to be run
+static uint8_t commandQueueHead = 0; //Index of the command currently being run
+static uint8_t commandQueueCount = 0;
+static uint8_t commandStep = 0; //The step the current command is up to. Only used by commands that are split over multiple loops
+
 static bool commandRequiresStoppedEngine(uint16_t buttonCommand)
 {
   return ((buttonCommand >= TS_CMD_INJ1_ON) && (buttonCommand <= TS_CMD_IGN8_PULSED)) 
       || ((buttonCommand == TS_CMD_TEST_ENBL) || (buttonCommand == TS_CMD_TEST_DSBL));
 }
 
+static bool commandIsKnown(uint16_t buttonCommand)
+{
+  return ((buttonCommand == TS_CMD_TEST_DSBL) || (buttonCommand == TS_CMD_TEST_ENBL))
+      || ((buttonCommand >= TS_CMD_INJ1_ON) && (buttonCommand <= TS_CMD_INJ8_PULSED))
+      || ((buttonCommand >= TS_CMD_IGN1_ON) && (buttonCommand <= TS_CMD_IGN8_PULSED))
+      || ((buttonCommand >= TS_CMD_VSS_60KMH) && (buttonCommand <= TS_CMD_VSS_RATIO6))
+      || ((buttonCommand == TS_CMD_STM32_REBOOT) || (buttonCommand == TS_CMD_STM32_BOOTLOADER))
+      || (buttonCommand == TS_CMD_SCHED_STATS_RESET)
+      || ((buttonCommand == TS_CMD_VE_LEARN_APPLY) || (buttonCommand == TS_CMD_VE_LEARN_RESET))
+      || ((buttonCommand == TS_CMD_TABLE_OVERLAY_COMMIT) || (buttonCommand == TS_CMD_TABLE_OVERLAY_CLEAR))
+#ifdef SD_LOGGING
+      || (buttonCommand == TS_CMD_SD_FORMAT)
+#endif
+      ;
+}
+
+static void setCommandResult(bool success)
+{
+  if(success == true)
+  {
+    BIT_SET(currentStatus.tsCommandStatus, TS_CMD_STATUS_DONE);
+    BIT_CLEAR(currentStatus.tsCommandStatus, TS_CMD_STATUS_FAILED);
+  }
+  else
+  {
+    BIT_CLEAR(currentStatus.tsCommandStatus, TS_CMD_STATUS_DONE);
+    BIT_SET(currentStatus.tsCommandStatus, TS_CMD_STATUS_FAILED);
+  }
+}
+
 /**
- * @brief 
+ * @brief Runs a single step of a command button action
  * 
  * @param buttonCommand The command number of the button that was clicked. See TS_CommendButtonHandler.h for a list of button IDs
+ * @param step The step of the command to run. Starts at 0 and increments each time TS_CMD_RESULT_IN_PROGRESS is returned
+ * @return One of the TS_CMD_RESULT_* values
  */
-bool TS_CommandButtonsHandler(uint16_t buttonCommand)
+static uint8_t runCommandStep(uint16_t buttonCommand, uint8_t step)
 {
+  //The engine may have started since the command was queued
   if (commandRequiresStoppedEngine(buttonCommand) && currentStatus.RPM != 0)
   {
-    return false;
+    return TS_CMD_RESULT_FAILED;
   }
+#ifndef SD_LOGGING
+  (void)step; //Only the SD format is split into steps
+#endif
   
   switch (buttonCommand)
   {
@@ -377,16 +420,102 @@ bool TS_CommandButtonsHandler(uint16_t buttonCommand)
       jumpToBootloader();
       break;
 
+    case TS_CMD_SCHED_STATS_RESET:
+      resetScheduleStats();
+      updateScheduleStatus();
+      break;
+
+    case TS_CMD_VE_LEARN_APPLY:
+      applyVELearn();
+      break;
+
+    case TS_CMD_VE_LEARN_RESET:
+      resetVELearn();
+      break;
+
+    case TS_CMD_TABLE_OVERLAY_COMMIT:
+      commitTableOverlays();
+      break;
+
+    case TS_CMD_TABLE_OVERLAY_CLEAR:
+      clearTableOverlays();
+      break;
+
 #ifdef SD_LOGGING
-    case TS_CMD_SD_FORMAT: //Format SD card
-      formatExFat();
+    case TS_CMD_SD_FORMAT: //Format SD card. This is split into steps as each stage can take a long time
+      {
+        uint8_t formatResult = formatExFatStep(step);
+        if(formatResult == SD_FORMAT_IN_PROGRESS) { return TS_CMD_RESULT_IN_PROGRESS; }
+        if(formatResult == SD_FORMAT_FAILED) { return TS_CMD_RESULT_FAILED; }
+      }
       break;
 #endif
 
     default:
-      return false;
+      return TS_CMD_RESULT_FAILED;
       break;
   }
 
+  return TS_CMD_RESULT_DONE;
+}
+
+/**
+ * @brief Queues a command button that has been clicked in TS
+ * 
+ * The command is not run here as some commands (SD format, EEPROM writes etc) can take a long time. Queued commands are run from the main loop by processTSCommandQueue()
+ * 
+ * @param buttonCommand The command number of the button that was clicked. See TS_CommendButtonHandler.h for a list of button IDs
+ * @return true if the command was queued. false if it was rejected
+ */
+bool TS_CommandButtonsHandler(uint16_t buttonCommand)
+{
+  if ( (commandIsKnown(buttonCommand) == false) || (commandRequiresStoppedEngine(buttonCommand) && currentStatus.RPM != 0) || (commandQueueCount >= TS_CMD_QUEUE_SIZE) )
+  {
+    setCommandResult(false);
+    return false;
+  }
+
+  commandQueue[(commandQueueHead + commandQueueCount) % TS_CMD_QUEUE_SIZE] = buttonCommand;
+  commandQueueCount++;
+  BIT_SET(currentStatus.tsCommandStatus, TS_CMD_STATUS_BUSY);
+
   return true;
 }
+
+/**
+ * @brief Runs queued command buttons until the time budget is used up
+ * 
+ * Commands are run in the order they were clicked. Commands that take a long time are split into steps, with 1 step run per call if the budget allows.
+ * At least 1 step is always run so that the queue cannot stall, however a single step is never interrupted so the budget can be exceeded by a slow step.
+ * 
+ * @param timeBudget The time (uS) that can be spent running commands
+ */
+void processTSCommandQueue(uint16_t timeBudget)
+{
+  uint32_t startTime = micros();
+
+  while(commandQueueCount > 0U)
+  {
+    uint8_t result = runCommandStep(commandQueue[commandQueueHead], commandStep);
+    if(result == TS_CMD_RESULT_IN_PROGRESS) { commandStep++; }
+    else
+    {
+      setCommandResult(result == TS_CMD_RESULT_DONE);
+      commandQueueHead = (commandQueueHead + 1U) % TS_CMD_QUEUE_SIZE;
+      commandQueueCount--;
+      commandStep = 0;
+    }
+
+    if( (micros() - startTime) >= timeBudget ) { break; }
+  }
+
+  if(commandQueueCount == 0U) { BIT_CLEAR(currentStatus.tsCommandStatus, TS_CMD_STATUS_BUSY); }
+}
+
+/**
+ * @brief The number of commands queued or in progress
+ */
+uint8_t getTSCommandQueueCount(void)
+{
+  return commandQueueCount;
+}
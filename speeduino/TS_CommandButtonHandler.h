@@ -3,6 +3,8 @@
  * Header file for the TunerStudio command handler
  * The command handler manages all the inputs FROM TS which are issued when a command button is clicked by the user
  */
+#ifndef TS_COMMAND_BUTTON_HANDLER_H
+#define TS_COMMAND_BUTTON_HANDLER_H
 
 #define TS_CMD_TEST_DSBL    256
 #define TS_CMD_TEST_ENBL    257
@@ -62,6 +64,14 @@
 
 #define TS_CMD_SD_FORMAT  13057
 
+#define TS_CMD_SCHED_STATS_RESET 13312 //0x34x00. Clears the schedule event counters (See schedule_stats_t)
+
+#define TS_CMD_VE_LEARN_APPLY 13568 //0x35x00. Moves the learned VE cells into the table overlay (See veLearn.h)
+#define TS_CMD_VE_LEARN_RESET 13569 //0x35x01. Restarts the learned VE table from the VE table
+
+#define TS_CMD_TABLE_OVERLAY_COMMIT 13824 //0x36x00. Adds the table overlay deltas to the tables and burns them (See table3d_overlay.h)
+#define TS_CMD_TABLE_OVERLAY_CLEAR  13825 //0x36x01. Discards the table overlay deltas
+
 #define TS_CMD_VSS_60KMH  39168 //0x99x00
 #define TS_CMD_VSS_RATIO1 39169
 #define TS_CMD_VSS_RATIO2 39170
@@ -70,5 +80,22 @@
 #define TS_CMD_VSS_RATIO5 39173
 #define TS_CMD_VSS_RATIO6 39174
 
+#define TS_CMD_QUEUE_SIZE   8   //The maximum number of button commands waiting to be run
+#define TS_CMD_LOOP_BUDGET  250 //The time (uS) per main loop that can be spent running queued commands. At least 1 command step is always run
+
+//Bits of currentStatus.tsCommandStatus
+#define TS_CMD_STATUS_BUSY    0 //Commands are queued or in progress
+#define TS_CMD_STATUS_DONE    1 //The last command completed successfully
+#define TS_CMD_STATUS_FAILED  2 //The last command was rejected (Unknown, engine running or queue full) or failed
+
+//Results of running a single step of a command
+#define TS_CMD_RESULT_DONE        0
+#define TS_CMD_RESULT_IN_PROGRESS 1
+#define TS_CMD_RESULT_FAILED      2
+
 /* the maximum id number is 65,535 */
 bool TS_CommandButtonsHandler(uint16_t buttonCommand);
+void processTSCommandQueue(uint16_t timeBudget);
+uint8_t getTSCommandQueueCount(void);
+
+#endif // TS_COMMAND_BUTTON_HANDLER_H
@@ -0,0 +1,238 @@
+/** @file
+ * Angle triggered arming of the fuel and ignition schedules. See angleArming.h
+ *
+ * The targets are double buffered. The main loop fills the buffer that the interrupt is not using and then swaps them
+ * over with a single byte write, so the interrupt always sees a complete set and interrupts never need to be disabled.
+ */
+#include "globals.h"
+#include "angleArming.h"
+#include "scheduler.h"
+#include "decoders.h"
+#include "crankMaths.h"
+
+struct arming_targets_t {
+  uint16_t fuelAngle[INJ_CHANNELS];  ///< Injector start angles
+  uint16_t fuelPW[INJ_CHANNELS];     ///< Pulse widths (uS)
+  uint16_t ignitionAngle[IGN_CHANNELS]; ///< Coil charge start angles
+  uint16_t ignitionDwell[IGN_CHANNELS]; ///< Dwell times (uS)
+  uint8_t fuelChannels;     ///< The injector channels to arm (INJx_CMD_BIT)
+  uint8_t ignitionChannels; ///< The ignition channels to arm (IGNx_CMD_BIT)
+};
+
+static arming_targets_t armingTargets[2];
+static volatile uint8_t activeTargets = 0; //The buffer used by the interrupt. The main loop fills the other one
+static volatile bool armingActive = false;
+
+//Interrupt side state. The channels that have been armed for the start currently inside the window
+static uint8_t fuelArmed = 0;
+static uint8_t ignitionArmed = 0;
+static uint16_t largestToothGap = 0; //Largest angle between 2 primary teeth seen while in sync
+static int16_t lastToothAngle = -1;  //Crank angle (0 to CRANK_ANGLE_MAX_IGN) of the last tooth while in sync. -1 if there was none
+
+/**
+ * @brief Sets the injector start that will be published by the next publishArmingTargets()
+ *
+ * @param channel Injector channel (INJx_CMD_BIT)
+ * @param enabled Whether the channel should be armed at all (Output in use, fuel on and the pulse width is long enough)
+ * @param startAngle Injector start angle
+ * @param pulseWidth Pulse width (uS)
+ */
+void setFuelArmingTarget(uint8_t channel, bool enabled, uint16_t startAngle, uint16_t pulseWidth)
+{
+  arming_targets_t &targets = armingTargets[activeTargets ^ 1U];
+  targets.fuelAngle[channel] = startAngle;
+  targets.fuelPW[channel] = pulseWidth;
+  if(enabled == true) { BIT_SET(targets.fuelChannels, channel); }
+  else { BIT_CLEAR(targets.fuelChannels, channel); }
+}
+
+/**
+ * @brief Sets the coil charge start that will be published by the next publishArmingTargets()
+ *
+ * @param channel Ignition channel (IGNx_CMD_BIT)
+ * @param enabled Whether the channel should be armed at all
+ * @param startAngle Ignition start (Dwell start) angle
+ * @param dwell Dwell time (uS)
+ */
+void setIgnitionArmingTarget(uint8_t channel, bool enabled, uint16_t startAngle, uint16_t dwell)
+{
+  arming_targets_t &targets = armingTargets[activeTargets ^ 1U];
+  targets.ignitionAngle[channel] = startAngle;
+  targets.ignitionDwell[channel] = dwell;
+  if(enabled == true) { BIT_SET(targets.ignitionChannels, channel); }
+  else { BIT_CLEAR(targets.ignitionChannels, channel); }
+}
+
+/** Hands the targets set since the last call over to the trigger interrupt, and starts arming from the interrupt if it was stopped.
+ * Every channel must have been set, as the buffer being filled still holds the targets from 2 calls ago
+ */
+void publishArmingTargets(void)
+{
+  activeTargets ^= 1U;
+  armingActive = true;
+}
+
+/** Stops the trigger interrupt arming the schedules, so they are armed by the main loop instead */
+void stopAngleArming(void)
+{
+  armingActive = false;
+}
+
+/** Forgets the measured tooth gaps. Called when the engine stops, as the trigger settings can be changed before it is restarted */
+void resetAngleArmingToothGap(void)
+{
+  largestToothGap = 0;
+  lastToothAngle = -1;
+}
+
+bool isAngleArmingActive(void)
+{
+  return armingActive;
+}
+
+/** The degrees before its start that a schedule is armed. This is configPage15.angleArmWindow, widened to the largest gap between
+ * primary teeth. Otherwise a start in a gap larger than the window (The missing teeth of a coarse wheel) would be too far from
+ * the tooth before it to be armed, and then armed by no tooth at all
+ */
+uint16_t getAngleArmingWindow(void)
+{
+  return max((uint16_t)configPage15.angleArmWindow, largestToothGap);
+}
+
+/** Measures the gap from the previous tooth. Only done with full sync, as the crank angle can jump when sync is gained */
+static inline void updateToothGap(int16_t toothAngle)
+{
+  if(currentStatus.hasSync == false) { lastToothAngle = -1; }
+  else
+  {
+    if(lastToothAngle >= 0)
+    {
+      const uint16_t gap = (uint16_t)ignitionLimits(toothAngle - lastToothAngle);
+      if(gap > largestToothGap) { largestToothGap = gap; }
+    }
+    lastToothAngle = toothAngle;
+  }
+}
+
+/**
+ * @brief Works out whether a start should be armed from the current tooth
+ *
+ * @param startAngle The start angle (0 to maxAngle)
+ * @param crankAngle Crank angle at the tooth (0 to maxAngle)
+ * @param maxAngle CRANK_ANGLE_MAX_INJ or CRANK_ANGLE_MAX_IGN
+ * @param window Degrees before the start that it can be armed
+ * @return uint32_t The timeout (uS) to arm the start with, or 0 if it is not within the window. Never less than ANGLE_ARMING_MIN_TIMEOUT otherwise
+ */
+uint32_t angleArmingTimeout(uint16_t startAngle, int16_t crankAngle, int16_t maxAngle, uint16_t window)
+{
+  int16_t delta = (int16_t)startAngle - crankAngle;
+  if(delta < 0) { delta = delta + maxAngle; }
+  if(delta > (int16_t)window) { return 0; }
+  return max(angleToTimeMicroSecPerDegree((uint16_t)delta), (uint32_t)ANGLE_ARMING_MIN_TIMEOUT);
+}
+
+/*
+Each channel is armed once each time its start comes within the window. The armed bit is only cleared once the start
+has passed (Or the channel is turned off), so a start that fires before the next tooth is not armed again from that
+tooth. A channel that is still PENDING when its start enters the window was armed by the main loop before arming
+was handed over, so it is left alone.
+*/
+static inline void armFuelChannel(FuelSchedule &schedule, const arming_targets_t &targets, uint8_t channel, int16_t crankAngle, uint16_t window)
+{
+  uint32_t timeout = 0;
+  if(BIT_CHECK(targets.fuelChannels, channel)) { timeout = angleArmingTimeout(targets.fuelAngle[channel], crankAngle, CRANK_ANGLE_MAX_INJ, window); }
+
+  if(timeout == 0U) { BIT_CLEAR(fuelArmed, channel); }
+  else if(!BIT_CHECK(fuelArmed, channel))
+  {
+    if(schedule.Status != PENDING) { setFuelSchedule(schedule, timeout, targets.fuelPW[channel]); }
+    BIT_SET(fuelArmed, channel);
+  }
+}
+
+static inline void armIgnitionChannel(IgnitionSchedule &schedule, const arming_targets_t &targets, uint8_t channel, int16_t crankAngle, uint16_t window)
+{
+  uint32_t timeout = 0;
+  if(BIT_CHECK(targets.ignitionChannels, channel)) { timeout = angleArmingTimeout(targets.ignitionAngle[channel], crankAngle, CRANK_ANGLE_MAX_IGN, window); }
+
+  if(timeout == 0U) { BIT_CLEAR(ignitionArmed, channel); }
+  else if(!BIT_CHECK(ignitionArmed, channel))
+  {
+    if(schedule.Status != PENDING) { setIgnitionSchedule(schedule, timeout, targets.ignitionDwell[channel]); }
+    BIT_SET(ignitionArmed, channel);
+  }
+}
+
+/** The crank angle of the tooth that the decoder has just processed, plus the time since it.
+ * Worked out from the decoder state alone, as getCrankAngle() leaves its working values in globals that the main loop could be part way
+ * through using. Only correct for the decoders that set BIT_DECODER_UNIFORM_TEETH
+ */
+static inline int16_t getToothCrankAngle(void)
+{
+  decoder_snapshot_t snapshot;
+  getDecoderSnapshot(snapshot);
+  //A count of 0 means the secondary tooth reset it (Dual wheel), which happens on the last primary tooth
+  const int16_t tooth = (snapshot.toothCurrentCount == 0U) ? (int16_t)configPage4.triggerTeeth : (int16_t)snapshot.toothCurrentCount;
+  int16_t crankAngle = ((tooth - 1) * (int16_t)snapshot.triggerToothAngle) + configPage4.triggerAngle;
+  if( (snapshot.revolutionOne == true) && (configPage4.TrigSpeed == CRANK_SPEED) ) { crankAngle += 360; }
+  crankAngle += (int16_t)timeToAngleDegPerMicroSec(micros() - snapshot.toothLastToothTime);
+
+  if (crankAngle >= 720) { crankAngle -= 720; }
+  if (crankAngle < 0) { crankAngle += CRANK_ANGLE_MAX; }
+  return crankAngle;
+}
+
+/** Arms any schedule whose start is within the window of the current crank angle. Called from the primary trigger interrupt after the decoder has run.
+ * Edges that the decoder rejected (BIT_DECODER_VALID_TRIGGER is clear) are ignored.
+ * While angle arming is enabled the tooth gaps are measured even before arming is handed over by the main loop, so the window is already wide
+ * enough for the wheel when it is
+ */
+void armSchedulesAtTooth(void)
+{
+  if( (configPage15.angleArming == false) || !BIT_CHECK(decoderState, BIT_DECODER_UNIFORM_TEETH) ) { lastToothAngle = -1; return; }
+  if( !BIT_CHECK(decoderState, BIT_DECODER_VALID_TRIGGER) ) { return; }
+  if( (currentStatus.hasSync == false) && !BIT_CHECK(currentStatus.status3, BIT_STATUS3_HALFSYNC) ) { lastToothAngle = -1; return; }
+
+  const int16_t crankAngle = getToothCrankAngle();
+  const int16_t ignitionAngle = ignitionLimits(crankAngle);
+  updateToothGap(ignitionAngle);
+  if(armingActive == false) { return; }
+
+  const arming_targets_t &targets = armingTargets[activeTargets];
+  const uint16_t window = getAngleArmingWindow();
+
+  const int16_t injectorAngle = injectorLimits(crankAngle);
+  armFuelChannel(fuelSchedule1, targets, INJ1_CMD_BIT, injectorAngle, window);
+  armFuelChannel(fuelSchedule2, targets, INJ2_CMD_BIT, injectorAngle, window);
+  armFuelChannel(fuelSchedule3, targets, INJ3_CMD_BIT, injectorAngle, window);
+  armFuelChannel(fuelSchedule4, targets, INJ4_CMD_BIT, injectorAngle, window);
+#if INJ_CHANNELS >= 5
+  armFuelChannel(fuelSchedule5, targets, INJ5_CMD_BIT, injectorAngle, window);
+#endif
+#if INJ_CHANNELS >= 6
+  armFuelChannel(fuelSchedule6, targets, INJ6_CMD_BIT, injectorAngle, window);
+#endif
+#if INJ_CHANNELS >= 7
+  armFuelChannel(fuelSchedule7, targets, INJ7_CMD_BIT, injectorAngle, window);
+#endif
+#if INJ_CHANNELS >= 8
+  armFuelChannel(fuelSchedule8, targets, INJ8_CMD_BIT, injectorAngle, window);
+#endif
+
+  armIgnitionChannel(ignitionSchedule1, targets, IGN1_CMD_BIT, ignitionAngle, window);
+  armIgnitionChannel(ignitionSchedule2, targets, IGN2_CMD_BIT, ignitionAngle, window);
+  armIgnitionChannel(ignitionSchedule3, targets, IGN3_CMD_BIT, ignitionAngle, window);
+  armIgnitionChannel(ignitionSchedule4, targets, IGN4_CMD_BIT, ignitionAngle, window);
+#if IGN_CHANNELS >= 5
+  armIgnitionChannel(ignitionSchedule5, targets, IGN5_CMD_BIT, ignitionAngle, window);
+#endif
+#if IGN_CHANNELS >= 6
+  armIgnitionChannel(ignitionSchedule6, targets, IGN6_CMD_BIT, ignitionAngle, window);
+#endif
+#if IGN_CHANNELS >= 7
+  armIgnitionChannel(ignitionSchedule7, targets, IGN7_CMD_BIT, ignitionAngle, window);
+#endif
+#if IGN_CHANNELS >= 8
+  armIgnitionChannel(ignitionSchedule8, targets, IGN8_CMD_BIT, ignitionAngle, window);
+#endif
+}
@@ -0,0 +1,35 @@
+/** @file
+ * Angle triggered arming of the fuel and ignition schedules.
+ * Normally the main loop arms each schedule by converting the angle to its start into a time, using a crank angle
+ * estimated at some point during the loop. With a slow loop at high RPM that estimate can be stale, and the schedule is
+ * armed a long way (Up to a whole cycle) ahead of its start, so any change in engine speed over that time becomes a
+ * timing error.
+ *
+ * With angle arming enabled (configPage15.angleArming) the main loop only publishes the start angle and duration of
+ * each channel. The primary trigger interrupt then arms each schedule from the first tooth that is within
+ * configPage15.angleArmWindow degrees of its start, so the time that is converted from an angle is never more than
+ * the window, regardless of how long the loop takes. The window is never smaller than the largest gap between primary
+ * teeth that has been seen while in sync, so a start that falls in that gap (E.g. the missing tooth of a 4-1 wheel) is
+ * still armed from the tooth before it.
+ * The interrupt works out the crank angle of each tooth from the tooth count, so this is only used with the decoders whose
+ * teeth are evenly spaced from tooth 1 (BIT_DECODER_UNIFORM_TEETH: missing tooth and dual wheel). With any other decoder
+ * the main loop arms the schedules as normal.
+ */
+#ifndef ANGLE_ARMING_H
+#define ANGLE_ARMING_H
+
+#include "globals.h"
+
+#define ANGLE_ARMING_MIN_TIMEOUT  32 ///< Shortest timeout (uS) that a schedule is armed with. A compare set closer than this could already have been passed when it is written
+
+void setFuelArmingTarget(uint8_t channel, bool enabled, uint16_t startAngle, uint16_t pulseWidth);
+void setIgnitionArmingTarget(uint8_t channel, bool enabled, uint16_t startAngle, uint16_t dwell);
+void publishArmingTargets(void);
+void stopAngleArming(void);
+void resetAngleArmingToothGap(void);
+bool isAngleArmingActive(void);
+void armSchedulesAtTooth(void);
+uint16_t getAngleArmingWindow(void);
+uint32_t angleArmingTimeout(uint16_t startAngle, int16_t crankAngle, int16_t maxAngle, uint16_t window);
+
+#endif
@@ -9,20 +9,18 @@ A full copy of the license may be found in the projects root directory
 #include "src/PID_v1/PID_v1.h"
 #include "decoders.h"
 #include "timers.h"
+#include "pwmOutputs.h"
+#include "softPWM.h"
 
 static long vvt1_pwm_value;
 static long vvt2_pwm_value;
-volatile unsigned int vvt1_pwm_cur_value;
-volatile unsigned int vvt2_pwm_cur_value;
 static long vvt_pid_target_angle;
 static long vvt2_pid_target_angle;
 static long vvt_pid_current_angle;
 static long vvt2_pid_current_angle;
-volatile bool vvt1_pwm_state;
-volatile bool vvt2_pwm_state;
-volatile bool vvt1_max_pwm;
-volatile bool vvt2_max_pwm;
-volatile char nextVVT;
+static soft_pwm_t vvtPWM; //VVT1 and VVT2/WMI share the VVT timer compare
+static uint8_t vvt1Channel = SOFT_PWM_NO_CHANNEL;
+static uint8_t vvt2Channel = SOFT_PWM_NO_CHANNEL;
 byte boostCounter;
 byte vvtCounter;
 
@@ -71,6 +69,36 @@ bool vvtIsHot;
 bool vvtTimeHold;
 uint16_t vvt_pwm_max_count; //Used for variable PWM frequency
 uint16_t boost_pwm_max_count; //Used for variable PWM frequency
+static bool vvtHardwarePWM = false; //All of the VVT/WMI outputs in use are driven by hardware PWM. The VVT interrupt drives both outputs, so it is only unused if neither needs it
+
+//The compare interrupts are only used by the outputs that are not driven by hardware PWM. See pwmOutputs.h
+static inline void enableBoostTimer(void) { if(pwmOutputIsHardware(PWM_OUT_BOOST) == false) { ENABLE_BOOST_TIMER(); } }
+static inline void enableVVTTimer(void) { if(vvtHardwarePWM == false) { ENABLE_VVT_TIMER(); } }
+
+static inline void initialiseVVTPWM(void)
+{
+  #if defined(CORE_TEENSY41)
+    softPWMInit(vvtPWM, vvt_pwm_max_count, true); //The PIT only takes a new interval once the current one completes
+  #else
+    softPWMInit(vvtPWM, vvt_pwm_max_count, false);
+  #endif
+  //Outputs are only added if they are in use, as the interrupt drives every output it has at the start of each period
+  vvt1Channel = (configPage6.vvtEnabled > 0) ? softPWMAddChannel(vvtPWM, vvt1_pin_port, vvt1_pin_mask, false) : SOFT_PWM_NO_CHANNEL;
+  if( ((configPage6.vvtEnabled > 0) && (configPage10.vvt2Enabled == 1)) || (configPage10.wmiEnabled >= 1) ) { vvt2Channel = softPWMAddChannel(vvtPWM, vvt2_pin_port, vvt2_pin_mask, false); }
+  else { vvt2Channel = SOFT_PWM_NO_CHANNEL; }
+}
+
+//Hands the latest VVT/WMI duties to the VVT interrupt
+static inline void updateVVTPWM(void)
+{
+  softPWMSetOnTime(vvtPWM, vvt1Channel, (uint16_t)vvt1_pwm_value);
+  softPWMSetOnTime(vvtPWM, vvt2Channel, (uint16_t)vvt2_pwm_value);
+  softPWMUpdate(vvtPWM);
+}
+
+#if defined(PWM_FAN_AVAILABLE)
+static inline void enableFanTimer(void) { if(pwmOutputIsHardware(PWM_OUT_FAN) == false) { ENABLE_FAN_TIMER(); } }
+#endif
 
 //Old PID method. Retained in case the new one has issues
 //integerPID boostPID(&MAPx100, &boost_pwm_target_value, &boostTargetx100, configPage6.boostKP, configPage6.boostKI, configPage6.boostKD, DIRECT);
@@ -320,6 +348,9 @@ void initialiseFan(void)
   BIT_CLEAR(currentStatus.status4, BIT_STATUS4_FAN);
   currentStatus.fanDuty = 0;
 
+  if( configPage2.fanEnable == 2 ) { pwmOutputBegin(PWM_OUT_FAN, pinFan, configPage6.fanFreq * 2U, (configPage6.fanInv == 1U)); }
+  else { pwmOutputEnd(PWM_OUT_FAN); }
+
   #if defined(PWM_FAN_AVAILABLE)
     DISABLE_FAN_TIMER(); //disable FAN timer if available
     if ( configPage2.fanEnable == 2 ) // PWM Fan control
@@ -401,7 +432,7 @@ void fanControl(void)
           fan_pwm_value = halfPercentage(currentStatus.fanDuty, fan_pwm_max_count); //update FAN PWM value last
           if (currentStatus.fanDuty > 0)
           {
-            ENABLE_FAN_TIMER();
+            enableFanTimer();
             BIT_SET(currentStatus.status4, BIT_STATUS4_FAN);
           }
         #endif
@@ -442,6 +473,7 @@ void fanControl(void)
         BIT_SET(currentStatus.status4, BIT_STATUS4_FAN);
       }
     #endif
+    pwmOutputWrite(PWM_OUT_FAN, (uint16_t)currentStatus.fanDuty * 50U); //fanDuty is in 0.5% steps
   }
 }
 
@@ -471,6 +503,23 @@ void initialiseAuxPWM(void)
     else { pinMode(configPage10.n2o_arming_pin, INPUT); }
   }
 
+  if(configPage6.boostEnabled == 1) { pwmOutputBegin(PWM_OUT_BOOST, pinBoost, configPage6.boostFreq * 2U, false); }
+  else { pwmOutputEnd(PWM_OUT_BOOST); }
+  if(pwmOutputIsHardware(PWM_OUT_BOOST)) { DISABLE_BOOST_TIMER(); }
+
+  //VVT1 and VVT2/WMI share an interrupt, so they only use hardware PWM if all of the outputs in use can
+  bool vvt1Used = (configPage6.vvtEnabled > 0);
+  bool vvt2Used = ( (configPage6.vvtEnabled > 0) && (configPage10.vvt2Enabled == 1) ) || (configPage10.wmiEnabled >= 1);
+  vvtHardwarePWM = (vvt1Used || vvt2Used);
+  if(vvt1Used) { vvtHardwarePWM = pwmOutputBegin(PWM_OUT_VVT1, pinVVT_1, configPage6.vvtFreq * 2U, false); }
+  if(vvtHardwarePWM && vvt2Used) { vvtHardwarePWM = pwmOutputBegin(PWM_OUT_VVT2, pinVVT_2, configPage6.vvtFreq * 2U, false); }
+  if(vvtHardwarePWM == false)
+  {
+    pwmOutputEnd(PWM_OUT_VVT1);
+    pwmOutputEnd(PWM_OUT_VVT2);
+  }
+  else { DISABLE_VVT_TIMER(); }
+
   boostPID.SetOutputLimits(configPage2.boostMinDuty, configPage2.boostMaxDuty);
   if(configPage6.boostMode == BOOST_MODE_SIMPLE) { boostPID.SetTunings(SIMPLE_BOOST_P, SIMPLE_BOOST_I, SIMPLE_BOOST_D); }
   else { boostPID.SetTunings(configPage6.boostKP, configPage6.boostKI, configPage6.boostKD); }
@@ -505,7 +554,8 @@ void initialiseAuxPWM(void)
 
     vvt1_pwm_value = 0;
     vvt2_pwm_value = 0;
-    ENABLE_VVT_TIMER(); //Turn on the B compare unit (ie turn on the interrupt)
+    initialiseVVTPWM();
+    enableVVTTimer(); //Turn on the B compare unit (ie turn on the interrupt)
     BIT_CLEAR(currentStatus.status4, BIT_STATUS4_VVT1_ERROR);
     BIT_CLEAR(currentStatus.status4, BIT_STATUS4_VVT2_ERROR);
     vvtTimeHold = false;
@@ -526,7 +576,8 @@ void initialiseAuxPWM(void)
     currentStatus.wmiPW = 0;
     vvt1_pwm_value = 0;
     vvt2_pwm_value = 0;
-    ENABLE_VVT_TIMER(); //Turn on the B compare unit (ie turn on the interrupt)
+    initialiseVVTPWM();
+    enableVVTTimer(); //Turn on the B compare unit (ie turn on the interrupt)
   }
 
   currentStatus.boostDuty = 0;
@@ -751,7 +802,7 @@ void boostControl(void)
         //Boost control needs to have a high duty cycle if control is below threshold (baro or fixed value). This ensures the waste gate is closed as much as possible, this build boost as fast as possible.
         currentStatus.boostDuty = configPage15.boostDCWhenDisabled*100;
         boost_pwm_target_value = ((unsigned long)(currentStatus.boostDuty) * boost_pwm_max_count) / 10000; //Convert boost duty (Which is a % multiplied by 100) to a pwm count
-        ENABLE_BOOST_TIMER(); //Turn on the compare unit (ie turn on the interrupt) if boost duty >0
+        enableBoostTimer(); //Turn on the compare unit (ie turn on the interrupt) if boost duty >0
         if(currentStatus.boostDuty == 0) { boostDisable(); } //If boost control does nothing disable PWM completely
       } //MAP above boost + hyster
     } //Open / Cloosed loop
@@ -764,7 +815,7 @@ void boostControl(void)
     }
     else if(currentStatus.boostDuty > 0)
     {
-      ENABLE_BOOST_TIMER(); //Turn on the compare unit (ie turn on the interrupt) if boost duty is > 0
+      enableBoostTimer(); //Turn on the compare unit (ie turn on the interrupt) if boost duty is > 0
     }
     
   }
@@ -772,6 +823,7 @@ void boostControl(void)
     DISABLE_BOOST_TIMER();
     currentStatus.flexBoostCorrection = 0;
   }
+  pwmOutputWrite(PWM_OUT_BOOST, (configPage6.boostEnabled == 1) ? currentStatus.boostDuty : 0U);
 
   boostCounter++;
 }
@@ -903,10 +955,6 @@ void vvtControl(void)
           //Make sure solenoid is off (0% duty)
           VVT1_PIN_OFF();
           VVT2_PIN_OFF();
-          vvt1_pwm_state = false;
-          vvt1_max_pwm = false;
-          vvt2_pwm_state = false;
-          vvt2_max_pwm = false;
           DISABLE_VVT_TIMER();
         }
         else if( (currentStatus.vvt1Duty >= 200) && (currentStatus.vvt2Duty >= 200) )
@@ -914,18 +962,12 @@ void vvtControl(void)
           //Make sure solenoid is on (100% duty)
           VVT1_PIN_ON();
           VVT2_PIN_ON();
-          vvt1_pwm_state = true;
-          vvt1_max_pwm = true;
-          vvt2_pwm_state = true;
-          vvt2_max_pwm = true;
           DISABLE_VVT_TIMER();
         }
         else
         {
           //Duty cycle is between 0 and 100. Make sure the timer is enabled
-          ENABLE_VVT_TIMER();
-          if(currentStatus.vvt1Duty < 200) { vvt1_max_pwm = false; }
-          if(currentStatus.vvt2Duty < 200) { vvt2_max_pwm = false; }
+          enableVVTTimer();
         }
       }
       else
@@ -934,21 +976,16 @@ void vvtControl(void)
         {
           //Make sure solenoid is off (0% duty)
           VVT1_PIN_OFF();
-          vvt1_pwm_state = false;
-          vvt1_max_pwm = false;
         }
         else if( currentStatus.vvt1Duty >= 200 )
         {
           //Make sure solenoid is on (100% duty)
           VVT1_PIN_ON();
-          vvt1_pwm_state = true;
-          vvt1_max_pwm = true;
         }
         else
         {
           //Duty cycle is between 0 and 100. Make sure the timer is enabled
-          ENABLE_VVT_TIMER();
-          if(currentStatus.vvt1Duty < 200) { vvt1_max_pwm = false; }
+          enableVVTTimer();
         }
       }
     }
@@ -961,15 +998,16 @@ void vvtControl(void)
       DISABLE_VVT_TIMER();
       currentStatus.vvt2Duty = 0;
       vvt2_pwm_value = 0;
-      vvt2_pwm_state = false;
-      vvt2_max_pwm = false;
     }
     currentStatus.vvt1Duty = 0;
     vvt1_pwm_value = 0;
-    vvt1_pwm_state = false;
-    vvt1_max_pwm = false;
     vvtTimeHold = false;
   } 
+
+  updateVVTPWM();
+
+  pwmOutputWrite(PWM_OUT_VVT1, (uint16_t)currentStatus.vvt1Duty * 50U); //VVT duty is in 0.5% steps
+  if(configPage10.wmiEnabled == 0) { pwmOutputWrite(PWM_OUT_VVT2, (uint16_t)currentStatus.vvt2Duty * 50U); }
 }
 
 void nitrousControl(void)
@@ -1076,8 +1114,6 @@ void wmiControl(void)
     {
       // Make sure water pump is off
       VVT2_PIN_LOW();
-      vvt2_pwm_state = false;
-      vvt2_max_pwm = false;
       if( configPage6.vvtEnabled == 0 ) { DISABLE_VVT_TIMER(); }
       digitalWrite(pinWMIEnabled, LOW);
     }
@@ -1088,16 +1124,12 @@ void wmiControl(void)
       {
         // Make sure water pump is on (100% duty)
         VVT2_PIN_HIGH();
-        vvt2_pwm_state = true;
-        vvt2_max_pwm = true;
         if( configPage6.vvtEnabled == 0 ) { DISABLE_VVT_TIMER(); }
       }
-      else
-      {
-        vvt2_max_pwm = false;
-        ENABLE_VVT_TIMER();
-      }
+      else { enableVVTTimer(); }
     }
+    updateVVTPWM();
+    pwmOutputWrite(PWM_OUT_VVT2, (uint16_t)wmiPW * 50U); //WMI duty is in 0.5% steps
   }
 }
 
@@ -1107,6 +1139,7 @@ void boostDisable(void)
   currentStatus.boostDuty = 0;
   DISABLE_BOOST_TIMER(); //Turn off timer
   BOOST_PIN_LOW(); //Make sure solenoid is off (0% duty)
+  pwmOutputWrite(PWM_OUT_BOOST, 0U);
 }
 
 //The interrupt to control the Boost PWM
@@ -1139,123 +1172,14 @@ void boostDisable(void)
   }
 }
 
-//The interrupt to control the VVT PWM
+//The interrupt to control the VVT PWM. Both VVT outputs (Or VVT1 and WMI) are driven from this one compare. See softPWM.h
 #if defined(CORE_AVR)
   ISR(TIMER1_COMPB_vect) //cppcheck-suppress misra-c2012-8.2
 #else
   void vvtInterrupt(void) //Most ARM chips can simply call a function
 #endif
 {
-  if ( ((vvt1_pwm_state == false) || (vvt1_max_pwm == true)) && ((vvt2_pwm_state == false) || (vvt2_max_pwm == true)) )
-  {
-    if( (vvt1_pwm_value > 0) && (vvt1_max_pwm == false) ) //Don't toggle if at 0%
-    {
-      #if defined(CORE_TEENSY41)
-      VVT1_PIN_OFF();
-      #else
-      VVT1_PIN_ON();
-      #endif
-      vvt1_pwm_state = true;
-    }
-    if( (vvt2_pwm_value > 0) && (vvt2_max_pwm == false) ) //Don't toggle if at 0%
-    {
-      #if defined(CORE_TEENSY41)
-      VVT2_PIN_OFF();
-      #else
-      VVT2_PIN_ON();
-      #endif
-      vvt2_pwm_state = true;
-    }
-
-    if( (vvt1_pwm_state == true) && ((vvt1_pwm_value <= vvt2_pwm_value) || (vvt2_pwm_state == false)) )
-    {
-      SET_COMPARE(VVT_TIMER_COMPARE, VVT_TIMER_COUNTER + vvt1_pwm_value);
-      vvt1_pwm_cur_value = vvt1_pwm_value;
-      vvt2_pwm_cur_value = vvt2_pwm_value;
-      if (vvt1_pwm_value == vvt2_pwm_value) { nextVVT = 2; } //Next event is for both PWM
-      else { nextVVT = 0; } //Next event is for PWM0
-    }
-    else if( vvt2_pwm_state == true )
-    {
-      SET_COMPARE(VVT_TIMER_COMPARE, VVT_TIMER_COUNTER + vvt2_pwm_value);
-      vvt1_pwm_cur_value = vvt1_pwm_value;
-      vvt2_pwm_cur_value = vvt2_pwm_value;
-      nextVVT = 1; //Next event is for PWM1
-    }
-    else { SET_COMPARE(VVT_TIMER_COMPARE, VVT_TIMER_COUNTER + vvt_pwm_max_count); } //Shouldn't ever get here
-  }
-  else
-  {
-    if(nextVVT == 0)
-    {
-      if(vvt1_pwm_value < (long)vvt_pwm_max_count) //Don't toggle if at 100%
-      {
-        #if defined(CORE_TEENSY41)
-        VVT1_PIN_ON();
-        #else
-        VVT1_PIN_OFF();
-        #endif
-        vvt1_pwm_state = false;
-        vvt1_max_pwm = false;
-      }
-      else { vvt1_max_pwm = true; }
-      nextVVT = 1; //Next event is for PWM1
-      if(vvt2_pwm_state == true){ SET_COMPARE(VVT_TIMER_COMPARE, VVT_TIMER_COUNTER + (vvt2_pwm_cur_value - vvt1_pwm_cur_value) ); }
-      else
-      { 
-        SET_COMPARE(VVT_TIMER_COMPARE, VVT_TIMER_COUNTER + (vvt_pwm_max_count - vvt1_pwm_cur_value) );
-        nextVVT = 2; //Next event is for both PWM
-      }
-    }
-    else if (nextVVT == 1)
-    {
-      if(vvt2_pwm_value < (long)vvt_pwm_max_count) //Don't toggle if at 100%
-      {
-        #if defined(CORE_TEENSY41)
-        VVT2_PIN_ON();
-        #else
-        VVT2_PIN_OFF();
-        #endif
-        vvt2_pwm_state = false;
-        vvt2_max_pwm = false;
-      }
-      else { vvt2_max_pwm = true; }
-      nextVVT = 0; //Next event is for PWM0
-      if(vvt1_pwm_state == true) { SET_COMPARE(VVT_TIMER_COMPARE, VVT_TIMER_COUNTER + (vvt1_pwm_cur_value - vvt2_pwm_cur_value) ); }
-      else
-      { 
-        SET_COMPARE(VVT_TIMER_COMPARE, VVT_TIMER_COUNTER + (vvt_pwm_max_count - vvt2_pwm_cur_value) );
-        nextVVT = 2; //Next event is for both PWM
-      }
-    }
-    else
-    {
-      if(vvt1_pwm_value < (long)vvt_pwm_max_count) //Don't toggle if at 100%
-      {
-       #if defined(CORE_TEENSY41)
-        VVT1_PIN_ON();
-        #else
-        VVT1_PIN_OFF();
-        #endif
-        vvt1_pwm_state = false;
-        vvt1_max_pwm = false;
-        SET_COMPARE(VVT_TIMER_COMPARE, VVT_TIMER_COUNTER + (vvt_pwm_max_count - vvt1_pwm_cur_value) );
-      }
-      else { vvt1_max_pwm = true; }
-      if(vvt2_pwm_value < (long)vvt_pwm_max_count) //Don't toggle if at 100%
-      {
-        #if defined(CORE_TEENSY41)
-        VVT2_PIN_ON();
-        #else
-        VVT2_PIN_OFF();
-        #endif
-        vvt2_pwm_state = false;
-        vvt2_max_pwm = false;
-        SET_COMPARE(VVT_TIMER_COMPARE, VVT_TIMER_COUNTER + (vvt_pwm_max_count - vvt2_pwm_cur_value) );
-      }
-      else { vvt2_max_pwm = true; }
-    }
-  }
+  SET_COMPARE(VVT_TIMER_COMPARE, VVT_TIMER_COUNTER + softPWMInterrupt(vvtPWM));
 }
 
 #if defined(PWM_FAN_AVAILABLE)
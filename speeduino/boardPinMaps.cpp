@@ -0,0 +1,1522 @@
+/** @file
+ * The default pin mappings of each board (Selected by configPage2.pinMapping).
+ *
+ * Each board is a run of entries in a single table that is held in flash (PROGMEM on AVR), starting with a
+ * BOARD_PIN_MAP() marker. applyBoardPinMap() copies the values of the selected board into the pin globals. Entries are
+ * applied in order, so a later entry for the same pin (Eg in a core specific block) overrides an earlier one. Pins that
+ * a board does not list are left unchanged.
+ *
+ * Adding a board is a matter of adding its entries to the table. Any pin global that is not yet in
+ * BOARD_PIN_TARGETS (boardPinMaps.h) must be added there first.
+ */
+#include "globals.h"
+#include "boardPinMaps.h"
+#include "acc_mc33810.h"
+#include "utilities.h"
+
+#define BOARD_PIN(target, pin)      { BOARD_TARGET_##target, (uint8_t)(pin) }
+#define BOARD_PIN_MAP(boardID)      { BOARD_TARGET_BOARD, (boardID) }
+#define BOARD_PIN_MAP_DEFAULT()     { BOARD_TARGET_DEFAULT, 0 }
+#define BOARD_PIN_MAP_END()         { BOARD_TARGET_END, 0 }
+
+static constexpr board_pin_t boardPinMaps[] PROGMEM = {
+  //Note: Case 0 (Speeduino v0.1) was removed in Nov 2020 to handle default case for blank FRAM modules
+
+  BOARD_PIN_MAP(1),
+  #ifndef SMALL_FLASH_MODE //No support for bluepill here anyway
+    //Pin mappings as per the v0.2 shield
+    BOARD_PIN(pinInjector1, 8), //Output pin injector 1 is on
+    BOARD_PIN(pinInjector2, 9), //Output pin injector 2 is on
+    BOARD_PIN(pinInjector3, 10), //Output pin injector 3 is on
+    BOARD_PIN(pinInjector4, 11), //Output pin injector 4 is on
+    BOARD_PIN(pinInjector5, 12), //Output pin injector 5 is on
+    BOARD_PIN(pinCoil1, 28), //Pin for coil 1
+    BOARD_PIN(pinCoil2, 24), //Pin for coil 2
+    BOARD_PIN(pinCoil3, 40), //Pin for coil 3
+    BOARD_PIN(pinCoil4, 36), //Pin for coil 4
+    BOARD_PIN(pinCoil5, 34), //Pin for coil 5 PLACEHOLDER value for now
+    BOARD_PIN(pinTrigger, 20), //The CAS pin
+    BOARD_PIN(pinTrigger2, 21), //The Cam Sensor pin
+    BOARD_PIN(pinTrigger3, 3), //The Cam sensor 2 pin
+    BOARD_PIN(pinTPS, A2), //TPS input pin
+    BOARD_PIN(pinMAP, A3), //MAP sensor pin
+    BOARD_PIN(pinIAT, A0), //IAT sensor pin
+    BOARD_PIN(pinCLT, A1), //CLS sensor pin
+    BOARD_PIN(pinO2, A8), //O2 Sensor pin
+    BOARD_PIN(pinBat, A4), //Battery reference voltage pin
+    BOARD_PIN(pinDisplayReset, 48), // OLED reset pin
+    BOARD_PIN(pinTachOut, 49), //Tacho output pin
+    BOARD_PIN(pinIdle1, 30), //Single wire idle control
+    BOARD_PIN(pinIdle2, 31), //2 wire idle control
+    BOARD_PIN(pinStepperDir, 16), //Direction pin  for DRV8825 driver
+    BOARD_PIN(pinStepperStep, 17), //Step pin for DRV8825 driver
+    BOARD_PIN(pinFan, 47), //Pin for the fan output
+    BOARD_PIN(pinFuelPump, 4), //Fuel pump output
+    BOARD_PIN(pinFlex, 2), // Flex sensor (Must be external interrupt enabled)
+    BOARD_PIN(pinResetControl, 43), //Reset control output
+  #endif
+  BOARD_PIN_MAP(2),
+  #ifndef SMALL_FLASH_MODE //No support for bluepill here anyway
+    //Pin mappings as per the v0.3 shield
+    BOARD_PIN(pinInjector1, 8), //Output pin injector 1 is on
+    BOARD_PIN(pinInjector2, 9), //Output pin injector 2 is on
+    BOARD_PIN(pinInjector3, 10), //Output pin injector 3 is on
+    BOARD_PIN(pinInjector4, 11), //Output pin injector 4 is on
+    BOARD_PIN(pinInjector5, 12), //Output pin injector 5 is on
+    BOARD_PIN(pinCoil1, 28), //Pin for coil 1
+    BOARD_PIN(pinCoil2, 24), //Pin for coil 2
+    BOARD_PIN(pinCoil3, 40), //Pin for coil 3
+    BOARD_PIN(pinCoil4, 36), //Pin for coil 4
+    BOARD_PIN(pinCoil5, 34), //Pin for coil 5 PLACEHOLDER value for now
+    BOARD_PIN(pinTrigger, 19), //The CAS pin
+    BOARD_PIN(pinTrigger2, 18), //The Cam Sensor pin
+    BOARD_PIN(pinTrigger3, 3), //The Cam sensor 2 pin
+    BOARD_PIN(pinTPS, A2), //TPS input pin
+    BOARD_PIN(pinMAP, A3), //MAP sensor pin
+    BOARD_PIN(pinIAT, A0), //IAT sensor pin
+    BOARD_PIN(pinCLT, A1), //CLS sensor pin
+    BOARD_PIN(pinO2, A8), //O2 Sensor pin
+    BOARD_PIN(pinBat, A4), //Battery reference voltage pin
+    BOARD_PIN(pinDisplayReset, 48), // OLED reset pin
+    BOARD_PIN(pinTachOut, 49), //Tacho output pin
+    BOARD_PIN(pinIdle1, 5), //Single wire idle control
+    BOARD_PIN(pinIdle2, 53), //2 wire idle control
+    BOARD_PIN(pinBoost, 7), //Boost control
+    BOARD_PIN(pinVVT_1, 6), //Default VVT output
+    BOARD_PIN(pinVVT_2, 48), //Default VVT2 output
+    BOARD_PIN(pinFuelPump, 4), //Fuel pump output
+    BOARD_PIN(pinStepperDir, 16), //Direction pin  for DRV8825 driver
+    BOARD_PIN(pinStepperStep, 17), //Step pin for DRV8825 driver
+    BOARD_PIN(pinStepperEnable, 26), //Enable pin for DRV8825
+    BOARD_PIN(pinFan, A13), //Pin for the fan output
+    BOARD_PIN(pinLaunch, 51), //Can be overwritten below
+    BOARD_PIN(pinFlex, 2), // Flex sensor (Must be external interrupt enabled)
+    BOARD_PIN(pinResetControl, 50), //Reset control output
+    BOARD_PIN(pinBaro, A5),
+    BOARD_PIN(pinVSS, 20),
+
+    #if defined(CORE_TEENSY35)
+      BOARD_PIN(pinTrigger, 23),
+      BOARD_PIN(pinStepperDir, 33),
+      BOARD_PIN(pinStepperStep, 34),
+      BOARD_PIN(pinCoil1, 31),
+      BOARD_PIN(pinTachOut, 28),
+      BOARD_PIN(pinFan, 27),
+      BOARD_PIN(pinCoil4, 21),
+      BOARD_PIN(pinCoil3, 30),
+      BOARD_PIN(pinO2, A22),
+    #endif
+  #endif
+
+  BOARD_PIN_MAP(3),
+    //Pin mappings as per the v0.4 shield
+    BOARD_PIN(pinInjector1, 8), //Output pin injector 1 is on
+    BOARD_PIN(pinInjector2, 9), //Output pin injector 2 is on
+    BOARD_PIN(pinInjector3, 10), //Output pin injector 3 is on
+    BOARD_PIN(pinInjector4, 11), //Output pin injector 4 is on
+    BOARD_PIN(pinInjector5, 12), //Output pin injector 5 is on
+    BOARD_PIN(pinInjector6, 50), //CAUTION: Uses the same as Coil 4 below. 
+    BOARD_PIN(pinCoil1, 40), //Pin for coil 1
+    BOARD_PIN(pinCoil2, 38), //Pin for coil 2
+    BOARD_PIN(pinCoil3, 52), //Pin for coil 3
+    BOARD_PIN(pinCoil4, 50), //Pin for coil 4
+    BOARD_PIN(pinCoil5, 34), //Pin for coil 5 PLACEHOLDER value for now
+    BOARD_PIN(pinTrigger, 19), //The CAS pin
+    BOARD_PIN(pinTrigger2, 18), //The Cam Sensor pin
+    BOARD_PIN(pinTrigger3, 3), //The Cam sensor 2 pin
+    BOARD_PIN(pinTPS, A2), //TPS input pin
+    BOARD_PIN(pinMAP, A3), //MAP sensor pin
+    BOARD_PIN(pinIAT, A0), //IAT sensor pin
+    BOARD_PIN(pinCLT, A1), //CLS sensor pin
+    BOARD_PIN(pinO2, A8), //O2 Sensor pin
+    BOARD_PIN(pinBat, A4), //Battery reference voltage pin
+    BOARD_PIN(pinDisplayReset, 48), // OLED reset pin
+    BOARD_PIN(pinTachOut, 49), //Tacho output pin  (Goes to ULN2803)
+    BOARD_PIN(pinIdle1, 5), //Single wire idle control
+    BOARD_PIN(pinIdle2, 6), //2 wire idle control
+    BOARD_PIN(pinBoost, 7), //Boost control
+    BOARD_PIN(pinVVT_1, 4), //Default VVT output
+    BOARD_PIN(pinVVT_2, 48), //Default VVT2 output
+    BOARD_PIN(pinFuelPump, 45), //Fuel pump output  (Goes to ULN2803)
+    BOARD_PIN(pinStepperDir, 16), //Direction pin  for DRV8825 driver
+    BOARD_PIN(pinStepperStep, 17), //Step pin for DRV8825 driver
+    BOARD_PIN(pinStepperEnable, 24), //Enable pin for DRV8825
+    BOARD_PIN(pinFan, 47), //Pin for the fan output (Goes to ULN2803)
+    BOARD_PIN(pinLaunch, 51), //Can be overwritten below
+    BOARD_PIN(pinFlex, 2), // Flex sensor (Must be external interrupt enabled)
+    BOARD_PIN(pinResetControl, 43), //Reset control output
+    BOARD_PIN(pinBaro, A5),
+    BOARD_PIN(pinVSS, 20),
+    BOARD_PIN(pinWMIEmpty, 46),
+    BOARD_PIN(pinWMIIndicator, 44),
+    BOARD_PIN(pinWMIEnabled, 42),
+
+    #if defined(CORE_TEENSY35)
+      BOARD_PIN(pinInjector6, 51),
+
+      BOARD_PIN(pinTrigger, 23),
+      BOARD_PIN(pinTrigger2, 36),
+      BOARD_PIN(pinStepperDir, 34),
+      BOARD_PIN(pinStepperStep, 35),
+      BOARD_PIN(pinCoil1, 31),
+      BOARD_PIN(pinCoil2, 32),
+      BOARD_PIN(pinTachOut, 28),
+      BOARD_PIN(pinFan, 27),
+      BOARD_PIN(pinCoil4, 29),
+      BOARD_PIN(pinCoil3, 30),
+      BOARD_PIN(pinO2, A22),
+
+      //Make sure the CAN pins aren't overwritten
+      BOARD_PIN(pinTrigger3, 54),
+      BOARD_PIN(pinVVT_1, 55),
+
+    #elif defined(CORE_TEENSY41)
+      //These are only to prevent lockups or weird behaviour on T4.1 when this board is used as the default
+      BOARD_PIN(pinBaro, A4),
+      BOARD_PIN(pinMAP, A5),
+      BOARD_PIN(pinTPS, A3), //TPS input pin
+      BOARD_PIN(pinIAT, A0), //IAT sensor pin
+      BOARD_PIN(pinCLT, A1), //CLS sensor pin
+      BOARD_PIN(pinO2, A2), //O2 Sensor pin
+      BOARD_PIN(pinBat, A15), //Battery reference voltage pin. Needs Alpha4+
+      BOARD_PIN(pinLaunch, 34), //Can be overwritten below
+      BOARD_PIN(pinVSS, 35),
+      BOARD_PIN(pinSpareTemp2, A16), //WRONG! Needs updating!!
+      BOARD_PIN(pinSpareTemp2, A17), //WRONG! Needs updating!!
+
+      BOARD_PIN(pinTrigger, 20), //The CAS pin
+      BOARD_PIN(pinTrigger2, 21), //The Cam Sensor pin
+      BOARD_PIN(pinTrigger3, 24),
+
+      BOARD_PIN(pinStepperDir, 34),
+      BOARD_PIN(pinStepperStep, 35),
+
+      BOARD_PIN(pinCoil1, 31),
+      BOARD_PIN(pinCoil2, 32),
+      BOARD_PIN(pinCoil4, 29),
+      BOARD_PIN(pinCoil3, 30),
+
+      BOARD_PIN(pinTachOut, 28),
+      BOARD_PIN(pinFan, 27),
+      BOARD_PIN(pinFuelPump, 33),
+      BOARD_PIN(pinWMIEmpty, 34),
+      BOARD_PIN(pinWMIIndicator, 35),
+      BOARD_PIN(pinWMIEnabled, 36),
+    #elif defined(STM32F407xx)
+   //Pin definitions for experimental board Tjeerd
+      //Black F407VE wiki.stm32duino.com/index.php?title=STM32F407
+
+      //******************************************
+      //******** PORTA CONNECTIONS ***************
+      //******************************************
+      /* = PA0 */ //Wakeup ADC123
+      // = PA1;
+      // = PA2;
+      // = PA3;
+      // = PA4;
+      /* = PA5; */ //ADC12
+      /* = PA6; */ //ADC12 LED_BUILTIN_1
+      BOARD_PIN(pinFuelPump, PA7), //ADC12 LED_BUILTIN_2
+      BOARD_PIN(pinCoil3, PA8),
+      /* = PA9 */ //TXD1
+      /* = PA10 */ //RXD1
+      /* = PA11 */ //(DO NOT USE FOR SPEEDUINO) USB
+      /* = PA12 */ //(DO NOT USE FOR SPEEDUINO) USB
+      /* = PA13 */ //(DO NOT USE FOR SPEEDUINO) NOT ON GPIO - DEBUG ST-LINK
+      /* = PA14 */ //(DO NOT USE FOR SPEEDUINO) NOT ON GPIO - DEBUG ST-LINK
+      /* = PA15 */ //(DO NOT USE FOR SPEEDUINO) NOT ON GPIO - DEBUG ST-LINK
+
+      //******************************************
+      //******** PORTB CONNECTIONS ***************
+      //******************************************
+      /* = PB0; */ //(DO NOT USE FOR SPEEDUINO) ADC123 - SPI FLASH CHIP CS pin
+      BOARD_PIN(pinBaro, PB1), //ADC12
+      /* = PB2; */ //(DO NOT USE FOR SPEEDUINO) BOOT1
+      /* = PB3; */ //(DO NOT USE FOR SPEEDUINO) SPI1_SCK FLASH CHIP
+      /* = PB4; */ //(DO NOT USE FOR SPEEDUINO) SPI1_MISO FLASH CHIP
+      /* = PB5; */ //(DO NOT USE FOR SPEEDUINO) SPI1_MOSI FLASH CHIP
+      /* = PB6; */ //NRF_CE
+      /* = PB7; */ //NRF_CS
+      /* = PB8; */ //NRF_IRQ
+      BOARD_PIN(pinCoil2, PB9), //
+      /* = PB9; */ //
+      BOARD_PIN(pinCoil4, PB10), //TXD3
+      BOARD_PIN(pinIdle1, PB11), //RXD3
+      BOARD_PIN(pinIdle2, PB12), //
+      BOARD_PIN(pinBoost, PB12), //
+      /* = PB13; */ //SPI2_SCK
+      /* = PB14; */ //SPI2_MISO
+      /* = PB15; */ //SPI2_MOSI
+
+      //******************************************
+      //******** PORTC CONNECTIONS ***************
+      //******************************************
+      BOARD_PIN(pinMAP, PC0), //ADC123 
+      BOARD_PIN(pinTPS, PC1), //ADC123
+      BOARD_PIN(pinIAT, PC2), //ADC123
+      BOARD_PIN(pinCLT, PC3), //ADC123
+      BOARD_PIN(pinO2, PC4), //ADC12
+      BOARD_PIN(pinBat, PC5), //ADC12
+      BOARD_PIN(pinVVT_1, PC6), //
+      BOARD_PIN(pinDisplayReset, PC7), //
+      /* = PC8; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_D0
+      /* = PC9; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_D1
+      /* = PC10; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_D2
+      /* = PC11; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_D3
+      /* = PC12; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_SCK
+      BOARD_PIN(pinTachOut, PC13), //
+      /* = PC14; */ //(DO NOT USE FOR SPEEDUINO) - OSC32_IN
+      /* = PC15; */ //(DO NOT USE FOR SPEEDUINO) - OSC32_OUT
+
+      //******************************************
+      //******** PORTD CONNECTIONS ***************
+      //******************************************
+      /* = PD0; */ //CANRX
+      /* = PD1; */ //CANTX
+      /* = PD2; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_CMD
+      BOARD_PIN(pinVVT_2, PD3), //
+      BOARD_PIN(pinFlex, PD4),
+      /* = PD5;*/ //TXD2
+      /* = PD6; */ //RXD2
+      BOARD_PIN(pinCoil1, PD7), //
+      /* = PD8; */ //
+      BOARD_PIN(pinCoil5, PD9), //
+      /* = PD10; */ //
+      /* = PD11; */ //
+      BOARD_PIN(pinInjector1, PD12), //
+      BOARD_PIN(pinInjector2, PD13), //
+      BOARD_PIN(pinInjector3, PD14), //
+      BOARD_PIN(pinInjector4, PD15), //
+
+      //******************************************
+      //******** PORTE CONNECTIONS ***************
+      //******************************************
+      BOARD_PIN(pinTrigger, PE0), //
+      BOARD_PIN(pinTrigger2, PE1), //
+      BOARD_PIN(pinStepperEnable, PE2), //
+      /* = PE3; */ //ONBOARD KEY1
+      /* = PE4; */ //ONBOARD KEY2
+      BOARD_PIN(pinStepperStep, PE5), //
+      BOARD_PIN(pinFan, PE6), //
+      BOARD_PIN(pinStepperDir, PE7), //
+      /* = PE8; */ //
+      /* = PE9; */ //
+      /* = PE10; */ //
+      BOARD_PIN(pinInjector5, PE11), //
+      BOARD_PIN(pinInjector6, PE12), //
+      /* = PE13; */ //
+      /* = PE14; */ //
+      /* = PE15; */ //
+
+    #elif defined(CORE_STM32)
+      //https://github.com/stm32duino/Arduino_Core_STM32/blob/master/variants/Generic_F411Cx/variant.h#L28
+      //pins PA12, PA11 are used for USB or CAN couldn't be used for GPIO
+      //pins PB12, PB13, PB14 and PB15 are used to SPI FLASH
+      //PB2 can't be used as input because it's the BOOT pin
+      BOARD_PIN(pinInjector1, PB7), //Output pin injector 1 is on
+      BOARD_PIN(pinInjector2, PB6), //Output pin injector 2 is on
+      BOARD_PIN(pinInjector3, PB5), //Output pin injector 3 is on
+      BOARD_PIN(pinInjector4, PB4), //Output pin injector 4 is on
+      BOARD_PIN(pinCoil1, PB9), //Pin for coil 1
+      BOARD_PIN(pinCoil2, PB8), //Pin for coil 2
+      BOARD_PIN(pinCoil3, PB3), //Pin for coil 3
+      BOARD_PIN(pinCoil4, PA15), //Pin for coil 4
+      BOARD_PIN(pinTPS, A2), //TPS input pin
+      BOARD_PIN(pinMAP, A3), //MAP sensor pin
+      BOARD_PIN(pinIAT, A0), //IAT sensor pin
+      BOARD_PIN(pinCLT, A1), //CLS sensor pin
+      BOARD_PIN(pinO2, A8), //O2 Sensor pin
+      BOARD_PIN(pinBat, A4), //Battery reference voltage pin
+      BOARD_PIN(pinBaro, A3), //Same as pinMAP
+      BOARD_PIN(pinTachOut, PB1), //Tacho output pin  (Goes to ULN2803)
+      BOARD_PIN(pinIdle1, PB2), //Single wire idle control
+      BOARD_PIN(pinIdle2, PB10), //2 wire idle control
+      BOARD_PIN(pinBoost, PA6), //Boost control
+      BOARD_PIN(pinStepperDir, PB10), //Direction pin  for DRV8825 driver
+      BOARD_PIN(pinStepperStep, PB2), //Step pin for DRV8825 driver
+      BOARD_PIN(pinFuelPump, PA8), //Fuel pump output
+      BOARD_PIN(pinFan, PA5), //Pin for the fan output (Goes to ULN2803)
+      //external interrupt enabled pins
+      BOARD_PIN(pinFlex, PC14), // Flex sensor (Must be external interrupt enabled)
+      BOARD_PIN(pinTrigger, PC13), //The CAS pin also led pin so bad idea
+      BOARD_PIN(pinTrigger2, PC15), //The Cam Sensor pin
+    #endif
+
+  BOARD_PIN_MAP(6),
+    #ifndef SMALL_FLASH_MODE
+    //Pin mappings as per the 2001-05 MX5 PNP shield
+    BOARD_PIN(pinInjector1, 44), //Output pin injector 1 is on
+    BOARD_PIN(pinInjector2, 46), //Output pin injector 2 is on
+    BOARD_PIN(pinInjector3, 47), //Output pin injector 3 is on
+    BOARD_PIN(pinInjector4, 45), //Output pin injector 4 is on
+    BOARD_PIN(pinInjector5, 14), //Output pin injector 5 is on
+    BOARD_PIN(pinCoil1, 42), //Pin for coil 1
+    BOARD_PIN(pinCoil2, 43), //Pin for coil 2
+    BOARD_PIN(pinCoil3, 32), //Pin for coil 3
+    BOARD_PIN(pinCoil4, 33), //Pin for coil 4
+    BOARD_PIN(pinCoil5, 34), //Pin for coil 5 PLACEHOLDER value for now
+    BOARD_PIN(pinTrigger, 19), //The CAS pin
+    BOARD_PIN(pinTrigger2, 18), //The Cam Sensor pin
+    BOARD_PIN(pinTrigger3, 2), //The Cam sensor 2 pin
+    BOARD_PIN(pinTPS, A2), //TPS input pin
+    BOARD_PIN(pinMAP, A5), //MAP sensor pin
+    BOARD_PIN(pinIAT, A0), //IAT sensor pin
+    BOARD_PIN(pinCLT, A1), //CLS sensor pin
+    BOARD_PIN(pinO2, A3), //O2 Sensor pin
+    BOARD_PIN(pinBat, A4), //Battery reference voltage pin
+    BOARD_PIN(pinDisplayReset, 48), // OLED reset pin
+    BOARD_PIN(pinTachOut, 23), //Tacho output pin  (Goes to ULN2803)
+    BOARD_PIN(pinIdle1, 5), //Single wire idle control
+    BOARD_PIN(pinBoost, 4),
+    BOARD_PIN(pinVVT_1, 11), //Default VVT output
+    BOARD_PIN(pinVVT_2, 48), //Default VVT2 output
+    BOARD_PIN(pinIdle2, 4), //2 wire idle control (Note this is shared with boost!!!)
+    BOARD_PIN(pinFuelPump, 40), //Fuel pump output
+    BOARD_PIN(pinStepperDir, 16), //Direction pin  for DRV8825 driver
+    BOARD_PIN(pinStepperStep, 17), //Step pin for DRV8825 driver
+    BOARD_PIN(pinStepperEnable, 24),
+    BOARD_PIN(pinFan, 41), //Pin for the fan output
+    BOARD_PIN(pinLaunch, 12), //Can be overwritten below
+    BOARD_PIN(pinFlex, 3), // Flex sensor (Must be external interrupt enabled)
+    BOARD_PIN(pinResetControl, 39), //Reset control output
+    #endif
+    //This is NOT correct. It has not yet been tested with this board
+    #if defined(CORE_TEENSY35)
+      BOARD_PIN(pinTrigger, 23),
+      BOARD_PIN(pinTrigger2, 36),
+      BOARD_PIN(pinStepperDir, 34),
+      BOARD_PIN(pinStepperStep, 35),
+      BOARD_PIN(pinCoil1, 33), //Done
+      BOARD_PIN(pinCoil2, 24), //Done
+      BOARD_PIN(pinCoil3, 51), //Won't work (No mapping for pin 32)
+      BOARD_PIN(pinCoil4, 52), //Won't work (No mapping for pin 33)
+      BOARD_PIN(pinFuelPump, 26), //Requires PVT4 adapter or above
+      BOARD_PIN(pinFan, 50), //Won't work (No mapping for pin 35)
+      BOARD_PIN(pinTachOut, 28), //Done
+    #endif
+
+  BOARD_PIN_MAP(8),
+    #ifndef SMALL_FLASH_MODE
+    //Pin mappings as per the 1996-97 MX5 PNP shield
+    BOARD_PIN(pinInjector1, 11), //Output pin injector 1 is on
+    BOARD_PIN(pinInjector2, 10), //Output pin injector 2 is on
+    BOARD_PIN(pinInjector3, 9), //Output pin injector 3 is on
+    BOARD_PIN(pinInjector4, 8), //Output pin injector 4 is on
+    BOARD_PIN(pinInjector5, 14), //Output pin injector 5 is on
+    BOARD_PIN(pinCoil1, 39), //Pin for coil 1
+    BOARD_PIN(pinCoil2, 41), //Pin for coil 2
+    BOARD_PIN(pinCoil3, 32), //Pin for coil 3
+    BOARD_PIN(pinCoil4, 33), //Pin for coil 4
+    BOARD_PIN(pinCoil5, 34), //Pin for coil 5 PLACEHOLDER value for now
+    BOARD_PIN(pinTrigger, 19), //The CAS pin
+    BOARD_PIN(pinTrigger2, 18), //The Cam Sensor pin
+    BOARD_PIN(pinTPS, A2), //TPS input pin
+    BOARD_PIN(pinMAP, A5), //MAP sensor pin
+    BOARD_PIN(pinIAT, A0), //IAT sensor pin
+    BOARD_PIN(pinCLT, A1), //CLS sensor pin
+    BOARD_PIN(pinO2, A3), //O2 Sensor pin
+    BOARD_PIN(pinBat, A4), //Battery reference voltage pin
+    BOARD_PIN(pinDisplayReset, 48), // OLED reset pin
+    BOARD_PIN(pinTachOut, A9), //Tacho output pin  (Goes to ULN2803)
+    BOARD_PIN(pinIdle1, 2), //Single wire idle control
+    BOARD_PIN(pinBoost, 4),
+    BOARD_PIN(pinIdle2, 4), //2 wire idle control (Note this is shared with boost!!!)
+    BOARD_PIN(pinFuelPump, 49), //Fuel pump output
+    BOARD_PIN(pinStepperDir, 16), //Direction pin  for DRV8825 driver
+    BOARD_PIN(pinStepperStep, 17), //Step pin for DRV8825 driver
+    BOARD_PIN(pinStepperEnable, 24),
+    BOARD_PIN(pinFan, 35), //Pin for the fan output
+    BOARD_PIN(pinLaunch, 37), //Can be overwritten below
+    BOARD_PIN(pinFlex, 3), // Flex sensor (Must be external interrupt enabled)
+    BOARD_PIN(pinResetControl, 44), //Reset control output
+
+    //This is NOT correct. It has not yet been tested with this board
+    #if defined(CORE_TEENSY35)
+      BOARD_PIN(pinTrigger, 23),
+      BOARD_PIN(pinTrigger2, 36),
+      BOARD_PIN(pinStepperDir, 34),
+      BOARD_PIN(pinStepperStep, 35),
+      BOARD_PIN(pinCoil1, 33), //Done
+      BOARD_PIN(pinCoil2, 24), //Done
+      BOARD_PIN(pinCoil3, 51), //Won't work (No mapping for pin 32)
+      BOARD_PIN(pinCoil4, 52), //Won't work (No mapping for pin 33)
+      BOARD_PIN(pinFuelPump, 26), //Requires PVT4 adapter or above
+      BOARD_PIN(pinFan, 50), //Won't work (No mapping for pin 35)
+      BOARD_PIN(pinTachOut, 28), //Done
+    #endif
+    #endif
+
+  BOARD_PIN_MAP(9),
+   #ifndef SMALL_FLASH_MODE
+    //Pin mappings as per the 89-95 MX5 PNP shield
+    BOARD_PIN(pinInjector1, 11), //Output pin injector 1 is on
+    BOARD_PIN(pinInjector2, 10), //Output pin injector 2 is on
+    BOARD_PIN(pinInjector3, 9), //Output pin injector 3 is on
+    BOARD_PIN(pinInjector4, 8), //Output pin injector 4 is on
+    BOARD_PIN(pinInjector5, 14), //Output pin injector 5 is on
+    BOARD_PIN(pinCoil1, 39), //Pin for coil 1
+    BOARD_PIN(pinCoil2, 41), //Pin for coil 2
+    BOARD_PIN(pinCoil3, 32), //Pin for coil 3
+    BOARD_PIN(pinCoil4, 33), //Pin for coil 4
+    BOARD_PIN(pinCoil5, 34), //Pin for coil 5 PLACEHOLDER value for now
+    BOARD_PIN(pinTrigger, 19), //The CAS pin
+    BOARD_PIN(pinTrigger2, 18), //The Cam Sensor pin
+    BOARD_PIN(pinTPS, A2), //TPS input pin
+    BOARD_PIN(pinMAP, A5), //MAP sensor pin
+    BOARD_PIN(pinIAT, A0), //IAT sensor pin
+    BOARD_PIN(pinCLT, A1), //CLS sensor pin
+    BOARD_PIN(pinO2, A3), //O2 Sensor pin
+    BOARD_PIN(pinBat, A4), //Battery reference voltage pin
+    BOARD_PIN(pinDisplayReset, 48), // OLED reset pin
+    BOARD_PIN(pinTachOut, 49), //Tacho output pin  (Goes to ULN2803)
+    BOARD_PIN(pinIdle1, 2), //Single wire idle control
+    BOARD_PIN(pinBoost, 4),
+    BOARD_PIN(pinIdle2, 4), //2 wire idle control (Note this is shared with boost!!!)
+    BOARD_PIN(pinFuelPump, 37), //Fuel pump output
+    //Note that there is no stepper driver output on the PNP boards. These pins are unconnected and remain here just to prevent issues with random pin numbers occurring
+    BOARD_PIN(pinStepperEnable, 15), //Enable pin for the DRV8825
+    BOARD_PIN(pinStepperDir, 16), //Direction pin  for DRV8825 driver
+    BOARD_PIN(pinStepperStep, 17), //Step pin for DRV8825 driver
+    BOARD_PIN(pinFan, 35), //Pin for the fan output
+    BOARD_PIN(pinLaunch, 12), //Can be overwritten below
+    BOARD_PIN(pinFlex, 3), // Flex sensor (Must be external interrupt enabled)
+    BOARD_PIN(pinResetControl, 44), //Reset control output
+    BOARD_PIN(pinVSS, 20),
+    BOARD_PIN(pinIdleUp, 48),
+    BOARD_PIN(pinCTPS, 47),
+    #endif
+    #if defined(CORE_TEENSY35)
+      BOARD_PIN(pinTrigger, 23),
+      BOARD_PIN(pinTrigger2, 36),
+      BOARD_PIN(pinStepperDir, 34),
+      BOARD_PIN(pinStepperStep, 35),
+      BOARD_PIN(pinCoil1, 33), //Done
+      BOARD_PIN(pinCoil2, 24), //Done
+      BOARD_PIN(pinCoil3, 51), //Won't work (No mapping for pin 32)
+      BOARD_PIN(pinCoil4, 52), //Won't work (No mapping for pin 33)
+      BOARD_PIN(pinFuelPump, 26), //Requires PVT4 adapter or above
+      BOARD_PIN(pinFan, 50), //Won't work (No mapping for pin 35)
+      BOARD_PIN(pinTachOut, 28), //Done
+    #endif
+
+  BOARD_PIN_MAP(10),
+  #ifndef SMALL_FLASH_MODE //No support for bluepill here anyway
+    //Pin mappings for user turtanas PCB
+    BOARD_PIN(pinInjector1, 4), //Output pin injector 1 is on
+    BOARD_PIN(pinInjector2, 5), //Output pin injector 2 is on
+    BOARD_PIN(pinInjector3, 6), //Output pin injector 3 is on
+    BOARD_PIN(pinInjector4, 7), //Output pin injector 4 is on
+    BOARD_PIN(pinInjector5, 8), //Placeholder only - NOT USED
+    BOARD_PIN(pinInjector6, 9), //Placeholder only - NOT USED
+    BOARD_PIN(pinInjector7, 10), //Placeholder only - NOT USED
+    BOARD_PIN(pinInjector8, 11), //Placeholder only - NOT USED
+    BOARD_PIN(pinCoil1, 24), //Pin for coil 1
+    BOARD_PIN(pinCoil2, 28), //Pin for coil 2
+    BOARD_PIN(pinCoil3, 36), //Pin for coil 3
+    BOARD_PIN(pinCoil4, 40), //Pin for coil 4
+    BOARD_PIN(pinCoil5, 34), //Pin for coil 5 PLACEHOLDER value for now
+    BOARD_PIN(pinTrigger, 18), //The CAS pin
+    BOARD_PIN(pinTrigger2, 19), //The Cam Sensor pin
+    BOARD_PIN(pinTPS, A2), //TPS input pin
+    BOARD_PIN(pinMAP, A3), //MAP sensor pin
+    BOARD_PIN(pinMAP2, A8), //MAP2 sensor pin
+    BOARD_PIN(pinIAT, A0), //IAT sensor pin
+    BOARD_PIN(pinCLT, A1), //CLS sensor pin
+    BOARD_PIN(pinO2, A4), //O2 Sensor pin
+    BOARD_PIN(pinBat, A7), //Battery reference voltage pin
+    BOARD_PIN(pinDisplayReset, 48), // OLED reset pin
+    BOARD_PIN(pinSpareTemp1, A6),
+    BOARD_PIN(pinSpareTemp2, A5),
+    BOARD_PIN(pinTachOut, 41), //Tacho output pin transistor is missing 2n2222 for this and 1k for 12v
+    BOARD_PIN(pinFuelPump, 42), //Fuel pump output 2n2222
+    BOARD_PIN(pinFan, 47), //Pin for the fan output
+    BOARD_PIN(pinTachOut, 49), //Tacho output pin
+    BOARD_PIN(pinFlex, 2), // Flex sensor (Must be external interrupt enabled)
+    BOARD_PIN(pinResetControl, 26), //Reset control output
+
+  #endif
+
+  BOARD_PIN_MAP(20),
+  #if defined(CORE_AVR) && !defined(SMALL_FLASH_MODE) //No support for bluepill here anyway
+    //Pin mappings as per the Plazomat In/Out shields Rev 0.1
+    BOARD_PIN(pinInjector1, 8), //Output pin injector 1 is on
+    BOARD_PIN(pinInjector2, 9), //Output pin injector 2 is on
+    BOARD_PIN(pinInjector3, 10), //Output pin injector 3 is on
+    BOARD_PIN(pinInjector4, 11), //Output pin injector 4 is on
+    BOARD_PIN(pinInjector5, 12), //Output pin injector 5 is on
+    BOARD_PIN(pinCoil1, 28), //Pin for coil 1
+    BOARD_PIN(pinCoil2, 24), //Pin for coil 2
+    BOARD_PIN(pinCoil3, 40), //Pin for coil 3
+    BOARD_PIN(pinCoil4, 36), //Pin for coil 4
+    BOARD_PIN(pinCoil5, 34), //Pin for coil 5 PLACEHOLDER value for now
+    BOARD_PIN(pinSpareOut1, 4), //Spare LSD Output 1(PWM)
+    BOARD_PIN(pinSpareOut2, 5), //Spare LSD Output 2(PWM)
+    BOARD_PIN(pinSpareOut3, 6), //Spare LSD Output 3(PWM)
+    BOARD_PIN(pinSpareOut4, 7), //Spare LSD Output 4(PWM)
+    BOARD_PIN(pinSpareOut5, 50), //Spare LSD Output 5(digital)
+    BOARD_PIN(pinSpareOut6, 52), //Spare LSD Output 6(digital)
+    BOARD_PIN(pinTrigger, 20), //The CAS pin
+    BOARD_PIN(pinTrigger2, 21), //The Cam Sensor pin
+    BOARD_PIN(pinSpareTemp2, A15), //spare Analog input 2
+    BOARD_PIN(pinSpareTemp1, A14), //spare Analog input 1
+    BOARD_PIN(pinO2, A8), //O2 Sensor pin
+    BOARD_PIN(pinBat, A4), //Battery reference voltage pin
+    BOARD_PIN(pinMAP, A3), //MAP sensor pin
+    BOARD_PIN(pinTPS, A2), //TPS input pin
+    BOARD_PIN(pinCLT, A1), //CLS sensor pin
+    BOARD_PIN(pinIAT, A0), //IAT sensor pin
+    BOARD_PIN(pinFan, 47), //Pin for the fan output
+    BOARD_PIN(pinFuelPump, 4), //Fuel pump output
+    BOARD_PIN(pinTachOut, 49), //Tacho output pin
+    BOARD_PIN(pinResetControl, 26), //Reset control output
+  #endif
+
+  BOARD_PIN_MAP(30),
+  #ifndef SMALL_FLASH_MODE //No support for bluepill here anyway
+    //Pin mappings as per the dazv6 shield
+    BOARD_PIN(pinInjector1, 8), //Output pin injector 1 is on
+    BOARD_PIN(pinInjector2, 9), //Output pin injector 2 is on
+    BOARD_PIN(pinInjector3, 10), //Output pin injector 3 is on
+    BOARD_PIN(pinInjector4, 11), //Output pin injector 4 is on
+    BOARD_PIN(pinInjector5, 12), //Output pin injector 5 is on
+    BOARD_PIN(pinCoil1, 40), //Pin for coil 1
+    BOARD_PIN(pinCoil2, 38), //Pin for coil 2
+    BOARD_PIN(pinCoil3, 50), //Pin for coil 3
+    BOARD_PIN(pinCoil4, 52), //Pin for coil 4
+    BOARD_PIN(pinCoil5, 34), //Pin for coil 5 PLACEHOLDER value for now
+    BOARD_PIN(pinTrigger, 19), //The CAS pin
+    BOARD_PIN(pinTrigger2, 18), //The Cam Sensor pin
+    BOARD_PIN(pinTrigger3, 17), // cam sensor 2 pin, pin17 isn't external trigger enabled in arduino mega??
+    BOARD_PIN(pinTPS, A2), //TPS input pin
+    BOARD_PIN(pinMAP, A3), //MAP sensor pin
+    BOARD_PIN(pinIAT, A0), //IAT sensor pin
+    BOARD_PIN(pinCLT, A1), //CLS sensor pin
+    BOARD_PIN(pinO2, A8), //O2 Sensor pin
+    BOARD_PIN(pinO2_2, A9), //O2 sensor pin (second sensor)
+    BOARD_PIN(pinBat, A4), //Battery reference voltage pin
+    BOARD_PIN(pinDisplayReset, 48), // OLED reset pin
+    BOARD_PIN(pinTachOut, 49), //Tacho output pin
+    BOARD_PIN(pinIdle1, 5), //Single wire idle control
+    BOARD_PIN(pinFuelPump, 45), //Fuel pump output
+    BOARD_PIN(pinStepperDir, 20), //Direction pin  for DRV8825 driver
+    BOARD_PIN(pinStepperStep, 21), //Step pin for DRV8825 driver
+    BOARD_PIN(pinSpareHOut1, 4), // high current output spare1
+    BOARD_PIN(pinSpareHOut2, 6), // high current output spare2
+    BOARD_PIN(pinBoost, 7),
+    BOARD_PIN(pinSpareLOut1, 43), //low current output spare1
+    BOARD_PIN(pinSpareLOut2, 47),
+    BOARD_PIN(pinSpareLOut3, 49),
+    BOARD_PIN(pinSpareLOut4, 51),
+    BOARD_PIN(pinSpareLOut5, 53),
+    BOARD_PIN(pinFan, 47), //Pin for the fan output
+  #endif
+
+ BOARD_PIN_MAP(31),
+    //Pin mappings for the BMW PnP PCBs by pazi88.
+    #if defined(CORE_AVR)
+    //This is the regular MEGA2560 pin mapping
+    BOARD_PIN(pinInjector1, 8), //Output pin injector 1
+    BOARD_PIN(pinInjector2, 9), //Output pin injector 2
+    BOARD_PIN(pinInjector3, 10), //Output pin injector 3
+    BOARD_PIN(pinInjector4, 11), //Output pin injector 4
+    BOARD_PIN(pinInjector5, 12), //Output pin injector 5
+    BOARD_PIN(pinInjector6, 50), //Output pin injector 6
+    BOARD_PIN(pinInjector7, 39), //Output pin injector 7 (placeholder)
+    BOARD_PIN(pinInjector8, 42), //Output pin injector 8 (placeholder)
+    BOARD_PIN(pinCoil1, 40), //Pin for coil 1
+    BOARD_PIN(pinCoil2, 38), //Pin for coil 2
+    BOARD_PIN(pinCoil3, 52), //Pin for coil 3
+    BOARD_PIN(pinCoil4, 48), //Pin for coil 4
+    BOARD_PIN(pinCoil5, 36), //Pin for coil 5
+    BOARD_PIN(pinCoil6, 34), //Pin for coil 6
+    BOARD_PIN(pinCoil7, 46), //Pin for coil 7 (placeholder)
+    BOARD_PIN(pinCoil8, 53), //Pin for coil 8 (placeholder)
+    BOARD_PIN(pinTrigger, 19), //The CAS pin
+    BOARD_PIN(pinTrigger2, 18), //The Cam Sensor pin
+    BOARD_PIN(pinTrigger3, 20), //The Cam sensor 2 pin
+    BOARD_PIN(pinTPS, A2), //TPS input pin
+    BOARD_PIN(pinMAP, A3), //MAP sensor pin
+    BOARD_PIN(pinEMAP, A15), //EMAP sensor pin
+    BOARD_PIN(pinIAT, A0), //IAT sensor pin
+    BOARD_PIN(pinCLT, A1), //CLT sensor pin
+    BOARD_PIN(pinO2, A8), //O2 Sensor pin
+    BOARD_PIN(pinBat, A4), //Battery reference voltage pin
+    BOARD_PIN(pinBaro, A5), //Baro sensor pin
+    BOARD_PIN(pinDisplayReset, 41), // OLED reset pin
+    BOARD_PIN(pinTachOut, 49), //Tacho output pin  (Goes to ULN2003)
+    BOARD_PIN(pinIdle1, 5), //ICV pin1
+    BOARD_PIN(pinIdle2, 6), //ICV pin3
+    BOARD_PIN(pinBoost, 7), //Boost control
+    BOARD_PIN(pinVVT_1, 4), //VVT1 output (intake vanos)
+    BOARD_PIN(pinVVT_2, 26), //VVT2 output (exhaust vanos)
+    BOARD_PIN(pinFuelPump, 45), //Fuel pump output  (Goes to ULN2003)
+    BOARD_PIN(pinStepperDir, 16), //Stepper valve isn't used with these
+    BOARD_PIN(pinStepperStep, 17), //Stepper valve isn't used with these
+    BOARD_PIN(pinStepperEnable, 24), //Stepper valve isn't used with these
+    BOARD_PIN(pinFan, 47), //Pin for the fan output (Goes to ULN2003)
+    BOARD_PIN(pinLaunch, 51), //Launch control pin
+    BOARD_PIN(pinFlex, 2), // Flex sensor
+    BOARD_PIN(pinResetControl, 43), //Reset control output
+    BOARD_PIN(pinVSS, 3), //VSS input pin
+    BOARD_PIN(pinWMIEmpty, 31), //(placeholder)
+    BOARD_PIN(pinWMIIndicator, 33), //(placeholder)
+    BOARD_PIN(pinWMIEnabled, 35), //(placeholder)
+    BOARD_PIN(pinIdleUp, 37), //(placeholder)
+    BOARD_PIN(pinCTPS, A6), //(placeholder)
+   #elif defined(STM32F407xx)
+    BOARD_PIN(pinInjector1, PB15), //Output pin injector 1
+    BOARD_PIN(pinInjector2, PB14), //Output pin injector 2
+    BOARD_PIN(pinInjector3, PB12), //Output pin injector 3
+    BOARD_PIN(pinInjector4, PB13), //Output pin injector 4
+    BOARD_PIN(pinInjector5, PA8), //Output pin injector 5
+    BOARD_PIN(pinInjector6, PE7), //Output pin injector 6
+    BOARD_PIN(pinInjector7, PE13), //Output pin injector 7 (placeholder)
+    BOARD_PIN(pinInjector8, PE10), //Output pin injector 8 (placeholder)
+    BOARD_PIN(pinCoil1, PE2), //Pin for coil 1
+    BOARD_PIN(pinCoil2, PE3), //Pin for coil 2
+    BOARD_PIN(pinCoil3, PC13), //Pin for coil 3
+    BOARD_PIN(pinCoil4, PE6), //Pin for coil 4
+    BOARD_PIN(pinCoil5, PE4), //Pin for coil 5
+    BOARD_PIN(pinCoil6, PE5), //Pin for coil 6
+    BOARD_PIN(pinCoil7, PE0), //Pin for coil 7 (placeholder)
+    BOARD_PIN(pinCoil8, PB9), //Pin for coil 8 (placeholder)
+    BOARD_PIN(pinTrigger, PD3), //The CAS pin
+    BOARD_PIN(pinTrigger2, PD4), //The Cam Sensor pin
+    BOARD_PIN(pinTPS, PA2), //TPS input pin
+    BOARD_PIN(pinMAP, PA3), //MAP sensor pin
+    BOARD_PIN(pinEMAP, PC5), //EMAP sensor pin
+    BOARD_PIN(pinIAT, PA0), //IAT sensor pin
+    BOARD_PIN(pinCLT, PA1), //CLS sensor pin
+    BOARD_PIN(pinO2, PB0), //O2 Sensor pin
+    BOARD_PIN(pinBat, PA4), //Battery reference voltage pin
+    BOARD_PIN(pinBaro, PA5), //Baro sensor pin
+    BOARD_PIN(pinDisplayReset, PE12), // OLED reset pin
+    BOARD_PIN(pinTachOut, PE8), //Tacho output pin  (Goes to ULN2003)
+    BOARD_PIN(pinIdle1, PD10), //ICV pin1
+    BOARD_PIN(pinIdle2, PD9), //ICV pin3
+    BOARD_PIN(pinBoost, PD8), //Boost control
+    BOARD_PIN(pinVVT_1, PD11), //VVT1 output (intake vanos)
+    BOARD_PIN(pinVVT_2, PC7), //VVT2 output (exhaust vanos)
+    BOARD_PIN(pinFuelPump, PE11), //Fuel pump output  (Goes to ULN2003)
+    BOARD_PIN(pinStepperDir, PB10), //Stepper valve isn't used with these
+    BOARD_PIN(pinStepperStep, PB11), //Stepper valve isn't used with these
+    BOARD_PIN(pinStepperEnable, PA15), //Stepper valve isn't used with these
+    BOARD_PIN(pinFan, PE9), //Pin for the fan output (Goes to ULN2003)
+    BOARD_PIN(pinLaunch, PB8), //Launch control pin
+    BOARD_PIN(pinFlex, PD7), // Flex sensor
+    BOARD_PIN(pinResetControl, PB7), //Reset control output
+    BOARD_PIN(pinVSS, PB6), //VSS input pin
+    BOARD_PIN(pinWMIEmpty, PD15), //(placeholder)
+    BOARD_PIN(pinWMIIndicator, PD13), //(placeholder)
+    BOARD_PIN(pinWMIEnabled, PE15), //(placeholder)
+    BOARD_PIN(pinIdleUp, PE14), //(placeholder)
+    BOARD_PIN(pinCTPS, PA6), //(placeholder)
+   #endif
+
+  BOARD_PIN_MAP(40),
+   #ifndef SMALL_FLASH_MODE
+    //Pin mappings as per the NO2C shield
+    BOARD_PIN(pinInjector1, 8), //Output pin injector 1 is on
+    BOARD_PIN(pinInjector2, 9), //Output pin injector 2 is on
+    BOARD_PIN(pinInjector3, 11), //Output pin injector 3 is on - NOT USED
+    BOARD_PIN(pinInjector4, 12), //Output pin injector 4 is on - NOT USED
+    BOARD_PIN(pinInjector5, 13), //Placeholder only - NOT USED
+    BOARD_PIN(pinCoil1, 23), //Pin for coil 1
+    BOARD_PIN(pinCoil2, 22), //Pin for coil 2
+    BOARD_PIN(pinCoil3, 2), //Pin for coil 3 - ONLY WITH DB2
+    BOARD_PIN(pinCoil4, 3), //Pin for coil 4 - ONLY WITH DB2
+    BOARD_PIN(pinCoil5, 46), //Placeholder only - NOT USED
+    BOARD_PIN(pinTrigger, 19), //The CAS pin
+    BOARD_PIN(pinTrigger2, 18), //The Cam Sensor pin
+    BOARD_PIN(pinTrigger3, 21), //The Cam sensor 2 pin
+    BOARD_PIN(pinTPS, A3), //TPS input pin
+    BOARD_PIN(pinMAP, A0), //MAP sensor pin
+    BOARD_PIN(pinIAT, A5), //IAT sensor pin
+    BOARD_PIN(pinCLT, A4), //CLT sensor pin
+    BOARD_PIN(pinO2, A2), //O2 sensor pin
+    BOARD_PIN(pinBat, A1), //Battery reference voltage pin
+    BOARD_PIN(pinBaro, A6), //Baro sensor pin - ONLY WITH DB
+    BOARD_PIN(pinSpareTemp1, A7), //spare Analog input 1 - ONLY WITH DB
+    BOARD_PIN(pinDisplayReset, 48), // OLED reset pin - NOT USED
+    BOARD_PIN(pinTachOut, 38), //Tacho output pin
+    BOARD_PIN(pinIdle1, 5), //Single wire idle control
+    BOARD_PIN(pinIdle2, 47), //2 wire idle control - NOT USED
+    BOARD_PIN(pinBoost, 7), //Boost control
+    BOARD_PIN(pinVVT_1, 6), //Default VVT output
+    BOARD_PIN(pinVVT_2, 48), //Default VVT2 output
+    BOARD_PIN(pinFuelPump, 4), //Fuel pump output
+    BOARD_PIN(pinStepperDir, 25), //Direction pin for DRV8825 driver
+    BOARD_PIN(pinStepperStep, 24), //Step pin for DRV8825 driver
+    BOARD_PIN(pinStepperEnable, 27), //Enable pin for DRV8825 driver
+    BOARD_PIN(pinLaunch, 10), //Can be overwritten below
+    BOARD_PIN(pinFlex, 20), // Flex sensor (Must be external interrupt enabled) - ONLY WITH DB
+    BOARD_PIN(pinFan, 30), //Pin for the fan output - ONLY WITH DB
+    BOARD_PIN(pinSpareLOut1, 32), //low current output spare1 - ONLY WITH DB
+    BOARD_PIN(pinSpareLOut2, 34), //low current output spare2 - ONLY WITH DB
+    BOARD_PIN(pinSpareLOut3, 36), //low current output spare3 - ONLY WITH DB
+    BOARD_PIN(pinResetControl, 26), //Reset control output
+    #endif
+
+  BOARD_PIN_MAP(41),
+  #ifndef SMALL_FLASH_MODE //No support for bluepill here anyway
+    //Pin mappings as per the UA4C shield
+    BOARD_PIN(pinInjector1, 8), //Output pin injector 1 is on
+    BOARD_PIN(pinInjector2, 7), //Output pin injector 2 is on
+    BOARD_PIN(pinInjector3, 6), //Output pin injector 3 is on
+    BOARD_PIN(pinInjector4, 5), //Output pin injector 4 is on
+    BOARD_PIN(pinInjector5, 45), //Output pin injector 5 is on PLACEHOLDER value for now
+    BOARD_PIN(pinCoil1, 35), //Pin for coil 1
+    BOARD_PIN(pinCoil2, 36), //Pin for coil 2
+    BOARD_PIN(pinCoil3, 33), //Pin for coil 3
+    BOARD_PIN(pinCoil4, 34), //Pin for coil 4
+    BOARD_PIN(pinCoil5, 44), //Pin for coil 5 PLACEHOLDER value for now
+    BOARD_PIN(pinTrigger, 19), //The CAS pin
+    BOARD_PIN(pinTrigger2, 18), //The Cam Sensor pin
+    BOARD_PIN(pinTrigger3, 3), //The Cam sensor 2 pin
+    BOARD_PIN(pinFlex, 20), // Flex sensor
+    BOARD_PIN(pinTPS, A3), //TPS input pin
+    BOARD_PIN(pinMAP, A0), //MAP sensor pin
+    BOARD_PIN(pinBaro, A7), //Baro sensor pin
+    BOARD_PIN(pinIAT, A5), //IAT sensor pin
+    BOARD_PIN(pinCLT, A4), //CLS sensor pin
+    BOARD_PIN(pinO2, A1), //O2 Sensor pin
+    BOARD_PIN(pinO2_2, A9), //O2 sensor pin (second sensor)
+    BOARD_PIN(pinBat, A2), //Battery reference voltage pin
+    BOARD_PIN(pinSpareTemp1, A8), //spare Analog input 1
+    BOARD_PIN(pinLaunch, 37), //Can be overwritten below
+    BOARD_PIN(pinDisplayReset, 48), // OLED reset pin PLACEHOLDER value for now
+    BOARD_PIN(pinTachOut, 22), //Tacho output pin
+    BOARD_PIN(pinIdle1, 9), //Single wire idle control
+    BOARD_PIN(pinIdle2, 10), //2 wire idle control
+    BOARD_PIN(pinFuelPump, 23), //Fuel pump output
+    BOARD_PIN(pinVVT_1, 11), //Default VVT output
+    BOARD_PIN(pinVVT_2, 48), //Default VVT2 output
+    BOARD_PIN(pinStepperDir, 32), //Direction pin  for DRV8825 driver
+    BOARD_PIN(pinStepperStep, 31), //Step pin for DRV8825 driver
+    BOARD_PIN(pinStepperEnable, 30), //Enable pin for DRV8825 driver
+    BOARD_PIN(pinBoost, 12), //Boost control
+    BOARD_PIN(pinSpareLOut1, 26), //low current output spare1
+    BOARD_PIN(pinSpareLOut2, 27), //low current output spare2
+    BOARD_PIN(pinSpareLOut3, 28), //low current output spare3
+    BOARD_PIN(pinSpareLOut4, 29), //low current output spare4
+    BOARD_PIN(pinFan, 24), //Pin for the fan output
+    BOARD_PIN(pinResetControl, 46), //Reset control output PLACEHOLDER value for now
+  #endif
+
+  BOARD_PIN_MAP(42),
+    //Pin mappings for all BlitzboxBL49sp variants
+    BOARD_PIN(pinInjector1, 6), //Output pin injector 1
+    BOARD_PIN(pinInjector2, 7), //Output pin injector 2
+    BOARD_PIN(pinInjector3, 8), //Output pin injector 3
+    BOARD_PIN(pinInjector4, 9), //Output pin injector 4
+    BOARD_PIN(pinCoil1, 24), //Pin for coil 1
+    BOARD_PIN(pinCoil2, 25), //Pin for coil 2
+    BOARD_PIN(pinCoil3, 23), //Pin for coil 3
+    BOARD_PIN(pinCoil4, 22), //Pin for coil 4
+    BOARD_PIN(pinTrigger, 19), //The CRANK Sensor pin
+    BOARD_PIN(pinTrigger2, 18), //The Cam Sensor pin
+    BOARD_PIN(pinFlex, 20), // Flex sensor PLACEHOLDER value for now
+    BOARD_PIN(pinTPS, A0), //TPS input pin
+    BOARD_PIN(pinSpareTemp1, A1), //LMM sensor pin
+    BOARD_PIN(pinO2, A2), //O2 Sensor pin
+    BOARD_PIN(pinIAT, A3), //IAT sensor pin
+    BOARD_PIN(pinCLT, A4), //CLT sensor pin
+    BOARD_PIN(pinMAP, A7), //internal MAP sensor
+    BOARD_PIN(pinBat, A6), //Battery reference voltage pin
+    BOARD_PIN(pinBaro, A5), //external MAP/Baro sensor pin
+    BOARD_PIN(pinO2_2, A9), //O2 sensor pin (second sensor) PLACEHOLDER value for now
+    BOARD_PIN(pinLaunch, 2), //Can be overwritten below
+    BOARD_PIN(pinTachOut, 10), //Tacho output pin
+    BOARD_PIN(pinIdle1, 11), //Single wire idle control
+    BOARD_PIN(pinIdle2, 14), //2 wire idle control PLACEHOLDER value for now
+    BOARD_PIN(pinFuelPump, 3), //Fuel pump output
+    BOARD_PIN(pinVVT_1, 15), //Default VVT output PLACEHOLDER value for now
+    BOARD_PIN(pinBoost, 5), //Boost control
+    BOARD_PIN(pinSpareLOut1, 49), //enable Wideband Lambda Heater
+    BOARD_PIN(pinSpareLOut2, 16), //low current output spare2 PLACEHOLDER value for now
+    BOARD_PIN(pinSpareLOut3, 17), //low current output spare3 PLACEHOLDER value for now
+    BOARD_PIN(pinSpareLOut4, 21), //low current output spare4 PLACEHOLDER value for now
+    BOARD_PIN(pinFan, 12), //Pin for the fan output
+    BOARD_PIN(pinResetControl, 46), //Reset control output PLACEHOLDER value for now
+
+  BOARD_PIN_MAP(45),
+  #ifndef SMALL_FLASH_MODE //No support for bluepill here anyway
+    //Pin mappings for the DIY-EFI CORE4 Module. This is an AVR only module
+    #if defined(CORE_AVR)
+    BOARD_PIN(pinInjector1, 10), //Output pin injector 1 is on
+    BOARD_PIN(pinInjector2, 11), //Output pin injector 2 is on
+    BOARD_PIN(pinInjector3, 12), //Output pin injector 3 is on
+    BOARD_PIN(pinInjector4, 9), //Output pin injector 4 is on
+    BOARD_PIN(pinCoil1, 39), //Pin for coil 1
+    BOARD_PIN(pinCoil2, 29), //Pin for coil 2
+    BOARD_PIN(pinCoil3, 28), //Pin for coil 3
+    BOARD_PIN(pinCoil4, 27), //Pin for coil 4
+    BOARD_PIN(pinCoil5, 26), //Placeholder  for coil 5
+    BOARD_PIN(pinTrigger, 19), //The CAS pin
+    BOARD_PIN(pinTrigger2, 18), //The Cam Sensor pin
+    BOARD_PIN(pinTrigger3, 21), // The Cam sensor 2 pin
+    BOARD_PIN(pinFlex, 20), // Flex sensor
+    BOARD_PIN(pinTPS, A3), //TPS input pin
+    BOARD_PIN(pinMAP, A2), //MAP sensor pin
+    BOARD_PIN(pinBaro, A15), //Baro sensor pin
+    BOARD_PIN(pinIAT, A11), //IAT sensor pin
+    BOARD_PIN(pinCLT, A4), //CLS sensor pin
+    BOARD_PIN(pinO2, A12), //O2 Sensor pin
+    BOARD_PIN(pinO2_2, A5), //O2 sensor pin (second sensor)
+    BOARD_PIN(pinBat, A1), //Battery reference voltage pin
+    BOARD_PIN(pinSpareTemp1, A14), //spare Analog input 1
+    BOARD_PIN(pinLaunch, 24), //Can be overwritten below
+    BOARD_PIN(pinDisplayReset, 48), // OLED reset pin PLACEHOLDER value for now
+    BOARD_PIN(pinTachOut, 38), //Tacho output pin
+    BOARD_PIN(pinIdle1, 42), //Single wire idle control
+    BOARD_PIN(pinIdle2, 43), //2 wire idle control
+    BOARD_PIN(pinFuelPump, 41), //Fuel pump output
+    BOARD_PIN(pinVVT_1, 44), //Default VVT output
+    BOARD_PIN(pinVVT_2, 48), //Default VVT2 output
+    BOARD_PIN(pinStepperDir, 32), //Direction pin  for DRV8825 driver
+    BOARD_PIN(pinStepperStep, 31), //Step pin for DRV8825 driver
+    BOARD_PIN(pinStepperEnable, 30), //Enable pin for DRV8825 driver
+    BOARD_PIN(pinBoost, 45), //Boost control
+    BOARD_PIN(pinSpareLOut1, 37), //low current output spare1
+    BOARD_PIN(pinSpareLOut2, 36), //low current output spare2
+    BOARD_PIN(pinSpareLOut3, 35), //low current output spare3
+    BOARD_PIN(pinInjector5, 33), //Output pin injector 5 is on
+    BOARD_PIN(pinInjector6, 34), //Output pin injector 6 is on
+    BOARD_PIN(pinFan, 40), //Pin for the fan output
+    BOARD_PIN(pinResetControl, 46), //Reset control output PLACEHOLDER value for now
+    #endif
+  #endif
+
+  #if defined(CORE_TEENSY35)
+  BOARD_PIN_MAP(50),
+    //Pin mappings as per the teensy rev A shield
+    BOARD_PIN(pinInjector1, 2), //Output pin injector 1 is on
+    BOARD_PIN(pinInjector2, 10), //Output pin injector 2 is on
+    BOARD_PIN(pinInjector3, 6), //Output pin injector 3 is on
+    BOARD_PIN(pinInjector4, 9), //Output pin injector 4 is on
+    //Placeholder only - NOT USED:
+    //pinInjector5 = 13;
+    BOARD_PIN(pinCoil1, 29), //Pin for coil 1
+    BOARD_PIN(pinCoil2, 30), //Pin for coil 2
+    BOARD_PIN(pinCoil3, 31), //Pin for coil 3 - ONLY WITH DB2
+    BOARD_PIN(pinCoil4, 32), //Pin for coil 4 - ONLY WITH DB2
+    //Placeholder only - NOT USED:
+    //pinCoil5 = 46;
+    BOARD_PIN(pinTrigger, 23), //The CAS pin
+    BOARD_PIN(pinTrigger2, 36), //The Cam Sensor pin
+    BOARD_PIN(pinTPS, 16), //TPS input pin
+    BOARD_PIN(pinMAP, 17), //MAP sensor pin
+    BOARD_PIN(pinIAT, 14), //IAT sensor pin
+    BOARD_PIN(pinCLT, 15), //CLT sensor pin
+    BOARD_PIN(pinO2, A22), //O2 sensor pin
+    BOARD_PIN(pinO2_2, A21), //O2 sensor pin (second sensor)
+    BOARD_PIN(pinBat, 18), //Battery reference voltage pin
+    BOARD_PIN(pinTachOut, 20), //Tacho output pin
+    BOARD_PIN(pinIdle1, 5), //Single wire idle control
+    BOARD_PIN(pinBoost, 11), //Boost control
+    BOARD_PIN(pinFuelPump, 38), //Fuel pump output
+    BOARD_PIN(pinStepperDir, 34), //Direction pin for DRV8825 driver
+    BOARD_PIN(pinStepperStep, 35), //Step pin for DRV8825 driver
+    BOARD_PIN(pinStepperEnable, 33), //Enable pin for DRV8825 driver
+    BOARD_PIN(pinLaunch, 26), //Can be overwritten below
+    BOARD_PIN(pinFan, 37), //Pin for the fan output - ONLY WITH DB
+    BOARD_PIN(pinSpareHOut1, 8), // high current output spare1
+    BOARD_PIN(pinSpareHOut2, 7), // high current output spare2
+    BOARD_PIN(pinSpareLOut1, 21), //low current output spare1
+
+  BOARD_PIN_MAP(51),
+    //Pin mappings as per the teensy revB board shield
+    BOARD_PIN(pinInjector1, 2), //Output pin injector 1 is on
+    BOARD_PIN(pinInjector2, 10), //Output pin injector 2 is on
+    BOARD_PIN(pinInjector3, 6), //Output pin injector 3 is on - NOT USED
+    BOARD_PIN(pinInjector4, 9), //Output pin injector 4 is on - NOT USED
+    BOARD_PIN(pinCoil1, 29), //Pin for coil 1
+    BOARD_PIN(pinCoil2, 30), //Pin for coil 2
+    BOARD_PIN(pinCoil3, 31), //Pin for coil 3 - ONLY WITH DB2
+    BOARD_PIN(pinCoil4, 32), //Pin for coil 4 - ONLY WITH DB2
+    BOARD_PIN(pinTrigger, 23), //The CAS pin
+    BOARD_PIN(pinTrigger2, 36), //The Cam Sensor pin
+    BOARD_PIN(pinTPS, 16), //TPS input pin
+    BOARD_PIN(pinMAP, 17), //MAP sensor pin
+    BOARD_PIN(pinIAT, 14), //IAT sensor pin
+    BOARD_PIN(pinCLT, 15), //CLT sensor pin
+    BOARD_PIN(pinO2, A22), //O2 sensor pin
+    BOARD_PIN(pinO2_2, A21), //O2 sensor pin (second sensor)
+    BOARD_PIN(pinBat, 18), //Battery reference voltage pin
+    BOARD_PIN(pinTachOut, 20), //Tacho output pin
+    BOARD_PIN(pinIdle1, 5), //Single wire idle control
+    BOARD_PIN(pinBoost, 11), //Boost control
+    BOARD_PIN(pinFuelPump, 38), //Fuel pump output
+    BOARD_PIN(pinStepperDir, 34), //Direction pin for DRV8825 driver
+    BOARD_PIN(pinStepperStep, 35), //Step pin for DRV8825 driver
+    BOARD_PIN(pinStepperEnable, 33), //Enable pin for DRV8825 driver
+    BOARD_PIN(pinLaunch, 26), //Can be overwritten below
+    BOARD_PIN(pinFan, 37), //Pin for the fan output - ONLY WITH DB
+    BOARD_PIN(pinSpareHOut1, 8), // high current output spare1
+    BOARD_PIN(pinSpareHOut2, 7), // high current output spare2
+    BOARD_PIN(pinSpareLOut1, 21), //low current output spare1
+  #endif
+
+  #if defined(CORE_TEENSY35)
+  BOARD_PIN_MAP(53),
+    //Pin mappings for the Juice Box (ignition only board)
+    BOARD_PIN(pinInjector1, 2), //Output pin injector 1 is on - NOT USED
+    BOARD_PIN(pinInjector2, 56), //Output pin injector 2 is on - NOT USED
+    BOARD_PIN(pinInjector3, 6), //Output pin injector 3 is on - NOT USED
+    BOARD_PIN(pinInjector4, 50), //Output pin injector 4 is on - NOT USED
+    BOARD_PIN(pinCoil1, 29), //Pin for coil 1
+    BOARD_PIN(pinCoil2, 30), //Pin for coil 2
+    BOARD_PIN(pinCoil3, 31), //Pin for coil 3
+    BOARD_PIN(pinCoil4, 32), //Pin for coil 4
+    BOARD_PIN(pinTrigger, 37), //The CAS pin
+    BOARD_PIN(pinTrigger2, 38), //The Cam Sensor pin - NOT USED
+    BOARD_PIN(pinTPS, A2), //TPS input pin
+    BOARD_PIN(pinMAP, A7), //MAP sensor pin
+    BOARD_PIN(pinIAT, A1), //IAT sensor pin
+    BOARD_PIN(pinCLT, A5), //CLT sensor pin
+    BOARD_PIN(pinO2, A0), //O2 sensor pin
+    BOARD_PIN(pinO2_2, A21), //O2 sensor pin (second sensor) - NOT USED
+    BOARD_PIN(pinBat, A6), //Battery reference voltage pin
+    BOARD_PIN(pinTachOut, 28), //Tacho output pin
+    BOARD_PIN(pinIdle1, 5), //Single wire idle control - NOT USED
+    BOARD_PIN(pinBoost, 11), //Boost control - NOT USED
+    BOARD_PIN(pinFuelPump, 24), //Fuel pump output
+    BOARD_PIN(pinStepperDir, 3), //Direction pin for DRV8825 driver - NOT USED
+    BOARD_PIN(pinStepperStep, 4), //Step pin for DRV8825 driver - NOT USED
+    BOARD_PIN(pinStepperEnable, 6), //Enable pin for DRV8825 driver - NOT USED
+    BOARD_PIN(pinLaunch, 26), //Can be overwritten below
+    BOARD_PIN(pinFan, 25), //Pin for the fan output
+    BOARD_PIN(pinSpareHOut1, 26), // high current output spare1
+    BOARD_PIN(pinSpareHOut2, 27), // high current output spare2
+    BOARD_PIN(pinSpareLOut1, 55), //low current output spare1 - NOT USED
+  #endif
+
+  BOARD_PIN_MAP(55),
+    #if defined(CORE_TEENSY)
+    //Pin mappings for the DropBear
+    BOARD_PIN(injectorOutputControl, OUTPUT_CONTROL_MC33810),
+    BOARD_PIN(ignitionOutputControl, OUTPUT_CONTROL_MC33810),
+
+    //The injector pins below are not used directly as the control is via SPI through the MC33810s, however the pin numbers are set to be the SPI pins (SCLK, MOSI, MISO and CS) so that nothing else will set them as inputs
+    BOARD_PIN(pinInjector1, 13), //SCLK
+    BOARD_PIN(pinInjector2, 11), //MOSI
+    BOARD_PIN(pinInjector3, 12), //MISO
+    BOARD_PIN(pinInjector4, 10), //CS for MC33810 1
+    BOARD_PIN(pinInjector5, 9), //CS for MC33810 2
+    BOARD_PIN(pinInjector6, 9), //CS for MC33810 3
+
+    //Dummy pins, without these pin 0 (Serial1 RX) gets overwritten
+    BOARD_PIN(pinCoil1, 40),
+    BOARD_PIN(pinCoil2, 41),
+    /*
+    pinCoil3 = 55;
+    pinCoil4 = 55;
+    pinCoil5 = 55;
+    pinCoil6 = 55;
+    */
+
+    BOARD_PIN(pinTrigger, 19), //The CAS pin
+    BOARD_PIN(pinTrigger2, 18), //The Cam Sensor pin
+    BOARD_PIN(pinTrigger3, 22), //Uses one of the protected spare digital inputs. This must be set or Serial1 (Pin 0) gets broken
+    BOARD_PIN(pinFlex, A16), // Flex sensor
+    BOARD_PIN(pinMAP, A1), //MAP sensor pin
+    BOARD_PIN(pinBaro, A0), //Baro sensor pin
+    BOARD_PIN(pinBat, A14), //Battery reference voltage pin
+    BOARD_PIN(pinSpareTemp1, A17), //spare Analog input 1
+    BOARD_PIN(pinLaunch, A15), //Can be overwritten below
+    BOARD_PIN(pinTachOut, 5), //Tacho output pin
+    BOARD_PIN(pinIdle1, 27), //Single wire idle control
+    BOARD_PIN(pinIdle2, 29), //2 wire idle control. Shared with Spare 1 output
+    BOARD_PIN(pinFuelPump, 8), //Fuel pump output
+    BOARD_PIN(pinVVT_1, 28), //Default VVT output
+    BOARD_PIN(pinStepperDir, 32), //Direction pin  for DRV8825 driver
+    BOARD_PIN(pinStepperStep, 31), //Step pin for DRV8825 driver
+    BOARD_PIN(pinStepperEnable, 30), //Enable pin for DRV8825 driver
+    BOARD_PIN(pinBoost, 24), //Boost control
+    BOARD_PIN(pinSpareLOut1, 29), //low current output spare1
+    BOARD_PIN(pinSpareLOut2, 26), //low current output spare2
+    BOARD_PIN(pinSpareLOut3, 28), //low current output spare3
+    BOARD_PIN(pinSpareLOut4, 29), //low current output spare4
+    BOARD_PIN(pinFan, 25), //Pin for the fan output
+    BOARD_PIN(pinResetControl, 46), //Reset control output PLACEHOLDER value for now
+
+    //CS pin number is now set in a compile flag.
+    // #ifdef USE_SPI_EEPROM
+    //   pinSPIFlash_CS = 6;
+    // #endif
+
+    #if defined(CORE_TEENSY35)
+      BOARD_PIN(pinTPS, A22), //TPS input pin
+      BOARD_PIN(pinIAT, A19), //IAT sensor pin
+      BOARD_PIN(pinCLT, A20), //CLS sensor pin
+      BOARD_PIN(pinO2, A21), //O2 Sensor pin
+      BOARD_PIN(pinO2_2, A18), //Spare 2
+
+    #endif
+
+    #if defined(CORE_TEENSY41)
+      BOARD_PIN(pinTPS, A17), //TPS input pin
+      BOARD_PIN(pinIAT, A14), //IAT sensor pin
+      BOARD_PIN(pinCLT, A15), //CLS sensor pin
+      BOARD_PIN(pinO2, A16), //O2 Sensor pin
+      BOARD_PIN(pinBat, A3), //Battery reference voltage pin. Needs Alpha4+
+
+      //New pins for the actual T4.1 version of the Dropbear
+      BOARD_PIN(pinBaro, A4),
+      BOARD_PIN(pinMAP, A5),
+      BOARD_PIN(pinTPS, A3), //TPS input pin
+      BOARD_PIN(pinIAT, A0), //IAT sensor pin
+      BOARD_PIN(pinCLT, A1), //CLS sensor pin
+      BOARD_PIN(pinO2, A2), //O2 Sensor pin
+      BOARD_PIN(pinBat, A15), //Battery reference voltage pin. Needs Alpha4+
+      BOARD_PIN(pinLaunch, 36),
+      BOARD_PIN(pinFlex, 37), // Flex sensor
+      BOARD_PIN(pinSpareTemp1, A16),
+      BOARD_PIN(pinSpareTemp2, A17),
+
+      BOARD_PIN(pinTrigger, 20), //The CAS pin
+      BOARD_PIN(pinTrigger2, 21), //The Cam Sensor pin
+
+      BOARD_PIN(pinFuelPump, 5), //Fuel pump output
+      BOARD_PIN(pinTachOut, 8), //Tacho output pin
+
+      BOARD_PIN(pinResetControl, 49), //PLaceholder only. Cannot use 42-47 as these are the SD card
+
+      //CS pin number is now set in a compile flag.
+      // #ifdef USE_SPI_EEPROM
+      //   pinSPIFlash_CS = 33;
+      // #endif
+
+    #endif
+
+      BOARD_PIN(pinMC33810_1_CS, 10),
+      BOARD_PIN(pinMC33810_2_CS, 9),
+
+    //Pin alignment to the MC33810 outputs
+    BOARD_PIN(MC33810_BIT_INJ1, 3),
+    BOARD_PIN(MC33810_BIT_INJ2, 1),
+    BOARD_PIN(MC33810_BIT_INJ3, 0),
+    BOARD_PIN(MC33810_BIT_INJ4, 2),
+    BOARD_PIN(MC33810_BIT_IGN1, 4),
+    BOARD_PIN(MC33810_BIT_IGN2, 5),
+    BOARD_PIN(MC33810_BIT_IGN3, 6),
+    BOARD_PIN(MC33810_BIT_IGN4, 7),
+
+    BOARD_PIN(MC33810_BIT_INJ5, 3),
+    BOARD_PIN(MC33810_BIT_INJ6, 1),
+    BOARD_PIN(MC33810_BIT_INJ7, 0),
+    BOARD_PIN(MC33810_BIT_INJ8, 2),
+    BOARD_PIN(MC33810_BIT_IGN5, 4),
+    BOARD_PIN(MC33810_BIT_IGN6, 5),
+    BOARD_PIN(MC33810_BIT_IGN7, 6),
+    BOARD_PIN(MC33810_BIT_IGN8, 7),
+
+
+
+    #endif
+
+  BOARD_PIN_MAP(56),
+    #if defined(CORE_TEENSY)
+    //Pin mappings for the Bear Cub (Teensy 4.1)
+    BOARD_PIN(pinInjector1, 6),
+    BOARD_PIN(pinInjector2, 7),
+    BOARD_PIN(pinInjector3, 9),
+    BOARD_PIN(pinInjector4, 8),
+    BOARD_PIN(pinInjector5, 0), //Not used
+    BOARD_PIN(pinCoil1, 2),
+    BOARD_PIN(pinCoil2, 3),
+    BOARD_PIN(pinCoil3, 4),
+    BOARD_PIN(pinCoil4, 5),
+
+    BOARD_PIN(pinTrigger, 20), //The CAS pin
+    BOARD_PIN(pinTrigger2, 21), //The Cam Sensor pin
+    BOARD_PIN(pinFlex, 37), // Flex sensor
+    BOARD_PIN(pinMAP, A5), //MAP sensor pin
+    BOARD_PIN(pinBaro, A4), //Baro sensor pin
+    BOARD_PIN(pinBat, A15), //Battery reference voltage pin
+    BOARD_PIN(pinTPS, A3), //TPS input pin
+    BOARD_PIN(pinIAT, A0), //IAT sensor pin
+    BOARD_PIN(pinCLT, A1), //CLS sensor pin
+    BOARD_PIN(pinO2, A2), //O2 Sensor pin
+    BOARD_PIN(pinLaunch, 36),
+
+    BOARD_PIN(pinSpareTemp1, A16), //spare Analog input 1
+    BOARD_PIN(pinSpareTemp2, A17), //spare Analog input 2
+    BOARD_PIN(pinTachOut, 38), //Tacho output pin
+    BOARD_PIN(pinIdle1, 27), //Single wire idle control
+    BOARD_PIN(pinIdle2, 26), //2 wire idle control. Shared with Spare 1 output
+    BOARD_PIN(pinFuelPump, 10), //Fuel pump output
+    BOARD_PIN(pinVVT_1, 28), //Default VVT output
+    BOARD_PIN(pinStepperDir, 32), //Direction pin  for DRV8825 driver
+    BOARD_PIN(pinStepperStep, 31), //Step pin for DRV8825 driver
+    BOARD_PIN(pinStepperEnable, 30), //Enable pin for DRV8825 driver
+    BOARD_PIN(pinBoost, 24), //Boost control
+    BOARD_PIN(pinSpareLOut1, 29), //low current output spare1
+    BOARD_PIN(pinSpareLOut2, 26), //low current output spare2
+    BOARD_PIN(pinSpareLOut3, 28), //low current output spare3
+    BOARD_PIN(pinSpareLOut4, 29), //low current output spare4
+    BOARD_PIN(pinFan, 25), //Pin for the fan output
+    BOARD_PIN(pinResetControl, 46), //Reset control output PLACEHOLDER value for now
+
+    #endif
+
+
+  BOARD_PIN_MAP(60),
+      #if defined(STM32F407xx)
+      //Pin definitions for experimental board Tjeerd
+      //Black F407VE wiki.stm32duino.com/index.php?title=STM32F407
+      //https://github.com/Tjeerdie/SPECTRE/tree/master/SPECTRE_V0.5
+
+      //******************************************
+      //******** PORTA CONNECTIONS ***************
+      //******************************************
+      // = PA0; //Wakeup ADC123
+      // = PA1; //ADC123
+      // = PA2; //ADC123
+      // = PA3; //ADC123
+      // = PA4; //ADC12
+      // = PA5; //ADC12
+      // = PA6; //ADC12 LED_BUILTIN_1
+      // = PA7; //ADC12 LED_BUILTIN_2
+      BOARD_PIN(pinCoil3, PA8),
+      // = PA9;  //TXD1=Bluetooth module
+      // = PA10; //RXD1=Bluetooth module
+      // = PA11; //(DO NOT USE FOR SPEEDUINO) USB
+      // = PA12; //(DO NOT USE FOR SPEEDUINO) USB
+      // = PA13;  //(DO NOT USE FOR SPEEDUINO) NOT ON GPIO - DEBUG ST-LINK
+      // = PA14;  //(DO NOT USE FOR SPEEDUINO) NOT ON GPIO - DEBUG ST-LINK
+      // = PA15;  //(DO NOT USE FOR SPEEDUINO) NOT ON GPIO - DEBUG ST-LINK
+
+      //******************************************
+      //******** PORTB CONNECTIONS ***************
+      //******************************************
+      // = PB0;  //(DO NOT USE FOR SPEEDUINO) ADC123 - SPI FLASH CHIP CS pin
+      BOARD_PIN(pinBaro, PB1), //ADC12
+      // = PB2;  //(DO NOT USE FOR SPEEDUINO) BOOT1
+      // = PB3;  //(DO NOT USE FOR SPEEDUINO) SPI1_SCK FLASH CHIP
+      // = PB4;  //(DO NOT USE FOR SPEEDUINO) SPI1_MISO FLASH CHIP
+      // = PB5;  //(DO NOT USE FOR SPEEDUINO) SPI1_MOSI FLASH CHIP
+      // = PB6;  //NRF_CE
+      BOARD_PIN(pinCoil6, PB7), //NRF_CS
+      // = PB8;  //NRF_IRQ
+      BOARD_PIN(pinCoil2, PB9), //
+      // = PB9;  //
+      // = PB10; //TXD3
+      // = PB11; //RXD3
+      // = PB12; //
+      // = PB13;  //SPI2_SCK
+      // = PB14;  //SPI2_MISO
+      // = PB15;  //SPI2_MOSI
+
+      //******************************************
+      //******** PORTC CONNECTIONS ***************
+      //******************************************
+      BOARD_PIN(pinIAT, PC0), //ADC123 
+      BOARD_PIN(pinTPS, PC1), //ADC123
+      BOARD_PIN(pinMAP, PC2), //ADC123 
+      BOARD_PIN(pinCLT, PC3), //ADC123
+      BOARD_PIN(pinO2, PC4), //ADC12
+      BOARD_PIN(pinBat, PC5), //ADC12
+      BOARD_PIN(pinBoost, PC6), //
+      BOARD_PIN(pinIdle1, PC7), //
+      // = PC8;  //(DO NOT USE FOR SPEEDUINO) - SDIO_D0
+      // = PC9;  //(DO NOT USE FOR SPEEDUINO) - SDIO_D1
+      // = PC10;  //(DO NOT USE FOR SPEEDUINO) - SDIO_D2
+      // = PC11;  //(DO NOT USE FOR SPEEDUINO) - SDIO_D3
+      // = PC12;  //(DO NOT USE FOR SPEEDUINO) - SDIO_SCK
+      BOARD_PIN(pinTachOut, PC13), //
+      // = PC14;  //(DO NOT USE FOR SPEEDUINO) - OSC32_IN
+      // = PC15;  //(DO NOT USE FOR SPEEDUINO) - OSC32_OUT
+
+      //******************************************
+      //******** PORTD CONNECTIONS ***************
+      //******************************************
+      // = PD0;  //CANRX
+      // = PD1;  //CANTX
+      // = PD2;  //(DO NOT USE FOR SPEEDUINO) - SDIO_CMD
+      BOARD_PIN(pinIdle2, PD3), //
+      // = PD4;  //
+      BOARD_PIN(pinFlex, PD4),
+      // = PD5; //TXD2
+      // = PD6;  //RXD2
+      BOARD_PIN(pinCoil1, PD7), //
+      // = PD7;  //
+      // = PD8;  //
+      BOARD_PIN(pinCoil5, PD9), //
+      BOARD_PIN(pinCoil4, PD10), //
+      // = PD11;  //
+      BOARD_PIN(pinInjector1, PD12), //
+      BOARD_PIN(pinInjector2, PD13), //
+      BOARD_PIN(pinInjector3, PD14), //
+      BOARD_PIN(pinInjector4, PD15), //
+
+      //******************************************
+      //******** PORTE CONNECTIONS ***************
+      //******************************************
+      BOARD_PIN(pinTrigger, PE0), //
+      BOARD_PIN(pinTrigger2, PE1), //
+      BOARD_PIN(pinStepperEnable, PE2), //
+      BOARD_PIN(pinFuelPump, PE3), //ONBOARD KEY1
+      // = PE4;  //ONBOARD KEY2
+      BOARD_PIN(pinStepperStep, PE5), //
+      BOARD_PIN(pinFan, PE6), //
+      BOARD_PIN(pinStepperDir, PE7), //
+      // = PE8;  //
+      BOARD_PIN(pinInjector5, PE9), //
+      // = PE10;  //
+      BOARD_PIN(pinInjector6, PE11), //
+      // = PE12; //
+      BOARD_PIN(pinInjector8, PE13), //
+      BOARD_PIN(pinInjector7, PE14), //
+      // = PE15;  //
+   #elif (defined(STM32F411xE) || defined(STM32F401xC))
+      //pins PA12, PA11 are used for USB or CAN couldn't be used for GPIO
+      //PB2 can't be used as input because is BOOT pin
+      BOARD_PIN(pinInjector1, PB7), //Output pin injector 1 is on
+      BOARD_PIN(pinInjector2, PB6), //Output pin injector 2 is on
+      BOARD_PIN(pinInjector3, PB5), //Output pin injector 3 is on
+      BOARD_PIN(pinInjector4, PB4), //Output pin injector 4 is on
+      BOARD_PIN(pinCoil1, PB9), //Pin for coil 1
+      BOARD_PIN(pinCoil2, PB8), //Pin for coil 2
+      BOARD_PIN(pinCoil3, PB3), //Pin for coil 3
+      BOARD_PIN(pinCoil4, PA15), //Pin for coil 4
+      BOARD_PIN(pinTPS, A2), //TPS input pin
+      BOARD_PIN(pinMAP, A3), //MAP sensor pin
+      BOARD_PIN(pinIAT, A0), //IAT sensor pin
+      BOARD_PIN(pinCLT, A1), //CLS sensor pin
+      BOARD_PIN(pinO2, A8), //O2 Sensor pin
+      BOARD_PIN(pinBat, A4), //Battery reference voltage pin
+      BOARD_PIN(pinBaro, A3), //Same as pinMAP
+      BOARD_PIN(pinTachOut, PB1), //Tacho output pin  (Goes to ULN2803)
+      BOARD_PIN(pinIdle1, PB2), //Single wire idle control
+      BOARD_PIN(pinIdle2, PB10), //2 wire idle control
+      BOARD_PIN(pinBoost, PA6), //Boost control
+      BOARD_PIN(pinStepperDir, PB10), //Direction pin  for DRV8825 driver
+      BOARD_PIN(pinStepperStep, PB2), //Step pin for DRV8825 driver
+      BOARD_PIN(pinFuelPump, PA8), //Fuel pump output
+      BOARD_PIN(pinFan, PA5), //Pin for the fan output (Goes to ULN2803)
+
+      //external interrupt enabled pins
+      BOARD_PIN(pinFlex, PC14), // Flex sensor (Must be external interrupt enabled)
+      BOARD_PIN(pinTrigger, PC13), //The CAS pin also led pin so bad idea
+      BOARD_PIN(pinTrigger2, PC15), //The Cam Sensor pin
+
+   #elif defined(CORE_STM32)
+      //blue pill wiki.stm32duino.com/index.php?title=Blue_Pill
+      //Maple mini wiki.stm32duino.com/index.php?title=Maple_Mini
+      //pins PA12, PA11 are used for USB or CAN couldn't be used for GPIO
+      //PB2 can't be used as input because is BOOT pin
+      BOARD_PIN(pinInjector1, PB7), //Output pin injector 1 is on
+      BOARD_PIN(pinInjector2, PB6), //Output pin injector 2 is on
+      BOARD_PIN(pinInjector3, PB5), //Output pin injector 3 is on
+      BOARD_PIN(pinInjector4, PB4), //Output pin injector 4 is on
+      BOARD_PIN(pinCoil1, PB3), //Pin for coil 1
+      BOARD_PIN(pinCoil2, PA15), //Pin for coil 2
+      BOARD_PIN(pinCoil3, PA14), //Pin for coil 3
+      BOARD_PIN(pinCoil4, PA9), //Pin for coil 4
+      BOARD_PIN(pinCoil5, PA8), //Pin for coil 5
+      BOARD_PIN(pinTPS, A0), //TPS input pin
+      BOARD_PIN(pinMAP, A1), //MAP sensor pin
+      BOARD_PIN(pinIAT, A2), //IAT sensor pin
+      BOARD_PIN(pinCLT, A3), //CLS sensor pin
+      BOARD_PIN(pinO2, A4), //O2 Sensor pin
+      BOARD_PIN(pinBat, A5), //Battery reference voltage pin
+      BOARD_PIN(pinBaro, A1), //Same as pinMAP
+      BOARD_PIN(pinIdle1, PB2), //Single wire idle control
+      BOARD_PIN(pinIdle2, PA2), //2 wire idle control
+      BOARD_PIN(pinBoost, PA1), //Boost control
+      BOARD_PIN(pinVVT_1, PA0), //Default VVT output
+      BOARD_PIN(pinVVT_2, PA2), //Default VVT2 output
+      BOARD_PIN(pinStepperDir, PC15), //Direction pin  for DRV8825 driver
+      BOARD_PIN(pinStepperStep, PC14), //Step pin for DRV8825 driver
+      BOARD_PIN(pinStepperEnable, PC13), //Enable pin for DRV8825
+      BOARD_PIN(pinDisplayReset, PB2), // OLED reset pin
+      BOARD_PIN(pinFan, PB1), //Pin for the fan output
+      BOARD_PIN(pinFuelPump, PB11), //Fuel pump output
+      BOARD_PIN(pinTachOut, PB10), //Tacho output pin
+      //external interrupt enabled pins
+      BOARD_PIN(pinFlex, PB8), // Flex sensor (Must be external interrupt enabled)
+      BOARD_PIN(pinTrigger, PA10), //The CAS pin
+      BOARD_PIN(pinTrigger2, PA13), //The Cam Sensor pin
+
+  #endif
+  BOARD_PIN_MAP_DEFAULT(),
+    #if defined(STM32F407xx)
+    //Pin definitions for experimental board Tjeerd
+      //Black F407VE wiki.stm32duino.com/index.php?title=STM32F407
+
+      //******************************************
+      //******** PORTA CONNECTIONS ***************
+      //******************************************
+      /* = PA0 */ //Wakeup ADC123
+      // = PA1;
+      // = PA2;
+      // = PA3;
+      // = PA4;
+      /* = PA5; */ //ADC12
+      BOARD_PIN(pinFuelPump, PA6), //ADC12 LED_BUILTIN_1
+      /* = PA7; */ //ADC12 LED_BUILTIN_2
+      BOARD_PIN(pinCoil3, PA8),
+      /* = PA9 */ //TXD1
+      /* = PA10 */ //RXD1
+      /* = PA11 */ //(DO NOT USE FOR SPEEDUINO) USB
+      /* = PA12 */ //(DO NOT USE FOR SPEEDUINO) USB
+      /* = PA13 */ //(DO NOT USE FOR SPEEDUINO) NOT ON GPIO - DEBUG ST-LINK
+      /* = PA14 */ //(DO NOT USE FOR SPEEDUINO) NOT ON GPIO - DEBUG ST-LINK
+      /* = PA15 */ //(DO NOT USE FOR SPEEDUINO) NOT ON GPIO - DEBUG ST-LINK
+
+      //******************************************
+      //******** PORTB CONNECTIONS ***************
+      //******************************************
+      /* = PB0; */ //(DO NOT USE FOR SPEEDUINO) ADC123 - SPI FLASH CHIP CS pin
+      BOARD_PIN(pinBaro, PB1), //ADC12
+      /* = PB2; */ //(DO NOT USE FOR SPEEDUINO) BOOT1
+      /* = PB3; */ //(DO NOT USE FOR SPEEDUINO) SPI1_SCK FLASH CHIP
+      /* = PB4; */ //(DO NOT USE FOR SPEEDUINO) SPI1_MISO FLASH CHIP
+      /* = PB5; */ //(DO NOT USE FOR SPEEDUINO) SPI1_MOSI FLASH CHIP
+      /* = PB6; */ //NRF_CE
+      /* = PB7; */ //NRF_CS
+      /* = PB8; */ //NRF_IRQ
+      BOARD_PIN(pinCoil2, PB9), //
+      /* = PB9; */ //
+      BOARD_PIN(pinCoil4, PB10), //TXD3
+      BOARD_PIN(pinIdle1, PB11), //RXD3
+      BOARD_PIN(pinIdle2, PB12), //
+      /* pinBoost = PB12; */ //
+      /* = PB13; */ //SPI2_SCK
+      /* = PB14; */ //SPI2_MISO
+      /* = PB15; */ //SPI2_MOSI
+
+      //******************************************
+      //******** PORTC CONNECTIONS ***************
+      //******************************************
+      BOARD_PIN(pinMAP, PC0), //ADC123 
+      BOARD_PIN(pinTPS, PC1), //ADC123
+      BOARD_PIN(pinIAT, PC2), //ADC123
+      BOARD_PIN(pinCLT, PC3), //ADC123
+      BOARD_PIN(pinO2, PC4), //ADC12
+      BOARD_PIN(pinBat, PC5), //ADC12
+      /*pinVVT_1 = PC6; */ //
+      BOARD_PIN(pinDisplayReset, PC7), //
+      /* = PC8; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_D0
+      /* = PC9; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_D1
+      /* = PC10; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_D2
+      /* = PC11; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_D3
+      /* = PC12; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_SCK
+      BOARD_PIN(pinTachOut, PC13), //
+      /* = PC14; */ //(DO NOT USE FOR SPEEDUINO) - OSC32_IN
+      /* = PC15; */ //(DO NOT USE FOR SPEEDUINO) - OSC32_OUT
+
+      //******************************************
+      //******** PORTD CONNECTIONS ***************
+      //******************************************
+      /* = PD0; */ //CANRX
+      /* = PD1; */ //CANTX
+      /* = PD2; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_CMD
+      /* = PD3; */ //
+      /* = PD4; */ //
+      BOARD_PIN(pinFlex, PD4),
+      /* = PD5;*/ //TXD2
+      /* = PD6; */ //RXD2
+      BOARD_PIN(pinCoil1, PD7), //
+      /* = PD7; */ //
+      /* = PD8; */ //
+      BOARD_PIN(pinCoil5, PD9), //
+      /* = PD10; */ //
+      /* = PD11; */ //
+      BOARD_PIN(pinInjector1, PD12), //
+      BOARD_PIN(pinInjector2, PD13), //
+      BOARD_PIN(pinInjector3, PD14), //
+      BOARD_PIN(pinInjector4, PD15), //
+
+      //******************************************
+      //******** PORTE CONNECTIONS ***************
+      //******************************************
+      BOARD_PIN(pinTrigger, PE0), //
+      BOARD_PIN(pinTrigger2, PE1), //
+      BOARD_PIN(pinStepperEnable, PE2), //
+      /* = PE3; */ //ONBOARD KEY1
+      /* = PE4; */ //ONBOARD KEY2
+      BOARD_PIN(pinStepperStep, PE5), //
+      BOARD_PIN(pinFan, PE6), //
+      BOARD_PIN(pinStepperDir, PE7), //
+      /* = PE8; */ //
+      /* = PE9; */ //
+      /* = PE10; */ //
+      BOARD_PIN(pinInjector5, PE11), //
+      BOARD_PIN(pinInjector6, PE12), //
+      /* = PE13; */ //
+      /* = PE14; */ //
+      /* = PE15; */ //
+    #else
+      #ifndef SMALL_FLASH_MODE //No support for bluepill here anyway
+      //Pin mappings as per the v0.2 shield
+      BOARD_PIN(pinInjector1, 8), //Output pin injector 1 is on
+      BOARD_PIN(pinInjector2, 9), //Output pin injector 2 is on
+      BOARD_PIN(pinInjector3, 10), //Output pin injector 3 is on
+      BOARD_PIN(pinInjector4, 11), //Output pin injector 4 is on
+      BOARD_PIN(pinInjector5, 12), //Output pin injector 5 is on
+      BOARD_PIN(pinCoil1, 28), //Pin for coil 1
+      BOARD_PIN(pinCoil2, 24), //Pin for coil 2
+      BOARD_PIN(pinCoil3, 40), //Pin for coil 3
+      BOARD_PIN(pinCoil4, 36), //Pin for coil 4
+      BOARD_PIN(pinCoil5, 34), //Pin for coil 5 PLACEHOLDER value for now
+      BOARD_PIN(pinTrigger, 20), //The CAS pin
+      BOARD_PIN(pinTrigger2, 21), //The Cam Sensor pin
+      BOARD_PIN(pinTPS, A2), //TPS input pin
+      BOARD_PIN(pinMAP, A3), //MAP sensor pin
+      BOARD_PIN(pinIAT, A0), //IAT sensor pin
+      BOARD_PIN(pinCLT, A1), //CLS sensor pin
+      #ifdef A8 //Bit hacky, but needed for the atmega2561
+      BOARD_PIN(pinO2, A8), //O2 Sensor pin
+      #endif
+      BOARD_PIN(pinBat, A4), //Battery reference voltage pin
+      BOARD_PIN(pinStepperDir, 16), //Direction pin  for DRV8825 driver
+      BOARD_PIN(pinStepperStep, 17), //Step pin for DRV8825 driver
+      BOARD_PIN(pinDisplayReset, 48), // OLED reset pin
+      BOARD_PIN(pinFan, 47), //Pin for the fan output
+      BOARD_PIN(pinFuelPump, 4), //Fuel pump output
+      BOARD_PIN(pinTachOut, 49), //Tacho output pin
+      BOARD_PIN(pinFlex, 3), // Flex sensor (Must be external interrupt enabled)
+      BOARD_PIN(pinBoost, 5),
+      BOARD_PIN(pinIdle1, 6),
+      BOARD_PIN(pinResetControl, 43), //Reset control output
+      #endif
+    #endif
+
+  BOARD_PIN_MAP_END()
+};
+
+#define BOARD_TARGET_ADDRESS(name) &name,
+static byte * const boardPinTargets[BOARD_TARGET_COUNT] PROGMEM = { BOARD_PIN_TARGETS(BOARD_TARGET_ADDRESS) };
+
+//Returns the index of the first entry after the given marker, or 0 if it is not in the table
+static uint16_t findBoardPinMap(uint8_t marker, uint8_t boardID)
+{
+  for(uint16_t entry = 0; entry < _countof(boardPinMaps); entry++)
+  {
+    uint8_t target = pgm_read_byte(&boardPinMaps[entry].target);
+    if( (target == marker) && ((marker == BOARD_TARGET_DEFAULT) || (pgm_read_byte(&boardPinMaps[entry].pin) == boardID)) ) { return entry + 1U; }
+  }
+  return 0;
+}
+
+/**
+ * @brief Sets the pin globals to the default mapping of a board. Boards without their own map use the default map
+ *
+ * @param boardID The board / pin mapping number (configPage2.pinMapping)
+ */
+void applyBoardPinMap(byte boardID)
+{
+  uint16_t entry = findBoardPinMap(BOARD_TARGET_BOARD, boardID);
+  if(entry == 0U) { entry = findBoardPinMap(BOARD_TARGET_DEFAULT, 0); }
+  if(entry == 0U) { return; }
+
+  for(; entry < _countof(boardPinMaps); entry++)
+  {
+    uint8_t target = pgm_read_byte(&boardPinMaps[entry].target);
+    if(target >= BOARD_TARGET_COUNT) { break; } //Start of the next board or the end of the table
+    byte *pin = (byte *)pgm_read_ptr(&boardPinTargets[target]);
+    *pin = pgm_read_byte(&boardPinMaps[entry].pin);
+  }
+}
@@ -0,0 +1,47 @@
+/** @file
+ * The default pin mappings of each board, held as data rather than code. See boardPinMaps.cpp
+ */
+#ifndef BOARD_PIN_MAPS_H
+#define BOARD_PIN_MAPS_H
+
+#include "globals.h"
+
+/**
+ * @brief Every global that a board pin map can set. Each becomes a BOARD_TARGET_<name> value
+ */
+#define BOARD_PIN_TARGETS(X) \
+  X(pinInjector1) X(pinInjector2) X(pinInjector3) X(pinInjector4) X(pinInjector5) X(pinCoil1) X(pinCoil2) \
+  X(pinCoil3) X(pinCoil4) X(pinCoil5) X(pinTrigger) X(pinTrigger2) X(pinTrigger3) X(pinTPS) X(pinMAP) X(pinIAT) \
+  X(pinCLT) X(pinO2) X(pinBat) X(pinDisplayReset) X(pinTachOut) X(pinIdle1) X(pinIdle2) X(pinStepperDir) \
+  X(pinStepperStep) X(pinFan) X(pinFuelPump) X(pinFlex) X(pinResetControl) X(pinBoost) X(pinVVT_1) X(pinVVT_2) \
+  X(pinStepperEnable) X(pinLaunch) X(pinBaro) X(pinVSS) X(pinInjector6) X(pinWMIEmpty) X(pinWMIIndicator) \
+  X(pinWMIEnabled) X(pinSpareTemp2) X(pinIdleUp) X(pinCTPS) X(pinInjector7) X(pinInjector8) X(pinMAP2) \
+  X(pinSpareTemp1) X(pinSpareOut1) X(pinSpareOut2) X(pinSpareOut3) X(pinSpareOut4) X(pinSpareOut5) X(pinSpareOut6) \
+  X(pinO2_2) X(pinSpareHOut1) X(pinSpareHOut2) X(pinSpareLOut1) X(pinSpareLOut2) X(pinSpareLOut3) X(pinSpareLOut4) \
+  X(pinSpareLOut5) X(pinCoil6) X(pinCoil7) X(pinCoil8) X(pinEMAP) X(injectorOutputControl) X(ignitionOutputControl) \
+  X(pinMC33810_1_CS) X(pinMC33810_2_CS) X(MC33810_BIT_INJ1) X(MC33810_BIT_INJ2) X(MC33810_BIT_INJ3) \
+  X(MC33810_BIT_INJ4) X(MC33810_BIT_IGN1) X(MC33810_BIT_IGN2) X(MC33810_BIT_IGN3) X(MC33810_BIT_IGN4) \
+  X(MC33810_BIT_INJ5) X(MC33810_BIT_INJ6) X(MC33810_BIT_INJ7) X(MC33810_BIT_INJ8) X(MC33810_BIT_IGN5) \
+  X(MC33810_BIT_IGN6) X(MC33810_BIT_IGN7) X(MC33810_BIT_IGN8)
+
+#define BOARD_TARGET_ENUM(name) BOARD_TARGET_##name,
+enum board_target_t : uint8_t {
+  BOARD_PIN_TARGETS(BOARD_TARGET_ENUM)
+  BOARD_TARGET_COUNT,
+  BOARD_TARGET_BOARD = 0xFD, ///< Start of a board. The pin is the board ID
+  BOARD_TARGET_DEFAULT = 0xFE, ///< Start of the board used for any ID without its own map
+  BOARD_TARGET_END = 0xFF,
+};
+#undef BOARD_TARGET_ENUM
+
+/**
+ * @brief A single entry of the pin map table. Either a value for one of the targets, or the start of a board
+ */
+struct board_pin_t {
+  uint8_t target; ///< A board_target_t
+  uint8_t pin;
+};
+
+void applyBoardPinMap(byte boardID);
+
+#endif
@@ -8,6 +8,7 @@
 #include "HardwareTimer.h"
 #include "timers.h"
 #include "comms_secondary.h"
+#include "pwmOutputs.h"
 
 #if HAL_CAN_MODULE_ENABLED
 //This activates CAN1 interface on STM32, but it's named as Can0, because that's how Teensy implementation is done
@@ -350,7 +351,93 @@ STM32RTC& rtc = STM32RTC::getInstance();
   ***********************************************************************************************************
   * Interrupt callback functions
   */
-  #if ((STM32_CORE_VERSION_MINOR<=8) & (STM32_CORE_VERSION_MAJOR==1)) 
+  #if ( STM32_CORE_VERSION_MAJOR >= 2 )
+/*
+Hardware PWM for the auxiliary outputs (See pwmOutputs.h)
+TIM1-5 and the 1ms timer are used by the schedules and the interrupt driven outputs, so only pins on the other timers
+can be used. All the channels of a timer share its frequency, so a pin is refused if its timer is already running
+another output at a different frequency.
+*/
+#define PWM_HARDWARE_TIMERS 4U
+
+typedef struct {
+  TIM_TypeDef *instance;
+  HardwareTimer *timer;
+  uint16_t frequency;
+  uint8_t channels; //Bit per channel in use
+} pwm_timer_t;
+
+static pwm_timer_t pwmTimers[PWM_HARDWARE_TIMERS];
+
+static bool pwmTimerIsReserved(const TIM_TypeDef *instance)
+{
+  if( (instance == TIM1) || (instance == TIM2) || (instance == TIM3) || (instance == TIM4) ) { return true; }
+  #if defined(TIM5)
+  if(instance == TIM5) { return true; }
+  #endif
+  #if defined(TIM11)
+  if(instance == TIM11) { return true; }
+  #endif
+  return false;
+}
+
+static pwm_timer_t* getPWMTimer(uint8_t pin, uint32_t &channel)
+{
+  PinName pinName = digitalPinToPinName(pin);
+  TIM_TypeDef *instance = (TIM_TypeDef *)pinmap_peripheral(pinName, PinMap_PWM);
+  if( (instance == NP) || (pwmTimerIsReserved(instance) == true) ) { return nullptr; }
+  channel = STM_PIN_CHANNEL(pinmap_function(pinName, PinMap_PWM));
+
+  pwm_timer_t *freeTimer = nullptr;
+  for(uint8_t x = 0; x < PWM_HARDWARE_TIMERS; x++)
+  {
+    if(pwmTimers[x].instance == instance) { return &pwmTimers[x]; }
+    if( (pwmTimers[x].instance == nullptr) && (freeTimer == nullptr) ) { freeTimer = &pwmTimers[x]; }
+  }
+  if(freeTimer != nullptr)
+  {
+    freeTimer->instance = instance;
+    freeTimer->timer = new HardwareTimer(instance);
+    freeTimer->channels = 0;
+  }
+  return freeTimer;
+}
+
+bool boardPWMBegin(uint8_t pin, uint16_t frequency)
+{
+  uint32_t channel;
+  pwm_timer_t *pwmTimer = getPWMTimer(pin, channel);
+  if(pwmTimer == nullptr) { return false; }
+  if( (pwmTimer->channels != 0U) && (pwmTimer->frequency != frequency) ) { return false; }
+
+  pwmTimer->timer->setPWM(channel, pin, frequency, 0);
+  pwmTimer->frequency = frequency;
+  BIT_SET(pwmTimer->channels, channel);
+  return true;
+}
+
+void boardPWMWrite(uint8_t pin, uint16_t duty)
+{
+  uint32_t channel;
+  pwm_timer_t *pwmTimer = getPWMTimer(pin, channel);
+  if(pwmTimer == nullptr) { return; }
+  uint32_t ticks = ((uint32_t)duty * pwmTimer->timer->getOverflow(TICK_FORMAT)) / PWM_DUTY_MAX;
+  pwmTimer->timer->setCaptureCompare(channel, ticks, TICK_COMPARE_FORMAT);
+}
+
+void boardPWMEnd(uint8_t pin)
+{
+  uint32_t channel;
+  pwm_timer_t *pwmTimer = getPWMTimer(pin, channel);
+  if(pwmTimer == nullptr) { return; }
+  pwmTimer->timer->setMode(channel, TIMER_DISABLED);
+  BIT_CLEAR(pwmTimer->channels, channel);
+  if(pwmTimer->channels == 0U) { pwmTimer->timer->pause(); }
+  pinMode(pin, OUTPUT);
+}
+#endif
+
+#if ((STM32_CORE_VERSION_MINOR<=8) & (STM32_CORE_VERSION_MAJOR==1)) 
   void oneMSInterval(HardwareTimer*){oneMSInterval();}
   void boostInterrupt(HardwareTimer*){boostInterrupt();}
   void fuelSchedule1Interrupt(HardwareTimer*){fuelSchedule1Interrupt();}
@@ -309,6 +309,14 @@ static inline void FUEL8_TIMER_DISABLE(void) {(TIM5)->DIER &= ~TIM_DIER_CC4IE;}
 #define FAN_TIMER_COMPARE     (TIM1)->CCR1
 #define FAN_TIMER_COUNTER     (TIM1)->CNT
 
+#if ( STM32_CORE_VERSION_MAJOR >= 2 )
+//Auxiliary outputs on pins of the timers not used below can use hardware PWM. See pwmOutputs.h
+#define PWM_HARDWARE_AVAILABLE
+bool boardPWMBegin(uint8_t pin, uint16_t frequency);
+void boardPWMWrite(uint8_t pin, uint16_t duty);
+void boardPWMEnd(uint8_t pin);
+#endif
+
 /*
 ***********************************************************************************************************
 * Idle
@@ -6,6 +6,7 @@
 #include "scheduler.h"
 #include "timers.h"
 #include "comms_secondary.h"
+#include "pwmOutputs.h"
 
 /*
   //These are declared locally in comms_CAN now due to this issue: https://github.com/tonton81/FlexCAN_T4/issues/67
@@ -306,6 +307,39 @@ time_t getTeensy3Time()
 void doSystemReset() { return; }
 void jumpToBootloader() { return; }
 
+/*
+Hardware PWM for the auxiliary outputs (See pwmOutputs.h)
+Only the FlexPWM pins are used, as the Quad timer pins (10-15, 18 and 19) are driven by the timers used for the schedules.
+Note that pins on the same FlexPWM submodule share the same frequency.
+*/
+#define PWM_HARDWARE_RESOLUTION 15U
+#define PWM_HARDWARE_MIN_FREQ   20U //The lowest frequency the FlexPWM can run at (With the 150MHz bus clock and maximum prescaler) is ~18Hz
+
+static inline bool pinHasFlexPWM(uint8_t pin)
+{
+  return digitalPinHasPWM(pin) && !( ((pin >= 10U) && (pin <= 15U)) || (pin == 18U) || (pin == 19U) );
+}
+
+bool boardPWMBegin(uint8_t pin, uint16_t frequency)
+{
+  if( (pinHasFlexPWM(pin) == false) || (frequency < PWM_HARDWARE_MIN_FREQ) ) { return false; }
+
+  analogWriteResolution(PWM_HARDWARE_RESOLUTION);
+  analogWriteFrequency(pin, frequency);
+  analogWrite(pin, 0);
+  return true;
+}
+
+void boardPWMWrite(uint8_t pin, uint16_t duty)
+{
+  analogWrite(pin, (int)(((uint32_t)duty << PWM_HARDWARE_RESOLUTION) / PWM_DUTY_MAX));
+}
+
+void boardPWMEnd(uint8_t pin)
+{
+  pinMode(pin, OUTPUT); //Returns the pin from the FlexPWM to the GPIO
+}
+
 void setTriggerHysteresis()
 {
   //Refer to digital.c in the Teensyduino core for the following code
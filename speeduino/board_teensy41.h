@@ -154,6 +154,12 @@
   #define FAN_TIMER_COMPARE     TMR3_COMP22
   #define FAN_TIMER_COUNTER     TMR3_CNTR1
 
+  //The FlexPWM channels are free, so the auxiliary outputs on FlexPWM pins use hardware PWM. See pwmOutputs.h
+  #define PWM_HARDWARE_AVAILABLE
+  bool boardPWMBegin(uint8_t pin, uint16_t frequency);
+  void boardPWMWrite(uint8_t pin, uint16_t duty);
+  void boardPWMEnd(uint8_t pin);
+
 /*
 ***********************************************************************************************************
 * Idle
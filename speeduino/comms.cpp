@@ -13,6 +13,8 @@ A full copy of the license may be found in the projects root directory
 #include "maths.h"
 #include "utilities.h"
 #include "decoders.h"
+#include "scheduler.h"
+#include "veLearn.h"
 #include "TS_CommandButtonHandler.h"
 #include "pages.h"
 #include "page_crc.h"
@@ -35,13 +37,13 @@ A full copy of the license may be found in the projects root directory
 // Forward declarations
 
 /** @brief Processes a message once it has been fully received */
-void processSerialCommand(void);
+static void processSerialCommand(comms_session_t &session);
 
-/** @brief Should be called when ::serialStatusFlag == SERIAL_TRANSMIT_TOOTH_INPROGRESS, */
-void sendToothLog(void);
+/** @brief Should be called when the session status flag == SERIAL_TRANSMIT_TOOTH_INPROGRESS, */
+static void sendToothLog(comms_session_t &session);
 
-/** @brief Should be called when ::serialStatusFlag == LOG_SEND_COMPOSITE */
-void sendCompositeLog(void);
+/** @brief Should be called when the session status flag == SERIAL_TRANSMIT_COMPOSITE_INPROGRESS */
+static void sendCompositeLog(comms_session_t &session);
 
 /// @defgroup group-serial-return-codes Serial return codes sent to TS
 /// @{
@@ -57,6 +59,8 @@ static constexpr byte SERIAL_RC_BUSY_ERR   = 0x85U; //!< TS will wait and retry
 ///@}
 
 static constexpr uint8_t SEND_OUTPUT_CHANNELS = 48U; //!< Code for the "send output channels command"
+static constexpr uint8_t SEND_SCHEDULE_STATS = 49U; //!< Code for the "send schedule event counters" command. See sendScheduleStats()
+static constexpr uint8_t SEND_VE_LEARN = 50U; //!< Code for the "send learned VE table" command. See sendLearnedVE()
 
 #if defined(RTC_ENABLED) && defined(SD_LOGGING)
   #define COMMS_SD            
@@ -73,18 +77,10 @@ static constexpr byte productString[] PROGMEM = { SERIAL_RC_OK, 'S', 'p', 'e', '
 static constexpr byte testCommsResponse[] PROGMEM = { SERIAL_RC_OK, 255 };
 /// @}
 
-/** 
- * @brief The number of bytes received or transmitted to date during nonblocking I/O.
- * @note We can share one variable between rx & tx because we only support simplex serial comms. 
- * I.e. we can only be receiving or transmitting at any one time.
- */
-static uint16_t serialBytesRxTx = 0; 
-
 static constexpr uint16_t SERIAL_TIMEOUT = 700; //!< Timeout threshold in milliseconds
-static uint32_t serialReceiveStartTime = 0; //!< The time in milliseconds at which the serial receive started. Used for calculating whether a timeout has occurred
 
-static FastCRC32 CRC32_serial; //!< Support accumulation of a CRC during non-blocking operations
-static FastCRC32 CRC32_calibration; //!< Support accumulation of a CRC during calibration loads. Must be a separate instance to CRC32_serial due to calibration data being sent in multiple packets
+static constexpr uint16_t FRAME_LENGTH_SIZE = 2U; //!< Every frame starts with the payload length
+static FastCRC32 CRC32_calibration; //!< Support accumulation of a CRC during calibration loads. Must be separate to the session CRCs due to calibration data being sent in multiple packets
 using crc_t = uint32_t;
 
 #ifdef COMMS_SD
@@ -99,9 +95,15 @@ static uint32_t SDreadStartSector;
 static uint32_t SDreadNumSectors;
 static uint32_t SDreadCompletedSectors = 0;
 #endif
-static uint8_t serialPayload[SERIAL_BUFFER_SIZE]; //!< Serial payload buffer
-static uint16_t serialPayloadLength = 0; //!< How many bytes in serialPayload were received or sent
-Stream* pPrimarySerial;
+static uint8_t serialPayload[SERIAL_BUFFER_SIZE]; //!< Payload buffer of the primary session
+#if defined(COMMS_SHARED_PAYLOAD)
+comms_session_t primaryCommsSession = { nullptr, &serialStatusFlag, serialPayload, sizeof(serialPayload), &serialSecondaryStatusFlag, &legacySerialCommand, 0, 0, 0, 0, FastCRC32() };
+#else
+comms_session_t primaryCommsSession = { nullptr, &serialStatusFlag, serialPayload, sizeof(serialPayload), nullptr, &legacySerialCommand, 0, 0, 0, 0, FastCRC32() };
+#endif
+
+/** @brief The session that is sending the tooth or composite log. The log buffer is shared, so only one session can be sending it */
+static const comms_session_t *pLogSession = nullptr;
 
 #if defined(CORE_AVR)
 #pragma GCC push_options
@@ -110,8 +112,8 @@ Stream* pPrimarySerial;
 #endif
 
 /** @brief Has the current receive operation timed out? */
-static inline bool isRxTimeout(void) {
-  return (millis() - serialReceiveStartTime) > SERIAL_TIMEOUT;
+static inline bool isRxTimeout(const comms_session_t &session) {
+  return (millis() - session.receiveStartTime) > SERIAL_TIMEOUT;
 }
 
 // ====================================== Endianness Support =============================
@@ -119,9 +121,9 @@ static inline bool isRxTimeout(void) {
 /**
  * @brief Flush all remaining bytes from the rx serial buffer
  */
-void flushRXbuffer(void)
+static void flushRXbuffer(Stream &port)
 {
-  while (primarySerial.available() > 0) { primarySerial.read(); }
+  while (port.available() > 0) { port.read(); }
 }
 
 /** @brief Reverse the byte order of a uint32_t
@@ -139,150 +141,114 @@ static __attribute__((noinline)) uint32_t reverse_bytes(uint32_t i)
 
 // ====================================== Blocking IO Support ================================
 
-void writeByteReliableBlocking(byte value) {
+static void writeByteReliableBlocking(Stream &port, byte value) {
   // Some platforms (I'm looking at you Teensy 3.5) do not mimic the Arduino 1.0
   // contract which synchronously blocks. 
   // https://github.com/PaulStoffregen/cores/blob/master/teensy3/usb_primarySerial.c#L215
-  while (!primarySerial.availableForWrite()) { /* Wait for the buffer to free up space */ }
-  primarySerial.write(value);
+  while (!port.availableForWrite()) { /* Wait for the buffer to free up space */ }
+  port.write(value);
 }
 
 // ====================================== Multibyte Primitive Type IO Support =============================
 
-/** @brief Read from the serial port into the supplied buffer 
- * @attention The buffer is filled in reverse, since TS comms is little-endian.
-*/
-static void readSerialTimeout(char *buffer, size_t length) {
-  // Teensy 3.5: Serial.available() should only be used as a boolean test
-  // See https://www.pjrc.com/teensy/td_serial.html#singlebytepackets
-  while (length>0U) {
-    if (primarySerial.available()!=0) {
-      buffer[--length] =(byte)primarySerial.read();
-    } else if(isRxTimeout()) {
-      return;
-    } else { /* MISRA - no-op */ }
-  }
-}
-
-/**
- * @brief Reads an integral type, timing out if necessary
- * 
- * @tparam TIntegral The integral type. E.g. uint16_t 
- */
-template <typename TIntegral>
-static __attribute__((noinline)) TIntegral readSerialIntegralTimeout(void) {
-  // We use type punning to read into a buffer and convert to the appropriate type
-  union {
-    char raw[sizeof(TIntegral)];
-    TIntegral value;
-  } buffer;
-  readSerialTimeout(buffer.raw, sizeof(buffer.raw));
-
-  if(isRxTimeout()) {
-    return TIntegral();
-  }
-  return buffer.value;
-}
-
 /** @brief Write a uint32_t to Serial 
  * @returns The value as transmitted on the wire
 */
-static uint32_t serialWrite(uint32_t value)
+static uint32_t serialWrite(Stream &port, uint32_t value)
 {
   value = reverse_bytes(value);
   const byte *pBuffer = (const byte*)&value;
-  writeByteReliableBlocking(pBuffer[0]);
-  writeByteReliableBlocking(pBuffer[1]);
-  writeByteReliableBlocking(pBuffer[2]);
-  writeByteReliableBlocking(pBuffer[3]);
+  writeByteReliableBlocking(port, pBuffer[0]);
+  writeByteReliableBlocking(port, pBuffer[1]);
+  writeByteReliableBlocking(port, pBuffer[2]);
+  writeByteReliableBlocking(port, pBuffer[3]);
   return value;
 }
 
 /** @brief Write a uint16_t to Serial */
-static void serialWrite(uint16_t value)
+static void serialWrite(Stream &port, uint16_t value)
 {
-  writeByteReliableBlocking((value >> 8U) & 255U);
-  writeByteReliableBlocking(value & 255U);
+  writeByteReliableBlocking(port, (value >> 8U) & 255U);
+  writeByteReliableBlocking(port, value & 255U);
 }
 
 // ====================================== Non-blocking IO Support =============================
 
-/** @brief Send as much data as possible without blocking the caller
- * @return Number of bytes sent
- */
-static uint16_t writeNonBlocking(const byte *buffer, size_t length)
+uint16_t writeNonBlocking(Stream &port, const byte *buffer, uint16_t length)
 {
   uint16_t bytesTransmitted = 0;
 
-  while (bytesTransmitted<length 
-        && primarySerial.availableForWrite() != 0 
-        // Just in case
-        && primarySerial.write(buffer[bytesTransmitted]) == 1)
+  while (bytesTransmitted < length)
   {
-    bytesTransmitted++;
+    //Only as many bytes as there is space for are written, so the write never waits for the buffer to drain
+    int capacity = port.availableForWrite();
+    if (capacity <= 0) { break; }
+    uint16_t blockLength = min((uint16_t)capacity, (uint16_t)(length - bytesTransmitted));
+    size_t written = port.write(buffer + bytesTransmitted, blockLength);
+    bytesTransmitted += (uint16_t)written;
+    //Some cores (Eg the Teensy USB serial) can take fewer bytes than availableForWrite() reported
+    if (written < blockLength) { break; }
   }
 
   return bytesTransmitted;
-
-  // This doesn't work on Teensy.
-  // See https://github.com/PaulStoffregen/cores/issues/10#issuecomment-61514955
-  // size_t capacity = min((size_t)Serial.availableForWrite(), length);
-  // return Serial.write(buffer, capacity);
 }
 
-/** @brief Write a uint32_t to Serial without blocking the caller
- * @return Number of bytes sent
- */
-static size_t writeNonBlocking(size_t start, uint32_t value)
+byte *getSerialPayloadBuffer(uint16_t &bufferSize)
 {
-  value = reverse_bytes(value);
-  const byte *pBuffer = (const byte*)&value;
-  return writeNonBlocking(pBuffer+start, sizeof(value)-start); //cppcheck-suppress misra-c2012-17.2
+  bufferSize = primaryCommsSession.payloadSize;
+  return primaryCommsSession.payload;
 }
 
-
-/** @brief Send the buffer, followed by it's CRC
- * 
- * This is supposed to be called multiple times for the same buffer until
- * it's all sent.
- * 
- * @param buffer The buffer
- * @param start Index into the buffer to start sending at. [0, length)
- * @param length Total size of the buffer
- * @return Cumulative total number of bytes written . I.e. the next start value
+/** @brief Send the next part of the session's response frame: the length, the payload and then its CRC
+ *
+ * This is supposed to be called multiple times for the same frame until
+ * it's all sent. Each call sends as much as the port can take without blocking.
+ *
+ * @param session The session. bytesRxTx is the index into the frame to start sending at and is updated with what was sent
+ * @return true if the whole frame has been sent
  */
-static uint16_t sendBufferAndCrcNonBlocking(const byte *buffer, size_t start, size_t length)
+static bool sendFrameNonBlocking(comms_session_t &session)
 {
-  if (start<length)
+  const uint16_t crcStart = FRAME_LENGTH_SIZE + session.payloadLength;
+
+  if (session.bytesRxTx < FRAME_LENGTH_SIZE)
   {
-    start = start + writeNonBlocking(buffer+start, length-start);
+    const byte header[FRAME_LENGTH_SIZE] = { highByte(session.payloadLength), lowByte(session.payloadLength) };
+    session.bytesRxTx += writeNonBlocking(*session.port, &header[session.bytesRxTx], FRAME_LENGTH_SIZE - session.bytesRxTx);
   }
-  
-  if (start>=length && start<length+sizeof(crc_t))
+
+  if ( (session.bytesRxTx >= FRAME_LENGTH_SIZE) && (session.bytesRxTx < crcStart) )
   {
-    start = start + writeNonBlocking(start-length, CRC32_serial.crc32(buffer, length));
+    session.bytesRxTx += writeNonBlocking(*session.port, &session.payload[session.bytesRxTx - FRAME_LENGTH_SIZE], crcStart - session.bytesRxTx);
   }
 
-  return start;
+  if ( (session.bytesRxTx >= crcStart) && (session.bytesRxTx < (crcStart + sizeof(crc_t))) )
+  {
+    const crc_t wireCrc = reverse_bytes(session.payloadCrc);
+    const byte *pCrc = (const byte*)&wireCrc;
+    session.bytesRxTx += writeNonBlocking(*session.port, pCrc + (session.bytesRxTx - crcStart), (uint16_t)(sizeof(crc_t) - (session.bytesRxTx - crcStart)));
+  }
+
+  return session.bytesRxTx == (crcStart + sizeof(crc_t));
 }
 
-/** @brief Start sending the shared serialPayload buffer.
+/** @brief Start sending the session's payload buffer.
  * 
- * ::serialStatusFlag will be signal the result of the send:<br>
- * ::serialStatusFlag == SERIAL_INACTIVE: send is complete <br>
- * ::serialStatusFlag == SERIAL_TRANSMIT_INPROGRESS: partial send, subsequent calls to continueSerialTransmission
- * will finish sending serialPayload
+ * The session status flag will be signal the result of the send:<br>
+ * SERIAL_INACTIVE: send is complete <br>
+ * SERIAL_TRANSMIT_INPROGRESS: partial send, subsequent calls to serialTransmit()
+ * will finish sending the payload
  * 
- * @param payloadLength How many bytes to send [0, sizeof(serialPayload))
+ * @param session The session to send on
+ * @param payloadLength How many bytes to send [0, payloadSize]
 */
-static void sendSerialPayloadNonBlocking(uint16_t payloadLength)
+static void sendSerialPayloadNonBlocking(comms_session_t &session, uint16_t payloadLength)
 {
   //Start new transmission session
-  serialStatusFlag = SERIAL_TRANSMIT_INPROGRESS;
-  serialWrite(payloadLength);
-  serialPayloadLength = payloadLength;
-  serialBytesRxTx = sendBufferAndCrcNonBlocking(serialPayload, 0, payloadLength);
-  serialStatusFlag = serialBytesRxTx==payloadLength+sizeof(crc_t) ? SERIAL_INACTIVE : SERIAL_TRANSMIT_INPROGRESS;
+  session.payloadLength = payloadLength;
+  session.payloadCrc = session.crc.crc32(session.payload, payloadLength);
+  session.bytesRxTx = 0U;
+  *session.status = sendFrameNonBlocking(session) ? SERIAL_INACTIVE : SERIAL_TRANSMIT_INPROGRESS;
 }
 
 // ====================================== TS Message Support =============================
@@ -291,14 +257,11 @@ static void sendSerialPayloadNonBlocking(uint16_t payloadLength)
  * 
  * This is used when TS asks for an action to happen (E.g. start a logger) or
  * to signal an error condition to TS
- * 
- * @attention This is a blocking operation
  */
-static void sendReturnCodeMsg(byte returnCode)
+static void sendReturnCodeMsg(comms_session_t &session, byte returnCode)
 {
-  serialWrite((uint16_t)sizeof(returnCode));
-  writeByteReliableBlocking(returnCode);
-  (void)serialWrite(CRC32_serial.crc32(&returnCode, sizeof(returnCode)));
+  session.payload[0] = returnCode;
+  sendSerialPayloadNonBlocking(session, sizeof(returnCode));
 }
 
 // ====================================== Command/Action Support =============================
@@ -349,36 +312,103 @@ static void loadPageValuesToBuffer(uint8_t pageNum, uint16_t offset, byte *buffe
 
 /** @brief Send a status record back to tuning/logging SW.
  * This will "live" information from @ref currentStatus struct.
+ * @param session - The session. Its payload buffer must hold packetLength + 1 bytes
  * @param offset - Start field number
  * @param packetLength - Length of actual message (after possible ack/confirm headers)
  * E.g. tuning sw command 'A' (Send all values) will send data from field number 0, LOG_ENTRY_SIZE fields.
  */
-static void generateLiveValues(uint16_t offset, uint16_t packetLength)
+static void generateLiveValues(const comms_session_t &session, uint16_t offset, uint16_t packetLength)
 {  
+  byte *buffer = session.payload;
   if(firstCommsRequest) 
   { 
     firstCommsRequest = false;
     currentStatus.secl = 0; 
   }
 
-  currentStatus.status2 ^= (-currentStatus.hasSync ^ currentStatus.status2) & (1U << BIT_STATUS2_SYNC); //Set the sync bit of the Spark variable to match the hasSync variable
+  buffer[0] = SERIAL_RC_OK;
+  //The values are copied from the snapshot for this loop. Anything past the end of the packet is sent as 0
+  const live_snapshot_t &snapshot = getLiveSnapshot();
+  uint16_t available = 0;
+  if(offset < LOG_CHANNEL_BYTES)
+  {
+    available = min(packetLength, (uint16_t)(LOG_CHANNEL_BYTES - offset));
+    memcpy(&buffer[1], &snapshot.values[offset], available);
+  }
+  memset(&buffer[available + 1U], 0, packetLength - available);
+  // Reset any flags that are being used to trigger page refreshes. They are for the TunerStudio on the primary port, so a
+  // dash or logger polling the secondary serial must not clear them before TunerStudio has seen them
+  if(&session == &primaryCommsSession)
+  {
+    BIT_CLEAR(currentStatus.status3, BIT_STATUS3_VSS_REFRESH);
+    BIT_CLEAR(currentStatus.status5, BIT_STATUS5_TABLE_REFRESH);
+  }
+}
+
+static uint16_t putScheduleStats(byte *buffer, const schedule_stats_t &stats)
+{
+  buffer[0] = lowByte(stats.lateStarts);
+  buffer[1] = highByte(stats.lateStarts);
+  buffer[2] = lowByte(stats.truncated);
+  buffer[3] = highByte(stats.truncated);
+  buffer[4] = lowByte(stats.skipped);
+  buffer[5] = highByte(stats.skipped);
+  buffer[6] = lowByte(stats.maxLate);
+  buffer[7] = highByte(stats.maxLate);
+  return 8U;
+}
+
+/** @brief Send the event counters of every fuel and ignition schedule (See schedule_stats_t in scheduler.h)
+ * The reply is the number of fuel and then ignition channels (1 byte each), followed by the late starts, truncated pulses,
+ * skipped events and max lateness (uS) of each fuel channel and then each ignition channel, as little endian U16s.
+ * The counters are cleared with the TS_CMD_SCHED_STATS_RESET button command
+ */
+static void sendScheduleStats(comms_session_t &session)
+{
+  const uint16_t length = 3U + ((INJ_CHANNELS + IGN_CHANNELS) * 8U);
+  if(length > session.payloadSize) { sendReturnCodeMsg(session, SERIAL_RC_RANGE_ERR); return; }
+
+  session.payload[0] = SERIAL_RC_OK;
+  session.payload[1] = INJ_CHANNELS;
+  session.payload[2] = IGN_CHANNELS;
+  uint16_t payloadIndex = 3U;
+  schedule_stats_t stats;
+  for(uint8_t channel = 0; channel < INJ_CHANNELS; channel++)
+  {
+    if(!getFuelScheduleStats(channel, stats)) { stats = schedule_stats_t(); }
+    payloadIndex += putScheduleStats(&session.payload[payloadIndex], stats);
+  }
+  for(uint8_t channel = 0; channel < IGN_CHANNELS; channel++)
+  {
+    if(!getIgnitionScheduleStats(channel, stats)) { stats = schedule_stats_t(); }
+    payloadIndex += putScheduleStats(&session.payload[payloadIndex], stats);
+  }
+  sendSerialPayloadNonBlocking(session, payloadIndex);
+}
 
-  serialPayload[0] = SERIAL_RC_OK;
-  for(uint16_t x=0; x<packetLength; x++)
+/** @brief Send part of the learned VE table (See veLearn.h)
+ * The cells are sent in the same order as the VE table page, so the reply can be written straight into the VE table.
+ * Cells past the end of the table are sent as 0
+ */
+static void sendLearnedVE(comms_session_t &session, uint16_t offset, uint16_t length)
+{
+  constexpr uint16_t tableSize = sizeof(fuelTable.values.values);
+  session.payload[0] = SERIAL_RC_OK;
+  for(uint16_t cell = 0; cell < length; cell++)
   {
-    serialPayload[x+1U] = getTSLogEntry(offset+x); 
+    session.payload[cell + 1U] = ((offset + cell) < tableSize) ? getLearnedVE((table3d_dim_t)(offset + cell)) : 0U;
   }
-  // Reset any flags that are being used to trigger page refreshes
-  BIT_CLEAR(currentStatus.status3, BIT_STATUS3_VSS_REFRESH);
+  sendSerialPayloadNonBlocking(session, length + 1U);
 }
 
 /**
- * @brief Update the oxygen sensor table from serialPayload
+ * @brief Update the oxygen sensor table from a received payload
  * 
- * @param offset Offset into serialPayload and the table
- * @param chunkSize Number of bytes available in serialPayload
+ * @param payload The received payload
+ * @param offset Offset into the table
+ * @param chunkSize Number of bytes available in the payload
  */
-static void loadO2CalibrationChunk(uint16_t offset, uint16_t chunkSize)
+static void loadO2CalibrationChunk(const byte *payload, uint16_t offset, uint16_t chunkSize)
 {
   using pCrcCalc = uint32_t (FastCRC32::*)(const uint8_t *, const uint16_t, bool);
   // First pass through the loop, we need to INITIALIZE the CRC
@@ -395,12 +425,12 @@ static void loadO2CalibrationChunk(uint16_t offset, uint16_t chunkSize)
     //As we're using an interpolated 2D table, we only need to store 32 values out of this 1024
     if( (x % 32U) == 0U )
     {
-      o2Calibration_values[offset/32U] = serialPayload[x+7U]; //O2 table stores 8 bit values
+      o2Calibration_values[offset/32U] = payload[x+7U]; //O2 table stores 8 bit values
       o2Calibration_bins[offset/32U]   = offset;
     }
 
     //Update the CRC
-    calibrationCRC = (CRC32_calibration.*pCrcFun)(&serialPayload[x+7U], 1, false);
+    calibrationCRC = (CRC32_calibration.*pCrcFun)(&payload[x+7U], 1, false);
     // Subsequent passes through the loop, we need to UPDATE the CRC
     pCrcFun = &FastCRC32::crc32_upd;
   }
@@ -427,131 +457,152 @@ static uint16_t toTemperature(byte lo, byte hi)
 }
 
 /**
- * @brief Update a temperature calibration table from serialPayload
+ * @brief Update a temperature calibration table from the session payload
   * 
+ * @param session The session the calibration was received on
  * @param calibrationLength The chunk size received from TS
  * @param calibrationPage Index of the table
  * @param values The table values
  * @param bins The table bin values
  */
-static void processTemperatureCalibrationTableUpdate(uint16_t calibrationLength, uint8_t calibrationPage, uint16_t *values, uint16_t *bins)
+static void processTemperatureCalibrationTableUpdate(comms_session_t &session, uint16_t calibrationLength, uint8_t calibrationPage, uint16_t *values, uint16_t *bins)
 {
   //Temperature calibrations are sent as 32 16-bit values
   if(calibrationLength == 64U)
   {
     for (uint16_t x = 0; x < 32U; x++)
     {
-      values[x] = toTemperature(serialPayload[(2U * x) + 7U], serialPayload[(2U * x) + 8U]);
+      values[x] = toTemperature(session.payload[(2U * x) + 7U], session.payload[(2U * x) + 8U]);
       bins[x] = (x * 33U); // 0*33=0 to 31*33=1023
     }
-    storeCalibrationCRC32(calibrationPage, CRC32_calibration.crc32(&serialPayload[7], 64));
+    storeCalibrationCRC32(calibrationPage, CRC32_calibration.crc32(&session.payload[7], 64));
     writeCalibrationPage(calibrationPage);
-    sendReturnCodeMsg(SERIAL_RC_OK);
+    sendReturnCodeMsg(session, SERIAL_RC_OK);
   }
   else 
   { 
-    sendReturnCodeMsg(SERIAL_RC_RANGE_ERR); 
+    sendReturnCodeMsg(session, SERIAL_RC_RANGE_ERR);
+  }
+}
+
+/** @brief Checks and processes a frame once it has been completely received */
+static void processReceivedFrame(comms_session_t &session)
+{
+  if ( (session.payloadLength == 0U) || (session.payloadLength > session.payloadSize) )
+  {
+    //The command was read so the next one is still found, but there is nothing that can be done with it
+    sendReturnCodeMsg(session, SERIAL_RC_RANGE_ERR);
+  }
+  else if (session.payloadCrc == session.crc.crc32(session.payload, session.payloadLength))
+  {
+    //CRC is correct. Process the command
+    processSerialCommand(session);
+    BIT_CLEAR(currentStatus.status4, BIT_STATUS4_ALLOW_LEGACY_COMMS); //Lock out legacy commands until next power cycle
+  }
+  else
+  {
+    //CRC Error. Need to send an error message
+    flushRXbuffer(*session.port);
+    sendReturnCodeMsg(session, SERIAL_RC_CRC_ERR);
   }
 }
 
 // ====================================== End Internal Functions =============================
 
 
-/** Processes the incoming data on the serial buffer based on the command sent.
-Can be either data for a new command or a continuation of data for command that is already in progress:
+/** Processes the incoming data on the session's port based on the command sent.
+Can be either data for a new command or a continuation of data for command that is already in progress.
 
-Commands are single byte (letter symbol) commands.
+Commands are framed as a 2 byte length, the payload and then its 4 byte CRC. The frame is read as it arrives, so this never
+waits for the rest of a command.
 */
-void serialReceive(void)
+void serialReceive(comms_session_t &session)
 {
+  Stream &port = *session.port;
+  SerialStatus &status = *session.status;
+
   //Check for an existing legacy command in progress
-  if(serialStatusFlag==SERIAL_COMMAND_INPROGRESS_LEGACY)
+  if(status==SERIAL_COMMAND_INPROGRESS_LEGACY)
   {
-    legacySerialCommand();
+    session.legacyCommand();
     return;
   }
 
-  if (primarySerial.available()!=0 && serialStatusFlag == SERIAL_INACTIVE)
+  if ( (port.available()!=0) && (status == SERIAL_INACTIVE) && isPayloadBufferFree(session) )
   { 
     //New command received
-    //Need at least 2 bytes to read the length of the command
-    char highByte = (char)primarySerial.peek();
+    char highByte = (char)port.peek();
 
     //Check if the command is legacy using the call/response mechanism
     if(highByte == 'F')
     {
       //F command is always allowed as it provides the initial serial protocol version. 
-      legacySerialCommand();
+      session.legacyCommand();
       return;
     }
     else if( (((highByte >= 'A') && (highByte <= 'z')) || (highByte == '?')) && (BIT_CHECK(currentStatus.status4, BIT_STATUS4_ALLOW_LEGACY_COMMS)) )
     {
       //Handle legacy cases here
-      legacySerialCommand();
+      session.legacyCommand();
       return;
     }
     else
     {
-      serialReceiveStartTime = millis();
-      serialPayloadLength = readSerialIntegralTimeout<uint16_t>();
-      if (!isRxTimeout()) {
-        serialBytesRxTx = 0U;
-        serialStatusFlag = SERIAL_RECEIVE_INPROGRESS; //Flag the serial receive as being in progress
-      }
+      session.receiveStartTime = millis();
+      session.payloadLength = 0U;
+      session.payloadCrc = 0U;
+      session.bytesRxTx = 0U;
+      status = SERIAL_RECEIVE_INPROGRESS; //Flag the serial receive as being in progress
     }
   }
 
   //If there is a serial receive in progress, read as much from the buffer as possible or until we receive all bytes
-  while( (primarySerial.available() > 0) && (serialStatusFlag == SERIAL_RECEIVE_INPROGRESS) )
+  while( (port.available() > 0) && (status == SERIAL_RECEIVE_INPROGRESS) )
   {
-    if (serialBytesRxTx < serialPayloadLength )
+    byte value = (byte)port.read();
+    if (session.bytesRxTx < FRAME_LENGTH_SIZE)
     {
-      serialPayload[serialBytesRxTx] = (byte)primarySerial.read();
-      ++serialBytesRxTx;
+      session.payloadLength = (session.payloadLength << 8U) | value;
+    }
+    else if (session.bytesRxTx < (FRAME_LENGTH_SIZE + session.payloadLength))
+    {
+      //A command too long for the buffer is read to the end, but not kept
+      uint16_t payloadIndex = session.bytesRxTx - FRAME_LENGTH_SIZE;
+      if (payloadIndex < session.payloadSize) { session.payload[payloadIndex] = value; }
     }
     else
     {
-      uint32_t incomingCrc = readSerialIntegralTimeout<uint32_t>();
-      serialStatusFlag = SERIAL_INACTIVE; //The serial receive is now complete
+      session.payloadCrc = (session.payloadCrc << 8U) | value; //The CRC is sent most significant byte first
+    }
+    ++session.bytesRxTx;
 
-      if (!isRxTimeout()) // CRC read can timeout also!
-      {
-        if (incomingCrc == CRC32_serial.crc32(serialPayload, serialPayloadLength))
-        {
-          //CRC is correct. Process the command
-          processSerialCommand();
-          BIT_CLEAR(currentStatus.status4, BIT_STATUS4_ALLOW_LEGACY_COMMS); //Lock out legacy commands until next power cycle
-        }
-        else {
-          //CRC Error. Need to send an error message
-          sendReturnCodeMsg(SERIAL_RC_CRC_ERR);
-          flushRXbuffer();
-        }
-      }
-      // else timeout - code below will kick in.
+    if ( (session.bytesRxTx > FRAME_LENGTH_SIZE) && (session.bytesRxTx == ((uint32_t)FRAME_LENGTH_SIZE + session.payloadLength + sizeof(crc_t))) )
+    {
+      status = SERIAL_INACTIVE; //The serial receive is now complete
+      processReceivedFrame(session);
     }
   } //Data in serial buffer and serial receive in progress
 
   //Check for a timeout
-  if( isRxTimeout() )
+  if( (status == SERIAL_RECEIVE_INPROGRESS) && isRxTimeout(session) )
   {
-    serialStatusFlag = SERIAL_INACTIVE; //Reset the serial receive
+    status = SERIAL_INACTIVE; //Reset the serial receive
 
-    flushRXbuffer();
-    sendReturnCodeMsg(SERIAL_RC_TIMEOUT);
+    flushRXbuffer(port);
+    sendReturnCodeMsg(session, SERIAL_RC_TIMEOUT);
   } //Timeout
 }
 
-void serialTransmit(void)
+void serialTransmit(comms_session_t &session)
 {
-  switch (serialStatusFlag)
+  switch (*session.status)
   {
     case SERIAL_TRANSMIT_INPROGRESS_LEGACY:
-      sendValues(logItemsTransmitted, inProgressLength, SEND_OUTPUT_CHANNELS, Serial, serialStatusFlag);
+      sendValuesContinue(*session.status);
       break;
 
     case SERIAL_TRANSMIT_TOOTH_INPROGRESS:
-      sendToothLog();
+      sendToothLog(session);
       break;
 
     case SERIAL_TRANSMIT_TOOTH_INPROGRESS_LEGACY:
@@ -559,12 +610,11 @@ void serialTransmit(void)
       break;
 
     case SERIAL_TRANSMIT_COMPOSITE_INPROGRESS:
-      sendCompositeLog();
+      sendCompositeLog(session);
       break;
 
     case SERIAL_TRANSMIT_INPROGRESS:
-      serialBytesRxTx = sendBufferAndCrcNonBlocking(serialPayload, serialBytesRxTx, serialPayloadLength);
-      serialStatusFlag = serialBytesRxTx==serialPayloadLength+sizeof(crc_t) ? SERIAL_INACTIVE : SERIAL_TRANSMIT_INPROGRESS;
+      *session.status = sendFrameNonBlocking(session) ? SERIAL_INACTIVE : SERIAL_TRANSMIT_INPROGRESS;
       break;
 
     default: // Nothing to do
@@ -572,99 +622,99 @@ void serialTransmit(void)
   }
 }
 
-void processSerialCommand(void)
+static void processSerialCommand(comms_session_t &session)
 {
-  switch (serialPayload[0])
+  switch (session.payload[0])
   {
 
     case 'A': // send x bytes of realtime values in legacy support format
-      generateLiveValues(0, LOG_ENTRY_SIZE); 
+      generateLiveValues(session, 0, LOG_ENTRY_SIZE); 
       break;
 
     case 'b': // New EEPROM burn command to only burn a single page at a time 
-      if( (micros() > deferEEPROMWritesUntil)) { writeConfig(serialPayload[2]); } //Read the table number and perform burn. Note that byte 1 in the array is unused
+      if( (micros() > deferEEPROMWritesUntil)) { writeConfig(session.payload[2]); } //Read the table number and perform burn. Note that byte 1 in the array is unused
       else { BIT_SET(currentStatus.status4, BIT_STATUS4_BURNPENDING); }
       
-      sendReturnCodeMsg(SERIAL_RC_BURN_OK);
+      sendReturnCodeMsg(session, SERIAL_RC_BURN_OK);
       break;
 
     case 'B': // Same as above, but for the comms compat mode. Slows down the burn rate and increases the defer time
       BIT_SET(currentStatus.status4, BIT_STATUS4_COMMS_COMPAT); //Force the compat mode
       deferEEPROMWritesUntil += (EEPROM_DEFER_DELAY/4); //Add 25% more to the EEPROM defer time
-      if( (micros() > deferEEPROMWritesUntil)) { writeConfig(serialPayload[2]); } //Read the table number and perform burn. Note that byte 1 in the array is unused
+      if( (micros() > deferEEPROMWritesUntil)) { writeConfig(session.payload[2]); } //Read the table number and perform burn. Note that byte 1 in the array is unused
       else { BIT_SET(currentStatus.status4, BIT_STATUS4_BURNPENDING); }
       
-      sendReturnCodeMsg(SERIAL_RC_BURN_OK);
+      sendReturnCodeMsg(session, SERIAL_RC_BURN_OK);
       break;
 
     case 'C': // test communications. This is used by Tunerstudio to see whether there is an ECU on a given serial port
-      (void)memcpy_P(serialPayload, testCommsResponse, sizeof(testCommsResponse) );
-      sendSerialPayloadNonBlocking(sizeof(testCommsResponse));
+      (void)memcpy_P(session.payload, testCommsResponse, sizeof(testCommsResponse) );
+      sendSerialPayloadNonBlocking(session, sizeof(testCommsResponse));
       break;
 
     case 'd': // Send a CRC32 hash of a given page
     {
-      uint32_t CRC32_val = reverse_bytes(calculatePageCRC32( serialPayload[2] ));
+      uint32_t CRC32_val = reverse_bytes(calculatePageCRC32( session.payload[2] ));
 
-      serialPayload[0] = SERIAL_RC_OK;
-      (void)memcpy(&serialPayload[1], (byte*)&CRC32_val, sizeof(CRC32_val));
-      sendSerialPayloadNonBlocking(5);      
+      session.payload[0] = SERIAL_RC_OK;
+      (void)memcpy(&session.payload[1], (byte*)&CRC32_val, sizeof(CRC32_val));
+      sendSerialPayloadNonBlocking(session, 5);      
       break;
     }
 
     case 'E': // receive command button commands
-      (void)TS_CommandButtonsHandler(word(serialPayload[1], serialPayload[2]));
-      sendReturnCodeMsg(SERIAL_RC_OK);
+      (void)TS_CommandButtonsHandler(word(session.payload[1], session.payload[2]));
+      sendReturnCodeMsg(session, SERIAL_RC_OK);
       break;
 
     case 'f': //Send serial capability details
-      serialPayload[0] = SERIAL_RC_OK;
-      serialPayload[1] = 2; //Serial protocol version
-      serialPayload[2] = highByte(BLOCKING_FACTOR);
-      serialPayload[3] = lowByte(BLOCKING_FACTOR);
-      serialPayload[4] = highByte(TABLE_BLOCKING_FACTOR);
-      serialPayload[5] = lowByte(TABLE_BLOCKING_FACTOR);
+      session.payload[0] = SERIAL_RC_OK;
+      session.payload[1] = 2; //Serial protocol version
+      session.payload[2] = highByte(BLOCKING_FACTOR);
+      session.payload[3] = lowByte(BLOCKING_FACTOR);
+      session.payload[4] = highByte(TABLE_BLOCKING_FACTOR);
+      session.payload[5] = lowByte(TABLE_BLOCKING_FACTOR);
       
-      sendSerialPayloadNonBlocking(6);
+      sendSerialPayloadNonBlocking(session, 6);
       break;
 
     case 'F': // send serial protocol version
-      (void)memcpy_P(serialPayload, serialVersion, sizeof(serialVersion) );
-      sendSerialPayloadNonBlocking(sizeof(serialVersion));
+      (void)memcpy_P(session.payload, serialVersion, sizeof(serialVersion) );
+      sendSerialPayloadNonBlocking(session, sizeof(serialVersion));
       break;
 
     case 'H': //Start the tooth logger
       startToothLogger();
-      sendReturnCodeMsg(SERIAL_RC_OK);
+      sendReturnCodeMsg(session, SERIAL_RC_OK);
       break;
 
     case 'h': //Stop the tooth logger
       stopToothLogger();
-      sendReturnCodeMsg(SERIAL_RC_OK);
+      sendReturnCodeMsg(session, SERIAL_RC_OK);
       break;
 
     case 'I': // send CAN ID
-      (void)memcpy_P(serialPayload, canId, sizeof(canId) );
-      sendSerialPayloadNonBlocking(sizeof(serialVersion));
+      (void)memcpy_P(session.payload, canId, sizeof(canId) );
+      sendSerialPayloadNonBlocking(session, sizeof(serialVersion));
       break;
 
     case 'J': //Start the composite logger
       startCompositeLogger();
-      sendReturnCodeMsg(SERIAL_RC_OK);
+      sendReturnCodeMsg(session, SERIAL_RC_OK);
       break;
 
     case 'j': //Stop the composite logger
       stopCompositeLogger();
-      sendReturnCodeMsg(SERIAL_RC_OK);
+      sendReturnCodeMsg(session, SERIAL_RC_OK);
       break;
 
     case 'k': //Send CRC values for the calibration pages
     {
-      uint32_t CRC32_val = reverse_bytes(readCalibrationCRC32(serialPayload[2])); //Get the CRC for the requested page
+      uint32_t CRC32_val = reverse_bytes(readCalibrationCRC32(session.payload[2])); //Get the CRC for the requested page
 
-      serialPayload[0] = SERIAL_RC_OK;
-      (void)memcpy(&serialPayload[1], (byte*)&CRC32_val, sizeof(CRC32_val));
-      sendSerialPayloadNonBlocking(5);
+      session.payload[0] = SERIAL_RC_OK;
+      (void)memcpy(&session.payload[1], (byte*)&CRC32_val, sizeof(CRC32_val));
+      sendSerialPayloadNonBlocking(session, 5);
       break;
     }
 
@@ -676,36 +726,36 @@ void processSerialCommand(void)
       //2 - offset
       //2 - Length
       //1 - 1st New value
-      if (updatePageValues(serialPayload[2], word(serialPayload[4], serialPayload[3]), &serialPayload[7], word(serialPayload[6], serialPayload[5])))
+      if (updatePageValues(session.payload[2], word(session.payload[4], session.payload[3]), &session.payload[7], word(session.payload[6], session.payload[5])))
       {
-        sendReturnCodeMsg(SERIAL_RC_OK);    
+        sendReturnCodeMsg(session, SERIAL_RC_OK);    
       }
       else
       {
         //This should never happen, but just in case
-        sendReturnCodeMsg(SERIAL_RC_RANGE_ERR);
+        sendReturnCodeMsg(session, SERIAL_RC_RANGE_ERR);
       }
       break;
     }  
 
     case 'O': //Start the composite logger 2nd cam (teritary)
       startCompositeLoggerTertiary();
-      sendReturnCodeMsg(SERIAL_RC_OK);
+      sendReturnCodeMsg(session, SERIAL_RC_OK);
       break;
 
     case 'o': //Stop the composite logger 2nd cam (tertiary)
       stopCompositeLoggerTertiary();
-      sendReturnCodeMsg(SERIAL_RC_OK);
+      sendReturnCodeMsg(session, SERIAL_RC_OK);
       break;
 
     case 'X': //Start the composite logger 2nd cam (teritary)
       startCompositeLoggerCams();
-      sendReturnCodeMsg(SERIAL_RC_OK);
+      sendReturnCodeMsg(session, SERIAL_RC_OK);
       break;
 
     case 'x': //Stop the composite logger 2nd cam (tertiary)
       stopCompositeLoggerCams();
-      sendReturnCodeMsg(SERIAL_RC_OK);
+      sendReturnCodeMsg(session, SERIAL_RC_OK);
       break;
 
     /*
@@ -717,54 +767,61 @@ void processSerialCommand(void)
       //2 - Page identifier
       //2 - offset
       //2 - Length
-      uint16_t length = word(serialPayload[6], serialPayload[5]);
+      uint16_t length = word(session.payload[6], session.payload[5]);
 
-      //Setup the transmit buffer
-      serialPayload[0] = SERIAL_RC_OK;
-      loadPageValuesToBuffer(serialPayload[2], word(serialPayload[4], serialPayload[3]), &serialPayload[1], length);
-      sendSerialPayloadNonBlocking(length + 1U);
+      if(length >= session.payloadSize) { sendReturnCodeMsg(session, SERIAL_RC_RANGE_ERR); } //Doesn't fit in this session's buffer
+      else
+      {
+        //Setup the transmit buffer
+        session.payload[0] = SERIAL_RC_OK;
+        loadPageValuesToBuffer(session.payload[2], word(session.payload[4], session.payload[3]), &session.payload[1], length);
+        sendSerialPayloadNonBlocking(session, length + 1U);
+      }
       break;
     }
 
     case 'Q': // send code version
-      (void)memcpy_P(serialPayload, codeVersion, sizeof(codeVersion) );
-      sendSerialPayloadNonBlocking(sizeof(codeVersion));
+      (void)memcpy_P(session.payload, codeVersion, sizeof(codeVersion) );
+      sendSerialPayloadNonBlocking(session, sizeof(codeVersion));
       break;
 
     case 'r': //New format for the optimised OutputChannels
     {
-      uint8_t cmd = serialPayload[2];
-      uint16_t offset = word(serialPayload[4], serialPayload[3]);
-      uint16_t length = word(serialPayload[6], serialPayload[5]);
+      uint8_t cmd = session.payload[2];
+      uint16_t offset = word(session.payload[4], session.payload[3]);
+      uint16_t length = word(session.payload[6], session.payload[5]);
 #ifdef COMMS_SD     
-      uint16_t SD_arg1 = word(serialPayload[3], serialPayload[4]);
-      uint16_t SD_arg2 = word(serialPayload[5], serialPayload[6]);
+      uint16_t SD_arg1 = word(session.payload[3], session.payload[4]);
+      uint16_t SD_arg2 = word(session.payload[5], session.payload[6]);
 #endif
 
-      if(cmd == SEND_OUTPUT_CHANNELS) //Send output channels command 0x30 is 48dec
+      if( ((cmd == SEND_OUTPUT_CHANNELS) || (cmd == SEND_VE_LEARN)) && (length >= session.payloadSize) ) { sendReturnCodeMsg(session, SERIAL_RC_RANGE_ERR); }
+      else if(cmd == SEND_OUTPUT_CHANNELS) //Send output channels command 0x30 is 48dec
       {
-        generateLiveValues(offset, length);
-        sendSerialPayloadNonBlocking(length + 1U);
+        generateLiveValues(session, offset, length);
+        sendSerialPayloadNonBlocking(session, length + 1U);
       }
+      else if(cmd == SEND_SCHEDULE_STATS) { sendScheduleStats(session); }
+      else if(cmd == SEND_VE_LEARN) { sendLearnedVE(session, offset, length); }
       else if(cmd == 0x0fU)
       {
         //Request for signature
-        (void)memcpy_P(serialPayload, codeVersion, sizeof(codeVersion) );
-        sendSerialPayloadNonBlocking(sizeof(codeVersion));
+        (void)memcpy_P(session.payload, codeVersion, sizeof(codeVersion) );
+        sendSerialPayloadNonBlocking(session, sizeof(codeVersion));
       }
 #ifdef COMMS_SD
       else if(cmd == SD_RTC_PAGE) //Request to read SD card RTC
       {
-        serialPayload[0] = SERIAL_RC_OK;
-        serialPayload[1] = rtc_getSecond(); //Seconds
-        serialPayload[2] = rtc_getMinute(); //Minutes
-        serialPayload[3] = rtc_getHour(); //Hours
-        serialPayload[4] = rtc_getDOW(); //Day of week
-        serialPayload[5] = rtc_getDay(); //Day of month
-        serialPayload[6] = rtc_getMonth(); //Month
-        serialPayload[7] = highByte(rtc_getYear()); //Year
-        serialPayload[8] = lowByte(rtc_getYear()); //Year
-        sendSerialPayloadNonBlocking(9);
+        session.payload[0] = SERIAL_RC_OK;
+        session.payload[1] = rtc_getSecond(); //Seconds
+        session.payload[2] = rtc_getMinute(); //Minutes
+        session.payload[3] = rtc_getHour(); //Hours
+        session.payload[4] = rtc_getDOW(); //Day of week
+        session.payload[5] = rtc_getDay(); //Day of month
+        session.payload[6] = rtc_getMonth(); //Month
+        session.payload[7] = highByte(rtc_getYear()); //Year
+        session.payload[8] = lowByte(rtc_getYear()); //Year
+        sendSerialPayloadNonBlocking(session, 9);
       }
       else if(cmd == SD_READWRITE_PAGE) //Request SD card extended parameters
       {
@@ -773,58 +830,58 @@ void processSerialCommand(void)
         {
           //Read the status of the SD card
           
-          serialPayload[0] = SERIAL_RC_OK;
+          session.payload[0] = SERIAL_RC_OK;
 
-          serialPayload[1] = currentStatus.TS_SD_Status;
-          serialPayload[2] = 0; //Error code
+          session.payload[1] = currentStatus.TS_SD_Status;
+          session.payload[2] = 0; //Error code
  
           //Sector size = 512
-          serialPayload[3] = 2;
-          serialPayload[4] = 0;
+          session.payload[3] = 2;
+          session.payload[4] = 0;
 
           //Max blocks (4 bytes)
           uint32_t sectors = sectorCount();
-          serialPayload[5] = ((sectors >> 24) & 255);
-          serialPayload[6] = ((sectors >> 16) & 255);
-          serialPayload[7] = ((sectors >> 8) & 255);
-          serialPayload[8] = (sectors & 255);
+          session.payload[5] = ((sectors >> 24) & 255);
+          session.payload[6] = ((sectors >> 16) & 255);
+          session.payload[7] = ((sectors >> 8) & 255);
+          session.payload[8] = (sectors & 255);
 
           //Max roots (Number of files)
           uint16_t numLogFiles = getNextSDLogFileNumber() - 2; // -1 because this returns the NEXT file name not the current one and -1 because TS expects a 0 based index
-          serialPayload[9] = highByte(numLogFiles);
-          serialPayload[10] = lowByte(numLogFiles);
+          session.payload[9] = highByte(numLogFiles);
+          session.payload[10] = lowByte(numLogFiles);
 
           //Dir Start (4 bytes)
-          serialPayload[11] = 0;
-          serialPayload[12] = 0;
-          serialPayload[13] = 0;
-          serialPayload[14] = 0;
+          session.payload[11] = 0;
+          session.payload[12] = 0;
+          session.payload[13] = 0;
+          session.payload[14] = 0;
 
           //Unknown purpose for last 2 bytes
-          serialPayload[15] = 0;
-          serialPayload[16] = 0;
+          session.payload[15] = 0;
+          session.payload[16] = 0;
 
-          sendSerialPayloadNonBlocking(17);
+          sendSerialPayloadNonBlocking(session, 17);
 
         }
         else if((SD_arg1 == SD_READ_DIR_ARG1) && (SD_arg2 == SD_READ_DIR_ARG2))
         {
           //Send file details
-          serialPayload[0] = SERIAL_RC_OK;
+          session.payload[0] = SERIAL_RC_OK;
 
           uint16_t logFileNumber = (SDcurrentDirChunk * 16) + 1;
           uint8_t filesInCurrentChunk = 0;
           uint16_t payloadIndex = 1;
-          while((filesInCurrentChunk < 16) && (getSDLogFileDetails(&serialPayload[payloadIndex], logFileNumber) == true))
+          while((filesInCurrentChunk < 16) && (getSDLogFileDetails(&session.payload[payloadIndex], logFileNumber) == true))
           {
             logFileNumber++;
             filesInCurrentChunk++;
             payloadIndex += 32;
           }
-          serialPayload[payloadIndex] = lowByte(SDcurrentDirChunk);
-          serialPayload[payloadIndex + 1] = highByte(SDcurrentDirChunk);
+          session.payload[payloadIndex] = lowByte(SDcurrentDirChunk);
+          session.payload[payloadIndex + 1] = highByte(SDcurrentDirChunk);
 
-          sendSerialPayloadNonBlocking(payloadIndex + 2);
+          sendSerialPayloadNonBlocking(session, payloadIndex + 2);
         }
       }
       else if(cmd == SD_READFILE_PAGE)
@@ -833,9 +890,9 @@ void processSerialCommand(void)
         if(SD_arg2 == SD_READ_COMP_ARG2)
         {
           //arg1 is the block number to return
-          serialPayload[0] = SERIAL_RC_OK;
-          serialPayload[1] = highByte(SD_arg1);
-          serialPayload[2] = lowByte(SD_arg1);
+          session.payload[0] = SERIAL_RC_OK;
+          session.payload[1] = highByte(SD_arg1);
+          session.payload[2] = lowByte(SD_arg1);
 
           uint32_t currentSector = SDreadStartSector + (SD_arg1 * 4);
           
@@ -850,11 +907,12 @@ void processSerialCommand(void)
           }
           SDreadCompletedSectors += numSectorsToSend;
           
-          if(numSectorsToSend <= 0) { sendReturnCodeMsg(SERIAL_RC_OK); }
+          if(numSectorsToSend <= 0) { sendReturnCodeMsg(session, SERIAL_RC_OK); }
+          else if( ((uint32_t)numSectorsToSend * SD_SECTOR_SIZE + 3U) > session.payloadSize ) { sendReturnCodeMsg(session, SERIAL_RC_RANGE_ERR); } //Only the primary buffer is big enough for SD transfers
           else
           {
-            readSDSectors(&serialPayload[3], currentSector, numSectorsToSend); 
-            sendSerialPayloadNonBlocking(numSectorsToSend * SD_SECTOR_SIZE + 3);
+            readSDSectors(&session.payload[3], currentSector, numSectorsToSend); 
+            sendSerialPayloadNonBlocking(session, numSectorsToSend * SD_SECTOR_SIZE + 3);
           }
         }
       }
@@ -867,41 +925,45 @@ void processSerialCommand(void)
     }
 
     case 'S': // send code version
-      (void)memcpy_P(serialPayload, productString, sizeof(productString) );
-      sendSerialPayloadNonBlocking(sizeof(productString));
+      (void)memcpy_P(session.payload, productString, sizeof(productString) );
+      sendSerialPayloadNonBlocking(session, sizeof(productString));
       currentStatus.secl = 0; //This is required in TS3 due to its stricter timings
       break;
 
     case 'T': //Send 256 tooth log entries to Tuner Studios tooth logger
-      logItemsTransmitted = 0;
-      if(currentStatus.toothLogEnabled == true) { sendToothLog(); } //Sends tooth log values as ints
-      else if (currentStatus.compositeTriggerUsed > 0U) { sendCompositeLog(); }
-      else { /* MISRA no-op */ }
+      if( (pLogSession != nullptr) && (pLogSession != &session) ) { sendReturnCodeMsg(session, SERIAL_RC_BUSY_ERR); } //Another session is part way through sending the log
+      else
+      {
+        logItemsTransmitted = 0;
+        if(currentStatus.toothLogEnabled == true) { sendToothLog(session); } //Sends tooth log values as ints
+        else if (currentStatus.compositeTriggerUsed > 0U) { sendCompositeLog(session); }
+        else { /* MISRA no-op */ }
+      }
       break;
 
     case 't': // receive new Calibration info. Command structure: "t", <tble_idx> <data array>.
     {
-      uint8_t cmd = serialPayload[2];
-      uint16_t offset = word(serialPayload[3], serialPayload[4]);
-      uint16_t calibrationLength = word(serialPayload[5], serialPayload[6]); // Should be 256
+      uint8_t cmd = session.payload[2];
+      uint16_t offset = word(session.payload[3], session.payload[4]);
+      uint16_t calibrationLength = word(session.payload[5], session.payload[6]); // Should be 256
 
       if(cmd == O2_CALIBRATION_PAGE)
       {
-        loadO2CalibrationChunk(offset, calibrationLength);
-        sendReturnCodeMsg(SERIAL_RC_OK);
-        primarySerial.flush(); //This is safe because engine is assumed to not be running during calibration
+        loadO2CalibrationChunk(session.payload, offset, calibrationLength);
+        sendReturnCodeMsg(session, SERIAL_RC_OK);
+        session.port->flush(); //This is safe because engine is assumed to not be running during calibration
       }
       else if(cmd == IAT_CALIBRATION_PAGE)
       {
-        processTemperatureCalibrationTableUpdate(calibrationLength, IAT_CALIBRATION_PAGE, iatCalibration_values, iatCalibration_bins);
+        processTemperatureCalibrationTableUpdate(session, calibrationLength, IAT_CALIBRATION_PAGE, iatCalibration_values, iatCalibration_bins);
       }
       else if(cmd == CLT_CALIBRATION_PAGE)
       {
-        processTemperatureCalibrationTableUpdate(calibrationLength, CLT_CALIBRATION_PAGE, cltCalibration_values, cltCalibration_bins);
+        processTemperatureCalibrationTableUpdate(session, calibrationLength, CLT_CALIBRATION_PAGE, cltCalibration_values, cltCalibration_bins);
       }
       else
       {
-        sendReturnCodeMsg(SERIAL_RC_RANGE_ERR);
+        sendReturnCodeMsg(session, SERIAL_RC_RANGE_ERR);
       }
       break;
     }
@@ -910,16 +972,16 @@ void processSerialCommand(void)
       if (resetControl != RESET_CONTROL_DISABLED)
       {
       #ifndef SMALL_FLASH_MODE
-        if (serialStatusFlag == SERIAL_INACTIVE) { primarySerial.println(F("Comms halted. Next byte will reset the Arduino.")); }
+        if (*session.status == SERIAL_INACTIVE) { session.port->println(F("Comms halted. Next byte will reset the Arduino.")); }
       #endif
 
-        while (primarySerial.available() == 0) { }
+        while (session.port->available() == 0) { }
         digitalWrite(pinResetControl, LOW);
       }
       else
       {
       #ifndef SMALL_FLASH_MODE
-        if (serialStatusFlag == SERIAL_INACTIVE) { primarySerial.println(F("Reset control is currently disabled.")); }
+        if (*session.status == SERIAL_INACTIVE) { session.port->println(F("Reset control is currently disabled.")); }
       #endif
       }
       break;
@@ -927,9 +989,9 @@ void processSerialCommand(void)
     case 'w':
     {
 #ifdef COMMS_SD
-      uint8_t cmd = serialPayload[2];
-      uint16_t SD_arg1 = word(serialPayload[3], serialPayload[4]);
-      uint16_t SD_arg2 = word(serialPayload[5], serialPayload[6]);
+      uint8_t cmd = session.payload[2];
+      uint16_t SD_arg1 = word(session.payload[3], session.payload[4]);
+      uint16_t SD_arg2 = word(session.payload[5], session.payload[6]);
       if(cmd == SD_READWRITE_PAGE)
         { 
           if((SD_arg1 == SD_WRITE_DO_ARG1) && (SD_arg2 == SD_WRITE_DO_ARG2))
@@ -943,31 +1005,31 @@ void processSerialCommand(void)
             4 Load status variable
             5 Init SD card
             */
-            uint8_t command = serialPayload[7];
+            uint8_t command = session.payload[7];
             if(command == 2) { endSDLogging(); manualLogActive = false; }
             else if(command == 3) { beginSDLogging(); manualLogActive = true; }
             else if(command == 4) { setTS_SD_status(); }
             //else if(command == 5) { initSD(); }
             
-            sendReturnCodeMsg(SERIAL_RC_OK);
+            sendReturnCodeMsg(session, SERIAL_RC_OK);
           }
           else if((SD_arg1 == SD_WRITE_DIR_ARG1) && (SD_arg2 == SD_WRITE_DIR_ARG2))
           {
             //Begin SD directory read. Value in payload represents the directory chunk to read
             //Directory chunks are each 16 files long
-            SDcurrentDirChunk = word(serialPayload[7], serialPayload[8]);
-            sendReturnCodeMsg(SERIAL_RC_OK);
+            SDcurrentDirChunk = word(session.payload[7], session.payload[8]);
+            sendReturnCodeMsg(session, SERIAL_RC_OK);
           }
           else if((SD_arg1 == SD_WRITE_READ_SEC_ARG1) && (SD_arg2 == SD_WRITE_READ_SEC_ARG2))
           {
             //Read sector Init? Unsure what this is meant to do however it is sent at the beginning of a Card Format request and requires an OK response
             //Provided the sector being requested is x0 x0 x0 x0, we treat this as a SD Card format request
-            if( (serialPayload[7] == 0) && (serialPayload[8] == 0) && (serialPayload[9] == 0) && (serialPayload[10] == 0) )
+            if( (session.payload[7] == 0) && (session.payload[8] == 0) && (session.payload[9] == 0) && (session.payload[10] == 0) )
             {
-              //SD Card format request
-              formatExFat();
+              //SD Card format request. Queued the same as the format command button as it takes a long time
+              (void)TS_CommandButtonsHandler(TS_CMD_SD_FORMAT);
             }
-            sendReturnCodeMsg(SERIAL_RC_OK);
+            sendReturnCodeMsg(session, SERIAL_RC_OK);
           }
           else if((SD_arg1 == SD_WRITE_WRITE_SEC_ARG1) && (SD_arg2 == SD_WRITE_WRITE_SEC_ARG2))
           {
@@ -977,13 +1039,13 @@ void processSerialCommand(void)
           {
             //Erase file command
             //We just need the 4 ASCII characters of the file name
-            char log1 = serialPayload[7];
-            char log2 = serialPayload[8];
-            char log3 = serialPayload[9];
-            char log4 = serialPayload[10];
+            char log1 = session.payload[7];
+            char log2 = session.payload[8];
+            char log3 = session.payload[9];
+            char log4 = session.payload[10];
 
             deleteLogFile(log1, log2, log3, log4);
-            sendReturnCodeMsg(SERIAL_RC_OK);
+            sendReturnCodeMsg(session, SERIAL_RC_OK);
           }
           else if((SD_arg1 == SD_SPD_TEST_ARG1) && (SD_arg2 == SD_SPD_TEST_ARG2))
           {
@@ -992,47 +1054,47 @@ void processSerialCommand(void)
             #if 0
             TODO: Need to write test routine
             uint32_t sector;
-            uint8_t sector1 = serialPayload[7];
-            uint8_t sector2 = serialPayload[8];
-            uint8_t sector3 = serialPayload[9];
-            uint8_t sector4 = serialPayload[10];
+            uint8_t sector1 = session.payload[7];
+            uint8_t sector2 = session.payload[8];
+            uint8_t sector3 = session.payload[9];
+            uint8_t sector4 = session.payload[10];
             sector = (sector1 << 24) | (sector2 << 16) | (sector3 << 8) | sector4;
 
 
             //Last 4 bytes are the number of sectors to test
             uint32_t testSize;
-            uint8_t testSize1 = serialPayload[11];
-            uint8_t testSize2 = serialPayload[12];
-            uint8_t testSize3 = serialPayload[13];
-            uint8_t testSize4 = serialPayload[14];
+            uint8_t testSize1 = session.payload[11];
+            uint8_t testSize2 = session.payload[12];
+            uint8_t testSize3 = session.payload[13];
+            uint8_t testSize4 = session.payload[14];
             testSize = (testSize1 << 24) | (testSize2 << 16) | (testSize3 << 8) | testSize4; 
             #endif
 
-            sendReturnCodeMsg(SERIAL_RC_OK);
+            sendReturnCodeMsg(session, SERIAL_RC_OK);
 
           }
           else if((SD_arg1 == SD_WRITE_COMP_ARG1) && (SD_arg2 == SD_WRITE_COMP_ARG2))
           {
             //Prepare to read a 2024 byte chunk of data from the SD card
-            uint8_t sector1 = serialPayload[7];
-            uint8_t sector2 = serialPayload[8];
-            uint8_t sector3 = serialPayload[9];
-            uint8_t sector4 = serialPayload[10];
+            uint8_t sector1 = session.payload[7];
+            uint8_t sector2 = session.payload[8];
+            uint8_t sector3 = session.payload[9];
+            uint8_t sector4 = session.payload[10];
             //SDreadStartSector = (sector1 << 24) | (sector2 << 16) | (sector3 << 8) | sector4;
             SDreadStartSector = (sector4 << 24) | (sector3 << 16) | (sector2 << 8) | sector1;
             //SDreadStartSector = sector4 | (sector3 << 8) | (sector2 << 16) | (sector1 << 24);
 
             //Next 4 bytes are the number of sectors to write
-            uint8_t sectorCount1 = serialPayload[11];
-            uint8_t sectorCount2 = serialPayload[12];
-            uint8_t sectorCount3 = serialPayload[13];
-            uint8_t sectorCount4 = serialPayload[14];
+            uint8_t sectorCount1 = session.payload[11];
+            uint8_t sectorCount2 = session.payload[12];
+            uint8_t sectorCount3 = session.payload[13];
+            uint8_t sectorCount4 = session.payload[14];
             SDreadNumSectors = (sectorCount1 << 24) | (sectorCount2 << 16) | (sectorCount3 << 8) | sectorCount4;
 
             //Reset the sector counter
             SDreadCompletedSectors = 0;
 
-            sendReturnCodeMsg(SERIAL_RC_OK);
+            sendReturnCodeMsg(session, SERIAL_RC_OK);
           }
         }
         else if(cmd == SD_RTC_PAGE)
@@ -1041,15 +1103,15 @@ void processSerialCommand(void)
           if((SD_arg1 == SD_RTC_WRITE_ARG1) && (SD_arg2 == SD_RTC_WRITE_ARG2))
           {
             //Set the RTC date/time
-            byte second = serialPayload[7];
-            byte minute = serialPayload[8];
-            byte hour = serialPayload[9];
-            //byte dow = serialPayload[10]; //Not used
-            byte day = serialPayload[11];
-            byte month = serialPayload[12];
-            uint16_t year = word(serialPayload[13], serialPayload[14]);
+            byte second = session.payload[7];
+            byte minute = session.payload[8];
+            byte hour = session.payload[9];
+            //byte dow = session.payload[10]; //Not used
+            byte day = session.payload[11];
+            byte month = session.payload[12];
+            uint16_t year = word(session.payload[13], session.payload[14]);
             rtc_setTime(second, minute, hour, day, month, year);
-            sendReturnCodeMsg(SERIAL_RC_OK);
+            sendReturnCodeMsg(session, SERIAL_RC_OK);
           }
         }
 #endif
@@ -1058,16 +1120,15 @@ void processSerialCommand(void)
 
     default:
       //Unknown command
-      sendReturnCodeMsg(SERIAL_RC_UKWN_ERR);
+      sendReturnCodeMsg(session, SERIAL_RC_UKWN_ERR);
       break;
   }
 }
 
-/** 
- * 
-*/
-void sendToothLog(void)
+static void sendToothLog(comms_session_t &session)
 {
+  Stream &port = *session.port;
+
   //We need TOOTH_LOG_SIZE number of records to send to TunerStudio. If there aren't that many in the buffer then we just return and wait for the next call
   if (BIT_CHECK(currentStatus.status1, BIT_STATUS1_TOOTHLOG1READY) == false) 
   {
@@ -1083,43 +1144,47 @@ void sendToothLog(void)
   if(logItemsTransmitted == 0U)
   {
     //Transmit the size of the packet
-    (void)serialWrite((uint16_t)(sizeof(toothHistory) + 1U)); //Size of the tooth log (uint32_t values) plus the return code
+    (void)serialWrite(port, (uint16_t)(sizeof(toothHistory) + 1U)); //Size of the tooth log (uint32_t values) plus the return code
+    pLogSession = &session;
     //Begin new CRC hash
     const uint8_t returnCode = SERIAL_RC_OK;
-    CRC32_val = CRC32_serial.crc32(&returnCode, 1, false);
+    CRC32_val = session.crc.crc32(&returnCode, 1, false);
 
     //Send the return code
-    writeByteReliableBlocking(returnCode);
+    writeByteReliableBlocking(port, returnCode);
   }
   
   for (; logItemsTransmitted < TOOTH_LOG_SIZE; logItemsTransmitted++)
   {
     //Check whether the tx buffer still has space
-    if(primarySerial.availableForWrite() < 4) 
+    if(port.availableForWrite() < 4) 
     { 
       //tx buffer is full. Store the current state so it can be resumed later
-      serialStatusFlag = SERIAL_TRANSMIT_TOOTH_INPROGRESS;
+      *session.status = SERIAL_TRANSMIT_TOOTH_INPROGRESS;
       return;
     }
 
     //Transmit the tooth time
-    uint32_t transmitted = serialWrite(toothHistory[logItemsTransmitted]);
-    CRC32_val = CRC32_serial.crc32_upd((const byte*)&transmitted, sizeof(transmitted), false);
+    uint32_t transmitted = serialWrite(port, toothHistory[logItemsTransmitted]);
+    CRC32_val = session.crc.crc32_upd((const byte*)&transmitted, sizeof(transmitted), false);
   }
   BIT_CLEAR(currentStatus.status1, BIT_STATUS1_TOOTHLOG1READY);
-  serialStatusFlag = SERIAL_INACTIVE;
+  *session.status = SERIAL_INACTIVE;
   toothHistoryIndex = 0;
   logItemsTransmitted = 0;
+  pLogSession = nullptr;
 
   //Apply the CRC reflection
   CRC32_val = ~CRC32_val;
 
   //Send the CRC
-  (void)serialWrite(CRC32_val);
+  (void)serialWrite(port, CRC32_val);
 }
 
-void sendCompositeLog(void)
+static void sendCompositeLog(comms_session_t &session)
 {
+  Stream &port = *session.port;
+
   if ( BIT_CHECK(currentStatus.status1, BIT_STATUS1_TOOTHLOG1READY) == false )
   {
     //If the buffer is not yet full but TS has timed out, pad the rest of the buffer with 0s
@@ -1135,43 +1200,45 @@ void sendCompositeLog(void)
   if(logItemsTransmitted == 0U)
   { 
     //Transmit the size of the packet
-    (void)serialWrite((uint16_t)(sizeof(toothHistory) + sizeof(compositeLogHistory) + 1U)); //Size of the tooth log (uint32_t values) plus the return code
+    (void)serialWrite(port, (uint16_t)(sizeof(toothHistory) + sizeof(compositeLogHistory) + 1U)); //Size of the tooth log (uint32_t values) plus the return code
     
+    pLogSession = &session;
     //Begin new CRC hash
     const uint8_t returnCode = SERIAL_RC_OK;
-    CRC32_val = CRC32_serial.crc32(&returnCode, 1, false);
+    CRC32_val = session.crc.crc32(&returnCode, 1, false);
 
     //Send the return code
-    writeByteReliableBlocking(returnCode);
+    writeByteReliableBlocking(port, returnCode);
   }
 
   for (; logItemsTransmitted < TOOTH_LOG_SIZE; logItemsTransmitted++)
   {
     //Check whether the tx buffer still has space
-    if((uint16_t)primarySerial.availableForWrite() < sizeof(toothHistory[logItemsTransmitted])+sizeof(compositeLogHistory[logItemsTransmitted])) 
+    if((uint16_t)port.availableForWrite() < sizeof(toothHistory[logItemsTransmitted])+sizeof(compositeLogHistory[logItemsTransmitted])) 
     { 
       //tx buffer is full. Store the current state so it can be resumed later
-      serialStatusFlag = SERIAL_TRANSMIT_COMPOSITE_INPROGRESS;
+      *session.status = SERIAL_TRANSMIT_COMPOSITE_INPROGRESS;
       return;
     }
 
-    uint32_t transmitted = serialWrite(toothHistory[logItemsTransmitted]); //This combined runtime (in us) that the log was going for by this record
-    (void)CRC32_serial.crc32_upd((const byte*)&transmitted, sizeof(transmitted), false);
+    uint32_t transmitted = serialWrite(port, toothHistory[logItemsTransmitted]); //This combined runtime (in us) that the log was going for by this record
+    (void)session.crc.crc32_upd((const byte*)&transmitted, sizeof(transmitted), false);
 
     //The status byte (Indicates the trigger edge, whether it was a pri/sec pulse, the sync status)
-    writeByteReliableBlocking(compositeLogHistory[logItemsTransmitted]);
-    CRC32_val = CRC32_serial.crc32_upd((const byte*)&compositeLogHistory[logItemsTransmitted], sizeof(compositeLogHistory[logItemsTransmitted]), false);
+    writeByteReliableBlocking(port, compositeLogHistory[logItemsTransmitted]);
+    CRC32_val = session.crc.crc32_upd((const byte*)&compositeLogHistory[logItemsTransmitted], sizeof(compositeLogHistory[logItemsTransmitted]), false);
   }
   BIT_CLEAR(currentStatus.status1, BIT_STATUS1_TOOTHLOG1READY);
   toothHistoryIndex = 0;
-  serialStatusFlag = SERIAL_INACTIVE;
+  *session.status = SERIAL_INACTIVE;
   logItemsTransmitted = 0;
+  pLogSession = nullptr;
 
   //Apply the CRC reflection
   CRC32_val = ~CRC32_val;
 
   //Send the CRC
-  (void)serialWrite(CRC32_val);
+  (void)serialWrite(port, CRC32_val);
 }
 
 #if defined(CORE_AVR)
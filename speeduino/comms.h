@@ -10,6 +10,9 @@
 #ifndef NEW_COMMS_H
 #define NEW_COMMS_H
 
+#include "comms_legacy.h"
+#include "src/FastCRC/FastCRC.h"
+
 #if defined(CORE_TEENSY)
   #define BLOCKING_FACTOR       251
   #define TABLE_BLOCKING_FACTOR 256
@@ -21,17 +24,74 @@
   #define TABLE_BLOCKING_FACTOR 64
 #endif
 
-extern Stream *pPrimarySerial;
-#define primarySerial (*pPrimarySerial)
+#if defined(CORE_AVR) && defined(secondarySerial_AVAILABLE)
+/** @brief The AVR doesn't have the RAM for a second payload buffer, so the secondary serial session uses the buffer of the primary session.
+ * Only one of the two sessions can be part way through a command at a time. See isPayloadBufferFree()
+ */
+#define COMMS_SHARED_PAYLOAD
+#endif
+
+/** @brief The state of one connection using the new comms protocol
+ *
+ * Each port that TunerStudio (or a logger) can connect on has its own session, so the primary port and the secondary serial
+ * can both be part way through receiving a command or sending a response without affecting each other.
+ * The exception is a session that shares its payload buffer with another (See ::COMMS_SHARED_PAYLOAD).
+ */
+struct comms_session_t {
+  Stream *port;
+  SerialStatus *status; ///< The status flag of the port. ::serialStatusFlag for the primary port
+  byte *payload; ///< Holds the received command, then the response to it
+  uint16_t payloadSize; ///< Size of the payload buffer. Longer commands are rejected
+  const SerialStatus *sharedStatus; ///< The status flag of the other session using the same payload buffer. nullptr if the buffer isn't shared
+  void (*legacyCommand)(void); ///< Handles the single character commands of the legacy protocol on this port
+  uint16_t payloadLength; ///< Length of the payload being received or sent
+  uint16_t bytesRxTx; ///< Bytes of the frame (length, payload and CRC) received or sent so far. A session only ever does one at a time
+  uint32_t payloadCrc; ///< The CRC received with the payload, or the CRC of the response being sent
+  uint32_t receiveStartTime; ///< The time in milliseconds at which the receive started. Used for the timeout
+  FastCRC32 crc; ///< Accumulates the CRC of a log that is sent over several calls
+};
+
+extern comms_session_t primaryCommsSession;
+#define primarySerial (*primaryCommsSession.port)
+
+/** @brief Whether the session can start on a new command.
+ *
+ * A session that shares its payload buffer has to wait until the other session has finished its command and response.
+ * Until then the new command is left in the port's receive buffer.
+ */
+static inline bool isPayloadBufferFree(const comms_session_t &session)
+{
+  return (session.sharedStatus == nullptr) || (*session.sharedStatus == SERIAL_INACTIVE);
+}
 
 /**
- * @brief The serial receive pump. Should be called whenever the serial port
- * has data available to read.
+ * @brief The serial receive pump. Should be called whenever the session's port
+ * has data available to read, or a receive is in progress.
  */
-void serialReceive(void);
+void serialReceive(comms_session_t &session);
 
-/** @brief The serial transmit pump. Should be called when ::serialStatusFlag indicates a transmit
+/** @brief The serial transmit pump. Should be called when the session's status flag indicates a transmit
  * operation is in progress */
-void serialTransmit(void);
+void serialTransmit(comms_session_t &session);
+
+/** @brief serialReceive() for the primary port */
+inline void serialReceive(void) { serialReceive(primaryCommsSession); }
+/** @brief serialTransmit() for the primary port */
+inline void serialTransmit(void) { serialTransmit(primaryCommsSession); }
+
+/** @brief Send as much of a buffer as the port can take without blocking the caller
+ *
+ * The bytes are written in blocks of the free space in the transmit buffer, rather than checking the space before each byte.
+ * @return Number of bytes sent
+ */
+uint16_t writeNonBlocking(Stream &port, const byte *buffer, uint16_t length);
+
+/** @brief The payload buffer of the primary session.
+ *
+ * Legacy responses on the primary port are also built in it, as both protocols are driven by ::serialStatusFlag and so are never
+ * in progress at the same time.
+ * @param bufferSize Set to the size of the buffer
+ */
+byte *getSerialPayloadBuffer(uint16_t &bufferSize);
 
 #endif // COMMS_H
@@ -42,7 +42,6 @@ int CAN_read();
 void CAN_write();
 void sendCANBroadcast(uint8_t);
 void receiveCANwbo();
-void DashMessages(uint16_t DashMessageID);
 void can_Command(void);
 void obd_response(uint8_t therequestedPID , uint8_t therequestedPIDlow, uint8_t therequestedPIDhigh);
 void readAuxCanBus();
@@ -0,0 +1,288 @@
+/*
+Speeduino - Simple engine management for the Arduino Mega 2560 platform
+Copyright (C) Josh Stewart
+A full copy of the license may be found in the projects root directory
+*/
+
+/*
+The frames broadcast to CAN dashes and instrument clusters. These don't depend on any CAN hardware, so that the
+same frames can be sent over the native CAN interface or streamed over the secondary serial port.
+*/
+#include "globals.h"
+#include "comms_dash.h"
+#include "comms_CAN.h"
+#include "maths.h"
+#include "utilities.h"
+
+struct dash_rate_t {
+  uint8_t protocol;
+  uint8_t frequency;
+  uint16_t id;
+};
+
+/** The frames of each broadcast protocol and the rate (Hz) they are sent at. */
+static const dash_rate_t dashRates[] PROGMEM = {
+  { CAN_BROADCAST_PROTOCOL_BMW, 30, CAN_BMW_DME1 },
+  { CAN_BROADCAST_PROTOCOL_BMW, 30, CAN_BMW_DME2 },
+  { CAN_BROADCAST_PROTOCOL_BMW, 10, CAN_BMW_DME4 },
+  //All VAG broadcasts are at 30Hz
+  { CAN_BROADCAST_PROTOCOL_VAG, 30, CAN_VAG_RPM },
+  { CAN_BROADCAST_PROTOCOL_VAG, 30, CAN_VAG_VSS },
+  //Haltech has broadcasts over multiple frequencies
+  { CAN_BROADCAST_PROTOCOL_HALTECH, 50, CAN_HALTECH_DATA1 },
+  { CAN_BROADCAST_PROTOCOL_HALTECH, 50, CAN_HALTECH_DATA2 },
+  { CAN_BROADCAST_PROTOCOL_HALTECH, 50, CAN_HALTECH_DATA3 },
+  { CAN_BROADCAST_PROTOCOL_HALTECH, 50, CAN_HALTECH_PW },
+  //Note: Haltech lists these as being 20Hz messages, but as we don't have a 20Hz flag we'll use 15Hz instead
+  { CAN_BROADCAST_PROTOCOL_HALTECH, 15, CAN_HALTECH_LAMBDA },
+  { CAN_BROADCAST_PROTOCOL_HALTECH, 15, CAN_HALTECH_TRIGGER },
+  { CAN_BROADCAST_PROTOCOL_HALTECH, 15, CAN_HALTECH_VSS },
+  { CAN_BROADCAST_PROTOCOL_HALTECH, 10, CAN_HALTECH_DATA4 },
+  { CAN_BROADCAST_PROTOCOL_HALTECH, 10, CAN_HALTECH_DATA5 },
+};
+
+/**
+ * @brief Gets the IDs of the frames that a broadcast protocol sends at a given rate
+ *
+ * @param protocol One of the CAN_BROADCAST_PROTOCOL_ values
+ * @param frequency The rate in Hz (50, 30, 15 or 10)
+ * @param ids Filled with the frame IDs. Must hold DASH_FRAMES_PER_RATE_MAX IDs
+ * @return uint8_t The number of IDs
+ */
+uint8_t getDashMessageIDs(uint8_t protocol, uint8_t frequency, uint16_t *ids)
+{
+  uint8_t count = 0;
+  for(uint8_t x = 0; (x < _countof(dashRates)) && (count < DASH_FRAMES_PER_RATE_MAX); x++)
+  {
+    if( (pgm_read_byte(&dashRates[x].protocol) == protocol) && (pgm_read_byte(&dashRates[x].frequency) == frequency) )
+    {
+      ids[count] = pgm_read_word(&dashRates[x].id);
+      count++;
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief Fills a frame with the current values. All supported definitions/protocols for CAN Dash broadcasts
+ *
+ * @param DashMessageID The CAN ID of the frame, one of the CAN_BMW_, CAN_VAG_ or CAN_HALTECH_ IDs
+ * @param frame The frame to fill. An unknown ID gives a frame with no data
+ */
+void buildDashMessage(uint16_t DashMessageID, dash_frame_t &frame)
+{
+  uint16_t temp_TPS;
+  uint16_t temp_MAP;
+  uint16_t temp_Baro;
+  uint16_t temp_CLT;
+  uint16_t temp_IAT;
+  uint16_t temp_VSS;
+  uint16_t temp_VVT1;
+  uint16_t temp_VVT2;
+  uint16_t temp_fuelLoad;
+  uint16_t temp_fuelTemp;
+  uint16_t temp_fuelPressure;
+  uint16_t temp_oilPressure;
+  int16_t temp_Advance;
+  uint16_t temp_DutyCycle;
+  uint16_t temp_Lambda;
+  uint16_t temp_BoostTarget;
+
+  memset(&frame, 0, sizeof(frame));
+  frame.id = DashMessageID;
+  switch (DashMessageID)
+  {
+    case CAN_BMW_DME1:
+      uint32_t temp_RPM;
+      temp_RPM = currentStatus.RPM * 64UL;  //RPM conversion is currentStatus.RPM * 6.4, but this does it without floats.
+      temp_RPM = temp_RPM / 10U;
+      frame.len = 8;
+      frame.buf[0] = 0x05;  //bitfield, Bit0 = 1 = terminal 15 on detected, Bit2 = 1 = the ASC message ASC1 was received within the last 500 ms and contains no plausibility errors
+      frame.buf[1] = 0x0C;  //Indexed Engine Torque in % of C_TQ_STND TBD do torque calculation.
+      frame.buf[2] = lowByte(uint16_t(temp_RPM));  //lsb RPM
+      frame.buf[3] = highByte(uint16_t(temp_RPM)); //msb RPM
+      frame.buf[4] = 0x0C;  //Indicated Engine Torque in % of C_TQ_STND TBD do torque calculation!! Use same as for byte 1
+      frame.buf[5] = 0x15;  //Engine Torque Loss (due to engine friction, AC compressor and electrical power consumption)
+      frame.buf[6] = 0x00;  //not used
+      frame.buf[7] = 0x35;  //Theorethical Engine Torque in % of C_TQ_STND after charge intervention
+    break;
+
+    case CAN_BMW_DME2:
+      temp_TPS = map(currentStatus.TPS, 0, 200, 1, 254);//TPS value conversion (from 0x01 to 0xFE)
+      temp_CLT = (((currentStatus.coolant - CALIBRATION_TEMPERATURE_OFFSET) + 48)*4/3); //CLT conversion (actual value to add is 48.373, but close enough)
+      if (temp_CLT > UINT8_MAX) { temp_CLT = UINT8_MAX; } //CLT conversion can yield to higher values than what fits to byte, so limit the maximum value to 255.
+
+      frame.len = 8;
+      frame.buf[0] = 0x11;  //Multiplexed Information
+      frame.buf[1] = temp_CLT;
+      frame.buf[2] = currentStatus.baro;
+      frame.buf[3] = 0x08;  //bitfield, Bit0 = 0 = Clutch released, Bit 3 = 1 = engine running
+      frame.buf[4] = 0x00;  //TPS_VIRT_CRU_CAN (Not used)
+      frame.buf[5] = (uint8_t)temp_TPS;
+      frame.buf[6] = 0x00;  //bitfield, Bit0 = 0 = brake not actuated, Bit1 = 0 = brake switch system OK etc...
+      frame.buf[7] = 0x00;  //not used, but set to zero just in case.
+    break;
+
+    case CAN_BMW_DME4:       //fuel consumption and CEl light for BMW e46/e39/e38 instrument cluster
+                      //fuel consumption calculation not implemented yet. But this still needs to be sent to get rid of the CEL and EML fault lights on the dash.
+      frame.len = 5;
+      frame.buf[0] = 0x00;  //Check engine light (binary 10), Cruise light (binary 1000), EML (binary 10000).
+      frame.buf[1] = 0x00;  //LSB Fuel consumption
+      frame.buf[2] = 0x00;  //MSB Fuel Consumption
+      if (currentStatus.coolant > 159) { frame.buf[3] = 0x08; } //Turn on overheat light if coolant temp hits 120 degrees celsius.
+      else { frame.buf[3] = 0x00; } //Overheat light off at normal engine temps.
+      frame.buf[4] = 0x7E; //this is oil temp
+    break;
+
+    case CAN_VAG_RPM:       //RPM for VW instrument cluster
+      temp_RPM =  currentStatus.RPM * 4; //RPM conversion
+      frame.len = 8;
+      frame.buf[0] = 0x49;
+      frame.buf[1] = 0x0E;
+      frame.buf[2] = lowByte(uint16_t(temp_RPM));  //lsb RPM
+      frame.buf[3] = highByte(uint16_t(temp_RPM)); //msb RPM
+      frame.buf[4] = 0x0E;
+      frame.buf[5] = 0x00;
+      frame.buf[6] = 0x1B;
+      frame.buf[7] = 0x0E;
+    break;
+
+    case CAN_VAG_VSS:       //VSS for VW instrument cluster
+      temp_VSS =  currentStatus.vss * 133U; //VSS conversion
+      frame.len = 8;
+      frame.buf[0] = 0xFF;
+      frame.buf[1] = lowByte(temp_VSS);
+      frame.buf[2] = highByte(temp_VSS);
+      frame.buf[3] = 0x00;
+      frame.buf[4] = 0x00;
+      frame.buf[5] = 0x00;
+      frame.buf[6] = 0x00;
+      frame.buf[7] = 0xAD;
+    break;
+
+    case CAN_HALTECH_DATA1:
+      temp_MAP = currentStatus.MAP * 10U;
+      temp_TPS = currentStatus.TPS * 5U; //TPS value to 0.1. TPS is already in 0.5 increments, so multiply by 5
+      frame.len = 8;
+      frame.buf[0] = highByte(currentStatus.RPM);
+      frame.buf[1] = lowByte(currentStatus.RPM);
+      frame.buf[2] = highByte(temp_MAP);
+      frame.buf[3] = lowByte(temp_MAP);
+      frame.buf[4] = highByte(temp_TPS);
+      frame.buf[5] = lowByte(temp_TPS);
+      //Next 2 bytes are coolant pressure, not supported
+      frame.buf[6] = 0x00;
+      frame.buf[7] = 0x00;
+    break;
+
+    case CAN_HALTECH_DATA2:
+      temp_fuelLoad = currentStatus.fuelLoad * 10U;
+      temp_fuelPressure = div100(currentStatus.fuelPressure * 6894UL) + 1013; //Convert from PSI to KPA and add 101.3kPa (1 atmosphere) offset. 0.1 scale
+      temp_oilPressure = div100(currentStatus.oilPressure * 6894UL) + 1013; //Convert from PSI to KPA and add 101.3kPa (1 atmosphere) offset. 0.1 scale
+      frame.len = 8;
+      frame.buf[0] = highByte(temp_fuelPressure); //Fuel pressure
+      frame.buf[1] = lowByte(temp_fuelPressure);
+      frame.buf[2] = highByte(temp_oilPressure); //Oil Pressure
+      frame.buf[3] = lowByte(temp_oilPressure);
+      frame.buf[4] = highByte(temp_fuelLoad);
+      frame.buf[5] = lowByte(temp_fuelLoad);
+      frame.buf[6] = 0x00; //Wastegate pressure
+      frame.buf[7] = 0x00;
+    break;
+
+    case CAN_HALTECH_DATA3:
+      temp_Advance = currentStatus.advance * 10U; //Note: Signed value
+      //Convert PW into duty cycle
+      temp_DutyCycle = (currentStatus.PW1 * 100UL * currentStatus.nSquirts) / revolutionTime; 
+      if (configPage2.strokes == FOUR_STROKE) { temp_DutyCycle = temp_DutyCycle / 2U; }
+
+      frame.len = 8;
+      frame.buf[0] = highByte(temp_DutyCycle);
+      frame.buf[1] = lowByte(temp_DutyCycle);
+      frame.buf[2] = 0x00; //TODO: Staging Duty Cycle. 
+      frame.buf[3] = 0x00;
+      frame.buf[4] = highByte(temp_Advance);
+      frame.buf[5] = lowByte(temp_Advance);
+      frame.buf[6] = 0x00; //Unused
+      frame.buf[7] = 0x00; //Unused
+    break;
+
+    case CAN_HALTECH_PW:
+      frame.len = 8;
+      frame.buf[0] = highByte(currentStatus.PW1);
+      frame.buf[1] = lowByte(currentStatus.PW1);
+      frame.buf[2] = highByte(currentStatus.PW2);
+      frame.buf[3] = lowByte(currentStatus.PW2);
+      frame.buf[4] = highByte(currentStatus.PW3);
+      frame.buf[5] = lowByte(currentStatus.PW3);
+      frame.buf[6] = highByte(currentStatus.PW4);
+      frame.buf[7] = lowByte(currentStatus.PW4);
+    break;
+
+    case CAN_HALTECH_LAMBDA:
+      temp_Lambda = (currentStatus.O2 * 1000U) / configPage2.stoich;
+      frame.len = 8;
+      frame.buf[0] = highByte(temp_Lambda);
+      frame.buf[1] = lowByte(temp_Lambda);
+      temp_Lambda = (currentStatus.O2_2 * 1000U) / configPage2.stoich;
+      frame.buf[2] = highByte(temp_Lambda);
+      frame.buf[3] = lowByte(temp_Lambda);
+      frame.buf[4] = 0x00; //Lambda 3
+      frame.buf[5] = 0x00; //Lambda 3
+      frame.buf[6] = 0x00; //Lambda 4
+      frame.buf[7] = 0x00; //Lambda 4
+    break;
+
+    case CAN_HALTECH_TRIGGER:
+      //Trigger counter, sync level and sync error count are not supported yet. All bytes are 0
+      frame.len = 8;
+    break;
+
+    case CAN_HALTECH_VSS:
+      temp_VSS = currentStatus.vss * 10U;
+      temp_VVT1 = currentStatus.vvt1Angle * 10U;
+      temp_VVT2 = currentStatus.vvt2Angle * 10U;
+      frame.len = 8;
+      frame.buf[0] = highByte(temp_VSS);
+      frame.buf[1] = lowByte(temp_VSS);
+      frame.buf[2] = 0x00;
+      frame.buf[3] = currentStatus.gear;
+      frame.buf[4] = highByte(temp_VVT1);
+      frame.buf[5] = lowByte(temp_VVT1);
+      frame.buf[6] = highByte(temp_VVT2);
+      frame.buf[7] = lowByte(temp_VVT2);
+    break;
+
+    case CAN_HALTECH_DATA4:
+      temp_BoostTarget = currentStatus.boostTarget * 10U;
+      temp_Baro = currentStatus.baro * 10U;
+      frame.len = 8;
+      frame.buf[0] = 0x00; //High byte for battery voltage, which is not used (Max battery voltage is 25.5 or 255)
+      frame.buf[1] = currentStatus.battery10;
+      frame.buf[2] = 0x00; //Unused
+      frame.buf[3] = 0x00; //Unused
+      frame.buf[4] = highByte(temp_BoostTarget);
+      frame.buf[5] = lowByte(temp_BoostTarget);
+      frame.buf[6] = highByte(temp_Baro);
+      frame.buf[7] = lowByte(temp_Baro);
+    break;
+
+    case CAN_HALTECH_DATA5:
+      temp_CLT = (currentStatus.coolant + 273U) * 10U; //Convert to Kelvin and adjust to 0.1
+      temp_IAT = (currentStatus.IAT + 273U) * 10U; //Convert to Kelvin and adjust to 0.1
+      temp_fuelTemp = (currentStatus.fuelTemp + 273U) * 10U; //Convert to Kelvin and adjust to 0.1
+      frame.len = 8;
+      frame.buf[0] = highByte(temp_CLT);
+      frame.buf[1] = lowByte(temp_CLT);
+      frame.buf[2] = highByte(temp_IAT);
+      frame.buf[3] = lowByte(temp_IAT);
+      frame.buf[4] = highByte(temp_fuelTemp);
+      frame.buf[5] = lowByte(temp_fuelTemp);
+      frame.buf[6] = 0x00; //Oil Temperature
+      frame.buf[7] = 0x00; //Oil Temperature
+    break;
+
+    default:
+    break;
+  }
+}
@@ -0,0 +1,26 @@
+/** \file comms_dash.h
+ * @brief The frames broadcast to CAN dashes and instrument clusters
+ *
+ * The frame contents and the rate each frame is sent at are shared by the native CAN broadcast and the
+ * RealDash CAN frame stream on the secondary serial port, so both send the same data.
+ */
+#ifndef COMMS_DASH_H
+#define COMMS_DASH_H
+
+#include <stdint.h>
+
+#define DASH_FRAME_MAX_LENGTH 8
+/** The most frames any protocol sends at one rate */
+#define DASH_FRAMES_PER_RATE_MAX 4
+
+/** A single dash frame, independent of how it is sent */
+struct dash_frame_t {
+  uint16_t id; ///< The 11 bit CAN ID
+  uint8_t len; ///< Number of bytes in buf that are used
+  uint8_t buf[DASH_FRAME_MAX_LENGTH]; ///< Bytes after len are always 0
+};
+
+void buildDashMessage(uint16_t DashMessageID, dash_frame_t &frame);
+uint8_t getDashMessageIDs(uint8_t protocol, uint8_t frequency, uint16_t *ids);
+
+#endif // COMMS_DASH_H
@@ -32,10 +32,44 @@ static uint16_t chunkComplete = 0; /**< The number of bytes in a chunk write tha
 static uint16_t chunkSize = 0; /**< The complete size of the requested chunk write */
 static int valueOffset; /**< The memory offset within a given page for a value to be read from or written to. Note that we cannot use 'offset' as a variable name, it is a reserved word for several teensy libraries */
 byte logItemsTransmitted;
-byte inProgressLength;
 SerialStatus serialStatusFlag;
 SerialStatus serialSecondaryStatusFlag;
 
+/** @brief A realtime values packet that is being sent without blocking. See sendValues() */
+struct values_tx_t {
+  Stream *port;
+  byte *buffer;
+  uint16_t size; ///< Size of the buffer
+  uint16_t length; ///< Length of the packet in the buffer
+  uint16_t sent; ///< Bytes of the packet sent so far
+};
+static values_tx_t primaryValuesTx = { nullptr, nullptr, 0, 0, 0 }; //The buffer is the shared serial payload buffer
+#if defined(secondarySerial_AVAILABLE)
+static values_tx_t secondaryValuesTx = { nullptr, nullptr, 0, 0, 0 }; //The buffer is the payload buffer of the secondary session
+#endif
+
+//Each status flag is continued separately, so each has its own packet
+static values_tx_t &getValuesTx(const SerialStatus &targetStatusFlag)
+{
+#if defined(secondarySerial_AVAILABLE)
+  if(&targetStatusFlag == &serialSecondaryStatusFlag)
+  {
+    //The legacy protocols and the TunerStudio session on the secondary serial are chosen by secondarySerialProtocol and share its status flag,
+    //so they are never in progress at the same time and can share the payload buffer
+    if(secondaryValuesTx.buffer == nullptr)
+    {
+      secondaryValuesTx.buffer = secondaryCommsSession.payload;
+      secondaryValuesTx.size = secondaryCommsSession.payloadSize;
+    }
+    return secondaryValuesTx;
+  }
+#else
+  (void)targetStatusFlag;
+#endif
+  if(primaryValuesTx.buffer == nullptr) { primaryValuesTx.buffer = getSerialPayloadBuffer(primaryValuesTx.size); }
+  return primaryValuesTx;
+}
+
 static bool isMap(void) {
     // Detecting if the current page is a table/map
   return (currentPage == veMapPage) || (currentPage == ignMapPage) || (currentPage == afrMapPage) || (currentPage == fuelMap2Page) || (currentPage == ignMap2Page);
@@ -426,21 +460,21 @@ void legacySerialCommand(void)
       for (int x = 0; x < 32; x++)
       {
         primarySerial.print(cltCalibration_bins[x]);
-        primarySerial.print(", ");
+        primarySerial.print(F(", "));
         primarySerial.println(cltCalibration_values[x]);
       }
       primarySerial.println(F("Inlet temp"));
       for (int x = 0; x < 32; x++)
       {
         primarySerial.print(iatCalibration_bins[x]);
-        primarySerial.print(", ");
+        primarySerial.print(F(", "));
         primarySerial.println(iatCalibration_values[x]);
       }
       primarySerial.println(F("O2"));
       for (int x = 0; x < 32; x++)
       {
         primarySerial.print(o2Calibration_bins[x]);
-        primarySerial.print(", ");
+        primarySerial.print(F(", "));
         primarySerial.println(o2Calibration_values[x]);
       }
       primarySerial.println(F("WUE"));
@@ -669,6 +703,9 @@ void legacySerialHandler(byte cmd, Stream &targetPort, SerialStatus &targetStatu
 
 /** Send a status record back to tuning/logging SW.
  * This will "live" information from @ref currentStatus struct.
+ * The whole packet is built in a buffer first, so it is a single snapshot of the values however many calls it takes to send.
+ * As much of it as the port can take is sent straight away and the rest by sendValuesContinue(), which must be called while
+ * targetStatusFlag is SERIAL_TRANSMIT_INPROGRESS_LEGACY.
  * @param offset - Start field number
  * @param packetLength - Length of actual message (after possible ack/confirm headers)
  * @param cmd - ??? - Will be used as some kind of ack on secondarySerial
@@ -678,9 +715,12 @@ void legacySerialHandler(byte cmd, Stream &targetPort, SerialStatus &targetStatu
  * E.g. tuning sw command 'A' (Send all values) will send data from field number 0, LOG_ENTRY_SIZE fields.
  * @return the current values of a fixed group of variables
  */
-void sendValues(uint16_t offset, uint16_t packetLength, byte cmd, Stream &targetPort, SerialStatus &targetStatusFlag) { sendValues(offset, packetLength, cmd, targetPort, targetStatusFlag, &getTSLogEntry); } //Defaults to using the standard TS log function
+void sendValues(uint16_t offset, uint16_t packetLength, byte cmd, Stream &targetPort, SerialStatus &targetStatusFlag) { sendValues(offset, packetLength, cmd, targetPort, targetStatusFlag, &getLiveSnapshotEntry); } //Defaults to the standard TS log, from this loop's snapshot
 void sendValues(uint16_t offset, uint16_t packetLength, byte cmd, Stream &targetPort, SerialStatus &targetStatusFlag, uint8_t (*logFunction)(uint16_t))
 {  
+  values_tx_t &tx = getValuesTx(targetStatusFlag);
+  uint16_t length = 0;
+
   #if defined(secondarySerial_AVAILABLE)
   if (&targetPort == &secondarySerial)
   {
@@ -689,18 +729,18 @@ void sendValues(uint16_t offset, uint16_t packetLength, byte cmd, Stream &target
     {
         if (cmd == 0x30) 
         {
-          secondarySerial.write("r");         //confirm cmd type
-          secondarySerial.write(cmd);
+          tx.buffer[length++] = 'r';         //confirm cmd type
+          tx.buffer[length++] = cmd;
         }
         else if (cmd == 0x31)
         {
-          secondarySerial.write("A");         // confirm command type   
+          tx.buffer[length++] = 'A';         // confirm command type   
         }
         else if (cmd == 0x32)
         {
-          secondarySerial.write("n");                       // confirm command type
-          secondarySerial.write(cmd);                       // send command type  , 0x32 (dec50) is ascii '0'
-          secondarySerial.write(NEW_CAN_PACKET_SIZE);       // send the packet size the receiving device should expect.
+          tx.buffer[length++] = 'n';                       // confirm command type
+          tx.buffer[length++] = cmd;                       // send command type  , 0x32 (dec50) is ascii '0'
+          tx.buffer[length++] = NEW_CAN_PACKET_SIZE;       // send the packet size the receiving device should expect.
         }
     }  
   }
@@ -714,39 +754,36 @@ void sendValues(uint16_t offset, uint16_t packetLength, byte cmd, Stream &target
     }
   }
 
-  //
-  targetStatusFlag = SERIAL_TRANSMIT_INPROGRESS_LEGACY;
   currentStatus.status2 ^= (-currentStatus.hasSync ^ currentStatus.status2) & (1U << BIT_STATUS2_SYNC); //Set the sync bit of the Spark variable to match the hasSync variable
 
-  for(byte x=0; x<packetLength; x++)
+  if(packetLength > (tx.size - length)) { packetLength = tx.size - length; } //Requests larger than the buffer are cut short
+  for(uint16_t x=0; x<packetLength; x++)
   {
-    bool bufferFull = false;
+    tx.buffer[length++] = logFunction(offset+x);
+  }
 
-    //targetPort.write(getTSLogEntry(offset+x));
-    targetPort.write(logFunction(offset+x));
+  tx.port = &targetPort;
+  tx.length = length;
+  tx.sent = 0;
+  targetStatusFlag = SERIAL_TRANSMIT_INPROGRESS_LEGACY;
+  sendValuesContinue(targetStatusFlag);
+}
 
-    if( (&targetPort == &Serial) ) 
-    { 
-      //If the transmit buffer is full, wait for it to clear. This cannot be used with Read Dash as it will cause a timeout
-      if(targetPort.availableForWrite() < 1) { bufferFull = true; }
-    }
+/** @brief Sends as much as the port can take of the rest of the packet started by sendValues(), without blocking
+ * @param targetStatusFlag - The status flag that was passed to sendValues(). This is set to SERIAL_INACTIVE once the packet is complete
+ */
+void sendValuesContinue(SerialStatus &targetStatusFlag)
+{
+  values_tx_t &tx = getValuesTx(targetStatusFlag);
+  tx.sent += writeNonBlocking(*tx.port, tx.buffer + tx.sent, tx.length - tx.sent);
 
-    //Check whether the tx buffer still has space
-    if(bufferFull == true) 
-    { 
-      //tx buffer is full. Store the current state so it can be resumed later
-      logItemsTransmitted = offset + x + 1;
-      inProgressLength = packetLength - x - 1;
-      return;
-    }
-    
+  if(tx.sent >= tx.length)
+  {
+    targetStatusFlag = SERIAL_INACTIVE;
+    while(tx.port->available()) { tx.port->read(); }
+    // Reset any flags that are being used to trigger page refreshes. Only TunerStudio on the primary port uses them
+    if(&targetStatusFlag == &serialStatusFlag) { BIT_CLEAR(currentStatus.status3, BIT_STATUS3_VSS_REFRESH); }
   }
-
-  targetStatusFlag = SERIAL_INACTIVE;
-  while(targetPort.available()) { targetPort.read(); }
-  // Reset any flags that are being used to trigger page refreshes
-  BIT_CLEAR(currentStatus.status3, BIT_STATUS3_VSS_REFRESH);
-
 }
 
 void sendValuesLegacy(void)
@@ -49,14 +49,15 @@ extern SerialStatus serialSecondaryStatusFlag;
  * Expectation is that ::serialTransmit is called until this
  * returns false
  */
-inline bool serialTransmitInProgress(void) {
-    return serialStatusFlag==SERIAL_TRANSMIT_INPROGRESS
-    || serialStatusFlag==SERIAL_TRANSMIT_INPROGRESS_LEGACY
-    || serialStatusFlag==SERIAL_TRANSMIT_TOOTH_INPROGRESS
-    || serialStatusFlag==SERIAL_TRANSMIT_TOOTH_INPROGRESS_LEGACY
-    || serialStatusFlag==SERIAL_TRANSMIT_COMPOSITE_INPROGRESS
-    || serialStatusFlag==SERIAL_TRANSMIT_COMPOSITE_INPROGRESS_LEGACY;
+inline bool serialTransmitInProgress(SerialStatus status) {
+    return status==SERIAL_TRANSMIT_INPROGRESS
+    || status==SERIAL_TRANSMIT_INPROGRESS_LEGACY
+    || status==SERIAL_TRANSMIT_TOOTH_INPROGRESS
+    || status==SERIAL_TRANSMIT_TOOTH_INPROGRESS_LEGACY
+    || status==SERIAL_TRANSMIT_COMPOSITE_INPROGRESS
+    || status==SERIAL_TRANSMIT_COMPOSITE_INPROGRESS_LEGACY;
 }
+inline bool serialTransmitInProgress(void) { return serialTransmitInProgress(serialStatusFlag); }
 
 /**
  * @brief Is a non-blocking serial receive operation in progress?
@@ -64,19 +65,20 @@ inline bool serialTransmitInProgress(void) {
  * Expectation is the ::serialReceive is called until this
  * returns false.
  */
-inline bool serialRecieveInProgress(void) {
-  return serialStatusFlag==SERIAL_RECEIVE_INPROGRESS
-  || serialStatusFlag==SERIAL_COMMAND_INPROGRESS_LEGACY;
+inline bool serialRecieveInProgress(SerialStatus status) {
+  return status==SERIAL_RECEIVE_INPROGRESS
+  || status==SERIAL_COMMAND_INPROGRESS_LEGACY;
 }
+inline bool serialRecieveInProgress(void) { return serialRecieveInProgress(serialStatusFlag); }
 
 extern bool firstCommsRequest; /**< The number of times the A command has been issued. This is used to track whether a reset has recently been performed on the controller */
 extern byte logItemsTransmitted;
-extern byte inProgressLength;
 
 void legacySerialCommand(void);//This is the heart of the Command Line Interpreter.  All that needed to be done was to make it human readable.
 void legacySerialHandler(byte cmd, Stream &targetPort, SerialStatus &targetStatusFlag);
 void sendValues(uint16_t offset, uint16_t packetLength, byte cmd, Stream &targetPort, SerialStatus &targetStatusFlag);
 void sendValues(uint16_t offset, uint16_t packetLength, byte cmd, Stream &targetPort, SerialStatus &targetStatusFlag, uint8_t (*logFunction)(uint16_t));
+void sendValuesContinue(SerialStatus &targetStatusFlag);
 void sendValuesLegacy(void);
 void sendPage(void);
 void sendPageASCII(void);
@@ -29,6 +29,17 @@ sendcancommand is called when a command is to be sent either to serial3
 uint8_t currentSecondaryCommand;
 SECONDARY_SERIAL_T* pSecondarySerial;
 
+#if defined(secondarySerial_AVAILABLE)
+static void secondserial_legacyCommand(void);
+#if defined(COMMS_SHARED_PAYLOAD)
+//The payload buffer is the one of the primary session. It is set when the port is, in initialiseAll()
+comms_session_t secondaryCommsSession = { nullptr, &serialSecondaryStatusFlag, nullptr, 0, &serialStatusFlag, &secondserial_legacyCommand, 0, 0, 0, 0, FastCRC32() };
+#else
+static byte secondaryPayload[SERIAL_BUFFER_SIZE]; //!< Payload buffer of the TunerStudio session on the secondary serial
+comms_session_t secondaryCommsSession = { nullptr, &serialSecondaryStatusFlag, secondaryPayload, sizeof(secondaryPayload), nullptr, &secondserial_legacyCommand, 0, 0, 0, 0, FastCRC32() };
+#endif
+#endif
+
 #if defined(CORE_AVR)
 #pragma GCC push_options
 // This minimizes RAM usage at no performance cost
@@ -39,17 +50,20 @@ void secondserial_Command(void)
 {
   #if defined(secondarySerial_AVAILABLE)
 
-  //If the selected protocol is Tuner Studio then everything is routed via the primary serial functions but with the output diverted to the secondary serial interface
+  //If the selected protocol is Tuner Studio then the commands are handled by the same functions as the primary serial, but in a separate session
   if(configPage9.secondarySerialProtocol == SECONDARY_SERIAL_PROTO_TUNERSTUDIO)
   {
-    pPrimarySerial = pSecondarySerial; //Divert the output of all primary serial functions to the secondary serial interface
-    serialReceive();
-    while(secondarySerial.available()) { secondarySerial.read(); }
+    serialReceive(secondaryCommsSession);
     return;
   }
 
 
-  if ( serialSecondaryStatusFlag == SERIAL_INACTIVE )  { currentSecondaryCommand = secondarySerial.read(); }
+  if ( serialSecondaryStatusFlag == SERIAL_INACTIVE )
+  {
+    //The values packets are built in the session payload buffer, which may be in use by the primary port
+    if(!isPayloadBufferFree(secondaryCommsSession)) { return; }
+    currentSecondaryCommand = secondarySerial.read();
+  }
 
   switch (currentSecondaryCommand)
   {
@@ -183,6 +197,31 @@ void secondserial_Command(void)
   }
   #endif
 } 
+
+#if defined(secondarySerial_AVAILABLE)
+/**
+ * @brief Handles the legacy commands that TunerStudio uses to find the ECU and its protocol on the secondary serial, when in TunerStudio mode
+ */
+static void secondserial_legacyCommand(void)
+{
+  if ( serialSecondaryStatusFlag == SERIAL_INACTIVE )  { currentSecondaryCommand = secondarySerial.read(); }
+
+  switch (currentSecondaryCommand)
+  {
+    case 'A': // send x bytes of realtime values
+      sendValues(0, LOG_ENTRY_SIZE, 0x31, secondarySerial, serialSecondaryStatusFlag);
+      break;
+
+    case 'F': // send serial protocol version
+      secondarySerial.print(F("002"));
+      break;
+
+    default:
+      legacySerialHandler(currentSecondaryCommand, secondarySerial, serialSecondaryStatusFlag);
+      break;
+  }
+}
+#endif
     
 // this routine sends a request(either "0" for a "G" , "1" for a "L" , "2" for a "R" to the Can interface or "3" sends the request via the actual local canbus
 void sendCancommand(uint8_t cmdtype, uint16_t canaddress, uint8_t candata1, uint8_t candata2, uint16_t sourcecanAddress)
@@ -191,19 +230,19 @@ void sendCancommand(uint8_t cmdtype, uint16_t canaddress, uint8_t candata1, uint
     switch (cmdtype)
     {
       case 0:
-        secondarySerial.print("G");
+        secondarySerial.write('G');
         secondarySerial.write(canaddress);  //tscanid of speeduino device
         secondarySerial.write(candata1);    // table id
         secondarySerial.write(candata2);    //table memory offset
         break;
 
       case 1:                      //send request to listen for a can message
-        secondarySerial.print("L");
+        secondarySerial.write('L');
         secondarySerial.write(canaddress);  //11 bit canaddress of device to listen for
         break;
 
      case 2:                                          // requests via serial3
-        secondarySerial.print("R");                         //send "R" to request data from the sourcecanAddress whose value is sent next
+        secondarySerial.write('R');                         //send "R" to request data from the sourcecanAddress whose value is sent next
         secondarySerial.write(candata1);                    //the currentStatus.current_caninchannel
         secondarySerial.write(lowByte(sourcecanAddress) );       //send lsb first
         secondarySerial.write(highByte(sourcecanAddress) );
@@ -240,6 +279,85 @@ void sendCancommand(uint8_t cmdtype, uint16_t canaddress, uint8_t candata1, uint
 #endif
 }
 
+/*
+RealDash CAN mode streams the frames of the selected CAN broadcast protocol without waiting for requests.
+See: https://realdash.net/manuals/realdash_can_protocol.php
+The frames due at each rate are queued by their ID, then built from the current values and sent as space becomes
+free in the transmit buffer. This means a slow link never stalls the main loop, and every frame has the latest values.
+*/
+static uint16_t dashQueue[REALDASH_QUEUE_SIZE];
+static uint8_t dashQueueStart = 0;
+static uint8_t dashQueueLength = 0;
+
+/**
+ * @brief Encodes a frame in the RealDash 0x44 format: 0x44 0x33 0x22 0x11, the frame ID as 4 bytes (little endian), then 8 data bytes
+ *
+ * @param frame The frame to encode. Data bytes past its length are sent as 0
+ * @param buffer Must hold REALDASH_FRAME_SIZE bytes
+ */
+void encodeRealDashFrame(const dash_frame_t &frame, byte *buffer)
+{
+  buffer[0] = 0x44;
+  buffer[1] = 0x33;
+  buffer[2] = 0x22;
+  buffer[3] = 0x11;
+  buffer[4] = lowByte(frame.id);
+  buffer[5] = highByte(frame.id);
+  buffer[6] = 0x00;
+  buffer[7] = 0x00;
+  for(uint8_t x = 0; x < DASH_FRAME_MAX_LENGTH; x++)
+  {
+    buffer[8U + x] = (x < frame.len) ? frame.buf[x] : 0U;
+  }
+}
+
+/**
+ * @brief Queues the frames that are due at the given rate when the RealDash CAN protocol is selected. Called from the 50, 30, 15 and 10Hz timers
+ */
+void secondserial_queueDashFrames(uint8_t frequency)
+{
+  if( (configPage9.enable_secondarySerial == 0U) || (configPage9.secondarySerialProtocol != SECONDARY_SERIAL_PROTO_REALDASH_CAN) ) { return; }
+
+  uint16_t ids[DASH_FRAMES_PER_RATE_MAX];
+  uint8_t count = getDashMessageIDs(configPage4.CANBroadcastProtocol, frequency, ids);
+  for(uint8_t x = 0; x < count; x++)
+  {
+    //A frame that is still waiting will be sent with the latest values anyway, so it is only queued once
+    bool queued = false;
+    for(uint8_t y = 0; y < dashQueueLength; y++)
+    {
+      if(dashQueue[(dashQueueStart + y) % REALDASH_QUEUE_SIZE] == ids[x]) { queued = true; }
+    }
+    if( (queued == false) && (dashQueueLength < REALDASH_QUEUE_SIZE) )
+    {
+      dashQueue[(dashQueueStart + dashQueueLength) % REALDASH_QUEUE_SIZE] = ids[x];
+      dashQueueLength++;
+    }
+  }
+}
+
+/**
+ * @brief Sends as many of the queued frames as will fit in the transmit buffer without blocking. Called every loop in RealDash CAN mode
+ *
+ * @param port The serial port to send the frames on
+ */
+void secondserial_sendDashFrames(Stream &port)
+{
+  //Nothing is requested in this mode, so anything received is discarded
+  while(port.available() > 0) { port.read(); }
+
+  byte buffer[REALDASH_FRAME_SIZE];
+  dash_frame_t frame;
+  while( (dashQueueLength > 0U) && (port.availableForWrite() >= REALDASH_FRAME_SIZE) )
+  {
+    buildDashMessage(dashQueue[dashQueueStart], frame);
+    encodeRealDashFrame(frame, buffer);
+    port.write(buffer, REALDASH_FRAME_SIZE);
+    dashQueueStart = (dashQueueStart + 1U) % REALDASH_QUEUE_SIZE;
+    dashQueueLength--;
+  }
+}
+
 #if defined(CORE_AVR)
 #pragma GCC pop_options
 #endif
\ No newline at end of file
@@ -1,6 +1,9 @@
 #ifndef COMMS_SECONDARY_H
 #define COMMS_SECONDARY_H
 
+#include "comms.h"
+#include "comms_dash.h"
+
 #define NEW_CAN_PACKET_SIZE   123
 #define CAN_PACKET_SIZE   75
 
@@ -10,11 +13,19 @@
 #define SECONDARY_SERIAL_PROTO_MSDROID        3
 #define SECONDARY_SERIAL_PROTO_REALDASH       4
 #define SECONDARY_SERIAL_PROTO_TUNERSTUDIO    5
+#define SECONDARY_SERIAL_PROTO_REALDASH_CAN   6 //Streams the frames of the CAN broadcast protocol as RealDash CAN frames
+
+#define REALDASH_FRAME_SIZE   16
+#define REALDASH_QUEUE_SIZE   16
 
 extern SECONDARY_SERIAL_T *pSecondarySerial;
 #define secondarySerial (*pSecondarySerial)
+extern comms_session_t secondaryCommsSession; //!< The session used when the secondary serial is in TunerStudio mode
 
 void secondserial_Command(void);//This is the heart of the Command Line Interpreter.  All that needed to be done was to make it human readable.
 void sendCancommand(uint8_t cmdtype , uint16_t canadddress, uint8_t candata1, uint8_t candata2, uint16_t sourcecanAddress);
+void encodeRealDashFrame(const dash_frame_t &frame, byte *buffer);
+void secondserial_queueDashFrames(uint8_t frequency);
+void secondserial_sendDashFrames(Stream &port);
 
 #endif // COMMS_SECONDARY_H
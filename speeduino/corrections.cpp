@@ -29,6 +29,7 @@ There are 2 top level functions that call more detailed corrections for Fuel and
 #include "timers.h"
 #include "maths.h"
 #include "sensors.h"
+#include "engineProtection.h"
 #include "src/PID_v1/PID_v1.h"
 
 long PID_O2, PID_output, PID_AFRTarget;
@@ -614,6 +615,14 @@ uint8_t calculateAfrTarget(table3d16RpmLoad &afrLookUpTable, const statuses &cur
   return current.afrTarget;
 }
 
+/** Whether the engine is within the coolant, RPM, TPS, MAP, O2 reading and time since start limits that the closed loop AFR correction runs in.
+ * Also used by the VE learning (See veLearn.h), so that it only learns from the same conditions
+ */
+bool egoConditionsMet(void)
+{
+  return (currentStatus.coolant > (int)(configPage6.egoTemp - CALIBRATION_TEMPERATURE_OFFSET)) && (currentStatus.RPM > (unsigned int)(configPage6.egoRPM * 100)) && (currentStatus.TPS <= configPage6.egoTPSMax) && (currentStatus.O2 < configPage6.ego_max) && (currentStatus.O2 > configPage6.ego_min) && (currentStatus.runSecs > configPage6.ego_sdelay) &&  (BIT_CHECK(currentStatus.status1, BIT_STATUS1_DFCO) == 0) && ( currentStatus.MAP <= (configPage9.egoMAPMax * 2) ) && ( currentStatus.MAP >= (configPage9.egoMAPMin * 2) );
+}
+
 /** Lookup the AFR target table and perform either a simple or PID adjustment based on this.
 
 Simple (Best suited to narrowband sensors):
@@ -640,7 +649,7 @@ byte correctionAFRClosedLoop(void)
       AFRnextCycle = ignitionCount + configPage6.egoCount; //Set the target ignition event for the next calculation
         
       //Check all other requirements for closed loop adjustments
-      if( (currentStatus.coolant > (int)(configPage6.egoTemp - CALIBRATION_TEMPERATURE_OFFSET)) && (currentStatus.RPM > (unsigned int)(configPage6.egoRPM * 100)) && (currentStatus.TPS <= configPage6.egoTPSMax) && (currentStatus.O2 < configPage6.ego_max) && (currentStatus.O2 > configPage6.ego_min) && (currentStatus.runSecs > configPage6.ego_sdelay) &&  (BIT_CHECK(currentStatus.status1, BIT_STATUS1_DFCO) == 0) && ( currentStatus.MAP <= (configPage9.egoMAPMax * 2) ) && ( currentStatus.MAP >= (configPage9.egoMAPMin * 2) ) )
+      if( egoConditionsMet() )
       {
 
         //Check which algorithm is used, simple or PID
@@ -829,6 +838,26 @@ When some other mechanism is also present, wait until the engine is no more than
 
   return ignIdleValue;
 }
+/** Percentage (0-100) of a soft limiter's retard to apply.
+ * Without the predictive limiter this is all or nothing. With it, the retard is proportional to how far the RPM predicted 1 cycle ahead passes the limit
+ * @param overLimit Whether the current RPM is over the limit (Used when the predictive limiter is off)
+ * @param rpmLimit The RPM limit
+ */
+static inline uint8_t softLimitPercent(bool overLimit, uint16_t rpmLimit)
+{
+  uint8_t limitPercent = 0;
+  if(configPage15.revLimitPredict == true) { limitPercent = predictiveLimitPercent(currentStatus.RPM, currentStatus.predictedRPM, rpmLimit); }
+  else if(overLimit == true) { limitPercent = 100; }
+  return limitPercent;
+}
+
+/** Moves the advance towards the limited advance by the given percentage */
+static inline int8_t scaleLimitAdvance(int8_t advance, int8_t limitedAdvance, uint8_t limitPercent)
+{
+  if(limitPercent >= 100U) { return limitedAdvance; }
+  return (int8_t)(advance - (((int16_t)advance - (int16_t)limitedAdvance) * (int16_t)limitPercent) / 100);
+}
+
 /** Ignition soft revlimit correction.
  */
 int8_t correctionSoftRevLimit(int8_t advance)
@@ -838,13 +867,14 @@ int8_t correctionSoftRevLimit(int8_t advance)
 
   if (configPage6.engineProtectType == PROTECT_CUT_IGN || configPage6.engineProtectType == PROTECT_CUT_BOTH) 
   {
-    if (currentStatus.RPMdiv100 >= configPage4.SoftRevLim) //Softcut RPM limit
+    uint8_t limitPercent = softLimitPercent((currentStatus.RPMdiv100 >= configPage4.SoftRevLim), ((uint16_t)configPage4.SoftRevLim * 100U));
+    if (limitPercent > 0U) //Softcut RPM limit
     {
       BIT_SET(currentStatus.status2, BIT_STATUS2_SFTLIM);
       if( softLimitTime < configPage4.SoftLimMax )
       {
-        if (configPage2.SoftLimitMode == SOFT_LIMIT_RELATIVE) { ignSoftRevValue = ignSoftRevValue - configPage4.SoftLimRetard; } //delay timing by configured number of degrees in relative mode
-        else if (configPage2.SoftLimitMode == SOFT_LIMIT_FIXED) { ignSoftRevValue = configPage4.SoftLimRetard; } //delay timing to configured number of degrees in fixed mode
+        if (configPage2.SoftLimitMode == SOFT_LIMIT_RELATIVE) { ignSoftRevValue = scaleLimitAdvance(advance, (int8_t)(advance - configPage4.SoftLimRetard), limitPercent); } //delay timing by configured number of degrees in relative mode
+        else if (configPage2.SoftLimitMode == SOFT_LIMIT_FIXED) { ignSoftRevValue = scaleLimitAdvance(advance, configPage4.SoftLimRetard, limitPercent); } //delay timing to configured number of degrees in fixed mode
 
         if( BIT_CHECK(LOOP_TIMER, BIT_TIMER_10HZ) ) { softLimitTime++; }
       }
@@ -880,17 +910,18 @@ int8_t correctionNitrous(int8_t advance)
 int8_t correctionSoftLaunch(int8_t advance)
 {
   byte ignSoftLaunchValue = advance;
+  uint8_t limitPercent = softLimitPercent( (currentStatus.RPM > ((unsigned int)(configPage6.lnchSoftLim) * 100)), ((uint16_t)configPage6.lnchSoftLim * 100U) );
   //SoftCut rev limit for 2-step launch control.
   if(  configPage6.launchEnabled && currentStatus.clutchTrigger && \
       (currentStatus.clutchEngagedRPM < ((unsigned int)(configPage6.flatSArm) * 100)) && \
-      (currentStatus.RPM > ((unsigned int)(configPage6.lnchSoftLim) * 100)) && \
+      (limitPercent > 0U) && \
       (currentStatus.TPS >= configPage10.lnchCtrlTPS) && \
       ( (configPage2.vssMode == 0) || ((configPage2.vssMode > 0) && (currentStatus.vss <= configPage10.lnchCtrlVss)) ) \
     )
   {
     currentStatus.launchingSoft = true;
     BIT_SET(currentStatus.status2, BIT_STATUS2_SLAUNCH);
-    ignSoftLaunchValue = configPage6.lnchRetard;
+    ignSoftLaunchValue = scaleLimitAdvance(advance, configPage6.lnchRetard, limitPercent);
   }
   else
   {
@@ -906,10 +937,15 @@ int8_t correctionSoftFlatShift(int8_t advance)
 {
   int8_t ignSoftFlatValue = advance;
 
-  if(configPage6.flatSEnable && currentStatus.clutchTrigger && (currentStatus.clutchEngagedRPM > ((unsigned int)(configPage6.flatSArm) * 100)) && (currentStatus.RPM > (currentStatus.clutchEngagedRPM - (configPage6.flatSSoftWin * 100) ) ) )
+  if(configPage6.flatSEnable && currentStatus.clutchTrigger && (currentStatus.clutchEngagedRPM > ((unsigned int)(configPage6.flatSArm) * 100)) )
   {
-    BIT_SET(currentStatus.status5, BIT_STATUS5_FLATSS);
-    ignSoftFlatValue = configPage6.flatSRetard;
+    uint8_t limitPercent = softLimitPercent( (currentStatus.RPM > (currentStatus.clutchEngagedRPM - (configPage6.flatSSoftWin * 100) ) ), (uint16_t)(currentStatus.clutchEngagedRPM - (configPage6.flatSSoftWin * 100)) );
+    if(limitPercent > 0U)
+    {
+      BIT_SET(currentStatus.status5, BIT_STATUS5_FLATSS);
+      ignSoftFlatValue = scaleLimitAdvance(advance, configPage6.flatSRetard, limitPercent);
+    }
+    else { BIT_CLEAR(currentStatus.status5, BIT_STATUS5_FLATSS); }
   }
   else { BIT_CLEAR(currentStatus.status5, BIT_STATUS5_FLATSS); }
 
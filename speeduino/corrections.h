@@ -16,6 +16,7 @@ byte correctionASE(void); //After Start Enrichment
 uint16_t correctionAccel(void); //Acceleration Enrichment
 byte correctionFloodClear(void); //Check for flood clear on cranking
 byte correctionAFRClosedLoop(void); //Closed loop AFR adjustment
+bool egoConditionsMet(void); //Whether the closed loop AFR adjustment can run
 byte correctionFlex(void); //Flex fuel adjustment
 byte correctionFuelTemp(void); //Fuel temp correction
 byte correctionBatVoltage(void); //Battery voltage correction
@@ -1,6 +1,7 @@
 #include "globals.h"
 #include "crankMaths.h"
 #include "bit_shifts.h"
+#include <SimplyAtomic.h>
 
 #define SECOND_DERIV_ENABLED                0          
 
@@ -28,8 +29,13 @@ static UQ1X15_t degreesPerMicro;
 static constexpr uint8_t degreesPerMicro_Shift = UQ1X15_Shift;
 
 void setAngleConverterRevolutionTime(uint32_t revolutionTime) {
-  microsPerDegree = div360(lshift<microsPerDegree_Shift>(revolutionTime));
-  degreesPerMicro = (uint16_t)UDIV_ROUND_CLOSEST(lshift<degreesPerMicro_Shift>(UINT32_C(360)), revolutionTime, uint32_t);
+  //The divisions are done first so that the converters (Which are used by the interrupts) are only locked for the assignment
+  UQ24X8_t newMicrosPerDegree = div360(lshift<microsPerDegree_Shift>(revolutionTime));
+  UQ1X15_t newDegreesPerMicro = (uint16_t)UDIV_ROUND_CLOSEST(lshift<degreesPerMicro_Shift>(UINT32_C(360)), revolutionTime, uint32_t);
+  ATOMIC() {
+    microsPerDegree = newMicrosPerDegree;
+    degreesPerMicro = newDegreesPerMicro;
+  }
 }
 
 uint32_t angleToTimeMicroSecPerDegree(uint16_t angle) {
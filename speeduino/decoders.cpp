@@ -44,6 +44,8 @@ A full copy of the license may be found in the projects root directory
 #include "timers.h"
 #include "schedule_calcs.h"
 #include "unit_testing.h"
+#include "rpmEstimator.h"
+#include "angleArming.h"
 
 void nullTriggerHandler (void){return;} //initialisation function for triggerhandlers, does exactly nothing
 uint16_t nullGetRPM(void){return 0;} //initialisation function for getRpm, returns safe value of 0
@@ -52,12 +54,14 @@ int nullGetCrankAngle(void){return 0;} //initialisation function for getCrankAng
 void (*triggerHandler)(void) = nullTriggerHandler; ///Pointer for the trigger function (Gets pointed to the relevant decoder)
 void (*triggerSecondaryHandler)(void) = nullTriggerHandler; ///Pointer for the secondary trigger function (Gets pointed to the relevant decoder)
 void (*triggerTertiaryHandler)(void) = nullTriggerHandler; ///Pointer for the tertiary trigger function (Gets pointed to the relevant decoder)
+void (*primaryTriggerISR)(void) = nullTriggerHandler; ///The interrupt attached to the primary trigger when the loggers are not running. Either decoderPrimaryISR or rpmEstimatorPrimaryISR
 uint16_t (*getRPM)(void) = nullGetRPM; ///Pointer to the getRPM function (Gets pointed to the relevant decoder)
 int (*getCrankAngle)(void) = nullGetCrankAngle; ///Pointer to the getCrank Angle function (Gets pointed to the relevant decoder)
 void (*triggerSetEndTeeth)(void) = triggerSetEndTeeth_missingTooth; ///Pointer to the triggerSetEndTeeth function of each decoder
 
 static void triggerRoverMEMSCommon(void);
 static inline void triggerRecordVVT1Angle (void);
+static inline void syncOnCamEdge(void);
 
 volatile unsigned long curTime;
 volatile unsigned long curGap;
@@ -73,7 +77,7 @@ volatile uint16_t toothCurrentCount = 0; //The current number of teeth (Once syn
 static volatile byte toothSystemCount = 0; //Used for decoders such as Audi 135 where not every tooth is used for calculating crank angle. This variable stores the actual number of teeth, not the number being used to calculate crank angle
 volatile unsigned long toothSystemLastToothTime = 0; //As below, but used for decoders where not every tooth count is used for calculation
 TESTABLE_STATIC volatile unsigned long toothLastToothTime = 0; //The time (micros()) that the last tooth was registered
-static volatile unsigned long toothLastSecToothTime = 0; //The time (micros()) that the last tooth was registered on the secondary input
+TESTABLE_STATIC volatile unsigned long toothLastSecToothTime = 0; //The time (micros()) that the last tooth was registered on the secondary input
 volatile unsigned long toothLastThirdToothTime = 0; //The time (micros()) that the last tooth was registered on the second cam input
 volatile unsigned long toothLastMinusOneToothTime = 0; //The time (micros()) that the tooth before the last tooth was registered
 volatile unsigned long toothLastMinusOneSecToothTime = 0; //The time (micros()) that the tooth before the last tooth was registered on secondary input
@@ -101,6 +105,7 @@ volatile unsigned long triggerSecFilterTime; // The shortest time (in uS) that p
 volatile unsigned long triggerThirdFilterTime; // The shortest time (in uS) that pulses will be accepted (Used for debounce filtering) for the Third input
 
 volatile uint8_t decoderState = 0;
+volatile uint8_t decoderGeneration = 0; //Incremented by the trigger interrupts each time the decoder has run. See getDecoderSnapshot()
 
 unsigned int triggerSecFilterTime_duration; // The shortest valid time (in uS) pulse DURATION
 volatile uint16_t triggerToothAngle; //The number of crank degrees that elapse per tooth
@@ -133,12 +138,34 @@ static libdivide::libdivide_s16_t divTriggerToothAngle;
 */
 // whichTooth - 0 for Primary (Crank), 1 for Secondary (Cam)
 
+/** The time and trigger input levels read at the start of a logger interrupt */
+struct trigger_edge_t {
+  unsigned long time; ///< micros() at the start of the interrupt. Only read (Otherwise 0) when the composite logger is running
+  byte levels; ///< The level of each trigger input, in the COMPOSITE_LOG_PRI, COMPOSITE_LOG_SEC and COMPOSITE_LOG_THIRD bits
+};
+
+/** Reads the time and the trigger input levels as the first thing in a logger interrupt, before the decoder runs.
+ * This keeps the decoder's run time out of the composite log. The values still include the interrupt latency, so they are
+ * not the time or levels of the edge itself.
+ */
+static inline trigger_edge_t captureTriggerEdge(void)
+{
+  trigger_edge_t edge;
+  edge.time = (currentStatus.compositeTriggerUsed > 0U) ? micros() : 0UL;
+  edge.levels = 0;
+  if(READ_PRI_TRIGGER() == true) { BIT_SET(edge.levels, COMPOSITE_LOG_PRI); }
+  if(READ_SEC_TRIGGER() == true) { BIT_SET(edge.levels, COMPOSITE_LOG_SEC); }
+  if(READ_THIRD_TRIGGER() == true) { BIT_SET(edge.levels, COMPOSITE_LOG_THIRD); }
+  return edge;
+}
+
 /** Add tooth log entry to toothHistory (array).
  * Enabled by (either) currentStatus.toothLogEnabled and currentStatus.compositeTriggerUsed.
  * @param toothTime - Tooth Time
  * @param whichTooth - 0 for Primary (Crank), 2 for Secondary (Cam) 3 for Tertiary (Cam)
+ * @param edge - The time and input levels from the start of the interrupt (See captureTriggerEdge()). Used by the composite logger
  */
-static inline void addToothLogEntry(unsigned long toothTime, byte whichTooth)
+static inline void addToothLogEntry(unsigned long toothTime, byte whichTooth, const trigger_edge_t &edge)
 {
   if(BIT_CHECK(currentStatus.status1, BIT_STATUS1_TOOTHLOG1READY)) { return; }
   //High speed tooth logging history
@@ -160,26 +187,26 @@ static inline void addToothLogEntry(unsigned long toothTime, byte whichTooth)
       if(currentStatus.compositeTriggerUsed == 4)
       {
         // we want to display both cams so swap the values round to display primary as cam1 and secondary as cam2, include the crank in the data as the third output
-        if(READ_SEC_TRIGGER() == true) { BIT_SET(compositeLogHistory[toothHistoryIndex], COMPOSITE_LOG_PRI); }
-        if(READ_THIRD_TRIGGER() == true) { BIT_SET(compositeLogHistory[toothHistoryIndex], COMPOSITE_LOG_SEC); }
-        if(READ_PRI_TRIGGER() == true) { BIT_SET(compositeLogHistory[toothHistoryIndex], COMPOSITE_LOG_THIRD); }
+        if(BIT_CHECK(edge.levels, COMPOSITE_LOG_SEC)) { BIT_SET(compositeLogHistory[toothHistoryIndex], COMPOSITE_LOG_PRI); }
+        if(BIT_CHECK(edge.levels, COMPOSITE_LOG_THIRD)) { BIT_SET(compositeLogHistory[toothHistoryIndex], COMPOSITE_LOG_SEC); }
+        if(BIT_CHECK(edge.levels, COMPOSITE_LOG_PRI)) { BIT_SET(compositeLogHistory[toothHistoryIndex], COMPOSITE_LOG_THIRD); }
         if(whichTooth > TOOTH_CAM_SECONDARY) { BIT_SET(compositeLogHistory[toothHistoryIndex], COMPOSITE_LOG_TRIG); }
       }
       else
       {
         // we want to display crank and one of the cams
-        if(READ_PRI_TRIGGER() == true) { BIT_SET(compositeLogHistory[toothHistoryIndex], COMPOSITE_LOG_PRI); }
+        if(BIT_CHECK(edge.levels, COMPOSITE_LOG_PRI)) { BIT_SET(compositeLogHistory[toothHistoryIndex], COMPOSITE_LOG_PRI); }
         if(currentStatus.compositeTriggerUsed == 3)
         { 
           // display cam2 and also log data for cam 1
-          if(READ_THIRD_TRIGGER() == true) { BIT_SET(compositeLogHistory[toothHistoryIndex], COMPOSITE_LOG_SEC); } // only the COMPOSITE_LOG_SEC value is visualised hence the swapping of the data
-          if(READ_SEC_TRIGGER() == true) { BIT_SET(compositeLogHistory[toothHistoryIndex], COMPOSITE_LOG_THIRD); } 
+          if(BIT_CHECK(edge.levels, COMPOSITE_LOG_THIRD)) { BIT_SET(compositeLogHistory[toothHistoryIndex], COMPOSITE_LOG_SEC); } // only the COMPOSITE_LOG_SEC value is visualised hence the swapping of the data
+          if(BIT_CHECK(edge.levels, COMPOSITE_LOG_SEC)) { BIT_SET(compositeLogHistory[toothHistoryIndex], COMPOSITE_LOG_THIRD); } 
         } 
         else
         { 
           // display cam1 and also log data for cam 2 - this is the historic composite view
-          if(READ_SEC_TRIGGER() == true) { BIT_SET(compositeLogHistory[toothHistoryIndex], COMPOSITE_LOG_SEC); } 
-          if(READ_THIRD_TRIGGER() == true) { BIT_SET(compositeLogHistory[toothHistoryIndex], COMPOSITE_LOG_THIRD); }
+          if(BIT_CHECK(edge.levels, COMPOSITE_LOG_SEC)) { BIT_SET(compositeLogHistory[toothHistoryIndex], COMPOSITE_LOG_SEC); } 
+          if(BIT_CHECK(edge.levels, COMPOSITE_LOG_THIRD)) { BIT_SET(compositeLogHistory[toothHistoryIndex], COMPOSITE_LOG_THIRD); }
         }
         if(whichTooth > TOOTH_CRANK) { BIT_SET(compositeLogHistory[toothHistoryIndex], COMPOSITE_LOG_TRIG); }
       }  
@@ -190,7 +217,7 @@ static inline void addToothLogEntry(unsigned long toothTime, byte whichTooth)
       else
       { BIT_CLEAR(compositeLogHistory[toothHistoryIndex], COMPOSITE_ENGINE_CYCLE);}
 
-      toothHistory[toothHistoryIndex] = micros();
+      toothHistory[toothHistoryIndex] = edge.time;
       valueLogged = true;
     }
 
@@ -205,12 +232,95 @@ static inline void addToothLogEntry(unsigned long toothTime, byte whichTooth)
   } //Tooth/Composite log enabled
 }
 
+/** The crank angle of the last tooth gap to pass to the RPM estimator. 0 (Unknown) when the decoder cannot provide an accurate angle, such as over the missing teeth gap */
+static inline uint16_t getEstimatorToothAngle(void)
+{
+  return BIT_CHECK(decoderState, BIT_DECODER_TOOTH_ANG_CORRECT) ? triggerToothAngle : 0U;
+}
+
+/** Interrupt handler for the primary trigger.
+* Calls the decoder and then publishes the new decoder state to the main loop (See getDecoderSnapshot()).
+* When angle arming is active the schedules that start shortly after this tooth are then armed (See angleArming.h).
+*/
+void decoderPrimaryISR(void)
+{
+  BIT_CLEAR(decoderState, BIT_DECODER_VALID_TRIGGER);
+  triggerHandler();
+  decoderGeneration++;
+  armSchedulesAtTooth();
+}
+
+/** Interrupt handler for the primary trigger when the RPM estimator is enabled.
+* As decoderPrimaryISR, but also passes each valid tooth to the estimator.
+*/
+void rpmEstimatorPrimaryISR(void)
+{
+  BIT_CLEAR(decoderState, BIT_DECODER_VALID_TRIGGER);
+  triggerHandler();
+  decoderGeneration++;
+  if( BIT_CHECK(decoderState, BIT_DECODER_VALID_TRIGGER) ) { addRPMEstimatorTooth(toothLastToothTime, getEstimatorToothAngle()); }
+  armSchedulesAtTooth();
+}
+
+/** Interrupt handler for the secondary trigger.
+* Calls the decoder and then publishes the new decoder state to the main loop (See getDecoderSnapshot()).
+*/
+void decoderSecondaryISR(void)
+{
+  triggerSecondaryHandler();
+  decoderGeneration++;
+}
+
+/** Takes a consistent copy of the decoder state that is shared with the trigger interrupts.
+* Rather than disabling interrupts while the values are copied, the copy is repeated if any trigger interrupt ran
+* part way through it. The interrupts increment decoderGeneration after the decoder has run, so an unchanged
+* generation means none of the values were changed during the copy.
+* @param snapshot - The copy to fill
+*/
+#if defined(UNIT_TEST)
+void (*decoderSnapshotPreempt)(void) = nullptr; //Called part way through each copy to simulate a trigger interrupt
+#endif
+void getDecoderSnapshot(decoder_snapshot_t &snapshot)
+{
+  uint8_t generation;
+  do
+  {
+    generation = decoderGeneration;
+    snapshot.toothLastToothTime = toothLastToothTime;
+    snapshot.toothLastMinusOneToothTime = toothLastMinusOneToothTime;
+#if defined(UNIT_TEST)
+    if(decoderSnapshotPreempt != nullptr) { decoderSnapshotPreempt(); }
+#endif
+    snapshot.toothOneTime = toothOneTime;
+    snapshot.toothOneMinusOneTime = toothOneMinusOneTime;
+    snapshot.toothCurrentCount = toothCurrentCount;
+    snapshot.secondaryToothCount = secondaryToothCount;
+    snapshot.triggerToothAngle = triggerToothAngle;
+    snapshot.revolutionOne = revolutionOne;
+    snapshot.toothAngleCorrect = BIT_CHECK(decoderState, BIT_DECODER_TOOTH_ANG_CORRECT);
+  } while(generation != decoderGeneration);
+}
+
+/** Returns toothLastToothTime, using the same method as getDecoderSnapshot() */
+static inline unsigned long getToothLastToothTime(void)
+{
+  uint8_t generation;
+  unsigned long lastToothTime;
+  do
+  {
+    generation = decoderGeneration;
+    lastToothTime = toothLastToothTime;
+  } while(generation != decoderGeneration);
+  return lastToothTime;
+}
+
 /** Interrupt handler for primary trigger.
 * This function is called on both the rising and falling edges of the primary trigger, when either the 
 * composite or tooth loggers are turned on. 
 */
 void loggerPrimaryISR(void)
 {
+  const trigger_edge_t edge = captureTriggerEdge();
   BIT_CLEAR(decoderState, BIT_DECODER_VALID_TRIGGER); //This value will be set to the return value of the decoder function, indicating whether or not this pulse passed the filters
   bool validEdge = false; //This is set true below if the edge 
   /* 
@@ -220,23 +330,26 @@ void loggerPrimaryISR(void)
   2) If the primary trigger is FALLING, then check whether the primary is currently LOW
   If either of these are true, the primary decoder function is called
   */
-  if( ( (primaryTriggerEdge == RISING) && (READ_PRI_TRIGGER() == HIGH) ) || ( (primaryTriggerEdge == FALLING) && (READ_PRI_TRIGGER() == LOW) ) || (primaryTriggerEdge == CHANGE) )
+  if( ( (primaryTriggerEdge == RISING) && BIT_CHECK(edge.levels, COMPOSITE_LOG_PRI) ) || ( (primaryTriggerEdge == FALLING) && !BIT_CHECK(edge.levels, COMPOSITE_LOG_PRI) ) || (primaryTriggerEdge == CHANGE) )
   {
     triggerHandler();
+    decoderGeneration++;
     validEdge = true;
+    if( (primaryTriggerISR == rpmEstimatorPrimaryISR) && (BIT_CHECK(decoderState, BIT_DECODER_VALID_TRIGGER)) ) { addRPMEstimatorTooth(toothLastToothTime, getEstimatorToothAngle()); }
+    armSchedulesAtTooth();
   }
   if( (currentStatus.toothLogEnabled == true) && (BIT_CHECK(decoderState, BIT_DECODER_VALID_TRIGGER)) )
   {
     //Tooth logger only logs when the edge was correct
     if(validEdge == true) 
     { 
-      addToothLogEntry(curGap, TOOTH_CRANK);
+      addToothLogEntry(curGap, TOOTH_CRANK, edge);
     }
   }
   else if( (currentStatus.compositeTriggerUsed > 0) )
   {
     //Composite logger adds an entry regardless of which edge it was
-    addToothLogEntry(curGap, TOOTH_CRANK);
+    addToothLogEntry(curGap, TOOTH_CRANK, edge);
   }
 }
 
@@ -245,6 +358,7 @@ void loggerPrimaryISR(void)
 */
 void loggerSecondaryISR(void)
 {
+  const trigger_edge_t edge = captureTriggerEdge();
   BIT_CLEAR(decoderState, BIT_DECODER_VALID_TRIGGER); //This value will be set to the return value of the decoder function, indicating whether or not this pulse passed the filters
   BIT_SET(decoderState, BIT_DECODER_VALID_TRIGGER); //This value will be set to the return value of the decoder function, indicating whether or not this pulse passed the filters
   /* 3 checks here:
@@ -253,15 +367,16 @@ void loggerSecondaryISR(void)
   3) The secondary trigger is CHANGING
   If any of these are true, the primary decoder function is called
   */
-  if( ( (secondaryTriggerEdge == RISING) && (READ_SEC_TRIGGER() == HIGH) ) || ( (secondaryTriggerEdge == FALLING) && (READ_SEC_TRIGGER() == LOW) ) || (secondaryTriggerEdge == CHANGE) )
+  if( ( (secondaryTriggerEdge == RISING) && BIT_CHECK(edge.levels, COMPOSITE_LOG_SEC) ) || ( (secondaryTriggerEdge == FALLING) && !BIT_CHECK(edge.levels, COMPOSITE_LOG_SEC) ) || (secondaryTriggerEdge == CHANGE) )
   {
     triggerSecondaryHandler();
+    decoderGeneration++;
   }
   //No tooth logger for the secondary input
   if( (currentStatus.compositeTriggerUsed > 0) && (BIT_CHECK(decoderState, BIT_DECODER_VALID_TRIGGER)) )
   {
     //Composite logger adds an entry regardless of which edge it was
-    addToothLogEntry(curGap2, TOOTH_CAM_SECONDARY);
+    addToothLogEntry(curGap2, TOOTH_CAM_SECONDARY, edge);
   }
 }
 
@@ -270,6 +385,7 @@ void loggerSecondaryISR(void)
 */
 void loggerTertiaryISR(void)
 {
+  const trigger_edge_t edge = captureTriggerEdge();
   BIT_CLEAR(decoderState, BIT_DECODER_VALID_TRIGGER); //This value will be set to the return value of the decoder function, indicating whether or not this pulse passed the filters
   BIT_SET(decoderState, BIT_DECODER_VALID_TRIGGER); //This value will be set to the return value of the decoder function, indicating whether or not this pulse passed the filters
   /* 3 checks here:
@@ -280,7 +396,7 @@ void loggerTertiaryISR(void)
   */
   
   
-  if( ( (tertiaryTriggerEdge == RISING) && ( READ_THIRD_TRIGGER() == HIGH) ) || ( (tertiaryTriggerEdge == FALLING) && (READ_THIRD_TRIGGER() == LOW) ) || (tertiaryTriggerEdge == CHANGE) )
+  if( ( (tertiaryTriggerEdge == RISING) && BIT_CHECK(edge.levels, COMPOSITE_LOG_THIRD) ) || ( (tertiaryTriggerEdge == FALLING) && !BIT_CHECK(edge.levels, COMPOSITE_LOG_THIRD) ) || (tertiaryTriggerEdge == CHANGE) )
   {
     triggerTertiaryHandler();
   }
@@ -288,7 +404,7 @@ void loggerTertiaryISR(void)
   if( (currentStatus.compositeTriggerUsed > 0) && (BIT_CHECK(decoderState, BIT_DECODER_VALID_TRIGGER)) )
   {
     //Composite logger adds an entry regardless of which edge it was
-    addToothLogEntry(curGap3, TOOTH_CAM_TERTIARY);
+    addToothLogEntry(curGap3, TOOTH_CAM_TERTIARY, edge);
   }  
 }
 
@@ -316,18 +432,16 @@ uint32_t angleToTimeIntervalTooth(uint16_t angle) {
 
 static uint16_t timeToAngleIntervalTooth(uint32_t time)
 {
-    noInterrupts();
+    decoder_snapshot_t snapshot;
+    getDecoderSnapshot(snapshot);
     //Still uses a last interval method (ie retrospective), but bases the interval on the gap between the 2 most recent teeth rather than the last full revolution
-    if(BIT_CHECK(decoderState, BIT_DECODER_TOOTH_ANG_CORRECT))
+    if(snapshot.toothAngleCorrect)
     {
-      unsigned long toothTime = (toothLastToothTime - toothLastMinusOneToothTime);
-      uint16_t tempTriggerToothAngle = triggerToothAngle; // triggerToothAngle is set by interrupts
-      interrupts();
+      unsigned long toothTime = (snapshot.toothLastToothTime - snapshot.toothLastMinusOneToothTime);
 
-      return (unsigned long)(time * (uint32_t)tempTriggerToothAngle) / toothTime;
+      return (unsigned long)(time * (uint32_t)snapshot.triggerToothAngle) / toothTime;
     }
     else { 
-      interrupts();
       //Safety check. This can occur if the last tooth seen was outside the normal pattern etc
       return timeToAngleDegPerMicroSec(time);
     }
@@ -341,10 +455,8 @@ bool engineIsRunning(uint32_t curTime) {
   // Check how long ago the last tooth was seen compared to now. 
   // If it was more than MAX_STALL_TIME then the engine is probably stopped. 
   // toothLastToothTime can be greater than curTime if a pulse occurs between getting the latest time and doing the comparison
-  ATOMIC() {
-    return (toothLastToothTime > curTime) || ((curTime - toothLastToothTime) < MAX_STALL_TIME); 
-  }
-  return false; // Just here to avoid compiler warning.
+  unsigned long lastToothTime = getToothLastToothTime();
+  return (lastToothTime > curTime) || ((curTime - lastToothTime) < MAX_STALL_TIME); 
 }
 
 void resetDecoder(void) {
@@ -361,23 +473,23 @@ static __attribute__((noinline)) bool SetRevolutionTime(uint32_t revTime)
 #endif
 {
   if (revTime!=revolutionTime) {
-    revolutionTime = revTime;
-    setAngleConverterRevolutionTime(revolutionTime);
+    ATOMIC() { revolutionTime = revTime; } //revolutionTime is used by some of the trigger interrupts
+    setAngleConverterRevolutionTime(revTime);
     return true;
   } 
   return false;
 }
 
 static bool UpdateRevolutionTimeFromTeeth(bool isCamTeeth) {
-  noInterrupts();
+  decoder_snapshot_t snapshot;
+  getDecoderSnapshot(snapshot);
   bool updatedRevTime = HasAnySync(currentStatus) 
     && !IsCranking(currentStatus)
-    && (toothOneMinusOneTime!=UINT32_C(0))
-    && (toothOneTime>toothOneMinusOneTime) 
+    && (snapshot.toothOneMinusOneTime!=UINT32_C(0))
+    && (snapshot.toothOneTime>snapshot.toothOneMinusOneTime) 
     //The time in uS that one revolution would take at current speed (The time tooth 1 was last seen, minus the time it was seen prior to that)
-    && SetRevolutionTime((toothOneTime - toothOneMinusOneTime) >> (isCamTeeth ? 1U : 0U)); 
+    && SetRevolutionTime((snapshot.toothOneTime - snapshot.toothOneMinusOneTime) >> (isCamTeeth ? 1U : 0U)); 
 
-  interrupts();
  return updatedRevTime;  
 }
 
@@ -452,11 +564,11 @@ static __attribute__((noinline)) int crankingGetRPM(byte totalTeeth, bool isCamT
 {
   if( (currentStatus.startRevolutions >= configPage4.StgCycles) && ((currentStatus.hasSync == true) || BIT_CHECK(currentStatus.status3, BIT_STATUS3_HALFSYNC)) )
   {
-    if((toothLastMinusOneToothTime > 0) && (toothLastToothTime > toothLastMinusOneToothTime) )
+    decoder_snapshot_t snapshot;
+    getDecoderSnapshot(snapshot);
+    if((snapshot.toothLastMinusOneToothTime > 0) && (snapshot.toothLastToothTime > snapshot.toothLastMinusOneToothTime) )
     {
-      noInterrupts();
-      bool newRevtime = SetRevolutionTime(((toothLastToothTime - toothLastMinusOneToothTime) * totalTeeth) >> (isCamTeeth ? 1U : 0U));
-      interrupts();
+      bool newRevtime = SetRevolutionTime(((snapshot.toothLastToothTime - snapshot.toothLastMinusOneToothTime) * totalTeeth) >> (isCamTeeth ? 1U : 0U));
       if (newRevtime) {
         return RpmFromRevolutionTimeUs(revolutionTime);
       }
@@ -707,6 +819,8 @@ void triggerSec_missingTooth(void)
           revolutionOne = 1; //Sequential revolution reset
           triggerSecFilterTime = 0; //This is used to prevent a condition where serious intermittent signals (Eg someone furiously plugging the sensor wire in and out) can leave the filter in an unrecoverable state
           triggerRecordVVT1Angle();
+          //Only a gap measured against a previous gap identifies the revolution. The target is 0 on the 2nd tooth seen
+          if( (curGap2 >= targetGap2) && (targetGap2 > 0U) ) { syncOnCamEdge(); }
         }
         else
         {
@@ -728,6 +842,7 @@ void triggerSec_missingTooth(void)
         triggerSecFilterTime = curGap2 >> 1; //Next secondary filter is half the current gap
         secondaryToothCount++;
         triggerRecordVVT1Angle();
+        syncOnCamEdge();
         break;
 
       case SEC_TRIGGER_TOYOTA_3:
@@ -738,6 +853,7 @@ void triggerSec_missingTooth(void)
         { 
           revolutionOne = 1; // sequential revolution reset
           triggerRecordVVT1Angle();         
+          syncOnCamEdge(); //The count is reset at each crank gap, so it can only reach 2 in the revolution with 2 teeth once there is half sync
         }        
         //Next secondary filter is 25% the current gap, done here so we don't get a great big gap for the 1st tooth
         triggerSecFilterTime = curGap2 >> 2; 
@@ -747,6 +863,19 @@ void triggerSec_missingTooth(void)
   } //Trigger filter
 }
 
+/** Called when a cam edge has set revolutionOne. If the crank gap has already been seen (Half sync), the position in the
+ * cycle is now known, so full sync is declared from this edge rather than waiting for the next crank gap.
+ * The main loop then moves the channels from wasted spark and batch fuel over to sequential.
+ */
+static inline void syncOnCamEdge(void)
+{
+  if( (currentStatus.hasSync == false) && BIT_CHECK(currentStatus.status3, BIT_STATUS3_HALFSYNC) )
+  {
+    currentStatus.hasSync = true;
+    BIT_CLEAR(currentStatus.status3, BIT_STATUS3_HALFSYNC);
+  }
+}
+
 static inline void triggerRecordVVT1Angle (void)
 {
   //Record the VVT Angle
@@ -820,11 +949,11 @@ int getCrankAngle_missingTooth(void)
     int tempToothCurrentCount;
     bool tempRevolutionOne;
     //Grab some variables that are used in the trigger code and assign them to temp variables.
-    noInterrupts();
-    tempToothCurrentCount = toothCurrentCount;
-    tempRevolutionOne = revolutionOne;
-    tempToothLastToothTime = toothLastToothTime;
-    interrupts();
+    decoder_snapshot_t snapshot;
+    getDecoderSnapshot(snapshot);
+    tempToothCurrentCount = snapshot.toothCurrentCount;
+    tempRevolutionOne = snapshot.revolutionOne;
+    tempToothLastToothTime = snapshot.toothLastToothTime;
 
     int crankAngle = ((tempToothCurrentCount - 1) * triggerToothAngle) + configPage4.triggerAngle; //Number of teeth that have passed since tooth 1, multiplied by the angle each tooth represents, plus the angle that tooth 1 is ATDC. This gives accuracy only to the nearest tooth.
     
@@ -1024,12 +1153,12 @@ int getCrankAngle_DualWheel(void)
     int tempToothCurrentCount;
     bool tempRevolutionOne;
     //Grab some variables that are used in the trigger code and assign them to temp variables.
-    noInterrupts();
-    tempToothCurrentCount = toothCurrentCount;
-    tempToothLastToothTime = toothLastToothTime;
-    tempRevolutionOne = revolutionOne;
+    decoder_snapshot_t snapshot;
+    getDecoderSnapshot(snapshot);
+    tempToothCurrentCount = snapshot.toothCurrentCount;
+    tempToothLastToothTime = snapshot.toothLastToothTime;
+    tempRevolutionOne = snapshot.revolutionOne;
     lastCrankAngleCalc = micros();
-    interrupts();
 
     //Handle case where the secondary tooth was the last one seen
     if(tempToothCurrentCount == 0) { tempToothCurrentCount = configPage4.triggerTeeth; }
@@ -1198,11 +1327,11 @@ int getCrankAngle_BasicDistributor(void)
     unsigned long tempToothLastToothTime;
     int tempToothCurrentCount;
     //Grab some variables that are used in the trigger code and assign them to temp variables.
-    noInterrupts();
-    tempToothCurrentCount = toothCurrentCount;
-    tempToothLastToothTime = toothLastToothTime;
-    lastCrankAngleCalc = micros(); //micros() is no longer interrupt safe
-    interrupts();
+    decoder_snapshot_t snapshot;
+    getDecoderSnapshot(snapshot);
+    tempToothCurrentCount = snapshot.toothCurrentCount;
+    tempToothLastToothTime = snapshot.toothLastToothTime;
+    lastCrankAngleCalc = micros();
 
     int crankAngle = ((tempToothCurrentCount - 1) * triggerToothAngle) + configPage4.triggerAngle; //Number of teeth that have passed since tooth 1, multiplied by the angle each tooth represents, plus the angle that tooth 1 is ATDC. This gives accuracy only to the nearest tooth.
     
@@ -1379,11 +1508,11 @@ int getCrankAngle_GM7X(void)
     unsigned long tempToothLastToothTime;
     int tempToothCurrentCount;
     //Grab some variables that are used in the trigger code and assign them to temp variables.
-    noInterrupts();
-    tempToothCurrentCount = toothCurrentCount;
-    tempToothLastToothTime = toothLastToothTime;
-    lastCrankAngleCalc = micros(); //micros() is no longer interrupt safe
-    interrupts();
+    decoder_snapshot_t snapshot;
+    getDecoderSnapshot(snapshot);
+    tempToothCurrentCount = snapshot.toothCurrentCount;
+    tempToothLastToothTime = snapshot.toothLastToothTime;
+    lastCrankAngleCalc = micros();
 
     //Check if the last tooth seen was the reference tooth (Number 3). All others can be calculated, but tooth 3 has a unique angle
     int crankAngle;
@@ -1769,10 +1898,10 @@ uint16_t getRPM_4G63(void)
       if( (toothLastToothTime == 0) || (toothLastMinusOneToothTime == 0) ) { tempRPM = 0; }
       else
       {
-        noInterrupts();
-        tempToothAngle = triggerToothAngle;
-        toothTime = (toothLastToothTime - toothLastMinusOneToothTime); //Note that trigger tooth angle changes between 70 and 110 depending on the last tooth that was seen (or 70/50 for 6 cylinders)
-        interrupts();
+        decoder_snapshot_t snapshot;
+        getDecoderSnapshot(snapshot);
+        tempToothAngle = snapshot.triggerToothAngle;
+        toothTime = (snapshot.toothLastToothTime - snapshot.toothLastMinusOneToothTime); //Note that trigger tooth angle changes between 70 and 110 depending on the last tooth that was seen (or 70/50 for 6 cylinders)
         toothTime = toothTime * 36;
         tempRPM = ((unsigned long)tempToothAngle * (MICROS_PER_MIN/10U)) / toothTime;
         SetRevolutionTime((10UL * toothTime) / tempToothAngle);
@@ -1801,11 +1930,11 @@ int getCrankAngle_4G63(void)
       unsigned long tempToothLastToothTime;
       int tempToothCurrentCount;
       //Grab some variables that are used in the trigger code and assign them to temp variables.
-      noInterrupts();
-      tempToothCurrentCount = toothCurrentCount;
-      tempToothLastToothTime = toothLastToothTime;
-      lastCrankAngleCalc = micros(); //micros() is no longer interrupt safe
-      interrupts();
+      decoder_snapshot_t snapshot;
+      getDecoderSnapshot(snapshot);
+      tempToothCurrentCount = snapshot.toothCurrentCount;
+      tempToothLastToothTime = snapshot.toothLastToothTime;
+      lastCrankAngleCalc = micros();
 
       crankAngle = toothAngles[(tempToothCurrentCount - 1)] + configPage4.triggerAngle; //Perform a lookup of the fixed toothAngles array to find what the angle of the last tooth passed was.
 
@@ -1952,12 +2081,12 @@ int getCrankAngle_24X(void)
     unsigned long tempToothLastToothTime;
     int tempToothCurrentCount, tempRevolutionOne;
     //Grab some variables that are used in the trigger code and assign them to temp variables.
-    noInterrupts();
-    tempToothCurrentCount = toothCurrentCount;
-    tempToothLastToothTime = toothLastToothTime;
-    tempRevolutionOne = revolutionOne;
-    lastCrankAngleCalc = micros(); //micros() is no longer interrupt safe
-    interrupts();
+    decoder_snapshot_t snapshot;
+    getDecoderSnapshot(snapshot);
+    tempToothCurrentCount = snapshot.toothCurrentCount;
+    tempToothLastToothTime = snapshot.toothLastToothTime;
+    tempRevolutionOne = snapshot.revolutionOne;
+    lastCrankAngleCalc = micros();
 
     int crankAngle;
     if (tempToothCurrentCount == 0) { crankAngle = 0 + configPage4.triggerAngle; } //This is the special case to handle when the 'last tooth' seen was the cam tooth. 0 is the angle at which the crank tooth goes high (Within 360 degrees).
@@ -2062,11 +2191,11 @@ int getCrankAngle_Jeep2000(void)
     unsigned long tempToothLastToothTime;
     int tempToothCurrentCount;
     //Grab some variables that are used in the trigger code and assign them to temp variables.
-    noInterrupts();
-    tempToothCurrentCount = toothCurrentCount;
-    tempToothLastToothTime = toothLastToothTime;
-    lastCrankAngleCalc = micros(); //micros() is no longer interrupt safe
-    interrupts();
+    decoder_snapshot_t snapshot;
+    getDecoderSnapshot(snapshot);
+    tempToothCurrentCount = snapshot.toothCurrentCount;
+    tempToothLastToothTime = snapshot.toothLastToothTime;
+    lastCrankAngleCalc = micros();
 
     int crankAngle;
     if (toothCurrentCount == 0) { crankAngle = 114 + configPage4.triggerAngle; } //This is the special case to handle when the 'last tooth' seen was the cam tooth. Since  the tooth timings were taken on the previous crank tooth, the previous crank tooth angle is used here, not cam angle.
@@ -2177,12 +2306,12 @@ int getCrankAngle_Audi135(void)
     int tempToothCurrentCount;
     bool tempRevolutionOne;
     //Grab some variables that are used in the trigger code and assign them to temp variables.
-    noInterrupts();
-    tempToothCurrentCount = toothCurrentCount;
-    tempToothLastToothTime = toothLastToothTime;
-    tempRevolutionOne = revolutionOne;
-    lastCrankAngleCalc = micros(); //micros() is no longer interrupt safe
-    interrupts();
+    decoder_snapshot_t snapshot;
+    getDecoderSnapshot(snapshot);
+    tempToothCurrentCount = snapshot.toothCurrentCount;
+    tempToothLastToothTime = snapshot.toothLastToothTime;
+    tempRevolutionOne = snapshot.revolutionOne;
+    lastCrankAngleCalc = micros();
 
     //Handle case where the secondary tooth was the last one seen
     if(tempToothCurrentCount == 0) { tempToothCurrentCount = 45; }
@@ -2272,11 +2401,11 @@ int getCrankAngle_HondaD17(void)
     unsigned long tempToothLastToothTime;
     int tempToothCurrentCount;
     //Grab some variables that are used in the trigger code and assign them to temp variables.
-    noInterrupts();
-    tempToothCurrentCount = toothCurrentCount;
-    tempToothLastToothTime = toothLastToothTime;
-    lastCrankAngleCalc = micros(); //micros() is no longer interrupt safe
-    interrupts();
+    decoder_snapshot_t snapshot;
+    getDecoderSnapshot(snapshot);
+    tempToothCurrentCount = snapshot.toothCurrentCount;
+    tempToothLastToothTime = snapshot.toothLastToothTime;
+    lastCrankAngleCalc = micros();
 
     //Check if the last tooth seen was the reference tooth 13 (Number 0 here). All others can be calculated, but tooth 3 has a unique angle
     int crankAngle;
@@ -2415,11 +2544,11 @@ int getCrankAngle_HondaJ32(void)
   // Teeth 14 and 22 are unusually sized (18 degrees), but the missing tooth is smaller (12 degrees), so this oddity only applies when toothCurrentCount = 14 || 22
   int crankAngle;
   uint16_t tempToothCurrentCount;
-  noInterrupts();
-    tempToothCurrentCount = toothCurrentCount;
-    lastCrankAngleCalc = micros(); //micros() is no longer interrupt safe
-    elapsedTime = lastCrankAngleCalc - toothLastToothTime;
-  interrupts();
+  decoder_snapshot_t snapshot;
+  getDecoderSnapshot(snapshot);
+  tempToothCurrentCount = snapshot.toothCurrentCount;
+  lastCrankAngleCalc = micros();
+  elapsedTime = lastCrankAngleCalc - snapshot.toothLastToothTime;
 
   if (tempToothCurrentCount == 14)
   {
@@ -2620,10 +2749,10 @@ uint16_t getRPM_Miata9905(void)
     {
       int tempToothAngle;
       unsigned long toothTime;
-      noInterrupts();
-      tempToothAngle = triggerToothAngle;
-      toothTime = (toothLastToothTime - toothLastMinusOneToothTime); //Note that trigger tooth angle changes between 70 and 110 depending on the last tooth that was seen
-      interrupts();
+      decoder_snapshot_t snapshot;
+      getDecoderSnapshot(snapshot);
+      tempToothAngle = snapshot.triggerToothAngle;
+      toothTime = (snapshot.toothLastToothTime - snapshot.toothLastMinusOneToothTime); //Note that trigger tooth angle changes between 70 and 110 depending on the last tooth that was seen
       toothTime = toothTime * 36;
       tempRPM = ((unsigned long)tempToothAngle * (MICROS_PER_MIN/10U)) / toothTime;
       SetRevolutionTime((10UL * toothTime) / tempToothAngle);
@@ -2649,11 +2778,11 @@ int getCrankAngle_Miata9905(void)
       unsigned long tempToothLastToothTime;
       int tempToothCurrentCount;
       //Grab some variables that are used in the trigger code and assign them to temp variables.
-      noInterrupts();
-      tempToothCurrentCount = toothCurrentCount;
-      tempToothLastToothTime = toothLastToothTime;
-      lastCrankAngleCalc = micros(); //micros() is no longer interrupt safe
-      interrupts();
+      decoder_snapshot_t snapshot;
+      getDecoderSnapshot(snapshot);
+      tempToothCurrentCount = snapshot.toothCurrentCount;
+      tempToothLastToothTime = snapshot.toothLastToothTime;
+      lastCrankAngleCalc = micros();
 
       crankAngle = toothAngles[(tempToothCurrentCount - 1)] + configPage4.triggerAngle; //Perform a lookup of the fixed toothAngles array to find what the angle of the last tooth passed was.
 
@@ -2826,10 +2955,10 @@ uint16_t getRPM_MazdaAU(void)
     if(currentStatus.RPM < currentStatus.crankRPM)
     {
       int tempToothAngle;
-      noInterrupts();
-      tempToothAngle = triggerToothAngle;
-      SetRevolutionTime(36*(toothLastToothTime - toothLastMinusOneToothTime)); //Note that trigger tooth angle changes between 72 and 108 depending on the last tooth that was seen
-      interrupts();
+      decoder_snapshot_t snapshot;
+      getDecoderSnapshot(snapshot);
+      tempToothAngle = snapshot.triggerToothAngle;
+      SetRevolutionTime(36*(snapshot.toothLastToothTime - snapshot.toothLastMinusOneToothTime)); //Note that trigger tooth angle changes between 72 and 108 depending on the last tooth that was seen
       tempRPM = (tempToothAngle * MICROS_PER_MIN) / revolutionTime;
     }
     else { tempRPM = stdGetRPM(CRANK_SPEED); }
@@ -2846,11 +2975,11 @@ int getCrankAngle_MazdaAU(void)
       unsigned long tempToothLastToothTime;
       int tempToothCurrentCount;
       //Grab some variables that are used in the trigger code and assign them to temp variables.
-      noInterrupts();
-      tempToothCurrentCount = toothCurrentCount;
-      tempToothLastToothTime = toothLastToothTime;
-      lastCrankAngleCalc = micros(); //micros() is no longer interrupt safe
-      interrupts();
+      decoder_snapshot_t snapshot;
+      getDecoderSnapshot(snapshot);
+      tempToothCurrentCount = snapshot.toothCurrentCount;
+      tempToothLastToothTime = snapshot.toothLastToothTime;
+      lastCrankAngleCalc = micros();
 
       crankAngle = toothAngles[(tempToothCurrentCount - 1)] + configPage4.triggerAngle; //Perform a lookup of the fixed toothAngles array to find what the angle of the last tooth passed was.
 
@@ -2915,11 +3044,11 @@ int getCrankAngle_non360(void)
     unsigned long tempToothLastToothTime;
     int tempToothCurrentCount;
     //Grab some variables that are used in the trigger code and assign them to temp variables.
-    noInterrupts();
-    tempToothCurrentCount = toothCurrentCount;
-    tempToothLastToothTime = toothLastToothTime;
-    lastCrankAngleCalc = micros(); //micros() is no longer interrupt safe
-    interrupts();
+    decoder_snapshot_t snapshot;
+    getDecoderSnapshot(snapshot);
+    tempToothCurrentCount = snapshot.toothCurrentCount;
+    tempToothLastToothTime = snapshot.toothLastToothTime;
+    lastCrankAngleCalc = micros();
 
     //Handle case where the secondary tooth was the last one seen
     if(tempToothCurrentCount == 0) { tempToothCurrentCount = configPage4.triggerTeeth; }
@@ -3103,17 +3232,15 @@ uint16_t getRPM_Nissan360(void)
   uint16_t tempRPM;
   if( (currentStatus.hasSync == true) && (toothLastToothTime != 0) && (toothLastMinusOneToothTime != 0) )
   {
+    decoder_snapshot_t snapshot;
+    getDecoderSnapshot(snapshot);
     if(currentStatus.startRevolutions < 2)
     {
-      noInterrupts();
-      SetRevolutionTime((toothLastToothTime - toothLastMinusOneToothTime) * 180); //Each tooth covers 2 crank degrees, so multiply by 180 to get a full revolution time. 
-      interrupts();
+      SetRevolutionTime((snapshot.toothLastToothTime - snapshot.toothLastMinusOneToothTime) * 180); //Each tooth covers 2 crank degrees, so multiply by 180 to get a full revolution time. 
     }
     else
     {
-      noInterrupts();
-      SetRevolutionTime((toothOneTime - toothOneMinusOneTime) >> 1); //The time in uS that one revolution would take at current speed (The time tooth 1 was last seen, minus the time it was seen prior to that)
-      interrupts();
+      SetRevolutionTime((snapshot.toothOneTime - snapshot.toothOneMinusOneTime) >> 1); //The time in uS that one revolution would take at current speed (The time tooth 1 was last seen, minus the time it was seen prior to that)
     }
     tempRPM = RpmFromRevolutionTimeUs(revolutionTime); //Calc RPM based on last full revolution time (Faster as /)
     MAX_STALL_TIME = revolutionTime << 1; //Set the stall time to be twice the current RPM. This is a safe figure as there should be no single revolution where this changes more than this
@@ -3131,12 +3258,12 @@ int getCrankAngle_Nissan360(void)
   int tempToothLastMinusOneToothTime;
   int tempToothCurrentCount;
 
-  noInterrupts();
-  tempToothLastToothTime = toothLastToothTime;
-  tempToothLastMinusOneToothTime = toothLastMinusOneToothTime;
-  tempToothCurrentCount = toothCurrentCount;
-  lastCrankAngleCalc = micros(); //micros() is no longer interrupt safe
-  interrupts();
+  decoder_snapshot_t snapshot;
+  getDecoderSnapshot(snapshot);
+  tempToothLastToothTime = snapshot.toothLastToothTime;
+  tempToothLastMinusOneToothTime = snapshot.toothLastMinusOneToothTime;
+  tempToothCurrentCount = snapshot.toothCurrentCount;
+  lastCrankAngleCalc = micros();
 
   crankAngle = ( (tempToothCurrentCount - 1) * 2) + configPage4.triggerAngle;
   unsigned long halfTooth = (tempToothLastToothTime - tempToothLastMinusOneToothTime) / 2;
@@ -3381,11 +3508,11 @@ int getCrankAngle_Subaru67(void)
     unsigned long tempToothLastToothTime;
     int tempToothCurrentCount;
     //Grab some variables that are used in the trigger code and assign them to temp variables.
-    noInterrupts();
-    tempToothCurrentCount = toothCurrentCount;
-    tempToothLastToothTime = toothLastToothTime;
-    lastCrankAngleCalc = micros(); //micros() is no longer interrupt safe
-    interrupts();
+    decoder_snapshot_t snapshot;
+    getDecoderSnapshot(snapshot);
+    tempToothCurrentCount = snapshot.toothCurrentCount;
+    tempToothLastToothTime = snapshot.toothLastToothTime;
+    lastCrankAngleCalc = micros();
 
     crankAngle = toothAngles[(tempToothCurrentCount - 1)] + configPage4.triggerAngle; //Perform a lookup of the fixed toothAngles array to find what the angle of the last tooth passed was.
 
@@ -3559,9 +3686,9 @@ uint16_t getRPM_Daihatsu(void)
       else if (toothCurrentCount == 3) { tempRPM = currentStatus.RPM; }
       else
       {
-        noInterrupts();
-        SetRevolutionTime((toothLastToothTime - toothLastMinusOneToothTime) * (triggerActualTeeth-1));
-        interrupts();
+        decoder_snapshot_t snapshot;
+        getDecoderSnapshot(snapshot);
+        SetRevolutionTime((snapshot.toothLastToothTime - snapshot.toothLastMinusOneToothTime) * (triggerActualTeeth-1));
         tempRPM = RpmFromRevolutionTimeUs(revolutionTime);
       } //is tooth #2
     }
@@ -3580,11 +3707,11 @@ int getCrankAngle_Daihatsu(void)
     int tempToothCurrentCount;
     int crankAngle;
     //Grab some variables that are used in the trigger code and assign them to temp variables.
-    noInterrupts();
-    tempToothCurrentCount = toothCurrentCount;
-    tempToothLastToothTime = toothLastToothTime;
-    lastCrankAngleCalc = micros(); //micros() is no longer interrupt safe
-    interrupts();
+    decoder_snapshot_t snapshot;
+    getDecoderSnapshot(snapshot);
+    tempToothCurrentCount = snapshot.toothCurrentCount;
+    tempToothLastToothTime = snapshot.toothLastToothTime;
+    lastCrankAngleCalc = micros();
 
     crankAngle = toothAngles[tempToothCurrentCount-1] + configPage4.triggerAngle; //Crank angle of the last tooth seen
 
@@ -3682,15 +3809,15 @@ uint16_t getRPM_Harley(void)
       if ( (toothLastToothTime == 0) || (toothLastMinusOneToothTime == 0) ) { tempRPM = 0; }
       else
       {
-        noInterrupts();
-        tempToothAngle = triggerToothAngle;
+        decoder_snapshot_t snapshot;
+        getDecoderSnapshot(snapshot);
+        tempToothAngle = snapshot.triggerToothAngle;
         /* High-res mode
           if(toothCurrentCount == 1) { tempToothAngle = 129; }
           else { tempToothAngle = toothAngles[toothCurrentCount-1] - toothAngles[toothCurrentCount-2]; }
         */
-        SetRevolutionTime(toothOneTime - toothOneMinusOneTime); //The time in uS that one revolution would take at current speed (The time tooth 1 was last seen, minus the time it was seen prior to that)
-        toothTime = (toothLastToothTime - toothLastMinusOneToothTime); //Note that trigger tooth angle changes between 129 and 332 depending on the last tooth that was seen
-        interrupts();
+        SetRevolutionTime(snapshot.toothOneTime - snapshot.toothOneMinusOneTime); //The time in uS that one revolution would take at current speed (The time tooth 1 was last seen, minus the time it was seen prior to that)
+        toothTime = (snapshot.toothLastToothTime - snapshot.toothLastMinusOneToothTime); //Note that trigger tooth angle changes between 129 and 332 depending on the last tooth that was seen
         toothTime = toothTime * 36;
         tempRPM = ((unsigned long)tempToothAngle * (MICROS_PER_MIN/10U)) / toothTime;
       }
@@ -3709,11 +3836,11 @@ int getCrankAngle_Harley(void)
   unsigned long tempToothLastToothTime;
   int tempToothCurrentCount;
   //Grab some variables that are used in the trigger code and assign them to temp variables.
-  noInterrupts();
-  tempToothCurrentCount = toothCurrentCount;
-  tempToothLastToothTime = toothLastToothTime;
-  lastCrankAngleCalc = micros(); //micros() is no longer interrupt safe
-  interrupts();
+  decoder_snapshot_t snapshot;
+  getDecoderSnapshot(snapshot);
+  tempToothCurrentCount = snapshot.toothCurrentCount;
+  tempToothLastToothTime = snapshot.toothLastToothTime;
+  lastCrankAngleCalc = micros();
 
   //Check if the last tooth seen was the reference tooth (Number 3). All others can be calculated, but tooth 3 has a unique angle
   int crankAngle;
@@ -4200,11 +4327,11 @@ int getCrankAngle_420a(void)
   unsigned long tempToothLastToothTime;
   int tempToothCurrentCount;
   //Grab some variables that are used in the trigger code and assign them to temp variables.
-  noInterrupts();
-  tempToothCurrentCount = toothCurrentCount;
-  tempToothLastToothTime = toothLastToothTime;
-  lastCrankAngleCalc = micros(); //micros() is no longer interrupt safe
-  interrupts();
+  decoder_snapshot_t snapshot;
+  getDecoderSnapshot(snapshot);
+  tempToothCurrentCount = snapshot.toothCurrentCount;
+  tempToothLastToothTime = snapshot.toothLastToothTime;
+  lastCrankAngleCalc = micros();
 
   int crankAngle;
   crankAngle = toothAngles[(tempToothCurrentCount - 1)] + configPage4.triggerAngle; //Perform a lookup of the fixed toothAngles array to find what the angle of the last tooth passed was.
@@ -4451,11 +4578,11 @@ int getCrankAngle_FordST170(void)
     int tempToothCurrentCount;
     bool tempRevolutionOne;
     //Grab some variables that are used in the trigger code and assign them to temp variables.
-    noInterrupts();
-    tempToothCurrentCount = toothCurrentCount;
-    tempRevolutionOne = revolutionOne;
-    tempToothLastToothTime = toothLastToothTime;
-    interrupts();
+    decoder_snapshot_t snapshot;
+    getDecoderSnapshot(snapshot);
+    tempToothCurrentCount = snapshot.toothCurrentCount;
+    tempRevolutionOne = snapshot.revolutionOne;
+    tempToothLastToothTime = snapshot.toothLastToothTime;
 
     int crankAngle = ((tempToothCurrentCount - 1) * triggerToothAngle) + configPage4.triggerAngle; //Number of teeth that have passed since tooth 1, multiplied by the angle each tooth represents, plus the angle that tooth 1 is ATDC. This gives accuracy only to the nearest tooth.
     
@@ -5029,11 +5156,11 @@ uint16_t getRPM_Vmax(void)
       if ( (toothLastToothTime == 0) || (toothLastMinusOneToothTime == 0) ) { tempRPM = 0; }
       else
       {
-        noInterrupts();
-        tempToothAngle = triggerToothAngle;
-        SetRevolutionTime(toothOneTime - toothOneMinusOneTime); //The time in uS that one revolution would take at current speed (The time tooth 1 was last seen, minus the time it was seen prior to that)
-        toothTime = (toothLastToothTime - toothLastMinusOneToothTime); 
-        interrupts();
+        decoder_snapshot_t snapshot;
+        getDecoderSnapshot(snapshot);
+        tempToothAngle = snapshot.triggerToothAngle;
+        SetRevolutionTime(snapshot.toothOneTime - snapshot.toothOneMinusOneTime); //The time in uS that one revolution would take at current speed (The time tooth 1 was last seen, minus the time it was seen prior to that)
+        toothTime = (snapshot.toothLastToothTime - snapshot.toothLastMinusOneToothTime); 
         toothTime = toothTime * 36;
         tempRPM = ((unsigned long)tempToothAngle * (MICROS_PER_MIN/10U)) / toothTime;
       }
@@ -5052,11 +5179,11 @@ int getCrankAngle_Vmax(void)
   unsigned long tempToothLastToothTime;
   int tempsecondaryToothCount;
   //Grab some variables that are used in the trigger code and assign them to temp variables.
-  noInterrupts();
-  tempsecondaryToothCount = secondaryToothCount;
-  tempToothLastToothTime = toothLastToothTime;
-  lastCrankAngleCalc = micros(); //micros() is no longer interrupt safe
-  interrupts();
+  decoder_snapshot_t snapshot;
+  getDecoderSnapshot(snapshot);
+  tempsecondaryToothCount = snapshot.secondaryToothCount;
+  tempToothLastToothTime = snapshot.toothLastToothTime;
+  lastCrankAngleCalc = micros();
 
   //Check if the last tooth seen was the reference tooth (Number 3). All others can be calculated, but tooth 3 has a unique angle
   int crankAngle;
@@ -5450,11 +5577,11 @@ int getCrankAngle_RoverMEMS()
     int tempToothCurrentCount;
     bool tempRevolutionOne;
     //Grab some variables that are used in the trigger code and assign them to temp variables.
-    noInterrupts();
-    tempToothCurrentCount = toothCurrentCount;
-    tempRevolutionOne = revolutionOne;
-    tempToothLastToothTime = toothLastToothTime;
-    interrupts();
+    decoder_snapshot_t snapshot;
+    getDecoderSnapshot(snapshot);
+    tempToothCurrentCount = snapshot.toothCurrentCount;
+    tempRevolutionOne = snapshot.revolutionOne;
+    tempToothLastToothTime = snapshot.toothLastToothTime;
 
     int crankAngle = ((tempToothCurrentCount - 1) * triggerToothAngle) + configPage4.triggerAngle; //Number of teeth that have passed since tooth 1, multiplied by the angle each tooth represents, plus the angle that tooth 1 is ATDC. This gives accuracy only to the nearest tooth.
     
@@ -5917,11 +6044,11 @@ uint16_t getRPM_SuzukiK6A(void)
 int getCrankAngle_SuzukiK6A(void)
 {
   //Grab some variables that are used in the trigger code and assign them to temp variables.
-  noInterrupts();
-  uint16_t tempToothCurrentCount = toothCurrentCount;
-  unsigned long tempToothLastToothTime = toothLastToothTime;
-  lastCrankAngleCalc = micros(); //micros() is no longer interrupt safe
-  interrupts();
+  decoder_snapshot_t snapshot;
+  getDecoderSnapshot(snapshot);
+  uint16_t tempToothCurrentCount = snapshot.toothCurrentCount;
+  unsigned long tempToothLastToothTime = snapshot.toothLastToothTime;
+  lastCrankAngleCalc = micros();
 
   if (tempToothCurrentCount>0U) {
     triggerToothAngle = (uint16_t)toothAngles[tempToothCurrentCount] - (uint16_t)toothAngles[tempToothCurrentCount-1U];
@@ -44,7 +44,7 @@
 
 #define BIT_DECODER_2ND_DERIV           0 //The use of the 2nd derivative calculation is limited to certain decoders. This is set to either true or false in each decoders setup routine
 #define BIT_DECODER_IS_SEQUENTIAL       1 //Whether or not the decoder supports sequential operation
-#define BIT_DECODER_UNUSED1             2 
+#define BIT_DECODER_UNIFORM_TEETH       2 //Whether the angle of each primary tooth is ((toothCurrentCount - 1) * triggerToothAngle) + triggerAngle (+360 on the 2nd revolution). Angle arming is only used with these decoders
 #define BIT_DECODER_HAS_SECONDARY       3 //Whether or not the decoder supports fixed cranking timing
 #define BIT_DECODER_HAS_FIXED_CRANKING  4
 #define BIT_DECODER_VALID_TRIGGER       5 //Is set true when the last trigger (Primary or secondary) was valid (ie passed filters)
@@ -57,6 +57,29 @@
 
 //220 bytes free
 extern volatile uint8_t decoderState;
+extern volatile uint8_t decoderGeneration; //Incremented by the trigger interrupts each time the decoder has run. See getDecoderSnapshot()
+
+/**
+ * @brief A consistent copy of the decoder state that is shared between the trigger interrupts and the main loop
+ */
+struct decoder_snapshot_t {
+  unsigned long toothLastToothTime;         ///< See toothLastToothTime
+  unsigned long toothLastMinusOneToothTime; ///< See toothLastMinusOneToothTime
+  unsigned long toothOneTime;               ///< See toothOneTime
+  unsigned long toothOneMinusOneTime;       ///< See toothOneMinusOneTime
+  uint16_t toothCurrentCount;               ///< See toothCurrentCount
+  unsigned int secondaryToothCount;         ///< See secondaryToothCount
+  uint16_t triggerToothAngle;               ///< See triggerToothAngle
+  bool revolutionOne;                       ///< See revolutionOne
+  bool toothAngleCorrect;                   ///< BIT_DECODER_TOOTH_ANG_CORRECT of decoderState
+};
+
+/**
+ * @brief Copies the decoder state shared with the trigger interrupts without disabling interrupts
+ * 
+ * @param snapshot The copy to fill
+ */
+void getDecoderSnapshot(decoder_snapshot_t &snapshot);
 
 /**
  * @brief Is the engine running?
@@ -81,6 +104,9 @@ extern bool decoderHasFixedCrankingTiming;
 void loggerPrimaryISR(void);
 void loggerSecondaryISR(void);
 void loggerTertiaryISR(void);
+void decoderPrimaryISR(void);
+void decoderSecondaryISR(void);
+void rpmEstimatorPrimaryISR(void);
 
 //All of the below are the 6 required functions for each decoder / pattern
 void triggerSetup_missingTooth(void);
@@ -280,6 +306,7 @@ void resetDecoder(void);
 extern void (*triggerHandler)(void); //Pointer for the trigger function (Gets pointed to the relevant decoder)
 extern void (*triggerSecondaryHandler)(void); //Pointer for the secondary trigger function (Gets pointed to the relevant decoder)
 extern void (*triggerTertiaryHandler)(void); //Pointer for the tertiary trigger function (Gets pointed to the relevant decoder)
+extern void (*primaryTriggerISR)(void); //The interrupt attached to the primary trigger when the loggers are not running. Either decoderPrimaryISR or rpmEstimatorPrimaryISR
 
 extern uint16_t (*getRPM)(void); //Pointer to the getRPM function (Gets pointed to the relevant decoder)
 extern int (*getCrankAngle)(void); //Pointer to the getCrank Angle function (Gets pointed to the relevant decoder)
@@ -0,0 +1,114 @@
+/** @file
+ * Closed loop dwell control. See dwellControl.h
+ *
+ * The trims are kept in uS rather than degrees, as the scheduling delay that they make up for is a time. They are only
+ * converted to an angle when they are applied to the start angles.
+ */
+#include "globals.h"
+#include "dwellControl.h"
+#include "scheduler.h"
+#include "schedule_calcs.h"
+#include "crankMaths.h"
+#include "maths.h"
+#include "ignitionTrim.h"
+
+static int16_t dwellTrims[IGN_CHANNELS]; ///< Time (uS) added to the dwell of each channel
+static uint8_t lastSparkCounts[IGN_CHANNELS]; ///< IgnitionSchedule::sparkCount when each channel was last updated
+
+/** Clears the trims and the dwell errors. Called when the engine stops, and whenever closed loop dwell is not active */
+void resetDwellTrims(void)
+{
+  for(uint8_t channel = 0; channel < IGN_CHANNELS; channel++) { dwellTrims[channel] = 0; }
+  for(uint8_t channel = 0; channel < DWELL_ERROR_CHANNELS; channel++) { currentStatus.dwellError[channel] = 0; }
+}
+
+static void updateChannelTrim(const IgnitionSchedule &schedule, uint8_t channel, uint16_t targetDwell)
+{
+  uint8_t sparkCount;
+  uint16_t measuredDwell;
+  ATOMIC()
+  {
+    sparkCount = schedule.sparkCount;
+    measuredDwell = schedule.measuredDwell;
+  }
+  if(sparkCount == lastSparkCounts[channel]) { return; } //No spark on this channel since the last update
+  lastSparkCounts[channel] = sparkCount;
+
+  //The dwell trim table of the channel changes the dwell that is wanted on it
+  const int32_t channelDwell = (int32_t)targetDwell + getIgnitionDwellTrim(channel);
+  targetDwell = (channelDwell > 0) ? (uint16_t)min(channelDwell, (int32_t)UINT16_MAX) : 0U;
+
+  const int16_t error = (int16_t)min(targetDwell, (uint16_t)INT16_MAX) - (int16_t)min(measuredDwell, (uint16_t)INT16_MAX);
+  if(channel < DWELL_ERROR_CHANNELS) { currentStatus.dwellError[channel] = error; }
+
+  //The trim can never take more than half of the dwell away
+  const int16_t maxTrim = (int16_t)configPage15.dwellTrimLimit * 100;
+  const int16_t minTrim = max((int16_t)-maxTrim, (int16_t)-(int16_t)(min(targetDwell, (uint16_t)INT16_MAX) >> 1));
+  int32_t trim = (int32_t)dwellTrims[channel] + div100((int32_t)error * (int32_t)configPage15.dwellTrimGain);
+  dwellTrims[channel] = (int16_t)constrain(trim, (int32_t)minTrim, (int32_t)maxTrim);
+}
+
+/** Updates the trim of each ignition channel that has sparked since the last call, from the dwell that was measured on that spark
+ * @param targetDwell The dwell (uS) that is wanted, currentStatus.dwell. The dwell trim table of each channel is added to this
+ */
+void updateDwellTrims(uint16_t targetDwell)
+{
+  updateChannelTrim(ignitionSchedule1, IGN1_CMD_BIT, targetDwell);
+  if(maxIgnOutputs >= 2) { updateChannelTrim(ignitionSchedule2, IGN2_CMD_BIT, targetDwell); }
+  if(maxIgnOutputs >= 3) { updateChannelTrim(ignitionSchedule3, IGN3_CMD_BIT, targetDwell); }
+  if(maxIgnOutputs >= 4) { updateChannelTrim(ignitionSchedule4, IGN4_CMD_BIT, targetDwell); }
+#if IGN_CHANNELS >= 5
+  if(maxIgnOutputs >= 5) { updateChannelTrim(ignitionSchedule5, IGN5_CMD_BIT, targetDwell); }
+#endif
+#if IGN_CHANNELS >= 6
+  if(maxIgnOutputs >= 6) { updateChannelTrim(ignitionSchedule6, IGN6_CMD_BIT, targetDwell); }
+#endif
+#if IGN_CHANNELS >= 7
+  if(maxIgnOutputs >= 7) { updateChannelTrim(ignitionSchedule7, IGN7_CMD_BIT, targetDwell); }
+#endif
+#if IGN_CHANNELS >= 8
+  if(maxIgnOutputs >= 8) { updateChannelTrim(ignitionSchedule8, IGN8_CMD_BIT, targetDwell); }
+#endif
+}
+
+static inline void trimStartAngle(int *pStartAngle, uint8_t channel)
+{
+  const int16_t trim = dwellTrims[channel];
+  if(trim > 0) { *pStartAngle = ignitionLimits(*pStartAngle - (int16_t)timeToAngleDegPerMicroSec((uint16_t)trim)); }
+  else if(trim < 0) { *pStartAngle = ignitionLimits(*pStartAngle + (int16_t)timeToAngleDegPerMicroSec((uint16_t)-trim)); }
+}
+
+/** Moves the start angle of each channel by its trim, at the current engine speed. Called after calculateIgnitionAngles() */
+void trimIgnitionStartAngles(void)
+{
+  trimStartAngle(&ignition1StartAngle, IGN1_CMD_BIT);
+  trimStartAngle(&ignition2StartAngle, IGN2_CMD_BIT);
+  trimStartAngle(&ignition3StartAngle, IGN3_CMD_BIT);
+  trimStartAngle(&ignition4StartAngle, IGN4_CMD_BIT);
+#if IGN_CHANNELS >= 5
+  trimStartAngle(&ignition5StartAngle, IGN5_CMD_BIT);
+#endif
+#if IGN_CHANNELS >= 6
+  trimStartAngle(&ignition6StartAngle, IGN6_CMD_BIT);
+#endif
+#if IGN_CHANNELS >= 7
+  trimStartAngle(&ignition7StartAngle, IGN7_CMD_BIT);
+#endif
+#if IGN_CHANNELS >= 8
+  trimStartAngle(&ignition8StartAngle, IGN8_CMD_BIT);
+#endif
+}
+
+/** The trim (uS) of an ignition channel (IGNx_CMD_BIT). Positive when the dwell is being lengthened */
+int16_t getDwellTrim(uint8_t channel)
+{
+  return dwellTrims[channel];
+}
+
+/** The dwell (uS) to schedule on an ignition channel (IGNx_CMD_BIT), which is currentStatus.dwell plus the closed loop trim
+ * and the dwell trim table of that channel */
+uint16_t getTrimmedDwell(uint8_t channel)
+{
+  const int32_t dwell = (int32_t)currentStatus.dwell + dwellTrims[channel] + getIgnitionDwellTrim(channel);
+  return (dwell > 0) ? (uint16_t)dwell : 0U;
+}
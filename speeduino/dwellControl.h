@@ -0,0 +1,26 @@
+/** @file
+ * Closed loop dwell control.
+ * The dwell that a coil actually gets is the time from the start of its schedule to the spark. The start is timed from a
+ * crank angle worked out in the main loop, while the spark can be moved to the latest crank angle (The end angle refresh
+ * and per tooth timing), so any delay in arming or starting the schedule comes off the dwell. At high RPM this delay is
+ * a larger share of the dwell and the coil is under charged.
+ *
+ * With closed loop dwell (configPage15.dwellClosedLoop) the ignition interrupt records the dwell of every spark
+ * (IgnitionSchedule::measuredDwell). After each spark the main loop adds configPage15.dwellTrimGain percent of the error
+ * to a trim for that channel, limited to configPage15.dwellTrimLimit. The trim moves the start of the channel earlier
+ * (Or later) and extends the scheduled dwell by the same time, so a spark that is timed from the start stays where it was.
+ */
+#ifndef DWELL_CONTROL_H
+#define DWELL_CONTROL_H
+
+#include "globals.h"
+
+#define DWELL_ERROR_CHANNELS 4 ///< The number of channels that have a dwell error output channel (currentStatus.dwellError)
+
+void resetDwellTrims(void);
+void updateDwellTrims(uint16_t targetDwell);
+void trimIgnitionStartAngles(void);
+int16_t getDwellTrim(uint8_t channel);
+uint16_t getTrimmedDwell(uint8_t channel);
+
+#endif
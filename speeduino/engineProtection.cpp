@@ -5,6 +5,13 @@
 
 byte oilProtStartTime = 0;
 
+static uint32_t predictLastRevolution = 0; //The revolution count when the last acceleration sample was taken
+static uint16_t predictLastRPM = 0; //The RPM when the last acceleration sample was taken
+static int16_t predictAccel = 0; //The filtered full torque RPM acceleration (RPM/s)
+static bool predictTorqueReduced = false; //Whether a limiter has reduced torque since the last acceleration sample
+
+#define RPM_PREDICT_FILTER  128U //Filter factor for the once per revolution acceleration. 0-255, see LOW_PASS_FILTER
+
 byte checkEngineProtect(void)
 {
   byte protectActive = 0;
@@ -26,10 +33,11 @@ byte checkRevLimit(void)
 
   if (configPage6.engineProtectType != PROTECT_CUT_OFF) 
   {
+    uint16_t limiterRPMdiv100 = div100(getLimiterRPM());
     if(configPage9.hardRevMode == HARD_REV_FIXED)
     {
       currentLimitRPM = configPage4.HardRevLim;
-      if ( (currentStatus.RPMdiv100 >= configPage4.HardRevLim) || ((softLimitTime > configPage4.SoftLimMax) && (currentStatus.RPMdiv100 >= configPage4.SoftRevLim)) )
+      if ( (limiterRPMdiv100 >= configPage4.HardRevLim) || ((softLimitTime > configPage4.SoftLimMax) && (limiterRPMdiv100 >= configPage4.SoftRevLim)) )
       { 
         BIT_SET(currentStatus.status2, BIT_STATUS2_HRDLIM); //Legacy and likely to be removed at some point
         BIT_SET(currentStatus.engineProtectStatus, ENGINE_PROTECT_BIT_RPM);
@@ -39,7 +47,7 @@ byte checkRevLimit(void)
     else if(configPage9.hardRevMode == HARD_REV_COOLANT )
     {
       currentLimitRPM = (int16_t)(table2D_getValue(&coolantProtectTable, currentStatus.coolant + CALIBRATION_TEMPERATURE_OFFSET));
-      if(currentStatus.RPMdiv100 > currentLimitRPM)
+      if(limiterRPMdiv100 > currentLimitRPM)
       {
         BIT_SET(currentStatus.engineProtectStatus, ENGINE_PROTECT_BIT_COOLANT);
         BIT_SET(currentStatus.status2, BIT_STATUS2_HRDLIM); //Legacy and likely to be removed at some point
@@ -221,3 +229,114 @@ byte checkAFRLimit(void)
   return checkAFRLimitActive;
 }
 
+/**
+ * @brief Calculates the rate of change of RPM between 2 samples
+ * 
+ * @param rpm The current RPM
+ * @param lastRPM The RPM at the previous sample
+ * @param sampleTime The time between the 2 samples (uS)
+ * @return int16_t The RPM acceleration in RPM/s
+ */
+int16_t calculateRPMAccel(uint16_t rpm, uint16_t lastRPM, uint32_t sampleTime)
+{
+  //1000000 = 15625 * 64. Working in 64uS units keeps the intermediate value within 32 bits
+  int32_t rpmDelta = clamp((int32_t)rpm - (int32_t)lastRPM, (int32_t)-INT16_MAX, (int32_t)INT16_MAX);
+  int32_t sampleTime64 = (int32_t)max(sampleTime >> 6U, (uint32_t)1U);
+  int32_t rpmAccel = (rpmDelta * 15625L) / sampleTime64;
+
+  return (int16_t)clamp(rpmAccel, (int32_t)-INT16_MAX, (int32_t)INT16_MAX);
+}
+
+/**
+ * @brief Predicts the RPM after the given time, assuming the acceleration remains constant
+ * 
+ * @param rpm The current RPM
+ * @param rpmAccel The current RPM acceleration (RPM/s)
+ * @param cycleTime The time to predict ahead (uS). Normally the time of 1 engine cycle
+ * @return uint16_t The predicted RPM
+ */
+uint16_t predictRPM(uint16_t rpm, int16_t rpmAccel, uint32_t cycleTime)
+{
+  uint16_t cycleTimeMs = (uint16_t)min((uint32_t)(cycleTime / 1000UL), (uint32_t)UINT16_MAX);
+  int32_t predicted = (int32_t)rpm + (((int32_t)rpmAccel * (int32_t)cycleTimeMs) / 1000L);
+
+  return (uint16_t)clamp(predicted, (int32_t)0, (int32_t)UINT16_MAX);
+}
+
+/**
+ * @brief Calculates how much of the engine torque must be removed (Via cut or retard) to stop the RPM passing the limit
+ * 
+ * When the RPM is predicted to pass the limit within the next cycle, the portion of the predicted rise that is above the limit
+ * is used as the amount to remove. Eg If the RPM is 100 below the limit and predicted to rise by 200, then 50% must be removed.
+ * 
+ * @param rpm The current RPM
+ * @param predictedRPM The RPM predicted 1 engine cycle ahead
+ * @param rpmLimit The RPM limit
+ * @return uint8_t Percentage (0-100) of torque to remove. Always 100 once the current RPM reaches the limit
+ */
+uint8_t predictiveLimitPercent(uint16_t rpm, uint16_t predictedRPM, uint16_t rpmLimit)
+{
+  uint8_t limitPercent;
+  if(rpm >= rpmLimit) { limitPercent = 100; }
+  else if(predictedRPM <= rpmLimit) { limitPercent = 0; }
+  else { limitPercent = (uint8_t)( ((uint32_t)(predictedRPM - rpmLimit) * 100UL) / (uint32_t)(predictedRPM - rpm) ); }
+
+  return limitPercent;
+}
+
+/**
+ * @brief Updates the predicted RPM (currentStatus.predictedRPM) used by the rev, launch and flat shift limiters
+ * 
+ * The acceleration is sampled once per revolution and averaged with rpmDOT (Which is only updated at 10Hz). The per revolution sample
+ * responds much faster at high RPM, which is where the limiters operate.
+ * The acceleration is only sampled while the engine is making full torque. Whilst any limiter is cutting or retarding, the last full
+ * torque acceleration is held so that the prediction is of what the engine would do if the limiter released. This is what allows the
+ * proportional cut to settle at the limit rather than oscillate around it.
+ * The RPM is predicted 1 full engine cycle ahead as that is the soonest a cut or retard decided now can take effect on all cylinders.
+ * Must be called after the RPM is updated each loop
+ * 
+ * @param torqueReduced Whether any limiter was cutting or retarding during the last loop
+ */
+void updateRPMPrediction(bool torqueReduced)
+{
+  if( (configPage15.revLimitPredict == false) || (currentStatus.RPM == 0U) )
+  {
+    currentStatus.predictedRPM = currentStatus.RPM;
+    predictLastRevolution = 0;
+    predictAccel = 0;
+    predictTorqueReduced = false;
+    return;
+  }
+
+  if(torqueReduced == true) { predictTorqueReduced = true; }
+
+  if(currentStatus.startRevolutions != predictLastRevolution)
+  {
+    if( (predictLastRevolution != 0U) && (predictTorqueReduced == false) )
+    {
+      uint32_t sampleTime = (currentStatus.startRevolutions - predictLastRevolution) * revolutionTime;
+      int16_t revAccel = calculateRPMAccel(currentStatus.RPM, predictLastRPM, sampleTime);
+      int16_t newAccel = (int16_t)(((int32_t)revAccel + (int32_t)currentStatus.rpmDOT) / 2);
+      predictAccel = LOW_PASS_FILTER(newAccel, RPM_PREDICT_FILTER, predictAccel);
+    }
+    predictLastRevolution = currentStatus.startRevolutions;
+    predictLastRPM = currentStatus.RPM;
+    predictTorqueReduced = torqueReduced;
+  }
+
+  uint32_t cycleTime = revolutionTime;
+  if(configPage2.strokes == FOUR_STROKE) { cycleTime = cycleTime * 2U; }
+  currentStatus.predictedRPM = predictRPM(currentStatus.RPM, predictAccel, cycleTime);
+}
+
+/**
+ * @brief The RPM that the rev, launch and flat shift limiters should compare against
+ * 
+ * @return uint16_t The predicted RPM if the predictive limiter is enabled, otherwise the current RPM
+ */
+uint16_t getLimiterRPM(void)
+{
+  uint16_t limiterRPM = currentStatus.RPM;
+  if(configPage15.revLimitPredict == true) { limiterRPM = currentStatus.predictedRPM; }
+  return limiterRPM;
+}
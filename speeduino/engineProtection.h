@@ -6,4 +6,10 @@ byte checkEngineProtect(void);
 byte checkRevLimit(void);
 byte checkBoostLimit(void);
 byte checkOilPressureLimit(void);
-byte checkAFRLimit(void);
\ No newline at end of file
+byte checkAFRLimit(void);
+
+void updateRPMPrediction(bool torqueReduced);
+uint16_t getLimiterRPM(void);
+uint16_t predictRPM(uint16_t rpm, int16_t rpmAccel, uint32_t cycleTime);
+int16_t calculateRPMAccel(uint16_t rpm, uint16_t lastRPM, uint32_t sampleTime);
+uint8_t predictiveLimitPercent(uint16_t rpm, uint16_t predictedRPM, uint16_t rpmLimit);
\ No newline at end of file
@@ -26,6 +26,8 @@ trimTable3d trim5Table; ///< 6x6 Fuel trim 5 map
 trimTable3d trim6Table; ///< 6x6 Fuel trim 6 map
 trimTable3d trim7Table; ///< 6x6 Fuel trim 7 map
 trimTable3d trim8Table; ///< 6x6 Fuel trim 8 map
+ignTrimTable3d ignTrim1Table; ///< 4x4 Ignition trim 1 map
+byte ignTrimValues[7][IGN_TRIM_CELLS]; ///< 4x4 Ignition trim 2-8 map values, in the order TS sends them. These use the axes of ignTrim1Table
 struct table3d4RpmLoad dwellTable; ///< 4x4 Dwell map
 struct table2D taeTable; ///< 4 bin TPS Acceleration Enrichment map (2D)
 struct table2D maeTable;
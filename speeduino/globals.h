@@ -165,7 +165,7 @@
 #define BIT_STATUS5_SPARK2_ACTIVE  2
 #define BIT_STATUS5_KNOCK_ACTIVE   3
 #define BIT_STATUS5_KNOCK_PULSE    4
-#define BIT_STATUS5_UNUSED6        5
+#define BIT_STATUS5_TABLE_REFRESH  5  //Tables have been changed by committing the table overlay, so TS should reload them
 #define BIT_STATUS5_UNUSED7        6
 #define BIT_STATUS5_UNUSED8        7
 
@@ -313,12 +313,14 @@ static_assert(TOOTH_LOG_SIZE<UINT8_MAX, "Check all uses of TOOTH_LOG_SIZE");
 #define FUEL2_MODE_ADD      2
 #define FUEL2_MODE_CONDITIONAL_SWITCH   3
 #define FUEL2_MODE_INPUT_SWITCH 4
+#define FUEL2_MODE_FLEX_BLEND   5
 
 #define SPARK2_MODE_OFF      0
 #define SPARK2_MODE_MULTIPLY 1
 #define SPARK2_MODE_ADD      2
 #define SPARK2_MODE_CONDITIONAL_SWITCH   3
 #define SPARK2_MODE_INPUT_SWITCH 4
+#define SPARK2_MODE_FLEX_BLEND   5
 
 #define FUEL2_CONDITION_RPM 0
 #define FUEL2_CONDITION_MAP 1
@@ -390,6 +392,9 @@ static_assert(TOOTH_LOG_SIZE<UINT8_MAX, "Check all uses of TOOTH_LOG_SIZE");
 This is so we can use an unsigned byte (0-255) to represent temperature ranges from -40 to 215 */
 #define OFFSET_FUELTRIM 127U ///< The fuel trim tables are offset by 128 to allow for -128 to +128 values
 #define OFFSET_IGNITION 40 ///< Ignition values from the main spark table are offset 40 degrees downwards to allow for negative spark timing
+#define OFFSET_IGNTRIM 128U ///< The ignition trim tables are offset by 128 to allow for negative (Retard) trims
+#define OFFSET_DWELLTRIM 100U ///< The dwell trim tables are a percentage of the dwell, offset by 100 to allow for shorter dwells
+#define IGN_TRIM_CELLS 16U ///< The number of values in each ignition and dwell trim table (4x4)
 
 #define SERIAL_BUFFER_THRESHOLD 32 ///< When the serial buffer is filled to greater than this threshold value, the serial processing operations will be performed more urgently in order to avoid it overflowing. Serial buffer is 64 bytes long, so the threshold is set at half this as a reasonable figure
 
@@ -438,6 +443,11 @@ extern trimTable3d trim6Table; //6x6 Fuel trim 6 map
 extern trimTable3d trim7Table; //6x6 Fuel trim 7 map
 extern trimTable3d trim8Table; //6x6 Fuel trim 8 map
 
+typedef table3d4RpmLoad ignTrimTable3d;
+
+extern ignTrimTable3d ignTrim1Table; //4x4 Ignition trim 1 map
+extern byte ignTrimValues[7][IGN_TRIM_CELLS]; //4x4 Ignition trim 2-8 map values. These use the axes of ignTrim1Table
+
 extern struct table3d4RpmLoad dwellTable; //4x4 Dwell map
 extern struct table2D taeTable; //4 bin TPS Acceleration Enrichment map (2D)
 extern struct table2D maeTable;
@@ -596,6 +606,10 @@ struct statuses {
   byte TPSlast; /**< The previous TPS reading */
   int16_t mapDOT; /**< MAP delta over time. Measures the kpa per second that the MAP is changing. Note that is signed value, because MAPdot can be also negative */
   volatile int rpmDOT; /**< RPM delta over time (RPM increase / s ?) */
+  uint16_t predictedRPM; /**< RPM predicted one engine cycle ahead. Equal to RPM unless the predictive rev limiter is enabled */
+  uint16_t estRPM; /**< RPM from the decoder independent estimator (See rpmEstimator.h). 0 when the estimator is disabled */
+  int16_t estRPMdot; /**< RPM acceleration (RPM/s) between consecutive estimator windows */
+  uint16_t rpmJitter; /**< Tooth to tooth timing jitter, expressed in RPM */
   byte VE;     /**< The current VE value being used in the fuel calculation. Can be the same as VE1 or VE2, or a calculated value of both. */
   byte VE1;    /**< The VE value from fuel table 1 */
   byte VE2;    /**< The VE value from fuel table 2, if in use (and required conditions are met) */
@@ -696,6 +710,16 @@ struct statuses {
   byte outputsStatus;
   byte TS_SD_Status; //TunerStudios SD card status
   byte airConStatus;
+  byte tsCommandStatus; /**< Status of the TunerStudio command button queue. See TS_CMD_STATUS_* in TS_CommandButtonHandler.h */
+  uint16_t firstFireTime; /**< Time (ms) from the first main loop that saw the engine turning on the last start, to the first spark. 0 until the first spark */
+  uint16_t fullSyncTime;  /**< Time (ms) from the first main loop that saw the engine turning on the last start, to full sync. 0 until there is full sync */
+  int16_t dwellError[4]; /**< Target minus measured dwell (uS) of the last spark on ignition channels 1-4, with closed loop dwell. See dwellControl.h */
+  uint16_t schedLateStarts; /**< Late fuel and ignition schedule starts, totalled over the channels in use. See schedule_stats_t in scheduler.h */
+  uint16_t schedTruncated;  /**< Sparks that got less than the scheduled dwell, totalled over the ignition channels in use */
+  uint16_t schedSkipped;    /**< Queued fuel and ignition events whose start had already passed, totalled over the channels in use */
+  uint16_t schedMaxLate;    /**< The longest time (uS) that a fuel or ignition schedule interrupt has run after its compare */
+  byte veLearnStatus;       /**< Status of the VE learning. See VE_LEARN_* in veLearn.h */
+  uint16_t veLearnUpdates;  /**< Number of learned VE cell updates since the learned table was last reset */
 };
 
 /**
@@ -1109,7 +1133,7 @@ struct config9 {
   byte enable_secondarySerial:1;            //enable secondary serial
   byte intcan_available:1;                     //enable internal can module
   byte enable_intcan:1;
-  byte secondarySerialProtocol:4;            //protocol for secondary serial. 0=Generic (Fixed list), 1=Generic (ini based list), 2=CAN, 3=msDroid, 4=Real Dash
+  byte secondarySerialProtocol:4;            //protocol for secondary serial. 0=Generic (Fixed list), 1=Generic (ini based list), 2=CAN, 3=msDroid, 4=Real Dash, 5=TunerStudio, 6=Real Dash CAN frames
   byte unused9_0:1;
 
   byte caninput_sel[16];                    //bit status on/Can/analog_local/digtal_local if input is enabled
@@ -1434,7 +1458,12 @@ Page 15 - second page for VVT and boost control.
 */
 struct config15 {
   byte boostControlEnable : 1; 
-  byte unused15_1 : 7; //7bits unused
+  byte revLimitPredict : 1; ///< Rev/launch limiters act on the RPM predicted one engine cycle ahead rather than the current RPM
+  byte angleArming : 1; ///< The trigger interrupt arms the fuel and ignition schedules from the published start angles (See angleArming.h)
+  byte dwellClosedLoop : 1; ///< Trim the dwell of each ignition channel from its measured dwell (See dwellControl.h)
+  byte ignTrimEnabled : 1; ///< Apply the per channel ignition trim tables (See ignitionTrim.h)
+  byte veLearnEnabled : 1; ///< Learn a corrected VE table from the wideband O2 reading (See veLearn.h)
+  byte unused15_1 : 2; //2bits unused
   byte boostDCWhenDisabled;
   byte boostControlEnableThreshold; //if fixed value enable set threshold here.
   
@@ -1468,9 +1497,33 @@ struct config15 {
 
   int8_t rollingProtRPMDelta[4]; // Signed RPM value representing how much below the RPM limit. Divided by 10
   byte rollingProtCutPercent[4];
+
+  //Bytes 106-107 - Flex fuel table blending (See FUEL2_MODE_FLEX_BLEND & SPARK2_MODE_FLEX_BLEND)
+  byte flexBlendEthLow;  ///< Ethanol % at (or below) which only the primary tables are used
+  byte flexBlendEthHigh; ///< Ethanol % at (or above) which only the secondary tables are used
   
-  //Bytes 106-255
-  byte Unused15_106_255[150];
+  //Bytes 108-109 - Decoder independent RPM estimator (See rpmEstimator.h)
+  byte rpmEstWindow : 3; ///< Window the estimator calculates RPM over. One of the RPM_EST_* values
+  byte rpmEstUnused : 5;
+  byte rpmEstTeeth;      ///< Number of tooth gaps in the RPM_EST_TEETH window
+
+  //Byte 110 - Angle arming
+  byte angleArmWindow;   ///< Degrees before its start that a schedule can be armed by the trigger interrupt
+
+  //Bytes 111-112 - Closed loop dwell
+  byte dwellTrimGain;    ///< Percentage of the dwell error that is added to the trim after each spark
+  byte dwellTrimLimit;   ///< Largest dwell trim (0.1ms)
+
+  //Bytes 113-115 - VE learning
+  byte veLearnGain;      ///< Percentage of the difference to the target VE that a learned cell moves by on each update
+  byte veLearnLimit;     ///< Largest change (%) from the VE table that can be learned
+  byte veLearnSamples;   ///< Full weight samples that a cell needs before it is updated
+
+  //Bytes 116-243 - Dwell trim tables (See ignitionTrim.h). 4x4 values for each ignition channel, using the axes of ignTrim1Table
+  byte dwellTrimValues[8][IGN_TRIM_CELLS]; ///< Percentage of the dwell (Offset by OFFSET_DWELLTRIM) added to the dwell of each channel
+
+  //Bytes 244-255
+  byte Unused15_244_255[12];
 
 #if defined(CORE_AVR)
   };
@@ -6,6 +6,7 @@ A full copy of the license may be found in the projects root directory
 #include "idle.h"
 #include "maths.h"
 #include "timers.h"
+#include "pwmOutputs.h"
 #include "src/PID_v1/PID_v1.h"
 
 #define STEPPER_LESS_AIR_DIRECTION() ((configPage9.iacStepperInv == 0) ? STEPPER_BACKWARD : STEPPER_FORWARD)
@@ -55,13 +56,19 @@ Currently limited to on/off control and open loop PWM and stepper drive
 */
 integerPID idlePID(&currentStatus.longRPM, &idle_pid_target_value, &idle_cl_target_rpm, configPage6.idleKP, configPage6.idleKI, configPage6.idleKD, DIRECT); //This is the PID object if that algorithm is used. Needs to be global as it maintains state outside of each function call
 
+//The PWM interrupt is not needed if the idle output is driven by hardware PWM. See pwmOutputs.h
+static inline void enableIdleTimer(void)
+{
+  if(pwmOutputIsHardware(PWM_OUT_IDLE) == false) { IDLE_TIMER_ENABLE(); }
+}
+
 //Any common functions associated with starting the Idle
 //Typically this is enabling the PWM interrupt
 static inline void enableIdle(void)
 {
   if( (configPage6.iacAlgorithm == IAC_ALGORITHM_PWM_CL) || (configPage6.iacAlgorithm == IAC_ALGORITHM_PWM_OL) || (configPage6.iacAlgorithm == IAC_ALGORITHM_PWM_OLCL) )
   {
-    IDLE_TIMER_ENABLE();
+    enableIdleTimer();
   }
   else if ( (configPage6.iacAlgorithm == IAC_ALGORITHM_STEP_CL) || (configPage6.iacAlgorithm == IAC_ALGORITHM_STEP_OL) || (configPage6.iacAlgorithm == IAC_ALGORITHM_STEP_OLCL) )
   {
@@ -80,6 +87,13 @@ void initialiseIdle(bool forcehoming)
   idle2_pin_port = portOutputRegister(digitalPinToPort(pinIdle2));
   idle2_pin_mask = digitalPinToBitMask(pinIdle2);
 
+  //Hardware PWM can only be used for a single idle output. The 2 output mode needs the 2nd output to be the inverse of the first
+  if( ((configPage6.iacAlgorithm == IAC_ALGORITHM_PWM_OL) || (configPage6.iacAlgorithm == IAC_ALGORITHM_PWM_CL) || (configPage6.iacAlgorithm == IAC_ALGORITHM_PWM_OLCL)) && (configPage6.iacChannels == 0) )
+  {
+    pwmOutputBegin(PWM_OUT_IDLE, pinIdle1, configPage6.idleFreq * 2U, (configPage6.iacPWMdir == 1));
+  }
+  else { pwmOutputEnd(PWM_OUT_IDLE); }
+
   //Initialising comprises of setting the 2D tables with the relevant values from the config pages
   switch(configPage6.iacAlgorithm)
   {
@@ -770,6 +784,7 @@ void idleControl(void)
     {
       BIT_SET(currentStatus.status2, BIT_STATUS2_IDLE); //Turn the idle control flag on
       IDLE_TIMER_DISABLE();
+      pwmOutputWrite(PWM_OUT_IDLE, PWM_DUTY_MAX);
       if (configPage6.iacPWMdir == 0)
       {
         //Normal direction
@@ -790,7 +805,8 @@ void idleControl(void)
     else
     {
       BIT_SET(currentStatus.status2, BIT_STATUS2_IDLE); //Turn the idle control flag on
-      IDLE_TIMER_ENABLE();
+      enableIdleTimer();
+      if(pwmOutputIsHardware(PWM_OUT_IDLE)) { pwmOutputWrite(PWM_OUT_IDLE, udiv_32_16(idle_pwm_target_value * PWM_DUTY_MAX, idle_pwm_max_count)); }
     }
   }
 }
@@ -835,6 +851,7 @@ void disableIdle(void)
         idle_pid_target_value = idleStepper.targetIdleStep<<2;
     }
   }
+  pwmOutputWrite(PWM_OUT_IDLE, 0U);
   BIT_CLEAR(currentStatus.status2, BIT_STATUS2_IDLE); //Turn the idle control flag off
   currentStatus.idleLoad = 0;
 }
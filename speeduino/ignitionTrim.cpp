@@ -0,0 +1,117 @@
+/** @file
+ * Per channel ignition trims. See ignitionTrim.h
+ */
+#include "globals.h"
+#include "ignitionTrim.h"
+#include "schedule_calcs.h"
+#include "crankMaths.h"
+#include "table3d.h"
+#include "maths.h"
+
+static int8_t ignitionTrims[IGN_CHANNELS]; ///< Degrees of advance added to each channel
+static int16_t dwellTableTrims[IGN_CHANNELS]; ///< Time (uS) added to the dwell of each channel by the dwell trim tables
+
+/* The value only trims are stored in the order TS sends them (Lowest load row first), while the lookup context from
+ * ignTrim1Table indexes its values in memory order (Highest load row first). Flipping the rows swaps corners A/B with C/D */
+static inline void flipLookupRows(const table3DLookupContext &lookup, table3DLookupContext &tsLookup)
+{
+  const table3d_dim_t rowSize = ignTrimTable3d::value_t::row_size;
+  const table3d_dim_t row = lookup.valueIndex / rowSize;
+  tsLookup.valueIndex = ((rowSize - 2U - row) * rowSize) + (lookup.valueIndex % rowSize);
+  tsLookup.weightA = lookup.weightC;
+  tsLookup.weightB = lookup.weightD;
+  tsLookup.weightC = lookup.weightA;
+  tsLookup.weightD = lookup.weightB;
+}
+
+static inline int8_t getAdvanceTrim(const table3d_value_t *pValues, const table3DLookupContext &tsLookup)
+{
+  return (int8_t)((int16_t)interpolate3DTableValue(tsLookup, ignTrimTable3d::value_t::row_size, pValues) - (int16_t)OFFSET_IGNTRIM);
+}
+
+static inline int16_t getDwellTableTrim(const table3d_value_t *pValues, const table3DLookupContext &tsLookup)
+{
+  const int16_t percent = (int16_t)interpolate3DTableValue(tsLookup, ignTrimTable3d::value_t::row_size, pValues) - (int16_t)OFFSET_DWELLTRIM;
+  const int32_t trim = div100((int32_t)currentStatus.dwell * percent);
+  return (int16_t)constrain(trim, (int32_t)-INT16_MAX, (int32_t)INT16_MAX);
+}
+
+/** Looks up the advance and dwell trims of each ignition channel in use at the current load and RPM.
+ * The axes of ignTrim1Table are searched once and used for every table. Must be called after currentStatus.dwell is set
+ */
+void calculateIgnitionTrims(void)
+{
+  table3DLookupContext lookup;
+  get3DTableLookupContext(&ignTrim1Table, currentStatus.ignLoad, currentStatus.RPM, lookup);
+  table3DLookupContext tsLookup;
+  flipLookupRows(lookup, tsLookup);
+
+  ignitionTrims[IGN1_CMD_BIT] = (int8_t)((int16_t)interpolate3DTableValue(&ignTrim1Table, lookup) - (int16_t)OFFSET_IGNTRIM);
+  dwellTableTrims[IGN1_CMD_BIT] = getDwellTableTrim(configPage15.dwellTrimValues[IGN1_CMD_BIT], tsLookup);
+
+  const uint8_t channels = min(maxIgnOutputs, (uint8_t)IGN_CHANNELS);
+  for(uint8_t channel = IGN2_CMD_BIT; channel < channels; channel++)
+  {
+    ignitionTrims[channel] = getAdvanceTrim(ignTrimValues[channel - 1U], tsLookup);
+    dwellTableTrims[channel] = getDwellTableTrim(configPage15.dwellTrimValues[channel], tsLookup);
+  }
+}
+
+/** Clears the trims. Called whenever the ignition trims are not active */
+void resetIgnitionTrims(void)
+{
+  for(uint8_t channel = 0; channel < IGN_CHANNELS; channel++)
+  {
+    ignitionTrims[channel] = 0;
+    dwellTableTrims[channel] = 0;
+  }
+}
+
+static inline void trimChannelAngles(int *pEndAngle, int *pStartAngle, uint8_t channel)
+{
+  //More advance moves both the spark and the start of the dwell earlier
+  const int8_t trim = ignitionTrims[channel];
+  if(trim != 0)
+  {
+    *pEndAngle = ignitionLimits(*pEndAngle - trim);
+    *pStartAngle = ignitionLimits(*pStartAngle - trim);
+  }
+
+  //More dwell moves only the start of the dwell earlier
+  const int16_t dwellTrim = dwellTableTrims[channel];
+  if(dwellTrim > 0) { *pStartAngle = ignitionLimits(*pStartAngle - (int16_t)timeToAngleDegPerMicroSec((uint16_t)dwellTrim)); }
+  else if(dwellTrim < 0) { *pStartAngle = ignitionLimits(*pStartAngle + (int16_t)timeToAngleDegPerMicroSec((uint16_t)-dwellTrim)); }
+}
+
+/** Moves the end and start angle of each channel by its trims. Called after calculateIgnitionAngles() */
+void trimIgnitionAngles(void)
+{
+  trimChannelAngles(&ignition1EndAngle, &ignition1StartAngle, IGN1_CMD_BIT);
+  trimChannelAngles(&ignition2EndAngle, &ignition2StartAngle, IGN2_CMD_BIT);
+  trimChannelAngles(&ignition3EndAngle, &ignition3StartAngle, IGN3_CMD_BIT);
+  trimChannelAngles(&ignition4EndAngle, &ignition4StartAngle, IGN4_CMD_BIT);
+#if IGN_CHANNELS >= 5
+  trimChannelAngles(&ignition5EndAngle, &ignition5StartAngle, IGN5_CMD_BIT);
+#endif
+#if IGN_CHANNELS >= 6
+  trimChannelAngles(&ignition6EndAngle, &ignition6StartAngle, IGN6_CMD_BIT);
+#endif
+#if IGN_CHANNELS >= 7
+  trimChannelAngles(&ignition7EndAngle, &ignition7StartAngle, IGN7_CMD_BIT);
+#endif
+#if IGN_CHANNELS >= 8
+  trimChannelAngles(&ignition8EndAngle, &ignition8StartAngle, IGN8_CMD_BIT);
+#endif
+}
+
+/** The trim (Degrees of advance) of an ignition channel (IGNx_CMD_BIT) */
+int8_t getIgnitionTrim(uint8_t channel)
+{
+  return ignitionTrims[channel];
+}
+
+/** The dwell trim (uS) of an ignition channel (IGNx_CMD_BIT) from its dwell trim table. Positive when the dwell is lengthened */
+int16_t getIgnitionDwellTrim(uint8_t channel)
+{
+  return dwellTableTrims[channel];
+}
@@ -0,0 +1,26 @@
+/** @file
+ * Per channel ignition trims.
+ * Each ignition channel has a 4x4 advance trim table of degrees added to the advance of that channel, Eg to run
+ * individual cylinders closer to their knock limit, and a 4x4 dwell trim table of the percentage of currentStatus.dwell
+ * added to the dwell of that channel, Eg to make up for coils or wiring that charge slower than the others.
+ *
+ * Only ignTrim1Table is a full table. The advance trims of channels 2-8 (ignTrimValues) and the dwell trims
+ * (configPage15.dwellTrimValues) are values only and use the axes of ignTrim1Table, so the trims for every channel
+ * cost one axis search plus two interpolations per channel.
+ *
+ * The advance trims move the end and start angles that calculateIgnitionAngles() has worked out from
+ * currentStatus.advance. The dwell trims move the start angle earlier (Or later) and are added to the dwell that is
+ * scheduled for the channel (See getTrimmedDwell()).
+ */
+#ifndef IGNITION_TRIM_H
+#define IGNITION_TRIM_H
+
+#include "globals.h"
+
+void calculateIgnitionTrims(void);
+void resetIgnitionTrims(void);
+void trimIgnitionAngles(void);
+int8_t getIgnitionTrim(uint8_t channel);
+int16_t getIgnitionDwellTrim(uint8_t channel);
+
+#endif
@@ -6,11 +6,54 @@
 #include "utilities.h"
 #include BOARD_H 
 
+//Reads a channel's source variable, including the side effects that some channels have when read
+static int32_t readLogChannelSource(const log_channel_t &channel)
+{
+  uint8_t transform = pgm_read_byte(&channel.transform);
+  if(transform == LOG_TRANSFORM_LOOPS)
+  {
+    if(currentStatus.loopsPerSecond > 60000U) { currentStatus.loopsPerSecond = 60000U; }
+  }
+  else if(transform == LOG_TRANSFORM_FREERAM) { currentStatus.freeRAM = freeRam(); }
+  else { /* No side effect */ }
+
+  const volatile void *source = (const volatile void *)pgm_read_ptr(&channel.source);
+  uint8_t sourceType = pgm_read_byte(&channel.sourceType);
+  int32_t value = 0;
+  ATOMIC() //Some of the multi-byte sources are updated by interrupts
+  {
+    switch(sourceType)
+    {
+      case 1: value = *(const volatile uint8_t *)source; break;
+      case (1 | LOG_SOURCE_SIGNED): value = *(const volatile int8_t *)source; break;
+      case 2: value = *(const volatile uint16_t *)source; break;
+      case (2 | LOG_SOURCE_SIGNED): value = *(const volatile int16_t *)source; break;
+      case 4: value = (int32_t)*(const volatile uint32_t *)source; break;
+      case (4 | LOG_SOURCE_SIGNED): value = *(const volatile int32_t *)source; break;
+      default: value = 0; break; //Always 0 (No source)
+    }
+  }
+  return value;
+}
+
+//Reads a channel with the offsets and shifts that TunerStudio expects
+static int32_t readTSLogChannel(const log_channel_t &channel)
+{
+  int32_t value = readLogChannelSource(channel);
+  switch(pgm_read_byte(&channel.transform))
+  {
+    case LOG_TRANSFORM_TEMPERATURE: value = value + CALIBRATION_TEMPERATURE_OFFSET; break;
+    case LOG_TRANSFORM_HALF: value = (uint16_t)value >> 1U; break;
+    case LOG_TRANSFORM_DIV100: value = div100((uint16_t)value); break;
+    default: break;
+  }
+  return value;
+}
+
 /** 
  * Returns a numbered byte-field (partial field in case of multi-byte fields) from "current status" structure in the format expected by TunerStudio
  * Notes on fields:
- * - Numbered field will be fields from @ref currentStatus, but not at all in the internal order of strct (e.g. field RPM value, number 14 will be
- *   2nd field in struct)
+ * - The fields, their order and their format are defined in output_channels.csv. This is the same definition that the ini file is generated from
  * - The fields stored in multi-byte types will be accessed lowbyte and highbyte separately (e.g. PW1 will be broken into numbered byte-fields 75,76)
  * - Values have the value offsets and shifts expected by TunerStudio. They will not all be a 'human readable value'
  * @param byteNum - byte-Field number. This is not the entry number (As some entries have multiple byets), but the byte number that is needed
@@ -18,325 +61,96 @@
  */
 byte getTSLogEntry(uint16_t byteNum)
 {
-  byte statusValue = 0;
+  if(byteNum >= LOG_CHANNEL_BYTES) { return 0; }
 
-  switch(byteNum)
+  const log_channel_t &channel = logChannels[pgm_read_byte(&logChannelBytes[byteNum])];
+  int32_t value = readTSLogChannel(channel);
+  if(byteNum != pgm_read_byte(&channel.offset)) { value = value >> 8U; } //High byte of a 2 byte field
+  return lowByte(value);
+}
+
+static live_snapshot_t liveSnapshot;
+static bool liveSnapshotCurrent = false; ///< Whether the snapshot was taken in this loop
+
+/** 
+ * Reads every output channel into the live snapshot. Each channel is read once, so both bytes of a 2 byte field
+ * always come from the same value
+ */
+void takeLiveSnapshot(void)
+{
+  liveSnapshot.timestamp = micros();
+  currentStatus.status2 ^= (-currentStatus.hasSync ^ currentStatus.status2) & (1U << BIT_STATUS2_SYNC); //Set the sync bit of the Spark variable to match the hasSync variable
+
+  for(uint8_t x = 0; x < LOG_CHANNEL_COUNT; x++)
   {
-    case 0: statusValue = currentStatus.secl; break; //secl is simply a counter that increments each second. Used to track unexpected resets (Which will reset this count to 0)
-    case 1: statusValue = currentStatus.status1; break; //status1 Bitfield
-    case 2: statusValue = currentStatus.engine; break; //Engine Status Bitfield
-    case 3: statusValue = currentStatus.syncLossCounter; break;
-    case 4: statusValue = lowByte(currentStatus.MAP); break; //2 bytes for MAP
-    case 5: statusValue = highByte(currentStatus.MAP); break;
-    case 6: statusValue = lowByte(currentStatus.IAT + CALIBRATION_TEMPERATURE_OFFSET); break; //mat
-    case 7: statusValue = lowByte(currentStatus.coolant + CALIBRATION_TEMPERATURE_OFFSET); break; //Coolant ADC
-    case 8: statusValue = currentStatus.batCorrection; break; //Battery voltage correction (%)
-    case 9: statusValue = currentStatus.battery10; break; //battery voltage
-    case 10: statusValue = currentStatus.O2; break; //O2
-    case 11: statusValue = currentStatus.egoCorrection; break; //Exhaust gas correction (%)
-    case 12: statusValue = currentStatus.iatCorrection; break; //Air temperature Correction (%)
-    case 13: statusValue = currentStatus.wueCorrection; break; //Warmup enrichment (%)
-    case 14: statusValue = lowByte(currentStatus.RPM); break; //rpm HB
-    case 15: statusValue = highByte(currentStatus.RPM); break; //rpm LB
-    case 16: statusValue = lowByte(currentStatus.AEamount >> 1U); break; //TPS acceleration enrichment (%) divided by 2 (Can exceed 255)
-    case 17: statusValue = lowByte(currentStatus.corrections); break; //Total GammaE (%)
-    case 18: statusValue = highByte(currentStatus.corrections); break; //Total GammaE (%)
-    case 19: statusValue = currentStatus.VE1; break; //VE 1 (%)
-    case 20: statusValue = currentStatus.VE2; break; //VE 2 (%)
-    case 21: statusValue = currentStatus.afrTarget; break;
-    case 22: statusValue = lowByte(currentStatus.tpsDOT); break; //TPS DOT
-    case 23: statusValue = highByte(currentStatus.tpsDOT); break; //TPS DOT
-    case 24: statusValue = currentStatus.advance; break;
-    case 25: statusValue = currentStatus.TPS; break; // TPS (0% to 100%)
-    
-    case 26: 
-      if(currentStatus.loopsPerSecond > 60000U) { currentStatus.loopsPerSecond = 60000U;}
-      statusValue = lowByte(currentStatus.loopsPerSecond); 
-      break;
-    case 27: 
-      if(currentStatus.loopsPerSecond > 60000U) { currentStatus.loopsPerSecond = 60000U;}
-      statusValue = highByte(currentStatus.loopsPerSecond); 
-      break;
-    
-    case 28: 
-      currentStatus.freeRAM = freeRam();
-      statusValue = lowByte(currentStatus.freeRAM); //(byte)((currentStatus.loopsPerSecond >> 8) & 0xFF);
-      break; 
-    case 29: 
-      currentStatus.freeRAM = freeRam();
-      statusValue = highByte(currentStatus.freeRAM); 
-      break;
-
-    case 30: statusValue = lowByte(currentStatus.boostTarget >> 1U); break; //Divide boost target by 2 to fit in a byte
-    case 31: statusValue = lowByte(div100(currentStatus.boostDuty)); break;
-    case 32: statusValue = currentStatus.status2; break; //Spark related bitfield
-
-    //rpmDOT must be sent as a signed integer
-    case 33: statusValue = lowByte(currentStatus.rpmDOT); break;
-    case 34: statusValue = highByte(currentStatus.rpmDOT); break;
-
-    case 35: statusValue = currentStatus.ethanolPct; break; //Flex sensor value (or 0 if not used)
-    case 36: statusValue = currentStatus.flexCorrection; break; //Flex fuel correction (% above or below 100)
-    case 37: statusValue = currentStatus.flexIgnCorrection; break; //Ignition correction (Increased degrees of advance) for flex fuel
-
-    case 38: statusValue = currentStatus.idleLoad; break;
-    case 39: statusValue = currentStatus.testOutputs; break;
-
-    case 40: statusValue = currentStatus.O2_2; break; //O2
-    case 41: statusValue = currentStatus.baro; break; //Barometer value
-
-    case 42: statusValue = lowByte(currentStatus.canin[0]); break;
-    case 43: statusValue = highByte(currentStatus.canin[0]); break;
-    case 44: statusValue = lowByte(currentStatus.canin[1]); break;
-    case 45: statusValue = highByte(currentStatus.canin[1]); break;
-    case 46: statusValue = lowByte(currentStatus.canin[2]); break;
-    case 47: statusValue = highByte(currentStatus.canin[2]); break;
-    case 48: statusValue = lowByte(currentStatus.canin[3]); break;
-    case 49: statusValue = highByte(currentStatus.canin[3]); break;
-    case 50: statusValue = lowByte(currentStatus.canin[4]); break;
-    case 51: statusValue = highByte(currentStatus.canin[4]); break;
-    case 52: statusValue = lowByte(currentStatus.canin[5]); break;
-    case 53: statusValue = highByte(currentStatus.canin[5]); break;
-    case 54: statusValue = lowByte(currentStatus.canin[6]); break;
-    case 55: statusValue = highByte(currentStatus.canin[6]); break;
-    case 56: statusValue = lowByte(currentStatus.canin[7]); break;
-    case 57: statusValue = highByte(currentStatus.canin[7]); break;
-    case 58: statusValue = lowByte(currentStatus.canin[8]); break;
-    case 59: statusValue = highByte(currentStatus.canin[8]); break;
-    case 60: statusValue = lowByte(currentStatus.canin[9]); break;
-    case 61: statusValue = highByte(currentStatus.canin[9]); break;
-    case 62: statusValue = lowByte(currentStatus.canin[10]); break;
-    case 63: statusValue = highByte(currentStatus.canin[10]); break;
-    case 64: statusValue = lowByte(currentStatus.canin[11]); break;
-    case 65: statusValue = highByte(currentStatus.canin[11]); break;
-    case 66: statusValue = lowByte(currentStatus.canin[12]); break;
-    case 67: statusValue = highByte(currentStatus.canin[12]); break;
-    case 68: statusValue = lowByte(currentStatus.canin[13]); break;
-    case 69: statusValue = highByte(currentStatus.canin[13]); break;
-    case 70: statusValue = lowByte(currentStatus.canin[14]); break;
-    case 71: statusValue = highByte(currentStatus.canin[14]); break;
-    case 72: statusValue = lowByte(currentStatus.canin[15]); break;
-    case 73: statusValue = highByte(currentStatus.canin[15]); break;
-
-    case 74: statusValue = currentStatus.tpsADC; break;
-    case 75: statusValue = 0U /*getNextError()*/; break;
-
-    case 76: statusValue = lowByte(currentStatus.PW1); break; //Pulsewidth 1 multiplied by 10 in ms. Have to convert from uS to mS.
-    case 77: statusValue = highByte(currentStatus.PW1); break; //Pulsewidth 1 multiplied by 10 in ms. Have to convert from uS to mS.
-    case 78: statusValue = lowByte(currentStatus.PW2); break; //Pulsewidth 2 multiplied by 10 in ms. Have to convert from uS to mS.
-    case 79: statusValue = highByte(currentStatus.PW2); break; //Pulsewidth 2 multiplied by 10 in ms. Have to convert from uS to mS.
-    case 80: statusValue = lowByte(currentStatus.PW3); break; //Pulsewidth 3 multiplied by 10 in ms. Have to convert from uS to mS.
-    case 81: statusValue = highByte(currentStatus.PW3); break; //Pulsewidth 3 multiplied by 10 in ms. Have to convert from uS to mS.
-    case 82: statusValue = lowByte(currentStatus.PW4); break; //Pulsewidth 4 multiplied by 10 in ms. Have to convert from uS to mS.
-    case 83: statusValue = highByte(currentStatus.PW4); break; //Pulsewidth 4 multiplied by 10 in ms. Have to convert from uS to mS.
-
-    case 84: statusValue = currentStatus.status3; break;
-    case 85: statusValue = currentStatus.engineProtectStatus; break;
-    case 86: statusValue = lowByte(currentStatus.fuelLoad); break;
-    case 87: statusValue = highByte(currentStatus.fuelLoad); break;
-    case 88: statusValue = lowByte(currentStatus.ignLoad); break;
-    case 89: statusValue = highByte(currentStatus.ignLoad); break;
-    case 90: statusValue = lowByte(currentStatus.dwell); break;
-    case 91: statusValue = highByte(currentStatus.dwell); break;
-    case 92: statusValue = currentStatus.CLIdleTarget; break;
-    case 93: statusValue = lowByte(currentStatus.mapDOT); break;
-    case 94: statusValue = highByte(currentStatus.mapDOT); break;
-    case 95: statusValue = lowByte(currentStatus.vvt1Angle); break; //2 bytes for vvt1Angle
-    case 96: statusValue = highByte(currentStatus.vvt1Angle); break;
-    case 97: statusValue = currentStatus.vvt1TargetAngle; break;
-    case 98: statusValue = lowByte(currentStatus.vvt1Duty); break;
-    case 99: statusValue = lowByte(currentStatus.flexBoostCorrection); break;
-    case 100: statusValue = highByte(currentStatus.flexBoostCorrection); break;
-    case 101: statusValue = currentStatus.baroCorrection; break;
-    case 102: statusValue = currentStatus.VE; break; //Current VE (%). Can be equal to VE1 or VE2 or a calculated value from both of them
-    case 103: statusValue = currentStatus.ASEValue; break; //Current ASE (%)
-    case 104: statusValue = lowByte(currentStatus.vss); break;
-    case 105: statusValue = highByte(currentStatus.vss); break;
-    case 106: statusValue = currentStatus.gear; break;
-    case 107: statusValue = currentStatus.fuelPressure; break;
-    case 108: statusValue = currentStatus.oilPressure; break;
-    case 109: statusValue = currentStatus.wmiPW; break;
-    case 110: statusValue = currentStatus.status4; break;
-    case 111: statusValue = lowByte(currentStatus.vvt2Angle); break; //2 bytes for vvt2Angle
-    case 112: statusValue = highByte(currentStatus.vvt2Angle); break;
-    case 113: statusValue = currentStatus.vvt2TargetAngle; break;
-    case 114: statusValue = lowByte(currentStatus.vvt2Duty); break;
-    case 115: statusValue = currentStatus.outputsStatus; break;
-    case 116: statusValue = lowByte(currentStatus.fuelTemp + CALIBRATION_TEMPERATURE_OFFSET); break; //Fuel temperature from flex sensor
-    case 117: statusValue = currentStatus.fuelTempCorrection; break; //Fuel temperature Correction (%)
-    case 118: statusValue = currentStatus.advance1; break; //advance 1 (%)
-    case 119: statusValue = currentStatus.advance2; break; //advance 2 (%)
-    case 120: statusValue = currentStatus.TS_SD_Status; break; //SD card status
-    case 121: statusValue = lowByte(currentStatus.EMAP); break; //2 bytes for EMAP
-    case 122: statusValue = highByte(currentStatus.EMAP); break;
-    case 123: statusValue = currentStatus.fanDuty; break;
-    case 124: statusValue = currentStatus.airConStatus; break;
-    case 125: statusValue = lowByte(currentStatus.actualDwell); break;
-    case 126: statusValue = highByte(currentStatus.actualDwell); break;
-    case 127: statusValue = currentStatus.status5; break;
-    case 128: statusValue = currentStatus.knockCount; break;
-    case 129: statusValue = currentStatus.knockRetard; break;
-    default: statusValue = 0; // MISRA check
+    const log_channel_t &channel = logChannels[x];
+    uint8_t size = pgm_read_byte(&channel.size);
+    if(size == 0U) { continue; } //Unused readable log field, which has no bytes in the packet
+
+    int32_t value = readTSLogChannel(channel);
+    uint8_t offset = pgm_read_byte(&channel.offset);
+    liveSnapshot.values[offset] = lowByte(value);
+    if(size == 2U) { liveSnapshot.values[offset + 1U] = highByte(value); }
   }
+  liveSnapshotCurrent = true;
+}
 
-  return statusValue;
+/** 
+ * Marks the live snapshot as out of date. This is called at the start of each main loop, so the first request in a loop
+ * takes a new snapshot and any others in the same loop share it
+ */
+void expireLiveSnapshot(void) { liveSnapshotCurrent = false; }
+
+/** 
+ * Returns the live snapshot, taking it first if it has not been taken in this loop
+ */
+const live_snapshot_t &getLiveSnapshot(void)
+{
+  if(liveSnapshotCurrent == false) { takeLiveSnapshot(); }
+  return liveSnapshot;
+}
+
+/** 
+ * The same as @ref getTSLogEntry, but the byte is read from the live snapshot
+ * @param byteNum - byte-Field number
+ * @return The byte of the snapshot, or 0 if byteNum is past the end of the packet
+ */
+byte getLiveSnapshotEntry(uint16_t byteNum)
+{
+  if(byteNum >= LOG_CHANNEL_BYTES) { return 0; }
+  return getLiveSnapshot().values[byteNum];
 }
 
 /** 
  * Similar to the @ref getTSLogEntry function, however this returns a full, unadjusted (ie human readable) log entry value.
- * See logger.h for the field names and order
+ * See output_channels.csv for the field names and order
  * @param logIndex - The log index required. Note that this is NOT the byte number, but the index in the log
  * @return Raw, unadjusted value of the log entry. No offset or multiply is applied like it is with the TS log
  */
 int16_t getReadableLogEntry(uint16_t logIndex)
 {
-  int16_t statusValue = 0;
-
-  switch(logIndex)
-  {
-    case 0: statusValue = currentStatus.secl; break; //secl is simply a counter that increments each second. Used to track unexpected resets (Which will reset this count to 0)
-    case 1: statusValue = currentStatus.status1; break; //status1 Bitfield
-    case 2: statusValue = currentStatus.engine; break; //Engine Status Bitfield
-    case 3: statusValue = currentStatus.syncLossCounter; break;
-    case 4: statusValue = currentStatus.MAP; break; //2 bytes for MAP
-    case 5: statusValue = currentStatus.IAT; break; //mat
-    case 6: statusValue = currentStatus.coolant; break; //Coolant ADC
-    case 7: statusValue = currentStatus.batCorrection; break; //Battery voltage correction (%)
-    case 8: statusValue = currentStatus.battery10; break; //battery voltage
-    case 9: statusValue = currentStatus.O2; break; //O2
-    case 10: statusValue = currentStatus.egoCorrection; break; //Exhaust gas correction (%)
-    case 11: statusValue = currentStatus.iatCorrection; break; //Air temperature Correction (%)
-    case 12: statusValue = currentStatus.wueCorrection; break; //Warmup enrichment (%)
-    case 13: statusValue = currentStatus.RPM; break; //rpm HB
-    case 14: statusValue = currentStatus.AEamount; break; //TPS acceleration enrichment (%)
-    case 15: statusValue = currentStatus.corrections; break; //Total GammaE (%)
-    case 16: statusValue = currentStatus.VE1; break; //VE 1 (%)
-    case 17: statusValue = currentStatus.VE2; break; //VE 2 (%)
-    case 18: statusValue = currentStatus.afrTarget; break;
-    case 19: statusValue = currentStatus.tpsDOT; break; //TPS DOT
-    case 20: statusValue = currentStatus.advance; break;
-    case 21: statusValue = currentStatus.TPS; break; // TPS (0% to 100%)
-    
-    case 22: 
-      if(currentStatus.loopsPerSecond > 60000U) { currentStatus.loopsPerSecond = 60000U;}
-      statusValue = currentStatus.loopsPerSecond; 
-      break;
-    
-    case 23: 
-      currentStatus.freeRAM = freeRam();
-      statusValue = currentStatus.freeRAM;
-      break; 
-
-    case 24: statusValue = currentStatus.boostTarget; break;
-    case 25: statusValue = currentStatus.boostDuty; break;
-    case 26: statusValue = currentStatus.status2; break; //Spark related bitfield
-    case 27: statusValue = currentStatus.rpmDOT; break;
-    case 28: statusValue = currentStatus.ethanolPct; break; //Flex sensor value (or 0 if not used)
-    case 29: statusValue = currentStatus.flexCorrection; break; //Flex fuel correction (% above or below 100)
-    case 30: statusValue = currentStatus.flexIgnCorrection; break; //Ignition correction (Increased degrees of advance) for flex fuel
-    case 31: statusValue = currentStatus.idleLoad; break;
-    case 32: statusValue = currentStatus.testOutputs; break;
-    case 33: statusValue = currentStatus.O2_2; break; //O2
-    case 34: statusValue = currentStatus.baro; break; //Barometer value
-
-    case 35: statusValue = currentStatus.canin[0]; break;
-    case 36: statusValue = currentStatus.canin[1]; break;
-    case 37: statusValue = currentStatus.canin[2]; break;
-    case 38: statusValue = currentStatus.canin[3]; break;
-    case 39: statusValue = currentStatus.canin[4]; break;
-    case 40: statusValue = currentStatus.canin[5]; break;
-    case 41: statusValue = currentStatus.canin[6]; break;
-    case 42: statusValue = currentStatus.canin[7]; break;
-    case 43: statusValue = currentStatus.canin[8]; break;
-    case 44: statusValue = currentStatus.canin[9]; break;
-    case 45: statusValue = currentStatus.canin[10]; break;
-    case 46: statusValue = currentStatus.canin[11]; break;
-    case 47: statusValue = currentStatus.canin[12]; break;
-    case 48: statusValue = currentStatus.canin[13]; break;
-    case 49: statusValue = currentStatus.canin[14]; break;
-    case 50: statusValue = currentStatus.canin[15]; break;
-    
-    case 51: statusValue = currentStatus.tpsADC; break;
-    case 52: statusValue = 0U /*getNextError()*/; break;
-
-    case 53: statusValue = currentStatus.PW1; break; //Pulsewidth 1 multiplied by 10 in ms. Have to convert from uS to mS.
-    case 54: statusValue = currentStatus.PW2; break; //Pulsewidth 2 multiplied by 10 in ms. Have to convert from uS to mS.
-    case 55: statusValue = currentStatus.PW3; break; //Pulsewidth 3 multiplied by 10 in ms. Have to convert from uS to mS.
-    case 56: statusValue = currentStatus.PW4; break; //Pulsewidth 4 multiplied by 10 in ms. Have to convert from uS to mS.
-  
-    case 57: statusValue = currentStatus.status3; break;
-    case 58: statusValue = currentStatus.engineProtectStatus; break;
-
-    case 59: break; //UNUSED!!
-
-    case 60: statusValue = currentStatus.fuelLoad; break;
-    case 61: statusValue = currentStatus.ignLoad; break;
-    case 62: statusValue = (int16_t)currentStatus.dwell; break;
-    case 63: statusValue = currentStatus.CLIdleTarget; break;
-    case 64: statusValue = currentStatus.mapDOT; break;
-    case 65: statusValue = currentStatus.vvt1Angle; break;
-    case 66: statusValue = currentStatus.vvt1TargetAngle; break;
-    case 67: statusValue = currentStatus.vvt1Duty; break;
-    case 68: statusValue = currentStatus.flexBoostCorrection; break;
-    case 69: statusValue = currentStatus.baroCorrection; break;
-    case 70: statusValue = currentStatus.VE; break; //Current VE (%). Can be equal to VE1 or VE2 or a calculated value from both of them
-    case 71: statusValue = currentStatus.ASEValue; break; //Current ASE (%)
-    case 72: statusValue = currentStatus.vss; break;
-    case 73: statusValue = currentStatus.gear; break;
-    case 74: statusValue = currentStatus.fuelPressure; break;
-    case 75: statusValue = currentStatus.oilPressure; break;
-    case 76: statusValue = currentStatus.wmiPW; break;
-    case 77: statusValue = currentStatus.status4; break;
-    case 78: statusValue = currentStatus.vvt2Angle; break; //2 bytes for vvt2Angle
-    case 79: statusValue = currentStatus.vvt2TargetAngle; break;
-    case 80: statusValue = currentStatus.vvt2Duty; break;
-    case 81: statusValue = currentStatus.outputsStatus; break;
-    case 82: statusValue = currentStatus.fuelTemp; break; //Fuel temperature from flex sensor
-    case 83: statusValue = currentStatus.fuelTempCorrection; break; //Fuel temperature Correction (%)
-    case 84: statusValue = currentStatus.advance1; break; //advance 1 (%)
-    case 85: statusValue = currentStatus.advance2; break; //advance 2 (%)
-    case 86: statusValue = currentStatus.TS_SD_Status; break; //SD card status
-    case 87: statusValue = currentStatus.EMAP; break;
-    case 88: statusValue = currentStatus.fanDuty; break;
-    case 89: statusValue = currentStatus.airConStatus; break;
-    case 90: statusValue = currentStatus.actualDwell; break;
-    case 91: statusValue = currentStatus.status5; break;
-    case 92: statusValue = currentStatus.knockCount; break;
-    case 93: statusValue = currentStatus.knockRetard; break;
-    default: statusValue = 0; // MISRA check
-  }
-
-  return statusValue;
+  if(logIndex >= LOG_READABLE_FIELDS) { return 0; }
+  return (int16_t)readLogChannelSource(logChannels[logIndex]);
 }
 
 /** 
  * An expansion to the @ref getReadableLogEntry function for systems that have an FPU. It will provide a floating point value for any parameter that this is appropriate for, otherwise will return the result of @ref getReadableLogEntry.
- * See logger.h for the field names and order
+ * See output_channels.csv for the field names and order
  * @param logIndex - The log index required. Note that this is NOT the byte number, but the index in the log
  * @return float value of the requested log entry. 
  */
 #if defined(FPU_MAX_SIZE) && FPU_MAX_SIZE >= 32 //cppcheck-suppress misra-c2012-20.9
 float getReadableFloatLogEntry(uint16_t logIndex)
 {
-  float statusValue = 0.0;
-
-  switch(logIndex)
+  for(uint8_t x = 0; x < LOG_FLOAT_DIVISOR_COUNT; x++)
   {
-    case 8: statusValue = currentStatus.battery10 / 10.0; break; //battery voltage
-    case 9: statusValue = currentStatus.O2 / 10.0; break;
-    case 18: statusValue = currentStatus.afrTarget / 10.0; break;
-    case 21: statusValue = currentStatus.TPS / 2.0; break; // TPS (0% to 100% = 0 to 200)
-    case 33: statusValue = currentStatus.O2_2 / 10.0; break; //O2
-
-    case 53: statusValue = currentStatus.PW1 / 1000.0; break; //Pulsewidth 1 Have to convert from uS to mS.
-    case 54: statusValue = currentStatus.PW2 / 1000.0; break; //Pulsewidth 2 Have to convert from uS to mS.
-    case 55: statusValue = currentStatus.PW3 / 1000.0; break; //Pulsewidth 3 Have to convert from uS to mS.
-    case 56: statusValue = currentStatus.PW4 / 1000.0; break; //Pulsewidth 4 Have to convert from uS to mS.
-
-    default: statusValue = getReadableLogEntry(logIndex); break; //If logIndex value is NOT a float based one, use the regular function
+    if(pgm_read_byte(&logFloatDivisors[x].logIndex) == logIndex)
+    {
+      //The full source value is used, as some (Eg pulse widths) are too large for the 16 bit readable value
+      return (float)(readLogChannelSource(logChannels[logIndex]) / (double)pgm_read_word(&logFloatDivisors[x].divisor));
+    }
   }
-
-  return statusValue;
+  return getReadableLogEntry(logIndex); //If logIndex value is NOT a float based one, use the regular function
 }
 #endif
 
@@ -481,32 +295,16 @@ uint8_t getLegacySecondarySerialLogEntry(uint16_t byteNum)
 }
 
 /** 
- * Searches the log 2 byte array to determine whether a given index is a regular single byte or a 2 byte field
- * Uses a boundless binary search for improved performance, but requires the fsIntIndex to remain in order
+ * Determines whether a given byte of the TunerStudio log is the first byte of a 2 byte field
  * 
  * @param key - Index in the log array to check
  * @return True if the index is a 2 byte log field. False if it is a single byte
  */
 bool is2ByteEntry(uint8_t key)
 {
-  // This array indicates which index values from the log are 2 byte values
-  // This array MUST remain in ascending order
-  // !!!! WARNING: If any value above 255 is required in this array, changes MUST be made to is2ByteEntry() function !!!!
-  static constexpr byte PROGMEM fsIntIndex[] = {4, 14, 17, 22, 26, 28, 33, 42, 44, 46, 48, 50, 52, 54, 56, 58, 60, 62, 64, 66, 68, 70, 72, 76, 78, 80, 82, 86, 88, 90, 93, 95, 99, 104, 111, 121, 125 };
-
-  unsigned int bot = 0U;
-  unsigned int mid = _countof(fsIntIndex);
-  
-  while (mid > 1U)
-  {  
-    if (key >= pgm_read_byte( &fsIntIndex[bot + mid / 2U]) )
-    {
-      bot += mid++ / 2U;
-    }
-    mid /= 2U;
-  }
-
-  return key == pgm_read_byte(&fsIntIndex[bot]);
+  if(key >= LOG_CHANNEL_BYTES) { return false; }
+  const log_channel_t &channel = logChannels[pgm_read_byte(&logChannelBytes[key])];
+  return (pgm_read_byte(&channel.size) == 2U) && (pgm_read_byte(&channel.offset) == key);
 }
 
 void startToothLogger(void)
@@ -534,12 +332,12 @@ void stopToothLogger(void)
 
   //Disconnect the logger interrupts and attach the normal ones
   detachInterrupt( digitalPinToInterrupt(pinTrigger) );
-  attachInterrupt( digitalPinToInterrupt(pinTrigger), triggerHandler, primaryTriggerEdge );
+  attachInterrupt( digitalPinToInterrupt(pinTrigger), primaryTriggerISR, primaryTriggerEdge );
 
   if(VSS_USES_RPM2() != true)
   {
     detachInterrupt( digitalPinToInterrupt(pinTrigger2) );
-    attachInterrupt( digitalPinToInterrupt(pinTrigger2), triggerSecondaryHandler, secondaryTriggerEdge );  
+    attachInterrupt( digitalPinToInterrupt(pinTrigger2), decoderSecondaryISR, secondaryTriggerEdge );  
   }
 }
 
@@ -567,12 +365,12 @@ void stopCompositeLogger(void)
 
   //Disconnect the logger interrupts and attach the normal ones
   detachInterrupt( digitalPinToInterrupt(pinTrigger) );
-  attachInterrupt( digitalPinToInterrupt(pinTrigger), triggerHandler, primaryTriggerEdge );
+  attachInterrupt( digitalPinToInterrupt(pinTrigger), primaryTriggerISR, primaryTriggerEdge );
 
   if( (VSS_USES_RPM2() != true) && (FLEX_USES_RPM2() != true) )
   {
     detachInterrupt( digitalPinToInterrupt(pinTrigger2) );
-    attachInterrupt( digitalPinToInterrupt(pinTrigger2), triggerSecondaryHandler, secondaryTriggerEdge );
+    attachInterrupt( digitalPinToInterrupt(pinTrigger2), decoderSecondaryISR, secondaryTriggerEdge );
   }
 }
 
@@ -597,7 +395,7 @@ void stopCompositeLoggerTertiary(void)
 
   //Disconnect the logger interrupts and attach the normal ones
   detachInterrupt( digitalPinToInterrupt(pinTrigger) );
-  attachInterrupt( digitalPinToInterrupt(pinTrigger), triggerHandler, primaryTriggerEdge );
+  attachInterrupt( digitalPinToInterrupt(pinTrigger), primaryTriggerISR, primaryTriggerEdge );
 
   detachInterrupt( digitalPinToInterrupt(pinTrigger3) );
   attachInterrupt( digitalPinToInterrupt(pinTrigger3), triggerTertiaryHandler, tertiaryTriggerEdge );
@@ -630,7 +428,7 @@ void stopCompositeLoggerCams(void)
   if( (VSS_USES_RPM2() != true) && (FLEX_USES_RPM2() != true) )
   {
     detachInterrupt( digitalPinToInterrupt(pinTrigger2) );
-    attachInterrupt( digitalPinToInterrupt(pinTrigger2), triggerSecondaryHandler, secondaryTriggerEdge );
+    attachInterrupt( digitalPinToInterrupt(pinTrigger2), decoderSecondaryISR, secondaryTriggerEdge );
   }
 
   detachInterrupt( digitalPinToInterrupt(pinTrigger3) );
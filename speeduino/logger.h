@@ -10,13 +10,62 @@
 #define LOGGER_H
 
 #include "globals.h" // Needed for FPU_MAX_SIZE
+#include "logger_channels.h"
 
 #ifndef UNIT_TEST // Scope guard for unit testing
-  #define LOG_ENTRY_SIZE      130 /**< The size of the live data packet. This MUST match ochBlockSize setting in the ini file */
+  #define LOG_ENTRY_SIZE      LOG_CHANNEL_BYTES /**< The size of the live data packet. This is generated with the ochBlockSize setting in the ini file */
 #else
   #define LOG_ENTRY_SIZE      1 /**< The size of the live data packet. This MUST match ochBlockSize setting in the ini file */
 #endif
 
+/*
+The output channels are defined once, in output_channels.csv. output_channels.py generates the channel tables
+(logger_channels.cpp) and the matching [OutputChannels] entries of the ini file from it.
+*/
+#define LOG_SOURCE_SIZE_MASK  0x0F
+#define LOG_SOURCE_SIGNED     0x80
+
+#define LOG_TRANSFORM_NONE        0 ///< The value is sent unchanged
+#define LOG_TRANSFORM_TEMPERATURE 1 ///< CALIBRATION_TEMPERATURE_OFFSET is added so that negative temperatures fit in a byte
+#define LOG_TRANSFORM_HALF        2 ///< The value is halved to fit in a byte
+#define LOG_TRANSFORM_DIV100      3 ///< The value is divided by 100
+#define LOG_TRANSFORM_LOOPS       4 ///< Loops per second, which is limited to 60000 before it is read
+#define LOG_TRANSFORM_FREERAM     5 ///< Free RAM, which is measured before it is read
+
+/** A single output channel */
+struct log_channel_t {
+  const volatile void *source; ///< The variable the channel is read from, or nullptr if it is always 0
+  uint8_t sourceType; ///< Size of the source in bytes, ORed with LOG_SOURCE_SIGNED if it is signed
+  uint8_t transform; ///< One of the LOG_TRANSFORM_ values. Only applies to the TunerStudio packet
+  uint8_t offset; ///< The offset of the channel in the TunerStudio packet
+  uint8_t size; ///< The number of bytes in the TunerStudio packet. 0 for an unused readable log field
+};
+
+/** The divisor that gives the floating point value of a readable log field */
+struct log_float_divisor_t {
+  uint8_t logIndex;
+  uint16_t divisor;
+};
+
+/** The sourceType of a variable. The type is deduced without its volatile qualifier */
+template<typename T> constexpr uint8_t logSourceType(const volatile T &)
+{
+  static_assert((sizeof(T) == 1U) || (sizeof(T) == 2U) || (sizeof(T) == 4U), "Output channel sources must be 1, 2 or 4 bytes");
+  return (uint8_t)(sizeof(T) | ((T(-1) < T(1)) ? LOG_SOURCE_SIGNED : 0U));
+}
+
+#define LOG_CHANNEL(field, transform, offset, size) { &(field), logSourceType(field), (transform), (offset), (size) }
+#define LOG_CHANNEL_ZERO(offset, size) { nullptr, 0U, LOG_TRANSFORM_NONE, (offset), (size) }
+
+extern const log_channel_t logChannels[LOG_CHANNEL_COUNT];
+extern const uint8_t logChannelBytes[LOG_CHANNEL_BYTES]; ///< The channel of each byte of the TunerStudio packet
+#if defined(FPU_MAX_SIZE) && FPU_MAX_SIZE >= 32 //cppcheck-suppress misra-c2012-20.9
+  extern const log_float_divisor_t logFloatDivisors[LOG_FLOAT_DIVISOR_COUNT];
+#endif
+#if defined(SD_LOGGING)
+  extern const char * const logSDHeaders[LOG_SD_FIELDS]; ///< The SD log header names
+#endif
+
 byte getTSLogEntry(uint16_t byteNum);
 int16_t getReadableLogEntry(uint16_t logIndex);
 #if defined(FPU_MAX_SIZE) && FPU_MAX_SIZE >= 32 //cppcheck-suppress misra-c2012-20.9
@@ -25,6 +74,21 @@ int16_t getReadableLogEntry(uint16_t logIndex);
 uint8_t getLegacySecondarySerialLogEntry(uint16_t byteNum);
 bool is2ByteEntry(uint8_t key);
 
+/** 
+ * A copy of the whole TunerStudio packet, taken at one point in the main loop.
+ * Every request in the same loop is served from the same copy, and each multi-byte value in it is read atomically, so a
+ * packet never has some values from before an interrupt and some from after it, or a 2 byte value with a torn high byte.
+ */
+struct live_snapshot_t {
+  uint32_t timestamp; ///< micros() when the snapshot was taken
+  byte values[LOG_CHANNEL_BYTES];
+};
+
+void takeLiveSnapshot(void);
+void expireLiveSnapshot(void);
+const live_snapshot_t &getLiveSnapshot(void);
+byte getLiveSnapshotEntry(uint16_t byteNum);
+
 void startToothLogger(void);
 void stopToothLogger(void);
 
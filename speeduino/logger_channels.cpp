@@ -0,0 +1,329 @@
+// Generated from output_channels.csv by output_channels.py. Do not edit, change the csv file and regenerate
+#include "globals.h"
+#include BOARD_H //Must be before logger.h for SD_LOGGING
+#include "logger.h"
+
+const log_channel_t logChannels[LOG_CHANNEL_COUNT] PROGMEM = {
+  LOG_CHANNEL(currentStatus.secl, LOG_TRANSFORM_NONE, 0, 1), //secl
+  LOG_CHANNEL(currentStatus.status1, LOG_TRANSFORM_NONE, 1, 1), //status1
+  LOG_CHANNEL(currentStatus.engine, LOG_TRANSFORM_NONE, 2, 1), //engine
+  LOG_CHANNEL(currentStatus.syncLossCounter, LOG_TRANSFORM_NONE, 3, 1), //syncLossCounter
+  LOG_CHANNEL(currentStatus.MAP, LOG_TRANSFORM_NONE, 4, 2), //map
+  LOG_CHANNEL(currentStatus.IAT, LOG_TRANSFORM_TEMPERATURE, 6, 1), //iatRaw
+  LOG_CHANNEL(currentStatus.coolant, LOG_TRANSFORM_TEMPERATURE, 7, 1), //coolantRaw
+  LOG_CHANNEL(currentStatus.batCorrection, LOG_TRANSFORM_NONE, 8, 1), //batCorrection
+  LOG_CHANNEL(currentStatus.battery10, LOG_TRANSFORM_NONE, 9, 1), //batteryVoltage
+  LOG_CHANNEL(currentStatus.O2, LOG_TRANSFORM_NONE, 10, 1), //afr
+  LOG_CHANNEL(currentStatus.egoCorrection, LOG_TRANSFORM_NONE, 11, 1), //egoCorrection
+  LOG_CHANNEL(currentStatus.iatCorrection, LOG_TRANSFORM_NONE, 12, 1), //airCorrection
+  LOG_CHANNEL(currentStatus.wueCorrection, LOG_TRANSFORM_NONE, 13, 1), //warmupEnrich
+  LOG_CHANNEL(currentStatus.RPM, LOG_TRANSFORM_NONE, 14, 2), //rpm
+  LOG_CHANNEL(currentStatus.AEamount, LOG_TRANSFORM_HALF, 16, 1), //accelEnrich
+  LOG_CHANNEL(currentStatus.corrections, LOG_TRANSFORM_NONE, 17, 2), //gammaEnrich
+  LOG_CHANNEL(currentStatus.VE1, LOG_TRANSFORM_NONE, 19, 1), //VE1
+  LOG_CHANNEL(currentStatus.VE2, LOG_TRANSFORM_NONE, 20, 1), //VE2
+  LOG_CHANNEL(currentStatus.afrTarget, LOG_TRANSFORM_NONE, 21, 1), //afrTarget
+  LOG_CHANNEL(currentStatus.tpsDOT, LOG_TRANSFORM_NONE, 22, 2), //TPSdot
+  LOG_CHANNEL(currentStatus.advance, LOG_TRANSFORM_NONE, 24, 1), //advance
+  LOG_CHANNEL(currentStatus.TPS, LOG_TRANSFORM_NONE, 25, 1), //tps
+  LOG_CHANNEL(currentStatus.loopsPerSecond, LOG_TRANSFORM_LOOPS, 26, 2), //loopsPerSecond
+  LOG_CHANNEL(currentStatus.freeRAM, LOG_TRANSFORM_FREERAM, 28, 2), //freeRAM
+  LOG_CHANNEL(currentStatus.boostTarget, LOG_TRANSFORM_HALF, 30, 1), //boostTarget
+  LOG_CHANNEL(currentStatus.boostDuty, LOG_TRANSFORM_DIV100, 31, 1), //boostDuty
+  LOG_CHANNEL(currentStatus.status2, LOG_TRANSFORM_NONE, 32, 1), //status2
+  LOG_CHANNEL(currentStatus.rpmDOT, LOG_TRANSFORM_NONE, 33, 2), //rpmDOT
+  LOG_CHANNEL(currentStatus.ethanolPct, LOG_TRANSFORM_NONE, 35, 1), //flex
+  LOG_CHANNEL(currentStatus.flexCorrection, LOG_TRANSFORM_NONE, 36, 1), //flexFuelCor
+  LOG_CHANNEL(currentStatus.flexIgnCorrection, LOG_TRANSFORM_NONE, 37, 1), //flexIgnCor
+  LOG_CHANNEL(currentStatus.idleLoad, LOG_TRANSFORM_NONE, 38, 1), //idleLoad
+  LOG_CHANNEL(currentStatus.testOutputs, LOG_TRANSFORM_NONE, 39, 1), //testoutputs
+  LOG_CHANNEL(currentStatus.O2_2, LOG_TRANSFORM_NONE, 40, 1), //afr2
+  LOG_CHANNEL(currentStatus.baro, LOG_TRANSFORM_NONE, 41, 1), //baro
+  LOG_CHANNEL(currentStatus.canin[0], LOG_TRANSFORM_NONE, 42, 2), //auxin_gauge0
+  LOG_CHANNEL(currentStatus.canin[1], LOG_TRANSFORM_NONE, 44, 2), //auxin_gauge1
+  LOG_CHANNEL(currentStatus.canin[2], LOG_TRANSFORM_NONE, 46, 2), //auxin_gauge2
+  LOG_CHANNEL(currentStatus.canin[3], LOG_TRANSFORM_NONE, 48, 2), //auxin_gauge3
+  LOG_CHANNEL(currentStatus.canin[4], LOG_TRANSFORM_NONE, 50, 2), //auxin_gauge4
+  LOG_CHANNEL(currentStatus.canin[5], LOG_TRANSFORM_NONE, 52, 2), //auxin_gauge5
+  LOG_CHANNEL(currentStatus.canin[6], LOG_TRANSFORM_NONE, 54, 2), //auxin_gauge6
+  LOG_CHANNEL(currentStatus.canin[7], LOG_TRANSFORM_NONE, 56, 2), //auxin_gauge7
+  LOG_CHANNEL(currentStatus.canin[8], LOG_TRANSFORM_NONE, 58, 2), //auxin_gauge8
+  LOG_CHANNEL(currentStatus.canin[9], LOG_TRANSFORM_NONE, 60, 2), //auxin_gauge9
+  LOG_CHANNEL(currentStatus.canin[10], LOG_TRANSFORM_NONE, 62, 2), //auxin_gauge10
+  LOG_CHANNEL(currentStatus.canin[11], LOG_TRANSFORM_NONE, 64, 2), //auxin_gauge11
+  LOG_CHANNEL(currentStatus.canin[12], LOG_TRANSFORM_NONE, 66, 2), //auxin_gauge12
+  LOG_CHANNEL(currentStatus.canin[13], LOG_TRANSFORM_NONE, 68, 2), //auxin_gauge13
+  LOG_CHANNEL(currentStatus.canin[14], LOG_TRANSFORM_NONE, 70, 2), //auxin_gauge14
+  LOG_CHANNEL(currentStatus.canin[15], LOG_TRANSFORM_NONE, 72, 2), //auxin_gauge15
+  LOG_CHANNEL(currentStatus.tpsADC, LOG_TRANSFORM_NONE, 74, 1), //tpsADC
+  LOG_CHANNEL_ZERO(75, 1), //errors
+  LOG_CHANNEL(currentStatus.PW1, LOG_TRANSFORM_NONE, 76, 2), //pulseWidth
+  LOG_CHANNEL(currentStatus.PW2, LOG_TRANSFORM_NONE, 78, 2), //pulseWidth2
+  LOG_CHANNEL(currentStatus.PW3, LOG_TRANSFORM_NONE, 80, 2), //pulseWidth3
+  LOG_CHANNEL(currentStatus.PW4, LOG_TRANSFORM_NONE, 82, 2), //pulseWidth4
+  LOG_CHANNEL(currentStatus.status3, LOG_TRANSFORM_NONE, 84, 1), //status3
+  LOG_CHANNEL(currentStatus.engineProtectStatus, LOG_TRANSFORM_NONE, 85, 1), //engineProtectStatus
+  LOG_CHANNEL_ZERO(86, 0), //Unused
+  LOG_CHANNEL(currentStatus.fuelLoad, LOG_TRANSFORM_NONE, 86, 2), //fuelLoad
+  LOG_CHANNEL(currentStatus.ignLoad, LOG_TRANSFORM_NONE, 88, 2), //ignLoad
+  LOG_CHANNEL(currentStatus.dwell, LOG_TRANSFORM_NONE, 90, 2), //dwell
+  LOG_CHANNEL(currentStatus.CLIdleTarget, LOG_TRANSFORM_NONE, 92, 1), //CLIdleTarget
+  LOG_CHANNEL(currentStatus.mapDOT, LOG_TRANSFORM_NONE, 93, 2), //MAPdot
+  LOG_CHANNEL(currentStatus.vvt1Angle, LOG_TRANSFORM_NONE, 95, 2), //vvt1Angle
+  LOG_CHANNEL(currentStatus.vvt1TargetAngle, LOG_TRANSFORM_NONE, 97, 1), //vvt1Target
+  LOG_CHANNEL(currentStatus.vvt1Duty, LOG_TRANSFORM_NONE, 98, 1), //vvt1Duty
+  LOG_CHANNEL(currentStatus.flexBoostCorrection, LOG_TRANSFORM_NONE, 99, 2), //flexBoostCor
+  LOG_CHANNEL(currentStatus.baroCorrection, LOG_TRANSFORM_NONE, 101, 1), //baroCorrection
+  LOG_CHANNEL(currentStatus.VE, LOG_TRANSFORM_NONE, 102, 1), //veCurr
+  LOG_CHANNEL(currentStatus.ASEValue, LOG_TRANSFORM_NONE, 103, 1), //ASECurr
+  LOG_CHANNEL(currentStatus.vss, LOG_TRANSFORM_NONE, 104, 2), //vss
+  LOG_CHANNEL(currentStatus.gear, LOG_TRANSFORM_NONE, 106, 1), //gear
+  LOG_CHANNEL(currentStatus.fuelPressure, LOG_TRANSFORM_NONE, 107, 1), //fuelPressure
+  LOG_CHANNEL(currentStatus.oilPressure, LOG_TRANSFORM_NONE, 108, 1), //oilPressure
+  LOG_CHANNEL(currentStatus.wmiPW, LOG_TRANSFORM_NONE, 109, 1), //wmiPW
+  LOG_CHANNEL(currentStatus.status4, LOG_TRANSFORM_NONE, 110, 1), //status4
+  LOG_CHANNEL(currentStatus.vvt2Angle, LOG_TRANSFORM_NONE, 111, 2), //vvt2Angle
+  LOG_CHANNEL(currentStatus.vvt2TargetAngle, LOG_TRANSFORM_NONE, 113, 1), //vvt2Target
+  LOG_CHANNEL(currentStatus.vvt2Duty, LOG_TRANSFORM_NONE, 114, 1), //vvt2Duty
+  LOG_CHANNEL(currentStatus.outputsStatus, LOG_TRANSFORM_NONE, 115, 1), //outputsStatus
+  LOG_CHANNEL(currentStatus.fuelTemp, LOG_TRANSFORM_TEMPERATURE, 116, 1), //fuelTempRaw
+  LOG_CHANNEL(currentStatus.fuelTempCorrection, LOG_TRANSFORM_NONE, 117, 1), //fuelTempCor
+  LOG_CHANNEL(currentStatus.advance1, LOG_TRANSFORM_NONE, 118, 1), //advance1
+  LOG_CHANNEL(currentStatus.advance2, LOG_TRANSFORM_NONE, 119, 1), //advance2
+  LOG_CHANNEL(currentStatus.TS_SD_Status, LOG_TRANSFORM_NONE, 120, 1), //sd_status
+  LOG_CHANNEL(currentStatus.EMAP, LOG_TRANSFORM_NONE, 121, 2), //emap
+  LOG_CHANNEL(currentStatus.fanDuty, LOG_TRANSFORM_NONE, 123, 1), //fanDuty
+  LOG_CHANNEL(currentStatus.airConStatus, LOG_TRANSFORM_NONE, 124, 1), //airConStatus
+  LOG_CHANNEL(currentStatus.actualDwell, LOG_TRANSFORM_NONE, 125, 2), //dwellActual
+  LOG_CHANNEL(currentStatus.status5, LOG_TRANSFORM_NONE, 127, 1), //status5
+  LOG_CHANNEL(currentStatus.knockCount, LOG_TRANSFORM_NONE, 128, 1), //knockEventCount
+  LOG_CHANNEL(currentStatus.knockRetard, LOG_TRANSFORM_NONE, 129, 1), //knockCor
+  LOG_CHANNEL(currentStatus.tsCommandStatus, LOG_TRANSFORM_NONE, 130, 1), //tsCommandStatus
+  LOG_CHANNEL(currentStatus.estRPM, LOG_TRANSFORM_NONE, 131, 2), //estRPM
+  LOG_CHANNEL(currentStatus.estRPMdot, LOG_TRANSFORM_NONE, 133, 2), //estRPMdot
+  LOG_CHANNEL(currentStatus.rpmJitter, LOG_TRANSFORM_NONE, 135, 2), //rpmJitter
+  LOG_CHANNEL(currentStatus.firstFireTime, LOG_TRANSFORM_NONE, 137, 2), //timeToFirstFire
+  LOG_CHANNEL(currentStatus.fullSyncTime, LOG_TRANSFORM_NONE, 139, 2), //timeToFullSync
+  LOG_CHANNEL(currentStatus.dwellError[0], LOG_TRANSFORM_NONE, 141, 2), //dwellError1
+  LOG_CHANNEL(currentStatus.dwellError[1], LOG_TRANSFORM_NONE, 143, 2), //dwellError2
+  LOG_CHANNEL(currentStatus.dwellError[2], LOG_TRANSFORM_NONE, 145, 2), //dwellError3
+  LOG_CHANNEL(currentStatus.dwellError[3], LOG_TRANSFORM_NONE, 147, 2), //dwellError4
+  LOG_CHANNEL(currentStatus.schedLateStarts, LOG_TRANSFORM_NONE, 149, 2), //schedLateStarts
+  LOG_CHANNEL(currentStatus.schedTruncated, LOG_TRANSFORM_NONE, 151, 2), //schedTruncated
+  LOG_CHANNEL(currentStatus.schedSkipped, LOG_TRANSFORM_NONE, 153, 2), //schedSkipped
+  LOG_CHANNEL(currentStatus.schedMaxLate, LOG_TRANSFORM_NONE, 155, 2), //schedMaxLate
+  LOG_CHANNEL(currentStatus.veLearnStatus, LOG_TRANSFORM_NONE, 157, 1), //veLearnStatus
+  LOG_CHANNEL(currentStatus.veLearnUpdates, LOG_TRANSFORM_NONE, 158, 2), //veLearnUpdates
+};
+
+const uint8_t logChannelBytes[LOG_CHANNEL_BYTES] PROGMEM = {
+  0, 1, 2, 3, 4, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 13, 14, 15, 15, 16,
+  17, 18, 19, 19, 20, 21, 22, 22, 23, 23, 24, 25, 26, 27, 27, 28, 29, 30, 31, 32,
+  33, 34, 35, 35, 36, 36, 37, 37, 38, 38, 39, 39, 40, 40, 41, 41, 42, 42, 43, 43,
+  44, 44, 45, 45, 46, 46, 47, 47, 48, 48, 49, 49, 50, 50, 51, 52, 53, 53, 54, 54,
+  55, 55, 56, 56, 57, 58, 60, 60, 61, 61, 62, 62, 63, 64, 64, 65, 65, 66, 67, 68,
+  68, 69, 70, 71, 72, 72, 73, 74, 75, 76, 77, 78, 78, 79, 80, 81, 82, 83, 84, 85,
+  86, 87, 87, 88, 89, 90, 90, 91, 92, 93, 94, 95, 95, 96, 96, 97, 97, 98, 98, 99,
+  99, 100, 100, 101, 101, 102, 102, 103, 103, 104, 104, 105, 105, 106, 106, 107, 107, 108, 109, 109,
+};
+
+#if defined(FPU_MAX_SIZE) && FPU_MAX_SIZE >= 32 //cppcheck-suppress misra-c2012-20.9
+const log_float_divisor_t logFloatDivisors[LOG_FLOAT_DIVISOR_COUNT] PROGMEM = {
+  { 8, 10 }, //batteryVoltage
+  { 9, 10 }, //afr
+  { 18, 10 }, //afrTarget
+  { 21, 2 }, //tps
+  { 33, 10 }, //afr2
+  { 53, 1000 }, //pulseWidth
+  { 54, 1000 }, //pulseWidth2
+  { 55, 1000 }, //pulseWidth3
+  { 56, 1000 }, //pulseWidth4
+};
+#endif
+
+#if defined(SD_LOGGING)
+static constexpr char logSDHeader_0[] PROGMEM = "secl";
+static constexpr char logSDHeader_1[] PROGMEM = "status1";
+static constexpr char logSDHeader_2[] PROGMEM = "engine";
+static constexpr char logSDHeader_3[] PROGMEM = "Sync Loss #";
+static constexpr char logSDHeader_4[] PROGMEM = "MAP";
+static constexpr char logSDHeader_5[] PROGMEM = "IAT(C)";
+static constexpr char logSDHeader_6[] PROGMEM = "CLT(C)";
+static constexpr char logSDHeader_7[] PROGMEM = "Battery Correction";
+static constexpr char logSDHeader_8[] PROGMEM = "Battery V";
+static constexpr char logSDHeader_9[] PROGMEM = "AFR";
+static constexpr char logSDHeader_10[] PROGMEM = "EGO Correction";
+static constexpr char logSDHeader_11[] PROGMEM = "IAT Correction";
+static constexpr char logSDHeader_12[] PROGMEM = "WUE Correction";
+static constexpr char logSDHeader_13[] PROGMEM = "RPM";
+static constexpr char logSDHeader_14[] PROGMEM = "Accel. Correction";
+static constexpr char logSDHeader_15[] PROGMEM = "Gamma Correction";
+static constexpr char logSDHeader_16[] PROGMEM = "VE1";
+static constexpr char logSDHeader_17[] PROGMEM = "VE2";
+static constexpr char logSDHeader_18[] PROGMEM = "AFR Target";
+static constexpr char logSDHeader_19[] PROGMEM = "TPSdot";
+static constexpr char logSDHeader_20[] PROGMEM = "Advance Current";
+static constexpr char logSDHeader_21[] PROGMEM = "TPS";
+static constexpr char logSDHeader_22[] PROGMEM = "Loops/S";
+static constexpr char logSDHeader_23[] PROGMEM = "Free RAM";
+static constexpr char logSDHeader_24[] PROGMEM = "Boost Target";
+static constexpr char logSDHeader_25[] PROGMEM = "Boost Duty";
+static constexpr char logSDHeader_26[] PROGMEM = "status2";
+static constexpr char logSDHeader_27[] PROGMEM = "rpmDOT";
+static constexpr char logSDHeader_28[] PROGMEM = "Eth%";
+static constexpr char logSDHeader_29[] PROGMEM = "Flex Fuel Correction";
+static constexpr char logSDHeader_30[] PROGMEM = "Flex Adv Correction";
+static constexpr char logSDHeader_31[] PROGMEM = "IAC Steps/Duty";
+static constexpr char logSDHeader_32[] PROGMEM = "testoutputs";
+static constexpr char logSDHeader_33[] PROGMEM = "AFR2";
+static constexpr char logSDHeader_34[] PROGMEM = "Baro";
+static constexpr char logSDHeader_35[] PROGMEM = "AUX_IN 0";
+static constexpr char logSDHeader_36[] PROGMEM = "AUX_IN 1";
+static constexpr char logSDHeader_37[] PROGMEM = "AUX_IN 2";
+static constexpr char logSDHeader_38[] PROGMEM = "AUX_IN 3";
+static constexpr char logSDHeader_39[] PROGMEM = "AUX_IN 4";
+static constexpr char logSDHeader_40[] PROGMEM = "AUX_IN 5";
+static constexpr char logSDHeader_41[] PROGMEM = "AUX_IN 6";
+static constexpr char logSDHeader_42[] PROGMEM = "AUX_IN 7";
+static constexpr char logSDHeader_43[] PROGMEM = "AUX_IN 8";
+static constexpr char logSDHeader_44[] PROGMEM = "AUX_IN 9";
+static constexpr char logSDHeader_45[] PROGMEM = "AUX_IN 10";
+static constexpr char logSDHeader_46[] PROGMEM = "AUX_IN 11";
+static constexpr char logSDHeader_47[] PROGMEM = "AUX_IN 12";
+static constexpr char logSDHeader_48[] PROGMEM = "AUX_IN 13";
+static constexpr char logSDHeader_49[] PROGMEM = "AUX_IN 14";
+static constexpr char logSDHeader_50[] PROGMEM = "AUX_IN 15";
+static constexpr char logSDHeader_51[] PROGMEM = "TPS ADC";
+static constexpr char logSDHeader_52[] PROGMEM = "Errors";
+static constexpr char logSDHeader_53[] PROGMEM = "PW";
+static constexpr char logSDHeader_54[] PROGMEM = "PW2";
+static constexpr char logSDHeader_55[] PROGMEM = "PW3";
+static constexpr char logSDHeader_56[] PROGMEM = "PW4";
+static constexpr char logSDHeader_57[] PROGMEM = "status3";
+static constexpr char logSDHeader_58[] PROGMEM = "Engine Protect";
+static constexpr char logSDHeader_59[] PROGMEM = "";
+static constexpr char logSDHeader_60[] PROGMEM = "Fuel Load";
+static constexpr char logSDHeader_61[] PROGMEM = "Ign Load";
+static constexpr char logSDHeader_62[] PROGMEM = "Dwell Requested";
+static constexpr char logSDHeader_63[] PROGMEM = "Idle Target (RPM)";
+static constexpr char logSDHeader_64[] PROGMEM = "MAP DOT";
+static constexpr char logSDHeader_65[] PROGMEM = "VVT1 Angle";
+static constexpr char logSDHeader_66[] PROGMEM = "VVT1 Target";
+static constexpr char logSDHeader_67[] PROGMEM = "VVT1 Duty";
+static constexpr char logSDHeader_68[] PROGMEM = "Flex Boost Adj";
+static constexpr char logSDHeader_69[] PROGMEM = "Baro Correction";
+static constexpr char logSDHeader_70[] PROGMEM = "VE Current";
+static constexpr char logSDHeader_71[] PROGMEM = "ASE Correction";
+static constexpr char logSDHeader_72[] PROGMEM = "Vehicle Speed";
+static constexpr char logSDHeader_73[] PROGMEM = "Gear";
+static constexpr char logSDHeader_74[] PROGMEM = "Fuel Pressure";
+static constexpr char logSDHeader_75[] PROGMEM = "Oil Pressure";
+static constexpr char logSDHeader_76[] PROGMEM = "WMI PW";
+static constexpr char logSDHeader_77[] PROGMEM = "status4";
+static constexpr char logSDHeader_78[] PROGMEM = "VVT2 Angle";
+static constexpr char logSDHeader_79[] PROGMEM = "VVT2 Target";
+static constexpr char logSDHeader_80[] PROGMEM = "VVT2 Duty";
+static constexpr char logSDHeader_81[] PROGMEM = "outputs";
+static constexpr char logSDHeader_82[] PROGMEM = "Fuel Temp";
+static constexpr char logSDHeader_83[] PROGMEM = "Fuel Temp Correction";
+static constexpr char logSDHeader_84[] PROGMEM = "Advance 1";
+static constexpr char logSDHeader_85[] PROGMEM = "Advance 2";
+static constexpr char logSDHeader_86[] PROGMEM = "SD Status";
+static constexpr char logSDHeader_87[] PROGMEM = "EMAP";
+static constexpr char logSDHeader_88[] PROGMEM = "Fan Duty";
+static constexpr char logSDHeader_89[] PROGMEM = "AirConStatus";
+static constexpr char logSDHeader_90[] PROGMEM = "Dwell Actual";
+const char * const logSDHeaders[LOG_SD_FIELDS] PROGMEM = {
+  logSDHeader_0,
+  logSDHeader_1,
+  logSDHeader_2,
+  logSDHeader_3,
+  logSDHeader_4,
+  logSDHeader_5,
+  logSDHeader_6,
+  logSDHeader_7,
+  logSDHeader_8,
+  logSDHeader_9,
+  logSDHeader_10,
+  logSDHeader_11,
+  logSDHeader_12,
+  logSDHeader_13,
+  logSDHeader_14,
+  logSDHeader_15,
+  logSDHeader_16,
+  logSDHeader_17,
+  logSDHeader_18,
+  logSDHeader_19,
+  logSDHeader_20,
+  logSDHeader_21,
+  logSDHeader_22,
+  logSDHeader_23,
+  logSDHeader_24,
+  logSDHeader_25,
+  logSDHeader_26,
+  logSDHeader_27,
+  logSDHeader_28,
+  logSDHeader_29,
+  logSDHeader_30,
+  logSDHeader_31,
+  logSDHeader_32,
+  logSDHeader_33,
+  logSDHeader_34,
+  logSDHeader_35,
+  logSDHeader_36,
+  logSDHeader_37,
+  logSDHeader_38,
+  logSDHeader_39,
+  logSDHeader_40,
+  logSDHeader_41,
+  logSDHeader_42,
+  logSDHeader_43,
+  logSDHeader_44,
+  logSDHeader_45,
+  logSDHeader_46,
+  logSDHeader_47,
+  logSDHeader_48,
+  logSDHeader_49,
+  logSDHeader_50,
+  logSDHeader_51,
+  logSDHeader_52,
+  logSDHeader_53,
+  logSDHeader_54,
+  logSDHeader_55,
+  logSDHeader_56,
+  logSDHeader_57,
+  logSDHeader_58,
+  logSDHeader_59,
+  logSDHeader_60,
+  logSDHeader_61,
+  logSDHeader_62,
+  logSDHeader_63,
+  logSDHeader_64,
+  logSDHeader_65,
+  logSDHeader_66,
+  logSDHeader_67,
+  logSDHeader_68,
+  logSDHeader_69,
+  logSDHeader_70,
+  logSDHeader_71,
+  logSDHeader_72,
+  logSDHeader_73,
+  logSDHeader_74,
+  logSDHeader_75,
+  logSDHeader_76,
+  logSDHeader_77,
+  logSDHeader_78,
+  logSDHeader_79,
+  logSDHeader_80,
+  logSDHeader_81,
+  logSDHeader_82,
+  logSDHeader_83,
+  logSDHeader_84,
+  logSDHeader_85,
+  logSDHeader_86,
+  logSDHeader_87,
+  logSDHeader_88,
+  logSDHeader_89,
+  logSDHeader_90,
+};
+#endif
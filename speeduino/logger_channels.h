@@ -0,0 +1,13 @@
+/** \file logger_channels.h
+ * @brief Sizes of the output channel tables. Generated from output_channels.csv by output_channels.py. Do not edit, change the csv file and regenerate
+ */
+#ifndef LOGGER_CHANNELS_H
+#define LOGGER_CHANNELS_H
+
+#define LOG_CHANNEL_BYTES       160 /**< The size of the TunerStudio realtime data packet (ochBlockSize) */
+#define LOG_CHANNEL_COUNT       110
+#define LOG_READABLE_FIELDS     94 /**< The first channels are the readable log, in order */
+#define LOG_SD_FIELDS           91 /**< The first readable log fields are written to the SD log */
+#define LOG_FLOAT_DIVISOR_COUNT 9
+
+#endif // LOGGER_CHANNELS_H
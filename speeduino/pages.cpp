@@ -2,6 +2,7 @@
 #include "globals.h"
 #include "utilities.h"
 #include "table3d_axis_io.h"
+#include "secondaryTables.h"
 
 // Maps from virtual page "addresses" to addresses/bytes of real in memory entities
 //
@@ -24,7 +25,7 @@
 //  2. Offset to intra-entity byte
 
 // Page sizes as defined in the .ini file
-constexpr const uint16_t PROGMEM ini_page_sizes[] = { 0, 128, 288, 288, 128, 288, 128, 240, 384, 192, 192, 288, 192, 128, 288, 256 };
+constexpr const uint16_t PROGMEM ini_page_sizes[] = { 0, 128, 288, 288, 128, 288, 128, 240, 384, 192, 192, 288, 192, 128, 288, 392 };
 
 // ========================= Table size calculations =========================
 // Note that these should be computed at compile time, assuming the correct
@@ -400,11 +401,13 @@ page_iterator_t map_page_offset_to_entity(uint8_t pageNumber, uint16_t offset)
       END_OF_PAGE(progOutsPage, 1)
     }
 
-    case boostvvtPage2: //Boost, VVT and staging maps (all 8x8)
+    case boostvvtPage2: //Boost duty lookup map (8x8), page 15 settings (Including the dwell trim values), ignition trim map 1 (4x4) and the values of ignition trim maps 2-8
     {
       CHECK_TABLE(boostvvtPage2, offset, &boostTableLookupDuty, 0)
       CHECK_RAW(boostvvtPage2, offset, &configPage15, sizeof(configPage15), 1)
-      END_OF_PAGE(boostvvtPage2, 2)
+      CHECK_TABLE(boostvvtPage2, offset, &ignTrim1Table, 2)
+      CHECK_RAW(boostvvtPage2, offset, ignTrimValues, sizeof(ignTrimValues), 3)
+      END_OF_PAGE(boostvvtPage2, 4)
     }
 
     default:
@@ -431,6 +434,9 @@ void setPageValue(byte pageNum, uint16_t offset, byte value)
   page_iterator_t entity = map_page_offset_to_entity(pageNum, offset);
 
   set_value(entity, value, offset);
+
+  //Flex blend mode needs to know whether the primary and secondary tables still have the same axes
+  if( (pageNum == veMapPage) || (pageNum == fuelMap2Page) || (pageNum == ignMapPage) || (pageNum == ignMap2Page) ) { invalidateSecondaryTableAxes(); }
 }
 
 byte getPageValue(byte pageNum, uint16_t offset)
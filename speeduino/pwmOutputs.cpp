@@ -0,0 +1,65 @@
+/** @file
+ * Hardware PWM for the auxiliary PWM outputs. See pwmOutputs.h
+ */
+#include "globals.h"
+#include "pwmOutputs.h"
+
+#if defined(PWM_HARDWARE_AVAILABLE)
+  static const pwm_backend_t boardPWMBackend = { boardPWMBegin, boardPWMWrite, boardPWMEnd };
+  const pwm_backend_t *pwmBackend = &boardPWMBackend;
+#else
+  const pwm_backend_t *pwmBackend = nullptr;
+#endif
+
+uint8_t pwmHardwareOutputs = 0;
+static uint8_t pwmInvertedOutputs = 0;
+static uint8_t pwmOutputPins[PWM_OUT_COUNT];
+
+/**
+ * @brief Attempts to drive an output with hardware PWM
+ *
+ * @param output One of the PWM_OUT_* outputs
+ * @param pin The output pin
+ * @param frequency PWM frequency in Hz
+ * @param inverted Whether the output is low for the duty cycle rather than high
+ * @return true if the output is now driven by hardware PWM. If false the compare interrupt must be used instead
+ */
+bool pwmOutputBegin(uint8_t output, uint8_t pin, uint16_t frequency, bool inverted)
+{
+  pwmOutputEnd(output);
+  if( (output >= PWM_OUT_COUNT) || (pwmBackend == nullptr) || (frequency == 0U) ) { return false; }
+  if(pwmBackend->begin(pin, frequency) == false) { return false; }
+
+  pwmOutputPins[output] = pin;
+  if(inverted == true) { BIT_SET(pwmInvertedOutputs, output); }
+  else { BIT_CLEAR(pwmInvertedOutputs, output); }
+  BIT_SET(pwmHardwareOutputs, output);
+  pwmOutputWrite(output, 0U);
+  return true;
+}
+
+/**
+ * @brief Sets the duty cycle of a hardware PWM output. Does nothing if the output is not driven by hardware PWM
+ *
+ * @param output One of the PWM_OUT_* outputs
+ * @param duty 0 to PWM_DUTY_MAX
+ */
+void pwmOutputWrite(uint8_t output, uint16_t duty)
+{
+  if(pwmOutputIsHardware(output) == false) { return; }
+  if(duty > PWM_DUTY_MAX) { duty = PWM_DUTY_MAX; }
+  if(BIT_CHECK(pwmInvertedOutputs, output)) { duty = PWM_DUTY_MAX - duty; }
+  pwmBackend->write(pwmOutputPins[output], duty);
+}
+
+/**
+ * @brief Stops hardware PWM on an output, if it was in use
+ *
+ * @param output One of the PWM_OUT_* outputs
+ */
+void pwmOutputEnd(uint8_t output)
+{
+  if(pwmOutputIsHardware(output) == false) { return; }
+  pwmBackend->end(pwmOutputPins[output]);
+  BIT_CLEAR(pwmHardwareOutputs, output);
+}
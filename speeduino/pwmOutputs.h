@@ -0,0 +1,42 @@
+/** @file
+ * Hardware PWM for the auxiliary PWM outputs (Boost, VVT, idle and fan).
+ * Where the board has a free hardware PWM channel on the output pin, the output is driven by that channel and the
+ * compare interrupt that would otherwise toggle the pin twice per PWM period is left disabled. Outputs on other pins
+ * fall back to the interrupt method.
+ */
+#ifndef PWM_OUTPUTS_H
+#define PWM_OUTPUTS_H
+
+#include "globals.h"
+
+#define PWM_OUT_BOOST   0U
+#define PWM_OUT_VVT1    1U
+#define PWM_OUT_VVT2    2U ///< Also used by the WMI output
+#define PWM_OUT_IDLE    3U
+#define PWM_OUT_FAN     4U
+#define PWM_OUT_COUNT   5U
+
+#define PWM_DUTY_MAX    10000U ///< Duty cycles are a % * 100, the same as currentStatus.boostDuty
+
+/**
+ * @brief The functions that drive the hardware PWM channels of a board. Duty cycles are 0 to PWM_DUTY_MAX
+ */
+struct pwm_backend_t {
+  bool (*begin)(uint8_t pin, uint16_t frequency); ///< Starts the PWM at 0% duty. Returns false if the pin has no usable hardware channel
+  void (*write)(uint8_t pin, uint16_t duty);      ///< Sets the duty cycle
+  void (*end)(uint8_t pin);                       ///< Stops the PWM and returns the pin to being a normal output
+};
+
+extern const pwm_backend_t *pwmBackend; ///< The hardware PWM functions for this board. nullptr if the board has none
+extern uint8_t pwmHardwareOutputs; ///< Bit per PWM_OUT_* output that is currently driven by hardware PWM
+
+bool pwmOutputBegin(uint8_t output, uint8_t pin, uint16_t frequency, bool inverted);
+void pwmOutputWrite(uint8_t output, uint16_t duty);
+void pwmOutputEnd(uint8_t output);
+
+/**
+ * @brief Whether an output is driven by hardware PWM. If not, its compare interrupt must be used
+ */
+static inline bool pwmOutputIsHardware(uint8_t output) { return BIT_CHECK(pwmHardwareOutputs, output); }
+
+#endif
@@ -0,0 +1,211 @@
+/** @file
+ * Decoder independent RPM estimator. See rpmEstimator.h
+ *
+ * addRPMEstimatorTooth() is called from the primary trigger interrupt and only does additions, with the window results
+ * being handed over to updateRPMEstimator() in the main loop, which does the divisions.
+ */
+#include "globals.h"
+#include "rpmEstimator.h"
+#include "engineProtection.h"
+#include "maths.h"
+
+static uint8_t estWindowType = RPM_EST_OFF;
+static uint8_t estWindowTeeth = 1U;
+
+//Interrupt side state
+static uint32_t estLastToothTime = 0; //Time of the previous tooth. 0 if there has not been one since the reset
+static uint32_t estLastGap = 0; //The gap before the previous tooth. 0 if its angle was not known
+static uint16_t estLastAngle = 0; //The angle of the gap before the previous tooth
+static uint32_t estGapTimes[RPM_EST_MAX_TEETH]; //Sliding window tooth gaps
+static uint16_t estGapAngles[RPM_EST_MAX_TEETH];
+static uint8_t estGapIndex = 0;
+static uint8_t estGapCount = 0;
+static uint32_t estWindowTime = 0; //Running totals of the window currently being filled
+static uint16_t estWindowAngle = 0;
+static uint32_t estJitterSum = 0; //Sum of the differences between consecutive equal angle tooth gaps
+static uint32_t estJitterTime = 0; //Sum of the tooth gaps included in estJitterSum
+
+//The most recently completed window, handed to the main loop
+static volatile bool estWindowReady = false;
+static volatile uint32_t estReadyTime = 0;
+static volatile uint16_t estReadyAngle = 0;
+static volatile uint32_t estReadyEndTime = 0;
+
+//Main loop state
+static uint32_t estLastEndTime = 0;
+
+/**
+ * @brief Converts a crank angle and the time taken to turn through it into RPM
+ *
+ * @param angle Crank degrees
+ * @param time uS
+ * @return uint16_t RPM, saturated at UINT16_MAX
+ */
+uint16_t rpmFromAngleTime(uint16_t angle, uint32_t time)
+{
+  if(time == 0UL) { return 0U; }
+  //RPM = (angle / 360) * (60000000 / time) = (angle * 500000) / (time * 3)
+  uint32_t rpm = UDIV_ROUND_CLOSEST((uint32_t)angle * 500000UL, time * 3UL, uint32_t);
+  return (uint16_t)min(rpm, (uint32_t)UINT16_MAX);
+}
+
+/**
+ * @brief Sets the window type and clears all estimator state and outputs. Called when the triggers are initialised
+ *
+ * @param windowType One of the RPM_EST_* window types
+ * @param windowTeeth Number of tooth gaps in a RPM_EST_TEETH window (1 to RPM_EST_MAX_TEETH)
+ */
+void resetRPMEstimator(uint8_t windowType, uint8_t windowTeeth)
+{
+  estWindowType = (windowType <= RPM_EST_CYCLE) ? windowType : RPM_EST_OFF;
+  estWindowTeeth = clamp(windowTeeth, (uint8_t)1U, (uint8_t)RPM_EST_MAX_TEETH);
+  clearRPMEstimator();
+}
+
+/**
+ * @brief Clears the estimator state and outputs without changing the window. Called when the engine stalls
+ */
+void clearRPMEstimator(void)
+{
+  noInterrupts();
+  estLastToothTime = 0;
+  estLastGap = 0;
+  estLastAngle = 0;
+  estGapIndex = 0;
+  estGapCount = 0;
+  estWindowTime = 0;
+  estWindowAngle = 0;
+  estJitterSum = 0;
+  estJitterTime = 0;
+  estWindowReady = false;
+  interrupts();
+
+  estLastEndTime = 0;
+  currentStatus.estRPM = 0;
+  currentStatus.estRPMdot = 0;
+  currentStatus.rpmJitter = 0;
+}
+
+static inline void publishWindow(uint32_t windowTime, uint16_t windowAngle, uint32_t endTime)
+{
+  estReadyTime = windowTime;
+  estReadyAngle = windowAngle;
+  estReadyEndTime = endTime;
+  estWindowReady = true;
+}
+
+/**
+ * @brief Adds a primary trigger tooth to the estimator. Called from the trigger interrupt
+ *
+ * @param toothTime The time of the tooth (uS)
+ * @param toothAngle The crank angle since the previous tooth. 0 if this is not known, in which case it is inferred from
+ * the gap compared to the previous tooth (Eg the gap over missing teeth).
+ */
+void addRPMEstimatorTooth(uint32_t toothTime, uint16_t toothAngle)
+{
+  if(estWindowType == RPM_EST_OFF) { return; }
+  if(estLastToothTime == 0UL)
+  {
+    estLastToothTime = toothTime;
+    return;
+  }
+
+  uint32_t gap = toothTime - estLastToothTime;
+  estLastToothTime = toothTime;
+
+  if(toothAngle == 0U)
+  {
+    //Unknown angle. Round to a whole number of the previous tooth gaps
+    if( (estLastGap == 0UL) || (estLastAngle == 0U) ) { return; }
+    uint16_t teeth = (uint16_t)UDIV_ROUND_CLOSEST(gap, estLastGap, uint32_t);
+    if(teeth == 0U) { teeth = 1U; }
+    toothAngle = estLastAngle * teeth;
+    estLastGap = 0; //The next tooth cannot infer its angle from this one
+  }
+  else
+  {
+    if( (toothAngle == estLastAngle) && (estLastGap != 0UL) )
+    {
+      estJitterSum += (gap > estLastGap) ? (gap - estLastGap) : (estLastGap - gap);
+      estJitterTime += gap;
+    }
+    estLastGap = gap;
+    estLastAngle = toothAngle;
+  }
+
+  switch(estWindowType)
+  {
+    case RPM_EST_TOOTH:
+      publishWindow(gap, toothAngle, toothTime);
+      break;
+
+    case RPM_EST_TEETH:
+      if(estGapCount == estWindowTeeth)
+      {
+        estWindowTime -= estGapTimes[estGapIndex];
+        estWindowAngle -= estGapAngles[estGapIndex];
+      }
+      else { estGapCount++; }
+      estGapTimes[estGapIndex] = gap;
+      estGapAngles[estGapIndex] = toothAngle;
+      estWindowTime += gap;
+      estWindowAngle += toothAngle;
+      estGapIndex++;
+      if(estGapIndex >= estWindowTeeth) { estGapIndex = 0; }
+      if(estGapCount == estWindowTeeth) { publishWindow(estWindowTime, estWindowAngle, toothTime); }
+      break;
+
+    default: //RPM_EST_REVOLUTION and RPM_EST_CYCLE
+      estWindowTime += gap;
+      estWindowAngle += toothAngle;
+      if(estWindowAngle >= ((estWindowType == RPM_EST_CYCLE) ? 720U : 360U))
+      {
+        publishWindow(estWindowTime, estWindowAngle, toothTime);
+        estWindowTime = 0;
+        estWindowAngle = 0;
+      }
+      break;
+  }
+}
+
+/**
+ * @brief Calculates the estimator outputs (estRPM, estRPMdot and rpmJitter) from the latest completed window. Called from the main loop
+ *
+ * @return true if a new window had completed since the last call
+ */
+bool updateRPMEstimator(void)
+{
+  if(estWindowType == RPM_EST_OFF) { return false; }
+
+  if(estWindowReady == false) { return false; }
+
+  noInterrupts();
+  uint32_t windowTime = estReadyTime;
+  uint16_t windowAngle = estReadyAngle;
+  uint32_t endTime = estReadyEndTime;
+  estWindowReady = false;
+  uint32_t jitterSum = 0;
+  uint32_t jitterTime = 0;
+  if(estJitterTime >= RPM_EST_JITTER_TIME)
+  {
+    jitterSum = estJitterSum;
+    jitterTime = estJitterTime;
+    estJitterSum = 0;
+    estJitterTime = 0;
+  }
+  interrupts();
+
+  uint16_t rpm = rpmFromAngleTime(windowAngle, windowTime);
+  if(estLastEndTime != 0UL) { currentStatus.estRPMdot = calculateRPMAccel(rpm, currentStatus.estRPM, endTime - estLastEndTime); }
+  estLastEndTime = endTime;
+  currentStatus.estRPM = rpm;
+
+  if(jitterTime != 0UL)
+  {
+    //Mean tooth to tooth gap change as a fraction (x1000) of the mean gap, scaled to RPM
+    uint32_t jitterPerMille = min((uint32_t)(jitterSum / (jitterTime / 1000UL)), (uint32_t)UINT16_MAX);
+    currentStatus.rpmJitter = (uint16_t)min((uint32_t)((jitterPerMille * rpm) / 1000UL), (uint32_t)UINT16_MAX);
+  }
+
+  return true;
+}
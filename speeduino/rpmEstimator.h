@@ -0,0 +1,28 @@
+/** @file
+ * Decoder independent RPM estimator.
+ * The estimator is fed with the time and crank angle of each primary trigger tooth and calculates RPM, RPM acceleration
+ * and a tooth timing jitter figure over a selectable window. The results are published as output channels alongside the
+ * decoders own RPM so that the noise of the different windows can be compared.
+ */
+#ifndef RPM_ESTIMATOR_H
+#define RPM_ESTIMATOR_H
+
+#include "globals.h"
+
+//Window types (configPage15.rpmEstWindow)
+#define RPM_EST_OFF         0U ///< Estimator disabled
+#define RPM_EST_TOOTH       1U ///< RPM from each tooth gap
+#define RPM_EST_TEETH       2U ///< RPM from the last configPage15.rpmEstTeeth tooth gaps (Sliding window)
+#define RPM_EST_REVOLUTION  3U ///< RPM from each complete crank revolution (360 degrees)
+#define RPM_EST_CYCLE       4U ///< RPM from each complete engine cycle (720 degrees)
+
+#define RPM_EST_MAX_TEETH   8U ///< The largest number of teeth in a RPM_EST_TEETH window
+#define RPM_EST_JITTER_TIME 100000UL ///< The minimum time (uS) of teeth that the jitter figure is calculated over
+
+void resetRPMEstimator(uint8_t windowType, uint8_t windowTeeth);
+void clearRPMEstimator(void);
+void addRPMEstimatorTooth(uint32_t toothTime, uint16_t toothAngle);
+bool updateRPMEstimator(void);
+uint16_t rpmFromAngleTime(uint16_t angle, uint32_t time);
+
+#endif
@@ -108,10 +108,21 @@ static inline uint32_t calculateIgnitionTimeout(const IgnitionSchedule &schedule
 
 inline void adjustCrankAngle(IgnitionSchedule &schedule, int endAngle, int crankAngle) {
   if( (schedule.Status == RUNNING) ) { 
-    SET_COMPARE(schedule.compare, schedule.counter + uS_TO_TIMER_COMPARE( angleToTimeMicroSecPerDegree( ignitionLimits( (endAngle - crankAngle) ) ) ) ); 
+    refreshIgnitionSchedule(schedule, angleToTimeMicroSecPerDegree( ignitionLimits( (endAngle - crankAngle) ) ) ); 
   }
   else if(currentStatus.startRevolutions > MIN_CYCLES_FOR_ENDCOMPARE) { 
     schedule.endCompare = schedule.counter + uS_TO_TIMER_COMPARE( angleToTimeMicroSecPerDegree( ignitionLimits( (endAngle - crankAngle) ) ) ); 
     schedule.endScheduleSetByDecoder = true; 
   }
+}
+
+/** Brings the end of a running ignition schedule forward to the latest crank angle. This is the main loop refresh (USE_IGN_REFRESH) for
+ * when the decoder is not adjusting the end per tooth. The end is never moved later than the scheduled dwell, so a refresh can't over dwell the coil.
+ * An end angle below the crank angle is in the next cycle, E.g. a spark just after TDC while the crank is just before it
+ */
+inline void refreshIgnitionEndAngle(IgnitionSchedule &schedule, int endAngle, int crankAngle) {
+  if(schedule.Status == RUNNING) {
+    unsigned long timeToEnd = angleToTimeMicroSecPerDegree( (uint16_t)ignitionLimits(endAngle - crankAngle) );
+    if(timeToEnd < schedule.duration) { refreshIgnitionSchedule(schedule, timeToEnd); }
+  }
 }
\ No newline at end of file
@@ -219,13 +219,14 @@ void _setFuelScheduleRunning(FuelSchedule &schedule, unsigned long timeout, unsi
   if (timeout > MAX_TIMER_PERIOD) { timeout_timer_compare = uS_TO_TIMER_COMPARE( (MAX_TIMER_PERIOD - 1) ); } // If the timeout is >4x (Each tick represents 4uS on a mega2560, other boards will be different) the maximum allowed value of unsigned int (65535), the timer compare value will overflow when applied causing erratic behaviour such as erroneous squirts
   else { timeout_timer_compare = uS_TO_TIMER_COMPARE(timeout); } //Normal case
 
-  //The following must be enclosed in the noInterupts block to avoid contention caused if the relevant interrupt fires before the state is fully set
-  noInterrupts();
-  schedule.startCompare = schedule.counter + timeout_timer_compare;
-  schedule.endCompare = schedule.startCompare + uS_TO_TIMER_COMPARE(duration);
-  SET_COMPARE(schedule.compare, schedule.startCompare); //Use the B compare unit of timer 3
-  schedule.Status = PENDING; //Turn this schedule on
-  interrupts();
+  //The following must be enclosed in the atomic block to avoid contention caused if the relevant interrupt fires before the state is fully set
+  ATOMIC() //This can be called from the trigger interrupt (See angleArming.h), so the interrupt state is restored rather than interrupts being turned back on
+  {
+    schedule.startCompare = schedule.counter + timeout_timer_compare;
+    schedule.endCompare = schedule.startCompare + uS_TO_TIMER_COMPARE(duration);
+    SET_COMPARE(schedule.compare, schedule.startCompare); //Use the B compare unit of timer 3
+    schedule.Status = PENDING; //Turn this schedule on
+  }
   schedule.pTimerEnable();
 }
 
@@ -233,7 +234,8 @@ void _setFuelScheduleNext(FuelSchedule &schedule, unsigned long timeout, unsigne
 {
   //If the schedule is already running, we can set the next schedule so it is ready to go
   //This is required in cases of high rpm and high DC where there otherwise would not be enough time to set the schedule
-  schedule.nextStartCompare = schedule.counter + uS_TO_TIMER_COMPARE(timeout);
+  schedule.nextArmCounter = schedule.counter;
+  schedule.nextStartCompare = schedule.nextArmCounter + uS_TO_TIMER_COMPARE(timeout);
   schedule.nextEndCompare = schedule.nextStartCompare + uS_TO_TIMER_COMPARE(duration);
   schedule.hasNextSchedule = true;
 }
@@ -247,12 +249,13 @@ void _setIgnitionScheduleRunning(IgnitionSchedule &schedule, unsigned long timeo
   if (timeout > MAX_TIMER_PERIOD) { timeout_timer_compare = uS_TO_TIMER_COMPARE( (MAX_TIMER_PERIOD - 1) ); } // If the timeout is >4x (Each tick represents 4uS) the maximum allowed value of unsigned int (65535), the timer compare value will overflow when applied causing erratic behaviour such as erroneous sparking.
   else { timeout_timer_compare = uS_TO_TIMER_COMPARE(timeout); } //Normal case
 
-  noInterrupts();
-  schedule.startCompare = schedule.counter + timeout_timer_compare; //As there is a tick every 4uS, there are timeout/4 ticks until the interrupt should be triggered ( >>2 divides by 4)
-  if(schedule.endScheduleSetByDecoder == false) { schedule.endCompare = schedule.startCompare + uS_TO_TIMER_COMPARE(duration); } //The .endCompare value is also set by the per tooth timing in decoders.ino. The check here is so that it's not getting overridden. 
-  SET_COMPARE(schedule.compare, schedule.startCompare);
-  schedule.Status = PENDING; //Turn this schedule on
-  interrupts();
+  ATOMIC() //As for the fuel schedules, this can be called from the trigger interrupt
+  {
+    schedule.startCompare = schedule.counter + timeout_timer_compare; //As there is a tick every 4uS, there are timeout/4 ticks until the interrupt should be triggered ( >>2 divides by 4)
+    if(schedule.endScheduleSetByDecoder == false) { schedule.endCompare = schedule.startCompare + uS_TO_TIMER_COMPARE(duration); } //The .endCompare value is also set by the per tooth timing in decoders.ino. The check here is so that it's not getting overridden. 
+    SET_COMPARE(schedule.compare, schedule.startCompare);
+    schedule.Status = PENDING; //Turn this schedule on
+  }
   schedule.pTimerEnable();
 }
 
@@ -260,22 +263,22 @@ void _setIgnitionScheduleNext(IgnitionSchedule &schedule, unsigned long timeout,
 {
   //If the schedule is already running, we can set the next schedule so it is ready to go
   //This is required in cases of high rpm and high DC where there otherwise would not be enough time to set the schedule
-  schedule.nextStartCompare = schedule.counter + uS_TO_TIMER_COMPARE(timeout);
+  schedule.nextArmCounter = schedule.counter;
+  schedule.nextStartCompare = schedule.nextArmCounter + uS_TO_TIMER_COMPARE(timeout);
   schedule.nextEndCompare = schedule.nextStartCompare + uS_TO_TIMER_COMPARE(duration);
   schedule.hasNextSchedule = true;
 }
 
 
-void refreshIgnitionSchedule1(unsigned long timeToEnd)
+void refreshIgnitionSchedule(IgnitionSchedule &schedule, unsigned long timeToEnd)
 {
-  if( (ignitionSchedule1.Status == RUNNING) && (timeToEnd < ignitionSchedule1.duration) )
   //Must have the threshold check here otherwise it can cause a condition where the compare fires twice, once after the other, both for the end
-  //if( (timeToEnd < ignitionSchedule1.duration) && (timeToEnd > IGNITION_REFRESH_THRESHOLD) )
+  if(timeToEnd <= IGNITION_REFRESH_THRESHOLD) { return; }
+
+  ATOMIC() //This can be called from the decoder interrupt, so the interrupt state is restored rather than interrupts being turned back on
   {
-    noInterrupts();
-    ignitionSchedule1.endCompare = IGN1_COUNTER + uS_TO_TIMER_COMPARE(timeToEnd);
-    SET_COMPARE(IGN1_COMPARE, ignitionSchedule1.endCompare);
-    interrupts();
+    //The status is checked with interrupts off so that the end can't fire between the check and the compare being changed
+    if(schedule.Status == RUNNING) { SET_COMPARE(schedule.compare, schedule.counter + uS_TO_TIMER_COMPARE(timeToEnd)); }
   }
 }
 
@@ -314,13 +317,34 @@ extern void beginInjectorPriming(void)
   }
 }
 
+static inline __attribute__((always_inline)) void countScheduleEvent(volatile uint16_t &count)
+{
+  if(count < UINT16_MAX) { count = count + 1U; }
+}
+
+//Records how late the interrupt is, from the counter and the compare that triggered it. Must be called before the compare is changed
+static inline __attribute__((always_inline)) COMPARE_TYPE recordScheduleLateness(volatile schedule_stats_t &stats, COMPARE_TYPE counter, COMPARE_TYPE compare)
+{
+  const COMPARE_TYPE lateTicks = (COMPARE_TYPE)(counter - compare);
+  if(lateTicks > stats.maxLate) { stats.maxLate = lateTicks; }
+  return lateTicks;
+}
+
+//Whether the start of a queued schedule has already passed, in which case its compare won't be reached until the timer wraps around
+static inline __attribute__((always_inline)) bool queuedStartPassed(COMPARE_TYPE counter, COMPARE_TYPE armCounter, COMPARE_TYPE startCompare)
+{
+  return (COMPARE_TYPE)(counter - armCounter) >= (COMPARE_TYPE)(startCompare - armCounter);
+}
+
 // Shared ISR function for all fuel timers.
 // This is completely inlined into the ISR - there is no function call
 // overhead.
 static inline __attribute__((always_inline)) void fuelScheduleISR(FuelSchedule &schedule)
 {
+  const COMPARE_TYPE lateTicks = recordScheduleLateness(schedule.stats, schedule.counter, schedule.compare);
   if (schedule.Status == PENDING) //Check to see if this schedule is turn on
   {
+    if(lateTicks > uS_TO_TIMER_COMPARE(SCHEDULE_LATE_THRESHOLD)) { countScheduleEvent(schedule.stats.lateStarts); }
     schedule.pStartFunction();
     schedule.Status = RUNNING; //Set the status to be in progress (ie The start callback has been called, but not the end callback)
     SET_COMPARE(schedule.compare, schedule.counter + uS_TO_TIMER_COMPARE(schedule.duration) ); //Doing this here prevents a potential overflow on restarts
@@ -333,6 +357,7 @@ static inline __attribute__((always_inline)) void fuelScheduleISR(FuelSchedule &
       //If there is a next schedule queued up, activate it
       if(schedule.hasNextSchedule == true)
       {
+        if(queuedStartPassed(schedule.counter, schedule.nextArmCounter, schedule.nextStartCompare)) { countScheduleEvent(schedule.stats.skipped); }
         SET_COMPARE(schedule.compare, schedule.nextStartCompare);
         SET_COMPARE(schedule.endCompare, schedule.nextEndCompare);
         schedule.Status = PENDING;
@@ -446,8 +471,10 @@ void fuelSchedule8Interrupt() //Most ARM chips can simply call a function
 // overhead.
 static inline __attribute__((always_inline)) void ignitionScheduleISR(IgnitionSchedule &schedule)
 {
+  const COMPARE_TYPE lateTicks = recordScheduleLateness(schedule.stats, schedule.counter, schedule.compare);
   if (schedule.Status == PENDING) //Check to see if this schedule is turn on
   {
+    if(lateTicks > uS_TO_TIMER_COMPARE(SCHEDULE_LATE_THRESHOLD)) { countScheduleEvent(schedule.stats.lateStarts); }
     schedule.pStartCallback();
     schedule.Status = RUNNING; //Set the status to be in progress (ie The start callback has been called, but not the end callback)
     schedule.startTime = micros();
@@ -460,11 +487,16 @@ static inline __attribute__((always_inline)) void ignitionScheduleISR(IgnitionSc
     schedule.Status = OFF; //Turn off the schedule
     schedule.endScheduleSetByDecoder = false;
     ignitionCount = ignitionCount + 1; //Increment the ignition counter
-    currentStatus.actualDwell = DWELL_AVERAGE( (micros() - schedule.startTime) );
+    const unsigned long measuredDwell = micros() - schedule.startTime;
+    currentStatus.actualDwell = DWELL_AVERAGE(measuredDwell);
+    schedule.measuredDwell = (measuredDwell > UINT16_MAX) ? UINT16_MAX : (uint16_t)measuredDwell;
+    schedule.sparkCount = schedule.sparkCount + 1U;
+    if( ((measuredDwell + SCHEDULE_LATE_THRESHOLD) < schedule.duration) && !BIT_CHECK(currentStatus.engine, BIT_ENGINE_CRANK) ) { countScheduleEvent(schedule.stats.truncated); }
 
     //If there is a next schedule queued up, activate it
     if(schedule.hasNextSchedule == true)
     {
+      if(queuedStartPassed(schedule.counter, schedule.nextArmCounter, schedule.nextStartCompare)) { countScheduleEvent(schedule.stats.skipped); }
       SET_COMPARE(schedule.compare, schedule.nextStartCompare);
       schedule.Status = PENDING;
       schedule.hasNextSchedule = false;
@@ -645,3 +677,138 @@ void disablePendingIgnSchedule(byte channel)
   }
   interrupts();
 }
+
+static volatile schedule_stats_t* fuelScheduleStats(uint8_t channel)
+{
+  switch(channel)
+  {
+    case 0: return &fuelSchedule1.stats;
+    case 1: return &fuelSchedule2.stats;
+    case 2: return &fuelSchedule3.stats;
+    case 3: return &fuelSchedule4.stats;
+#if (INJ_CHANNELS >= 5)
+    case 4: return &fuelSchedule5.stats;
+#endif
+#if (INJ_CHANNELS >= 6)
+    case 5: return &fuelSchedule6.stats;
+#endif
+#if (INJ_CHANNELS >= 7)
+    case 6: return &fuelSchedule7.stats;
+#endif
+#if (INJ_CHANNELS >= 8)
+    case 7: return &fuelSchedule8.stats;
+#endif
+    default: return NULL;
+  }
+}
+
+static volatile schedule_stats_t* ignitionScheduleStats(uint8_t channel)
+{
+  switch(channel)
+  {
+    case 0: return &ignitionSchedule1.stats;
+    case 1: return &ignitionSchedule2.stats;
+    case 2: return &ignitionSchedule3.stats;
+    case 3: return &ignitionSchedule4.stats;
+    case 4: return &ignitionSchedule5.stats;
+#if (IGN_CHANNELS >= 6)
+    case 5: return &ignitionSchedule6.stats;
+#endif
+#if (IGN_CHANNELS >= 7)
+    case 6: return &ignitionSchedule7.stats;
+#endif
+#if (IGN_CHANNELS >= 8)
+    case 7: return &ignitionSchedule8.stats;
+#endif
+    default: return NULL;
+  }
+}
+
+//Copies the counters with interrupts off, as they are updated by the schedule interrupts. The max lateness is converted from timer ticks to uS
+static bool copyScheduleStats(volatile schedule_stats_t *pSource, schedule_stats_t &stats)
+{
+  if(pSource == NULL) { return false; }
+  ATOMIC()
+  {
+    stats.lateStarts = pSource->lateStarts;
+    stats.truncated = pSource->truncated;
+    stats.skipped = pSource->skipped;
+    stats.maxLate = pSource->maxLate;
+  }
+  const uint32_t maxLateMicros = ((uint32_t)stats.maxLate * 1000UL) / uS_TO_TIMER_COMPARE(1000UL);
+  stats.maxLate = (maxLateMicros > UINT16_MAX) ? UINT16_MAX : (COMPARE_TYPE)maxLateMicros;
+  return true;
+}
+
+/** Gets the event counters of a fuel schedule
+ * @param channel The injector channel, starting from 0
+ * @param stats Receives the counters. maxLate is in uS
+ * @return false if there is no such channel on this board
+ */
+bool getFuelScheduleStats(uint8_t channel, schedule_stats_t &stats)
+{
+  return copyScheduleStats(fuelScheduleStats(channel), stats);
+}
+
+/** Gets the event counters of an ignition schedule
+ * @param channel The ignition channel, starting from 0
+ * @param stats Receives the counters. maxLate is in uS
+ * @return false if there is no such channel on this board
+ */
+bool getIgnitionScheduleStats(uint8_t channel, schedule_stats_t &stats)
+{
+  return copyScheduleStats(ignitionScheduleStats(channel), stats);
+}
+
+static void clearScheduleStats(volatile schedule_stats_t *pStats)
+{
+  if(pStats == NULL) { return; }
+  ATOMIC()
+  {
+    pStats->lateStarts = 0;
+    pStats->truncated = 0;
+    pStats->skipped = 0;
+    pStats->maxLate = 0;
+  }
+}
+
+/** Clears the event counters of all the fuel and ignition schedules */
+void resetScheduleStats(void)
+{
+  for(uint8_t channel = 0; channel < INJ_CHANNELS; channel++) { clearScheduleStats(fuelScheduleStats(channel)); }
+  for(uint8_t channel = 0; channel < IGN_CHANNELS; channel++) { clearScheduleStats(ignitionScheduleStats(channel)); }
+}
+
+static inline uint16_t addSaturated(uint16_t total, uint16_t count)
+{
+  return (count > (UINT16_MAX - total)) ? UINT16_MAX : (total + count);
+}
+
+static void addScheduleStats(statuses &current, const schedule_stats_t &stats)
+{
+  current.schedLateStarts = addSaturated(current.schedLateStarts, stats.lateStarts);
+  current.schedTruncated = addSaturated(current.schedTruncated, stats.truncated);
+  current.schedSkipped = addSaturated(current.schedSkipped, stats.skipped);
+  if(stats.maxLate > current.schedMaxLate) { current.schedMaxLate = stats.maxLate; }
+}
+
+/** Totals the event counters of the fuel and ignition channels that are in use into currentStatus, for the output channels.
+ * The counters of each channel are available through getFuelScheduleStats() and getIgnitionScheduleStats()
+ */
+void updateScheduleStatus(void)
+{
+  currentStatus.schedLateStarts = 0;
+  currentStatus.schedTruncated = 0;
+  currentStatus.schedSkipped = 0;
+  currentStatus.schedMaxLate = 0;
+
+  schedule_stats_t stats;
+  for(uint8_t channel = 0; channel < maxInjOutputs; channel++)
+  {
+    if(getFuelScheduleStats(channel, stats)) { addScheduleStats(currentStatus, stats); }
+  }
+  for(uint8_t channel = 0; channel < maxIgnOutputs; channel++)
+  {
+    if(getIgnitionScheduleStats(channel, stats)) { addScheduleStats(currentStatus, stats); }
+  }
+}
@@ -46,6 +46,8 @@ See page 136 of the processors datasheet: http://www.atmel.com/Images/doc2549.pd
 #define USE_IGN_REFRESH
 #define IGNITION_REFRESH_THRESHOLD  30 //Time in uS that the refresh functions will check to ensure there is enough time before changing the end compare
 
+#define SCHEDULE_LATE_THRESHOLD 16 //Time in uS that a schedule interrupt can run after its compare before the event is counted as late (See schedule_stats_t)
+
 #define DWELL_AVERAGE_ALPHA 30
 #define DWELL_AVERAGE(input) LOW_PASS_FILTER((input), DWELL_AVERAGE_ALPHA, currentStatus.actualDwell)
 //#define DWELL_AVERAGE(input) (currentStatus.dwell) //Can be use to disable the above for testing
@@ -56,7 +58,20 @@ void beginInjectorPriming(void);
 void disablePendingFuelSchedule(byte channel);
 void disablePendingIgnSchedule(byte channel);
 
-void refreshIgnitionSchedule1(unsigned long timeToEnd);
+/** Timing diagnostics of a schedule, counted by its interrupt from the timer counter and compare values.
+ * These show when the schedule interrupts are held up, Eg behind a long trigger interrupt, which otherwise only shows as a misfire
+ */
+struct schedule_stats_t {
+  uint16_t lateStarts;  ///< Starts that ran more than SCHEDULE_LATE_THRESHOLD after their compare
+  uint16_t truncated;   ///< Ignition only: Sparks (When not cranking) where the coil was charged for less than the scheduled dwell by more than SCHEDULE_LATE_THRESHOLD. Fuel pulses are timed from their actual start, so can't be cut short
+  uint16_t skipped;     ///< Events that were queued while the schedule was still RUNNING, but whose start had already passed when the running event ended
+  COMPARE_TYPE maxLate; ///< The longest time (Timer ticks) that an interrupt of this schedule has run after its compare. getFuelScheduleStats() and getIgnitionScheduleStats() convert this to uS
+};
+
+bool getFuelScheduleStats(uint8_t channel, schedule_stats_t &stats);
+bool getIgnitionScheduleStats(uint8_t channel, schedule_stats_t &stats);
+void resetScheduleStats(void);
+void updateScheduleStatus(void);
 
 //The ARM cores use separate functions for their ISRs
 #if defined(ARDUINO_ARCH_STM32) || defined(CORE_TEENSY)
@@ -140,6 +155,10 @@ struct IgnitionSchedule {
   COMPARE_TYPE nextEndCompare;        ///< Planned end of next schedule (when current schedule is RUNNING)
   volatile bool hasNextSchedule = false; ///< Enable flag for planned next schedule (when current schedule is RUNNING)
   volatile bool endScheduleSetByDecoder = false;
+  volatile uint16_t measuredDwell = 0; ///< The time (uS) that the coil was charged for on the last spark. Used by the closed loop dwell (See dwellControl.h)
+  volatile uint8_t sparkCount = 0;     ///< Incremented on every spark, so that a new measuredDwell can be told apart from the last one
+  COMPARE_TYPE nextArmCounter;         ///< The counter value when the next schedule was queued. Used to find whether its start has passed
+  volatile schedule_stats_t stats;     ///< Timing diagnostics
 
   counter_t &counter;  // Reference to the counter register. E.g. TCNT3
   compare_t &compare;  // Reference to the compare register. E.g. OCR3A
@@ -160,6 +179,12 @@ inline __attribute__((always_inline)) void setIgnitionSchedule(IgnitionSchedule
   }
 }
 
+/** Moves the end (spark) of a running ignition schedule to timeToEnd uS from now.
+ * Nothing is changed if the schedule is not running, or if timeToEnd is not more than IGNITION_REFRESH_THRESHOLD. 
+ * A compare set that close to the counter could already have been passed by the time it is written, and the end would then not fire until the timer wraps around
+ */
+void refreshIgnitionSchedule(IgnitionSchedule &schedule, unsigned long timeToEnd);
+
 /** Fuel injection schedule.
 * Fuel schedules don't use the callback pointers, or the startTime/endScheduleSetByDecoder variables.
 * They are removed in this struct to save RAM.
@@ -190,6 +215,8 @@ struct FuelSchedule {
   COMPARE_TYPE nextStartCompare;
   COMPARE_TYPE nextEndCompare;
   volatile bool hasNextSchedule = false;
+  COMPARE_TYPE nextArmCounter;       ///< The counter value when the next schedule was queued. Used to find whether its start has passed
+  volatile schedule_stats_t stats;   ///< Timing diagnostics
 
   counter_t &counter;  // Reference to the counter register. E.g. TCNT3
   compare_t &compare;  // Reference to the compare register. E.g. OCR3A
@@ -1,6 +1,57 @@
 #include "globals.h"
 #include "secondaryTables.h"
 #include "corrections.h"
+#include "maths.h"
+
+/**
+ * @brief The proportion of the secondary table to use in flex blend mode, based on the current ethanol content
+ * 
+ * @return uint8_t 0% (Primary table only) to 100% (Secondary table only)
+ */
+static inline uint8_t getFlexBlendPct(void)
+{
+  uint8_t ethanolPct = currentStatus.ethanolPct;
+  if(ethanolPct <= configPage15.flexBlendEthLow) { return 0U; }
+  if(ethanolPct >= configPage15.flexBlendEthHigh) { return 100U; }
+  return ((uint16_t)(ethanolPct - configPage15.flexBlendEthLow) * 100U) / (uint8_t)(configPage15.flexBlendEthHigh - configPage15.flexBlendEthLow);
+}
+
+static inline int16_t blendFlexValues(int16_t primary, int16_t secondary, uint8_t blendPct)
+{
+  return primary + div100((int16_t)((secondary - primary) * (int16_t)blendPct));
+}
+
+static bool axesChecked = false;     ///< Whether fuelAxesShared and sparkAxesShared are up to date with the tables
+static bool fuelAxesShared = false;  ///< fuelTable2 has the same axes as fuelTable
+static bool sparkAxesShared = false; ///< ignitionTable2 has the same axes as ignitionTable
+
+template <class table_t>
+static inline bool hasSameAxes(const table_t &table1, const table_t &table2)
+{
+  return (memcmp(table1.axisX.axis, table2.axisX.axis, sizeof(table1.axisX.axis)) == 0)
+      && (memcmp(table1.axisY.axis, table2.axisY.axis, sizeof(table1.axisY.axis)) == 0);
+}
+
+/**
+ * @brief Flags that the axes of the primary or secondary tables may have changed. Called whenever their pages are written
+ * 
+ * The axes are compared again on the next flex blend lookup, rather than on every byte of a page write
+ */
+void invalidateSecondaryTableAxes(void)
+{
+  axesChecked = false;
+}
+
+//Flex blend mode can only share the axis search of the primary table when the secondary table has the same axes
+static inline void checkSecondaryTableAxes(void)
+{
+  if(axesChecked == false)
+  {
+    fuelAxesShared = hasSameAxes(fuelTable, fuelTable2);
+    sparkAxesShared = hasSameAxes(ignitionTable, ignitionTable2);
+    axesChecked = true;
+  }
+}
 
 void calculateSecondaryFuel(void)
 {
@@ -72,6 +123,22 @@ void calculateSecondaryFuel(void)
         currentStatus.VE = currentStatus.VE2;
       }
     }
+    else if(configPage10.fuel2Mode == FUEL2_MODE_FLEX_BLEND)
+    {
+      //Blend mode looks up both tables at the primary table load and RPM. When the tables have the same axes they share a single axis search,
+      //so the secondary table only costs an extra interpolation. The final VE is then blended between the 2 based on ethanol content
+      BIT_SET(currentStatus.status3, BIT_STATUS3_FUEL2_ACTIVE); //Set the bit indicating that the 2nd fuel table is in use. 
+      currentStatus.fuelLoad2 = currentStatus.fuelLoad;
+      checkSecondaryTableAxes();
+      if(fuelAxesShared == true)
+      {
+        table3DLookupContext lookup;
+        get3DTableLookupContext(&fuelTable, currentStatus.fuelLoad, currentStatus.RPM, lookup);
+        currentStatus.VE2 = interpolate3DTableValue(&fuelTable2, lookup);
+      }
+      else { currentStatus.VE2 = get3DTableValue(&fuelTable2, currentStatus.fuelLoad2, currentStatus.RPM); } //Different axes need their own search
+      currentStatus.VE = (byte)blendFlexValues(currentStatus.VE1, currentStatus.VE2, getFlexBlendPct());
+    }
   }
 }
 
@@ -152,6 +219,33 @@ void calculateSecondarySpark(void)
         currentStatus.advance = currentStatus.advance2;
       }
     }
+    else if(configPage10.spark2Mode == SPARK2_MODE_FLEX_BLEND)
+    {
+      //As per the fuel blend mode, both tables are looked up at the primary table load and RPM, from a single axis search when they have the same axes
+      BIT_SET(currentStatus.status5, BIT_STATUS5_SPARK2_ACTIVE); //Set the bit indicating that the 2nd spark table is in use. 
+      currentStatus.ignLoad2 = currentStatus.ignLoad;
+      checkSecondaryTableAxes();
+      int16_t baseAdvance1;
+      if(sparkAxesShared == true)
+      {
+        table3DLookupContext lookup;
+        get3DTableLookupContext(&ignitionTable, currentStatus.ignLoad, currentStatus.RPM, lookup);
+        baseAdvance1 = (int16_t)interpolate3DTableValue(&ignitionTable, lookup) - OFFSET_IGNITION;
+        currentStatus.advance2 = (int16_t)interpolate3DTableValue(&ignitionTable2, lookup) - OFFSET_IGNITION;
+      }
+      else
+      {
+        baseAdvance1 = (int16_t)get3DTableValue(&ignitionTable, currentStatus.ignLoad, currentStatus.RPM) - OFFSET_IGNITION;
+        currentStatus.advance2 = (int16_t)get3DTableValue(&ignitionTable2, currentStatus.ignLoad2, currentStatus.RPM) - OFFSET_IGNITION;
+      }
+      //advance1 already has the ignition corrections applied. These are offsets from the table value, so blending 
+      //the difference between the tables onto advance1 gives the same result as correcting the blended table value
+      int16_t blendedAdvance = currentStatus.advance1 + blendFlexValues(0, currentStatus.advance2 - baseAdvance1, getFlexBlendPct());
+      //make sure we don't overflow and accidentally set negative timing, currentStatus.advance can only hold a signed 8 bit value
+      if(blendedAdvance > 127) { blendedAdvance = 127; }
+      else if(blendedAdvance < -128) { blendedAdvance = -128; }
+      currentStatus.advance = blendedAdvance;
+    }
 
     //Apply the fixed timing correction manually. This has to be done again here if any of the above conditions are met to prevent any of the seconadary calculations applying instead of fixec timing
     currentStatus.advance = correctionFixedTiming(currentStatus.advance);
@@ -1,4 +1,5 @@
 void calculateSecondaryFuel(void);
 void calculateSecondarySpark(void);
 byte getVE2(void);
-byte getAdvance2(void);
\ No newline at end of file
+byte getAdvance2(void);
+void invalidateSecondaryTableAxes(void);
\ No newline at end of file
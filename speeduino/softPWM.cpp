@@ -0,0 +1,157 @@
+/** @file
+ * Software PWM of several outputs from a single timer compare. See softPWM.h
+ */
+#include "globals.h"
+#include "softPWM.h"
+
+/**
+ * @brief Clears all channels and sets the period. Must only be called while the timer interrupt is disabled
+ *
+ * @param pwm The PWM group
+ * @param period The PWM period in timer ticks
+ * @param reloadTimer Whether the timer only takes up a new interval after the current one has completed
+ */
+void softPWMInit(soft_pwm_t &pwm, uint16_t period, bool reloadTimer)
+{
+  memset(&pwm, 0, sizeof(pwm));
+  pwm.period = period;
+  pwm.reloadTimer = reloadTimer;
+}
+
+/**
+ * @brief Adds an output to the group. It starts at 0% duty
+ *
+ * @return uint8_t The channel number, or SOFT_PWM_NO_CHANNEL if the group is full
+ */
+uint8_t softPWMAddChannel(soft_pwm_t &pwm, volatile PORT_TYPE *port, PINMASK_TYPE mask, bool inverted)
+{
+  if(pwm.channelCount >= SOFT_PWM_MAX_CHANNELS) { return SOFT_PWM_NO_CHANNEL; }
+  uint8_t channel = pwm.channelCount;
+  pwm.channel[channel].port = port;
+  pwm.channel[channel].mask = mask;
+  pwm.channel[channel].inverted = inverted;
+  pwm.onTime[channel] = 0;
+  pwm.channelCount++;
+  return channel;
+}
+
+/**
+ * @brief Sets the on time of a channel. This takes effect from the first period after the next softPWMUpdate()
+ *
+ * @param onTime Timer ticks. 0 is always off, >= the period is always on
+ */
+void softPWMSetOnTime(soft_pwm_t &pwm, uint8_t channel, uint16_t onTime)
+{
+  if(channel >= pwm.channelCount) { return; }
+  if(onTime > pwm.period) { onTime = pwm.period; }
+  if(pwm.onTime[channel] != onTime)
+  {
+    pwm.onTime[channel] = onTime;
+    pwm.changed = true;
+  }
+}
+
+/**
+ * @brief Rebuilds the edge list if any on time has changed and hands it to the interrupt. Called from the main loop
+ */
+void softPWMUpdate(soft_pwm_t &pwm)
+{
+  if(pwm.changed == false) { return; }
+
+  //The interrupt only changes the active list while there is one pending, so the inactive list is safe to rewrite once this is cleared
+  noInterrupts();
+  pwm.pending = false;
+  interrupts();
+
+  soft_pwm_edges_t &edges = pwm.edges[pwm.active ^ 1U];
+  edges.count = 0;
+  edges.onChannels = 0;
+  for(uint8_t channel = 0; channel < pwm.channelCount; channel++)
+  {
+    uint16_t onTime = pwm.onTime[channel];
+    if(onTime == 0U) { continue; }
+    BIT_SET(edges.onChannels, channel);
+    if(onTime >= pwm.period) { continue; } //Always on, no edge
+
+    //Insert in time order, sharing the edge of any other channel with the same on time
+    uint8_t edge = 0;
+    while( (edge < edges.count) && (edges.time[edge] < onTime) ) { edge++; }
+    if( (edge < edges.count) && (edges.time[edge] == onTime) ) { BIT_SET(edges.channels[edge], channel); }
+    else
+    {
+      for(uint8_t later = edges.count; later > edge; later--)
+      {
+        edges.time[later] = edges.time[later - 1U];
+        edges.channels[later] = edges.channels[later - 1U];
+      }
+      edges.time[edge] = onTime;
+      edges.channels[edge] = (uint8_t)(1U << channel);
+      edges.count++;
+    }
+  }
+
+  pwm.changed = false;
+  pwm.pending = true;
+}
+
+static inline void setChannels(const soft_pwm_t &pwm, uint8_t channels, bool on)
+{
+  for(uint8_t channel = 0; channels != 0U; channel++, channels >>= 1)
+  {
+    if( (channels & 1U) == 0U ) { continue; }
+    const soft_pwm_channel_t &output = pwm.channel[channel];
+    if(on != output.inverted) { *output.port |= output.mask; }
+    else { *output.port &= ~output.mask; }
+  }
+}
+
+//The time from the event at nextEdge to the one after it
+static inline uint16_t intervalAfter(const soft_pwm_t &pwm, const soft_pwm_edges_t &edges, uint8_t nextEdge)
+{
+  if(nextEdge < edges.count)
+  {
+    uint16_t followingTime = ((nextEdge + 1U) < edges.count) ? edges.time[nextEdge + 1U] : pwm.period;
+    return followingTime - edges.time[nextEdge];
+  }
+  //The next event is the start of a period, which will use the pending list if there is one
+  const soft_pwm_edges_t &nextEdges = pwm.pending ? pwm.edges[pwm.active ^ 1U] : edges;
+  return (nextEdges.count > 0U) ? nextEdges.time[0] : pwm.period;
+}
+
+/**
+ * @brief Performs the next edge of the group. Called from the timer compare interrupt
+ *
+ * @return uint16_t The number of ticks until the interrupt must next run. For a reload timer this is the interval
+ * after the next one, as the next has already been loaded.
+ */
+uint16_t softPWMInterrupt(soft_pwm_t &pwm)
+{
+  const soft_pwm_edges_t *edges = &pwm.edges[pwm.active];
+  uint16_t interval;
+
+  if(pwm.nextEdge < edges->count)
+  {
+    setChannels(pwm, edges->channels[pwm.nextEdge], false);
+    uint16_t edgeTime = edges->time[pwm.nextEdge];
+    pwm.nextEdge++;
+    interval = ((pwm.nextEdge < edges->count) ? edges->time[pwm.nextEdge] : pwm.period) - edgeTime;
+  }
+  else
+  {
+    //Start of a period
+    if(pwm.pending == true)
+    {
+      pwm.active ^= 1U;
+      pwm.pending = false;
+      edges = &pwm.edges[pwm.active];
+    }
+    uint8_t allChannels = (uint8_t)((1U << pwm.channelCount) - 1U);
+    setChannels(pwm, edges->onChannels, true);
+    setChannels(pwm, allChannels & ~edges->onChannels, false);
+    pwm.nextEdge = 0;
+    interval = (edges->count > 0U) ? edges->time[0] : pwm.period;
+  }
+
+  if(pwm.reloadTimer == true) { interval = intervalAfter(pwm, *edges, pwm.nextEdge); }
+  return interval;
+}
@@ -0,0 +1,49 @@
+/** @file
+ * Software PWM of several outputs from a single timer compare.
+ * All channels of a soft_pwm_t share one period. Each period starts with every channel with a non-zero duty being
+ * turned on, followed by a list of edges (Sorted by time) at which channels are turned off. Channels with the same duty
+ * share an edge, so the interrupt runs at most once per distinct duty plus once at the start of each period.
+ * The edge list is only rebuilt (By softPWMUpdate() in the main loop) when a duty has changed, and is handed over to the
+ * interrupt at the start of the next period so that a period is never made up of a mix of old and new duties.
+ */
+#ifndef SOFT_PWM_H
+#define SOFT_PWM_H
+
+#include "globals.h"
+
+#define SOFT_PWM_MAX_CHANNELS   8U ///< The channels turned off at an edge are a bit mask
+#define SOFT_PWM_NO_CHANNEL     0xFFU
+
+struct soft_pwm_channel_t {
+  volatile PORT_TYPE *port;
+  PINMASK_TYPE mask;
+  bool inverted; ///< The output is low for the on time rather than high
+};
+
+struct soft_pwm_edges_t {
+  uint16_t time[SOFT_PWM_MAX_CHANNELS];    ///< Ticks from the start of the period, ascending. Always > 0 and < period
+  uint8_t channels[SOFT_PWM_MAX_CHANNELS]; ///< Bit per channel that is turned off at each edge
+  uint8_t onChannels; ///< Bit per channel that is turned on at the start of the period. All others are turned off
+  uint8_t count;
+};
+
+struct soft_pwm_t {
+  soft_pwm_channel_t channel[SOFT_PWM_MAX_CHANNELS];
+  uint16_t onTime[SOFT_PWM_MAX_CHANNELS]; ///< Ticks. 0 is always off, >= period is always on
+  uint16_t period; ///< Ticks
+  uint8_t channelCount;
+  bool changed; ///< An on time has changed since the edge list was last built
+  bool reloadTimer; ///< The timer only takes a new interval after the current one completes (Eg the Teensy 4.1 PIT), so the interrupt must return the interval after next
+  soft_pwm_edges_t edges[2];
+  volatile uint8_t active; ///< The edge list in use by the interrupt
+  volatile bool pending; ///< The other edge list is newer and is to be used from the start of the next period
+  uint8_t nextEdge; ///< The index of the next edge in the active list. Equal to the count when the next event is the start of a period
+};
+
+void softPWMInit(soft_pwm_t &pwm, uint16_t period, bool reloadTimer);
+uint8_t softPWMAddChannel(soft_pwm_t &pwm, volatile PORT_TYPE *port, PINMASK_TYPE mask, bool inverted);
+void softPWMSetOnTime(soft_pwm_t &pwm, uint8_t channel, uint16_t onTime);
+void softPWMUpdate(soft_pwm_t &pwm);
+uint16_t softPWMInterrupt(soft_pwm_t &pwm);
+
+#endif
@@ -39,12 +39,19 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "init.h"
 #include "utilities.h"
 #include "engineProtection.h"
+#include "rpmEstimator.h"
+#include "angleArming.h"
+#include "dwellControl.h"
+#include "ignitionTrim.h"
+#include "veLearn.h"
 #include "scheduledIO.h"
 #include "secondaryTables.h"
 #include "comms_CAN.h"
 #include "SD_logger.h"
+#include "logger.h"
 #include "schedule_calcs.h"
 #include "auxiliaries.h"
+#include "TS_CommandButtonHandler.h"
 #include RTC_LIB_H //Defined in each boards .h file
 #include BOARD_H //Note that this is not a real file, it is defined in globals.h. 
 
@@ -60,6 +67,29 @@ uint32_t rollingCutLastRev = 0; /**< Tracks whether we're on the same or a diffe
 uint16_t staged_req_fuel_mult_pri = 0;
 uint16_t staged_req_fuel_mult_sec = 0;   
 #ifndef UNIT_TEST // Scope guard for unit testing
+static uint8_t fuelIgnDecoderGeneration = 0; /**< The decoderGeneration that the fuel and ignition values were last calculated for */
+static bool fuelIgnCalculated = false; /**< Whether the fuel and ignition values have been calculated since the engine last stopped */
+static bool startTimed = false; /**< Whether startTime has been set for the current start */
+static uint32_t startTime = 0; /**< micros() when the main loop first saw the engine turning. The start times (firstFireTime and fullSyncTime) are measured from this */
+
+/** Records how long the current start took to the first spark and to full sync. Both are held until the next start */
+static void updateStartTimes(uint32_t loopTime)
+{
+  if(startTimed == false)
+  {
+    startTimed = true;
+    startTime = loopTime;
+    currentStatus.firstFireTime = 0;
+    currentStatus.fullSyncTime = 0;
+  }
+
+  uint32_t sinceStart = (loopTime - startTime) / 1000UL;
+  if(sinceStart > UINT16_MAX) { sinceStart = UINT16_MAX; }
+  if(sinceStart == 0U) { sinceStart = 1U; } //0 means not reached yet
+  if( (currentStatus.firstFireTime == 0U) && (ignitionCount > 0U) ) { currentStatus.firstFireTime = (uint16_t)sinceStart; }
+  if( (currentStatus.fullSyncTime == 0U) && (currentStatus.hasSync == true) ) { currentStatus.fullSyncTime = (uint16_t)sinceStart; }
+}
+
 void setup(void)
 {
   currentStatus.initialisationComplete = false; //Tracks whether the initialiseAll() function has run completely
@@ -101,6 +131,7 @@ void __attribute__((always_inline)) loop(void)
 {
       mainLoopCount++;
       LOOP_TIMER = TIMER_mask;
+      expireLiveSnapshot(); //Realtime data requests in this loop will share one new snapshot
 
       //SERIAL Comms
       //Initially check that the last serial send values request is not still outstanding
@@ -115,12 +146,27 @@ void __attribute__((always_inline)) loop(void)
         serialReceive();
       }
       
+      //Run any command button actions that TS has queued. These are limited to a small amount of time per loop so that slow actions cannot stall the engine calculations
+      if (getTSCommandQueueCount() > 0U)
+      {
+        processTSCommandQueue(TS_CMD_LOOP_BUDGET);
+      }
+      
       //Check for any CAN comms requiring action 
       #if defined(secondarySerial_AVAILABLE)
         //if can or secondary serial interface is enabled then check for requests.
         if (configPage9.enable_secondarySerial == 1)  //secondary serial interface enabled
         {
-          if ( ((mainLoopCount & 31) == 1) || (secondarySerial.available() > SERIAL_BUFFER_THRESHOLD) )
+          //Finish sending any realtime values before looking at the next request
+          if (serialSecondaryStatusFlag == SERIAL_TRANSMIT_INPROGRESS_LEGACY) { sendValuesContinue(serialSecondaryStatusFlag); }
+          else if (configPage9.secondarySerialProtocol == SECONDARY_SERIAL_PROTO_REALDASH_CAN) { secondserial_sendDashFrames(secondarySerial); }
+          else if (configPage9.secondarySerialProtocol == SECONDARY_SERIAL_PROTO_TUNERSTUDIO)
+          {
+            //TunerStudio has its own session on this port, so it is serviced every loop the same as the primary port
+            if (serialTransmitInProgress(serialSecondaryStatusFlag)) { serialTransmit(secondaryCommsSession); }
+            if ( (secondarySerial.available() > 0) || serialRecieveInProgress(serialSecondaryStatusFlag) ) { serialReceive(secondaryCommsSession); }
+          }
+          else if ( ((mainLoopCount & 31) == 1) || (secondarySerial.available() > SERIAL_BUFFER_THRESHOLD) )
           {
             if (secondarySerial.available() > 0)  { secondserial_Command(); }
           } 
@@ -152,6 +198,10 @@ void __attribute__((always_inline)) loop(void)
       currentStatus.longRPM = getRPM(); //Long RPM is included here
       currentStatus.RPM = currentStatus.longRPM;
       currentStatus.RPMdiv100 = div100(currentStatus.RPM);
+      //Any limiter that cut or retarded on the previous loop means the current acceleration is not the full torque acceleration
+      updateRPMPrediction( ((ignitionChannelsOn & fuelChannelsOn) != 0xFF) || BIT_CHECK(currentStatus.status2, BIT_STATUS2_SFTLIM) || currentStatus.launchingSoft || BIT_CHECK(currentStatus.status5, BIT_STATUS5_FLATSS) );
+      updateRPMEstimator();
+      updateStartTimes(currentLoopTime);
       if(currentStatus.RPM > 0)
       {
         FUEL_PUMP_ON();
@@ -163,6 +213,8 @@ void __attribute__((always_inline)) loop(void)
       //We reach here if the time between teeth is too great. This VERY likely means the engine has stopped
       currentStatus.RPM = 0;
       currentStatus.RPMdiv100 = 0;
+      currentStatus.predictedRPM = 0;
+      clearRPMEstimator();
       currentStatus.PW1 = 0;
       currentStatus.VE = 0;
       currentStatus.VE2 = 0;
@@ -174,6 +226,11 @@ void __attribute__((always_inline)) loop(void)
       initialiseMAPBaro();
       currentStatus.rpmDOT = 0;
       AFRnextCycle = 0;
+      fuelIgnCalculated = false;
+      stopAngleArming();
+      resetAngleArmingToothGap();
+      resetDwellTrims();
+      startTimed = false;
       ignitionCount = 0;
       ignitionChannelsOn = 0;
       fuelChannelsOn = 0;
@@ -218,6 +275,9 @@ void __attribute__((always_inline)) loop(void)
       #if defined(NATIVE_CAN_AVAILABLE)
       sendCANBroadcast(50);
       #endif
+      #if defined(secondarySerial_AVAILABLE)
+      secondserial_queueDashFrames(50);
+      #endif
 
     }
     if(BIT_CHECK(LOOP_TIMER, BIT_TIMER_30HZ)) //30 hertz
@@ -241,6 +301,9 @@ void __attribute__((always_inline)) loop(void)
       #if defined(NATIVE_CAN_AVAILABLE)
       sendCANBroadcast(30);
       #endif
+      #if defined(secondarySerial_AVAILABLE)
+      secondserial_queueDashFrames(30);
+      #endif
 
       #ifdef SD_LOGGING
         if(configPage13.onboard_log_file_rate == LOGGER_RATE_30HZ) { writeSDLogEntry(); }
@@ -268,6 +331,9 @@ void __attribute__((always_inline)) loop(void)
       #if defined(NATIVE_CAN_AVAILABLE)
       sendCANBroadcast(15);
       #endif
+      #if defined(secondarySerial_AVAILABLE)
+      secondserial_queueDashFrames(15);
+      #endif
 
       //And check whether the tooth log buffer is ready
       if(toothHistoryIndex > TOOTH_LOG_SIZE) { BIT_SET(currentStatus.status1, BIT_STATUS1_TOOTHLOG1READY); }
@@ -285,9 +351,14 @@ void __attribute__((always_inline)) loop(void)
       currentStatus.vss = getSpeed();
       currentStatus.gear = getGear();
 
+      veLearnSample(); //Adaptive VE learning
+
       #if defined(NATIVE_CAN_AVAILABLE)
       sendCANBroadcast(10);
       #endif
+      #if defined(secondarySerial_AVAILABLE)
+      secondserial_queueDashFrames(10);
+      #endif
 
       #ifdef SD_LOGGING
         if(configPage13.onboard_log_file_rate == LOGGER_RATE_10HZ) { writeSDLogEntry(); }
@@ -301,6 +372,7 @@ void __attribute__((always_inline)) loop(void)
       readIAT();
       readBat();
       nitrousControl();
+      updateScheduleStatus(); //Schedule event counters for the output channels
 
       //Lookup the current target idle RPM. This is aligned with coolant and so needs to be calculated at the same rate CLT is read
       if( (configPage2.idleAdvEnabled >= 1) || (configPage6.iacAlgorithm != IAC_ALGORITHM_NONE) )
@@ -449,253 +521,179 @@ void __attribute__((always_inline)) loop(void)
       //END SETTING ENGINE STATUSES
       //-----------------------------------------------------------------------------------------------------
 
-      //Begin the fuel calculation
-      //Calculate an injector pulsewidth from the VE
-      currentStatus.afrTarget = calculateAfrTarget(afrTable, currentStatus, configPage2, configPage6);
-      currentStatus.corrections = correctionsFuel();
-
-      currentStatus.PW1 = PW(req_fuel_uS, currentStatus.VE, currentStatus.MAP, currentStatus.corrections, inj_opentime_uS);
-
-      //Manual adder for nitrous. These are not in correctionsFuel() because they are direct adders to the ms value, not % based
-      if( (currentStatus.nitrous_status == NITROUS_STAGE1) || (currentStatus.nitrous_status == NITROUS_BOTH) )
-      { 
-        int16_t adderRange = (configPage10.n2o_stage1_maxRPM - configPage10.n2o_stage1_minRPM) * 100;
-        int16_t adderPercent = ((currentStatus.RPM - (configPage10.n2o_stage1_minRPM * 100)) * 100) / adderRange; //The percentage of the way through the RPM range
-        adderPercent = 100 - adderPercent; //Flip the percentage as we go from a higher adder to a lower adder as the RPMs rise
-        currentStatus.PW1 = currentStatus.PW1 + (configPage10.n2o_stage1_adderMax + percentage(adderPercent, (configPage10.n2o_stage1_adderMin - configPage10.n2o_stage1_adderMax))) * 100; //Calculate the above percentage of the calculated ms value.
-      }
-      if( (currentStatus.nitrous_status == NITROUS_STAGE2) || (currentStatus.nitrous_status == NITROUS_BOTH) )
-      {
-        int16_t adderRange = (configPage10.n2o_stage2_maxRPM - configPage10.n2o_stage2_minRPM) * 100;
-        int16_t adderPercent = ((currentStatus.RPM - (configPage10.n2o_stage2_minRPM * 100)) * 100) / adderRange; //The percentage of the way through the RPM range
-        adderPercent = 100 - adderPercent; //Flip the percentage as we go from a higher adder to a lower adder as the RPMs rise
-        currentStatus.PW1 = currentStatus.PW1 + (configPage10.n2o_stage2_adderMax + percentage(adderPercent, (configPage10.n2o_stage2_adderMin - configPage10.n2o_stage2_adderMax))) * 100; //Calculate the above percentage of the calculated ms value.
-      }
-
-      int injector1StartAngle = 0;
-      uint16_t injector2StartAngle = 0;
-      uint16_t injector3StartAngle = 0;
-      uint16_t injector4StartAngle = 0;
-
+      //The fuel and ignition values only need to be recalculated when there has been an engine event (A trigger edge) or when one of the loop timers has ticked.
+      //All of the inputs are either read on a loop timer or change with the engine events, so in between these the calculations would give the same results.
+      //On fast boards the loop can run many times per tooth at idle, so this saves a lot of time. The schedules below are still checked every loop
+      static int injector1StartAngle = 0;
+      static uint16_t injector2StartAngle = 0;
+      static uint16_t injector3StartAngle = 0;
+      static uint16_t injector4StartAngle = 0;
       #if INJ_CHANNELS >= 5
-      uint16_t injector5StartAngle = 0;
+      static uint16_t injector5StartAngle = 0;
       #endif
       #if INJ_CHANNELS >= 6
-      uint16_t injector6StartAngle = 0;
+      static uint16_t injector6StartAngle = 0;
       #endif
       #if INJ_CHANNELS >= 7
-      uint16_t injector7StartAngle = 0;
+      static uint16_t injector7StartAngle = 0;
       #endif
       #if INJ_CHANNELS >= 8
-      uint16_t injector8StartAngle = 0;
+      static uint16_t injector8StartAngle = 0;
       #endif
-      
-      //Check that the duty cycle of the chosen pulsewidth isn't too high.
-      uint16_t pwLimit = calculatePWLimit();
-      //Apply the pwLimit if staging is disabled and engine is not cranking
-      if( (!BIT_CHECK(currentStatus.engine, BIT_ENGINE_CRANK)) && (configPage10.stagingEnabled == false) ) { if (currentStatus.PW1 > pwLimit) { currentStatus.PW1 = pwLimit; } }
 
-      calculateStaging(pwLimit);
+      const uint8_t decoderGenerationNow = decoderGeneration;
+      const bool recalculateFuelIgn = (fuelIgnCalculated == false) || (decoderGenerationNow != fuelIgnDecoderGeneration) || (LOOP_TIMER != 0U);
+      if(recalculateFuelIgn)
+      {
+        fuelIgnDecoderGeneration = decoderGenerationNow;
+        fuelIgnCalculated = true;
+        //The cam interrupt can bring full sync at any time. It is read once so that the fuel and ignition are both calculated (And switched to sequential) for the same sync state
+        const bool fullSync = currentStatus.hasSync;
 
-      //***********************************************************************************************
-      //BEGIN INJECTION TIMING
-      currentStatus.injAngle = table2D_getValue(&injectorAngleTable, currentStatus.RPMdiv100);
-      if(currentStatus.injAngle > uint16_t(CRANK_ANGLE_MAX_INJ)) { currentStatus.injAngle = uint16_t(CRANK_ANGLE_MAX_INJ); }
+        //Begin the fuel calculation
+        //Calculate an injector pulsewidth from the VE
+        currentStatus.afrTarget = calculateAfrTarget(afrTable, currentStatus, configPage2, configPage6);
+        currentStatus.corrections = correctionsFuel();
 
-      unsigned int PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW1); //How many crank degrees the calculated PW will take at the current speed
+        currentStatus.PW1 = PW(req_fuel_uS, currentStatus.VE, currentStatus.MAP, currentStatus.corrections, inj_opentime_uS);
 
-      injector1StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel1InjDegrees, currentStatus.injAngle);
+        //Manual adder for nitrous. These are not in correctionsFuel() because they are direct adders to the ms value, not % based
+        if( (currentStatus.nitrous_status == NITROUS_STAGE1) || (currentStatus.nitrous_status == NITROUS_BOTH) )
+        { 
+          int16_t adderRange = (configPage10.n2o_stage1_maxRPM - configPage10.n2o_stage1_minRPM) * 100;
+          int16_t adderPercent = ((currentStatus.RPM - (configPage10.n2o_stage1_minRPM * 100)) * 100) / adderRange; //The percentage of the way through the RPM range
+          adderPercent = 100 - adderPercent; //Flip the percentage as we go from a higher adder to a lower adder as the RPMs rise
+          currentStatus.PW1 = currentStatus.PW1 + (configPage10.n2o_stage1_adderMax + percentage(adderPercent, (configPage10.n2o_stage1_adderMin - configPage10.n2o_stage1_adderMax))) * 100; //Calculate the above percentage of the calculated ms value.
+        }
+        if( (currentStatus.nitrous_status == NITROUS_STAGE2) || (currentStatus.nitrous_status == NITROUS_BOTH) )
+        {
+          int16_t adderRange = (configPage10.n2o_stage2_maxRPM - configPage10.n2o_stage2_minRPM) * 100;
+          int16_t adderPercent = ((currentStatus.RPM - (configPage10.n2o_stage2_minRPM * 100)) * 100) / adderRange; //The percentage of the way through the RPM range
+          adderPercent = 100 - adderPercent; //Flip the percentage as we go from a higher adder to a lower adder as the RPMs rise
+          currentStatus.PW1 = currentStatus.PW1 + (configPage10.n2o_stage2_adderMax + percentage(adderPercent, (configPage10.n2o_stage2_adderMin - configPage10.n2o_stage2_adderMax))) * 100; //Calculate the above percentage of the calculated ms value.
+        }
 
-      //Repeat the above for each cylinder
-      switch (configPage2.nCylinders)
-      {
-        //Single cylinder
-        case 1:
-          //The only thing that needs to be done for single cylinder is to check for staging. 
-          if( (configPage10.stagingEnabled == true) && (BIT_CHECK(currentStatus.status4, BIT_STATUS4_STAGING_ACTIVE) == true) )
-          {
-            PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW2); //Need to redo this for PW2 as it will be dramatically different to PW1 when staging
-            //injector3StartAngle = calculateInjector3StartAngle(PWdivTimerPerDegree);
-            injector2StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel1InjDegrees, currentStatus.injAngle);
-          }
-          break;
-        //2 cylinders
-        case 2:
-          //injector2StartAngle = calculateInjector2StartAngle(PWdivTimerPerDegree);
-          injector2StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
-          
-          if ( (configPage2.injLayout == INJ_SEQUENTIAL) && (configPage6.fuelTrimEnabled > 0) )
-          {
-            currentStatus.PW1 = applyFuelTrimToPW(&trim1Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW1);
-            currentStatus.PW2 = applyFuelTrimToPW(&trim2Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW2);
-          }
-          else if( (configPage10.stagingEnabled == true) && (BIT_CHECK(currentStatus.status4, BIT_STATUS4_STAGING_ACTIVE) == true) )
-          {
-            PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW3); //Need to redo this for PW3 as it will be dramatically different to PW1 when staging
-            injector3StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel1InjDegrees, currentStatus.injAngle);
-            injector4StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
+        injector1StartAngle = 0;
+        injector2StartAngle = 0;
+        injector3StartAngle = 0;
+        injector4StartAngle = 0;
 
-            injector4StartAngle = injector3StartAngle + (CRANK_ANGLE_MAX_INJ / 2); //Phase this either 180 or 360 degrees out from inj3 (In reality this will always be 180 as you can't have sequential and staged currently)
-            if(injector4StartAngle > (uint16_t)CRANK_ANGLE_MAX_INJ) { injector4StartAngle -= CRANK_ANGLE_MAX_INJ; }
-          }
-          break;
-        //3 cylinders
-        case 3:
-          //injector2StartAngle = calculateInjector2StartAngle(PWdivTimerPerDegree);
-          //injector3StartAngle = calculateInjector3StartAngle(PWdivTimerPerDegree);
-          injector2StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
-          injector3StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle);
-          
-          if ( (configPage2.injLayout == INJ_SEQUENTIAL) && (configPage6.fuelTrimEnabled > 0) )
-          {
-            currentStatus.PW1 = applyFuelTrimToPW(&trim1Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW1);
-            currentStatus.PW2 = applyFuelTrimToPW(&trim2Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW2);
-            currentStatus.PW3 = applyFuelTrimToPW(&trim3Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW3);
+        #if INJ_CHANNELS >= 5
+        injector5StartAngle = 0;
+        #endif
+        #if INJ_CHANNELS >= 6
+        injector6StartAngle = 0;
+        #endif
+        #if INJ_CHANNELS >= 7
+        injector7StartAngle = 0;
+        #endif
+        #if INJ_CHANNELS >= 8
+        injector8StartAngle = 0;
+        #endif
+      
+        //Check that the duty cycle of the chosen pulsewidth isn't too high.
+        uint16_t pwLimit = calculatePWLimit();
+        //Apply the pwLimit if staging is disabled and engine is not cranking
+        if( (!BIT_CHECK(currentStatus.engine, BIT_ENGINE_CRANK)) && (configPage10.stagingEnabled == false) ) { if (currentStatus.PW1 > pwLimit) { currentStatus.PW1 = pwLimit; } }
 
-            #if INJ_CHANNELS >= 6
-              if( (configPage10.stagingEnabled == true) && (BIT_CHECK(currentStatus.status4, BIT_STATUS4_STAGING_ACTIVE) == true) )
-              {
-                PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW4); //Need to redo this for PW4 as it will be dramatically different to PW1 when staging
-                injector4StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel1InjDegrees, currentStatus.injAngle);
-                injector5StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
-                injector6StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle);
-              }
-            #endif
-          }
-          else if( (configPage10.stagingEnabled == true) && (BIT_CHECK(currentStatus.status4, BIT_STATUS4_STAGING_ACTIVE) == true) )
-          {
-            PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW4); //Need to redo this for PW3 as it will be dramatically different to PW1 when staging
-            injector4StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel1InjDegrees, currentStatus.injAngle);
-            #if INJ_CHANNELS >= 6
-              injector5StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
-              injector6StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle);
-            #endif
-          }
-          break;
-        //4 cylinders
-        case 4:
-          //injector2StartAngle = calculateInjector2StartAngle(PWdivTimerPerDegree);
-          injector2StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
+        calculateStaging(pwLimit);
 
-          if((configPage2.injLayout == INJ_SEQUENTIAL) && currentStatus.hasSync)
-          {
-            if( CRANK_ANGLE_MAX_INJ != 720 ) { changeHalfToFullSync(); }
+        //***********************************************************************************************
+        //BEGIN INJECTION TIMING
+        currentStatus.injAngle = table2D_getValue(&injectorAngleTable, currentStatus.RPMdiv100);
+        if(currentStatus.injAngle > uint16_t(CRANK_ANGLE_MAX_INJ)) { currentStatus.injAngle = uint16_t(CRANK_ANGLE_MAX_INJ); }
 
-            injector3StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle);
-            injector4StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel4InjDegrees, currentStatus.injAngle);
-            #if INJ_CHANNELS >= 8
-              if( (configPage10.stagingEnabled == true) && (BIT_CHECK(currentStatus.status4, BIT_STATUS4_STAGING_ACTIVE) == true) )
-              {
-                PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW5); //Need to redo this for PW5 as it will be dramatically different to PW1 when staging
-                injector5StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel1InjDegrees, currentStatus.injAngle);
-                injector6StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
-                injector7StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle);
-                injector8StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel4InjDegrees, currentStatus.injAngle);
-              }
-            #endif
+        unsigned int PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW1); //How many crank degrees the calculated PW will take at the current speed
 
-            if(configPage6.fuelTrimEnabled > 0)
+        injector1StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel1InjDegrees, currentStatus.injAngle);
+
+        //Repeat the above for each cylinder
+        switch (configPage2.nCylinders)
+        {
+          //Single cylinder
+          case 1:
+            //The only thing that needs to be done for single cylinder is to check for staging. 
+            if( (configPage10.stagingEnabled == true) && (BIT_CHECK(currentStatus.status4, BIT_STATUS4_STAGING_ACTIVE) == true) )
+            {
+              PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW2); //Need to redo this for PW2 as it will be dramatically different to PW1 when staging
+              //injector3StartAngle = calculateInjector3StartAngle(PWdivTimerPerDegree);
+              injector2StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel1InjDegrees, currentStatus.injAngle);
+            }
+            break;
+          //2 cylinders
+          case 2:
+            //injector2StartAngle = calculateInjector2StartAngle(PWdivTimerPerDegree);
+            injector2StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
+          
+            if ( (configPage2.injLayout == INJ_SEQUENTIAL) && (configPage6.fuelTrimEnabled > 0) )
             {
               currentStatus.PW1 = applyFuelTrimToPW(&trim1Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW1);
               currentStatus.PW2 = applyFuelTrimToPW(&trim2Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW2);
-              currentStatus.PW3 = applyFuelTrimToPW(&trim3Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW3);
-              currentStatus.PW4 = applyFuelTrimToPW(&trim4Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW4);
             }
-          }
-          else if( (configPage10.stagingEnabled == true) && (BIT_CHECK(currentStatus.status4, BIT_STATUS4_STAGING_ACTIVE) == true) )
-          {
-            PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW3); //Need to redo this for PW3 as it will be dramatically different to PW1 when staging
-            injector3StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel1InjDegrees, currentStatus.injAngle);
-            injector4StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
-          }
-          else
-          {
-            if( BIT_CHECK(currentStatus.status3, BIT_STATUS3_HALFSYNC) && (CRANK_ANGLE_MAX_INJ != 360) ) { changeFullToHalfSync(); }
-          }
-          break;
-        //5 cylinders
-        case 5:
-          injector2StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
-          injector3StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle);
-          injector4StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel4InjDegrees, currentStatus.injAngle);
-          #if INJ_CHANNELS >= 5
-            injector5StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel5InjDegrees, currentStatus.injAngle);
-          #endif
-
-          //Staging is possible by using the 6th channel if available
-          #if INJ_CHANNELS >= 6
-            if( (configPage10.stagingEnabled == true) && (BIT_CHECK(currentStatus.status4, BIT_STATUS4_STAGING_ACTIVE) == true) )
+            else if( (configPage10.stagingEnabled == true) && (BIT_CHECK(currentStatus.status4, BIT_STATUS4_STAGING_ACTIVE) == true) )
             {
-              PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW6);
-              injector6StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel6InjDegrees, currentStatus.injAngle);
-            }
-          #endif
+              PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW3); //Need to redo this for PW3 as it will be dramatically different to PW1 when staging
+              injector3StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel1InjDegrees, currentStatus.injAngle);
+              injector4StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
 
-          break;
-        //6 cylinders
-        case 6:
-          injector2StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
-          injector3StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle);
+              injector4StartAngle = injector3StartAngle + (CRANK_ANGLE_MAX_INJ / 2); //Phase this either 180 or 360 degrees out from inj3 (In reality this will always be 180 as you can't have sequential and staged currently)
+              if(injector4StartAngle > (uint16_t)CRANK_ANGLE_MAX_INJ) { injector4StartAngle -= CRANK_ANGLE_MAX_INJ; }
+            }
+            break;
+          //3 cylinders
+          case 3:
+            //injector2StartAngle = calculateInjector2StartAngle(PWdivTimerPerDegree);
+            //injector3StartAngle = calculateInjector3StartAngle(PWdivTimerPerDegree);
+            injector2StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
+            injector3StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle);
           
-          #if INJ_CHANNELS >= 6
-            if((configPage2.injLayout == INJ_SEQUENTIAL) && currentStatus.hasSync)
+            if ( (configPage2.injLayout == INJ_SEQUENTIAL) && (configPage6.fuelTrimEnabled > 0) )
             {
-              if( CRANK_ANGLE_MAX_INJ != 720 ) { changeHalfToFullSync(); }
-
-              injector4StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel4InjDegrees, currentStatus.injAngle);
-              injector5StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel5InjDegrees, currentStatus.injAngle);
-              injector6StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel6InjDegrees, currentStatus.injAngle);
-
-              if(configPage6.fuelTrimEnabled > 0)
-              {
-                currentStatus.PW1 = applyFuelTrimToPW(&trim1Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW1);
-                currentStatus.PW2 = applyFuelTrimToPW(&trim2Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW2);
-                currentStatus.PW3 = applyFuelTrimToPW(&trim3Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW3);
-                currentStatus.PW4 = applyFuelTrimToPW(&trim4Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW4);
-                currentStatus.PW5 = applyFuelTrimToPW(&trim5Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW5);
-                currentStatus.PW6 = applyFuelTrimToPW(&trim6Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW6);
-              }
+              currentStatus.PW1 = applyFuelTrimToPW(&trim1Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW1);
+              currentStatus.PW2 = applyFuelTrimToPW(&trim2Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW2);
+              currentStatus.PW3 = applyFuelTrimToPW(&trim3Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW3);
 
-              //Staging is possible with sequential on 8 channel boards by using outputs 7 + 8 for the staged injectors
-              #if INJ_CHANNELS >= 8
+              #if INJ_CHANNELS >= 6
                 if( (configPage10.stagingEnabled == true) && (BIT_CHECK(currentStatus.status4, BIT_STATUS4_STAGING_ACTIVE) == true) )
                 {
-                  PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW4); //Need to redo this for staging PW as it will be dramatically different to PW1 when staging
+                  PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW4); //Need to redo this for PW4 as it will be dramatically different to PW1 when staging
                   injector4StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel1InjDegrees, currentStatus.injAngle);
                   injector5StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
                   injector6StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle);
                 }
               #endif
             }
-            else
+            else if( (configPage10.stagingEnabled == true) && (BIT_CHECK(currentStatus.status4, BIT_STATUS4_STAGING_ACTIVE) == true) )
             {
-              if( BIT_CHECK(currentStatus.status3, BIT_STATUS3_HALFSYNC) && (CRANK_ANGLE_MAX_INJ != 360) ) { changeFullToHalfSync(); }
-
-              if( (configPage10.stagingEnabled == true) && (BIT_CHECK(currentStatus.status4, BIT_STATUS4_STAGING_ACTIVE) == true) )
-              {
-                PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW4); //Need to redo this for staging PW as it will be dramatically different to PW1 when staging
-                injector4StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel1InjDegrees, currentStatus.injAngle);
+              PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW4); //Need to redo this for PW3 as it will be dramatically different to PW1 when staging
+              injector4StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel1InjDegrees, currentStatus.injAngle);
+              #if INJ_CHANNELS >= 6
                 injector5StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
-                injector6StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle); 
-              }
+                injector6StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle);
+              #endif
             }
-          #endif
-          break;
-        //8 cylinders
-        case 8:
-          injector2StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
-          injector3StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle);
-          injector4StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel4InjDegrees, currentStatus.injAngle);
+            break;
+          //4 cylinders
+          case 4:
+            //injector2StartAngle = calculateInjector2StartAngle(PWdivTimerPerDegree);
+            injector2StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
 
-          #if INJ_CHANNELS >= 8
-            if((configPage2.injLayout == INJ_SEQUENTIAL) && currentStatus.hasSync)
+            if((configPage2.injLayout == INJ_SEQUENTIAL) && fullSync)
             {
               if( CRANK_ANGLE_MAX_INJ != 720 ) { changeHalfToFullSync(); }
 
-              injector5StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel5InjDegrees, currentStatus.injAngle);
-              injector6StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel6InjDegrees, currentStatus.injAngle);
-              injector7StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel7InjDegrees, currentStatus.injAngle);
-              injector8StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel8InjDegrees, currentStatus.injAngle);
+              injector3StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle);
+              injector4StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel4InjDegrees, currentStatus.injAngle);
+              #if INJ_CHANNELS >= 8
+                if( (configPage10.stagingEnabled == true) && (BIT_CHECK(currentStatus.status4, BIT_STATUS4_STAGING_ACTIVE) == true) )
+                {
+                  PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW5); //Need to redo this for PW5 as it will be dramatically different to PW1 when staging
+                  injector5StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel1InjDegrees, currentStatus.injAngle);
+                  injector6StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
+                  injector7StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle);
+                  injector8StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel4InjDegrees, currentStatus.injAngle);
+                }
+              #endif
 
               if(configPage6.fuelTrimEnabled > 0)
               {
@@ -703,62 +701,182 @@ void __attribute__((always_inline)) loop(void)
                 currentStatus.PW2 = applyFuelTrimToPW(&trim2Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW2);
                 currentStatus.PW3 = applyFuelTrimToPW(&trim3Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW3);
                 currentStatus.PW4 = applyFuelTrimToPW(&trim4Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW4);
-                currentStatus.PW5 = applyFuelTrimToPW(&trim5Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW5);
-                currentStatus.PW6 = applyFuelTrimToPW(&trim6Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW6);
-                currentStatus.PW7 = applyFuelTrimToPW(&trim7Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW7);
-                currentStatus.PW8 = applyFuelTrimToPW(&trim8Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW8);
               }
             }
+            else if( (configPage10.stagingEnabled == true) && (BIT_CHECK(currentStatus.status4, BIT_STATUS4_STAGING_ACTIVE) == true) )
+            {
+              PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW3); //Need to redo this for PW3 as it will be dramatically different to PW1 when staging
+              injector3StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel1InjDegrees, currentStatus.injAngle);
+              injector4StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
+            }
             else
             {
               if( BIT_CHECK(currentStatus.status3, BIT_STATUS3_HALFSYNC) && (CRANK_ANGLE_MAX_INJ != 360) ) { changeFullToHalfSync(); }
+            }
+            break;
+          //5 cylinders
+          case 5:
+            injector2StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
+            injector3StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle);
+            injector4StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel4InjDegrees, currentStatus.injAngle);
+            #if INJ_CHANNELS >= 5
+              injector5StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel5InjDegrees, currentStatus.injAngle);
+            #endif
 
+            //Staging is possible by using the 6th channel if available
+            #if INJ_CHANNELS >= 6
               if( (configPage10.stagingEnabled == true) && (BIT_CHECK(currentStatus.status4, BIT_STATUS4_STAGING_ACTIVE) == true) )
               {
-                PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW5); //Need to redo this for PW3 as it will be dramatically different to PW1 when staging
-                injector5StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel1InjDegrees, currentStatus.injAngle);
-                injector6StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
-                injector7StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle);
-                injector8StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel4InjDegrees, currentStatus.injAngle);
+                PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW6);
+                injector6StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel6InjDegrees, currentStatus.injAngle);
               }
-            }
+            #endif
 
-          #endif
-          break;
+            break;
+          //6 cylinders
+          case 6:
+            injector2StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
+            injector3StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle);
+          
+            #if INJ_CHANNELS >= 6
+              if((configPage2.injLayout == INJ_SEQUENTIAL) && fullSync)
+              {
+                if( CRANK_ANGLE_MAX_INJ != 720 ) { changeHalfToFullSync(); }
 
-        //Will hit the default case on 1 cylinder or >8 cylinders. Do nothing in these cases
-        default:
-          break;
-      }
+                injector4StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel4InjDegrees, currentStatus.injAngle);
+                injector5StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel5InjDegrees, currentStatus.injAngle);
+                injector6StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel6InjDegrees, currentStatus.injAngle);
 
-      //***********************************************************************************************
-      //| BEGIN IGNITION CALCULATIONS
+                if(configPage6.fuelTrimEnabled > 0)
+                {
+                  currentStatus.PW1 = applyFuelTrimToPW(&trim1Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW1);
+                  currentStatus.PW2 = applyFuelTrimToPW(&trim2Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW2);
+                  currentStatus.PW3 = applyFuelTrimToPW(&trim3Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW3);
+                  currentStatus.PW4 = applyFuelTrimToPW(&trim4Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW4);
+                  currentStatus.PW5 = applyFuelTrimToPW(&trim5Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW5);
+                  currentStatus.PW6 = applyFuelTrimToPW(&trim6Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW6);
+                }
 
-      //Set dwell
-      //Dwell is stored as ms * 10. ie Dwell of 4.3ms would be 43 in configPage4. This number therefore needs to be multiplied by 100 to get dwell in uS
-      if ( BIT_CHECK(currentStatus.engine, BIT_ENGINE_CRANK) ) {
-        currentStatus.dwell =  (configPage4.dwellCrank * 100U); //use cranking dwell
-      }
-      else 
-      {
-        if ( configPage2.useDwellMap == true )
+                //Staging is possible with sequential on 8 channel boards by using outputs 7 + 8 for the staged injectors
+                #if INJ_CHANNELS >= 8
+                  if( (configPage10.stagingEnabled == true) && (BIT_CHECK(currentStatus.status4, BIT_STATUS4_STAGING_ACTIVE) == true) )
+                  {
+                    PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW4); //Need to redo this for staging PW as it will be dramatically different to PW1 when staging
+                    injector4StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel1InjDegrees, currentStatus.injAngle);
+                    injector5StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
+                    injector6StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle);
+                  }
+                #endif
+              }
+              else
+              {
+                if( BIT_CHECK(currentStatus.status3, BIT_STATUS3_HALFSYNC) && (CRANK_ANGLE_MAX_INJ != 360) ) { changeFullToHalfSync(); }
+
+                if( (configPage10.stagingEnabled == true) && (BIT_CHECK(currentStatus.status4, BIT_STATUS4_STAGING_ACTIVE) == true) )
+                {
+                  PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW4); //Need to redo this for staging PW as it will be dramatically different to PW1 when staging
+                  injector4StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel1InjDegrees, currentStatus.injAngle);
+                  injector5StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
+                  injector6StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle); 
+                }
+              }
+            #endif
+            break;
+          //8 cylinders
+          case 8:
+            injector2StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
+            injector3StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle);
+            injector4StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel4InjDegrees, currentStatus.injAngle);
+
+            #if INJ_CHANNELS >= 8
+              if((configPage2.injLayout == INJ_SEQUENTIAL) && fullSync)
+              {
+                if( CRANK_ANGLE_MAX_INJ != 720 ) { changeHalfToFullSync(); }
+
+                injector5StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel5InjDegrees, currentStatus.injAngle);
+                injector6StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel6InjDegrees, currentStatus.injAngle);
+                injector7StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel7InjDegrees, currentStatus.injAngle);
+                injector8StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel8InjDegrees, currentStatus.injAngle);
+
+                if(configPage6.fuelTrimEnabled > 0)
+                {
+                  currentStatus.PW1 = applyFuelTrimToPW(&trim1Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW1);
+                  currentStatus.PW2 = applyFuelTrimToPW(&trim2Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW2);
+                  currentStatus.PW3 = applyFuelTrimToPW(&trim3Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW3);
+                  currentStatus.PW4 = applyFuelTrimToPW(&trim4Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW4);
+                  currentStatus.PW5 = applyFuelTrimToPW(&trim5Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW5);
+                  currentStatus.PW6 = applyFuelTrimToPW(&trim6Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW6);
+                  currentStatus.PW7 = applyFuelTrimToPW(&trim7Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW7);
+                  currentStatus.PW8 = applyFuelTrimToPW(&trim8Table, currentStatus.fuelLoad, currentStatus.RPM, currentStatus.PW8);
+                }
+              }
+              else
+              {
+                if( BIT_CHECK(currentStatus.status3, BIT_STATUS3_HALFSYNC) && (CRANK_ANGLE_MAX_INJ != 360) ) { changeFullToHalfSync(); }
+
+                if( (configPage10.stagingEnabled == true) && (BIT_CHECK(currentStatus.status4, BIT_STATUS4_STAGING_ACTIVE) == true) )
+                {
+                  PWdivTimerPerDegree = timeToAngleDegPerMicroSec(currentStatus.PW5); //Need to redo this for PW3 as it will be dramatically different to PW1 when staging
+                  injector5StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel1InjDegrees, currentStatus.injAngle);
+                  injector6StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel2InjDegrees, currentStatus.injAngle);
+                  injector7StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel3InjDegrees, currentStatus.injAngle);
+                  injector8StartAngle = calculateInjectorStartAngle(PWdivTimerPerDegree, channel4InjDegrees, currentStatus.injAngle);
+                }
+              }
+
+            #endif
+            break;
+
+          //Will hit the default case on 1 cylinder or >8 cylinders. Do nothing in these cases
+          default:
+            break;
+        }
+
+        //***********************************************************************************************
+        //| BEGIN IGNITION CALCULATIONS
+
+        //Set dwell
+        //Dwell is stored as ms * 10. ie Dwell of 4.3ms would be 43 in configPage4. This number therefore needs to be multiplied by 100 to get dwell in uS
+        if ( BIT_CHECK(currentStatus.engine, BIT_ENGINE_CRANK) ) {
+          currentStatus.dwell =  (configPage4.dwellCrank * 100U); //use cranking dwell
+        }
+        else 
         {
-          currentStatus.dwell = (get3DTableValue(&dwellTable, currentStatus.ignLoad, currentStatus.RPM) * 100U); //use running dwell from map
+          if ( configPage2.useDwellMap == true )
+          {
+            currentStatus.dwell = (get3DTableValue(&dwellTable, currentStatus.ignLoad, currentStatus.RPM) * 100U); //use running dwell from map
+          }
+          else
+          {
+            currentStatus.dwell =  (configPage4.dwellRun * 100U); //use fixed running dwell
+          }
         }
-        else
+        currentStatus.dwell = correctionsDwell(currentStatus.dwell);
+
+        // Convert the dwell time to dwell angle based on the current engine speed
+        calculateIgnitionAngles(timeToAngleDegPerMicroSec(currentStatus.dwell), fullSync);
+
+        //The ignition trims are not used with the fixed cranking or fixed timing angles, so that all channels fire at the set angle
+        if( (configPage15.ignTrimEnabled == true) && !BIT_CHECK(currentStatus.engine, BIT_ENGINE_CRANK) && (configPage2.fixAngEnable == 0) )
         {
-          currentStatus.dwell =  (configPage4.dwellRun * 100U); //use fixed running dwell
+          calculateIgnitionTrims();
+          trimIgnitionAngles();
         }
-      }
-      currentStatus.dwell = correctionsDwell(currentStatus.dwell);
+        else { resetIgnitionTrims(); }
 
-      // Convert the dwell time to dwell angle based on the current engine speed
-      calculateIgnitionAngles(timeToAngleDegPerMicroSec(currentStatus.dwell));
+        //Closed loop dwell is not used while cranking, where the dwell can be extended for the fixed cranking timing
+        if( (configPage15.dwellClosedLoop == true) && !BIT_CHECK(currentStatus.engine, BIT_ENGINE_CRANK) )
+        {
+          updateDwellTrims(currentStatus.dwell);
+          trimIgnitionStartAngles();
+        }
+        else { resetDwellTrims(); }
 
-      //If ignition timing is being tracked per tooth, perform the calcs to get the end teeth
-      //This only needs to be run if the advance figure has changed, otherwise the end teeth will still be the same
-      //if( (configPage2.perToothIgn == true) && (lastToothCalcAdvance != currentStatus.advance) ) { triggerSetEndTeeth(); }
-      if( (configPage2.perToothIgn == true) ) { triggerSetEndTeeth(); }
+        //If ignition timing is being tracked per tooth, perform the calcs to get the end teeth
+        //This only needs to be run if the advance figure has changed, otherwise the end teeth will still be the same
+        //if( (configPage2.perToothIgn == true) && (lastToothCalcAdvance != currentStatus.advance) ) { triggerSetEndTeeth(); }
+        if( (configPage2.perToothIgn == true) ) { triggerSetEndTeeth(); }
+      }
 
       //***********************************************************************************************
       //| BEGIN FUEL SCHEDULES
@@ -794,6 +912,8 @@ void __attribute__((always_inline)) loop(void)
       maxAllowedRPM = maxAllowedRPM * 100; //All of the above limits are divided by 100, convert back to RPM
       if ( (currentStatus.flatShiftingHard == true) && (currentStatus.clutchEngagedRPM < maxAllowedRPM) ) { maxAllowedRPM = currentStatus.clutchEngagedRPM; } //Flat shifting is a special case as the RPM limit is based on when the clutch was engaged. It is not divided by 100 as it is set with the actual RPM
     
+      uint16_t limiterRPM = getLimiterRPM(); //Either the current RPM or, if the predictive limiter is enabled, the RPM predicted 1 cycle ahead
+
       if( (configPage2.hardCutType == HARD_CUT_FULL) && (currentStatus.RPM > maxAllowedRPM) )
       {
         //Full hard cut turns outputs off completely. 
@@ -821,7 +941,8 @@ void __attribute__((always_inline)) loop(void)
             break;
         }
       } //Hard cut check
-      else if( (configPage2.hardCutType == HARD_CUT_ROLLING) && (currentStatus.RPM > (maxAllowedRPM + (configPage15.rollingProtRPMDelta[0] * 10))) ) //Limit for rolling is the max allowed RPM minus the lowest value in the delta table (Delta values are negative!)
+      else if( ((configPage2.hardCutType == HARD_CUT_ROLLING) && (limiterRPM > (maxAllowedRPM + (configPage15.rollingProtRPMDelta[0] * 10)))) //Limit for rolling is the max allowed RPM minus the lowest value in the delta table (Delta values are negative!)
+            || ((configPage15.revLimitPredict == true) && (limiterRPM > maxAllowedRPM)) ) //Predictive full cut is performed as a proportional rolling cut until the current RPM reaches the limit
       { 
         uint8_t revolutionsToCut = 1;
         if(configPage2.strokes == FOUR_STROKE) { revolutionsToCut *= 2; } //4 stroke needs to cut for at least 2 revolutions
@@ -831,8 +952,9 @@ void __attribute__((always_inline)) loop(void)
         if ( (currentStatus.startRevolutions >= (rollingCutLastRev + revolutionsToCut)) || (currentStatus.RPM > maxAllowedRPM) ) //If current RPM is over the max allowed RPM always cut, otherwise check if the required number of revolutions have passed since the last cut
         { 
           uint8_t cutPercent = 0;
-          int16_t rpmDelta = currentStatus.RPM - maxAllowedRPM;
-          if(rpmDelta >= 0) { cutPercent = 100; } //If the current RPM is over the max allowed RPM then cut is full (100%)
+          int16_t rpmDelta = limiterRPM - maxAllowedRPM;
+          if(currentStatus.RPM >= maxAllowedRPM) { cutPercent = 100; } //If the current RPM is over the max allowed RPM then cut is full (100%)
+          else if(rpmDelta >= 0) { cutPercent = predictiveLimitPercent(currentStatus.RPM, limiterRPM, maxAllowedRPM); } //Predictive mode only. RPM is below the limit but will pass it within 1 cycle. Cut the portion of the predicted rise that is over the limit
           else { cutPercent = table2D_getValue(&rollingCutTable, (rpmDelta / 10) ); } //
           
 
@@ -907,127 +1029,172 @@ void __attribute__((always_inline)) loop(void)
       }
 
 
-#if INJ_CHANNELS >= 1
-      if( (maxInjOutputs >= 1) && (currentStatus.PW1 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ1_CMD_BIT)) )
+      //With angle arming, the main loop only publishes the start angles and the trigger interrupt arms each schedule from the tooth just before its start (See angleArming.h)
+      //The loop still arms the schedules while cranking, where the start angles are adjusted for the fixed cranking timing, and with decoders whose tooth angles the interrupt can't work out
+      const bool armedByDecoder = (configPage15.angleArming == true) && BIT_CHECK(decoderState, BIT_DECODER_UNIFORM_TEETH) && !BIT_CHECK(currentStatus.engine, BIT_ENGINE_CRANK);
+      if(armedByDecoder == true)
       {
-        uint32_t timeOut = calculateInjectorTimeout(fuelSchedule1, channel1InjDegrees, injector1StartAngle, crankAngle);
-        if (timeOut>0U)
+        setFuelArmingTarget(INJ1_CMD_BIT, (maxInjOutputs >= 1) && (currentStatus.PW1 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ1_CMD_BIT)), injector1StartAngle, currentStatus.PW1);
+        setFuelArmingTarget(INJ2_CMD_BIT, (maxInjOutputs >= 2) && (currentStatus.PW2 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ2_CMD_BIT)), injector2StartAngle, currentStatus.PW2);
+        setFuelArmingTarget(INJ3_CMD_BIT, (maxInjOutputs >= 3) && (currentStatus.PW3 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ3_CMD_BIT)), injector3StartAngle, currentStatus.PW3);
+        setFuelArmingTarget(INJ4_CMD_BIT, (maxInjOutputs >= 4) && (currentStatus.PW4 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ4_CMD_BIT)), injector4StartAngle, currentStatus.PW4);
+#if INJ_CHANNELS >= 5
+        setFuelArmingTarget(INJ5_CMD_BIT, (maxInjOutputs >= 5) && (currentStatus.PW5 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ5_CMD_BIT)), injector5StartAngle, currentStatus.PW5);
+#endif
+#if INJ_CHANNELS >= 6
+        setFuelArmingTarget(INJ6_CMD_BIT, (maxInjOutputs >= 6) && (currentStatus.PW6 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ6_CMD_BIT)), injector6StartAngle, currentStatus.PW6);
+#endif
+#if INJ_CHANNELS >= 7
+        setFuelArmingTarget(INJ7_CMD_BIT, (maxInjOutputs >= 7) && (currentStatus.PW7 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ7_CMD_BIT)), injector7StartAngle, currentStatus.PW7);
+#endif
+#if INJ_CHANNELS >= 8
+        setFuelArmingTarget(INJ8_CMD_BIT, (maxInjOutputs >= 8) && (currentStatus.PW8 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ8_CMD_BIT)), injector8StartAngle, currentStatus.PW8);
+#endif
+
+        setIgnitionArmingTarget(IGN1_CMD_BIT, BIT_CHECK(ignitionChannelsOn, IGN1_CMD_BIT), ignition1StartAngle, getTrimmedDwell(IGN1_CMD_BIT));
+        setIgnitionArmingTarget(IGN2_CMD_BIT, (maxIgnOutputs >= 2) && (BIT_CHECK(ignitionChannelsOn, IGN2_CMD_BIT)), ignition2StartAngle, getTrimmedDwell(IGN2_CMD_BIT));
+        setIgnitionArmingTarget(IGN3_CMD_BIT, (maxIgnOutputs >= 3) && (BIT_CHECK(ignitionChannelsOn, IGN3_CMD_BIT)), ignition3StartAngle, getTrimmedDwell(IGN3_CMD_BIT));
+        setIgnitionArmingTarget(IGN4_CMD_BIT, (maxIgnOutputs >= 4) && (BIT_CHECK(ignitionChannelsOn, IGN4_CMD_BIT)), ignition4StartAngle, getTrimmedDwell(IGN4_CMD_BIT));
+#if IGN_CHANNELS >= 5
+        setIgnitionArmingTarget(IGN5_CMD_BIT, (maxIgnOutputs >= 5) && (BIT_CHECK(ignitionChannelsOn, IGN5_CMD_BIT)), ignition5StartAngle, getTrimmedDwell(IGN5_CMD_BIT));
+#endif
+#if IGN_CHANNELS >= 6
+        setIgnitionArmingTarget(IGN6_CMD_BIT, (maxIgnOutputs >= 6) && (BIT_CHECK(ignitionChannelsOn, IGN6_CMD_BIT)), ignition6StartAngle, getTrimmedDwell(IGN6_CMD_BIT));
+#endif
+#if IGN_CHANNELS >= 7
+        setIgnitionArmingTarget(IGN7_CMD_BIT, (maxIgnOutputs >= 7) && (BIT_CHECK(ignitionChannelsOn, IGN7_CMD_BIT)), ignition7StartAngle, getTrimmedDwell(IGN7_CMD_BIT));
+#endif
+#if IGN_CHANNELS >= 8
+        setIgnitionArmingTarget(IGN8_CMD_BIT, (maxIgnOutputs >= 8) && (BIT_CHECK(ignitionChannelsOn, IGN8_CMD_BIT)), ignition8StartAngle, getTrimmedDwell(IGN8_CMD_BIT));
+#endif
+        publishArmingTargets();
+      }
+      else
+      {
+        stopAngleArming();
+
+#if INJ_CHANNELS >= 1
+        if( (maxInjOutputs >= 1) && (currentStatus.PW1 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ1_CMD_BIT)) )
         {
-            setFuelSchedule(fuelSchedule1, 
-                      timeOut,
-                      (unsigned long)currentStatus.PW1
-                      );
+          uint32_t timeOut = calculateInjectorTimeout(fuelSchedule1, channel1InjDegrees, injector1StartAngle, crankAngle);
+          if (timeOut>0U)
+          {
+              setFuelSchedule(fuelSchedule1, 
+                        timeOut,
+                        (unsigned long)currentStatus.PW1
+                        );
+          }
         }
-      }
 #endif
 
-        /*-----------------------------------------------------------------------------------------
-        | A Note on tempCrankAngle and tempStartAngle:
-        |   The use of tempCrankAngle/tempStartAngle is described below. It is then used in the same way for channels 2, 3 and 4+ on both injectors and ignition
-        |   Essentially, these 2 variables are used to realign the current crank angle and the desired start angle around 0 degrees for the given cylinder/output
-        |   Eg: If cylinder 2 TDC is 180 degrees after cylinder 1 (Eg a standard 4 cylinder engine), then tempCrankAngle is 180* less than the current crank angle and
-        |       tempStartAngle is the desired open time less 180*. Thus the cylinder is being treated relative to its own TDC, regardless of its offset
-        |
-        |   This is done to avoid problems with very short of very long times until tempStartAngle.
-        |------------------------------------------------------------------------------------------
-        */
+          /*-----------------------------------------------------------------------------------------
+          | A Note on tempCrankAngle and tempStartAngle:
+          |   The use of tempCrankAngle/tempStartAngle is described below. It is then used in the same way for channels 2, 3 and 4+ on both injectors and ignition
+          |   Essentially, these 2 variables are used to realign the current crank angle and the desired start angle around 0 degrees for the given cylinder/output
+          |   Eg: If cylinder 2 TDC is 180 degrees after cylinder 1 (Eg a standard 4 cylinder engine), then tempCrankAngle is 180* less than the current crank angle and
+          |       tempStartAngle is the desired open time less 180*. Thus the cylinder is being treated relative to its own TDC, regardless of its offset
+          |
+          |   This is done to avoid problems with very short of very long times until tempStartAngle.
+          |------------------------------------------------------------------------------------------
+          */
 #if INJ_CHANNELS >= 2
-        if( (maxInjOutputs >= 2) && (currentStatus.PW2 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ2_CMD_BIT)) )
-        {
-          uint32_t timeOut = calculateInjectorTimeout(fuelSchedule2, channel2InjDegrees, injector2StartAngle, crankAngle);
-          if ( timeOut>0U )
+          if( (maxInjOutputs >= 2) && (currentStatus.PW2 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ2_CMD_BIT)) )
           {
-            setFuelSchedule(fuelSchedule2, 
-                      timeOut,
-                      (unsigned long)currentStatus.PW2
-                      );
+            uint32_t timeOut = calculateInjectorTimeout(fuelSchedule2, channel2InjDegrees, injector2StartAngle, crankAngle);
+            if ( timeOut>0U )
+            {
+              setFuelSchedule(fuelSchedule2, 
+                        timeOut,
+                        (unsigned long)currentStatus.PW2
+                        );
+            }
           }
-        }
 #endif
 
 #if INJ_CHANNELS >= 3
-        if( (maxInjOutputs >= 3) && (currentStatus.PW3 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ3_CMD_BIT)) )
-        {
-          uint32_t timeOut = calculateInjectorTimeout(fuelSchedule3, channel3InjDegrees, injector3StartAngle, crankAngle);
-          if ( timeOut>0U )
+          if( (maxInjOutputs >= 3) && (currentStatus.PW3 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ3_CMD_BIT)) )
           {
-            setFuelSchedule(fuelSchedule3, 
-                      timeOut,
-                      (unsigned long)currentStatus.PW3
-                      );
+            uint32_t timeOut = calculateInjectorTimeout(fuelSchedule3, channel3InjDegrees, injector3StartAngle, crankAngle);
+            if ( timeOut>0U )
+            {
+              setFuelSchedule(fuelSchedule3, 
+                        timeOut,
+                        (unsigned long)currentStatus.PW3
+                        );
+            }
           }
-        }
 #endif
 
 #if INJ_CHANNELS >= 4
-        if( (maxInjOutputs >= 4) && (currentStatus.PW4 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ4_CMD_BIT)) )
-        {
-          uint32_t timeOut = calculateInjectorTimeout(fuelSchedule4, channel4InjDegrees, injector4StartAngle, crankAngle);
-          if ( timeOut>0U )
+          if( (maxInjOutputs >= 4) && (currentStatus.PW4 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ4_CMD_BIT)) )
           {
-            setFuelSchedule(fuelSchedule4, 
-                      timeOut,
-                      (unsigned long)currentStatus.PW4
-                      );
+            uint32_t timeOut = calculateInjectorTimeout(fuelSchedule4, channel4InjDegrees, injector4StartAngle, crankAngle);
+            if ( timeOut>0U )
+            {
+              setFuelSchedule(fuelSchedule4, 
+                        timeOut,
+                        (unsigned long)currentStatus.PW4
+                        );
+            }
           }
-        }
 #endif
 
 #if INJ_CHANNELS >= 5
-        if( (maxInjOutputs >= 5) && (currentStatus.PW5 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ5_CMD_BIT)) )
-        {
-          uint32_t timeOut = calculateInjectorTimeout(fuelSchedule5, channel5InjDegrees, injector5StartAngle, crankAngle);
-          if ( timeOut>0U )
+          if( (maxInjOutputs >= 5) && (currentStatus.PW5 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ5_CMD_BIT)) )
           {
-            setFuelSchedule(fuelSchedule5, 
-                      timeOut,
-                      (unsigned long)currentStatus.PW5
-                      );
+            uint32_t timeOut = calculateInjectorTimeout(fuelSchedule5, channel5InjDegrees, injector5StartAngle, crankAngle);
+            if ( timeOut>0U )
+            {
+              setFuelSchedule(fuelSchedule5, 
+                        timeOut,
+                        (unsigned long)currentStatus.PW5
+                        );
+            }
           }
-        }
 #endif
 
 #if INJ_CHANNELS >= 6
-        if( (maxInjOutputs >= 6) && (currentStatus.PW6 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ6_CMD_BIT)) )
-        {
-          uint32_t timeOut = calculateInjectorTimeout(fuelSchedule6, channel6InjDegrees, injector6StartAngle, crankAngle);
-          if ( timeOut>0U )
+          if( (maxInjOutputs >= 6) && (currentStatus.PW6 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ6_CMD_BIT)) )
           {
-            setFuelSchedule(fuelSchedule6, 
-                      timeOut,
-                      (unsigned long)currentStatus.PW6
-                      );
+            uint32_t timeOut = calculateInjectorTimeout(fuelSchedule6, channel6InjDegrees, injector6StartAngle, crankAngle);
+            if ( timeOut>0U )
+            {
+              setFuelSchedule(fuelSchedule6, 
+                        timeOut,
+                        (unsigned long)currentStatus.PW6
+                        );
+            }
           }
-        }
 #endif
 
 #if INJ_CHANNELS >= 7
-        if( (maxInjOutputs >= 7) && (currentStatus.PW7 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ7_CMD_BIT)) )
-        {
-          uint32_t timeOut = calculateInjectorTimeout(fuelSchedule7, channel7InjDegrees, injector7StartAngle, crankAngle);
-          if ( timeOut>0U )
+          if( (maxInjOutputs >= 7) && (currentStatus.PW7 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ7_CMD_BIT)) )
           {
-            setFuelSchedule(fuelSchedule7, 
-                      timeOut,
-                      (unsigned long)currentStatus.PW7
-                      );
+            uint32_t timeOut = calculateInjectorTimeout(fuelSchedule7, channel7InjDegrees, injector7StartAngle, crankAngle);
+            if ( timeOut>0U )
+            {
+              setFuelSchedule(fuelSchedule7, 
+                        timeOut,
+                        (unsigned long)currentStatus.PW7
+                        );
+            }
           }
-        }
 #endif
 
 #if INJ_CHANNELS >= 8
-        if( (maxInjOutputs >= 8) && (currentStatus.PW8 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ8_CMD_BIT)) )
-        {
-          uint32_t timeOut = calculateInjectorTimeout(fuelSchedule8, channel8InjDegrees, injector8StartAngle, crankAngle);
-          if ( timeOut>0U )
+          if( (maxInjOutputs >= 8) && (currentStatus.PW8 >= inj_opentime_uS) && (BIT_CHECK(fuelChannelsOn, INJ8_CMD_BIT)) )
           {
-            setFuelSchedule(fuelSchedule8, 
-                      timeOut,
-                      (unsigned long)currentStatus.PW8
-                      );
+            uint32_t timeOut = calculateInjectorTimeout(fuelSchedule8, channel8InjDegrees, injector8StartAngle, crankAngle);
+            if ( timeOut>0U )
+            {
+              setFuelSchedule(fuelSchedule8, 
+                        timeOut,
+                        (unsigned long)currentStatus.PW8
+                        );
+            }
           }
-        }
 #endif
+      }
 
       //***********************************************************************************************
       //| BEGIN IGNITION SCHEDULES
@@ -1038,7 +1205,7 @@ void __attribute__((always_inline)) loop(void)
       {
         fixedCrankingOverride = currentStatus.dwell * 3;
         //This is a safety step to prevent the ignition start time occurring AFTER the target tooth pulse has already occurred. It simply moves the start time forward a little, which is compensated for by the increase in the dwell time
-        if(currentStatus.RPM < 250)
+        if( (currentStatus.RPM < 250) && (recalculateFuelIgn == true) ) //Only when the angles have just been calculated, otherwise they would be moved again every loop
         {
           ignition1StartAngle -= 5;
           ignition2StartAngle -= 5;
@@ -1066,122 +1233,130 @@ void __attribute__((always_inline)) loop(void)
         //ignition1StartAngle = 335;
         crankAngle = ignitionLimits(getCrankAngle()); //Refresh the crank angle info
 
-#if IGN_CHANNELS >= 1
-        uint32_t timeOut = calculateIgnitionTimeout(ignitionSchedule1, ignition1StartAngle, channel1IgnDegrees, crankAngle);
-        if ( (timeOut > 0U) && (BIT_CHECK(ignitionChannelsOn, IGN1_CMD_BIT)) )
+        if(armedByDecoder == false)
         {
-          setIgnitionSchedule(ignitionSchedule1, timeOut,
-                    currentStatus.dwell + fixedCrankingOverride);
-        }
+#if IGN_CHANNELS >= 1
+          uint32_t timeOut = calculateIgnitionTimeout(ignitionSchedule1, ignition1StartAngle, channel1IgnDegrees, crankAngle);
+          if ( (timeOut > 0U) && (BIT_CHECK(ignitionChannelsOn, IGN1_CMD_BIT)) )
+          {
+            setIgnitionSchedule(ignitionSchedule1, timeOut,
+                      getTrimmedDwell(IGN1_CMD_BIT) + fixedCrankingOverride);
+          }
 #endif
-
-#if defined(USE_IGN_REFRESH)
-        if( (ignitionSchedule1.Status == RUNNING) && (ignition1EndAngle > crankAngle) && (configPage4.StgCycles == 0) && (configPage2.perToothIgn != true) )
-        {
-          unsigned long uSToEnd = 0;
-
-          crankAngle = ignitionLimits(getCrankAngle()); //Refresh the crank angle info
-          
-          //ONLY ONE OF THE BELOW SHOULD BE USED (PROBABLY THE FIRST):
-          //*********
-          if(ignition1EndAngle > crankAngle) { uSToEnd = angleToTimeMicroSecPerDegree( (ignition1EndAngle - crankAngle) ); }
-          else { uSToEnd = angleToTimeMicroSecPerDegree( (360 + ignition1EndAngle - crankAngle) ); }
-          //*********
-          //uSToEnd = ((ignition1EndAngle - crankAngle) * (toothLastToothTime - toothLastMinusOneToothTime)) / triggerToothAngle;
-          //*********
-
-          refreshIgnitionSchedule1( uSToEnd + fixedCrankingOverride );
-        }
-  #endif
         
 #if IGN_CHANNELS >= 2
-        if (maxIgnOutputs >= 2)
-        {
-            unsigned long ignition2StartTime = calculateIgnitionTimeout(ignitionSchedule2, ignition2StartAngle, channel2IgnDegrees, crankAngle);
+          if (maxIgnOutputs >= 2)
+          {
+              unsigned long ignition2StartTime = calculateIgnitionTimeout(ignitionSchedule2, ignition2StartAngle, channel2IgnDegrees, crankAngle);
 
-            if ( (ignition2StartTime > 0) && (BIT_CHECK(ignitionChannelsOn, IGN2_CMD_BIT)) )
-            {
-              setIgnitionSchedule(ignitionSchedule2, ignition2StartTime,
-                        currentStatus.dwell + fixedCrankingOverride);
-            }
-        }
+              if ( (ignition2StartTime > 0) && (BIT_CHECK(ignitionChannelsOn, IGN2_CMD_BIT)) )
+              {
+                setIgnitionSchedule(ignitionSchedule2, ignition2StartTime,
+                          getTrimmedDwell(IGN2_CMD_BIT) + fixedCrankingOverride);
+              }
+          }
 #endif
 
 #if IGN_CHANNELS >= 3
-        if (maxIgnOutputs >= 3)
-        {
-            unsigned long ignition3StartTime = calculateIgnitionTimeout(ignitionSchedule3, ignition3StartAngle, channel3IgnDegrees, crankAngle);
+          if (maxIgnOutputs >= 3)
+          {
+              unsigned long ignition3StartTime = calculateIgnitionTimeout(ignitionSchedule3, ignition3StartAngle, channel3IgnDegrees, crankAngle);
 
-            if ( (ignition3StartTime > 0) && (BIT_CHECK(ignitionChannelsOn, IGN3_CMD_BIT)) )
-            {
-              setIgnitionSchedule(ignitionSchedule3, ignition3StartTime,
-                        currentStatus.dwell + fixedCrankingOverride);
-            }
-        }
+              if ( (ignition3StartTime > 0) && (BIT_CHECK(ignitionChannelsOn, IGN3_CMD_BIT)) )
+              {
+                setIgnitionSchedule(ignitionSchedule3, ignition3StartTime,
+                          getTrimmedDwell(IGN3_CMD_BIT) + fixedCrankingOverride);
+              }
+          }
 #endif
 
 #if IGN_CHANNELS >= 4
-        if (maxIgnOutputs >= 4)
-        {
-            unsigned long ignition4StartTime = calculateIgnitionTimeout(ignitionSchedule4, ignition4StartAngle, channel4IgnDegrees, crankAngle);
+          if (maxIgnOutputs >= 4)
+          {
+              unsigned long ignition4StartTime = calculateIgnitionTimeout(ignitionSchedule4, ignition4StartAngle, channel4IgnDegrees, crankAngle);
 
-            if ( (ignition4StartTime > 0) && (BIT_CHECK(ignitionChannelsOn, IGN4_CMD_BIT)) )
-            {
-              setIgnitionSchedule(ignitionSchedule4, ignition4StartTime,
-                        currentStatus.dwell + fixedCrankingOverride);
-            }
-        }
+              if ( (ignition4StartTime > 0) && (BIT_CHECK(ignitionChannelsOn, IGN4_CMD_BIT)) )
+              {
+                setIgnitionSchedule(ignitionSchedule4, ignition4StartTime,
+                          getTrimmedDwell(IGN4_CMD_BIT) + fixedCrankingOverride);
+              }
+          }
 #endif
 
 #if IGN_CHANNELS >= 5
-        if (maxIgnOutputs >= 5)
-        {
-            unsigned long ignition5StartTime = calculateIgnitionTimeout(ignitionSchedule5, ignition5StartAngle, channel5IgnDegrees, crankAngle);
+          if (maxIgnOutputs >= 5)
+          {
+              unsigned long ignition5StartTime = calculateIgnitionTimeout(ignitionSchedule5, ignition5StartAngle, channel5IgnDegrees, crankAngle);
 
-            if ( (ignition5StartTime > 0) && (BIT_CHECK(ignitionChannelsOn, IGN5_CMD_BIT)) )
-            {
-              setIgnitionSchedule(ignitionSchedule5, ignition5StartTime,
-                        currentStatus.dwell + fixedCrankingOverride);
-            }
-        }
+              if ( (ignition5StartTime > 0) && (BIT_CHECK(ignitionChannelsOn, IGN5_CMD_BIT)) )
+              {
+                setIgnitionSchedule(ignitionSchedule5, ignition5StartTime,
+                          getTrimmedDwell(IGN5_CMD_BIT) + fixedCrankingOverride);
+              }
+          }
 #endif
 
 #if IGN_CHANNELS >= 6
-        if (maxIgnOutputs >= 6)
-        {
-            unsigned long ignition6StartTime = calculateIgnitionTimeout(ignitionSchedule6, ignition6StartAngle, channel6IgnDegrees, crankAngle);
+          if (maxIgnOutputs >= 6)
+          {
+              unsigned long ignition6StartTime = calculateIgnitionTimeout(ignitionSchedule6, ignition6StartAngle, channel6IgnDegrees, crankAngle);
 
-            if ( (ignition6StartTime > 0) && (BIT_CHECK(ignitionChannelsOn, IGN6_CMD_BIT)) )
-            {
-              setIgnitionSchedule(ignitionSchedule6, ignition6StartTime,
-                        currentStatus.dwell + fixedCrankingOverride);
-            }
-        }
+              if ( (ignition6StartTime > 0) && (BIT_CHECK(ignitionChannelsOn, IGN6_CMD_BIT)) )
+              {
+                setIgnitionSchedule(ignitionSchedule6, ignition6StartTime,
+                          getTrimmedDwell(IGN6_CMD_BIT) + fixedCrankingOverride);
+              }
+          }
 #endif
 
 #if IGN_CHANNELS >= 7
-        if (maxIgnOutputs >= 7)
-        {
-            unsigned long ignition7StartTime = calculateIgnitionTimeout(ignitionSchedule7, ignition7StartAngle, channel7IgnDegrees, crankAngle);
+          if (maxIgnOutputs >= 7)
+          {
+              unsigned long ignition7StartTime = calculateIgnitionTimeout(ignitionSchedule7, ignition7StartAngle, channel7IgnDegrees, crankAngle);
 
-            if ( (ignition7StartTime > 0) && (BIT_CHECK(ignitionChannelsOn, IGN7_CMD_BIT)) )
-            {
-              setIgnitionSchedule(ignitionSchedule7, ignition7StartTime,
-                        currentStatus.dwell + fixedCrankingOverride);
-            }
-        }
+              if ( (ignition7StartTime > 0) && (BIT_CHECK(ignitionChannelsOn, IGN7_CMD_BIT)) )
+              {
+                setIgnitionSchedule(ignitionSchedule7, ignition7StartTime,
+                          getTrimmedDwell(IGN7_CMD_BIT) + fixedCrankingOverride);
+              }
+          }
 #endif
 
 #if IGN_CHANNELS >= 8
-        if (maxIgnOutputs >= 8)
-        {
-            unsigned long ignition8StartTime = calculateIgnitionTimeout(ignitionSchedule8, ignition8StartAngle, channel8IgnDegrees, crankAngle);
+          if (maxIgnOutputs >= 8)
+          {
+              unsigned long ignition8StartTime = calculateIgnitionTimeout(ignitionSchedule8, ignition8StartAngle, channel8IgnDegrees, crankAngle);
 
-            if ( (ignition8StartTime > 0) && (BIT_CHECK(ignitionChannelsOn, IGN8_CMD_BIT)) )
-            {
-              setIgnitionSchedule(ignitionSchedule8, ignition8StartTime,
-                        currentStatus.dwell + fixedCrankingOverride);
-            }
+              if ( (ignition8StartTime > 0) && (BIT_CHECK(ignitionChannelsOn, IGN8_CMD_BIT)) )
+              {
+                setIgnitionSchedule(ignitionSchedule8, ignition8StartTime,
+                          getTrimmedDwell(IGN8_CMD_BIT) + fixedCrankingOverride);
+              }
+          }
+#endif
+        }
+
+#if defined(USE_IGN_REFRESH)
+        //Bring the spark of any coil that is charging forward to the latest crank angle. Not needed when the decoder does this on each coil's end tooth
+        if( (configPage4.StgCycles == 0) && (configPage2.perToothIgn != true) && (fixedCrankingOverride == 0) )
+        {
+          crankAngle = ignitionLimits(getCrankAngle()); //Refresh the crank angle info
+          refreshIgnitionEndAngle(ignitionSchedule1, ignition1EndAngle, crankAngle);
+          refreshIgnitionEndAngle(ignitionSchedule2, ignition2EndAngle, crankAngle);
+          refreshIgnitionEndAngle(ignitionSchedule3, ignition3EndAngle, crankAngle);
+          refreshIgnitionEndAngle(ignitionSchedule4, ignition4EndAngle, crankAngle);
+#if IGN_CHANNELS >= 5
+          refreshIgnitionEndAngle(ignitionSchedule5, ignition5EndAngle, crankAngle);
+#endif
+#if IGN_CHANNELS >= 6
+          refreshIgnitionEndAngle(ignitionSchedule6, ignition6EndAngle, crankAngle);
+#endif
+#if IGN_CHANNELS >= 7
+          refreshIgnitionEndAngle(ignitionSchedule7, ignition7EndAngle, crankAngle);
+#endif
+#if IGN_CHANNELS >= 8
+          refreshIgnitionEndAngle(ignitionSchedule8, ignition8EndAngle, crankAngle);
+#endif
         }
 #endif
 
@@ -1344,8 +1519,9 @@ byte getAdvance1(void)
 /** Calculate the Ignition angles for all cylinders (based on @ref config2.nCylinders).
  * both start and end angles are calculated for each channel.
  * Also the mode of ignition firing - wasted spark vs. dedicated spark per cyl. - is considered here.
+ * @param fullSync Whether there is full sync, as read when the fuel was calculated. Sequential angles are only used with full sync
  */
-void calculateIgnitionAngles(uint16_t dwellAngle)
+void calculateIgnitionAngles(uint16_t dwellAngle, bool fullSync)
 {
   //This test for more cylinders and do the same thing
   switch (configPage2.nCylinders)
@@ -1371,7 +1547,7 @@ void calculateIgnitionAngles(uint16_t dwellAngle)
       calculateIgnitionAngle(dwellAngle, channel2IgnDegrees, currentStatus.advance, &ignition2EndAngle, &ignition2StartAngle);
 
       #if IGN_CHANNELS >= 4
-      if((configPage4.sparkMode == IGN_MODE_SEQUENTIAL) && currentStatus.hasSync)
+      if((configPage4.sparkMode == IGN_MODE_SEQUENTIAL) && fullSync)
       {
         if( CRANK_ANGLE_MAX_IGN != 720 ) { changeHalfToFullSync(); }
 
@@ -1410,7 +1586,7 @@ void calculateIgnitionAngles(uint16_t dwellAngle)
       calculateIgnitionAngle(dwellAngle, channel3IgnDegrees, currentStatus.advance, &ignition3EndAngle, &ignition3StartAngle);
 
       #if IGN_CHANNELS >= 6
-      if((configPage4.sparkMode == IGN_MODE_SEQUENTIAL) && currentStatus.hasSync)
+      if((configPage4.sparkMode == IGN_MODE_SEQUENTIAL) && fullSync)
       {
         if( CRANK_ANGLE_MAX_IGN != 720 ) { changeHalfToFullSync(); }
 
@@ -1432,7 +1608,7 @@ void calculateIgnitionAngles(uint16_t dwellAngle)
       calculateIgnitionAngle(dwellAngle, channel4IgnDegrees, currentStatus.advance, &ignition4EndAngle, &ignition4StartAngle);
 
       #if IGN_CHANNELS >= 8
-      if((configPage4.sparkMode == IGN_MODE_SEQUENTIAL) && currentStatus.hasSync)
+      if((configPage4.sparkMode == IGN_MODE_SEQUENTIAL) && fullSync)
       {
         if( CRANK_ANGLE_MAX_IGN != 720 ) { changeHalfToFullSync(); }
 
@@ -1703,7 +1879,7 @@ void checkLaunchAndFlatShift()
     uint16_t launchRPMLimit = (configPage6.lnchHardLim * 100);
     if( (configPage2.hardCutType == HARD_CUT_ROLLING) ) { launchRPMLimit += (configPage15.rollingProtRPMDelta[0] * 10); } //Add the rolling cut delta if enabled (Delta is a negative value)
 
-    if(currentStatus.RPM > launchRPMLimit)
+    if(getLimiterRPM() > launchRPMLimit)
     {
       //HardCut rev limit for 2-step launch control.
       currentStatus.launchingHard = true; 
@@ -1718,7 +1894,7 @@ void checkLaunchAndFlatShift()
       uint16_t flatRPMLimit = currentStatus.clutchEngagedRPM;
       if( (configPage2.hardCutType == HARD_CUT_ROLLING) ) { flatRPMLimit += (configPage15.rollingProtRPMDelta[0] * 10); } //Add the rolling cut delta if enabled (Delta is a negative value)
 
-      if(currentStatus.RPM > flatRPMLimit)
+      if(getLimiterRPM() > flatRPMLimit)
       {
         //Flat shift rev limit
         currentStatus.flatShiftingHard = true;
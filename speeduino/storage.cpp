@@ -56,6 +56,21 @@ void writeAllConfig(void)
   }
 }
 
+/** Adds the RAM overlay deltas to their tables and writes the changed pages (See table3d_overlay.h).
+ * Like writeAllConfig(), the pages that don't fit in this write are finished by the burn pending writes.
+ */
+void commitTableOverlays(void)
+{
+  uint16_t pages = applyTableOverlays();
+  if (pages != 0U) { BIT_SET(currentStatus.status5, BIT_STATUS5_TABLE_REFRESH); }
+  uint8_t pageCount = getPageCount();
+  uint8_t page = 1U;
+  while (page<pageCount && !isEepromWritePending())
+  {
+    if (BIT_CHECK(pages, page)) { writeConfig(page); }
+    page = page + 1;
+  }
+}
 
 //  ================================= Internal write support ===============================
 struct write_location {
@@ -323,6 +338,14 @@ void writeConfig(uint8_t pageNum)
       | Config page 15 (See storage.h for data layout)
       -----------------------------------------------------*/
       result = write_range((byte *)&configPage15, (byte *)&configPage15+sizeof(configPage15), result.changeWriteAddress(EEPROM_CONFIG15_START));
+
+      /*---------------------------------------------------
+      | Ignition trim tables (See storage.h for data layout)
+      | Table 1 is the 4x4 table itself + the 4 values along each of the axis
+      | Tables 2-8 are only the values, they use the axes of table 1
+      -----------------------------------------------------*/
+      result = writeTable(&ignTrim1Table, decltype(ignTrim1Table)::type_key, result.changeWriteAddress(EEPROM_CONFIG15_IGNTRIM1));
+      result = write_range((byte *)ignTrimValues, (byte *)ignTrimValues+sizeof(ignTrimValues), result.changeWriteAddress(EEPROM_CONFIG15_IGNTRIM_VALUES));
       break;
 
     default:
@@ -480,6 +503,10 @@ void loadConfig(void)
   loadTable(&boostTableLookupDuty, decltype(boostTableLookupDuty)::type_key, EEPROM_CONFIG15_MAP);
   load_range(EEPROM_CONFIG15_START, (byte *)&configPage15, (byte *)&configPage15+sizeof(configPage15));  
 
+  //Ignition trim tables
+  loadTable(&ignTrim1Table, decltype(ignTrim1Table)::type_key, EEPROM_CONFIG15_IGNTRIM1);
+  load_range(EEPROM_CONFIG15_IGNTRIM_VALUES, (byte *)ignTrimValues, (byte *)ignTrimValues+sizeof(ignTrimValues));
+
   //*********************************************************************************************************************************************************************************
 }
 
@@ -103,8 +103,15 @@
  * | 3282       |1           | boostDCWhenDisabled                  |                                    |
  * | 3283       |1           | boostControlEnableThreshold          |                                    |
  * | 3284       |14          | A/C Control Settings                 |                                    |
- * | 3298       |159         | Page 15 spare                        |                                    |
- * | 3457       |217         | EMPTY                                |                                    |
+ * | 3298       |19          | Page 15 settings                     |                                    |
+ * | 3317       |128         | Dwell trim tables (8x 4x4)           |                                    |
+ * | 3445       |12          | Page 15 spare                        |                                    |
+ * | 3457       |2           | X and Y sizes ignTrim1 table         |                                    |
+ * | 3459       |16          | Ignition trim1 table (4x4)           | @ref EEPROM_CONFIG15_IGNTRIM1      |
+ * | 3475       |4           | Ignition trim1 table (X axis) (RPM)  |                                    |
+ * | 3479       |4           | Ignition trim1 table (Y axis) (Load) |                                    |
+ * | 3483       |112         | Ignition trim2-8 values (7x 4x4)     | @ref EEPROM_CONFIG15_IGNTRIM_VALUES|
+ * | 3595       |79          | EMPTY                                |                                    |
  * | 3674       |4           | CLT Calibration CRC32                |                                    |
  * | 3678       |4           | IAT Calibration CRC32                |                                    |
  * | 3682       |4           | O2 Calibration CRC32                 |                                    |
@@ -122,6 +129,7 @@
 
 void writeAllConfig(void);
 void writeConfig(uint8_t pageNum);
+void commitTableOverlays(void);
 void EEPROMWriteRaw(uint16_t address, uint8_t data);
 uint8_t EEPROMReadRaw(uint16_t address);
 void loadConfig(void);
@@ -185,6 +193,8 @@ extern uint32_t deferEEPROMWritesUntil;
 #define EEPROM_CONFIG15_MAP   3199
 #define EEPROM_CONFIG15_START 3281
 #define EEPROM_CONFIG15_END   3457
+#define EEPROM_CONFIG15_IGNTRIM1 3459
+#define EEPROM_CONFIG15_IGNTRIM_VALUES 3483
 
 
 #define EEPROM_CALIBRATION_CLT_CRC  3674
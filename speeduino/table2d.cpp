@@ -20,8 +20,7 @@ static void construct2dTable(table2D &table, uint8_t valueSize, uint8_t axisSize
   table.values = values;
   table.axisX = bins;
   table.lastInput = INT16_MAX;
-  table.lastXMax = INT16_MAX;
-  table.lastXMin = INT16_MAX;
+  table.lastXMax = 0;
 }
 
 void construct2dTable(table2D &table, uint8_t length, uint8_t *values, uint8_t *bins) {
@@ -92,12 +91,17 @@ int table2D_getValue(struct table2D *fromTable, int X_in)
     fromTable->cacheTime = getCacheTime(); //As we're not using the cache value, set the current secl value to track when this new value was calculated
 
     //1st check is whether we're still in the same X bin as last time
-    xMaxValue = table2D_getAxisValue(fromTable, fromTable->lastXMax);
-    xMinValue = table2D_getAxisValue(fromTable, fromTable->lastXMin);
-    if ( (X <= xMaxValue) && (X > xMinValue) )
+    bool sameBin = false;
+    if ( (fromTable->lastXMax > 0U) && (fromTable->lastXMax < fromTable->xSize) )
+    {
+      xMaxValue = table2D_getAxisValue(fromTable, fromTable->lastXMax);
+      xMinValue = table2D_getAxisValue(fromTable, fromTable->lastXMax - 1U);
+      sameBin = (X <= xMaxValue) && (X > xMinValue);
+    }
+    if (sameBin == true)
     {
       xMax = fromTable->lastXMax;
-      xMin = fromTable->lastXMin;
+      xMin = xMax - 1;
     }
     else
     {
@@ -120,7 +124,6 @@ int table2D_getValue(struct table2D *fromTable, int X_in)
           xMax = x;
           fromTable->lastXMax = xMax;
           xMin = x-1;
-          fromTable->lastXMin = xMin;
           break;
         }
         // Otherwise, continue to next bin
@@ -16,23 +16,20 @@ The valueSize variable should be set to either 8 or 16 to indicate this BEFORE t
 */
 struct table2D {
   //Used 5414 RAM with original version
-  byte valueSize;
-  byte axisSize;
-  byte xSize;
-
+  //The pointers and 16 bit members are first so that no padding is needed on 32 bit boards
   void *values;
   void *axisX;
 
-  //int16_t *values16;
-  //int16_t *axisX16;
-
-  //Store the last X and Y coordinates in the table. This is used to make the next check faster
-  int16_t lastXMax;
-  int16_t lastXMin;
-
   //Store the last input and output for caching
   int16_t lastInput;
   int16_t lastOutput;
+
+  byte valueSize;
+  byte axisSize;
+  byte xSize;
+
+  //Store the upper bin of the last X lookup (The lower bin is always 1 below it). This is used to make the next check faster. 0 means there is no last bin
+  byte lastXMax;
   byte cacheTime; //Tracks when the last cache value was set so it can expire after x seconds. A timeout is required to pickup when a tuning value is changed, otherwise the old cached value will continue to be returned as the X value isn't changing. 
 };
 
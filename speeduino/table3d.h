@@ -46,6 +46,7 @@
 #pragma once
 
 #include "table3d_interpolate.h"
+#include "table3d_overlay.h"
 #include "table3d_axes.h"
 #include "table3d_values.h"
 
@@ -103,6 +104,42 @@ TABLE3D_GENERATOR(TABLE3D_GEN_TYPE)
     } 
 TABLE3D_GENERATOR(TABLE3D_GEN_GET_TABLE_VALUE)
 
+// Generate get3DTableLookupContext() & interpolate3DTableValue() functions
+#define TABLE3D_GEN_LOOKUP_CONTEXT(size, xDom, yDom) \
+    static inline void get3DTableLookupContext(TABLE3D_TYPENAME_BASE(size, xDom, yDom) *pTable, table3d_axis_t y, table3d_axis_t x, table3DLookupContext &context) \
+    { \
+      get3DTableLookupContext( &pTable->get_value_cache, \
+                              TABLE3D_TYPENAME_BASE(size, xDom, yDom)::value_t::row_size, \
+                              pTable->axisX.axis, \
+                              pTable->axisY.axis, \
+                              y, x, context); \
+    } \
+    static inline table3d_value_t interpolate3DTableValue(const TABLE3D_TYPENAME_BASE(size, xDom, yDom) *pTable, const table3DLookupContext &context) \
+    { \
+      return interpolate3DTableValue( context, \
+                              TABLE3D_TYPENAME_BASE(size, xDom, yDom)::value_t::row_size, \
+                              pTable->values.values); \
+    }
+TABLE3D_GENERATOR(TABLE3D_GEN_LOOKUP_CONTEXT)
+
+// Generate setTableOverlay() & getTableOverlay() functions. The cell index is in the
+// order TS sends the values (See table3d_overlay.h)
+#define TABLE3D_GEN_OVERLAY(size, xDom, yDom) \
+    static inline bool setTableOverlay(TABLE3D_TYPENAME_BASE(size, xDom, yDom) *pTable, uint8_t pageNum, table3d_dim_t index, int8_t delta) \
+    { \
+      return setTableOverlay( &pTable->get_value_cache, \
+                              pTable->values.values, \
+                              pageNum, \
+                              (table3d_dim_t)(&pTable->values.value_at(index) - pTable->values.values), \
+                              delta); \
+    } \
+    static inline int8_t getTableOverlay(TABLE3D_TYPENAME_BASE(size, xDom, yDom) *pTable, table3d_dim_t index) \
+    { \
+      return getTableOverlay( pTable->values.values, \
+                              (table3d_dim_t)(&pTable->values.value_at(index) - pTable->values.values)); \
+    }
+TABLE3D_GENERATOR(TABLE3D_GEN_OVERLAY)
+
 // =============================== Table function calls =========================
 
 // With no templates or inheritance we need some way to call functions
@@ -1,4 +1,5 @@
 #include "table3d_interpolate.h"
+#include "table3d_overlay.h"
 #include "maths.h"
 
 
@@ -93,16 +94,6 @@ table3d_dim_t find_ybin(table3d_axis_t &value, const table3d_axis_t *pAxis, tabl
 
 // ========================= Fixed point math =========================
 
-// An unsigned fixed point number type with 1 integer bit & 8 fractional bits.
-// See https://en.wikipedia.org/wiki/Q_(number_format).
-// This is specialised for the number range 0..1 - a generic fixed point
-// class would miss some important optimisations. Specifically, we can avoid
-// type promotion during multiplication.
-typedef uint16_t QU1X8_t;
-static constexpr QU1X8_t QU1X8_INTEGER_SHIFT = 8;
-static constexpr QU1X8_t QU1X8_ONE = (QU1X8_t)1U << QU1X8_INTEGER_SHIFT;
-static constexpr QU1X8_t QU1X8_HALF = (QU1X8_t)1U << (QU1X8_INTEGER_SHIFT-1U);
-
 static inline QU1X8_t mulQU1X8(QU1X8_t a, QU1X8_t b)
 {
     // 1x1 == 1....but the real reason for this is to avoid 16-bit multiplication overflow.
@@ -192,6 +183,7 @@ table3d_value_t __attribute__((noclone)) get3DTableValue(struct table3DGetValueC
     table3d_value_t B = pValues[rowMax + colMax];
     table3d_value_t C = pValues[rowMin + colMin];
     table3d_value_t D = pValues[rowMin + colMax];
+    if (tableOverlayCount != 0U) { overlayTableCorners(pValues, rowMax + colMin, axisSize, A, B, C, D); }
 
     //Check that all values aren't just the same (This regularly happens with things like the fuel trim maps)
     if( (A == B) && (A == C) && (A == D) ) { pValueCache->lastOutput = A; }
@@ -211,3 +203,43 @@ table3d_value_t __attribute__((noclone)) get3DTableValue(struct table3DGetValueC
 
     return pValueCache->lastOutput;
 }
+
+void get3DTableLookupContext(struct table3DGetValueCache *pValueCache, 
+                    table3d_dim_t axisSize,
+                    const table3d_axis_t *pXAxis,
+                    const table3d_axis_t *pYAxis,
+                    table3d_axis_t Y_in, table3d_axis_t X_in,
+                    table3DLookupContext &context)
+{
+    // Same axis search as get3DTableValue(), sharing the bin cache. 
+    pValueCache->lastXBinMax = find_xbin(X_in, pXAxis, axisSize, pValueCache->lastXBinMax);
+    pValueCache->lastYBinMax = find_ybin(Y_in, pYAxis, axisSize, pValueCache->lastYBinMax);
+
+    // See get3DTableValue() for the layout of the A, B, C & D values
+    context.valueIndex = (pValueCache->lastYBinMax * axisSize) + (axisSize - pValueCache->lastXBinMax - 2U);
+
+    const QU1X8_t p = compute_bin_position(X_in, pValueCache->lastXBinMax, pXAxis);
+    const QU1X8_t q = compute_bin_position(Y_in, pValueCache->lastYBinMax, pYAxis);
+
+    context.weightA = mulQU1X8(QU1X8_ONE-p, q);
+    context.weightB = mulQU1X8(p, q);
+    context.weightC = mulQU1X8(QU1X8_ONE-p, QU1X8_ONE-q);
+    context.weightD = mulQU1X8(p, QU1X8_ONE-q);
+}
+
+table3d_value_t interpolate3DTableValue(const table3DLookupContext &context,
+                    table3d_dim_t axisSize,
+                    const table3d_value_t *pValues)
+{
+    const table3d_value_t *pA = pValues + context.valueIndex;
+    table3d_value_t A = pA[0];
+    table3d_value_t B = pA[1];
+    table3d_value_t C = pA[axisSize];
+    table3d_value_t D = pA[axisSize+1U];
+    if (tableOverlayCount != 0U) { overlayTableCorners(pValues, context.valueIndex, axisSize, A, B, C, D); }
+
+    // Match get3DTableValue(): when all corners are the same, so is the result.
+    if( (A == B) && (A == C) && (A == D) ) { return A; }
+
+    return ( (A * context.weightA) + (B * context.weightB) + (C * context.weightC) + (D * context.weightD) ) >> QU1X8_INTEGER_SHIFT;
+}
@@ -38,6 +38,32 @@ static inline void invalidate_cache(table3DGetValueCache *pCache)
     pCache->last_lookup.x = INT16_MAX;
 }
 
+// An unsigned fixed point number type with 1 integer bit & 8 fractional bits.
+// See https://en.wikipedia.org/wiki/Q_(number_format).
+// This is specialised for the number range 0..1 - a generic fixed point
+// class would miss some important optimisations. Specifically, we can avoid
+// type promotion during multiplication.
+typedef uint16_t QU1X8_t;
+static constexpr QU1X8_t QU1X8_INTEGER_SHIFT = 8;
+static constexpr QU1X8_t QU1X8_ONE = (QU1X8_t)1U << QU1X8_INTEGER_SHIFT;
+static constexpr QU1X8_t QU1X8_HALF = (QU1X8_t)1U << (QU1X8_INTEGER_SHIFT-1U);
+
+// The result of locating an (x, y) coordinate on a tables axes: the 4 
+// surrounding values and their interpolation weights.
+//
+// This separates the axis search from the interpolation, so that several
+// tables that share the same axes can be interpolated using a single search.
+struct table3DLookupContext {
+  // Index into the table values of the top left corner (A). The other corners
+  // are implicit: B=A+1, C=A+axisSize, D=C+1
+  table3d_dim_t valueIndex;
+  // The interpolation weights of A, B, C & D
+  QU1X8_t weightA;
+  QU1X8_t weightB;
+  QU1X8_t weightC;
+  QU1X8_t weightD;
+};
+
 /*
 3D Tables have an origin (0,0) in the top left hand corner. Vertical axis is expressed first.
 Eg: 2x2 table
@@ -56,4 +82,26 @@ table3d_value_t get3DTableValue(struct table3DGetValueCache *pValueCache,
                     const table3d_value_t *pValues,
                     const table3d_axis_t *pXAxis,
                     const table3d_axis_t *pYAxis,
-                    table3d_axis_t y, table3d_axis_t x);
\ No newline at end of file
+                    table3d_axis_t y, table3d_axis_t x);
+
+/**
+ * @brief Locate a coordinate on a tables axes, ready for one or more calls to interpolate3DTableValue()
+ * 
+ * The axis bin cache is updated, but not the cached lookup value. So this can be 
+ * freely mixed with get3DTableValue() calls on the same table.
+ */
+void get3DTableLookupContext(struct table3DGetValueCache *pValueCache, 
+                    table3d_dim_t axisSize,
+                    const table3d_axis_t *pXAxis,
+                    const table3d_axis_t *pYAxis,
+                    table3d_axis_t y, table3d_axis_t x,
+                    table3DLookupContext &context);
+
+/**
+ * @brief Interpolate a value from a table, using the location from get3DTableLookupContext()
+ * 
+ * The table values must be the same size as the table the context was generated from. 
+ */
+table3d_value_t interpolate3DTableValue(const table3DLookupContext &context,
+                    table3d_dim_t axisSize,
+                    const table3d_value_t *pValues);
@@ -0,0 +1,106 @@
+/** \file
+ * @brief A sparse RAM overlay on the 3D table values. See table3d_overlay.h
+ */
+#include "table3d_overlay.h"
+
+/** @brief One table cell with an overlay delta */
+struct table3d_overlay_entry_t {
+  table3DGetValueCache *pValueCache; ///< Lookup cache of the table, invalidated when the delta changes
+  table3d_value_t *pValues;          ///< Values of the table. This is the key that lookups are matched on
+  table3d_dim_t index;               ///< Index of the cell in pValues
+  int8_t delta;                      ///< Added to the cell value
+  uint8_t pageNum;                   ///< The page the table is on
+};
+
+static table3d_overlay_entry_t overlay[TABLE3D_OVERLAY_SIZE]; ///< Entries [0, tableOverlayCount) are in use
+uint8_t tableOverlayCount = 0;
+
+static inline table3d_value_t addDelta(table3d_value_t value, int8_t delta)
+{
+  int16_t result = (int16_t)value + delta;
+  if (result < 0) { result = 0; }
+  else if (result > UINT8_MAX) { result = UINT8_MAX; }
+  return (table3d_value_t)result;
+}
+
+static uint8_t findEntry(const table3d_value_t *pValues, table3d_dim_t index)
+{
+  uint8_t entry = 0;
+  while ( (entry < tableOverlayCount) && ((overlay[entry].pValues != pValues) || (overlay[entry].index != index)) )
+  {
+    ++entry;
+  }
+  return entry;
+}
+
+bool setTableOverlay(table3DGetValueCache *pValueCache, table3d_value_t *pValues, uint8_t pageNum, table3d_dim_t index, int8_t delta)
+{
+  uint8_t entry = findEntry(pValues, index);
+  if (delta == 0)
+  {
+    // Keep the entries in use contiguous by moving the last one into the gap
+    if (entry < tableOverlayCount)
+    {
+      --tableOverlayCount;
+      overlay[entry] = overlay[tableOverlayCount];
+    }
+  }
+  else
+  {
+    if (entry == tableOverlayCount)
+    {
+      if (tableOverlayCount == TABLE3D_OVERLAY_SIZE) { return false; }
+      ++tableOverlayCount;
+    }
+    overlay[entry] = { pValueCache, pValues, index, delta, pageNum };
+  }
+  invalidate_cache(pValueCache);
+  return true;
+}
+
+int8_t getTableOverlay(const table3d_value_t *pValues, table3d_dim_t index)
+{
+  uint8_t entry = findEntry(pValues, index);
+  return entry < tableOverlayCount ? overlay[entry].delta : 0;
+}
+
+void clearTableOverlays(void)
+{
+  while (tableOverlayCount > 0U)
+  {
+    --tableOverlayCount;
+    invalidate_cache(overlay[tableOverlayCount].pValueCache);
+  }
+}
+
+uint16_t applyTableOverlays(void)
+{
+  uint16_t pages = 0;
+  while (tableOverlayCount > 0U)
+  {
+    --tableOverlayCount;
+    const table3d_overlay_entry_t &entry = overlay[tableOverlayCount];
+    entry.pValues[entry.index] = addDelta(entry.pValues[entry.index], entry.delta);
+    invalidate_cache(entry.pValueCache);
+    pages |= (uint16_t)(1U << entry.pageNum);
+  }
+  return pages;
+}
+
+void overlayTableCorners(const table3d_value_t *pValues, table3d_dim_t indexA, table3d_dim_t axisSize,
+                    table3d_value_t &A, table3d_value_t &B, table3d_value_t &C, table3d_value_t &D)
+{
+  for (uint8_t entry = 0; entry < tableOverlayCount; ++entry)
+  {
+    if ( (overlay[entry].pValues == pValues) && (overlay[entry].index >= indexA) )
+    {
+      const table3d_dim_t offset = overlay[entry].index - indexA;
+      const int8_t delta = overlay[entry].delta;
+      if (offset == 0U) { A = addDelta(A, delta); }
+      else if (offset == 1U) { B = addDelta(B, delta); }
+      else if (offset == axisSize) { C = addDelta(C, delta); }
+      else if (offset == axisSize + 1U) { D = addDelta(D, delta); }
+      else { /* Not one of the corners */ }
+    }
+  }
+}
@@ -0,0 +1,69 @@
+/** \file
+ * @brief A sparse RAM overlay on the 3D table values
+ *
+ * Each overlay entry is a delta that is added to one cell of a table when it is looked up, without changing the
+ * table itself. This allows live adaptation (Closed loop learning, on the fly tuning) without writing the tables,
+ * and therefore without a burn to EEPROM while driving. The VE learning (See veLearn.h) adds the cells it has learned
+ * to the overlay when they are applied.
+ *
+ * The entries are kept in a small fixed size store. When the store is empty, the only cost to a table lookup
+ * is a check of #tableOverlayCount.
+ *
+ * The deltas can be added to their tables with applyTableOverlays(), which is how commitTableOverlays() (See storage.h)
+ * writes them to EEPROM. Until then they are lost at power off.
+ * @ingroup table_3d
+ */
+#pragma once
+
+#include "table3d_interpolate.h"
+
+// The number of cells, across all tables, that can have an overlay delta. Every entry is checked on each
+// table lookup while the overlay is in use, so the AVR boards (Which are also short of RAM) have fewer
+#if defined(CORE_AVR) || defined(ARDUINO_ARCH_AVR)
+  #define TABLE3D_OVERLAY_SIZE 16
+#else
+  #define TABLE3D_OVERLAY_SIZE 64
+#endif
+
+/** @brief Number of overlay entries in use */
+extern uint8_t tableOverlayCount;
+
+/**
+ * @brief Set the overlay delta of one table cell
+ *
+ * A delta of 0 removes the cell from the overlay.
+ *
+ * @param pValueCache The lookup cache of the table. Invalidated so that the next lookup uses the new delta
+ * @param pValues The values of the table
+ * @param pageNum The page the table is on, so that commitTableOverlays() can write it
+ * @param index The index of the cell in pValues
+ * @param delta The amount added to the cell value when it is looked up
+ * @return false if the overlay is full. The overlay is unchanged
+ */
+bool setTableOverlay(table3DGetValueCache *pValueCache, table3d_value_t *pValues, uint8_t pageNum, table3d_dim_t index, int8_t delta);
+
+/**
+ * @brief The overlay delta of one table cell. 0 if it has none
+ */
+int8_t getTableOverlay(const table3d_value_t *pValues, table3d_dim_t index);
+
+/**
+ * @brief Discard all overlay entries, restoring the table values
+ */
+void clearTableOverlays(void);
+
+/**
+ * @brief Add the overlay deltas to the table values and clear the overlay
+ *
+ * The tables are only changed in RAM.
+ * @return A bit mask of the pages that were changed. Bit N is page N
+ */
+uint16_t applyTableOverlays(void);
+
+/**
+ * @brief Add the overlay deltas to the 4 table values that will be interpolated
+ *
+ * The corners are laid out as per table3DLookupContext: B=A+1, C=A+axisSize, D=C+1
+ */
+void overlayTableCorners(const table3d_value_t *pValues, table3d_dim_t indexA, table3d_dim_t axisSize,
+                    table3d_value_t &A, table3d_value_t &B, table3d_value_t &C, table3d_value_t &D);
@@ -14,11 +14,50 @@
 #include "updates.h"
 #include "pages.h"
 #include "comms_CAN.h"
+#include "rpmEstimator.h"
 #include EEPROM_LIB_H //This is defined in the board .h files
 
+//Sets the ignition and dwell trim tables to no trim. Trim table 1 gets the same axes as the dwell map (Which is also 4x4 RPM vs ignition load),
+//the other tables use the axes of table 1
+static void resetIgnitionTrimTables(void)
+{
+  ignTrimTable3d &table = ignTrim1Table;
+  auto table_it = table.values.begin();
+  while (!table_it.at_end())
+  {
+    auto row = *table_it;
+    while (!row.at_end())
+    {
+      *row = OFFSET_IGNTRIM;
+      ++row;
+    }
+    ++table_it;
+  }
+
+  auto x_it = table.axisX.begin();
+  auto dwell_x_it = dwellTable.axisX.begin();
+  while (!x_it.at_end())
+  {
+    *x_it = *dwell_x_it;
+    ++x_it;
+    ++dwell_x_it;
+  }
+  auto y_it = table.axisY.begin();
+  auto dwell_y_it = dwellTable.axisY.begin();
+  while (!y_it.at_end())
+  {
+    *y_it = *dwell_y_it;
+    ++y_it;
+    ++dwell_y_it;
+  }
+
+  memset(ignTrimValues, OFFSET_IGNTRIM, sizeof(ignTrimValues));
+  memset(configPage15.dwellTrimValues, OFFSET_DWELLTRIM, sizeof(configPage15.dwellTrimValues));
+}
+
 void doUpdates(void)
 {
-  #define CURRENT_DATA_VERSION    24
+  #define CURRENT_DATA_VERSION    25
   //Only the latest update for small flash devices must be retained
    #ifndef SMALL_FLASH_MODE
 
@@ -772,6 +811,44 @@ void doUpdates(void)
     writeAllConfig();
     storeEEPROMVersion(24);
   }
+
+  if(readEEPROMVersion() == 24)
+  {
+    //202501
+
+    //Flex blended secondary fuel and spark tables. Default range is E0 to E85
+    configPage15.flexBlendEthLow = 0;
+    configPage15.flexBlendEthHigh = 85;
+
+    //Predictive rev limiter uses a previously unused bit. Default to the existing (Current RPM) behaviour
+    configPage15.revLimitPredict = 0;
+
+    //RPM estimator uses previously unused bytes. Disabled by default
+    configPage15.rpmEstWindow = RPM_EST_OFF;
+    configPage15.rpmEstTeeth = 4;
+
+    //Angle arming uses a previously unused bit and byte. Default to the existing main loop arming
+    configPage15.angleArming = 0;
+    configPage15.angleArmWindow = 30;
+
+    //Closed loop dwell uses a previously unused bit and bytes. Default to off
+    configPage15.dwellClosedLoop = 0;
+    configPage15.dwellTrimGain = 25;
+    configPage15.dwellTrimLimit = 10;
+
+    //Ignition trim tables use a previously unused bit, the empty EEPROM after page 15 and (For the dwell trims) previously unused bytes. Default to off with no trim
+    configPage15.ignTrimEnabled = 0;
+    resetIgnitionTrimTables();
+
+    //VE learning uses a previously unused bit and bytes. Default to off
+    configPage15.veLearnEnabled = 0;
+    configPage15.veLearnGain = 25;
+    configPage15.veLearnLimit = 15;
+    configPage15.veLearnSamples = 4;
+
+    writeAllConfig();
+    storeEEPROMVersion(25);
+  }
   
   //Final check is always for 255 and 0 (Brand new arduino)
   if( (readEEPROMVersion() == 0) || (readEEPROMVersion() == 255) )
@@ -0,0 +1,166 @@
+/** @file
+ * Adaptive VE learning. See veLearn.h
+ */
+#include "globals.h"
+#include "veLearn.h"
+#include "corrections.h"
+#include "table3d.h"
+#include "pages.h"
+#include "maths.h"
+#include "utilities.h"
+
+static constexpr table3d_dim_t VE_ROW_SIZE = decltype(fuelTable)::value_t::row_size;
+static constexpr uint16_t VE_TABLE_SIZE = sizeof(fuelTable.values.values);
+#define VE_LEARN_MAX_ERROR 100 ///< Limits the error (%) of a single sample, so that the sums can't overflow
+
+/** The learned change to the VE of each cell that has not been applied yet, in the same order as fuelTable.values.
+ * Relative to the VE that is used for fuelling, so cells that are edited from TS keep their learned change. 0 for the cells
+ * that have nothing to apply */
+static int8_t learnedDeltas[VE_TABLE_SIZE];
+
+/** The samples collected so far for one of the cells around the operating point */
+struct ve_learn_cell_t {
+  table3d_dim_t index; ///< Index of the cell in fuelTable.values and learnedDeltas
+  uint16_t weight;     ///< Sum of the interpolation weights (QU1X8) of the samples. 0 when there are no samples
+  int32_t errorSum;    ///< Sum of the weight times the fuelling error (%) of each sample
+};
+static ve_learn_cell_t learnCells[4]; ///< In the same order as the A, B, C & D corners of table3DLookupContext
+
+/** Discards the learned changes and any samples. Called at startup and by TS_CMD_VE_LEARN_RESET */
+void resetVELearn(void)
+{
+  memset(learnedDeltas, 0, sizeof(learnedDeltas));
+  for(uint8_t corner = 0; corner < _countof(learnCells); corner++) { learnCells[corner].weight = 0; }
+  currentStatus.veLearnUpdates = 0;
+}
+
+//Keeps the samples of the cells that are still around the operating point, and starts the others from nothing
+static void moveLearnCells(const table3d_dim_t (&indexes)[4])
+{
+  ve_learn_cell_t cells[4];
+  for(uint8_t corner = 0; corner < _countof(cells); corner++)
+  {
+    cells[corner].index = indexes[corner];
+    cells[corner].weight = 0;
+    cells[corner].errorSum = 0;
+    for(uint8_t old = 0; old < _countof(learnCells); old++)
+    {
+      if( (learnCells[old].weight > 0U) && (learnCells[old].index == indexes[corner]) ) { cells[corner] = learnCells[old]; }
+    }
+  }
+  memcpy(learnCells, cells, sizeof(learnCells));
+}
+
+//The VE that a cell is fuelling with, which includes any overlay (See table3d_overlay.h) that has not been committed yet
+static int16_t getFuellingVE(table3d_dim_t index)
+{
+  const int16_t ve = (int16_t)fuelTable.values.values[index] + getTableOverlay(fuelTable.values.values, index);
+  return constrain(ve, (int16_t)0, (int16_t)UINT8_MAX);
+}
+
+//Moves the learned VE of a cell towards the VE that would have given the AFR target
+static void updateLearnedCell(ve_learn_cell_t &cell)
+{
+  const int16_t error = (int16_t)(cell.errorSum / (int32_t)cell.weight);
+  const int16_t tableVE = getFuellingVE(cell.index);
+  //The limit is on the total change from the VE table as it was burnt, so that the overlay and repeated applies can't add up past it
+  const int16_t burntVE = fuelTable.values.values[cell.index];
+  const int16_t limit = (int16_t)div100((int32_t)burntVE * configPage15.veLearnLimit);
+  const int16_t targetVE = constrain((int16_t)(tableVE + div100((int32_t)tableVE * error)), (int16_t)(burntVE - limit), (int16_t)min((int16_t)(burntVE + limit), (int16_t)UINT8_MAX));
+  const int16_t targetDelta = constrain((int16_t)(targetVE - tableVE), (int16_t)INT8_MIN, (int16_t)INT8_MAX);
+
+  const int16_t learned = learnedDeltas[cell.index];
+  int16_t step = (int16_t)div100((int32_t)(targetDelta - learned) * configPage15.veLearnGain);
+  //Always make some progress, otherwise a low gain would never get the last few steps
+  if( (step == 0) && (targetDelta > learned) ) { step = 1; }
+  else if( (step == 0) && (targetDelta < learned) ) { step = -1; }
+  learnedDeltas[cell.index] = (int8_t)(learned + step);
+
+  cell.weight = 0;
+  cell.errorSum = 0;
+  if(currentStatus.veLearnUpdates < UINT16_MAX) { currentStatus.veLearnUpdates++; }
+}
+
+/** Adds a sample to the cells of the VE table around an operating point
+ * @param load The fuel load of the sample (currentStatus.fuelLoad)
+ * @param rpm The RPM of the sample
+ * @param correction The fuelling (%) that would have hit the AFR target. 100 is no change
+ * @return true if a learned cell was updated
+ */
+bool addVELearnSample(table3d_axis_t load, table3d_axis_t rpm, uint16_t correction)
+{
+  table3DLookupContext lookup;
+  get3DTableLookupContext(&fuelTable, load, rpm, lookup);
+
+  const table3d_dim_t indexes[4] = { lookup.valueIndex, (table3d_dim_t)(lookup.valueIndex + 1U), (table3d_dim_t)(lookup.valueIndex + VE_ROW_SIZE), (table3d_dim_t)(lookup.valueIndex + VE_ROW_SIZE + 1U) };
+  const QU1X8_t weights[4] = { lookup.weightA, lookup.weightB, lookup.weightC, lookup.weightD };
+  moveLearnCells(indexes);
+
+  const int16_t error = constrain((int16_t)((int16_t)min(correction, (uint16_t)INT16_MAX) - 100), (int16_t)-VE_LEARN_MAX_ERROR, (int16_t)VE_LEARN_MAX_ERROR);
+  const uint16_t updateWeight = (uint16_t)max(configPage15.veLearnSamples, (byte)1U) * QU1X8_ONE;
+  bool updated = false;
+  for(uint8_t corner = 0; corner < _countof(learnCells); corner++)
+  {
+    if(weights[corner] == 0U) { continue; }
+    learnCells[corner].weight += weights[corner];
+    learnCells[corner].errorSum += (int32_t)weights[corner] * error;
+    if(learnCells[corner].weight >= updateWeight)
+    {
+      updateLearnedCell(learnCells[corner]);
+      updated = true;
+    }
+  }
+  return updated;
+}
+
+/** Learns from the current operating point, if the VE learning is enabled and the conditions are met. Called at 10Hz */
+void veLearnSample(void)
+{
+  BIT_CLEAR(currentStatus.veLearnStatus, VE_LEARN_ACTIVE);
+  if( (configPage15.veLearnEnabled == 0U) || (configPage6.egoType != EGO_TYPE_WIDE) || (currentStatus.afrTarget == 0U) ) { return; }
+
+  //Only learn from steady state, where the fuelling comes from the primary VE table alone
+  if( BIT_CHECK(currentStatus.engine, BIT_ENGINE_ACC) || BIT_CHECK(currentStatus.engine, BIT_ENGINE_DCC) || BIT_CHECK(currentStatus.status3, BIT_STATUS3_FUEL2_ACTIVE) ) { return; }
+  if(!egoConditionsMet()) { return; }
+
+  //The fuelling that would have hit the target is the closed loop correction, scaled by how far the reading is from the target
+  const uint16_t correction = (uint16_t)(((uint32_t)currentStatus.egoCorrection * currentStatus.O2) / currentStatus.afrTarget);
+  BIT_SET(currentStatus.veLearnStatus, VE_LEARN_ACTIVE);
+  (void)addVELearnSample(currentStatus.fuelLoad, currentStatus.RPM, correction);
+}
+
+/** Moves the learned changes into the table overlay (See table3d_overlay.h), where they are used for fuelling straight away.
+ * Called by TS_CMD_VE_LEARN_APPLY. Only the cells that have been learned are changed. The VE table itself is changed
+ * (And burnt) when the overlay is committed (TS_CMD_TABLE_OVERLAY_COMMIT)
+ *
+ * If the overlay fills up, or a cell's overlay change can't hold all of its learned change, what did not fit is kept and
+ * VE_LEARN_PENDING is set, so that it can be applied after the overlay has been committed
+ */
+void applyVELearn(void)
+{
+  BIT_CLEAR(currentStatus.veLearnStatus, VE_LEARN_PENDING);
+  for(uint16_t index = 0; index < VE_TABLE_SIZE; index++)
+  {
+    const int8_t delta = learnedDeltas[index];
+    if(delta == 0) { continue; }
+
+    const int16_t overlayDelta = (int16_t)getTableOverlay(fuelTable.values.values, (table3d_dim_t)index) + delta;
+    const int8_t applied = (int8_t)constrain(overlayDelta, (int16_t)INT8_MIN, (int16_t)INT8_MAX);
+    //Whatever the overlay can't hold is kept, to be applied once the overlay has been committed
+    if(setTableOverlay(&fuelTable.get_value_cache, fuelTable.values.values, veMapPage, (table3d_dim_t)index, applied))
+    {
+      learnedDeltas[index] = (int8_t)(overlayDelta - applied);
+    }
+    if(learnedDeltas[index] != 0) { BIT_SET(currentStatus.veLearnStatus, VE_LEARN_PENDING); }
+  }
+}
+
+/** The learned VE of a cell
+ * @param index Index of the cell in the order the VE table is sent to TS (Lowest load row first, lowest RPM first)
+ */
+table3d_value_t getLearnedVE(table3d_dim_t index)
+{
+  const table3d_dim_t cell = (table3d_dim_t)(&fuelTable.values.value_at(index) - fuelTable.values.values);
+  const int16_t learned = getFuellingVE(cell) + learnedDeltas[cell];
+  return (table3d_value_t)constrain(learned, (int16_t)0, (int16_t)UINT8_MAX);
+}
@@ -0,0 +1,32 @@
+/** @file
+ * Adaptive VE learning.
+ * While the closed loop AFR conditions are met, the fuelling error seen by a wideband O2 sensor (Including the correction
+ * the closed loop is already making) is added to the cells of the VE table around the operating point, weighted by how
+ * close the operating point is to each cell (The same weights that interpolate the VE).
+ * Once a cell has collected configPage15.veLearnSamples full weight samples, its learned VE is moved
+ * configPage15.veLearnGain % of the way towards the VE that would have hit the AFR target. The total change, including any
+ * change already in the table overlay, is limited to configPage15.veLearnLimit % either side of the VE table value.
+ *
+ * The learned values are kept as a change to each cell and are not used for fuelling. The learned table can be read with
+ * the 'r' comms command. Applying it (TS_CMD_VE_LEARN_APPLY) moves the changes of the learned cells into the table overlay
+ * (See table3d_overlay.h), where they are used for fuelling straight away and can be committed to the VE table and burnt
+ * (TS_CMD_TABLE_OVERLAY_COMMIT) or discarded (TS_CMD_TABLE_OVERLAY_CLEAR). The cells that have not been learned, and any
+ * edits made to the VE table from TS, are left as they are.
+ * RAM use is one byte per VE table cell, plus the accumulators for the 4 cells around the operating point.
+ */
+#ifndef VE_LEARN_H
+#define VE_LEARN_H
+
+#include "globals.h"
+
+//Bits of currentStatus.veLearnStatus
+#define VE_LEARN_ACTIVE   0 ///< The last sample was learned from
+#define VE_LEARN_PENDING  1 ///< Some learned cells did not fit in the table overlay when it was applied
+
+void resetVELearn(void);
+void veLearnSample(void);
+bool addVELearnSample(table3d_axis_t load, table3d_axis_t rpm, uint16_t correction);
+void applyVELearn(void);
+table3d_value_t getLearnedVE(table3d_dim_t index);
+
+#endif
@@ -0,0 +1,46 @@
+#include "bench.h"
+#include "../timer.hpp"
+
+volatile uint32_t benchSink;
+
+static void __attribute__((noinline)) benchEmpty(uint16_t iteration) { benchSink = iteration; }
+
+static uint32_t timeCalls(uint16_t iterations, bench_function_t pFunction)
+{
+    timer measure;
+    measure.start();
+    for(uint16_t iteration = 0; iteration < iterations; ++iteration) { pFunction(iteration); }
+    measure.stop();
+    return measure.duration_micros();
+}
+
+bench_result_t runBenchmark(uint16_t iterations, bench_function_t pFunction)
+{
+    //Let the previous report finish sending, otherwise the serial interrupts are included in the time
+    Serial.flush();
+
+    bench_result_t result;
+    result.iterations = iterations;
+    result.overheadMicros = timeCalls(iterations, benchEmpty);
+    result.totalMicros = timeCalls(iterations, pFunction);
+    return result;
+}
+
+void reportBenchmark(const char *name, const bench_result_t &result)
+{
+    const uint32_t elapsed = (result.totalMicros > result.overheadMicros) ? (result.totalMicros - result.overheadMicros) : 0U;
+    const uint32_t nanosPerCall = (uint32_t)(((uint64_t)elapsed * 1000U) / result.iterations);
+    const uint32_t centiCyclesPerCall = (uint32_t)(((uint64_t)elapsed * (F_CPU / 10000UL)) / result.iterations);
+
+    char benchName[32];
+    strncpy_P(benchName, name, sizeof(benchName) - 1U);
+    benchName[sizeof(benchName) - 1U] = '\0';
+
+    char msg[96];
+    sprintf_P(msg, PSTR("BENCH,%s,%" PRIu16 ",%" PRIu32 ",%" PRIu32 ".%02" PRIu32),
+        benchName, result.iterations, nanosPerCall, centiCyclesPerCall / 100U, centiCyclesPerCall % 100U);
+    TEST_MESSAGE(msg);
+
+    //Sanity check that the function was actually timed
+    TEST_ASSERT_GREATER_THAN_UINT32(result.overheadMicros, result.totalMicros);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <Arduino.h>
+#include <unity.h>
+
+// Benchmark harness for the hot paths of the firmware
+//
+// Each benchmark calls a function a fixed number of times and reports the average time per call as a line of the
+// test output:
+//
+//   BENCH,<name>,<calls>,<nanoseconds per call>,<CPU cycles per call>
+//
+// Timing uses micros(), so a single call can't be timed to the cycle. Instead the calls are timed as a batch, and the
+// time taken by the same number of calls to an empty function is subtracted to remove the loop and call overhead.
+// With a few thousand calls the average is accurate to a fraction of a cycle. The cycles are derived from F_CPU.
+//
+// bench_report.py (In the root of the repository) collects the lines into a report and compares them to a baseline.
+
+// Called once per iteration with the iteration number, which can be used to vary the input
+typedef void (*bench_function_t)(uint16_t iteration);
+
+struct bench_result_t {
+    uint16_t iterations;
+    uint32_t totalMicros;    // Time for all of the calls
+    uint32_t overheadMicros; // Time for the same number of calls to an empty function
+};
+
+// Benchmark functions write their result here, so that the optimiser can't remove the call
+extern volatile uint32_t benchSink;
+
+bench_result_t runBenchmark(uint16_t iterations, bench_function_t pFunction);
+void reportBenchmark(const char *name, const bench_result_t &result); // name is in PROGMEM
+
+#define BENCHMARK(name, iterations, function) reportBenchmark(PSTR(name), runBenchmark((iterations), (function)))
@@ -0,0 +1,38 @@
+#include <unity.h>
+#include "globals.h"
+#include "logger.h"
+#include "page_crc.h"
+#include "pages.h"
+#include "bench.h"
+#include "../test_utils.h"
+
+//Each call is the next byte of the output channels packet, as when a realtime data request is being sent
+static void run_getTSLogEntry(uint16_t iteration)
+{
+  benchSink = getTSLogEntry(iteration % LOG_CHANNEL_BYTES);
+}
+
+static void bench_getTSLogEntry(void)
+{
+  BENCHMARK("getTSLogEntry", 4000, run_getTSLogEntry);
+}
+
+static void run_calculatePageCRC32(uint16_t iteration)
+{
+  (void)iteration;
+  benchSink = calculatePageCRC32(veMapPage);
+}
+
+//The fuel table page: a 3D table, which is the slowest type of page to iterate over
+static void bench_calculatePageCRC32(void)
+{
+  BENCHMARK("calculatePageCRC32", 50, run_calculatePageCRC32);
+}
+
+void benchComms(void)
+{
+  SET_UNITY_FILENAME() {
+    RUN_TEST_P(bench_getTSLogEntry);
+    RUN_TEST_P(bench_calculatePageCRC32);
+  }
+}
@@ -0,0 +1,59 @@
+#include <unity.h>
+#include "globals.h"
+#include "decoders.h"
+#include "bench.h"
+#include "../test_utils.h"
+
+extern bool SetRevolutionTime(uint32_t revTime);
+
+//A 36-1 crank wheel with sync, at 6000 RPM
+static void setup_missingTooth_36_1(void)
+{
+  configPage4.triggerTeeth = 36;
+  configPage4.triggerMissingTeeth = 1;
+  configPage4.TrigSpeed = CRANK_SPEED;
+  configPage4.trigPatternSec = SEC_TRIGGER_SINGLE;
+  configPage4.triggerFilter = 0; //The teeth come much faster than any real wheel, so must not be filtered
+  configPage4.sparkMode = IGN_MODE_WASTED;
+  triggerSetup_missingTooth();
+
+  currentStatus.hasSync = true;
+  currentStatus.RPM = 6000;
+  SetRevolutionTime(10000);
+}
+
+static void run_triggerPri_missingTooth(uint16_t iteration)
+{
+  (void)iteration;
+  triggerPri_missingTooth();
+  benchSink = toothCurrentCount;
+}
+
+//Every call is a tooth, a few uS apart. Once the count passes the end of the wheel it takes the missing tooth path
+static void bench_triggerPri_missingTooth(void)
+{
+  setup_missingTooth_36_1();
+  BENCHMARK("triggerPri_missingTooth", 4000, run_triggerPri_missingTooth);
+}
+
+static void run_getCrankAngle_missingTooth(uint16_t iteration)
+{
+  (void)iteration;
+  benchSink = getCrankAngle_missingTooth();
+}
+
+static void bench_getCrankAngle_missingTooth(void)
+{
+  setup_missingTooth_36_1();
+  triggerPri_missingTooth();
+  triggerPri_missingTooth();
+  BENCHMARK("getCrankAngle_missingTooth", 4000, run_getCrankAngle_missingTooth);
+}
+
+void benchDecoders(void)
+{
+  SET_UNITY_FILENAME() {
+    RUN_TEST_P(bench_triggerPri_missingTooth);
+    RUN_TEST_P(bench_getCrankAngle_missingTooth);
+  }
+}
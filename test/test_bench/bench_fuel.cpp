@@ -0,0 +1,85 @@
+#include <unity.h>
+#include "globals.h"
+#include "corrections.h"
+#include "speeduino.h"
+#include "schedule_calcs.h"
+#include "bench.h"
+#include "../test_utils.h"
+
+extern void construct2dTables(void);
+
+//A warm engine cruising with closed loop off, so every correction is worked out but none of them end early
+static void setup_running_engine(void)
+{
+  construct2dTables();
+  initialiseCorrections();
+  populate_2dtable(&WUETable, 100, 100);
+  populate_2dtable(&injectorVCorrectionTable, 100, 100);
+  populate_2dtable(&baroFuelTable, 100, 100);
+  populate_2dtable(&IATDensityCorrectionTable, 100, 100);
+  populate_2dtable(&flexFuelTable, 100, 100);
+  populate_2dtable(&fuelTempTable, 100, 100);
+
+  BIT_SET(currentStatus.engine, BIT_ENGINE_RUN);
+  BIT_CLEAR(currentStatus.engine, BIT_ENGINE_CRANK);
+  currentStatus.RPM = 3000;
+  currentStatus.MAP = 60;
+  currentStatus.TPS = 40;
+  currentStatus.TPSlast = 40;
+  currentStatus.coolant = 90;
+  currentStatus.IAT = 30;
+  currentStatus.battery10 = 138;
+  currentStatus.runSecs = 255;
+  configPage2.battVCorMode = BATTV_COR_MODE_WHOLE;
+  configPage2.aeApplyMode = AE_MODE_MULTIPLIER;
+}
+
+static void run_correctionsFuel(uint16_t iteration)
+{
+  (void)iteration;
+  benchSink = correctionsFuel();
+}
+
+static void bench_correctionsFuel(void)
+{
+  setup_running_engine();
+  BENCHMARK("correctionsFuel", 2000, run_correctionsFuel);
+}
+
+static void run_PW(uint16_t iteration)
+{
+  const byte VE = 40U + (iteration & 0x3FU);
+  benchSink = PW(1060, VE, 94, 113U + (iteration & 0x0FU), 1000);
+}
+
+static void bench_PW(void)
+{
+  setup_running_engine();
+  configPage2.multiplyMAP = MULTIPLY_MAP_MODE_BARO;
+  configPage2.includeAFR = 0;
+  configPage2.incorporateAFR = 0;
+  currentStatus.baro = 100;
+  TEST_ASSERT_GREATER_THAN_UINT16(0, PW(1060, 100, 94, 113, 1000));
+  BENCHMARK("PW", 4000, run_PW);
+}
+
+static void run_calculateInjectorStartAngle(uint16_t iteration)
+{
+  const int16_t channelDegrees = (iteration & 0x03U) * 180;
+  benchSink = calculateInjectorStartAngle(iteration & 0xFFU, channelDegrees, 355U);
+}
+
+static void bench_calculateInjectorStartAngle(void)
+{
+  CRANK_ANGLE_MAX_INJ = 720;
+  BENCHMARK("calculateInjectorStartAngle", 8000, run_calculateInjectorStartAngle);
+}
+
+void benchFuel(void)
+{
+  SET_UNITY_FILENAME() {
+    RUN_TEST_P(bench_correctionsFuel);
+    RUN_TEST_P(bench_PW);
+    RUN_TEST_P(bench_calculateInjectorStartAngle);
+  }
+}
@@ -0,0 +1,33 @@
+#include <unity.h>
+#include "globals.h"
+#include "corrections.h"
+#include "bench.h"
+#include "../test_utils.h"
+
+extern void construct2dTables(void);
+
+static void run_correctionsIgn(uint16_t iteration)
+{
+  benchSink = (uint8_t)correctionsIgn(10 + (int8_t)(iteration & 0x1FU));
+}
+
+//A warm engine running at part throttle, with the default (Disabled) timing corrections
+static void bench_correctionsIgn(void)
+{
+  construct2dTables();
+  initialiseCorrections();
+  BIT_SET(currentStatus.engine, BIT_ENGINE_RUN);
+  BIT_CLEAR(currentStatus.engine, BIT_ENGINE_CRANK);
+  currentStatus.RPM = 3000;
+  currentStatus.TPS = 40;
+  currentStatus.coolant = 90;
+  currentStatus.IAT = 30;
+  BENCHMARK("correctionsIgn", 2000, run_correctionsIgn);
+}
+
+void benchIgn(void)
+{
+  SET_UNITY_FILENAME() {
+    RUN_TEST_P(bench_correctionsIgn);
+  }
+}
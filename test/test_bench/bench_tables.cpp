@@ -0,0 +1,68 @@
+#include <unity.h>
+#include "globals.h"
+#include "table2d.h"
+#include "table3d.h"
+#include "bench.h"
+#include "../test_utils.h"
+
+static table3d16RpmLoad benchTable3d;
+
+static void setup_benchTable3d(void)
+{
+  //RPM 500-8000 and load 10-160, with a different value in every cell
+  table_axis_iterator itX = benchTable3d.axisX.begin();
+  for(table3d_axis_t rpm = 500; !itX.at_end(); ++itX, rpm += 500) { *itX = rpm; }
+  table_axis_iterator itY = benchTable3d.axisY.begin();
+  for(table3d_axis_t load = 10; !itY.at_end(); ++itY, load += 10) { *itY = load; }
+
+  uint8_t value = 0;
+  table_value_iterator itZ = benchTable3d.values.begin();
+  while(!itZ.at_end())
+  {
+    table_row_iterator itRow = *itZ;
+    while(!itRow.at_end()) { *itRow = value; value += 7U; ++itRow; }
+    ++itZ;
+  }
+}
+
+//Every call is at a new point, so the value cache is never hit. Most points are between the bins
+static void run_get3DTableValue(uint16_t iteration)
+{
+  table3d_axis_t rpm = 400 + ((iteration * 37U) % 7700U);
+  table3d_axis_t load = 5 + ((iteration * 7U) % 160U);
+  benchSink = get3DTableValue(&benchTable3d, load, rpm);
+}
+
+static void bench_get3DTableValue(void)
+{
+  setup_benchTable3d();
+  BENCHMARK("get3DTableValue", 4000, run_get3DTableValue);
+}
+
+static uint8_t benchTable2dValues[10];
+static uint8_t benchTable2dBins[10];
+static table2D benchTable2d;
+
+static void run_table2D_getValue(uint16_t iteration)
+{
+  benchSink = table2D_getValue(&benchTable2d, (iteration * 13U) & 0xFFU);
+}
+
+static void bench_table2D_getValue(void)
+{
+  for(uint8_t x = 0; x < _countof(benchTable2dBins); x++)
+  {
+    benchTable2dBins[x] = 20U + (x * 20U);
+    benchTable2dValues[x] = 200U - (x * 10U);
+  }
+  construct2dTable(benchTable2d, _countof(benchTable2dValues), benchTable2dValues, benchTable2dBins);
+  BENCHMARK("table2D_getValue", 4000, run_table2D_getValue);
+}
+
+void benchTables(void)
+{
+  SET_UNITY_FILENAME() {
+    RUN_TEST_P(bench_get3DTableValue);
+    RUN_TEST_P(bench_table2D_getValue);
+  }
+}
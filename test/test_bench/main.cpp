@@ -0,0 +1,48 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <avr/sleep.h>
+
+void benchTables(void);
+void benchFuel(void);
+void benchIgn(void);
+void benchDecoders(void);
+void benchComms(void);
+
+#define UNITY_EXCLUDE_DETAILS
+
+void setup()
+{
+    pinMode(LED_BUILTIN, OUTPUT);
+
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+#if !defined(SIMULATOR)
+    delay(2000);
+#endif
+
+    UNITY_BEGIN();    // IMPORTANT LINE!
+
+    //initialiseAll() isn't called, as the interrupts of the timers it starts would be included in the times
+    benchTables();
+    benchFuel();
+    benchIgn();
+    benchDecoders();
+    benchComms();
+
+    UNITY_END(); // stop unit testing
+
+#if defined(SIMULATOR)       // Tell SimAVR we are done
+    cli();
+    sleep_enable();
+    sleep_cpu();
+#endif     
+}
+
+void loop()
+{
+    // Blink to indicate end of test
+    digitalWrite(LED_BUILTIN, HIGH);
+    delay(250);
+    digitalWrite(LED_BUILTIN, LOW);
+    delay(250);
+}
@@ -1 +1,3 @@
 void testMissingTooth();
+void testMissingToothSync();
+void testMissingToothArming();
@@ -0,0 +1,113 @@
+#include <decoders.h>
+#include <globals.h>
+#include <unity.h>
+#include "angleArming.h"
+#include "scheduler.h"
+#include "missing_tooth.h"
+#include "../../test_utils.h"
+
+extern volatile unsigned long toothLastToothTime;
+extern bool SetRevolutionTime(uint32_t revTime);
+
+// Turns a crank wheel with one missing tooth through the decoder and then the angle arming, the same as the trigger
+// interrupt does. The engine runs at 6000rpm whatever the number of teeth. Positions are counted in teeth from tooth #1.
+
+#define ARMING_REV_TIME 10000UL //uS per revolution
+
+static uint8_t armingTeeth;
+static bool ignitionArmed; //Whether ignition channel 1 has been armed by any tooth
+
+static void turnTo(uint16_t &position, uint16_t endPosition)
+{
+  for(; position < endPosition; position++)
+  {
+    delayMicroseconds(ARMING_REV_TIME / armingTeeth);
+    if( (position % armingTeeth) != (armingTeeth - 1U) )
+    {
+      triggerPri_missingTooth();
+      armSchedulesAtTooth();
+      if(ignitionSchedule1.Status != OFF) { ignitionArmed = true; }
+    }
+  }
+}
+
+static void setup_arming(uint8_t teeth, uint16_t ignitionStartAngle)
+{
+  armingTeeth = teeth;
+  configPage4.triggerTeeth = teeth;
+  configPage4.triggerMissingTeeth = 1;
+  configPage4.TrigSpeed = CRANK_SPEED;
+  configPage4.trigPatternSec = SEC_TRIGGER_SINGLE;
+  configPage4.triggerAngle = 0;
+  configPage4.sparkMode = IGN_MODE_WASTED;
+  configPage2.injLayout = INJ_PAIRED;
+  configPage2.strokes = FOUR_STROKE;
+  configPage2.perToothIgn = false;
+  triggerSetup_missingTooth();
+  BIT_SET(decoderState, BIT_DECODER_UNIFORM_TEETH);
+  getCrankAngle = getCrankAngle_missingTooth;
+  CRANK_ANGLE_MAX_IGN = 360;
+  CRANK_ANGLE_MAX_INJ = 360;
+
+  toothLastToothTime = 0;
+  currentStatus.hasSync = false;
+  BIT_CLEAR(currentStatus.status3, BIT_STATUS3_HALFSYNC);
+  SetRevolutionTime(ARMING_REV_TIME);
+
+  initialiseSchedulers();
+  resetAngleArmingToothGap();
+  configPage15.angleArming = true;
+  configPage15.angleArmWindow = 30;
+  setIgnitionArmingTarget(IGN1_CMD_BIT, true, ignitionStartAngle, 1000);
+  publishArmingTargets();
+  ignitionArmed = false;
+}
+
+static void teardown_arming(void)
+{
+  stopAngleArming();
+  resetAngleArmingToothGap();
+  configPage15.angleArming = false;
+  BIT_CLEAR(decoderState, BIT_DECODER_UNIFORM_TEETH);
+  setIgnitionArmingTarget(IGN1_CMD_BIT, false, 0, 0);
+  publishArmingTargets();
+  stopAngleArming();
+  initialiseSchedulers();
+}
+
+//4-1 wheel: teeth at 0, 90 and 180 degrees. A coil charge start at 300 degrees is 120 degrees after the last tooth before
+//the gap, far outside the configured window, so would never be armed if the window was not widened to the gap
+static void test_missingtooth_arming_coarse_wheel(void)
+{
+  setup_arming(4, 300);
+
+  uint16_t position = 0;
+  turnTo(position, 4U * 4U);
+  TEST_ASSERT_TRUE(currentStatus.hasSync);
+  TEST_ASSERT_UINT16_WITHIN(2, 180, getAngleArmingWindow());
+  TEST_ASSERT_TRUE(ignitionArmed);
+
+  teardown_arming();
+}
+
+//36-1 wheel: the largest gap (20 degrees) is inside the configured window, which is used as it is
+static void test_missingtooth_arming_fine_wheel(void)
+{
+  setup_arming(36, 300);
+
+  uint16_t position = 0;
+  turnTo(position, 36U * 4U);
+  TEST_ASSERT_TRUE(currentStatus.hasSync);
+  TEST_ASSERT_EQUAL_UINT16(30, getAngleArmingWindow());
+  TEST_ASSERT_TRUE(ignitionArmed);
+
+  teardown_arming();
+}
+
+void testMissingToothArming()
+{
+  SET_UNITY_FILENAME() {
+    RUN_TEST_P(test_missingtooth_arming_coarse_wheel);
+    RUN_TEST_P(test_missingtooth_arming_fine_wheel);
+  }
+}
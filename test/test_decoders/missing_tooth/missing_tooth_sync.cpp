@@ -0,0 +1,155 @@
+#include <decoders.h>
+#include <globals.h>
+#include <unity.h>
+#include "missing_tooth.h"
+#include "../../test_utils.h"
+
+extern volatile unsigned long toothLastToothTime;
+extern volatile unsigned long toothLastSecToothTime;
+extern bool SetRevolutionTime(uint32_t revTime);
+
+// Turns a 36-1 crank wheel with a cam input, the same as the engine would during cranking. Positions are counted in
+// crank teeth from tooth #1 of the first revolution of a cycle, so position 72 is tooth #1 of the next cycle. The
+// missing tooth is at positions 35 and 71 of each cycle. The cam edges come just after the crank tooth at their position.
+
+#define SYNC_TOOTH_GAP 400UL //uS between crank teeth, around 4000rpm
+#define CYCLE_TEETH 72U
+
+struct cam_pattern_t {
+  uint8_t trigPatternSec;
+  uint8_t camTeeth[3];  //Cycle position of each cam edge
+  uint8_t camToothCount;
+  uint8_t phaseTooth;   //The cam edge that sets revolutionOne
+};
+
+static bool isCamTooth(uint16_t position, const cam_pattern_t &cam)
+{
+  for(uint8_t tooth = 0; tooth < cam.camToothCount; tooth++)
+  {
+    if( (position % CYCLE_TEETH) == cam.camTeeth[tooth] ) { return true; }
+  }
+  return false;
+}
+
+static void turnTo(uint16_t &position, uint16_t endPosition, const cam_pattern_t &cam)
+{
+  for(; position < endPosition; position++)
+  {
+    delayMicroseconds(SYNC_TOOTH_GAP);
+    if( (position % 36U) != 35U ) { triggerPri_missingTooth(); }
+    if( isCamTooth(position, cam) ) { triggerSec_missingTooth(); }
+  }
+}
+
+//The crank angle at a position, once the revolution has been identified by the cam
+static int16_t expectedCrankAngle(uint16_t position, const cam_pattern_t &cam)
+{
+  int16_t angle = (position % 36U) * 10;
+  if( ((position % CYCLE_TEETH) / 36U) == (cam.phaseTooth / 36U) ) { angle += 360; }
+  return angle;
+}
+
+//Turns the engine through to endPosition checking that sync is kept and that every tooth is in the right revolution
+static void assertSyncHeld(uint16_t &position, uint16_t endPosition, const cam_pattern_t &cam)
+{
+  const uint8_t syncLossCount = currentStatus.syncLossCounter;
+  while(position < endPosition)
+  {
+    const uint16_t toothPosition = position;
+    turnTo(position, position + 1U, cam);
+    if( (toothPosition % 36U) != 35U )
+    {
+      TEST_ASSERT_INT_WITHIN(5, expectedCrankAngle(toothPosition, cam), getCrankAngle_missingTooth());
+    }
+    TEST_ASSERT_TRUE(currentStatus.hasSync);
+  }
+  TEST_ASSERT_EQUAL_UINT8(syncLossCount, currentStatus.syncLossCounter);
+}
+
+static void setup_cam_sync(const cam_pattern_t &cam)
+{
+  configPage4.triggerTeeth = 36;
+  configPage4.triggerMissingTeeth = 1;
+  configPage4.TrigSpeed = CRANK_SPEED;
+  configPage4.trigPatternSec = cam.trigPatternSec;
+  configPage4.triggerAngle = 0;
+  configPage4.sparkMode = IGN_MODE_SEQUENTIAL;
+  configPage2.injLayout = INJ_SEQUENTIAL;
+  configPage2.strokes = FOUR_STROKE;
+  configPage2.perToothIgn = false;
+  triggerSetup_missingTooth();
+
+  //Engine stopped, no teeth seen on either input. The secondary tooth count is reset by the setup
+  toothLastToothTime = 0;
+  toothLastSecToothTime = 0;
+  toothLastMinusOneSecToothTime = 0;
+  revolutionOne = false;
+  currentStatus.hasSync = false;
+  BIT_CLEAR(currentStatus.status3, BIT_STATUS3_HALFSYNC);
+  currentStatus.RPM = 0;
+  SetRevolutionTime(SYNC_TOOTH_GAP * 36UL);
+}
+
+//Single tooth cam: full sync comes from the cam edge after the crank gap, not from the crank gap after that
+static void test_missingtooth_camSync_single(void)
+{
+  static const cam_pattern_t cam = { SEC_TRIGGER_SINGLE, { 50 }, 1, 50 };
+  setup_cam_sync(cam);
+
+  //The first cam edge at 50 only starts the secondary timing, the crank gap at 72 gives half sync
+  uint16_t position = 40;
+  turnTo(position, 122, cam);
+  TEST_ASSERT_FALSE(currentStatus.hasSync);
+  TEST_ASSERT_BIT_HIGH(BIT_STATUS3_HALFSYNC, currentStatus.status3);
+
+  turnTo(position, 123, cam);
+  TEST_ASSERT_TRUE(currentStatus.hasSync);
+  TEST_ASSERT_BIT_LOW(BIT_STATUS3_HALFSYNC, currentStatus.status3);
+  TEST_ASSERT_INT_WITHIN(5, expectedCrankAngle(122, cam), getCrankAngle_missingTooth());
+
+  assertSyncHeld(position, position + (2U * CYCLE_TEETH), cam);
+}
+
+//Toyota 3 tooth cam: 1 tooth in the 1st revolution and 2 in the 2nd. Full sync comes from the 2nd tooth of the 2nd revolution
+static void test_missingtooth_camSync_toyota3(void)
+{
+  static const cam_pattern_t cam = { SEC_TRIGGER_TOYOTA_3, { 10, 40, 58 }, 3, 58 };
+  setup_cam_sync(cam);
+
+  //The first cam edge at 10 only starts the secondary timing, the crank gap at 36 gives half sync
+  uint16_t position = 5;
+  turnTo(position, 58, cam);
+  TEST_ASSERT_FALSE(currentStatus.hasSync);
+  TEST_ASSERT_BIT_HIGH(BIT_STATUS3_HALFSYNC, currentStatus.status3);
+
+  turnTo(position, 59, cam);
+  TEST_ASSERT_TRUE(currentStatus.hasSync);
+  TEST_ASSERT_BIT_LOW(BIT_STATUS3_HALFSYNC, currentStatus.status3);
+  TEST_ASSERT_INT_WITHIN(5, expectedCrankAngle(58, cam), getCrankAngle_missingTooth());
+
+  assertSyncHeld(position, position + (2U * CYCLE_TEETH), cam);
+}
+
+//4-1 cam: any cam tooth before the crank gap already gives full sync there, the cam gap then sets the revolution.
+//That edge must not disturb the sync
+static void test_missingtooth_camSync_4_1(void)
+{
+  static const cam_pattern_t cam = { SEC_TRIGGER_4_1, { 2, 20, 38 }, 3, 2 };
+  setup_cam_sync(cam);
+
+  uint16_t position = 10;
+  turnTo(position, 75, cam);
+  TEST_ASSERT_TRUE(currentStatus.hasSync);
+  TEST_ASSERT_TRUE(revolutionOne);
+
+  assertSyncHeld(position, position + (2U * CYCLE_TEETH), cam);
+}
+
+void testMissingToothSync()
+{
+  SET_UNITY_FILENAME() {
+    RUN_TEST_P(test_missingtooth_camSync_single);
+    RUN_TEST_P(test_missingtooth_camSync_toyota3);
+    RUN_TEST_P(test_missingtooth_camSync_4_1);
+  }
+}
@@ -0,0 +1,191 @@
+#include <globals.h>
+#include <unity.h>
+#include <math.h>
+#include "rpm_estimator.h"
+#include "rpmEstimator.h"
+#include "../../test_utils.h"
+
+// ---------------------------------------------------------------------------
+// Trigger generator
+//
+// Generates the tooth times of a 36-1 crank wheel and feeds them directly to the estimator, as the primary trigger
+// interrupt would. The crank speed can include a firing pulsation (2 per revolution, as a 4 cylinder at idle), a
+// constant acceleration and random jitter on each tooth edge. The gap over the missing tooth is passed with an unknown
+// angle, the same as the missing tooth decoder does.
+// ---------------------------------------------------------------------------
+
+struct generatorParams {
+    uint16_t rpm;           // Mean RPM at the start
+    uint16_t pulsationRPM;  // Amplitude of the firing pulsation
+    uint16_t jitterUs;      // Maximum random error on each tooth edge
+    int16_t rpmAccel;       // RPM/s
+};
+
+struct generatorResult {
+    uint16_t minRPM;        // Lowest estRPM once settled
+    uint16_t maxRPM;        // Highest estRPM once settled
+    uint16_t lastRPM;       // estRPM at the end of the run
+    int16_t lastRPMdot;     // estRPMdot at the end of the run
+    uint16_t lastJitter;    // rpmJitter at the end of the run
+    uint32_t estimatorMicros; // Total time spent in the estimator functions
+    uint16_t teeth;         // Total teeth generated
+};
+
+static constexpr uint8_t GEN_TEETH = 36;
+static constexpr uint8_t GEN_MISSING = 1;
+static constexpr uint16_t GEN_TOOTH_ANGLE = 360 / GEN_TEETH;
+static constexpr uint16_t GEN_STEP_ANGLE = 2;
+static constexpr uint16_t GEN_REVOLUTIONS = 20;
+static constexpr uint16_t GEN_SETTLE_REVOLUTIONS = 4;
+
+static uint32_t generatorSeed;
+static int16_t generatorJitter(uint16_t jitterUs) {
+    if(jitterUs == 0U) { return 0; }
+    generatorSeed = (generatorSeed * 1103515245UL) + 12345UL;
+    return (int16_t)((int32_t)((generatorSeed >> 16) % ((2UL * jitterUs) + 1UL)) - (int32_t)jitterUs);
+}
+
+static generatorResult runGenerator(uint8_t windowType, uint8_t windowTeeth, const generatorParams &params) {
+    resetRPMEstimator(windowType, windowTeeth);
+    generatorSeed = 1;
+
+    generatorResult result = { UINT16_MAX, 0, 0, 0, 0, 0, 0 };
+    float crankAngle = 0.0f;
+    float meanRPM = params.rpm;
+    float toothTime = 1000.0f; // uS. Exact time of the tooth
+
+    for(uint16_t revolution = 0; revolution < GEN_REVOLUTIONS; revolution++) {
+        for(uint8_t tooth = 1; tooth <= (GEN_TEETH - GEN_MISSING); tooth++) {
+            uint16_t gapAngle = (tooth == 1U) ? (GEN_TOOTH_ANGLE * (GEN_MISSING + 1U)) : GEN_TOOTH_ANGLE;
+            //Integrate over the gap in small steps as the speed changes through it. The speed is taken at the middle of each step
+            for(uint16_t step = 0; step < gapAngle; step += GEN_STEP_ANGLE) {
+                float rpm = meanRPM + (params.pulsationRPM * sinf(2.0f * (crankAngle + (GEN_STEP_ANGLE / 2.0f)) * (float)M_PI / 180.0f));
+                float stepTime = (GEN_STEP_ANGLE * 1000000.0f) / (rpm * 6.0f);
+                toothTime += stepTime;
+                meanRPM += params.rpmAccel * (stepTime / 1000000.0f);
+                crankAngle += GEN_STEP_ANGLE;
+            }
+
+            uint32_t edgeTime = (uint32_t)toothTime + generatorJitter(params.jitterUs);
+            uint32_t startTime = micros();
+            addRPMEstimatorTooth(edgeTime, (tooth == 1U) ? 0U : GEN_TOOTH_ANGLE);
+            updateRPMEstimator();
+            result.estimatorMicros += micros() - startTime;
+            result.teeth++;
+
+            if(revolution >= GEN_SETTLE_REVOLUTIONS) {
+                if(currentStatus.estRPM < result.minRPM) { result.minRPM = currentStatus.estRPM; }
+                if(currentStatus.estRPM > result.maxRPM) { result.maxRPM = currentStatus.estRPM; }
+            }
+        }
+    }
+
+    result.lastRPM = currentStatus.estRPM;
+    result.lastRPMdot = currentStatus.estRPMdot;
+    result.lastJitter = currentStatus.rpmJitter;
+    return result;
+}
+
+static void test_rpmFromAngleTime(void) {
+    TEST_ASSERT_EQUAL_UINT16(600, rpmFromAngleTime(360, 100000UL));
+    TEST_ASSERT_EQUAL_UINT16(1000, rpmFromAngleTime(6, 1000UL));
+    TEST_ASSERT_EQUAL_UINT16(6000, rpmFromAngleTime(720, 20000UL));
+    TEST_ASSERT_EQUAL_UINT16(0, rpmFromAngleTime(360, 0UL));
+    TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, rpmFromAngleTime(720, 1UL));
+}
+
+static void test_rpmEstimator_disabled(void) {
+    resetRPMEstimator(RPM_EST_OFF, 1);
+    addRPMEstimatorTooth(1000UL, 10);
+    addRPMEstimatorTooth(2000UL, 10);
+    TEST_ASSERT_FALSE(updateRPMEstimator());
+    TEST_ASSERT_EQUAL_UINT16(0, currentStatus.estRPM);
+}
+
+static void test_rpmEstimator_needsWindow(void) {
+    //The first tooth only sets the reference time. A revolution window needs a full revolution
+    resetRPMEstimator(RPM_EST_REVOLUTION, 1);
+    addRPMEstimatorTooth(1000UL, 10);
+    TEST_ASSERT_FALSE(updateRPMEstimator());
+    addRPMEstimatorTooth(2000UL, 10);
+    TEST_ASSERT_FALSE(updateRPMEstimator());
+
+    resetRPMEstimator(RPM_EST_TOOTH, 1);
+    addRPMEstimatorTooth(1000UL, 10);
+    addRPMEstimatorTooth(2000UL, 10);
+    TEST_ASSERT_TRUE(updateRPMEstimator());
+    TEST_ASSERT_EQUAL_UINT16(1667, currentStatus.estRPM);
+    TEST_ASSERT_FALSE(updateRPMEstimator());
+}
+
+static void assert_constantSpeed(uint8_t windowType, uint8_t windowTeeth) {
+    generatorParams params = { 1000, 0, 0, 0 };
+    generatorResult result = runGenerator(windowType, windowTeeth, params);
+
+    //Includes the windows over the missing tooth
+    TEST_ASSERT_UINT16_WITHIN(1, 1000, result.minRPM);
+    TEST_ASSERT_UINT16_WITHIN(1, 1000, result.maxRPM);
+    TEST_ASSERT_INT16_WITHIN(200, 0, result.lastRPMdot);
+    //Only the 1uS rounding of the tooth times
+    TEST_ASSERT_LESS_OR_EQUAL_UINT16(1, result.lastJitter);
+}
+
+static void test_rpmEstimator_constantSpeed_tooth(void) { assert_constantSpeed(RPM_EST_TOOTH, 1); }
+static void test_rpmEstimator_constantSpeed_teeth(void) { assert_constantSpeed(RPM_EST_TEETH, 4); }
+static void test_rpmEstimator_constantSpeed_revolution(void) { assert_constantSpeed(RPM_EST_REVOLUTION, 1); }
+static void test_rpmEstimator_constantSpeed_cycle(void) { assert_constantSpeed(RPM_EST_CYCLE, 1); }
+
+static void test_rpmEstimator_acceleration(void) {
+    generatorParams params = { 2000, 0, 0, 2000 };
+    generatorResult result = runGenerator(RPM_EST_REVOLUTION, 1, params);
+
+    TEST_ASSERT_INT16_WITHIN(100, 2000, result.lastRPMdot);
+    TEST_ASSERT_GREATER_THAN_UINT16(2000, result.lastRPM);
+}
+
+// Characterises the estimator noise at idle for each window, with the firing pulsation and edge jitter of a real
+// engine. Longer windows should be progressively quieter, with the revolution and cycle windows averaging out the
+// firing pulsation completely.
+static void test_rpmEstimator_idleNoise(void) {
+    static constexpr uint8_t windows[][2] = { { RPM_EST_TOOTH, 1 }, { RPM_EST_TEETH, 4 }, { RPM_EST_TEETH, 8 }, { RPM_EST_REVOLUTION, 1 }, { RPM_EST_CYCLE, 1 } };
+    generatorParams params = { 850, 40, 20, 0 };
+    uint16_t lastSpread = UINT16_MAX;
+    uint16_t toothSpread = 0;
+    char msg[96];
+
+    for(uint8_t window = 0; window < _countof(windows); window++) {
+        generatorResult result = runGenerator(windows[window][0], windows[window][1], params);
+        uint16_t spread = result.maxRPM - result.minRPM;
+
+        sprintf_P(msg, PSTR("Window %" PRIu8 "/%" PRIu8 ": RPM %" PRIu16 "-%" PRIu16 ", jitter %" PRIu16 ", %" PRIu32 "uS/tooth"),
+            windows[window][0], windows[window][1], result.minRPM, result.maxRPM, result.lastJitter, result.estimatorMicros / result.teeth);
+        TEST_MESSAGE(msg);
+
+        TEST_ASSERT_LESS_OR_EQUAL_UINT16(lastSpread, spread);
+        if(window == 0U) { toothSpread = spread; }
+        TEST_ASSERT_UINT16_WITHIN(params.pulsationRPM + 20U, params.rpm, result.minRPM);
+        TEST_ASSERT_UINT16_WITHIN(params.pulsationRPM + 20U, params.rpm, result.maxRPM);
+        //The jitter figure is a property of the signal, not the window
+        TEST_ASSERT_GREATER_THAN_UINT16(0, result.lastJitter);
+        lastSpread = spread;
+    }
+    //The revolution and cycle windows average out the firing pulsation, leaving only the edge jitter
+    TEST_ASSERT_LESS_OR_EQUAL_UINT16(2, lastSpread);
+    TEST_ASSERT_GREATER_THAN_UINT16(2U * params.pulsationRPM, toothSpread);
+}
+
+void testRPMEstimator()
+{
+    SET_UNITY_FILENAME() {
+        RUN_TEST_P(test_rpmFromAngleTime);
+        RUN_TEST_P(test_rpmEstimator_disabled);
+        RUN_TEST_P(test_rpmEstimator_needsWindow);
+        RUN_TEST_P(test_rpmEstimator_constantSpeed_tooth);
+        RUN_TEST_P(test_rpmEstimator_constantSpeed_teeth);
+        RUN_TEST_P(test_rpmEstimator_constantSpeed_revolution);
+        RUN_TEST_P(test_rpmEstimator_constantSpeed_cycle);
+        RUN_TEST_P(test_rpmEstimator_acceleration);
+        RUN_TEST_P(test_rpmEstimator_idleNoise);
+    }
+    resetRPMEstimator(RPM_EST_OFF, 1);
+}
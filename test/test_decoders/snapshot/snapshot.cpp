@@ -0,0 +1,161 @@
+#include <unity.h>
+#include "snapshot.h"
+#include "decoders.h"
+#include "../../test_utils.h"
+
+extern void (*decoderSnapshotPreempt)(void);
+
+// ---------------------------------------------------------------------------
+// Simulated trigger interrupt
+//
+// Moves the decoder state on by one tooth of a 12 tooth wheel, the same as a decoder would. The preempt hook in
+// getDecoderSnapshot() calls this part way through the copy, so any copy that is not retried would mix the old and new
+// values.
+// ---------------------------------------------------------------------------
+
+static constexpr uint16_t SNAP_TEETH = 12;
+static constexpr unsigned long SNAP_GAP = 1000;
+static uint8_t preemptCount; //The number of times the next snapshot is interrupted
+static uint16_t preemptCalls;
+
+static void simulatedToothISR(void)
+{
+    toothLastMinusOneToothTime = toothLastToothTime;
+    toothLastToothTime += SNAP_GAP;
+    toothCurrentCount++;
+    if(toothCurrentCount > SNAP_TEETH)
+    {
+        toothCurrentCount = 1;
+        toothOneMinusOneTime = toothOneTime;
+        toothOneTime = toothLastToothTime;
+        revolutionOne = !revolutionOne;
+    }
+    triggerToothAngle = 360U / SNAP_TEETH;
+}
+
+static void preemptingWriter(void)
+{
+    preemptCalls++;
+    if(preemptCount > 0U)
+    {
+        preemptCount--;
+        simulatedToothISR();
+        decoderGeneration++;
+    }
+}
+
+static void stubTriggerHandler(void)
+{
+    simulatedToothISR();
+}
+
+static void setup_snapshot(void)
+{
+    toothOneTime = 1000UL;
+    toothOneMinusOneTime = toothOneTime - (SNAP_GAP * SNAP_TEETH);
+    toothLastToothTime = toothOneTime;
+    toothLastMinusOneToothTime = toothLastToothTime - SNAP_GAP;
+    toothCurrentCount = 1;
+    revolutionOne = false;
+    triggerToothAngle = 360U / SNAP_TEETH;
+    preemptCount = 0;
+    preemptCalls = 0;
+}
+
+static void assert_consistent(const decoder_snapshot_t &snapshot)
+{
+    //Each of these relationships only holds if all of the values came from the same tooth
+    TEST_ASSERT_EQUAL_UINT32(SNAP_GAP, snapshot.toothLastToothTime - snapshot.toothLastMinusOneToothTime);
+    TEST_ASSERT_EQUAL_UINT32(SNAP_GAP * SNAP_TEETH, snapshot.toothOneTime - snapshot.toothOneMinusOneTime);
+    TEST_ASSERT_EQUAL_UINT32((unsigned long)(snapshot.toothCurrentCount - 1U) * SNAP_GAP, snapshot.toothLastToothTime - snapshot.toothOneTime);
+}
+
+static void test_snapshot_noPreempt(void)
+{
+    setup_snapshot();
+    decoderSnapshotPreempt = preemptingWriter;
+
+    decoder_snapshot_t snapshot;
+    getDecoderSnapshot(snapshot);
+    decoderSnapshotPreempt = nullptr;
+
+    //A single pass when nothing changes
+    TEST_ASSERT_EQUAL_UINT16(1, preemptCalls);
+    TEST_ASSERT_EQUAL_UINT32(toothLastToothTime, snapshot.toothLastToothTime);
+    TEST_ASSERT_EQUAL_UINT16(360U / SNAP_TEETH, snapshot.triggerToothAngle);
+    assert_consistent(snapshot);
+}
+
+static void test_snapshot_preempted(void)
+{
+    setup_snapshot();
+    decoderSnapshotPreempt = preemptingWriter;
+    preemptCount = 1;
+
+    decoder_snapshot_t snapshot;
+    getDecoderSnapshot(snapshot);
+    decoderSnapshotPreempt = nullptr;
+
+    //The first copy was interrupted and must have been repeated, giving the values after the interrupt
+    TEST_ASSERT_EQUAL_UINT16(2, preemptCalls);
+    TEST_ASSERT_EQUAL_UINT16(2, snapshot.toothCurrentCount);
+    TEST_ASSERT_EQUAL_UINT32(toothLastToothTime, snapshot.toothLastToothTime);
+    assert_consistent(snapshot);
+}
+
+// Interrupts the snapshot a varying number of times (Including across tooth one, where the most values change) over
+// several revolutions and checks every copy is consistent.
+static void test_snapshot_stress(void)
+{
+    setup_snapshot();
+    decoderSnapshotPreempt = preemptingWriter;
+
+    for(uint16_t x = 0; x < (SNAP_TEETH * 20U); x++)
+    {
+        preemptCount = x % 4U;
+        preemptCalls = 0;
+        uint8_t expectedCalls = preemptCount + 1U;
+
+        decoder_snapshot_t snapshot;
+        getDecoderSnapshot(snapshot);
+
+        TEST_ASSERT_EQUAL_UINT16(expectedCalls, preemptCalls);
+        TEST_ASSERT_EQUAL_UINT16(toothCurrentCount, snapshot.toothCurrentCount);
+        TEST_ASSERT_EQUAL(revolutionOne, snapshot.revolutionOne);
+        assert_consistent(snapshot);
+
+        //And a tooth between snapshots
+        simulatedToothISR();
+        decoderGeneration++;
+    }
+    decoderSnapshotPreempt = nullptr;
+}
+
+static void test_snapshot_ISRGeneration(void)
+{
+    setup_snapshot();
+    void (*savedHandler)(void) = triggerHandler;
+    void (*savedSecondaryHandler)(void) = triggerSecondaryHandler;
+    triggerHandler = stubTriggerHandler;
+    triggerSecondaryHandler = stubTriggerHandler;
+
+    uint8_t generation = decoderGeneration;
+    decoderPrimaryISR();
+    TEST_ASSERT_EQUAL_UINT8((uint8_t)(generation + 1U), decoderGeneration);
+    TEST_ASSERT_EQUAL_UINT16(2, toothCurrentCount);
+    decoderSecondaryISR();
+    TEST_ASSERT_EQUAL_UINT8((uint8_t)(generation + 2U), decoderGeneration);
+
+    triggerHandler = savedHandler;
+    triggerSecondaryHandler = savedSecondaryHandler;
+}
+
+void testDecoderSnapshot(void)
+{
+    SET_UNITY_FILENAME() {
+        RUN_TEST_P(test_snapshot_noPreempt);
+        RUN_TEST_P(test_snapshot_preempted);
+        RUN_TEST_P(test_snapshot_stress);
+        RUN_TEST_P(test_snapshot_ISRGeneration);
+    }
+}
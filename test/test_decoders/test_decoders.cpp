@@ -11,6 +11,8 @@
 #include "FordST170/FordST170.h"
 #include "NGC/test_ngc.h"
 #include "SuzukiK6A/SuzukiK6A.h"
+#include "rpm_estimator/rpm_estimator.h"
+#include "snapshot/snapshot.h"
 
 extern void testDecoder_General(void);
 
@@ -27,6 +29,8 @@ void setup()
     UNITY_BEGIN();    // IMPORTANT LINE!
 
     testMissingTooth();
+    testMissingToothSync();
+    testMissingToothArming();
     testDualWheel();
     testRenix();
     testNissan360();
@@ -35,6 +39,8 @@ void setup()
     testSuzukiK6A_setEndTeeth();
     testSuzukiK6A_getCrankAngle();
     testDecoder_General();
+    testRPMEstimator();
+    testDecoderSnapshot();
 
     UNITY_END(); // stop unit testing
 
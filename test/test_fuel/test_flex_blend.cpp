@@ -0,0 +1,86 @@
+#include <globals.h>
+#include <unity.h>
+#include "test_flex_blend.h"
+#include "secondaryTables.h"
+#include "../test_utils.h"
+
+//Fills a 16x16 table with axes that start at a value and step evenly. Each cell is set from the RPM of its column
+template <class table_t>
+static void fillBlendTable(table_t &table, table3d_axis_t rpmStart, table3d_axis_t rpmStep, table3d_value_t (*rpmValue)(table3d_axis_t rpm))
+{
+  table_axis_iterator itX = table.axisX.begin();
+  for(table3d_axis_t rpm = rpmStart; !itX.at_end(); ++itX, rpm += rpmStep) { *itX = rpm; }
+  table_axis_iterator itY = table.axisY.begin();
+  for(table3d_axis_t load = 10; !itY.at_end(); ++itY, load += 10) { *itY = load; }
+  for(uint16_t index = 0; index < 256U; index++)
+  {
+    table.values.value_at((table3d_dim_t)index) = rpmValue(rpmStart + (table3d_axis_t)((index % 16U) * rpmStep));
+  }
+  invalidate_cache(&table.get_value_cache);
+}
+
+static table3d_value_t flatValue(table3d_axis_t) { return 50; }
+static table3d_value_t veFromRpm(table3d_axis_t rpm) { return (table3d_value_t)(rpm / 100); }
+static table3d_value_t advanceFromRpm(table3d_axis_t rpm) { return (table3d_value_t)((rpm / 200) + OFFSET_IGNITION); }
+
+static void setup_flex_blend(table3d_axis_t secondaryRpmStep)
+{
+  //The primary tables run from 500 to 8000 RPM. At 4000 RPM the secondary fuel table gives VE 40 and the secondary spark table 20 degrees,
+  //but only when looked up on their own axes
+  fillBlendTable(fuelTable, 500, 500, &flatValue);
+  fillBlendTable(fuelTable2, (table3d_axis_t)(secondaryRpmStep == 500 ? 500 : 1000), secondaryRpmStep, &veFromRpm);
+  fillBlendTable(ignitionTable, 500, 500, &flatValue);
+  fillBlendTable(ignitionTable2, (table3d_axis_t)(secondaryRpmStep == 500 ? 500 : 1000), secondaryRpmStep, &advanceFromRpm);
+  invalidateSecondaryTableAxes();
+
+  configPage10.fuel2Mode = FUEL2_MODE_FLEX_BLEND;
+  configPage10.spark2Mode = SPARK2_MODE_FLEX_BLEND;
+  configPage15.flexBlendEthLow = 0;
+  configPage15.flexBlendEthHigh = 85;
+  configPage2.fixAngEnable = 0;
+  BIT_CLEAR(currentStatus.engine, BIT_ENGINE_CRANK);
+  currentStatus.ethanolPct = 85; //Secondary tables only
+  currentStatus.RPM = 4000;
+  currentStatus.fuelLoad = 50;
+  currentStatus.ignLoad = 50;
+  currentStatus.VE1 = 50;
+  currentStatus.advance1 = 50 - OFFSET_IGNITION;
+}
+
+static void test_flex_blend_shared_axes(void)
+{
+  setup_flex_blend(500);
+  calculateSecondaryFuel();
+  calculateSecondarySpark();
+  TEST_ASSERT_EQUAL_UINT8(40, currentStatus.VE2);
+  TEST_ASSERT_EQUAL_UINT8(40, currentStatus.VE);
+  TEST_ASSERT_EQUAL_INT8(20, currentStatus.advance2);
+  TEST_ASSERT_EQUAL_INT8(20, currentStatus.advance);
+}
+
+//The secondary tables have their own RPM axis (1000-16000), so the axis search of the primary tables can't be used for them
+static void test_flex_blend_different_axes(void)
+{
+  setup_flex_blend(1000);
+  calculateSecondaryFuel();
+  calculateSecondarySpark();
+  TEST_ASSERT_EQUAL_UINT8(40, currentStatus.VE2);
+  TEST_ASSERT_EQUAL_UINT8(40, currentStatus.VE);
+  TEST_ASSERT_EQUAL_INT8(20, currentStatus.advance2);
+  TEST_ASSERT_EQUAL_INT8(20, currentStatus.advance);
+
+  //Half way between E0 and E85 is half way between the tables
+  currentStatus.ethanolPct = 42;
+  calculateSecondaryFuel();
+  calculateSecondarySpark();
+  TEST_ASSERT_UINT8_WITHIN(1, 45, currentStatus.VE);
+  TEST_ASSERT_INT8_WITHIN(1, 15, currentStatus.advance);
+}
+
+void testFlexBlend(void)
+{
+  SET_UNITY_FILENAME() {
+    RUN_TEST_P(test_flex_blend_shared_axes);
+    RUN_TEST_P(test_flex_blend_different_axes);
+  }
+}
@@ -7,6 +7,8 @@
 #include "test_corrections.h"
 #include "test_PW.h"
 #include "test_staging.h"
+#include "test_ve_learn.h"
+#include "test_flex_blend.h"
 
 #define UNITY_EXCLUDE_DETAILS
 
@@ -25,6 +27,8 @@ void setup()
     testCorrections();
     testPW();
     testStaging();
+    testVELearn();
+    testFlexBlend();
 
     UNITY_END(); // stop unit testing
 
@@ -0,0 +1,281 @@
+#include <globals.h>
+#include <unity.h>
+#include "test_ve_learn.h"
+#include "veLearn.h"
+#include "pages.h"
+#include "../test_utils.h"
+
+//Synthetic engine: the VE it actually needs at any RPM and load
+static int16_t engineVE(int16_t rpm, int16_t load)
+{
+  return 20 + ((load * 2) / 5) + (rpm / 200);
+}
+
+//The TS index of the VE table cell at an RPM and load that are on the axes
+static table3d_dim_t veCellIndex(int16_t rpm, int16_t load)
+{
+  return (table3d_dim_t)((((load - 10) / 10) * 16) + ((rpm - 500) / 500));
+}
+
+//The fuelling (%) that would have hit the AFR target, for an engine running open loop on the VE table
+static uint16_t engineCorrection(int16_t rpm, int16_t load)
+{
+  const uint16_t tableVE = get3DTableValue(&fuelTable, load, rpm);
+  return (uint16_t)(((uint32_t)engineVE(rpm, load) * 100U + (tableVE / 2U)) / tableVE);
+}
+
+static void setup_ve_learn(void)
+{
+  //RPM 500-8000 and load 10-160, tuned 10% lean of the engine
+  table_axis_iterator itX = fuelTable.axisX.begin();
+  for(table3d_axis_t rpm = 500; !itX.at_end(); ++itX, rpm += 500) { *itX = rpm; }
+  table_axis_iterator itY = fuelTable.axisY.begin();
+  for(table3d_axis_t load = 10; !itY.at_end(); ++itY, load += 10) { *itY = load; }
+  for(uint16_t index = 0; index < 256U; index++)
+  {
+    fuelTable.values.value_at((table3d_dim_t)index) = (table3d_value_t)((engineVE(500 + ((index % 16U) * 500), 10 + ((index / 16U) * 10)) * 9) / 10);
+  }
+  invalidate_cache(&fuelTable.get_value_cache);
+
+  configPage15.veLearnEnabled = 1;
+  configPage15.veLearnGain = 25;
+  configPage15.veLearnLimit = 20;
+  configPage15.veLearnSamples = 4;
+  currentStatus.veLearnStatus = 0;
+  clearTableOverlays();
+  resetVELearn();
+}
+
+//A cell that is sampled on its own moves to the VE of the engine, without changing its neighbours
+static void test_ve_learn_single_cell(void)
+{
+  setup_ve_learn();
+  const table3d_dim_t cell = veCellIndex(2000, 40);
+  const table3d_value_t nextCellVE = getLearnedVE(cell + 1U);
+
+  uint16_t samples = 0;
+  while( (abs((int16_t)getLearnedVE(cell) - engineVE(2000, 40)) > 1) && (samples < 200U) )
+  {
+    addVELearnSample(40, 2000, engineCorrection(2000, 40));
+    samples++;
+  }
+  char msg[64];
+  sprintf(msg, "Single cell converged in %u samples", samples);
+  TEST_MESSAGE(msg);
+
+  TEST_ASSERT_INT16_WITHIN(1, engineVE(2000, 40), getLearnedVE(cell));
+  TEST_ASSERT_LESS_THAN_UINT16(100, samples);
+  TEST_ASSERT_EQUAL_UINT8(nextCellVE, getLearnedVE(cell + 1U));
+  //The VE table isn't changed until the learned table is applied
+  TEST_ASSERT_EQUAL_UINT8((engineVE(2000, 40) * 9) / 10, fuelTable.values.value_at(cell));
+}
+
+//Half way between 2 cells, each cell gets half the weight of a sample
+static void test_ve_learn_weighting(void)
+{
+  setup_ve_learn();
+  for(uint8_t sample = 0; sample < 7U; sample++) { TEST_ASSERT_FALSE(addVELearnSample(40, 2250, 110)); }
+  TEST_ASSERT_EQUAL_UINT16(0, currentStatus.veLearnUpdates);
+  TEST_ASSERT_TRUE(addVELearnSample(40, 2250, 110));
+  TEST_ASSERT_EQUAL_UINT16(2, currentStatus.veLearnUpdates);
+}
+
+//The learned VE stays within veLearnLimit of the VE table
+static void test_ve_learn_limit(void)
+{
+  setup_ve_learn();
+  configPage15.veLearnLimit = 10;
+  const table3d_dim_t cell = veCellIndex(3000, 60);
+  const int16_t tableVE = fuelTable.values.value_at(cell);
+
+  for(uint8_t sample = 0; sample < 200U; sample++) { addVELearnSample(60, 3000, 150); }
+  TEST_ASSERT_EQUAL_UINT8(tableVE + ((tableVE * 10) / 100), getLearnedVE(cell));
+}
+
+//The limit is on the total change from the VE table, so learning again after an apply can't go past it
+static void test_ve_learn_limit_applied(void)
+{
+  setup_ve_learn();
+  configPage15.veLearnLimit = 10;
+  const table3d_dim_t cell = veCellIndex(3000, 60);
+  const int16_t tableVE = fuelTable.values.value_at(cell);
+
+  for(uint8_t apply = 0; apply < 3U; apply++)
+  {
+    for(uint8_t sample = 0; sample < 200U; sample++) { addVELearnSample(60, 3000, 150); }
+    applyVELearn();
+  }
+  TEST_ASSERT_EQUAL_UINT8(tableVE, fuelTable.values.value_at(cell));
+  TEST_ASSERT_EQUAL_INT8((tableVE * 10) / 100, getTableOverlay(&fuelTable, cell));
+  TEST_ASSERT_EQUAL_UINT8(tableVE + ((tableVE * 10) / 100), getLearnedVE(cell));
+}
+
+//Simulated drive over part of the table, stepping through the operating points on and between the cells
+static void test_ve_learn_surface(void)
+{
+  setup_ve_learn();
+  configPage15.veLearnGain = 50;
+  configPage15.veLearnSamples = 2;
+
+  uint32_t samples = 0;
+  uint8_t pass = 0;
+  int16_t worstError;
+  do
+  {
+    for(int16_t load = 20; load <= 60; load += 5)
+    {
+      for(int16_t rpm = 1000; rpm <= 3000; rpm += 250)
+      {
+        for(uint8_t sample = 0; sample < 2U; sample++) { addVELearnSample(load, rpm, engineCorrection(rpm, load)); }
+        samples += 2U;
+      }
+    }
+    pass++;
+
+    worstError = 0;
+    for(int16_t load = 20; load <= 60; load += 10)
+    {
+      for(int16_t rpm = 1000; rpm <= 3000; rpm += 500)
+      {
+        worstError = max(worstError, (int16_t)abs((int16_t)getLearnedVE(veCellIndex(rpm, load)) - engineVE(rpm, load)));
+      }
+    }
+  } while( (worstError > 1) && (pass < 20U) );
+
+  char msg[80];
+  sprintf(msg, "Surface converged in %u passes, %lu samples (%lus at 10Hz)", pass, (unsigned long)samples, (unsigned long)(samples / 10U));
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_LESS_OR_EQUAL_INT16(1, worstError);
+  TEST_ASSERT_LESS_THAN_UINT8(10, pass);
+}
+
+//Applying moves the learned cells into the table overlay, where they are used for fuelling until they are committed
+static void test_ve_learn_apply_reset(void)
+{
+  setup_ve_learn();
+  const table3d_dim_t cell = veCellIndex(2000, 40);
+  const table3d_value_t tableVE = fuelTable.values.value_at(cell);
+  for(uint8_t sample = 0; sample < 40U; sample++) { addVELearnSample(40, 2000, 110); }
+  const table3d_value_t learned = getLearnedVE(cell);
+  TEST_ASSERT_NOT_EQUAL(tableVE, learned);
+
+  applyVELearn();
+  TEST_ASSERT_EQUAL_UINT8(tableVE, fuelTable.values.value_at(cell));
+  TEST_ASSERT_EQUAL_INT8(learned - tableVE, getTableOverlay(&fuelTable, cell));
+  TEST_ASSERT_EQUAL_UINT8(learned, get3DTableValue(&fuelTable, 40, 2000));
+  TEST_ASSERT_EQUAL_UINT8(learned, getLearnedVE(cell));
+  TEST_ASSERT_BIT_LOW(VE_LEARN_PENDING, currentStatus.veLearnStatus);
+
+  //Applying again doesn't add the same change twice
+  applyVELearn();
+  TEST_ASSERT_EQUAL_UINT8(learned, get3DTableValue(&fuelTable, 40, 2000));
+
+  (void)applyTableOverlays();
+  TEST_ASSERT_EQUAL_UINT8(learned, fuelTable.values.value_at(cell));
+
+  fuelTable.values.value_at(cell) = 30;
+  resetVELearn();
+  TEST_ASSERT_EQUAL_UINT8(30, getLearnedVE(cell));
+  TEST_ASSERT_EQUAL_UINT16(0, currentStatus.veLearnUpdates);
+}
+
+//Only the learned cells are changed, so edits made to the rest of the VE table after learning started are kept
+static void test_ve_learn_apply_keeps_edits(void)
+{
+  setup_ve_learn();
+  const table3d_dim_t cell = veCellIndex(2000, 40);
+  const table3d_dim_t editedCell = veCellIndex(5000, 100);
+  for(uint8_t sample = 0; sample < 40U; sample++) { addVELearnSample(40, 2000, 110); }
+  const int16_t learnedChange = (int16_t)getLearnedVE(cell) - (int16_t)fuelTable.values.value_at(cell);
+
+  fuelTable.values.value_at(editedCell) = 99;
+  fuelTable.values.value_at(cell) = 50;
+  applyVELearn();
+  (void)applyTableOverlays();
+
+  TEST_ASSERT_EQUAL_UINT8(99, fuelTable.values.value_at(editedCell));
+  TEST_ASSERT_EQUAL_UINT8(50 + learnedChange, fuelTable.values.value_at(cell));
+}
+
+//Cells that don't fit in the overlay are kept until the next apply
+static void test_ve_learn_apply_overlay_full(void)
+{
+  setup_ve_learn();
+  //Half way between 2 cells, so both are learned
+  for(uint8_t sample = 0; sample < 40U; sample++) { addVELearnSample(40, 2250, 110); }
+  const table3d_value_t learned1 = getLearnedVE(veCellIndex(2000, 40));
+  const table3d_value_t learned2 = getLearnedVE(veCellIndex(2500, 40));
+  //Leave room in the overlay for one cell
+  for(uint8_t cell = 0; cell < TABLE3D_OVERLAY_SIZE - 1U; cell++) { TEST_ASSERT_TRUE(setTableOverlay(&ignitionTable, ignMapPage, cell, 1)); }
+
+  applyVELearn();
+  TEST_ASSERT_BIT_HIGH(VE_LEARN_PENDING, currentStatus.veLearnStatus);
+  TEST_ASSERT_EQUAL_UINT8(learned1, getLearnedVE(veCellIndex(2000, 40)));
+  TEST_ASSERT_EQUAL_UINT8(learned2, getLearnedVE(veCellIndex(2500, 40)));
+
+  clearTableOverlays();
+  applyVELearn();
+  TEST_ASSERT_BIT_LOW(VE_LEARN_PENDING, currentStatus.veLearnStatus);
+  TEST_ASSERT_EQUAL_UINT8(learned2, get3DTableValue(&fuelTable, 40, 2500));
+  clearTableOverlays();
+}
+
+//A change that takes the overlay of a cell past what it can hold is applied as far as it can be, and the rest is kept
+static void test_ve_learn_apply_overlay_clipped(void)
+{
+  setup_ve_learn();
+  const table3d_dim_t cell = veCellIndex(2000, 40);
+  for(uint8_t sample = 0; sample < 40U; sample++) { addVELearnSample(40, 2000, 110); }
+  const int16_t learnedChange = (int16_t)getLearnedVE(cell) - (int16_t)fuelTable.values.value_at(cell);
+  TEST_ASSERT_GREATER_THAN_INT16(0, learnedChange);
+
+  //An overlay change made from TS after the cell was learned
+  TEST_ASSERT_TRUE(setTableOverlay(&fuelTable, veMapPage, cell, INT8_MAX - 1));
+  applyVELearn();
+  TEST_ASSERT_EQUAL_INT8(INT8_MAX, getTableOverlay(&fuelTable, cell));
+  TEST_ASSERT_BIT_HIGH(VE_LEARN_PENDING, currentStatus.veLearnStatus);
+  TEST_ASSERT_EQUAL_UINT8(fuelTable.values.value_at(cell) + INT8_MAX - 1 + learnedChange, getLearnedVE(cell));
+
+  (void)applyTableOverlays();
+  applyVELearn();
+  TEST_ASSERT_BIT_LOW(VE_LEARN_PENDING, currentStatus.veLearnStatus);
+  TEST_ASSERT_EQUAL_INT8(learnedChange - 1, getTableOverlay(&fuelTable, cell));
+  clearTableOverlays();
+}
+
+//Nothing is learned when disabled, or without a wideband sensor
+static void test_ve_learn_disabled(void)
+{
+  setup_ve_learn();
+  currentStatus.RPM = 2000;
+  currentStatus.fuelLoad = 40;
+  currentStatus.afrTarget = 147;
+  currentStatus.O2 = 160;
+  currentStatus.egoCorrection = 100;
+
+  configPage15.veLearnEnabled = 0;
+  configPage6.egoType = EGO_TYPE_WIDE;
+  veLearnSample();
+  TEST_ASSERT_BIT_LOW(VE_LEARN_ACTIVE, currentStatus.veLearnStatus);
+
+  configPage15.veLearnEnabled = 1;
+  configPage6.egoType = EGO_TYPE_OFF;
+  veLearnSample();
+  TEST_ASSERT_BIT_LOW(VE_LEARN_ACTIVE, currentStatus.veLearnStatus);
+}
+
+void testVELearn(void)
+{
+  SET_UNITY_FILENAME() {
+    RUN_TEST_P(test_ve_learn_single_cell);
+    RUN_TEST_P(test_ve_learn_weighting);
+    RUN_TEST_P(test_ve_learn_limit);
+    RUN_TEST_P(test_ve_learn_limit_applied);
+    RUN_TEST_P(test_ve_learn_surface);
+    RUN_TEST_P(test_ve_learn_apply_reset);
+    RUN_TEST_P(test_ve_learn_apply_keeps_edits);
+    RUN_TEST_P(test_ve_learn_apply_overlay_full);
+    RUN_TEST_P(test_ve_learn_apply_overlay_clipped);
+    RUN_TEST_P(test_ve_learn_disabled);
+  }
+}
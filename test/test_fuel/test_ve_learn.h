@@ -0,0 +1 @@
+void testVELearn(void);
@@ -3,6 +3,8 @@
 #include <avr/sleep.h>
 
 void testIgnCorrections(void);
+void testRevLimit(void);
+void testIgnitionTrims(void);
 
 #define UNITY_EXCLUDE_DETAILS
 
@@ -19,6 +21,8 @@ void setup()
     UNITY_BEGIN();    // IMPORTANT LINE!
 
     testIgnCorrections();
+    testRevLimit();
+    testIgnitionTrims();
 
     UNITY_END(); // stop unit testing
 
@@ -0,0 +1,151 @@
+#include <unity.h>
+#include "globals.h"
+#include "ignitionTrim.h"
+#include "schedule_calcs.h"
+#include "crankMaths.h"
+#include "../test_utils.h"
+
+extern bool SetRevolutionTime(uint32_t revTime);
+
+TEST_DATA_P table3d_axis_t trimRpmAxis[] = { 1000, 2000, 3000, 4000 };
+TEST_DATA_P table3d_axis_t trimLoadAxis[] = { 25, 50, 75, 100 };
+
+static void setup_ignition_trims(void)
+{
+  //Trim 1 goes from 0 to +4 degrees with RPM, trim 2 from -8 to +4 with an extra +16 degrees on the highest load row
+  TEST_DATA_P table3d_value_t trim1Values[] = {
+    128, 128, 130, 132,
+    128, 128, 130, 132,
+    128, 128, 130, 132,
+    128, 128, 130, 132,
+  };
+  const byte trim2Values[IGN_TRIM_CELLS] = {
+    120, 124, 128, 132,
+    120, 124, 128, 132,
+    120, 124, 128, 132,
+    136, 140, 144, 148,
+  };
+  const byte trim3Values[IGN_TRIM_CELLS] = {
+    118, 118, 118, 118,
+    118, 118, 118, 118,
+    118, 118, 118, 118,
+    118, 118, 118, 118,
+  };
+  populate_table_P(ignTrim1Table, trimRpmAxis, trimLoadAxis, trim1Values);
+  //Tables 2-8 are values only, in the order TS sends them (Lowest load row first)
+  memcpy(ignTrimValues[0], trim2Values, IGN_TRIM_CELLS);
+  memcpy(ignTrimValues[1], trim3Values, IGN_TRIM_CELLS);
+  memset(configPage15.dwellTrimValues, OFFSET_DWELLTRIM, sizeof(configPage15.dwellTrimValues));
+
+  maxIgnOutputs = 2;
+  CRANK_ANGLE_MAX_IGN = 360;
+  currentStatus.RPM = 3500;
+  currentStatus.ignLoad = 60;
+  currentStatus.dwell = 3000;
+  resetIgnitionTrims();
+}
+
+static void test_ignition_trims_lookup(void)
+{
+  setup_ignition_trims();
+  calculateIgnitionTrims();
+
+  TEST_ASSERT_INT8_WITHIN(1, 3, getIgnitionTrim(IGN1_CMD_BIT));
+  //Looked up on the axes of table 1
+  TEST_ASSERT_INT8_WITHIN(1, 2, getIgnitionTrim(IGN2_CMD_BIT));
+  //Channels that are not in use are not looked up
+  TEST_ASSERT_EQUAL_INT8(0, getIgnitionTrim(IGN3_CMD_BIT));
+
+  maxIgnOutputs = 3;
+  calculateIgnitionTrims();
+  TEST_ASSERT_EQUAL_INT8(-10, getIgnitionTrim(IGN3_CMD_BIT));
+}
+
+//The highest load row of the value only tables is the last row that TS sends
+static void test_ignition_trims_load(void)
+{
+  setup_ignition_trims();
+  currentStatus.ignLoad = 90;
+  calculateIgnitionTrims();
+
+  TEST_ASSERT_INT8_WITHIN(1, 3, getIgnitionTrim(IGN1_CMD_BIT));
+  TEST_ASSERT_INT8_WITHIN(1, 11, getIgnitionTrim(IGN2_CMD_BIT));
+}
+
+//The dwell trims are a percentage of the dwell and only move the start angle
+static void test_ignition_trims_dwell(void)
+{
+  setup_ignition_trims();
+  //Channel 1 +10% at the highest load, channel 2 -10% everywhere
+  memset(configPage15.dwellTrimValues[0] + 12, OFFSET_DWELLTRIM + 10, 4);
+  memset(configPage15.dwellTrimValues[1], OFFSET_DWELLTRIM - 10, IGN_TRIM_CELLS);
+  memset(ignTrimValues[0], OFFSET_IGNTRIM, IGN_TRIM_CELLS);
+  currentStatus.RPM = 1000; //No advance trim on channel 1
+  currentStatus.ignLoad = 100;
+  SetRevolutionTime(15000UL); //4000rpm
+  calculateIgnitionTrims();
+
+  TEST_ASSERT_EQUAL_INT16(300, getIgnitionDwellTrim(IGN1_CMD_BIT));
+  TEST_ASSERT_EQUAL_INT16(-300, getIgnitionDwellTrim(IGN2_CMD_BIT));
+  //Channels that are not in use are not looked up
+  TEST_ASSERT_EQUAL_INT16(0, getIgnitionDwellTrim(IGN3_CMD_BIT));
+
+  ignition1EndAngle = 10;
+  ignition1StartAngle = 50;
+  ignition2EndAngle = 10;
+  ignition2StartAngle = 50;
+  trimIgnitionAngles();
+
+  TEST_ASSERT_EQUAL_INT(10, ignition1EndAngle);
+  TEST_ASSERT_EQUAL_INT(50 - (int)timeToAngleDegPerMicroSec(300), ignition1StartAngle);
+  TEST_ASSERT_EQUAL_INT(10, ignition2EndAngle);
+  TEST_ASSERT_EQUAL_INT(50 + (int)timeToAngleDegPerMicroSec(300), ignition2StartAngle);
+}
+
+//Advance moves both the end and the start angle earlier, wrapping around the cycle
+static void test_ignition_trims_angles(void)
+{
+  setup_ignition_trims();
+  currentStatus.RPM = 4000;
+  calculateIgnitionTrims();
+
+  ignition1EndAngle = 10;
+  ignition1StartAngle = 50;
+  ignition2EndAngle = 2;
+  ignition2StartAngle = 42;
+  trimIgnitionAngles();
+
+  TEST_ASSERT_EQUAL_INT(6, ignition1EndAngle);
+  TEST_ASSERT_EQUAL_INT(46, ignition1StartAngle);
+  TEST_ASSERT_EQUAL_INT(358, ignition2EndAngle);
+  TEST_ASSERT_EQUAL_INT(38, ignition2StartAngle);
+}
+
+static void test_ignition_trims_reset(void)
+{
+  setup_ignition_trims();
+  memset(configPage15.dwellTrimValues[0], OFFSET_DWELLTRIM + 10, IGN_TRIM_CELLS);
+  calculateIgnitionTrims();
+  resetIgnitionTrims();
+
+  ignition1EndAngle = 10;
+  ignition1StartAngle = 50;
+  trimIgnitionAngles();
+
+  TEST_ASSERT_EQUAL_INT8(0, getIgnitionTrim(IGN1_CMD_BIT));
+  TEST_ASSERT_EQUAL_INT8(0, getIgnitionTrim(IGN2_CMD_BIT));
+  TEST_ASSERT_EQUAL_INT16(0, getIgnitionDwellTrim(IGN1_CMD_BIT));
+  TEST_ASSERT_EQUAL_INT(10, ignition1EndAngle);
+  TEST_ASSERT_EQUAL_INT(50, ignition1StartAngle);
+}
+
+void testIgnitionTrims(void)
+{
+  SET_UNITY_FILENAME() {
+    RUN_TEST_P(test_ignition_trims_lookup);
+    RUN_TEST_P(test_ignition_trims_load);
+    RUN_TEST_P(test_ignition_trims_dwell);
+    RUN_TEST_P(test_ignition_trims_angles);
+    RUN_TEST_P(test_ignition_trims_reset);
+  }
+}
@@ -0,0 +1,152 @@
+#include <unity.h>
+#include "globals.h"
+#include "engineProtection.h"
+#include "../test_utils.h"
+
+static void test_calculateRPMAccel(void) {
+    // 100 RPM rise over 0.1s = 1000 RPM/s
+    TEST_ASSERT_INT16_WITHIN(5, 1000, calculateRPMAccel(5100, 5000, 100000UL));
+    TEST_ASSERT_INT16_WITHIN(5, -1000, calculateRPMAccel(5000, 5100, 100000UL));
+    // 1 revolution at 6000 RPM (10mS) rising by 200 RPM = 20000 RPM/s
+    TEST_ASSERT_INT16_WITHIN(100, 20000, calculateRPMAccel(6200, 6000, 10000UL));
+    // Saturates rather than overflows
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, calculateRPMAccel(9000, 1000, 1000UL));
+    TEST_ASSERT_EQUAL_INT16(-INT16_MAX, calculateRPMAccel(1000, 9000, 1000UL));
+    TEST_ASSERT_EQUAL_INT16(0, calculateRPMAccel(1000, 1000, 0UL));
+}
+
+static void test_predictRPM(void) {
+    // 1 cycle at 6000 RPM is 20mS
+    TEST_ASSERT_EQUAL_UINT16(6200, predictRPM(6000, 10000, 20000UL));
+    TEST_ASSERT_EQUAL_UINT16(5800, predictRPM(6000, -10000, 20000UL));
+    TEST_ASSERT_EQUAL_UINT16(6000, predictRPM(6000, 0, 20000UL));
+    // Clamped to the valid RPM range
+    TEST_ASSERT_EQUAL_UINT16(0, predictRPM(100, -INT16_MAX, 1000000UL));
+    TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, predictRPM(60000, INT16_MAX, 1000000UL));
+}
+
+static void test_predictiveLimitPercent(void) {
+    // Not predicted to reach the limit
+    TEST_ASSERT_EQUAL_UINT8(0, predictiveLimitPercent(6000, 6500, 7000));
+    TEST_ASSERT_EQUAL_UINT8(0, predictiveLimitPercent(6000, 7000, 7000));
+    // Half of the predicted rise is over the limit
+    TEST_ASSERT_EQUAL_UINT8(50, predictiveLimitPercent(6900, 7100, 7000));
+    TEST_ASSERT_EQUAL_UINT8(33, predictiveLimitPercent(6600, 7200, 7000));
+    // At or over the limit is always a full cut, even if decelerating
+    TEST_ASSERT_EQUAL_UINT8(100, predictiveLimitPercent(7000, 7300, 7000));
+    TEST_ASSERT_EQUAL_UINT8(100, predictiveLimitPercent(7100, 6900, 7000));
+}
+
+static void test_updateRPMPrediction_disabled(void) {
+    configPage15.revLimitPredict = false;
+    currentStatus.RPM = 6000;
+    currentStatus.rpmDOT = 10000;
+    currentStatus.predictedRPM = 0;
+
+    updateRPMPrediction(false);
+    TEST_ASSERT_EQUAL_UINT16(6000, currentStatus.predictedRPM);
+    TEST_ASSERT_EQUAL_UINT16(6000, getLimiterRPM());
+}
+
+// ---------------------------------------------------------------------------
+// Engine inertia model
+//
+// Each simulated revolution the limiter decides a cut percentage from the current (or predicted) RPM,
+// then the engine accelerates according to the torque that remains after the cut, less a drag term
+// proportional to RPM. This is enough to reproduce the overshoot and limit cycle oscillation of the
+// reactive limiter.
+// ---------------------------------------------------------------------------
+
+struct inertiaModelResult {
+    uint16_t peakRPM;   // The highest RPM reached
+    uint16_t settledMin; // The lowest RPM once settled at the limit
+    uint16_t settledMax; // The highest RPM once settled at the limit
+};
+
+static constexpr uint16_t MODEL_RPM_LIMIT = 7000;
+static constexpr uint16_t MODEL_REVOLUTIONS = 1500;
+static constexpr uint16_t MODEL_SETTLE_REVOLUTIONS = 1000;
+
+static inertiaModelResult runInertiaModel(bool predictive, int32_t fullTorqueAccel) {
+    configPage15.revLimitPredict = predictive;
+    configPage2.strokes = FOUR_STROKE;
+    currentStatus.RPM = 0;
+    updateRPMPrediction(false); //Resets the prediction state
+    currentStatus.startRevolutions = 1;
+    currentStatus.rpmDOT = 0;
+
+    inertiaModelResult result = { 0, UINT16_MAX, 0 };
+    int32_t rpm = 3000;
+    int32_t rpm100ms = rpm;
+    uint32_t modelTime = 0;
+    uint32_t lastRpmDOTTime = 0;
+    bool torqueReduced = false;
+
+    for(uint16_t revolution = 0; revolution < MODEL_REVOLUTIONS; revolution++) {
+        revolutionTime = 60000000UL / (uint32_t)rpm;
+        currentStatus.RPM = (uint16_t)rpm;
+        updateRPMPrediction(torqueReduced);
+
+        //Same decision as the main loop makes for the hard limit
+        uint16_t limiterRPM = getLimiterRPM();
+        uint8_t cutPercent = 0;
+        if(currentStatus.RPM >= MODEL_RPM_LIMIT) { cutPercent = 100; }
+        else if(limiterRPM > MODEL_RPM_LIMIT) { cutPercent = predictiveLimitPercent(currentStatus.RPM, limiterRPM, MODEL_RPM_LIMIT); }
+        torqueReduced = (cutPercent > 0U);
+
+        int32_t rpmAccel = ((fullTorqueAccel * (int32_t)(100U - cutPercent)) / 100) - (rpm / 4);
+        rpm = rpm + ((rpmAccel * (int32_t)(revolutionTime / 1000UL)) / 1000);
+        modelTime += revolutionTime;
+        currentStatus.startRevolutions++;
+
+        //rpmDOT as calculated by the 10Hz timer
+        if((modelTime - lastRpmDOTTime) >= 100000UL) {
+            currentStatus.rpmDOT = (int)((rpm - rpm100ms) * 10);
+            rpm100ms = rpm;
+            lastRpmDOTTime = modelTime;
+        }
+
+        if(rpm > result.peakRPM) { result.peakRPM = (uint16_t)rpm; }
+        if(revolution >= MODEL_SETTLE_REVOLUTIONS) {
+            if(rpm < result.settledMin) { result.settledMin = (uint16_t)rpm; }
+            if(rpm > result.settledMax) { result.settledMax = (uint16_t)rpm; }
+        }
+    }
+
+    configPage15.revLimitPredict = false;
+    return result;
+}
+
+static void assert_inertiaModel(int32_t fullTorqueAccel) {
+    inertiaModelResult reactive = runInertiaModel(false, fullTorqueAccel);
+    inertiaModelResult predictive = runInertiaModel(true, fullTorqueAccel);
+
+    // The reactive limiter always overshoots by close to 1 revolution of acceleration
+    TEST_ASSERT_GREATER_THAN_UINT16(MODEL_RPM_LIMIT, reactive.peakRPM);
+    // Predictive limiter should not overshoot
+    TEST_ASSERT_LESS_OR_EQUAL_UINT16(MODEL_RPM_LIMIT, predictive.peakRPM);
+    // Should settle close to the limit...
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT16(MODEL_RPM_LIMIT - 50U, predictive.settledMin);
+    // ...and oscillate less than the reactive limiter
+    TEST_ASSERT_LESS_OR_EQUAL_UINT16(20U, predictive.settledMax - predictive.settledMin);
+    TEST_ASSERT_LESS_THAN_UINT16(reactive.settledMax - reactive.settledMin, predictive.settledMax - predictive.settledMin);
+}
+
+static void test_revLimit_inertiaModel_lowAccel(void) {
+    assert_inertiaModel(5000);
+}
+
+static void test_revLimit_inertiaModel_highAccel(void) {
+    assert_inertiaModel(20000);
+}
+
+void testRevLimit(void) {
+    SET_UNITY_FILENAME() {
+        RUN_TEST_P(test_calculateRPMAccel);
+        RUN_TEST_P(test_predictRPM);
+        RUN_TEST_P(test_predictiveLimitPercent);
+        RUN_TEST_P(test_updateRPMPrediction_disabled);
+        RUN_TEST_P(test_revLimit_inertiaModel_lowAccel);
+        RUN_TEST_P(test_revLimit_inertiaModel_highAccel);
+    }
+}
@@ -0,0 +1,1499 @@
+/*
+ * The board pin mappings as they were set by the switch in setPinMapping() before they were moved to the table in
+ * boardPinMaps.cpp. Kept only to check that the table gives identical pin assignments. Do not add new boards here.
+ */
+#include "globals.h"
+#include "acc_mc33810.h"
+#include "comms_secondary.h"
+
+void legacyBoardPinMapping(byte boardID)
+{
+  switch (boardID)
+  {
+    //Note: Case 0 (Speeduino v0.1) was removed in Nov 2020 to handle default case for blank FRAM modules
+
+    case 1:
+    #ifndef SMALL_FLASH_MODE //No support for bluepill here anyway
+      //Pin mappings as per the v0.2 shield
+      pinInjector1 = 8; //Output pin injector 1 is on
+      pinInjector2 = 9; //Output pin injector 2 is on
+      pinInjector3 = 10; //Output pin injector 3 is on
+      pinInjector4 = 11; //Output pin injector 4 is on
+      pinInjector5 = 12; //Output pin injector 5 is on
+      pinCoil1 = 28; //Pin for coil 1
+      pinCoil2 = 24; //Pin for coil 2
+      pinCoil3 = 40; //Pin for coil 3
+      pinCoil4 = 36; //Pin for coil 4
+      pinCoil5 = 34; //Pin for coil 5 PLACEHOLDER value for now
+      pinTrigger = 20; //The CAS pin
+      pinTrigger2 = 21; //The Cam Sensor pin
+      pinTrigger3 = 3; //The Cam sensor 2 pin
+      pinTPS = A2; //TPS input pin
+      pinMAP = A3; //MAP sensor pin
+      pinIAT = A0; //IAT sensor pin
+      pinCLT = A1; //CLS sensor pin
+      pinO2 = A8; //O2 Sensor pin
+      pinBat = A4; //Battery reference voltage pin
+      pinDisplayReset = 48; // OLED reset pin
+      pinTachOut = 49; //Tacho output pin
+      pinIdle1 = 30; //Single wire idle control
+      pinIdle2 = 31; //2 wire idle control
+      pinStepperDir = 16; //Direction pin  for DRV8825 driver
+      pinStepperStep = 17; //Step pin for DRV8825 driver
+      pinFan = 47; //Pin for the fan output
+      pinFuelPump = 4; //Fuel pump output
+      pinFlex = 2; // Flex sensor (Must be external interrupt enabled)
+      pinResetControl = 43; //Reset control output
+      break;
+    #endif
+    case 2:
+    #ifndef SMALL_FLASH_MODE //No support for bluepill here anyway
+      //Pin mappings as per the v0.3 shield
+      pinInjector1 = 8; //Output pin injector 1 is on
+      pinInjector2 = 9; //Output pin injector 2 is on
+      pinInjector3 = 10; //Output pin injector 3 is on
+      pinInjector4 = 11; //Output pin injector 4 is on
+      pinInjector5 = 12; //Output pin injector 5 is on
+      pinCoil1 = 28; //Pin for coil 1
+      pinCoil2 = 24; //Pin for coil 2
+      pinCoil3 = 40; //Pin for coil 3
+      pinCoil4 = 36; //Pin for coil 4
+      pinCoil5 = 34; //Pin for coil 5 PLACEHOLDER value for now
+      pinTrigger = 19; //The CAS pin
+      pinTrigger2 = 18; //The Cam Sensor pin
+      pinTrigger3 = 3; //The Cam sensor 2 pin
+      pinTPS = A2;//TPS input pin
+      pinMAP = A3; //MAP sensor pin
+      pinIAT = A0; //IAT sensor pin
+      pinCLT = A1; //CLS sensor pin
+      pinO2 = A8; //O2 Sensor pin
+      pinBat = A4; //Battery reference voltage pin
+      pinDisplayReset = 48; // OLED reset pin
+      pinTachOut = 49; //Tacho output pin
+      pinIdle1 = 5; //Single wire idle control
+      pinIdle2 = 53; //2 wire idle control
+      pinBoost = 7; //Boost control
+      pinVVT_1 = 6; //Default VVT output
+      pinVVT_2 = 48; //Default VVT2 output
+      pinFuelPump = 4; //Fuel pump output
+      pinStepperDir = 16; //Direction pin  for DRV8825 driver
+      pinStepperStep = 17; //Step pin for DRV8825 driver
+      pinStepperEnable = 26; //Enable pin for DRV8825
+      pinFan = A13; //Pin for the fan output
+      pinLaunch = 51; //Can be overwritten below
+      pinFlex = 2; // Flex sensor (Must be external interrupt enabled)
+      pinResetControl = 50; //Reset control output
+      pinBaro = A5;
+      pinVSS = 20;
+
+      #if defined(CORE_TEENSY35)
+        pinTrigger = 23;
+        pinStepperDir = 33;
+        pinStepperStep = 34;
+        pinCoil1 = 31;
+        pinTachOut = 28;
+        pinFan = 27;
+        pinCoil4 = 21;
+        pinCoil3 = 30;
+        pinO2 = A22;
+      #endif
+    #endif
+      break;
+
+    case 3:
+      //Pin mappings as per the v0.4 shield
+      pinInjector1 = 8; //Output pin injector 1 is on
+      pinInjector2 = 9; //Output pin injector 2 is on
+      pinInjector3 = 10; //Output pin injector 3 is on
+      pinInjector4 = 11; //Output pin injector 4 is on
+      pinInjector5 = 12; //Output pin injector 5 is on
+      pinInjector6 = 50; //CAUTION: Uses the same as Coil 4 below. 
+      pinCoil1 = 40; //Pin for coil 1
+      pinCoil2 = 38; //Pin for coil 2
+      pinCoil3 = 52; //Pin for coil 3
+      pinCoil4 = 50; //Pin for coil 4
+      pinCoil5 = 34; //Pin for coil 5 PLACEHOLDER value for now
+      pinTrigger = 19; //The CAS pin
+      pinTrigger2 = 18; //The Cam Sensor pin
+      pinTrigger3 = 3; //The Cam sensor 2 pin
+      pinTPS = A2;//TPS input pin
+      pinMAP = A3; //MAP sensor pin
+      pinIAT = A0; //IAT sensor pin
+      pinCLT = A1; //CLS sensor pin
+      pinO2 = A8; //O2 Sensor pin
+      pinBat = A4; //Battery reference voltage pin
+      pinDisplayReset = 48; // OLED reset pin
+      pinTachOut = 49; //Tacho output pin  (Goes to ULN2803)
+      pinIdle1 = 5; //Single wire idle control
+      pinIdle2 = 6; //2 wire idle control
+      pinBoost = 7; //Boost control
+      pinVVT_1 = 4; //Default VVT output
+      pinVVT_2 = 48; //Default VVT2 output
+      pinFuelPump = 45; //Fuel pump output  (Goes to ULN2803)
+      pinStepperDir = 16; //Direction pin  for DRV8825 driver
+      pinStepperStep = 17; //Step pin for DRV8825 driver
+      pinStepperEnable = 24; //Enable pin for DRV8825
+      pinFan = 47; //Pin for the fan output (Goes to ULN2803)
+      pinLaunch = 51; //Can be overwritten below
+      pinFlex = 2; // Flex sensor (Must be external interrupt enabled)
+      pinResetControl = 43; //Reset control output
+      pinBaro = A5;
+      pinVSS = 20;
+      pinWMIEmpty = 46;
+      pinWMIIndicator = 44;
+      pinWMIEnabled = 42;
+
+      #if defined(CORE_TEENSY35)
+        pinInjector6 = 51;
+
+        pinTrigger = 23;
+        pinTrigger2 = 36;
+        pinStepperDir = 34;
+        pinStepperStep = 35;
+        pinCoil1 = 31;
+        pinCoil2 = 32;
+        pinTachOut = 28;
+        pinFan = 27;
+        pinCoil4 = 29;
+        pinCoil3 = 30;
+        pinO2 = A22;
+
+        //Make sure the CAN pins aren't overwritten
+        pinTrigger3 = 54;
+        pinVVT_1 = 55;
+
+      #elif defined(CORE_TEENSY41)
+        //These are only to prevent lockups or weird behaviour on T4.1 when this board is used as the default
+        pinBaro = A4; 
+        pinMAP = A5;
+        pinTPS = A3; //TPS input pin
+        pinIAT = A0; //IAT sensor pin
+        pinCLT = A1; //CLS sensor pin
+        pinO2 = A2; //O2 Sensor pin
+        pinBat = A15; //Battery reference voltage pin. Needs Alpha4+
+        pinLaunch = 34; //Can be overwritten below
+        pinVSS = 35;
+        pinSpareTemp2 = A16; //WRONG! Needs updating!!
+        pinSpareTemp2 = A17; //WRONG! Needs updating!!
+
+        pinTrigger = 20; //The CAS pin
+        pinTrigger2 = 21; //The Cam Sensor pin
+        pinTrigger3 = 24;
+
+        pinStepperDir = 34;
+        pinStepperStep = 35;
+        
+        pinCoil1 = 31;
+        pinCoil2 = 32;
+        pinCoil4 = 29;
+        pinCoil3 = 30;
+
+        pinTachOut = 28;
+        pinFan = 27;
+        pinFuelPump = 33;
+        pinWMIEmpty = 34;
+        pinWMIIndicator = 35;
+        pinWMIEnabled = 36;
+      #elif defined(STM32F407xx)
+     //Pin definitions for experimental board Tjeerd 
+        //Black F407VE wiki.stm32duino.com/index.php?title=STM32F407
+
+        //******************************************
+        //******** PORTA CONNECTIONS *************** 
+        //******************************************
+        /* = PA0 */ //Wakeup ADC123
+        // = PA1;
+        // = PA2;
+        // = PA3;
+        // = PA4;
+        /* = PA5; */ //ADC12
+        /* = PA6; */ //ADC12 LED_BUILTIN_1
+        pinFuelPump = PA7; //ADC12 LED_BUILTIN_2
+        pinCoil3 = PA8;
+        /* = PA9 */ //TXD1
+        /* = PA10 */ //RXD1
+        /* = PA11 */ //(DO NOT USE FOR SPEEDUINO) USB
+        /* = PA12 */ //(DO NOT USE FOR SPEEDUINO) USB 
+        /* = PA13 */ //(DO NOT USE FOR SPEEDUINO) NOT ON GPIO - DEBUG ST-LINK
+        /* = PA14 */ //(DO NOT USE FOR SPEEDUINO) NOT ON GPIO - DEBUG ST-LINK
+        /* = PA15 */ //(DO NOT USE FOR SPEEDUINO) NOT ON GPIO - DEBUG ST-LINK
+
+        //******************************************
+        //******** PORTB CONNECTIONS *************** 
+        //******************************************
+        /* = PB0; */ //(DO NOT USE FOR SPEEDUINO) ADC123 - SPI FLASH CHIP CS pin
+        pinBaro = PB1; //ADC12
+        /* = PB2; */ //(DO NOT USE FOR SPEEDUINO) BOOT1 
+        /* = PB3; */ //(DO NOT USE FOR SPEEDUINO) SPI1_SCK FLASH CHIP
+        /* = PB4; */ //(DO NOT USE FOR SPEEDUINO) SPI1_MISO FLASH CHIP
+        /* = PB5; */ //(DO NOT USE FOR SPEEDUINO) SPI1_MOSI FLASH CHIP
+        /* = PB6; */ //NRF_CE
+        /* = PB7; */ //NRF_CS
+        /* = PB8; */ //NRF_IRQ
+        pinCoil2 = PB9; //
+        /* = PB9; */ //
+        pinCoil4 = PB10; //TXD3
+        pinIdle1 = PB11; //RXD3
+        pinIdle2 = PB12; //
+        pinBoost = PB12; //
+        /* = PB13; */ //SPI2_SCK
+        /* = PB14; */ //SPI2_MISO
+        /* = PB15; */ //SPI2_MOSI
+
+        //******************************************
+        //******** PORTC CONNECTIONS *************** 
+        //******************************************
+        pinMAP = PC0; //ADC123 
+        pinTPS = PC1; //ADC123
+        pinIAT = PC2; //ADC123
+        pinCLT = PC3; //ADC123
+        pinO2 = PC4;  //ADC12
+        pinBat = PC5; //ADC12
+        pinVVT_1 = PC6; //
+        pinDisplayReset = PC7; //
+        /* = PC8; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_D0
+        /* = PC9; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_D1
+        /* = PC10; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_D2
+        /* = PC11; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_D3
+        /* = PC12; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_SCK
+        pinTachOut = PC13; //
+        /* = PC14; */ //(DO NOT USE FOR SPEEDUINO) - OSC32_IN
+        /* = PC15; */ //(DO NOT USE FOR SPEEDUINO) - OSC32_OUT
+
+        //******************************************
+        //******** PORTD CONNECTIONS *************** 
+        //******************************************
+        /* = PD0; */ //CANRX
+        /* = PD1; */ //CANTX
+        /* = PD2; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_CMD
+        pinVVT_2 = PD3; //
+        pinFlex = PD4;
+        /* = PD5;*/ //TXD2
+        /* = PD6; */ //RXD2
+        pinCoil1 = PD7; //
+        /* = PD8; */ //
+        pinCoil5 = PD9;//
+        /* = PD10; */ //
+        /* = PD11; */ //
+        pinInjector1 = PD12; //
+        pinInjector2 = PD13; //
+        pinInjector3 = PD14; //
+        pinInjector4 = PD15; //
+
+        //******************************************
+        //******** PORTE CONNECTIONS *************** 
+        //******************************************
+        pinTrigger = PE0; //
+        pinTrigger2 = PE1; //
+        pinStepperEnable = PE2; //
+        /* = PE3; */ //ONBOARD KEY1
+        /* = PE4; */ //ONBOARD KEY2
+        pinStepperStep = PE5; //
+        pinFan = PE6; //
+        pinStepperDir = PE7; //
+        /* = PE8; */ //
+        /* = PE9; */ //
+        /* = PE10; */ //
+        pinInjector5 = PE11; //
+        pinInjector6 = PE12; //
+        /* = PE13; */ //
+        /* = PE14; */ //
+        /* = PE15; */ //
+
+      #elif defined(CORE_STM32)
+        //https://github.com/stm32duino/Arduino_Core_STM32/blob/master/variants/Generic_F411Cx/variant.h#L28
+        //pins PA12, PA11 are used for USB or CAN couldn't be used for GPIO
+        //pins PB12, PB13, PB14 and PB15 are used to SPI FLASH
+        //PB2 can't be used as input because it's the BOOT pin
+        pinInjector1 = PB7; //Output pin injector 1 is on
+        pinInjector2 = PB6; //Output pin injector 2 is on
+        pinInjector3 = PB5; //Output pin injector 3 is on
+        pinInjector4 = PB4; //Output pin injector 4 is on
+        pinCoil1 = PB9; //Pin for coil 1
+        pinCoil2 = PB8; //Pin for coil 2
+        pinCoil3 = PB3; //Pin for coil 3
+        pinCoil4 = PA15; //Pin for coil 4
+        pinTPS = A2;//TPS input pin
+        pinMAP = A3; //MAP sensor pin
+        pinIAT = A0; //IAT sensor pin
+        pinCLT = A1; //CLS sensor pin
+        pinO2 = A8; //O2 Sensor pin
+        pinBat = A4; //Battery reference voltage pin
+        pinBaro = pinMAP;
+        pinTachOut = PB1; //Tacho output pin  (Goes to ULN2803)
+        pinIdle1 = PB2; //Single wire idle control
+        pinIdle2 = PB10; //2 wire idle control
+        pinBoost = PA6; //Boost control
+        pinStepperDir = PB10; //Direction pin  for DRV8825 driver
+        pinStepperStep = PB2; //Step pin for DRV8825 driver
+        pinFuelPump = PA8; //Fuel pump output
+        pinFan = PA5; //Pin for the fan output (Goes to ULN2803)
+        //external interrupt enabled pins
+        pinFlex = PC14; // Flex sensor (Must be external interrupt enabled)
+        pinTrigger = PC13; //The CAS pin also led pin so bad idea
+        pinTrigger2 = PC15; //The Cam Sensor pin
+      #endif
+      break;
+
+    case 6:
+      #ifndef SMALL_FLASH_MODE
+      //Pin mappings as per the 2001-05 MX5 PNP shield
+      pinInjector1 = 44; //Output pin injector 1 is on
+      pinInjector2 = 46; //Output pin injector 2 is on
+      pinInjector3 = 47; //Output pin injector 3 is on
+      pinInjector4 = 45; //Output pin injector 4 is on
+      pinInjector5 = 14; //Output pin injector 5 is on
+      pinCoil1 = 42; //Pin for coil 1
+      pinCoil2 = 43; //Pin for coil 2
+      pinCoil3 = 32; //Pin for coil 3
+      pinCoil4 = 33; //Pin for coil 4
+      pinCoil5 = 34; //Pin for coil 5 PLACEHOLDER value for now
+      pinTrigger = 19; //The CAS pin
+      pinTrigger2 = 18; //The Cam Sensor pin
+      pinTrigger3 = 2; //The Cam sensor 2 pin
+      pinTPS = A2;//TPS input pin
+      pinMAP = A5; //MAP sensor pin
+      pinIAT = A0; //IAT sensor pin
+      pinCLT = A1; //CLS sensor pin
+      pinO2 = A3; //O2 Sensor pin
+      pinBat = A4; //Battery reference voltage pin
+      pinDisplayReset = 48; // OLED reset pin
+      pinTachOut = 23; //Tacho output pin  (Goes to ULN2803)
+      pinIdle1 = 5; //Single wire idle control
+      pinBoost = 4;
+      pinVVT_1 = 11; //Default VVT output
+      pinVVT_2 = 48; //Default VVT2 output
+      pinIdle2 = 4; //2 wire idle control (Note this is shared with boost!!!)
+      pinFuelPump = 40; //Fuel pump output
+      pinStepperDir = 16; //Direction pin  for DRV8825 driver
+      pinStepperStep = 17; //Step pin for DRV8825 driver
+      pinStepperEnable = 24;
+      pinFan = 41; //Pin for the fan output
+      pinLaunch = 12; //Can be overwritten below
+      pinFlex = 3; // Flex sensor (Must be external interrupt enabled)
+      pinResetControl = 39; //Reset control output
+      #endif
+      //This is NOT correct. It has not yet been tested with this board
+      #if defined(CORE_TEENSY35)
+        pinTrigger = 23;
+        pinTrigger2 = 36;
+        pinStepperDir = 34;
+        pinStepperStep = 35;
+        pinCoil1 = 33; //Done
+        pinCoil2 = 24; //Done
+        pinCoil3 = 51; //Won't work (No mapping for pin 32)
+        pinCoil4 = 52; //Won't work (No mapping for pin 33)
+        pinFuelPump = 26; //Requires PVT4 adapter or above
+        pinFan = 50; //Won't work (No mapping for pin 35)
+        pinTachOut = 28; //Done
+      #endif
+      break;
+
+    case 8:
+      #ifndef SMALL_FLASH_MODE
+      //Pin mappings as per the 1996-97 MX5 PNP shield
+      pinInjector1 = 11; //Output pin injector 1 is on
+      pinInjector2 = 10; //Output pin injector 2 is on
+      pinInjector3 = 9; //Output pin injector 3 is on
+      pinInjector4 = 8; //Output pin injector 4 is on
+      pinInjector5 = 14; //Output pin injector 5 is on
+      pinCoil1 = 39; //Pin for coil 1
+      pinCoil2 = 41; //Pin for coil 2
+      pinCoil3 = 32; //Pin for coil 3
+      pinCoil4 = 33; //Pin for coil 4
+      pinCoil5 = 34; //Pin for coil 5 PLACEHOLDER value for now
+      pinTrigger = 19; //The CAS pin
+      pinTrigger2 = 18; //The Cam Sensor pin
+      pinTPS = A2;//TPS input pin
+      pinMAP = A5; //MAP sensor pin
+      pinIAT = A0; //IAT sensor pin
+      pinCLT = A1; //CLS sensor pin
+      pinO2 = A3; //O2 Sensor pin
+      pinBat = A4; //Battery reference voltage pin
+      pinDisplayReset = 48; // OLED reset pin
+      pinTachOut = A9; //Tacho output pin  (Goes to ULN2803)
+      pinIdle1 = 2; //Single wire idle control
+      pinBoost = 4;
+      pinIdle2 = 4; //2 wire idle control (Note this is shared with boost!!!)
+      pinFuelPump = 49; //Fuel pump output
+      pinStepperDir = 16; //Direction pin  for DRV8825 driver
+      pinStepperStep = 17; //Step pin for DRV8825 driver
+      pinStepperEnable = 24;
+      pinFan = 35; //Pin for the fan output
+      pinLaunch = 37; //Can be overwritten below
+      pinFlex = 3; // Flex sensor (Must be external interrupt enabled)
+      pinResetControl = 44; //Reset control output
+
+      //This is NOT correct. It has not yet been tested with this board
+      #if defined(CORE_TEENSY35)
+        pinTrigger = 23;
+        pinTrigger2 = 36;
+        pinStepperDir = 34;
+        pinStepperStep = 35;
+        pinCoil1 = 33; //Done
+        pinCoil2 = 24; //Done
+        pinCoil3 = 51; //Won't work (No mapping for pin 32)
+        pinCoil4 = 52; //Won't work (No mapping for pin 33)
+        pinFuelPump = 26; //Requires PVT4 adapter or above
+        pinFan = 50; //Won't work (No mapping for pin 35)
+        pinTachOut = 28; //Done
+      #endif
+      #endif
+      break;
+
+    case 9:
+     #ifndef SMALL_FLASH_MODE
+      //Pin mappings as per the 89-95 MX5 PNP shield
+      pinInjector1 = 11; //Output pin injector 1 is on
+      pinInjector2 = 10; //Output pin injector 2 is on
+      pinInjector3 = 9; //Output pin injector 3 is on
+      pinInjector4 = 8; //Output pin injector 4 is on
+      pinInjector5 = 14; //Output pin injector 5 is on
+      pinCoil1 = 39; //Pin for coil 1
+      pinCoil2 = 41; //Pin for coil 2
+      pinCoil3 = 32; //Pin for coil 3
+      pinCoil4 = 33; //Pin for coil 4
+      pinCoil5 = 34; //Pin for coil 5 PLACEHOLDER value for now
+      pinTrigger = 19; //The CAS pin
+      pinTrigger2 = 18; //The Cam Sensor pin
+      pinTPS = A2;//TPS input pin
+      pinMAP = A5; //MAP sensor pin
+      pinIAT = A0; //IAT sensor pin
+      pinCLT = A1; //CLS sensor pin
+      pinO2 = A3; //O2 Sensor pin
+      pinBat = A4; //Battery reference voltage pin
+      pinDisplayReset = 48; // OLED reset pin
+      pinTachOut = 49; //Tacho output pin  (Goes to ULN2803)
+      pinIdle1 = 2; //Single wire idle control
+      pinBoost = 4;
+      pinIdle2 = 4; //2 wire idle control (Note this is shared with boost!!!)
+      pinFuelPump = 37; //Fuel pump output
+      //Note that there is no stepper driver output on the PNP boards. These pins are unconnected and remain here just to prevent issues with random pin numbers occurring
+      pinStepperEnable = 15; //Enable pin for the DRV8825
+      pinStepperDir = 16; //Direction pin  for DRV8825 driver
+      pinStepperStep = 17; //Step pin for DRV8825 driver
+      pinFan = 35; //Pin for the fan output
+      pinLaunch = 12; //Can be overwritten below
+      pinFlex = 3; // Flex sensor (Must be external interrupt enabled)
+      pinResetControl = 44; //Reset control output
+      pinVSS = 20;
+      pinIdleUp = 48;
+      pinCTPS = 47;
+      #endif
+      #if defined(CORE_TEENSY35)
+        pinTrigger = 23;
+        pinTrigger2 = 36;
+        pinStepperDir = 34;
+        pinStepperStep = 35;
+        pinCoil1 = 33; //Done
+        pinCoil2 = 24; //Done
+        pinCoil3 = 51; //Won't work (No mapping for pin 32)
+        pinCoil4 = 52; //Won't work (No mapping for pin 33)
+        pinFuelPump = 26; //Requires PVT4 adapter or above
+        pinFan = 50; //Won't work (No mapping for pin 35)
+        pinTachOut = 28; //Done
+      #endif
+      break;
+
+    case 10:
+    #ifndef SMALL_FLASH_MODE //No support for bluepill here anyway
+      //Pin mappings for user turtanas PCB
+      pinInjector1 = 4; //Output pin injector 1 is on
+      pinInjector2 = 5; //Output pin injector 2 is on
+      pinInjector3 = 6; //Output pin injector 3 is on
+      pinInjector4 = 7; //Output pin injector 4 is on
+      pinInjector5 = 8; //Placeholder only - NOT USED
+      pinInjector6 = 9; //Placeholder only - NOT USED
+      pinInjector7 = 10; //Placeholder only - NOT USED
+      pinInjector8 = 11; //Placeholder only - NOT USED
+      pinCoil1 = 24; //Pin for coil 1
+      pinCoil2 = 28; //Pin for coil 2
+      pinCoil3 = 36; //Pin for coil 3
+      pinCoil4 = 40; //Pin for coil 4
+      pinCoil5 = 34; //Pin for coil 5 PLACEHOLDER value for now
+      pinTrigger = 18; //The CAS pin
+      pinTrigger2 = 19; //The Cam Sensor pin
+      pinTPS = A2;//TPS input pin
+      pinMAP = A3; //MAP sensor pin
+      pinMAP2 = A8; //MAP2 sensor pin
+      pinIAT = A0; //IAT sensor pin
+      pinCLT = A1; //CLS sensor pin
+      pinO2 = A4; //O2 Sensor pin
+      pinBat = A7; //Battery reference voltage pin
+      pinDisplayReset = 48; // OLED reset pin
+      pinSpareTemp1 = A6;
+      pinSpareTemp2 = A5;
+      pinTachOut = 41; //Tacho output pin transistor is missing 2n2222 for this and 1k for 12v
+      pinFuelPump = 42; //Fuel pump output 2n2222
+      pinFan = 47; //Pin for the fan output
+      pinTachOut = 49; //Tacho output pin
+      pinFlex = 2; // Flex sensor (Must be external interrupt enabled)
+      pinResetControl = 26; //Reset control output
+
+    #endif
+      break;
+
+    case 20:
+    #if defined(CORE_AVR) && !defined(SMALL_FLASH_MODE) //No support for bluepill here anyway
+      //Pin mappings as per the Plazomat In/Out shields Rev 0.1
+      pinInjector1 = 8; //Output pin injector 1 is on
+      pinInjector2 = 9; //Output pin injector 2 is on
+      pinInjector3 = 10; //Output pin injector 3 is on
+      pinInjector4 = 11; //Output pin injector 4 is on
+      pinInjector5 = 12; //Output pin injector 5 is on
+      pinCoil1 = 28; //Pin for coil 1
+      pinCoil2 = 24; //Pin for coil 2
+      pinCoil3 = 40; //Pin for coil 3
+      pinCoil4 = 36; //Pin for coil 4
+      pinCoil5 = 34; //Pin for coil 5 PLACEHOLDER value for now
+      pinSpareOut1 = 4; //Spare LSD Output 1(PWM)
+      pinSpareOut2 = 5; //Spare LSD Output 2(PWM)
+      pinSpareOut3 = 6; //Spare LSD Output 3(PWM)
+      pinSpareOut4 = 7; //Spare LSD Output 4(PWM)
+      pinSpareOut5 = 50; //Spare LSD Output 5(digital)
+      pinSpareOut6 = 52; //Spare LSD Output 6(digital)
+      pinTrigger = 20; //The CAS pin
+      pinTrigger2 = 21; //The Cam Sensor pin
+      pinSpareTemp2 = A15; //spare Analog input 2
+      pinSpareTemp1 = A14; //spare Analog input 1
+      pinO2 = A8; //O2 Sensor pin
+      pinBat = A4; //Battery reference voltage pin
+      pinMAP = A3; //MAP sensor pin
+      pinTPS = A2;//TPS input pin
+      pinCLT = A1; //CLS sensor pin
+      pinIAT = A0; //IAT sensor pin
+      pinFan = 47; //Pin for the fan output
+      pinFuelPump = 4; //Fuel pump output
+      pinTachOut = 49; //Tacho output pin
+      pinResetControl = 26; //Reset control output
+    #endif
+      break;
+
+    case 30:
+    #ifndef SMALL_FLASH_MODE //No support for bluepill here anyway
+      //Pin mappings as per the dazv6 shield
+      pinInjector1 = 8; //Output pin injector 1 is on
+      pinInjector2 = 9; //Output pin injector 2 is on
+      pinInjector3 = 10; //Output pin injector 3 is on
+      pinInjector4 = 11; //Output pin injector 4 is on
+      pinInjector5 = 12; //Output pin injector 5 is on
+      pinCoil1 = 40; //Pin for coil 1
+      pinCoil2 = 38; //Pin for coil 2
+      pinCoil3 = 50; //Pin for coil 3
+      pinCoil4 = 52; //Pin for coil 4
+      pinCoil5 = 34; //Pin for coil 5 PLACEHOLDER value for now
+      pinTrigger = 19; //The CAS pin
+      pinTrigger2 = 18; //The Cam Sensor pin
+      pinTrigger3 = 17; // cam sensor 2 pin, pin17 isn't external trigger enabled in arduino mega??
+      pinTPS = A2;//TPS input pin
+      pinMAP = A3; //MAP sensor pin
+      pinIAT = A0; //IAT sensor pin
+      pinCLT = A1; //CLS sensor pin
+      pinO2 = A8; //O2 Sensor pin
+      pinO2_2 = A9; //O2 sensor pin (second sensor)
+      pinBat = A4; //Battery reference voltage pin
+      pinDisplayReset = 48; // OLED reset pin
+      pinTachOut = 49; //Tacho output pin
+      pinIdle1 = 5; //Single wire idle control
+      pinFuelPump = 45; //Fuel pump output
+      pinStepperDir = 20; //Direction pin  for DRV8825 driver
+      pinStepperStep = 21; //Step pin for DRV8825 driver
+      pinSpareHOut1 = 4; // high current output spare1
+      pinSpareHOut2 = 6; // high current output spare2
+      pinBoost = 7;
+      pinSpareLOut1 = 43; //low current output spare1
+      pinSpareLOut2 = 47;
+      pinSpareLOut3 = 49;
+      pinSpareLOut4 = 51;
+      pinSpareLOut5 = 53;
+      pinFan = 47; //Pin for the fan output
+    #endif
+      break;
+
+   case 31:
+      //Pin mappings for the BMW PnP PCBs by pazi88.
+      #if defined(CORE_AVR)
+      //This is the regular MEGA2560 pin mapping
+      pinInjector1 = 8; //Output pin injector 1
+      pinInjector2 = 9; //Output pin injector 2
+      pinInjector3 = 10; //Output pin injector 3
+      pinInjector4 = 11; //Output pin injector 4
+      pinInjector5 = 12; //Output pin injector 5
+      pinInjector6 = 50; //Output pin injector 6
+      pinInjector7 = 39; //Output pin injector 7 (placeholder)
+      pinInjector8 = 42; //Output pin injector 8 (placeholder)
+      pinCoil1 = 40; //Pin for coil 1
+      pinCoil2 = 38; //Pin for coil 2
+      pinCoil3 = 52; //Pin for coil 3
+      pinCoil4 = 48; //Pin for coil 4
+      pinCoil5 = 36; //Pin for coil 5
+      pinCoil6 = 34; //Pin for coil 6
+      pinCoil7 = 46; //Pin for coil 7 (placeholder)
+      pinCoil8 = 53; //Pin for coil 8 (placeholder)
+      pinTrigger = 19; //The CAS pin
+      pinTrigger2 = 18; //The Cam Sensor pin
+      pinTrigger3 = 20; //The Cam sensor 2 pin
+      pinTPS = A2;//TPS input pin
+      pinMAP = A3; //MAP sensor pin
+      pinEMAP = A15; //EMAP sensor pin
+      pinIAT = A0; //IAT sensor pin
+      pinCLT = A1; //CLT sensor pin
+      pinO2 = A8; //O2 Sensor pin
+      pinBat = A4; //Battery reference voltage pin
+      pinBaro = A5; //Baro sensor pin
+      pinDisplayReset = 41; // OLED reset pin
+      pinTachOut = 49; //Tacho output pin  (Goes to ULN2003)
+      pinIdle1 = 5; //ICV pin1
+      pinIdle2 = 6; //ICV pin3
+      pinBoost = 7; //Boost control
+      pinVVT_1 = 4; //VVT1 output (intake vanos)
+      pinVVT_2 = 26; //VVT2 output (exhaust vanos)
+      pinFuelPump = 45; //Fuel pump output  (Goes to ULN2003)
+      pinStepperDir = 16; //Stepper valve isn't used with these
+      pinStepperStep = 17; //Stepper valve isn't used with these
+      pinStepperEnable = 24; //Stepper valve isn't used with these
+      pinFan = 47; //Pin for the fan output (Goes to ULN2003)
+      pinLaunch = 51; //Launch control pin
+      pinFlex = 2; // Flex sensor
+      pinResetControl = 43; //Reset control output
+      pinVSS = 3; //VSS input pin
+      pinWMIEmpty = 31; //(placeholder)
+      pinWMIIndicator = 33; //(placeholder)
+      pinWMIEnabled = 35; //(placeholder)
+      pinIdleUp = 37; //(placeholder)
+      pinCTPS = A6; //(placeholder)
+     #elif defined(STM32F407xx)
+      pinInjector1 = PB15; //Output pin injector 1
+      pinInjector2 = PB14; //Output pin injector 2
+      pinInjector3 = PB12; //Output pin injector 3
+      pinInjector4 = PB13; //Output pin injector 4
+      pinInjector5 = PA8; //Output pin injector 5
+      pinInjector6 = PE7; //Output pin injector 6
+      pinInjector7 = PE13; //Output pin injector 7 (placeholder)
+      pinInjector8 = PE10; //Output pin injector 8 (placeholder)
+      pinCoil1 = PE2; //Pin for coil 1
+      pinCoil2 = PE3; //Pin for coil 2
+      pinCoil3 = PC13; //Pin for coil 3
+      pinCoil4 = PE6; //Pin for coil 4
+      pinCoil5 = PE4; //Pin for coil 5
+      pinCoil6 = PE5; //Pin for coil 6
+      pinCoil7 = PE0; //Pin for coil 7 (placeholder)
+      pinCoil8 = PB9; //Pin for coil 8 (placeholder)
+      pinTrigger = PD3; //The CAS pin
+      pinTrigger2 = PD4; //The Cam Sensor pin
+      pinTPS = PA2;//TPS input pin
+      pinMAP = PA3; //MAP sensor pin
+      pinEMAP = PC5; //EMAP sensor pin
+      pinIAT = PA0; //IAT sensor pin
+      pinCLT = PA1; //CLS sensor pin
+      pinO2 = PB0; //O2 Sensor pin
+      pinBat = PA4; //Battery reference voltage pin
+      pinBaro = PA5; //Baro sensor pin
+      pinDisplayReset = PE12; // OLED reset pin
+      pinTachOut = PE8; //Tacho output pin  (Goes to ULN2003)
+      pinIdle1 = PD10; //ICV pin1
+      pinIdle2 = PD9; //ICV pin3
+      pinBoost = PD8; //Boost control
+      pinVVT_1 = PD11; //VVT1 output (intake vanos)
+      pinVVT_2 = PC7; //VVT2 output (exhaust vanos)
+      pinFuelPump = PE11; //Fuel pump output  (Goes to ULN2003)
+      pinStepperDir = PB10; //Stepper valve isn't used with these
+      pinStepperStep = PB11; //Stepper valve isn't used with these
+      pinStepperEnable = PA15; //Stepper valve isn't used with these
+      pinFan = PE9; //Pin for the fan output (Goes to ULN2003)
+      pinLaunch = PB8; //Launch control pin
+      pinFlex = PD7; // Flex sensor
+      pinResetControl = PB7; //Reset control output
+      pinVSS = PB6; //VSS input pin
+      pinWMIEmpty = PD15; //(placeholder)
+      pinWMIIndicator = PD13; //(placeholder)
+      pinWMIEnabled = PE15; //(placeholder)
+      pinIdleUp = PE14; //(placeholder)
+      pinCTPS = PA6; //(placeholder)
+     #endif
+      break;
+
+    case 40:
+     #ifndef SMALL_FLASH_MODE
+      //Pin mappings as per the NO2C shield
+      pinInjector1 = 8; //Output pin injector 1 is on
+      pinInjector2 = 9; //Output pin injector 2 is on
+      pinInjector3 = 11; //Output pin injector 3 is on - NOT USED
+      pinInjector4 = 12; //Output pin injector 4 is on - NOT USED
+      pinInjector5 = 13; //Placeholder only - NOT USED
+      pinCoil1 = 23; //Pin for coil 1
+      pinCoil2 = 22; //Pin for coil 2
+      pinCoil3 = 2; //Pin for coil 3 - ONLY WITH DB2
+      pinCoil4 = 3; //Pin for coil 4 - ONLY WITH DB2
+      pinCoil5 = 46; //Placeholder only - NOT USED
+      pinTrigger = 19; //The CAS pin
+      pinTrigger2 = 18; //The Cam Sensor pin
+      pinTrigger3 = 21; //The Cam sensor 2 pin
+      pinTPS = A3; //TPS input pin
+      pinMAP = A0; //MAP sensor pin
+      pinIAT = A5; //IAT sensor pin
+      pinCLT = A4; //CLT sensor pin
+      pinO2 = A2; //O2 sensor pin
+      pinBat = A1; //Battery reference voltage pin
+      pinBaro = A6; //Baro sensor pin - ONLY WITH DB
+      pinSpareTemp1 = A7; //spare Analog input 1 - ONLY WITH DB
+      pinDisplayReset = 48; // OLED reset pin - NOT USED
+      pinTachOut = 38; //Tacho output pin
+      pinIdle1 = 5; //Single wire idle control
+      pinIdle2 = 47; //2 wire idle control - NOT USED
+      pinBoost = 7; //Boost control
+      pinVVT_1 = 6; //Default VVT output
+      pinVVT_2 = 48; //Default VVT2 output
+      pinFuelPump = 4; //Fuel pump output
+      pinStepperDir = 25; //Direction pin for DRV8825 driver
+      pinStepperStep = 24; //Step pin for DRV8825 driver
+      pinStepperEnable = 27; //Enable pin for DRV8825 driver
+      pinLaunch = 10; //Can be overwritten below
+      pinFlex = 20; // Flex sensor (Must be external interrupt enabled) - ONLY WITH DB
+      pinFan = 30; //Pin for the fan output - ONLY WITH DB
+      pinSpareLOut1 = 32; //low current output spare1 - ONLY WITH DB
+      pinSpareLOut2 = 34; //low current output spare2 - ONLY WITH DB
+      pinSpareLOut3 = 36; //low current output spare3 - ONLY WITH DB
+      pinResetControl = 26; //Reset control output
+      #endif
+      break;
+
+    case 41:
+    #ifndef SMALL_FLASH_MODE //No support for bluepill here anyway
+      //Pin mappings as per the UA4C shield
+      pinInjector1 = 8; //Output pin injector 1 is on
+      pinInjector2 = 7; //Output pin injector 2 is on
+      pinInjector3 = 6; //Output pin injector 3 is on
+      pinInjector4 = 5; //Output pin injector 4 is on
+      pinInjector5 = 45; //Output pin injector 5 is on PLACEHOLDER value for now
+      pinCoil1 = 35; //Pin for coil 1
+      pinCoil2 = 36; //Pin for coil 2
+      pinCoil3 = 33; //Pin for coil 3
+      pinCoil4 = 34; //Pin for coil 4
+      pinCoil5 = 44; //Pin for coil 5 PLACEHOLDER value for now
+      pinTrigger = 19; //The CAS pin
+      pinTrigger2 = 18; //The Cam Sensor pin
+      pinTrigger3 = 3; //The Cam sensor 2 pin
+      pinFlex = 20; // Flex sensor
+      pinTPS = A3; //TPS input pin
+      pinMAP = A0; //MAP sensor pin
+      pinBaro = A7; //Baro sensor pin
+      pinIAT = A5; //IAT sensor pin
+      pinCLT = A4; //CLS sensor pin
+      pinO2 = A1; //O2 Sensor pin
+      pinO2_2 = A9; //O2 sensor pin (second sensor)
+      pinBat = A2; //Battery reference voltage pin
+      pinSpareTemp1 = A8; //spare Analog input 1
+      pinLaunch = 37; //Can be overwritten below
+      pinDisplayReset = 48; // OLED reset pin PLACEHOLDER value for now
+      pinTachOut = 22; //Tacho output pin
+      pinIdle1 = 9; //Single wire idle control
+      pinIdle2 = 10; //2 wire idle control
+      pinFuelPump = 23; //Fuel pump output
+      pinVVT_1 = 11; //Default VVT output
+      pinVVT_2 = 48; //Default VVT2 output
+      pinStepperDir = 32; //Direction pin  for DRV8825 driver
+      pinStepperStep = 31; //Step pin for DRV8825 driver
+      pinStepperEnable = 30; //Enable pin for DRV8825 driver
+      pinBoost = 12; //Boost control
+      pinSpareLOut1 = 26; //low current output spare1
+      pinSpareLOut2 = 27; //low current output spare2
+      pinSpareLOut3 = 28; //low current output spare3
+      pinSpareLOut4 = 29; //low current output spare4
+      pinFan = 24; //Pin for the fan output
+      pinResetControl = 46; //Reset control output PLACEHOLDER value for now
+    #endif
+      break;
+
+    case 42:
+      //Pin mappings for all BlitzboxBL49sp variants
+      pinInjector1 = 6; //Output pin injector 1
+      pinInjector2 = 7; //Output pin injector 2
+      pinInjector3 = 8; //Output pin injector 3
+      pinInjector4 = 9; //Output pin injector 4
+      pinCoil1 = 24; //Pin for coil 1
+      pinCoil2 = 25; //Pin for coil 2
+      pinCoil3 = 23; //Pin for coil 3
+      pinCoil4 = 22; //Pin for coil 4
+      pinTrigger = 19; //The CRANK Sensor pin
+      pinTrigger2 = 18; //The Cam Sensor pin
+      pinFlex = 20; // Flex sensor PLACEHOLDER value for now
+      pinTPS = A0; //TPS input pin
+      pinSpareTemp1 = A1; //LMM sensor pin
+      pinO2 = A2; //O2 Sensor pin
+      pinIAT = A3; //IAT sensor pin
+      pinCLT = A4; //CLT sensor pin
+      pinMAP = A7; //internal MAP sensor
+      pinBat = A6; //Battery reference voltage pin
+      pinBaro = A5; //external MAP/Baro sensor pin
+      pinO2_2 = A9; //O2 sensor pin (second sensor) PLACEHOLDER value for now
+      pinLaunch = 2; //Can be overwritten below
+      pinTachOut = 10; //Tacho output pin
+      pinIdle1 = 11; //Single wire idle control
+      pinIdle2 = 14; //2 wire idle control PLACEHOLDER value for now
+      pinFuelPump = 3; //Fuel pump output
+      pinVVT_1 = 15; //Default VVT output PLACEHOLDER value for now
+      pinBoost = 5; //Boost control
+      pinSpareLOut1 = 49; //enable Wideband Lambda Heater
+      pinSpareLOut2 = 16; //low current output spare2 PLACEHOLDER value for now
+      pinSpareLOut3 = 17; //low current output spare3 PLACEHOLDER value for now
+      pinSpareLOut4 = 21; //low current output spare4 PLACEHOLDER value for now
+      pinFan = 12; //Pin for the fan output
+      pinResetControl = 46; //Reset control output PLACEHOLDER value for now
+    break;
+    
+    case 45:
+    #ifndef SMALL_FLASH_MODE //No support for bluepill here anyway
+      //Pin mappings for the DIY-EFI CORE4 Module. This is an AVR only module
+      #if defined(CORE_AVR)
+      pinInjector1 = 10; //Output pin injector 1 is on
+      pinInjector2 = 11; //Output pin injector 2 is on
+      pinInjector3 = 12; //Output pin injector 3 is on
+      pinInjector4 = 9; //Output pin injector 4 is on
+      pinCoil1 = 39; //Pin for coil 1
+      pinCoil2 = 29; //Pin for coil 2
+      pinCoil3 = 28; //Pin for coil 3
+      pinCoil4 = 27; //Pin for coil 4
+      pinCoil5 = 26; //Placeholder  for coil 5
+      pinTrigger = 19; //The CAS pin
+      pinTrigger2 = 18; //The Cam Sensor pin
+      pinTrigger3 = 21;// The Cam sensor 2 pin
+      pinFlex = 20; // Flex sensor
+      pinTPS = A3; //TPS input pin
+      pinMAP = A2; //MAP sensor pin
+      pinBaro = A15; //Baro sensor pin
+      pinIAT = A11; //IAT sensor pin
+      pinCLT = A4; //CLS sensor pin
+      pinO2 = A12; //O2 Sensor pin
+      pinO2_2 = A5; //O2 sensor pin (second sensor)
+      pinBat = A1; //Battery reference voltage pin
+      pinSpareTemp1 = A14; //spare Analog input 1
+      pinLaunch = 24; //Can be overwritten below
+      pinDisplayReset = 48; // OLED reset pin PLACEHOLDER value for now
+      pinTachOut = 38; //Tacho output pin
+      pinIdle1 = 42; //Single wire idle control
+      pinIdle2 = 43; //2 wire idle control
+      pinFuelPump = 41; //Fuel pump output
+      pinVVT_1 = 44; //Default VVT output
+      pinVVT_2 = 48; //Default VVT2 output
+      pinStepperDir = 32; //Direction pin  for DRV8825 driver
+      pinStepperStep = 31; //Step pin for DRV8825 driver
+      pinStepperEnable = 30; //Enable pin for DRV8825 driver
+      pinBoost = 45; //Boost control
+      pinSpareLOut1 = 37; //low current output spare1
+      pinSpareLOut2 = 36; //low current output spare2
+      pinSpareLOut3 = 35; //low current output spare3
+      pinInjector5 = 33; //Output pin injector 5 is on
+      pinInjector6 = 34; //Output pin injector 6 is on
+      pinFan = 40; //Pin for the fan output
+      pinResetControl = 46; //Reset control output PLACEHOLDER value for now
+      #endif
+    #endif
+      break;
+
+    #if defined(CORE_TEENSY35)
+    case 50:
+      //Pin mappings as per the teensy rev A shield
+      pinInjector1 = 2; //Output pin injector 1 is on
+      pinInjector2 = 10; //Output pin injector 2 is on
+      pinInjector3 = 6; //Output pin injector 3 is on
+      pinInjector4 = 9; //Output pin injector 4 is on
+      //Placeholder only - NOT USED:
+      //pinInjector5 = 13;
+      pinCoil1 = 29; //Pin for coil 1
+      pinCoil2 = 30; //Pin for coil 2
+      pinCoil3 = 31; //Pin for coil 3 - ONLY WITH DB2
+      pinCoil4 = 32; //Pin for coil 4 - ONLY WITH DB2
+      //Placeholder only - NOT USED:
+      //pinCoil5 = 46; 
+      pinTrigger = 23; //The CAS pin
+      pinTrigger2 = 36; //The Cam Sensor pin
+      pinTPS = 16; //TPS input pin
+      pinMAP = 17; //MAP sensor pin
+      pinIAT = 14; //IAT sensor pin
+      pinCLT = 15; //CLT sensor pin
+      pinO2 = A22; //O2 sensor pin
+      pinO2_2 = A21; //O2 sensor pin (second sensor)
+      pinBat = 18; //Battery reference voltage pin
+      pinTachOut = 20; //Tacho output pin
+      pinIdle1 = 5; //Single wire idle control
+      pinBoost = 11; //Boost control
+      pinFuelPump = 38; //Fuel pump output
+      pinStepperDir = 34; //Direction pin for DRV8825 driver
+      pinStepperStep = 35; //Step pin for DRV8825 driver
+      pinStepperEnable = 33; //Enable pin for DRV8825 driver
+      pinLaunch = 26; //Can be overwritten below
+      pinFan = 37; //Pin for the fan output - ONLY WITH DB
+      pinSpareHOut1 = 8; // high current output spare1
+      pinSpareHOut2 = 7; // high current output spare2
+      pinSpareLOut1 = 21; //low current output spare1
+      break;
+
+    case 51:
+      //Pin mappings as per the teensy revB board shield
+      pinInjector1 = 2; //Output pin injector 1 is on
+      pinInjector2 = 10; //Output pin injector 2 is on
+      pinInjector3 = 6; //Output pin injector 3 is on - NOT USED
+      pinInjector4 = 9; //Output pin injector 4 is on - NOT USED
+      pinCoil1 = 29; //Pin for coil 1
+      pinCoil2 = 30; //Pin for coil 2
+      pinCoil3 = 31; //Pin for coil 3 - ONLY WITH DB2
+      pinCoil4 = 32; //Pin for coil 4 - ONLY WITH DB2
+      pinTrigger = 23; //The CAS pin
+      pinTrigger2 = 36; //The Cam Sensor pin
+      pinTPS = 16; //TPS input pin
+      pinMAP = 17; //MAP sensor pin
+      pinIAT = 14; //IAT sensor pin
+      pinCLT = 15; //CLT sensor pin
+      pinO2 = A22; //O2 sensor pin
+      pinO2_2 = A21; //O2 sensor pin (second sensor)
+      pinBat = 18; //Battery reference voltage pin
+      pinTachOut = 20; //Tacho output pin
+      pinIdle1 = 5; //Single wire idle control
+      pinBoost = 11; //Boost control
+      pinFuelPump = 38; //Fuel pump output
+      pinStepperDir = 34; //Direction pin for DRV8825 driver
+      pinStepperStep = 35; //Step pin for DRV8825 driver
+      pinStepperEnable = 33; //Enable pin for DRV8825 driver
+      pinLaunch = 26; //Can be overwritten below
+      pinFan = 37; //Pin for the fan output - ONLY WITH DB
+      pinSpareHOut1 = 8; // high current output spare1
+      pinSpareHOut2 = 7; // high current output spare2
+      pinSpareLOut1 = 21; //low current output spare1
+      break;
+    #endif
+
+    #if defined(CORE_TEENSY35)
+    case 53:
+      //Pin mappings for the Juice Box (ignition only board)
+      pinInjector1 = 2; //Output pin injector 1 is on - NOT USED
+      pinInjector2 = 56; //Output pin injector 2 is on - NOT USED
+      pinInjector3 = 6; //Output pin injector 3 is on - NOT USED
+      pinInjector4 = 50; //Output pin injector 4 is on - NOT USED
+      pinCoil1 = 29; //Pin for coil 1
+      pinCoil2 = 30; //Pin for coil 2
+      pinCoil3 = 31; //Pin for coil 3
+      pinCoil4 = 32; //Pin for coil 4
+      pinTrigger = 37; //The CAS pin
+      pinTrigger2 = 38; //The Cam Sensor pin - NOT USED
+      pinTPS = A2; //TPS input pin
+      pinMAP = A7; //MAP sensor pin
+      pinIAT = A1; //IAT sensor pin
+      pinCLT = A5; //CLT sensor pin
+      pinO2 = A0; //O2 sensor pin
+      pinO2_2 = A21; //O2 sensor pin (second sensor) - NOT USED
+      pinBat = A6; //Battery reference voltage pin
+      pinTachOut = 28; //Tacho output pin
+      pinIdle1 = 5; //Single wire idle control - NOT USED
+      pinBoost = 11; //Boost control - NOT USED
+      pinFuelPump = 24; //Fuel pump output
+      pinStepperDir = 3; //Direction pin for DRV8825 driver - NOT USED
+      pinStepperStep = 4; //Step pin for DRV8825 driver - NOT USED
+      pinStepperEnable = 6; //Enable pin for DRV8825 driver - NOT USED
+      pinLaunch = 26; //Can be overwritten below
+      pinFan = 25; //Pin for the fan output
+      pinSpareHOut1 = 26; // high current output spare1
+      pinSpareHOut2 = 27; // high current output spare2
+      pinSpareLOut1 = 55; //low current output spare1 - NOT USED
+      break;
+    #endif
+
+    case 55:
+      #if defined(CORE_TEENSY)
+      //Pin mappings for the DropBear
+      injectorOutputControl = OUTPUT_CONTROL_MC33810;
+      ignitionOutputControl = OUTPUT_CONTROL_MC33810;
+
+      //The injector pins below are not used directly as the control is via SPI through the MC33810s, however the pin numbers are set to be the SPI pins (SCLK, MOSI, MISO and CS) so that nothing else will set them as inputs
+      pinInjector1 = 13; //SCLK
+      pinInjector2 = 11; //MOSI
+      pinInjector3 = 12; //MISO
+      pinInjector4 = 10; //CS for MC33810 1
+      pinInjector5 = 9; //CS for MC33810 2
+      pinInjector6 = 9; //CS for MC33810 3
+
+      //Dummy pins, without these pin 0 (Serial1 RX) gets overwritten
+      pinCoil1 = 40;
+      pinCoil2 = 41;
+      /*
+      pinCoil3 = 55;
+      pinCoil4 = 55;
+      pinCoil5 = 55;
+      pinCoil6 = 55;
+      */
+      
+      pinTrigger = 19; //The CAS pin
+      pinTrigger2 = 18; //The Cam Sensor pin
+      pinTrigger3 = 22; //Uses one of the protected spare digital inputs. This must be set or Serial1 (Pin 0) gets broken
+      pinFlex = A16; // Flex sensor
+      pinMAP = A1; //MAP sensor pin
+      pinBaro = A0; //Baro sensor pin
+      pinBat = A14; //Battery reference voltage pin
+      pinSpareTemp1 = A17; //spare Analog input 1
+      pinLaunch = A15; //Can be overwritten below
+      pinTachOut = 5; //Tacho output pin
+      pinIdle1 = 27; //Single wire idle control
+      pinIdle2 = 29; //2 wire idle control. Shared with Spare 1 output
+      pinFuelPump = 8; //Fuel pump output
+      pinVVT_1 = 28; //Default VVT output
+      pinStepperDir = 32; //Direction pin  for DRV8825 driver
+      pinStepperStep = 31; //Step pin for DRV8825 driver
+      pinStepperEnable = 30; //Enable pin for DRV8825 driver
+      pinBoost = 24; //Boost control
+      pinSpareLOut1 = 29; //low current output spare1
+      pinSpareLOut2 = 26; //low current output spare2
+      pinSpareLOut3 = 28; //low current output spare3
+      pinSpareLOut4 = 29; //low current output spare4
+      pinFan = 25; //Pin for the fan output
+      pinResetControl = 46; //Reset control output PLACEHOLDER value for now
+
+      //CS pin number is now set in a compile flag. 
+      // #ifdef USE_SPI_EEPROM
+      //   pinSPIFlash_CS = 6;
+      // #endif
+
+      #if defined(CORE_TEENSY35)
+        pinTPS = A22; //TPS input pin
+        pinIAT = A19; //IAT sensor pin
+        pinCLT = A20; //CLS sensor pin
+        pinO2 = A21; //O2 Sensor pin
+        pinO2_2 = A18; //Spare 2
+
+        pSecondarySerial = &Serial1; //Header that is broken out on Dropbear boards is attached to Serial1
+      #endif
+
+      #if defined(CORE_TEENSY41)
+        pinTPS = A17; //TPS input pin
+        pinIAT = A14; //IAT sensor pin
+        pinCLT = A15; //CLS sensor pin
+        pinO2 = A16; //O2 Sensor pin
+        pinBat = A3; //Battery reference voltage pin. Needs Alpha4+
+
+        //New pins for the actual T4.1 version of the Dropbear
+        pinBaro = A4; 
+        pinMAP = A5;
+        pinTPS = A3; //TPS input pin
+        pinIAT = A0; //IAT sensor pin
+        pinCLT = A1; //CLS sensor pin
+        pinO2 = A2; //O2 Sensor pin
+        pinBat = A15; //Battery reference voltage pin. Needs Alpha4+
+        pinLaunch = 36;
+        pinFlex = 37; // Flex sensor
+        pinSpareTemp1 = A16; 
+        pinSpareTemp2 = A17;
+
+        pinTrigger = 20; //The CAS pin
+        pinTrigger2 = 21; //The Cam Sensor pin
+
+        pinFuelPump = 5; //Fuel pump output
+        pinTachOut = 8; //Tacho output pin
+
+        pinResetControl = 49; //PLaceholder only. Cannot use 42-47 as these are the SD card
+
+        //CS pin number is now set in a compile flag. 
+        // #ifdef USE_SPI_EEPROM
+        //   pinSPIFlash_CS = 33;
+        // #endif
+
+      #endif
+
+        pinMC33810_1_CS = 10;
+        pinMC33810_2_CS = 9;
+
+      //Pin alignment to the MC33810 outputs
+      MC33810_BIT_INJ1 = 3;
+      MC33810_BIT_INJ2 = 1;
+      MC33810_BIT_INJ3 = 0;
+      MC33810_BIT_INJ4 = 2;
+      MC33810_BIT_IGN1 = 4;
+      MC33810_BIT_IGN2 = 5;
+      MC33810_BIT_IGN3 = 6;
+      MC33810_BIT_IGN4 = 7;
+
+      MC33810_BIT_INJ5 = 3;
+      MC33810_BIT_INJ6 = 1;
+      MC33810_BIT_INJ7 = 0;
+      MC33810_BIT_INJ8 = 2;
+      MC33810_BIT_IGN5 = 4;
+      MC33810_BIT_IGN6 = 5;
+      MC33810_BIT_IGN7 = 6;
+      MC33810_BIT_IGN8 = 7;
+
+
+
+      #endif
+      break;
+
+    case 56:
+      #if defined(CORE_TEENSY)
+      //Pin mappings for the Bear Cub (Teensy 4.1)
+      pinInjector1 = 6;
+      pinInjector2 = 7;
+      pinInjector3 = 9;
+      pinInjector4 = 8;
+      pinInjector5 = 0; //Not used
+      pinCoil1 = 2;
+      pinCoil2 = 3;
+      pinCoil3 = 4;
+      pinCoil4 = 5;
+
+      pinTrigger = 20; //The CAS pin
+      pinTrigger2 = 21; //The Cam Sensor pin
+      pinFlex = 37; // Flex sensor
+      pinMAP = A5; //MAP sensor pin
+      pinBaro = A4; //Baro sensor pin
+      pinBat = A15; //Battery reference voltage pin
+      pinTPS = A3; //TPS input pin
+      pinIAT = A0; //IAT sensor pin
+      pinCLT = A1; //CLS sensor pin
+      pinO2 = A2; //O2 Sensor pin
+      pinLaunch = 36;
+
+      pinSpareTemp1 = A16; //spare Analog input 1
+      pinSpareTemp2 = A17; //spare Analog input 2
+      pinTachOut = 38; //Tacho output pin
+      pinIdle1 = 27; //Single wire idle control
+      pinIdle2 = 26; //2 wire idle control. Shared with Spare 1 output
+      pinFuelPump = 10; //Fuel pump output
+      pinVVT_1 = 28; //Default VVT output
+      pinStepperDir = 32; //Direction pin  for DRV8825 driver
+      pinStepperStep = 31; //Step pin for DRV8825 driver
+      pinStepperEnable = 30; //Enable pin for DRV8825 driver
+      pinBoost = 24; //Boost control
+      pinSpareLOut1 = 29; //low current output spare1
+      pinSpareLOut2 = 26; //low current output spare2
+      pinSpareLOut3 = 28; //low current output spare3
+      pinSpareLOut4 = 29; //low current output spare4
+      pinFan = 25; //Pin for the fan output
+      pinResetControl = 46; //Reset control output PLACEHOLDER value for now
+
+      #endif
+      break;
+    
+ 
+    case 60:
+        #if defined(STM32F407xx)
+        //Pin definitions for experimental board Tjeerd 
+        //Black F407VE wiki.stm32duino.com/index.php?title=STM32F407
+        //https://github.com/Tjeerdie/SPECTRE/tree/master/SPECTRE_V0.5
+        
+        //******************************************
+        //******** PORTA CONNECTIONS *************** 
+        //******************************************
+        // = PA0; //Wakeup ADC123
+        // = PA1; //ADC123
+        // = PA2; //ADC123
+        // = PA3; //ADC123
+        // = PA4; //ADC12
+        // = PA5; //ADC12
+        // = PA6; //ADC12 LED_BUILTIN_1
+        // = PA7; //ADC12 LED_BUILTIN_2
+        pinCoil3 = PA8;
+        // = PA9;  //TXD1=Bluetooth module
+        // = PA10; //RXD1=Bluetooth module
+        // = PA11; //(DO NOT USE FOR SPEEDUINO) USB
+        // = PA12; //(DO NOT USE FOR SPEEDUINO) USB 
+        // = PA13;  //(DO NOT USE FOR SPEEDUINO) NOT ON GPIO - DEBUG ST-LINK
+        // = PA14;  //(DO NOT USE FOR SPEEDUINO) NOT ON GPIO - DEBUG ST-LINK
+        // = PA15;  //(DO NOT USE FOR SPEEDUINO) NOT ON GPIO - DEBUG ST-LINK
+
+        //******************************************
+        //******** PORTB CONNECTIONS *************** 
+        //******************************************
+        // = PB0;  //(DO NOT USE FOR SPEEDUINO) ADC123 - SPI FLASH CHIP CS pin
+        pinBaro = PB1; //ADC12
+        // = PB2;  //(DO NOT USE FOR SPEEDUINO) BOOT1 
+        // = PB3;  //(DO NOT USE FOR SPEEDUINO) SPI1_SCK FLASH CHIP
+        // = PB4;  //(DO NOT USE FOR SPEEDUINO) SPI1_MISO FLASH CHIP
+        // = PB5;  //(DO NOT USE FOR SPEEDUINO) SPI1_MOSI FLASH CHIP
+        // = PB6;  //NRF_CE
+        pinCoil6 = PB7;  //NRF_CS
+        // = PB8;  //NRF_IRQ
+        pinCoil2 = PB9; //
+        // = PB9;  //
+        // = PB10; //TXD3
+        // = PB11; //RXD3
+        // = PB12; //
+        // = PB13;  //SPI2_SCK
+        // = PB14;  //SPI2_MISO
+        // = PB15;  //SPI2_MOSI
+
+        //******************************************
+        //******** PORTC CONNECTIONS *************** 
+        //******************************************
+        pinIAT = PC0; //ADC123 
+        pinTPS = PC1; //ADC123
+        pinMAP = PC2; //ADC123 
+        pinCLT = PC3; //ADC123
+        pinO2 = PC4; //ADC12
+        pinBat = PC5;  //ADC12
+        pinBoost = PC6; //
+        pinIdle1 = PC7; //
+        // = PC8;  //(DO NOT USE FOR SPEEDUINO) - SDIO_D0
+        // = PC9;  //(DO NOT USE FOR SPEEDUINO) - SDIO_D1
+        // = PC10;  //(DO NOT USE FOR SPEEDUINO) - SDIO_D2
+        // = PC11;  //(DO NOT USE FOR SPEEDUINO) - SDIO_D3
+        // = PC12;  //(DO NOT USE FOR SPEEDUINO) - SDIO_SCK
+        pinTachOut = PC13; //
+        // = PC14;  //(DO NOT USE FOR SPEEDUINO) - OSC32_IN
+        // = PC15;  //(DO NOT USE FOR SPEEDUINO) - OSC32_OUT
+
+        //******************************************
+        //******** PORTD CONNECTIONS *************** 
+        //******************************************
+        // = PD0;  //CANRX
+        // = PD1;  //CANTX
+        // = PD2;  //(DO NOT USE FOR SPEEDUINO) - SDIO_CMD
+        pinIdle2 = PD3; //
+        // = PD4;  //
+        pinFlex = PD4;
+        // = PD5; //TXD2
+        // = PD6;  //RXD2
+        pinCoil1 = PD7; //
+        // = PD7;  //
+        // = PD8;  //
+        pinCoil5 = PD9;//
+        pinCoil4 = PD10;//
+        // = PD11;  //
+        pinInjector1 = PD12; //
+        pinInjector2 = PD13; //
+        pinInjector3 = PD14; //
+        pinInjector4 = PD15; //
+
+        //******************************************
+        //******** PORTE CONNECTIONS *************** 
+        //******************************************
+        pinTrigger = PE0; //
+        pinTrigger2 = PE1; //
+        pinStepperEnable = PE2; //
+        pinFuelPump = PE3; //ONBOARD KEY1
+        // = PE4;  //ONBOARD KEY2
+        pinStepperStep = PE5; //
+        pinFan = PE6; //
+        pinStepperDir = PE7; //
+        // = PE8;  //
+        pinInjector5 = PE9; //
+        // = PE10;  //
+        pinInjector6 = PE11; //
+        // = PE12; //
+        pinInjector8 = PE13; //
+        pinInjector7 = PE14; //
+        // = PE15;  //
+     #elif (defined(STM32F411xE) || defined(STM32F401xC))
+        //pins PA12, PA11 are used for USB or CAN couldn't be used for GPIO
+        //PB2 can't be used as input because is BOOT pin
+        pinInjector1 = PB7; //Output pin injector 1 is on
+        pinInjector2 = PB6; //Output pin injector 2 is on
+        pinInjector3 = PB5; //Output pin injector 3 is on
+        pinInjector4 = PB4; //Output pin injector 4 is on
+        pinCoil1 = PB9; //Pin for coil 1
+        pinCoil2 = PB8; //Pin for coil 2
+        pinCoil3 = PB3; //Pin for coil 3
+        pinCoil4 = PA15; //Pin for coil 4
+        pinTPS = A2;//TPS input pin
+        pinMAP = A3; //MAP sensor pin
+        pinIAT = A0; //IAT sensor pin
+        pinCLT = A1; //CLS sensor pin
+        pinO2 = A8; //O2 Sensor pin
+        pinBat = A4; //Battery reference voltage pin
+        pinBaro = pinMAP;
+        pinTachOut = PB1; //Tacho output pin  (Goes to ULN2803)
+        pinIdle1 = PB2; //Single wire idle control
+        pinIdle2 = PB10; //2 wire idle control
+        pinBoost = PA6; //Boost control
+        pinStepperDir = PB10; //Direction pin  for DRV8825 driver
+        pinStepperStep = PB2; //Step pin for DRV8825 driver
+        pinFuelPump = PA8; //Fuel pump output
+        pinFan = PA5; //Pin for the fan output (Goes to ULN2803)
+
+        //external interrupt enabled pins
+        pinFlex = PC14; // Flex sensor (Must be external interrupt enabled)
+        pinTrigger = PC13; //The CAS pin also led pin so bad idea
+        pinTrigger2 = PC15; //The Cam Sensor pin
+
+     #elif defined(CORE_STM32)
+        //blue pill wiki.stm32duino.com/index.php?title=Blue_Pill
+        //Maple mini wiki.stm32duino.com/index.php?title=Maple_Mini
+        //pins PA12, PA11 are used for USB or CAN couldn't be used for GPIO
+        //PB2 can't be used as input because is BOOT pin
+        pinInjector1 = PB7; //Output pin injector 1 is on
+        pinInjector2 = PB6; //Output pin injector 2 is on
+        pinInjector3 = PB5; //Output pin injector 3 is on
+        pinInjector4 = PB4; //Output pin injector 4 is on
+        pinCoil1 = PB3; //Pin for coil 1
+        pinCoil2 = PA15; //Pin for coil 2
+        pinCoil3 = PA14; //Pin for coil 3
+        pinCoil4 = PA9; //Pin for coil 4
+        pinCoil5 = PA8; //Pin for coil 5
+        pinTPS = A0; //TPS input pin
+        pinMAP = A1; //MAP sensor pin
+        pinIAT = A2; //IAT sensor pin
+        pinCLT = A3; //CLS sensor pin
+        pinO2 = A4; //O2 Sensor pin
+        pinBat = A5; //Battery reference voltage pin
+        pinBaro = pinMAP;
+        pinIdle1 = PB2; //Single wire idle control
+        pinIdle2 = PA2; //2 wire idle control
+        pinBoost = PA1; //Boost control
+        pinVVT_1 = PA0; //Default VVT output
+        pinVVT_2 = PA2; //Default VVT2 output
+        pinStepperDir = PC15; //Direction pin  for DRV8825 driver
+        pinStepperStep = PC14; //Step pin for DRV8825 driver
+        pinStepperEnable = PC13; //Enable pin for DRV8825
+        pinDisplayReset = PB2; // OLED reset pin
+        pinFan = PB1; //Pin for the fan output
+        pinFuelPump = PB11; //Fuel pump output
+        pinTachOut = PB10; //Tacho output pin
+        //external interrupt enabled pins
+        pinFlex = PB8; // Flex sensor (Must be external interrupt enabled)
+        pinTrigger = PA10; //The CAS pin
+        pinTrigger2 = PA13; //The Cam Sensor pin
+      
+    #endif
+      break;
+    default:
+      #if defined(STM32F407xx)
+      //Pin definitions for experimental board Tjeerd 
+        //Black F407VE wiki.stm32duino.com/index.php?title=STM32F407
+
+        //******************************************
+        //******** PORTA CONNECTIONS *************** 
+        //******************************************
+        /* = PA0 */ //Wakeup ADC123
+        // = PA1;
+        // = PA2;
+        // = PA3;
+        // = PA4;
+        /* = PA5; */ //ADC12
+        pinFuelPump = PA6; //ADC12 LED_BUILTIN_1
+        /* = PA7; */ //ADC12 LED_BUILTIN_2
+        pinCoil3 = PA8;
+        /* = PA9 */ //TXD1
+        /* = PA10 */ //RXD1
+        /* = PA11 */ //(DO NOT USE FOR SPEEDUINO) USB
+        /* = PA12 */ //(DO NOT USE FOR SPEEDUINO) USB 
+        /* = PA13 */ //(DO NOT USE FOR SPEEDUINO) NOT ON GPIO - DEBUG ST-LINK
+        /* = PA14 */ //(DO NOT USE FOR SPEEDUINO) NOT ON GPIO - DEBUG ST-LINK
+        /* = PA15 */ //(DO NOT USE FOR SPEEDUINO) NOT ON GPIO - DEBUG ST-LINK
+
+        //******************************************
+        //******** PORTB CONNECTIONS *************** 
+        //******************************************
+        /* = PB0; */ //(DO NOT USE FOR SPEEDUINO) ADC123 - SPI FLASH CHIP CS pin
+        pinBaro = PB1; //ADC12
+        /* = PB2; */ //(DO NOT USE FOR SPEEDUINO) BOOT1 
+        /* = PB3; */ //(DO NOT USE FOR SPEEDUINO) SPI1_SCK FLASH CHIP
+        /* = PB4; */ //(DO NOT USE FOR SPEEDUINO) SPI1_MISO FLASH CHIP
+        /* = PB5; */ //(DO NOT USE FOR SPEEDUINO) SPI1_MOSI FLASH CHIP
+        /* = PB6; */ //NRF_CE
+        /* = PB7; */ //NRF_CS
+        /* = PB8; */ //NRF_IRQ
+        pinCoil2 = PB9; //
+        /* = PB9; */ //
+        pinCoil4 = PB10; //TXD3
+        pinIdle1 = PB11; //RXD3
+        pinIdle2 = PB12; //
+        /* pinBoost = PB12; */ //
+        /* = PB13; */ //SPI2_SCK
+        /* = PB14; */ //SPI2_MISO
+        /* = PB15; */ //SPI2_MOSI
+
+        //******************************************
+        //******** PORTC CONNECTIONS *************** 
+        //******************************************
+        pinMAP = PC0; //ADC123 
+        pinTPS = PC1; //ADC123
+        pinIAT = PC2; //ADC123
+        pinCLT = PC3; //ADC123
+        pinO2 = PC4; //ADC12
+        pinBat = PC5; //ADC12
+        /*pinVVT_1 = PC6; */ //
+        pinDisplayReset = PC7; //
+        /* = PC8; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_D0
+        /* = PC9; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_D1
+        /* = PC10; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_D2
+        /* = PC11; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_D3
+        /* = PC12; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_SCK
+        pinTachOut = PC13; //
+        /* = PC14; */ //(DO NOT USE FOR SPEEDUINO) - OSC32_IN
+        /* = PC15; */ //(DO NOT USE FOR SPEEDUINO) - OSC32_OUT
+
+        //******************************************
+        //******** PORTD CONNECTIONS *************** 
+        //******************************************
+        /* = PD0; */ //CANRX
+        /* = PD1; */ //CANTX
+        /* = PD2; */ //(DO NOT USE FOR SPEEDUINO) - SDIO_CMD
+        /* = PD3; */ //
+        /* = PD4; */ //
+        pinFlex = PD4;
+        /* = PD5;*/ //TXD2
+        /* = PD6; */ //RXD2
+        pinCoil1 = PD7; //
+        /* = PD7; */ //
+        /* = PD8; */ //
+        pinCoil5 = PD9;//
+        /* = PD10; */ //
+        /* = PD11; */ //
+        pinInjector1 = PD12; //
+        pinInjector2 = PD13; //
+        pinInjector3 = PD14; //
+        pinInjector4 = PD15; //
+
+        //******************************************
+        //******** PORTE CONNECTIONS *************** 
+        //******************************************
+        pinTrigger = PE0; //
+        pinTrigger2 = PE1; //
+        pinStepperEnable = PE2; //
+        /* = PE3; */ //ONBOARD KEY1
+        /* = PE4; */ //ONBOARD KEY2
+        pinStepperStep = PE5; //
+        pinFan = PE6; //
+        pinStepperDir = PE7; //
+        /* = PE8; */ //
+        /* = PE9; */ //
+        /* = PE10; */ //
+        pinInjector5 = PE11; //
+        pinInjector6 = PE12; //
+        /* = PE13; */ //
+        /* = PE14; */ //
+        /* = PE15; */ //
+      #else
+        #ifndef SMALL_FLASH_MODE //No support for bluepill here anyway
+        //Pin mappings as per the v0.2 shield
+        pinInjector1 = 8; //Output pin injector 1 is on
+        pinInjector2 = 9; //Output pin injector 2 is on
+        pinInjector3 = 10; //Output pin injector 3 is on
+        pinInjector4 = 11; //Output pin injector 4 is on
+        pinInjector5 = 12; //Output pin injector 5 is on
+        pinCoil1 = 28; //Pin for coil 1
+        pinCoil2 = 24; //Pin for coil 2
+        pinCoil3 = 40; //Pin for coil 3
+        pinCoil4 = 36; //Pin for coil 4
+        pinCoil5 = 34; //Pin for coil 5 PLACEHOLDER value for now
+        pinTrigger = 20; //The CAS pin
+        pinTrigger2 = 21; //The Cam Sensor pin
+        pinTPS = A2; //TPS input pin
+        pinMAP = A3; //MAP sensor pin
+        pinIAT = A0; //IAT sensor pin
+        pinCLT = A1; //CLS sensor pin
+        #ifdef A8 //Bit hacky, but needed for the atmega2561
+        pinO2 = A8; //O2 Sensor pin
+        #endif
+        pinBat = A4; //Battery reference voltage pin
+        pinStepperDir = 16; //Direction pin  for DRV8825 driver
+        pinStepperStep = 17; //Step pin for DRV8825 driver
+        pinDisplayReset = 48; // OLED reset pin
+        pinFan = 47; //Pin for the fan output
+        pinFuelPump = 4; //Fuel pump output
+        pinTachOut = 49; //Tacho output pin
+        pinFlex = 3; // Flex sensor (Must be external interrupt enabled)
+        pinBoost = 5;
+        pinIdle1 = 6;
+        pinResetControl = 43; //Reset control output
+        #endif
+      #endif  
+      break;
+  }
+}
@@ -27,6 +27,7 @@ void prepareForInitialiseAll(uint8_t boardId) {
 void testInitialisation(void);
 void testFuelScheduleInit(void);
 void testIgnitionScheduleInit(void);
+void testBoardPinMaps(void);
 
 #define UNITY_EXCLUDE_DETAILS
 
@@ -45,6 +46,7 @@ void setup()
     testFuelScheduleInit();
     testIgnitionScheduleInit();
     testInitialisation();
+    testBoardPinMaps();
 
     UNITY_END(); // stop unit testing
 
@@ -0,0 +1,78 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "globals.h"
+#include "boardPinMaps.h"
+#include "acc_mc33810.h"
+#include "../test_utils.h"
+
+void legacyBoardPinMapping(byte boardID);
+
+#define BOARD_TARGET_ADDRESS(name) &name,
+static byte * const pinTargets[] = { BOARD_PIN_TARGETS(BOARD_TARGET_ADDRESS) };
+static constexpr byte UNSET_PIN = 0xEE; //Not a pin on any board, so it shows which pins a board leaves unchanged
+
+static void setAllPinTargets(byte value)
+{
+  for(uint8_t target = 0; target < _countof(pinTargets); target++) { *pinTargets[target] = value; }
+}
+
+// Every board ID must give exactly the same pins as the original setPinMapping() switch, including the pins it leaves unchanged
+static void test_boardPinMaps_matchLegacy(void)
+{
+  byte legacyPins[_countof(pinTargets)];
+  char msg[40];
+  uint16_t boardsChecked = 0;
+
+  for(uint16_t boardID = 0; boardID <= UINT8_MAX; boardID++)
+  {
+    setAllPinTargets(UNSET_PIN);
+    legacyBoardPinMapping((byte)boardID);
+    for(uint8_t target = 0; target < _countof(pinTargets); target++) { legacyPins[target] = *pinTargets[target]; }
+
+    setAllPinTargets(UNSET_PIN);
+    applyBoardPinMap((byte)boardID);
+    for(uint8_t target = 0; target < _countof(pinTargets); target++)
+    {
+      if(legacyPins[target] != *pinTargets[target])
+      {
+        sprintf_P(msg, PSTR("Board %" PRIu16 ", target %" PRIu8), boardID, target);
+        TEST_ASSERT_EQUAL_UINT8_MESSAGE(legacyPins[target], *pinTargets[target], msg);
+      }
+    }
+    boardsChecked++;
+  }
+  TEST_ASSERT_EQUAL_UINT16(256, boardsChecked);
+}
+
+static void test_boardPinMaps_v04(void)
+{
+  setAllPinTargets(UNSET_PIN);
+  applyBoardPinMap(3);
+  TEST_ASSERT_EQUAL_UINT8(8, pinInjector1);
+  TEST_ASSERT_EQUAL_UINT8(40, pinCoil1);
+  TEST_ASSERT_EQUAL_UINT8(A3, pinMAP);
+  TEST_ASSERT_EQUAL_UINT8(UNSET_PIN, MC33810_BIT_INJ1); //Not set by this board
+}
+
+static void test_boardPinMaps_unknownBoard(void)
+{
+  //Boards without a map get the default one
+  byte defaultPins[_countof(pinTargets)];
+  setAllPinTargets(UNSET_PIN);
+  applyBoardPinMap(254);
+  for(uint8_t target = 0; target < _countof(pinTargets); target++) { defaultPins[target] = *pinTargets[target]; }
+
+  setAllPinTargets(UNSET_PIN);
+  applyBoardPinMap(0);
+  for(uint8_t target = 0; target < _countof(pinTargets); target++) { TEST_ASSERT_EQUAL_UINT8(defaultPins[target], *pinTargets[target]); }
+  TEST_ASSERT_NOT_EQUAL(UNSET_PIN, pinInjector1);
+}
+
+void testBoardPinMaps(void)
+{
+  SET_UNITY_FILENAME() {
+    RUN_TEST_P(test_boardPinMaps_matchLegacy);
+    RUN_TEST_P(test_boardPinMaps_v04);
+    RUN_TEST_P(test_boardPinMaps_unknownBoard);
+  }
+}
@@ -0,0 +1,43 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <init.h>
+#include <avr/sleep.h>
+
+void testPWMOutputs(void);
+void testSoftPWM(void);
+
+#define UNITY_EXCLUDE_DETAILS
+
+void setup()
+{
+    pinMode(LED_BUILTIN, OUTPUT);
+
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+#if !defined(SIMULATOR)
+    delay(2000);
+#endif
+
+    UNITY_BEGIN();    // IMPORTANT LINE!
+
+    initialiseAll(); //The auxiliary outputs and their timers must be set up
+    testPWMOutputs();
+    testSoftPWM();
+
+    UNITY_END(); // stop unit testing
+
+#if defined(SIMULATOR)       // Tell SimAVR we are done
+    cli();
+    sleep_enable();
+    sleep_cpu();
+#endif     
+}
+
+void loop()
+{
+    // Blink to indicate end of test
+    digitalWrite(LED_BUILTIN, HIGH);
+    delay(250);
+    digitalWrite(LED_BUILTIN, LOW);
+    delay(250);
+}
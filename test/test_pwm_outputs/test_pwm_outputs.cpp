@@ -0,0 +1,178 @@
+#include <unity.h>
+#include "globals.h"
+#include "auxiliaries.h"
+#include "pwmOutputs.h"
+#include "../test_utils.h"
+
+// A backend that records what it is asked to do instead of driving any hardware
+static uint8_t mockPin;
+static uint16_t mockFrequency;
+static uint16_t mockDuty;
+static uint16_t mockWrites;
+static bool mockEnded;
+static bool mockRefuse;
+
+static bool mockBegin(uint8_t pin, uint16_t frequency)
+{
+    if(mockRefuse) { return false; }
+    mockPin = pin;
+    mockFrequency = frequency;
+    mockEnded = false;
+    return true;
+}
+static void mockWrite(uint8_t pin, uint16_t duty) { mockPin = pin; mockDuty = duty; mockWrites++; }
+static void mockEnd(uint8_t pin) { mockPin = pin; mockEnded = true; }
+
+static const pwm_backend_t mockBackend = { mockBegin, mockWrite, mockEnd };
+
+static void useBackend(const pwm_backend_t *backend)
+{
+    //Outputs must be ended by the backend that began them
+    for(uint8_t output = 0; output < PWM_OUT_COUNT; output++) { pwmOutputEnd(output); }
+    pwmBackend = backend;
+    mockPin = 0;
+    mockFrequency = 0;
+    mockDuty = UINT16_MAX;
+    mockWrites = 0;
+    mockEnded = false;
+    mockRefuse = false;
+}
+
+static void test_pwmOutputs_noBackend(void)
+{
+    useBackend(nullptr);
+    TEST_ASSERT_FALSE(pwmOutputBegin(PWM_OUT_BOOST, 7, 100, false));
+    TEST_ASSERT_FALSE(pwmOutputIsHardware(PWM_OUT_BOOST));
+    pwmOutputWrite(PWM_OUT_BOOST, 5000); //Must do nothing
+}
+
+static void test_pwmOutputs_mock(void)
+{
+    useBackend(&mockBackend);
+    TEST_ASSERT_TRUE(pwmOutputBegin(PWM_OUT_FAN, 9, 200, false));
+    TEST_ASSERT_TRUE(pwmOutputIsHardware(PWM_OUT_FAN));
+    TEST_ASSERT_EQUAL_UINT8(9, mockPin);
+    TEST_ASSERT_EQUAL_UINT16(200, mockFrequency);
+    TEST_ASSERT_EQUAL_UINT16(0, mockDuty); //Starts off
+
+    pwmOutputWrite(PWM_OUT_FAN, 2500);
+    TEST_ASSERT_EQUAL_UINT16(2500, mockDuty);
+    pwmOutputWrite(PWM_OUT_FAN, PWM_DUTY_MAX + 1U);
+    TEST_ASSERT_EQUAL_UINT16(PWM_DUTY_MAX, mockDuty);
+
+    //Other outputs are unaffected
+    uint16_t writes = mockWrites;
+    pwmOutputWrite(PWM_OUT_IDLE, 1000);
+    TEST_ASSERT_EQUAL_UINT16(writes, mockWrites);
+
+    pwmOutputEnd(PWM_OUT_FAN);
+    TEST_ASSERT_TRUE(mockEnded);
+    TEST_ASSERT_FALSE(pwmOutputIsHardware(PWM_OUT_FAN));
+}
+
+static void test_pwmOutputs_inverted(void)
+{
+    useBackend(&mockBackend);
+    TEST_ASSERT_TRUE(pwmOutputBegin(PWM_OUT_IDLE, 5, 100, true));
+    TEST_ASSERT_EQUAL_UINT16(PWM_DUTY_MAX, mockDuty); //0% inverted is always on
+    pwmOutputWrite(PWM_OUT_IDLE, 3000);
+    TEST_ASSERT_EQUAL_UINT16(7000, mockDuty);
+    pwmOutputEnd(PWM_OUT_IDLE);
+}
+
+static void test_pwmOutputs_refused(void)
+{
+    useBackend(&mockBackend);
+    mockRefuse = true;
+    TEST_ASSERT_FALSE(pwmOutputBegin(PWM_OUT_BOOST, 7, 100, false));
+    TEST_ASSERT_FALSE(pwmOutputIsHardware(PWM_OUT_BOOST));
+    TEST_ASSERT_FALSE(pwmOutputBegin(PWM_OUT_BOOST, 7, 0, false)); //No frequency
+    TEST_ASSERT_FALSE(pwmOutputBegin(PWM_OUT_COUNT, 7, 100, false)); //No such output
+}
+
+// Open loop boost at a fixed 50% duty (Boost by gear with a fixed duty per gear), 200Hz
+static void setup_boost(void)
+{
+    configPage6.boostEnabled = 1;
+    configPage4.boostType = OPEN_LOOP_BOOST;
+    configPage9.boostByGearEnabled = 2;
+    configPage2.vssMode = 2;
+    configPage9.boostByGear1 = 25;
+    configPage6.boostFreq = 100;
+    configPage6.vvtEnabled = 0;
+    configPage10.wmiEnabled = 0;
+    currentStatus.gear = 1;
+    pinBoost = 7;
+    pinMode(pinBoost, OUTPUT);
+    boost_pwm_max_count = (uint16_t)(MICROS_PER_SEC / (16U * configPage6.boostFreq * 2U));
+    initialiseAuxPWM();
+}
+
+// Counts the changes of the boost pin over 100mS. Each one is an interrupt when the output is not driven by hardware PWM
+static uint16_t countBoostEdges(void)
+{
+    uint16_t edges = 0;
+    int lastState = digitalRead(pinBoost);
+    uint32_t startTime = millis();
+    while((millis() - startTime) < 100UL)
+    {
+        int state = digitalRead(pinBoost);
+        if(state != lastState) { edges++; lastState = state; }
+    }
+    return edges;
+}
+
+static void test_pwmOutputs_boostHardware(void)
+{
+    useBackend(&mockBackend);
+    setup_boost();
+    TEST_ASSERT_TRUE(pwmOutputIsHardware(PWM_OUT_BOOST));
+    TEST_ASSERT_EQUAL_UINT8(7, mockPin);
+    TEST_ASSERT_EQUAL_UINT16(200, mockFrequency);
+
+    boostControl();
+    TEST_ASSERT_EQUAL_UINT16(5000, currentStatus.boostDuty);
+    TEST_ASSERT_EQUAL_UINT16(5000, mockDuty);
+    uint16_t edges = countBoostEdges();
+
+    char msg[48];
+    sprintf_P(msg, PSTR("Hardware PWM: %" PRIu16 " interrupts/100mS"), edges);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_EQUAL_UINT16(0, edges);
+
+    boostDisable();
+    TEST_ASSERT_EQUAL_UINT16(0, mockDuty);
+}
+
+static void test_pwmOutputs_boostInterrupt(void)
+{
+    useBackend(nullptr);
+    setup_boost();
+    TEST_ASSERT_FALSE(pwmOutputIsHardware(PWM_OUT_BOOST));
+
+    boostControl();
+    TEST_ASSERT_EQUAL_UINT16(5000, currentStatus.boostDuty);
+    uint16_t edges = countBoostEdges();
+
+    char msg[48];
+    sprintf_P(msg, PSTR("Compare interrupt: %" PRIu16 " interrupts/100mS"), edges);
+    TEST_MESSAGE(msg);
+    //2 per cycle at 200Hz
+    TEST_ASSERT_UINT16_WITHIN(4, 40, edges);
+
+    boostDisable();
+}
+
+void testPWMOutputs(void)
+{
+    const pwm_backend_t *boardBackend = pwmBackend;
+    SET_UNITY_FILENAME() {
+        RUN_TEST_P(test_pwmOutputs_noBackend);
+        RUN_TEST_P(test_pwmOutputs_mock);
+        RUN_TEST_P(test_pwmOutputs_inverted);
+        RUN_TEST_P(test_pwmOutputs_refused);
+        RUN_TEST_P(test_pwmOutputs_boostHardware);
+        RUN_TEST_P(test_pwmOutputs_boostInterrupt);
+    }
+    useBackend(boardBackend);
+}
@@ -0,0 +1,196 @@
+#include <unity.h>
+#include "globals.h"
+#include "softPWM.h"
+#include "../test_utils.h"
+
+// The channels drive bits of a RAM variable rather than a real port, so the output states can be checked directly
+static volatile PORT_TYPE fakePort;
+static soft_pwm_t testPWM;
+
+static constexpr uint16_t TEST_PERIOD = 1000;
+
+static void setup_softPWM(uint8_t channels, bool reloadTimer)
+{
+    fakePort = 0;
+    softPWMInit(testPWM, TEST_PERIOD, reloadTimer);
+    for(uint8_t channel = 0; channel < channels; channel++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(channel, softPWMAddChannel(testPWM, &fakePort, (PINMASK_TYPE)(1U << channel), false));
+    }
+}
+
+// Runs the interrupt for a number of periods, as the timer would, and totals the on time of each channel
+struct softPWMRun {
+    uint32_t onTime[SOFT_PWM_MAX_CHANNELS];
+    uint32_t interrupts;
+    uint32_t interruptMicros;
+};
+
+static softPWMRun runSoftPWM(uint16_t periods)
+{
+    softPWMRun run;
+    memset(&run, 0, sizeof(run));
+    uint32_t time = 0;
+    //The first interrupt is the start of a period
+    uint16_t interval = softPWMInterrupt(testPWM);
+    while(time < ((uint32_t)periods * TEST_PERIOD))
+    {
+        for(uint8_t channel = 0; channel < testPWM.channelCount; channel++)
+        {
+            if(BIT_CHECK(fakePort, channel)) { run.onTime[channel] += interval; }
+        }
+        time += interval;
+        uint32_t startTime = micros();
+        interval = softPWMInterrupt(testPWM);
+        run.interruptMicros += micros() - startTime;
+        run.interrupts++;
+    }
+    return run;
+}
+
+static void test_softPWM_edgeOrder(void)
+{
+    setup_softPWM(5, false);
+    softPWMSetOnTime(testPWM, 0, 300);
+    softPWMSetOnTime(testPWM, 1, 100);
+    softPWMSetOnTime(testPWM, 2, 200);
+    softPWMSetOnTime(testPWM, 3, 100);
+    softPWMSetOnTime(testPWM, 4, 0);
+    softPWMUpdate(testPWM);
+    TEST_ASSERT_TRUE(testPWM.pending);
+
+    //The new edges are taken up at the start of the period
+    TEST_ASSERT_EQUAL_UINT16(100, softPWMInterrupt(testPWM));
+    TEST_ASSERT_FALSE(testPWM.pending);
+    const soft_pwm_edges_t &edges = testPWM.edges[testPWM.active];
+    TEST_ASSERT_EQUAL_UINT8(3, edges.count);
+    TEST_ASSERT_EQUAL_UINT16(100, edges.time[0]);
+    TEST_ASSERT_EQUAL_UINT16(200, edges.time[1]);
+    TEST_ASSERT_EQUAL_UINT16(300, edges.time[2]);
+    TEST_ASSERT_EQUAL_UINT8(0b01010, edges.channels[0]); //Channels with the same duty share an edge
+    TEST_ASSERT_EQUAL_UINT8(0b00100, edges.channels[1]);
+    TEST_ASSERT_EQUAL_UINT8(0b00001, edges.channels[2]);
+    TEST_ASSERT_EQUAL_UINT8(0b01111, fakePort);
+
+    TEST_ASSERT_EQUAL_UINT16(100, softPWMInterrupt(testPWM));
+    TEST_ASSERT_EQUAL_UINT8(0b00101, fakePort);
+    TEST_ASSERT_EQUAL_UINT16(100, softPWMInterrupt(testPWM));
+    TEST_ASSERT_EQUAL_UINT8(0b00001, fakePort);
+    TEST_ASSERT_EQUAL_UINT16(TEST_PERIOD - 300, softPWMInterrupt(testPWM));
+    TEST_ASSERT_EQUAL_UINT8(0, fakePort);
+}
+
+static void test_softPWM_limits(void)
+{
+    setup_softPWM(3, false);
+    fakePort = 0b100; //Channel 2 is at 0% and must be turned off
+    softPWMSetOnTime(testPWM, 0, TEST_PERIOD); //Always on
+    softPWMSetOnTime(testPWM, 1, UINT16_MAX); //Clamped to the period
+    softPWMSetOnTime(testPWM, SOFT_PWM_MAX_CHANNELS, 500); //No such channel
+    softPWMUpdate(testPWM);
+
+    //No edges, so the interrupt only runs once per period
+    TEST_ASSERT_EQUAL_UINT16(TEST_PERIOD, softPWMInterrupt(testPWM));
+    TEST_ASSERT_EQUAL_UINT8(0b011, fakePort);
+    TEST_ASSERT_EQUAL_UINT16(TEST_PERIOD, softPWMInterrupt(testPWM));
+    TEST_ASSERT_EQUAL_UINT8(0b011, fakePort);
+}
+
+static void test_softPWM_inverted(void)
+{
+    fakePort = 0;
+    softPWMInit(testPWM, TEST_PERIOD, false);
+    softPWMAddChannel(testPWM, &fakePort, 0b1, true);
+    softPWMSetOnTime(testPWM, 0, 250);
+    softPWMUpdate(testPWM);
+    softPWMInterrupt(testPWM);
+    TEST_ASSERT_EQUAL_UINT8(0, fakePort);
+    softPWMInterrupt(testPWM);
+    TEST_ASSERT_EQUAL_UINT8(1, fakePort);
+}
+
+static void test_softPWM_full(void)
+{
+    setup_softPWM(SOFT_PWM_MAX_CHANNELS, false);
+    TEST_ASSERT_EQUAL_UINT8(SOFT_PWM_NO_CHANNEL, softPWMAddChannel(testPWM, &fakePort, 0, false));
+}
+
+static void test_softPWM_dutyChange(void)
+{
+    setup_softPWM(2, false);
+    softPWMSetOnTime(testPWM, 0, 400);
+    softPWMSetOnTime(testPWM, 1, 600);
+    softPWMUpdate(testPWM);
+    softPWMInterrupt(testPWM); //Start of period
+    softPWMInterrupt(testPWM); //Channel 0 off
+
+    //A change part way through a period is held until the next one
+    softPWMSetOnTime(testPWM, 1, 100);
+    softPWMUpdate(testPWM);
+    TEST_ASSERT_EQUAL_UINT16(TEST_PERIOD - 600, softPWMInterrupt(testPWM));
+    TEST_ASSERT_EQUAL_UINT16(100, softPWMInterrupt(testPWM));
+    TEST_ASSERT_EQUAL_UINT8(0b11, fakePort);
+
+    //Nothing is rebuilt if the duties are the same
+    softPWMSetOnTime(testPWM, 1, 100);
+    softPWMUpdate(testPWM);
+    TEST_ASSERT_FALSE(testPWM.pending);
+}
+
+static void test_softPWM_reloadTimer(void)
+{
+    //The returned interval is the one after the next, as the next has already been loaded into the timer
+    setup_softPWM(2, true);
+    softPWMSetOnTime(testPWM, 0, 200);
+    softPWMSetOnTime(testPWM, 1, 700);
+    softPWMUpdate(testPWM);
+    TEST_ASSERT_EQUAL_UINT16(500, softPWMInterrupt(testPWM)); //Start. Next is 200, then 500
+    TEST_ASSERT_EQUAL_UINT16(300, softPWMInterrupt(testPWM)); //200. Next is 500, then 300
+    TEST_ASSERT_EQUAL_UINT16(200, softPWMInterrupt(testPWM)); //700. Next is 300, then 200
+    TEST_ASSERT_EQUAL_UINT16(500, softPWMInterrupt(testPWM)); //Start
+}
+
+// Checks the on time of every channel is exact for 1 to 8 channels, and reports the interrupt cost per period
+static void test_softPWM_dutyAccuracy(void)
+{
+    static constexpr uint16_t periods = 20;
+    char msg[80];
+
+    for(uint8_t channels = 1; channels <= SOFT_PWM_MAX_CHANNELS; channels++)
+    {
+        setup_softPWM(channels, false);
+        for(uint8_t channel = 0; channel < channels; channel++)
+        {
+            //Spread over the period, including a shared duty when there are enough channels
+            uint16_t onTime = (channel == 7U) ? 111U : (uint16_t)(111U * (channel + 1U));
+            softPWMSetOnTime(testPWM, channel, onTime);
+        }
+        softPWMUpdate(testPWM);
+        softPWMRun run = runSoftPWM(periods);
+
+        for(uint8_t channel = 0; channel < channels; channel++)
+        {
+            TEST_ASSERT_EQUAL_UINT32((uint32_t)testPWM.onTime[channel] * periods, run.onTime[channel]);
+        }
+        //1 per distinct duty plus the start of each period
+        uint8_t edges = (channels == 8U) ? 7U : channels;
+        TEST_ASSERT_EQUAL_UINT32((uint32_t)(edges + 1U) * periods, run.interrupts);
+
+        sprintf_P(msg, PSTR("%" PRIu8 " channels: %" PRIu32 " interrupts, %" PRIu32 "uS per period"),
+            channels, run.interrupts / periods, run.interruptMicros / periods);
+        TEST_MESSAGE(msg);
+    }
+}
+
+void testSoftPWM(void)
+{
+    SET_UNITY_FILENAME() {
+        RUN_TEST_P(test_softPWM_edgeOrder);
+        RUN_TEST_P(test_softPWM_limits);
+        RUN_TEST_P(test_softPWM_inverted);
+        RUN_TEST_P(test_softPWM_full);
+        RUN_TEST_P(test_softPWM_dutyChange);
+        RUN_TEST_P(test_softPWM_reloadTimer);
+        RUN_TEST_P(test_softPWM_dutyAccuracy);
+    }
+}
@@ -1,6 +1,7 @@
 #include <Arduino.h>
 #include <unity.h>
 #include "schedule_calcs.h"
+#include "test_calcs_common.h"
 #include "../test_utils.h"
 
 static void nullIgnCallback(void) {};
@@ -74,6 +75,47 @@ void test_adjust_crank_angle_running()
     TEST_ASSERT_FALSE(schedule.endScheduleSetByDecoder);
 }
 
+static void test_refresh_ignition_end_angle(int endAngle, int crankAngle, uint16_t expectedAngle)
+{
+    auto counter = decltype(+IGN4_COUNTER){0};
+    auto compare = decltype(+IGN4_COMPARE){0};
+    IgnitionSchedule schedule(counter, compare, nullIgnCallback, nullIgnCallback);
+
+    setEngineSpeed(4000, 720);
+    schedule.Status = RUNNING;
+    schedule.duration = angleToTimeMicroSecPerDegree(45);
+    schedule.compare = 101;
+    schedule.counter = 100;
+
+    refreshIgnitionEndAngle(schedule, endAngle, crankAngle);
+
+    if (expectedAngle == 0U)
+    {
+      TEST_ASSERT_EQUAL(101, schedule.compare);
+    }
+    else
+    {
+      TEST_ASSERT_EQUAL(schedule.counter+uS_TO_TIMER_COMPARE(angleToTimeMicroSecPerDegree(expectedAngle)), schedule.compare);
+    }
+}
+
+void test_refresh_ignition_end_angle_ahead()
+{
+    test_refresh_ignition_end_angle(400, 380, 20);
+}
+
+void test_refresh_ignition_end_angle_across_zero()
+{
+    //The end angle is below the crank angle, so is in the next cycle
+    test_refresh_ignition_end_angle(5, 715, 10);
+}
+
+void test_refresh_ignition_end_angle_beyond_dwell()
+{
+    //The end has just passed, so is almost a whole cycle away. Never moved later than the dwell
+    test_refresh_ignition_end_angle(380, 400, 0);
+}
+
 void test_adjust_crank_angle()
 {
   SET_UNITY_FILENAME() {
@@ -81,5 +123,8 @@ void test_adjust_crank_angle()
     RUN_TEST(test_adjust_crank_angle_pending_below_minrevolutions);
     RUN_TEST(test_adjust_crank_angle_pending_above_minrevolutions);
     RUN_TEST(test_adjust_crank_angle_running);
+    RUN_TEST(test_refresh_ignition_end_angle_ahead);
+    RUN_TEST(test_refresh_ignition_end_angle_across_zero);
+    RUN_TEST(test_refresh_ignition_end_angle_beyond_dwell);
   }
 }
\ No newline at end of file
@@ -0,0 +1,380 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <math.h>
+#include "test_calcs_common.h"
+#include "schedule_calcs.h"
+#include "angleArming.h"
+#include "crankMaths.h"
+#include "decoders.h"
+#include "scheduler.h"
+#include "../test_utils.h"
+
+extern bool SetRevolutionTime(uint32_t revTime);
+extern volatile unsigned long toothLastToothTime;
+
+static void nullIgnCallback(void) { }
+
+void test_angle_arming_timeout(void)
+{
+    setEngineSpeed(6000, 360);
+
+    TEST_ASSERT_EQUAL_UINT32(angleToTimeMicroSecPerDegree(10), angleArmingTimeout(100, 90, 360, 30));
+    TEST_ASSERT_EQUAL_UINT32(angleToTimeMicroSecPerDegree(30), angleArmingTimeout(100, 70, 360, 30));
+    //Outside the window
+    TEST_ASSERT_EQUAL_UINT32(0, angleArmingTimeout(100, 60, 360, 30));
+    //The start has just passed, so is a whole revolution away
+    TEST_ASSERT_EQUAL_UINT32(0, angleArmingTimeout(100, 101, 360, 30));
+    //Across 0 degrees
+    TEST_ASSERT_EQUAL_UINT32(angleToTimeMicroSecPerDegree(15), angleArmingTimeout(5, 350, 360, 30));
+    TEST_ASSERT_EQUAL_UINT32(angleToTimeMicroSecPerDegree(25), angleArmingTimeout(5, 700, 720, 30));
+    //A start on the tooth is armed with the minimum timeout rather than one the timer could already have passed
+    TEST_ASSERT_EQUAL_UINT32(ANGLE_ARMING_MIN_TIMEOUT, angleArmingTimeout(100, 100, 360, 30));
+}
+
+// ---------------------------------------------------------------------------
+// Arming simulation
+//
+// A 36-1 crank wheel accelerating hard through 9000 RPM, with the coil charge start of a wasted spark channel in the
+// missing tooth gap. The decoder is modelled as the missing tooth decoder: the crank angle is the angle of the last
+// tooth plus the time since it converted at the RPM of the last revolution.
+//
+// Main loop arming: an artificially slow loop (LOOP_PERIOD) reads the crank angle and arms the channel LOOP_LATENCY
+// later, as the loop works through the other channels in between, using calculateIgnitionTimeout().
+// Interrupt arming: each tooth arms the channel from the tooth angle using angleArmingTimeout(), once per start.
+//
+// The timing error is the difference between the true crank angle when the coil starts charging and the start angle.
+// ---------------------------------------------------------------------------
+
+static constexpr float SIM_RPM = 9000.0f;
+static constexpr float SIM_RPM_ACCEL = 5000.0f; // RPM/s
+static constexpr uint8_t SIM_TEETH = 36;
+static constexpr uint16_t SIM_TOOTH_ANGLE = 360 / SIM_TEETH;
+static constexpr uint16_t SIM_REVOLUTIONS = 40;
+static constexpr uint16_t SIM_SETTLE_REVOLUTIONS = 2;
+static constexpr uint16_t SIM_START_ANGLE = 345;
+static constexpr uint8_t SIM_WINDOW = 30;
+static constexpr float LOOP_PERIOD = 5000.0f; // uS
+static constexpr float LOOP_LATENCY = 100.0f; // uS
+
+struct armingSimResult {
+    uint16_t maxError; // Largest timing error (0.01 degrees)
+    uint16_t fired;
+    uint16_t expected;
+};
+
+// Crank degrees turned in time uS
+static float simAngleAt(float time) {
+    const float speed = SIM_RPM * 6.0f / 1000000.0f; // deg/uS
+    const float accel = SIM_RPM_ACCEL * 6.0f / 1000000.0f / 1000000.0f; // deg/uS^2
+    return (speed * time) + (0.5f * accel * time * time);
+}
+
+// Time (uS) that the crank reaches angle degrees
+static float simTimeOf(float angle) {
+    const float speed = SIM_RPM * 6.0f / 1000000.0f;
+    const float accel = SIM_RPM_ACCEL * 6.0f / 1000000.0f / 1000000.0f;
+    return (sqrtf((speed * speed) + (2.0f * accel * angle)) - speed) / accel;
+}
+
+static armingSimResult runArmingSim(bool fromTooth) {
+    armingSimResult result = { 0, 0, 0 };
+    IgnitionSchedule schedule(IGN4_COUNTER, IGN4_COMPARE, nullIgnCallback, nullIgnCallback);
+    schedule.Status = OFF;
+    CRANK_ANGLE_MAX_IGN = 360;
+
+    const float settleTime = simTimeOf(SIM_SETTLE_REVOLUTIONS * 360.0f);
+    const float endTime = simTimeOf(SIM_REVOLUTIONS * 360.0f);
+    for(uint16_t revolution = SIM_SETTLE_REVOLUTIONS; revolution < SIM_REVOLUTIONS; revolution++) { result.expected++; }
+
+    uint32_t tooth = 1;
+    float lastToothTime = 0.0f;
+    uint16_t lastToothAngle = 0;
+    float lastToothOneTime = 0.0f;
+    float loopTime = LOOP_PERIOD / 2.0f;
+    bool pending = false;
+    bool armed = false;
+    float fireTime = 0.0f;
+    SetRevolutionTime((uint32_t)(60000000.0f / SIM_RPM));
+
+    while(true) {
+        //The missing tooth
+        if((tooth % SIM_TEETH) == (SIM_TEETH - 1U)) { tooth++; }
+        const float toothTime = simTimeOf((float)(tooth * SIM_TOOTH_ANGLE));
+        const bool fireNext = pending && (fireTime <= toothTime) && (fromTooth || (fireTime <= loopTime));
+        const bool toothNext = !fireNext && (fromTooth || (toothTime <= loopTime));
+        const float now = fireNext ? fireTime : (toothNext ? toothTime : loopTime);
+        if(now >= endTime) { break; }
+
+        if(fireNext) {
+            pending = false;
+            schedule.Status = OFF;
+            if(now >= settleTime) {
+                float error = fmodf(simAngleAt(now), 360.0f) - SIM_START_ANGLE;
+                if(error < -180.0f) { error += 360.0f; }
+                if(error > 180.0f) { error -= 360.0f; }
+                uint16_t errorCentiDegrees = (uint16_t)lroundf(fabsf(error) * 100.0f);
+                if(errorCentiDegrees > result.maxError) { result.maxError = errorCentiDegrees; }
+                result.fired++;
+            }
+        }
+        else if(toothNext) {
+            lastToothTime = toothTime;
+            lastToothAngle = (tooth * SIM_TOOTH_ANGLE) % 360U;
+            if(lastToothAngle == 0U) {
+                if(lastToothOneTime > 0.0f) { SetRevolutionTime((uint32_t)(toothTime - lastToothOneTime)); }
+                lastToothOneTime = toothTime;
+            }
+            tooth++;
+
+            if(fromTooth) {
+                uint32_t timeout = angleArmingTimeout(SIM_START_ANGLE, lastToothAngle, 360, SIM_WINDOW);
+                if(timeout == 0U) { armed = false; }
+                else if( (armed == false) && (pending == false) ) {
+                    fireTime = now + timeout;
+                    pending = true;
+                    armed = true;
+                }
+            }
+        }
+        else {
+            if(pending == false) {
+                int crankAngle = ignitionLimits(lastToothAngle + timeToAngleDegPerMicroSec((uint32_t)(now - lastToothTime)));
+                uint32_t timeout = calculateIgnitionTimeout(schedule, SIM_START_ANGLE, 0, crankAngle);
+                if(timeout > 0U) {
+                    fireTime = now + LOOP_LATENCY + timeout;
+                    pending = true;
+                    schedule.Status = PENDING;
+                }
+            }
+            loopTime += LOOP_PERIOD;
+        }
+    }
+    return result;
+}
+
+void test_angle_arming_simulation(void)
+{
+    char msg[96];
+    armingSimResult loopResult = runArmingSim(false);
+    armingSimResult toothResult = runArmingSim(true);
+
+    sprintf_P(msg, PSTR("Main loop arming: max error %" PRIu16 ".%02" PRIu16 " deg, %" PRIu16 "/%" PRIu16 " fired"),
+        loopResult.maxError / 100U, loopResult.maxError % 100U, loopResult.fired, loopResult.expected);
+    TEST_MESSAGE(msg);
+    sprintf_P(msg, PSTR("Interrupt arming: max error %" PRIu16 ".%02" PRIu16 " deg, %" PRIu16 "/%" PRIu16 " fired"),
+        toothResult.maxError / 100U, toothResult.maxError % 100U, toothResult.fired, toothResult.expected);
+    TEST_MESSAGE(msg);
+
+    //Arming from the tooth before the start fires every start, to well within a degree
+    TEST_ASSERT_EQUAL_UINT16(toothResult.expected, toothResult.fired);
+    TEST_ASSERT_LESS_THAN_UINT16(100, toothResult.maxError);
+    TEST_ASSERT_LESS_THAN_UINT16(loopResult.maxError, toothResult.maxError);
+}
+
+// ---------------------------------------------------------------------------
+// Arming from the trigger interrupt
+//
+// A 36-1 crank wheel at 6000 RPM is turned through decoderPrimaryISR() with the missing tooth decoder, which arms the
+// schedules through armSchedulesAtTooth(). Positions are counted in teeth from tooth #1 (0 degrees), position 35 of each
+// revolution is the missing tooth. After each tooth any schedule that was armed is recorded and then turned off again
+// without firing, so that arming the same start again from a later tooth would also be counted.
+// ---------------------------------------------------------------------------
+
+#define TOOTH_ARMING_TEETH 36U
+#define TOOTH_ARMING_REV_TIME 10000UL //uS per revolution
+#define TOOTH_ARMING_SETTLE (3U * TOOTH_ARMING_TEETH) //Positions to turn through to get sync and measure every tooth gap, including the missing tooth
+
+struct toothArmingCount {
+    uint8_t armed;        // Times the schedule was armed
+    uint16_t toothAngle;  // Angle of the tooth that last armed it
+    uint32_t timeout;     // Timer ticks to the start when it was last armed
+    unsigned long duration; // Duration it was last armed with
+};
+
+static uint16_t armingPosition;
+static toothArmingCount ignitionArming;
+static toothArmingCount fuelArming;
+
+//Arming always sets the duration, which is cleared before each tooth
+template <typename schedule_t>
+static void recordArming(schedule_t &schedule, toothArmingCount &count)
+{
+    if(schedule.duration != 0U)
+    {
+        count.timeout = (COMPARE_TYPE)(schedule.startCompare - schedule.counter);
+        count.duration = schedule.duration;
+        count.toothAngle = (armingPosition % TOOTH_ARMING_TEETH) * (360U / TOOTH_ARMING_TEETH);
+        count.armed++;
+        schedule.pTimerDisable();
+        schedule.Status = OFF;
+    }
+    schedule.duration = 0;
+}
+
+static void turnWheelTo(uint16_t endPosition)
+{
+    for(; armingPosition < endPosition; armingPosition++)
+    {
+        delayMicroseconds(TOOTH_ARMING_REV_TIME / TOOTH_ARMING_TEETH);
+        if( (armingPosition % TOOTH_ARMING_TEETH) != (TOOTH_ARMING_TEETH - 1U) )
+        {
+            ignitionSchedule1.duration = 0;
+            fuelSchedule1.duration = 0;
+            decoderPrimaryISR();
+            recordArming(ignitionSchedule1, ignitionArming);
+            recordArming(fuelSchedule1, fuelArming);
+        }
+    }
+}
+
+//Fills both target buffers, so that the next publish doesn't bring back older targets
+static void setToothArmingTargets(uint16_t ignitionAngle, uint16_t dwell, uint16_t fuelAngle, uint16_t pulseWidth)
+{
+    for(uint8_t buffer = 0; buffer < 2U; buffer++)
+    {
+        setIgnitionArmingTarget(IGN1_CMD_BIT, (dwell > 0U), ignitionAngle, dwell);
+        setFuelArmingTarget(INJ1_CMD_BIT, (pulseWidth > 0U), fuelAngle, pulseWidth);
+        publishArmingTargets();
+    }
+}
+
+static void resetArmingCounts(void)
+{
+    memset(&ignitionArming, 0, sizeof(ignitionArming));
+    memset(&fuelArming, 0, sizeof(fuelArming));
+}
+
+static void setup_tooth_arming(uint8_t window)
+{
+    configPage4.triggerTeeth = TOOTH_ARMING_TEETH;
+    configPage4.triggerMissingTeeth = 1;
+    configPage4.TrigSpeed = CRANK_SPEED;
+    configPage4.trigPatternSec = SEC_TRIGGER_SINGLE;
+    configPage4.triggerAngle = 0;
+    configPage4.sparkMode = IGN_MODE_WASTED;
+    configPage2.injLayout = INJ_PAIRED;
+    configPage2.strokes = FOUR_STROKE;
+    configPage2.perToothIgn = false;
+    triggerSetup_missingTooth();
+    BIT_SET(decoderState, BIT_DECODER_UNIFORM_TEETH);
+    triggerHandler = triggerPri_missingTooth;
+    CRANK_ANGLE_MAX_IGN = 360;
+    CRANK_ANGLE_MAX_INJ = 360;
+
+    toothLastToothTime = 0;
+    currentStatus.hasSync = false;
+    BIT_CLEAR(currentStatus.status3, BIT_STATUS3_HALFSYNC);
+    SetRevolutionTime(TOOTH_ARMING_REV_TIME);
+
+    initialiseSchedulers();
+    resetAngleArmingToothGap();
+    configPage15.angleArming = true;
+    configPage15.angleArmWindow = window;
+    armingPosition = 0;
+    resetArmingCounts();
+}
+
+static void teardown_tooth_arming(void)
+{
+    setToothArmingTargets(0, 0, 0, 0);
+    stopAngleArming();
+    resetAngleArmingToothGap();
+    configPage15.angleArming = false;
+    BIT_CLEAR(decoderState, BIT_DECODER_UNIFORM_TEETH);
+    initialiseSchedulers();
+}
+
+static void assertArming(const toothArmingCount &count, uint8_t armed, uint16_t toothAngle, uint16_t startAngle, unsigned long duration)
+{
+    TEST_ASSERT_EQUAL_UINT8(armed, count.armed);
+    TEST_ASSERT_EQUAL_UINT16(toothAngle, count.toothAngle);
+    TEST_ASSERT_EQUAL_UINT32(duration, count.duration);
+    //Less the time that the decoder and the arming have taken since the tooth
+    TEST_ASSERT_UINT32_WITHIN(uS_TO_TIMER_COMPARE(angleToTimeMicroSecPerDegree(5)), uS_TO_TIMER_COMPARE(angleToTimeMicroSecPerDegree(startAngle - toothAngle)), count.timeout);
+}
+
+//Each start is armed exactly once per revolution, from the first tooth inside the window
+void test_angle_arming_once_per_window(void)
+{
+    setup_tooth_arming(30);
+    setToothArmingTargets(300, 1000, 200, 3000);
+
+    turnWheelTo(TOOTH_ARMING_SETTLE);
+    TEST_ASSERT_TRUE(currentStatus.hasSync);
+    resetArmingCounts();
+    turnWheelTo(TOOTH_ARMING_SETTLE + (4U * TOOTH_ARMING_TEETH));
+
+    assertArming(ignitionArming, 4, 270, 300, 1000);
+    assertArming(fuelArming, 4, 170, 200, 3000);
+    teardown_tooth_arming();
+}
+
+//A schedule that is still PENDING (Armed by the main loop) when its start enters the window is left alone for that start
+void test_angle_arming_pending_skip(void)
+{
+    setup_tooth_arming(30);
+    setToothArmingTargets(300, 1000, 0, 0);
+
+    turnWheelTo(TOOTH_ARMING_SETTLE + 27U);
+    resetArmingCounts();
+    ignitionSchedule1.Status = PENDING;
+    turnWheelTo(TOOTH_ARMING_SETTLE + 28U);
+    TEST_ASSERT_EQUAL_UINT8(0, ignitionArming.armed);
+    TEST_ASSERT_EQUAL(PENDING, ignitionSchedule1.Status);
+
+    //Once the main loop's schedule has run, the rest of the window still doesn't arm it again
+    ignitionSchedule1.Status = OFF;
+    turnWheelTo(TOOTH_ARMING_SETTLE + TOOTH_ARMING_TEETH);
+    TEST_ASSERT_EQUAL_UINT8(0, ignitionArming.armed);
+
+    //The next start is armed as normal
+    turnWheelTo(TOOTH_ARMING_SETTLE + (2U * TOOTH_ARMING_TEETH));
+    assertArming(ignitionArming, 1, 270, 300, 1000);
+    teardown_tooth_arming();
+}
+
+//Targets set by the main loop are only used by the interrupt once they are published
+void test_angle_arming_publish_swap(void)
+{
+    setup_tooth_arming(30);
+    setToothArmingTargets(300, 1000, 0, 0);
+    turnWheelTo(TOOTH_ARMING_SETTLE);
+
+    resetArmingCounts();
+    setIgnitionArmingTarget(IGN1_CMD_BIT, true, 200, 2000);
+    turnWheelTo(TOOTH_ARMING_SETTLE + TOOTH_ARMING_TEETH);
+    assertArming(ignitionArming, 1, 270, 300, 1000);
+
+    resetArmingCounts();
+    publishArmingTargets();
+    turnWheelTo(TOOTH_ARMING_SETTLE + (2U * TOOTH_ARMING_TEETH));
+    assertArming(ignitionArming, 1, 170, 200, 2000);
+    teardown_tooth_arming();
+}
+
+//A start in the missing tooth gap is further than a small window from every tooth. The window is widened to the gap (20 degrees)
+void test_angle_arming_gap_window(void)
+{
+    setup_tooth_arming(5);
+    setToothArmingTargets(355, 1000, 0, 0);
+
+    turnWheelTo(TOOTH_ARMING_SETTLE);
+    TEST_ASSERT_EQUAL_UINT16(20, getAngleArmingWindow());
+    resetArmingCounts();
+    turnWheelTo(TOOTH_ARMING_SETTLE + (4U * TOOTH_ARMING_TEETH));
+    assertArming(ignitionArming, 4, 340, 355, 1000);
+    teardown_tooth_arming();
+}
+
+void test_angle_arming()
+{
+  SET_UNITY_FILENAME() {
+
+    RUN_TEST(test_angle_arming_timeout);
+    RUN_TEST(test_angle_arming_simulation);
+    RUN_TEST(test_angle_arming_once_per_window);
+    RUN_TEST(test_angle_arming_pending_skip);
+    RUN_TEST(test_angle_arming_publish_swap);
+    RUN_TEST(test_angle_arming_gap_window);
+  }
+}
@@ -6,6 +6,7 @@
 extern void test_calc_ign_timeout();
 extern void test_calc_inj_timeout();
 extern void test_adjust_crank_angle();
+extern void test_angle_arming();
 
 void setup()
 {
@@ -19,6 +20,7 @@ void setup()
   test_calc_ign_timeout();
   test_calc_inj_timeout();
   test_adjust_crank_angle();
+  test_angle_arming();
   
   UNITY_END(); // stop unit testing
 
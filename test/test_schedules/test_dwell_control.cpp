@@ -0,0 +1,108 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "../test_utils.h"
+#include "scheduler.h"
+#include "dwellControl.h"
+
+#define TIMEOUT 1000
+#define DWELL 4000
+#define SPARKS 12
+#define DELTA 40
+
+static void nullCallback(void) { }
+
+// Latency model: the spark is wanted TIMEOUT + DWELL from when it is scheduled, and is held there by the end angle
+// refresh. The start is armed latency uS later than asked for (Eg from a crank angle that is already old), less the
+// trim, so the coil only gets DWELL - latency + trim.
+static int16_t runSpark(IgnitionSchedule &schedule, uint8_t channel, int16_t latency)
+{
+    const uint32_t sparkTime = micros() + TIMEOUT + DWELL;
+    setIgnitionSchedule(schedule, TIMEOUT + latency - getDwellTrim(channel), getTrimmedDwell(channel));
+    while(schedule.Status != RUNNING) /*Wait*/ ;
+    refreshIgnitionSchedule(schedule, sparkTime - micros());
+    while(schedule.Status != OFF) /*Wait*/ ;
+
+    updateDwellTrims(DWELL);
+    return currentStatus.dwellError[channel];
+}
+
+static void setup_dwell_control(IgnitionSchedule &schedule)
+{
+    initialiseSchedulers();
+    schedule.pStartCallback = nullCallback;
+    schedule.pEndCallback = nullCallback;
+    maxIgnOutputs = 4;
+    currentStatus.dwell = DWELL;
+    configPage15.dwellTrimGain = 50;
+    configPage15.dwellTrimLimit = 20; //2ms
+
+    //Discard any spark from a previous test
+    updateDwellTrims(DWELL);
+    resetDwellTrims();
+}
+
+//The error is the full latency on the first spark, and is trimmed out over the following sparks
+static void test_dwell_control_converges(IgnitionSchedule &schedule, uint8_t channel, int16_t latency)
+{
+    setup_dwell_control(schedule);
+
+    int16_t error = runSpark(schedule, channel, latency);
+    TEST_ASSERT_INT16_WITHIN(DELTA, latency, error);
+
+    for(uint8_t spark = 1; spark < SPARKS; spark++)
+    {
+        int16_t lastError = error;
+        error = runSpark(schedule, channel, latency);
+        TEST_ASSERT_LESS_OR_EQUAL_INT16(abs(lastError) + DELTA, abs(error));
+    }
+    TEST_ASSERT_INT16_WITHIN(DELTA, 0, error);
+    TEST_ASSERT_INT16_WITHIN(DELTA, latency, getDwellTrim(channel));
+}
+
+static void test_dwell_control_late_start(void)
+{
+    test_dwell_control_converges(ignitionSchedule1, IGN1_CMD_BIT, 600);
+    test_dwell_control_converges(ignitionSchedule4, IGN4_CMD_BIT, 1200);
+}
+
+//A start that is early gives too much dwell, which is trimmed off
+static void test_dwell_control_early_start(void)
+{
+    test_dwell_control_converges(ignitionSchedule2, IGN2_CMD_BIT, -500);
+}
+
+//The trim stops at the limit, leaving the rest of the error
+static void test_dwell_control_limit(void)
+{
+    setup_dwell_control(ignitionSchedule3);
+    configPage15.dwellTrimLimit = 10; //1ms
+
+    int16_t error = 0;
+    for(uint8_t spark = 0; spark < SPARKS; spark++) { error = runSpark(ignitionSchedule3, IGN3_CMD_BIT, 1500); }
+    TEST_ASSERT_EQUAL_INT16(1000, getDwellTrim(IGN3_CMD_BIT));
+    TEST_ASSERT_INT16_WITHIN(DELTA, 500, error);
+}
+
+//Each channel only uses its own sparks
+static void test_dwell_control_channels(void)
+{
+    setup_dwell_control(ignitionSchedule1);
+    ignitionSchedule2.pStartCallback = nullCallback;
+    ignitionSchedule2.pEndCallback = nullCallback;
+
+    for(uint8_t spark = 0; spark < SPARKS; spark++) { runSpark(ignitionSchedule1, IGN1_CMD_BIT, 800); }
+    TEST_ASSERT_INT16_WITHIN(DELTA, 800, getDwellTrim(IGN1_CMD_BIT));
+    TEST_ASSERT_EQUAL_INT16(0, getDwellTrim(IGN2_CMD_BIT));
+    TEST_ASSERT_EQUAL_INT16(0, currentStatus.dwellError[IGN2_CMD_BIT]);
+    TEST_ASSERT_EQUAL_UINT16(DWELL, getTrimmedDwell(IGN2_CMD_BIT));
+}
+
+void test_dwell_control(void)
+{
+  SET_UNITY_FILENAME() {
+    RUN_TEST_P(test_dwell_control_late_start);
+    RUN_TEST_P(test_dwell_control_early_start);
+    RUN_TEST_P(test_dwell_control_limit);
+    RUN_TEST_P(test_dwell_control_channels);
+  }
+}
@@ -0,0 +1,139 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "../test_utils.h"
+#include "scheduler.h"
+
+#define TIMEOUT 1000
+#define DURATION 3000
+#define REFRESH 1000
+#define DELTA 20
+
+static uint32_t start_time, end_time;
+static void startCallback(void) { start_time = micros(); }
+static void endCallback(void) { end_time = micros(); }
+
+static void startIgnitionSchedule(IgnitionSchedule &schedule)
+{
+    initialiseSchedulers();
+    schedule.pStartCallback = startCallback;
+    schedule.pEndCallback = endCallback;
+    setIgnitionSchedule(schedule, TIMEOUT, DURATION);
+}
+
+//A refresh while the coil is charging moves the spark to the new time
+void test_ignition_refresh_running(IgnitionSchedule &schedule)
+{
+    startIgnitionSchedule(schedule);
+    while(schedule.Status != RUNNING) /*Wait*/ ;
+    uint32_t refresh_time = micros();
+    refreshIgnitionSchedule(schedule, REFRESH);
+    while(schedule.Status != OFF) /*Wait*/ ;
+    TEST_ASSERT_UINT32_WITHIN(DELTA, REFRESH, end_time - refresh_time);
+}
+
+//A refresh too close to now is ignored, as the compare could be passed before it is set. The spark stays where it was scheduled
+void test_ignition_refresh_threshold(IgnitionSchedule &schedule)
+{
+    startIgnitionSchedule(schedule);
+    while(schedule.Status != RUNNING) /*Wait*/ ;
+    refreshIgnitionSchedule(schedule, IGNITION_REFRESH_THRESHOLD);
+    while(schedule.Status != OFF) /*Wait*/ ;
+    TEST_ASSERT_UINT32_WITHIN(DELTA, DURATION, end_time - start_time);
+}
+
+//A refresh before the coil has started charging is ignored, so it can't move the start
+void test_ignition_refresh_pending(IgnitionSchedule &schedule)
+{
+    startIgnitionSchedule(schedule);
+    refreshIgnitionSchedule(schedule, REFRESH);
+    TEST_ASSERT_EQUAL(PENDING, schedule.Status);
+    while(schedule.Status != OFF) /*Wait*/ ;
+    TEST_ASSERT_UINT32_WITHIN(DELTA, DURATION, end_time - start_time);
+}
+
+void test_ignition_refresh_ign1(void)
+{
+    test_ignition_refresh_running(ignitionSchedule1);
+    test_ignition_refresh_threshold(ignitionSchedule1);
+    test_ignition_refresh_pending(ignitionSchedule1);
+}
+
+void test_ignition_refresh_ign2(void)
+{
+    test_ignition_refresh_running(ignitionSchedule2);
+    test_ignition_refresh_threshold(ignitionSchedule2);
+    test_ignition_refresh_pending(ignitionSchedule2);
+}
+
+void test_ignition_refresh_ign3(void)
+{
+    test_ignition_refresh_running(ignitionSchedule3);
+    test_ignition_refresh_threshold(ignitionSchedule3);
+    test_ignition_refresh_pending(ignitionSchedule3);
+}
+
+void test_ignition_refresh_ign4(void)
+{
+    test_ignition_refresh_running(ignitionSchedule4);
+    test_ignition_refresh_threshold(ignitionSchedule4);
+    test_ignition_refresh_pending(ignitionSchedule4);
+}
+
+#if IGN_CHANNELS >= 5
+void test_ignition_refresh_ign5(void)
+{
+    test_ignition_refresh_running(ignitionSchedule5);
+    test_ignition_refresh_threshold(ignitionSchedule5);
+    test_ignition_refresh_pending(ignitionSchedule5);
+}
+#endif
+
+#if IGN_CHANNELS >= 6
+void test_ignition_refresh_ign6(void)
+{
+    test_ignition_refresh_running(ignitionSchedule6);
+    test_ignition_refresh_threshold(ignitionSchedule6);
+    test_ignition_refresh_pending(ignitionSchedule6);
+}
+#endif
+
+#if IGN_CHANNELS >= 7
+void test_ignition_refresh_ign7(void)
+{
+    test_ignition_refresh_running(ignitionSchedule7);
+    test_ignition_refresh_threshold(ignitionSchedule7);
+    test_ignition_refresh_pending(ignitionSchedule7);
+}
+#endif
+
+#if IGN_CHANNELS >= 8
+void test_ignition_refresh_ign8(void)
+{
+    test_ignition_refresh_running(ignitionSchedule8);
+    test_ignition_refresh_threshold(ignitionSchedule8);
+    test_ignition_refresh_pending(ignitionSchedule8);
+}
+#endif
+
+void test_ignition_refresh(void)
+{
+  SET_UNITY_FILENAME() {
+
+    RUN_TEST(test_ignition_refresh_ign1);
+    RUN_TEST(test_ignition_refresh_ign2);
+    RUN_TEST(test_ignition_refresh_ign3);
+    RUN_TEST(test_ignition_refresh_ign4);
+#if IGN_CHANNELS >= 5
+    RUN_TEST(test_ignition_refresh_ign5);
+#endif
+#if IGN_CHANNELS >= 6
+    RUN_TEST(test_ignition_refresh_ign6);
+#endif
+#if IGN_CHANNELS >= 7
+    RUN_TEST(test_ignition_refresh_ign7);
+#endif
+#if IGN_CHANNELS >= 8
+    RUN_TEST(test_ignition_refresh_ign8);
+#endif
+  }
+}
@@ -0,0 +1,143 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "../test_utils.h"
+#include "scheduler.h"
+
+#define TIMEOUT 200
+#define DURATION 1000
+#define HOLDOFF 600
+#define DELTA 40
+
+static void nullCallback(void) { }
+
+static void setup_schedule_stats(void)
+{
+    initialiseSchedulers();
+    BIT_CLEAR(currentStatus.engine, BIT_ENGINE_CRANK);
+    resetScheduleStats();
+}
+
+static void runFuelSchedule(FuelSchedule &schedule, uint16_t holdOff)
+{
+    setFuelSchedule(schedule, TIMEOUT, DURATION);
+    if(holdOff > 0)
+    {
+        //Keep the schedule interrupt from running until after its start compare, the same as a long running interrupt would
+        noInterrupts();
+        delayMicroseconds(holdOff);
+        interrupts();
+    }
+    while(schedule.Status != OFF) /*Wait*/ ;
+}
+
+//A schedule that starts on time isn't counted
+static void test_schedule_stats_on_time(void)
+{
+    setup_schedule_stats();
+    runFuelSchedule(fuelSchedule1, 0);
+
+    schedule_stats_t stats;
+    TEST_ASSERT_TRUE(getFuelScheduleStats(0, stats));
+    TEST_ASSERT_EQUAL_UINT16(0, stats.lateStarts);
+    TEST_ASSERT_EQUAL_UINT16(0, stats.skipped);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT16(SCHEDULE_LATE_THRESHOLD, stats.maxLate);
+}
+
+//A start that is held off past its compare is counted, and the max lateness is how long it was held off for
+static void test_schedule_stats_late_start(void)
+{
+    setup_schedule_stats();
+    runFuelSchedule(fuelSchedule2, HOLDOFF);
+    runFuelSchedule(fuelSchedule2, HOLDOFF / 2);
+
+    schedule_stats_t stats;
+    TEST_ASSERT_TRUE(getFuelScheduleStats(1, stats));
+    TEST_ASSERT_EQUAL_UINT16(2, stats.lateStarts);
+    TEST_ASSERT_UINT16_WITHIN(DELTA, HOLDOFF - TIMEOUT, stats.maxLate);
+
+    //Other channels are not affected
+    TEST_ASSERT_TRUE(getFuelScheduleStats(0, stats));
+    TEST_ASSERT_EQUAL_UINT16(0, stats.lateStarts);
+
+    resetScheduleStats();
+    TEST_ASSERT_TRUE(getFuelScheduleStats(1, stats));
+    TEST_ASSERT_EQUAL_UINT16(0, stats.lateStarts);
+    TEST_ASSERT_EQUAL_UINT16(0, stats.maxLate);
+}
+
+//A spark that is moved before the end of the scheduled dwell is counted as truncated
+static void test_schedule_stats_truncated(void)
+{
+    setup_schedule_stats();
+    ignitionSchedule1.pStartCallback = nullCallback;
+    ignitionSchedule1.pEndCallback = nullCallback;
+
+    setIgnitionSchedule(ignitionSchedule1, TIMEOUT, DURATION);
+    while(ignitionSchedule1.Status != OFF) /*Wait*/ ;
+
+    setIgnitionSchedule(ignitionSchedule1, TIMEOUT, DURATION * 3U);
+    while(ignitionSchedule1.Status != RUNNING) /*Wait*/ ;
+    refreshIgnitionSchedule(ignitionSchedule1, DURATION);
+    while(ignitionSchedule1.Status != OFF) /*Wait*/ ;
+
+    schedule_stats_t stats;
+    TEST_ASSERT_TRUE(getIgnitionScheduleStats(0, stats));
+    TEST_ASSERT_EQUAL_UINT16(1, stats.truncated);
+    TEST_ASSERT_EQUAL_UINT16(0, stats.lateStarts);
+}
+
+//An event queued while the schedule is running, but that should have started before the running event ended, is counted as skipped
+static void test_schedule_stats_skipped(void)
+{
+    setup_schedule_stats();
+    ignitionSchedule2.pStartCallback = nullCallback;
+    ignitionSchedule2.pEndCallback = nullCallback;
+
+    //Queued to start after the running event ends
+    setIgnitionSchedule(ignitionSchedule2, TIMEOUT, DURATION);
+    while(ignitionSchedule2.Status != RUNNING) /*Wait*/ ;
+    setIgnitionSchedule(ignitionSchedule2, DURATION * 2U, DURATION);
+    while(ignitionSchedule2.Status != PENDING) /*Wait*/ ;
+    while(ignitionSchedule2.Status != OFF) /*Wait*/ ;
+
+    schedule_stats_t stats;
+    TEST_ASSERT_TRUE(getIgnitionScheduleStats(1, stats));
+    TEST_ASSERT_EQUAL_UINT16(0, stats.skipped);
+
+    //Queued to start before the running event ends
+    setIgnitionSchedule(ignitionSchedule2, TIMEOUT, DURATION);
+    while(ignitionSchedule2.Status != RUNNING) /*Wait*/ ;
+    setIgnitionSchedule(ignitionSchedule2, TIMEOUT, DURATION);
+    while(ignitionSchedule2.Status != PENDING) /*Wait*/ ;
+
+    TEST_ASSERT_TRUE(getIgnitionScheduleStats(1, stats));
+    TEST_ASSERT_EQUAL_UINT16(1, stats.skipped);
+
+    //The skipped event won't start until the timer wraps around
+    initialiseSchedulers();
+}
+
+//The totals for the output channels only include the channels that are in use
+static void test_schedule_stats_status(void)
+{
+    setup_schedule_stats();
+    maxInjOutputs = 2;
+    runFuelSchedule(fuelSchedule1, HOLDOFF);
+    runFuelSchedule(fuelSchedule2, HOLDOFF);
+    runFuelSchedule(fuelSchedule3, HOLDOFF);
+    updateScheduleStatus();
+
+    TEST_ASSERT_EQUAL_UINT16(2, currentStatus.schedLateStarts);
+    TEST_ASSERT_UINT16_WITHIN(DELTA, HOLDOFF - TIMEOUT, currentStatus.schedMaxLate);
+}
+
+void test_schedule_stats(void)
+{
+  SET_UNITY_FILENAME() {
+    RUN_TEST_P(test_schedule_stats_on_time);
+    RUN_TEST_P(test_schedule_stats_late_start);
+    RUN_TEST_P(test_schedule_stats_truncated);
+    RUN_TEST_P(test_schedule_stats_skipped);
+    RUN_TEST_P(test_schedule_stats_status);
+  }
+}
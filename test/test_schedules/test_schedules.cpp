@@ -22,6 +22,9 @@ void setup()
   //test_status_running_to_off();
   test_accuracy_timeout();
   test_accuracy_duration();
+  test_ignition_refresh();
+  test_dwell_control();
+  test_schedule_stats();
   
   UNITY_END(); // stop unit testing
 
@@ -9,6 +9,9 @@ void test_status_running_to_off(void);
 void test_status_running_to_pending(void);
 void test_accuracy_timeout(void);
 void test_accuracy_duration(void);
+void test_ignition_refresh(void);
+void test_dwell_control(void);
+void test_schedule_stats(void);
 
 void test_accuracy_timeout(void);
 
@@ -4,6 +4,7 @@
 
 #include "tests_tables.h"
 #include "test_table2d.h"
+#include "test_table3d_overlay.h"
 
 #define UNITY_EXCLUDE_DETAILS
 
@@ -21,6 +22,7 @@ void setup()
 
     testTables();
     testTable2d();
+    testTable3dOverlay();
 
     UNITY_END(); // stop unit testing
 
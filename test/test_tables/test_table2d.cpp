@@ -145,6 +145,29 @@ void test_table2d_all_decrementing(void)
     }
 }
 
+void test_table2d_lastBin(void)
+{
+    setup_test_subjects();
+    table2d_u8_u8.lastXMax = 0;
+
+    //Between the 4th and 5th bins
+    TEST_ASSERT_EQUAL(147, table2D_getValue(&table2d_u8_u8, 114));
+    TEST_ASSERT_EQUAL(4, table2d_u8_u8.lastXMax);
+
+    //Same bin again, at a different X so that the cached output isn't used
+    TEST_ASSERT_EQUAL(129, table2D_getValue(&table2d_u8_u8, 126));
+    TEST_ASSERT_EQUAL(4, table2d_u8_u8.lastXMax);
+
+    //Moving to another bin
+    TEST_ASSERT_EQUAL(41, table2D_getValue(&table2d_u8_u8, 205));
+    TEST_ASSERT_EQUAL(7, table2d_u8_u8.lastXMax);
+
+    //A last bin that is outside of the table (Eg the table has been made smaller) must be ignored
+    table2d_u8_u8.xSize = 5;
+    table2d_u8_u8.lastXMax = 7;
+    TEST_ASSERT_EQUAL(183, table2D_getValue(&table2d_u8_u8, 80));
+    TEST_ASSERT_EQUAL(3, table2d_u8_u8.lastXMax);
+}
 
 void testTable2d()
 {
@@ -155,5 +178,6 @@ void testTable2d()
     RUN_TEST(test_table2dLookup_overMax);
     RUN_TEST(test_table2dLookup_underMin);
     RUN_TEST(test_table2d_all_decrementing); 
+    RUN_TEST(test_table2d_lastBin);
   }
 }
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include <unity.h>
+#include "test_table3d_overlay.h"
+#include "table3d.h"
+#include "../test_utils.h"
+
+TEST_DATA_P table3d_axis_t overlayRpmAxis[] = { 1000, 2000, 3000, 4000 };
+TEST_DATA_P table3d_axis_t overlayLoadAxis[] = { 25, 50, 75, 100 };
+TEST_DATA_P table3d_value_t overlayValues[] = {
+  100, 100, 100, 100,
+  100, 100, 100, 100,
+  100, 100, 100, 200,
+  100, 100, 100, 200,
+};
+
+static table3d4RpmLoad overlayTable1;
+static table3d4RpmLoad overlayTable2;
+
+//The TS index of the cell at 2000 RPM and 50 load
+static constexpr table3d_dim_t OVERLAY_CELL = 5;
+
+static void setup_overlay_tables(void)
+{
+  clearTableOverlays();
+  populate_table_P(overlayTable1, overlayRpmAxis, overlayLoadAxis, overlayValues);
+  populate_table_P(overlayTable2, overlayRpmAxis, overlayLoadAxis, overlayValues);
+}
+
+static void test_overlay_lookup(void)
+{
+  setup_overlay_tables();
+  //Look the cell up first, so that the cached value has to be discarded
+  TEST_ASSERT_EQUAL_UINT8(100, get3DTableValue(&overlayTable1, 50, 2000));
+
+  TEST_ASSERT_TRUE(setTableOverlay(&overlayTable1, 2, OVERLAY_CELL, 20));
+  TEST_ASSERT_EQUAL_UINT8(1, tableOverlayCount);
+  TEST_ASSERT_EQUAL_INT8(20, getTableOverlay(&overlayTable1, OVERLAY_CELL));
+  TEST_ASSERT_EQUAL_UINT8(120, get3DTableValue(&overlayTable1, 50, 2000));
+  //Half way to the next cell gets half the delta
+  TEST_ASSERT_EQUAL_UINT8(110, get3DTableValue(&overlayTable1, 50, 1500));
+  TEST_ASSERT_EQUAL_UINT8(110, get3DTableValue(&overlayTable1, 62, 2000));
+  TEST_ASSERT_EQUAL_UINT8(100, get3DTableValue(&overlayTable1, 50, 3000));
+  //The table itself and other tables are not changed
+  TEST_ASSERT_EQUAL_UINT8(100, overlayTable1.values.value_at(OVERLAY_CELL));
+  TEST_ASSERT_EQUAL_INT8(0, getTableOverlay(&overlayTable2, OVERLAY_CELL));
+  TEST_ASSERT_EQUAL_UINT8(100, get3DTableValue(&overlayTable2, 50, 2000));
+}
+
+static void test_overlay_lookup_context(void)
+{
+  //Interpolating via a lookup context must give the same result as a regular lookup
+  setup_overlay_tables();
+  setTableOverlay(&overlayTable1, 2, OVERLAY_CELL, -30);
+  setTableOverlay(&overlayTable1, 2, OVERLAY_CELL + 5U, 12);
+
+  static constexpr table3d_axis_t loads[] = { 10, 37, 50, 62, 75, 110 };
+  static constexpr table3d_axis_t rpms[] = { 500, 1500, 2000, 2500, 3500, 4500 };
+  for (uint8_t loadIdx=0; loadIdx<_countof(loads); ++loadIdx)
+  {
+    for (uint8_t rpmIdx=0; rpmIdx<_countof(rpms); ++rpmIdx)
+    {
+      table3DLookupContext lookup;
+      get3DTableLookupContext(&overlayTable2, loads[loadIdx], rpms[rpmIdx], lookup);
+      TEST_ASSERT_EQUAL(get3DTableValue(&overlayTable1, loads[loadIdx], rpms[rpmIdx]), interpolate3DTableValue(&overlayTable1, lookup));
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT8(70, get3DTableValue(&overlayTable1, 50, 2000));
+}
+
+static void test_overlay_clamp(void)
+{
+  setup_overlay_tables();
+  setTableOverlay(&overlayTable1, 2, OVERLAY_CELL, -127);
+  setTableOverlay(&overlayTable1, 2, 15, 127);
+
+  TEST_ASSERT_EQUAL_UINT8(0, get3DTableValue(&overlayTable1, 50, 2000));
+  TEST_ASSERT_EQUAL_UINT8(255, get3DTableValue(&overlayTable1, 100, 4000));
+}
+
+static void test_overlay_remove(void)
+{
+  setup_overlay_tables();
+  setTableOverlay(&overlayTable1, 2, OVERLAY_CELL, 20);
+  setTableOverlay(&overlayTable2, 3, OVERLAY_CELL, 10);
+  TEST_ASSERT_EQUAL_UINT8(120, get3DTableValue(&overlayTable1, 50, 2000));
+
+  //A delta of 0 removes the cell, leaving the others
+  TEST_ASSERT_TRUE(setTableOverlay(&overlayTable1, 2, OVERLAY_CELL, 0));
+  TEST_ASSERT_EQUAL_UINT8(1, tableOverlayCount);
+  TEST_ASSERT_EQUAL_UINT8(100, get3DTableValue(&overlayTable1, 50, 2000));
+  TEST_ASSERT_EQUAL_UINT8(110, get3DTableValue(&overlayTable2, 50, 2000));
+
+  clearTableOverlays();
+  TEST_ASSERT_EQUAL_UINT8(0, tableOverlayCount);
+  TEST_ASSERT_EQUAL_UINT8(100, get3DTableValue(&overlayTable2, 50, 2000));
+}
+
+static void test_overlay_full(void)
+{
+  setup_overlay_tables();
+  //The overlay is a different size on each board, so fill it from a table with a cell for every entry
+  static table3d_value_t fullValues[TABLE3D_OVERLAY_SIZE];
+  table3DGetValueCache fullCache;
+  for (uint8_t cell = 0; cell < TABLE3D_OVERLAY_SIZE; ++cell)
+  {
+    TEST_ASSERT_TRUE(setTableOverlay(&fullCache, fullValues, 2, cell, 1));
+  }
+  TEST_ASSERT_FALSE(setTableOverlay(&overlayTable2, 2, 15, 1));
+  TEST_ASSERT_EQUAL_UINT8(TABLE3D_OVERLAY_SIZE, tableOverlayCount);
+  //Cells that are already in the overlay can still be changed
+  TEST_ASSERT_TRUE(setTableOverlay(&fullCache, fullValues, 2, 0, 5));
+  TEST_ASSERT_EQUAL_INT8(5, getTableOverlay(fullValues, 0));
+  clearTableOverlays();
+}
+
+static void test_overlay_apply(void)
+{
+  setup_overlay_tables();
+  setTableOverlay(&overlayTable1, 2, OVERLAY_CELL, 20);
+  setTableOverlay(&overlayTable2, 3, OVERLAY_CELL, -10);
+  TEST_ASSERT_EQUAL_UINT8(120, get3DTableValue(&overlayTable1, 50, 2000));
+
+  TEST_ASSERT_EQUAL_HEX16((1U << 2) | (1U << 3), applyTableOverlays());
+  TEST_ASSERT_EQUAL_UINT8(0, tableOverlayCount);
+  TEST_ASSERT_EQUAL_UINT8(120, overlayTable1.values.value_at(OVERLAY_CELL));
+  TEST_ASSERT_EQUAL_UINT8(90, overlayTable2.values.value_at(OVERLAY_CELL));
+  //The deltas are now in the tables, so the lookups don't change
+  TEST_ASSERT_EQUAL_UINT8(120, get3DTableValue(&overlayTable1, 50, 2000));
+  TEST_ASSERT_EQUAL_UINT8(90, get3DTableValue(&overlayTable2, 50, 2000));
+
+  TEST_ASSERT_EQUAL_HEX16(0, applyTableOverlays());
+}
+
+void testTable3dOverlay()
+{
+  SET_UNITY_FILENAME() {
+    RUN_TEST_P(test_overlay_lookup);
+    RUN_TEST_P(test_overlay_lookup_context);
+    RUN_TEST_P(test_overlay_clamp);
+    RUN_TEST_P(test_overlay_remove);
+    RUN_TEST_P(test_overlay_full);
+    RUN_TEST_P(test_overlay_apply);
+  }
+}
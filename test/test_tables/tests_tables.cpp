@@ -72,6 +72,8 @@ void testTables()
   RUN_TEST(test_tableLookup_underMinX);
   RUN_TEST(test_tableLookup_underMinY);
   RUN_TEST(test_tableLookup_roundUp);
+  RUN_TEST(test_tableLookupContext_matchesLookup);
+  RUN_TEST(test_tableLookupContext_sharedAxes);
   //RUN_TEST(test_all_incrementing);
 
   }  
@@ -167,6 +169,51 @@ void test_tableLookup_roundUp(void)
   TEST_ASSERT_EQUAL(testTable.get_value_cache.lastYBinMax, (table3d_dim_t)14);
 }
 
+void test_tableLookupContext_matchesLookup(void)
+{
+  //Interpolating via a lookup context must give exactly the same result as a regular lookup
+  setup_TestTable();
+
+  static constexpr table3d_axis_t loads[] = { yMin-5, 17, 38, 48, 53, 73, yMax+10 };
+  static constexpr table3d_axis_t rpms[] = { xMin-100, 600, 2250, 3100, 4000, xMax+100 };
+  for (uint8_t loadIdx=0; loadIdx<_countof(loads); ++loadIdx)
+  {
+    for (uint8_t rpmIdx=0; rpmIdx<_countof(rpms); ++rpmIdx)
+    {
+      table3DLookupContext lookup;
+      get3DTableLookupContext(&testTable, loads[loadIdx], rpms[rpmIdx], lookup);
+      TEST_ASSERT_EQUAL(get3DTableValue(&testTable, loads[loadIdx], rpms[rpmIdx]), interpolate3DTableValue(&testTable, lookup));
+    }
+  }
+}
+
+void test_tableLookupContext_sharedAxes(void)
+{
+  //A context from one table can be used to interpolate another table with the same dimensions
+  setup_TestTable();
+  static table3d16RpmLoad offsetTable;
+  populate_table_P(offsetTable, tempXAxis, tempYAxis, values);
+  table_value_iterator itZ = offsetTable.values.begin();
+  while (!itZ.at_end())
+  {
+    table_row_iterator itRow = *itZ;
+    while (!itRow.at_end())
+    {
+      *itRow = *itRow + 10U;
+      ++itRow;
+    }
+    ++itZ;
+  }
+
+  table3DLookupContext lookup;
+  get3DTableLookupContext(&testTable, 53, 2250, lookup);
+  TEST_ASSERT_EQUAL(69, interpolate3DTableValue(&testTable, lookup));
+  TEST_ASSERT_EQUAL(79, interpolate3DTableValue(&offsetTable, lookup));
+  //The bin cache is shared with get3DTableValue()
+  TEST_ASSERT_EQUAL(testTable.get_value_cache.lastXBinMax, (table3d_dim_t)9);
+  TEST_ASSERT_EQUAL(testTable.get_value_cache.lastYBinMax, (table3d_dim_t)8);
+}
+
 void test_all_incrementing(void)
 {
   //Test the when going up both the load and RPM axis that the returned value is always equal or higher to the previous one
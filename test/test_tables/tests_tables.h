@@ -9,3 +9,5 @@ void test_tableLookup_underMinX(void);
 void test_tableLookup_underMinY(void);
 void test_tableLookup_roundUp(void);
 void test_all_incrementing(void);
+void test_tableLookupContext_matchesLookup(void);
+void test_tableLookupContext_sharedAxes(void);
@@ -0,0 +1,183 @@
+#include <unity.h>
+#include "globals.h"
+#include "TS_CommandButtonHandler.h"
+#include "../test_utils.h"
+
+static void drainCommandQueue(void)
+{
+    while(getTSCommandQueueCount() > 0U) { processTSCommandQueue(UINT16_MAX); }
+}
+
+static void setup_commandQueue(void)
+{
+    drainCommandQueue();
+    currentStatus.RPM = 0;
+    currentStatus.vss = 0; //VSS ratio commands do nothing without a speed reading
+    currentStatus.tsCommandStatus = 0;
+    currentStatus.testOutputs = 0;
+    HWTest_INJ_Pulsed = 0;
+    HWTest_IGN_Pulsed = 0;
+}
+
+static void test_commandQueue_deferred(void)
+{
+    setup_commandQueue();
+
+    TEST_ASSERT_TRUE(TS_CommandButtonsHandler(TS_CMD_TEST_ENBL));
+    //Nothing is run until the queue is processed
+    TEST_ASSERT_BIT_LOW(1, currentStatus.testOutputs);
+    TEST_ASSERT_EQUAL_UINT8(1, getTSCommandQueueCount());
+    TEST_ASSERT_BIT_HIGH(TS_CMD_STATUS_BUSY, currentStatus.tsCommandStatus);
+
+    processTSCommandQueue(TS_CMD_LOOP_BUDGET);
+    TEST_ASSERT_BIT_HIGH(1, currentStatus.testOutputs);
+    TEST_ASSERT_EQUAL_UINT8(0, getTSCommandQueueCount());
+    TEST_ASSERT_BIT_LOW(TS_CMD_STATUS_BUSY, currentStatus.tsCommandStatus);
+    TEST_ASSERT_BIT_HIGH(TS_CMD_STATUS_DONE, currentStatus.tsCommandStatus);
+    TEST_ASSERT_BIT_LOW(TS_CMD_STATUS_FAILED, currentStatus.tsCommandStatus);
+}
+
+static void test_commandQueue_order(void)
+{
+    setup_commandQueue();
+
+    TEST_ASSERT_TRUE(TS_CommandButtonsHandler(TS_CMD_TEST_ENBL));
+    TEST_ASSERT_TRUE(TS_CommandButtonsHandler(TS_CMD_INJ1_PULSED));
+    TEST_ASSERT_TRUE(TS_CommandButtonsHandler(TS_CMD_IGN2_PULSED));
+    TEST_ASSERT_TRUE(TS_CommandButtonsHandler(TS_CMD_INJ1_OFF));
+    drainCommandQueue();
+
+    //Test mode must have been enabled before the pulsed commands, and the injector turned off after being pulsed
+    TEST_ASSERT_BIT_LOW(INJ1_CMD_BIT, HWTest_INJ_Pulsed);
+    TEST_ASSERT_BIT_HIGH(IGN2_CMD_BIT, HWTest_IGN_Pulsed);
+
+    TEST_ASSERT_TRUE(TS_CommandButtonsHandler(TS_CMD_TEST_DSBL));
+    drainCommandQueue();
+    TEST_ASSERT_EQUAL_UINT8(0, HWTest_IGN_Pulsed);
+    TEST_ASSERT_BIT_LOW(1, currentStatus.testOutputs);
+}
+
+static void test_commandQueue_reject_unknown(void)
+{
+    setup_commandQueue();
+
+    TEST_ASSERT_FALSE(TS_CommandButtonsHandler(1234));
+    TEST_ASSERT_EQUAL_UINT8(0, getTSCommandQueueCount());
+    TEST_ASSERT_BIT_HIGH(TS_CMD_STATUS_FAILED, currentStatus.tsCommandStatus);
+    TEST_ASSERT_BIT_LOW(TS_CMD_STATUS_BUSY, currentStatus.tsCommandStatus);
+}
+
+static void test_commandQueue_reject_engineRunning(void)
+{
+    setup_commandQueue();
+    currentStatus.RPM = 1000;
+
+    TEST_ASSERT_FALSE(TS_CommandButtonsHandler(TS_CMD_TEST_ENBL));
+    TEST_ASSERT_EQUAL_UINT8(0, getTSCommandQueueCount());
+    TEST_ASSERT_BIT_HIGH(TS_CMD_STATUS_FAILED, currentStatus.tsCommandStatus);
+
+    //Commands that do not need the engine stopped are still accepted
+    TEST_ASSERT_TRUE(TS_CommandButtonsHandler(TS_CMD_VSS_RATIO1));
+    drainCommandQueue();
+}
+
+static void test_commandQueue_fail_engineStartedWhileQueued(void)
+{
+    setup_commandQueue();
+
+    TEST_ASSERT_TRUE(TS_CommandButtonsHandler(TS_CMD_TEST_ENBL));
+    currentStatus.RPM = 1000;
+    processTSCommandQueue(TS_CMD_LOOP_BUDGET);
+
+    TEST_ASSERT_BIT_LOW(1, currentStatus.testOutputs);
+    TEST_ASSERT_EQUAL_UINT8(0, getTSCommandQueueCount());
+    TEST_ASSERT_BIT_HIGH(TS_CMD_STATUS_FAILED, currentStatus.tsCommandStatus);
+    TEST_ASSERT_BIT_LOW(TS_CMD_STATUS_DONE, currentStatus.tsCommandStatus);
+}
+
+static void test_commandQueue_full(void)
+{
+    setup_commandQueue();
+
+    for(uint8_t x = 0; x < TS_CMD_QUEUE_SIZE; x++)
+    {
+        TEST_ASSERT_TRUE(TS_CommandButtonsHandler(TS_CMD_VSS_RATIO1));
+    }
+    TEST_ASSERT_FALSE(TS_CommandButtonsHandler(TS_CMD_VSS_RATIO1));
+    TEST_ASSERT_EQUAL_UINT8(TS_CMD_QUEUE_SIZE, getTSCommandQueueCount());
+    TEST_ASSERT_BIT_HIGH(TS_CMD_STATUS_BUSY, currentStatus.tsCommandStatus);
+
+    drainCommandQueue();
+    //Queue space is available again
+    TEST_ASSERT_TRUE(TS_CommandButtonsHandler(TS_CMD_VSS_RATIO1));
+    drainCommandQueue();
+}
+
+static void test_commandQueue_minimumProgress(void)
+{
+    setup_commandQueue();
+
+    TEST_ASSERT_TRUE(TS_CommandButtonsHandler(TS_CMD_TEST_ENBL));
+    TEST_ASSERT_TRUE(TS_CommandButtonsHandler(TS_CMD_INJ1_PULSED));
+    TEST_ASSERT_TRUE(TS_CommandButtonsHandler(TS_CMD_TEST_DSBL));
+
+    //With no time budget, a single command is still run on each call
+    processTSCommandQueue(0);
+    TEST_ASSERT_EQUAL_UINT8(2, getTSCommandQueueCount());
+    processTSCommandQueue(0);
+    TEST_ASSERT_EQUAL_UINT8(1, getTSCommandQueueCount());
+    processTSCommandQueue(0);
+    TEST_ASSERT_EQUAL_UINT8(0, getTSCommandQueueCount());
+}
+
+// Simulates TS clicking buttons during a series of main loops and measures how long each loop is stalled by the
+// command processing. Neither queueing (Done in the serial command processing) nor the per loop processing should stall
+// the loop for significantly longer than the budget.
+static void test_commandQueue_loopStall(void)
+{
+    setup_commandQueue();
+
+    static constexpr uint16_t commands[] = { TS_CMD_TEST_ENBL, TS_CMD_INJ1_PULSED, TS_CMD_INJ2_PULSED, TS_CMD_IGN1_PULSED, TS_CMD_IGN2_PULSED,
+                                             TS_CMD_INJ1_OFF, TS_CMD_INJ2_OFF, TS_CMD_IGN1_OFF, TS_CMD_IGN2_OFF, TS_CMD_TEST_DSBL };
+    static constexpr uint16_t MAX_STEP_TIME = 100; //The longest any of the above commands should take to run (uS)
+    uint32_t maxQueueTime = 0;
+    uint32_t maxProcessTime = 0;
+    uint8_t commandIndex = 0;
+    uint8_t loops = 0;
+
+    while( ((commandIndex < _countof(commands)) || (getTSCommandQueueCount() > 0U)) && (loops < 100U) )
+    {
+        //2 button clicks arrive per loop
+        for(uint8_t click = 0; (click < 2U) && (commandIndex < _countof(commands)); click++)
+        {
+            uint32_t startTime = micros();
+            TEST_ASSERT_TRUE(TS_CommandButtonsHandler(commands[commandIndex]));
+            maxQueueTime = max(maxQueueTime, micros() - startTime);
+            commandIndex++;
+        }
+
+        uint32_t startTime = micros();
+        processTSCommandQueue(TS_CMD_LOOP_BUDGET);
+        maxProcessTime = max(maxProcessTime, micros() - startTime);
+        loops++;
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(0, getTSCommandQueueCount());
+    TEST_ASSERT_BIT_HIGH(TS_CMD_STATUS_DONE, currentStatus.tsCommandStatus);
+    TEST_ASSERT_LESS_THAN_UINT32(MAX_STEP_TIME, maxQueueTime);
+    TEST_ASSERT_LESS_THAN_UINT32(TS_CMD_LOOP_BUDGET + MAX_STEP_TIME, maxProcessTime);
+}
+
+void testCommandQueue(void)
+{
+    SET_UNITY_FILENAME() {
+        RUN_TEST_P(test_commandQueue_deferred);
+        RUN_TEST_P(test_commandQueue_order);
+        RUN_TEST_P(test_commandQueue_reject_unknown);
+        RUN_TEST_P(test_commandQueue_reject_engineRunning);
+        RUN_TEST_P(test_commandQueue_fail_engineStartedWhileQueued);
+        RUN_TEST_P(test_commandQueue_full);
+        RUN_TEST_P(test_commandQueue_minimumProgress);
+        RUN_TEST_P(test_commandQueue_loopStall);
+    }
+}
@@ -0,0 +1,209 @@
+#include <unity.h>
+#include "globals.h"
+#include "comms.h"
+#include "comms_legacy.h"
+#include "../test_utils.h"
+
+// A port with a receive queue that the test fills, and a transmit buffer with a settable amount of free space
+class SessionStream : public Stream
+{
+public:
+    void begin(uint16_t space)
+    {
+        rxHead = 0;
+        rxTail = 0;
+        received = 0;
+        freeSpace = space;
+    }
+
+    void feed(const byte *buffer, uint16_t length)
+    {
+        for(uint16_t x = 0; x < length; x++) { rx[rxTail++] = buffer[x]; }
+    }
+
+    int available(void) override { return rxTail - rxHead; }
+    int read(void) override { return (rxHead < rxTail) ? rx[rxHead++] : -1; }
+    int peek(void) override { return (rxHead < rxTail) ? rx[rxHead] : -1; }
+    int availableForWrite(void) override { return freeSpace; }
+
+    size_t write(uint8_t value) override
+    {
+        if(freeSpace == 0U) { return 0; }
+        if(received < sizeof(data)) { data[received] = value; }
+        received++;
+        freeSpace--;
+        return 1;
+    }
+    using Print::write;
+
+    byte rx[64];
+    uint16_t rxHead;
+    uint16_t rxTail;
+    byte data[64];
+    uint16_t received;
+    uint16_t freeSpace;
+};
+
+static SessionStream portA;
+static SessionStream portB;
+static SerialStatus statusA;
+static SerialStatus statusB;
+static byte payloadA[32];
+static byte payloadB[32];
+static void noLegacyCommand(void) { TEST_FAIL_MESSAGE("Legacy command"); }
+static comms_session_t sessionA = { &portA, &statusA, payloadA, sizeof(payloadA), &noLegacyCommand, 0, 0, 0, 0, FastCRC32() };
+static comms_session_t sessionB = { &portB, &statusB, payloadB, sizeof(payloadB), &noLegacyCommand, 0, 0, 0, 0, FastCRC32() };
+
+/** Builds a frame of the new protocol: 2 byte length, the payload, then its CRC32. Returns the frame length */
+static uint16_t buildFrame(const byte *payload, uint16_t length, byte *frame)
+{
+    FastCRC32 crc;
+    uint32_t payloadCrc = crc.crc32(payload, length);
+    frame[0] = highByte(length);
+    frame[1] = lowByte(length);
+    memcpy(&frame[2], payload, length);
+    frame[length + 2U] = (byte)(payloadCrc >> 24);
+    frame[length + 3U] = (byte)(payloadCrc >> 16);
+    frame[length + 4U] = (byte)(payloadCrc >> 8);
+    frame[length + 5U] = (byte)payloadCrc;
+    return length + 6U;
+}
+
+/** Checks that a port has sent one complete frame with a good CRC, and returns the length of its payload */
+static uint16_t checkResponseFrame(const SessionStream &port)
+{
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT16(7, port.received);
+    uint16_t length = word(port.data[0], port.data[1]);
+    TEST_ASSERT_EQUAL_UINT16(length + 6U, port.received);
+    byte frame[sizeof(port.data)];
+    (void)buildFrame(&port.data[2], length, frame);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(frame, port.data, port.received);
+    return length;
+}
+
+static void resetSessions(void)
+{
+    portA.begin(UINT8_MAX);
+    portB.begin(UINT8_MAX);
+    statusA = SERIAL_INACTIVE;
+    statusB = SERIAL_INACTIVE;
+    BIT_CLEAR(currentStatus.status4, BIT_STATUS4_ALLOW_LEGACY_COMMS);
+}
+
+static void test_sessions_interleavedReceive(void)
+{
+    resetSessions();
+    byte frameA[16];
+    byte frameB[16];
+    const byte commandA[] = { 'Q' };
+    const byte commandB[] = { 'C' };
+    uint16_t lengthA = buildFrame(commandA, sizeof(commandA), frameA);
+    uint16_t lengthB = buildFrame(commandB, sizeof(commandB), frameB);
+
+    //Part of a command arrives on A, then a whole command on B
+    portA.feed(frameA, 4);
+    serialReceive(sessionA);
+    TEST_ASSERT_EQUAL(SERIAL_RECEIVE_INPROGRESS, statusA);
+    portB.feed(frameB, lengthB);
+    serialReceive(sessionB);
+    TEST_ASSERT_EQUAL(SERIAL_INACTIVE, statusB);
+
+    //B has answered its own command, and A is still waiting for the rest of its one
+    TEST_ASSERT_EQUAL_UINT16(2, checkResponseFrame(portB));
+    TEST_ASSERT_EQUAL_HEX8(0x00, portB.data[2]);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, portB.data[3]);
+    TEST_ASSERT_EQUAL_UINT16(0, portA.received);
+    TEST_ASSERT_EQUAL(SERIAL_RECEIVE_INPROGRESS, statusA);
+
+    portA.feed(&frameA[4], lengthA - 4U);
+    serialReceive(sessionA);
+    TEST_ASSERT_EQUAL(SERIAL_INACTIVE, statusA);
+    checkResponseFrame(portA);
+    TEST_ASSERT_EQUAL_HEX8('s', portA.data[3]); //Code version
+}
+
+static void test_sessions_concurrentTransmit(void)
+{
+    resetSessions();
+    byte frame[16];
+    const byte commandA[] = { 'Q' };
+    const byte commandB[] = { 'F' };
+
+    //Neither port can take the whole response at once
+    portA.begin(5);
+    portB.begin(3);
+    portA.feed(frame, buildFrame(commandA, sizeof(commandA), frame));
+    serialReceive(sessionA);
+    portB.feed(frame, buildFrame(commandB, sizeof(commandB), frame));
+    serialReceive(sessionB);
+    TEST_ASSERT_EQUAL(SERIAL_TRANSMIT_INPROGRESS, statusA);
+    TEST_ASSERT_EQUAL(SERIAL_TRANSMIT_INPROGRESS, statusB);
+    TEST_ASSERT_EQUAL_UINT16(5, portA.received);
+    TEST_ASSERT_EQUAL_UINT16(3, portB.received);
+
+    //Each is finished by its own transmit pump, a few bytes at a time
+    uint8_t calls = 0;
+    while( ((statusA != SERIAL_INACTIVE) || (statusB != SERIAL_INACTIVE)) && (calls < 50U) )
+    {
+        portA.freeSpace = 3;
+        portB.freeSpace = 2;
+        serialTransmit(sessionA);
+        serialTransmit(sessionB);
+        calls++;
+    }
+    TEST_ASSERT_EQUAL(SERIAL_INACTIVE, statusA);
+    TEST_ASSERT_EQUAL(SERIAL_INACTIVE, statusB);
+    checkResponseFrame(portA);
+    TEST_ASSERT_EQUAL_HEX8('s', portA.data[3]);
+    TEST_ASSERT_EQUAL_UINT16(4, checkResponseFrame(portB));
+    TEST_ASSERT_EQUAL_HEX8('2', portB.data[5]); //Serial protocol version 002
+}
+
+static void test_sessions_crcError(void)
+{
+    resetSessions();
+    byte frameA[16];
+    byte frameB[16];
+    const byte command[] = { 'C' };
+    uint16_t lengthA = buildFrame(command, sizeof(command), frameA);
+    uint16_t lengthB = buildFrame(command, sizeof(command), frameB);
+    frameB[lengthB - 1U] ^= 0xFFU;
+
+    //A bad command on B is rejected without affecting the command A is receiving
+    portA.feed(frameA, 3);
+    serialReceive(sessionA);
+    portB.feed(frameB, lengthB);
+    serialReceive(sessionB);
+    TEST_ASSERT_EQUAL_UINT16(1, checkResponseFrame(portB));
+    TEST_ASSERT_EQUAL_HEX8(0x82, portB.data[2]); //CRC error
+
+    portA.feed(&frameA[3], lengthA - 3U);
+    serialReceive(sessionA);
+    TEST_ASSERT_EQUAL_UINT16(2, checkResponseFrame(portA));
+    TEST_ASSERT_EQUAL_HEX8(0xFF, portA.data[3]);
+}
+
+static void test_sessions_commandTooLong(void)
+{
+    resetSessions();
+    //A command that doesn't fit in the session buffer is read to the end and rejected, rather than overrunning the buffer
+    byte payload[sizeof(payloadA) + 8U];
+    memset(payload, 'M', sizeof(payload));
+    byte frame[sizeof(payload) + 6U];
+    portA.feed(frame, buildFrame(payload, sizeof(payload), frame));
+    serialReceive(sessionA);
+    TEST_ASSERT_EQUAL(SERIAL_INACTIVE, statusA);
+    TEST_ASSERT_EQUAL_INT(0, portA.available());
+    TEST_ASSERT_EQUAL_UINT16(1, checkResponseFrame(portA));
+    TEST_ASSERT_EQUAL_HEX8(0x84, portA.data[2]); //Range error
+}
+
+void testCommsSessions(void)
+{
+    SET_UNITY_FILENAME() {
+        RUN_TEST_P(test_sessions_interleavedReceive);
+        RUN_TEST_P(test_sessions_concurrentTransmit);
+        RUN_TEST_P(test_sessions_crcError);
+        RUN_TEST_P(test_sessions_commandTooLong);
+    }
+}
@@ -0,0 +1,126 @@
+#include <unity.h>
+#include "globals.h"
+#include "comms_dash.h"
+#include "comms_secondary.h"
+#include "comms_CAN.h"
+#include "../test_utils.h"
+
+// A port that keeps everything written to it, with a settable amount of transmit buffer space
+class CaptureStream : public Stream
+{
+public:
+    void begin(uint16_t space)
+    {
+        freeSpace = space;
+        received = 0;
+    }
+
+    int available(void) override { return 0; }
+    int read(void) override { return -1; }
+    int peek(void) override { return -1; }
+    int availableForWrite(void) override { return freeSpace; }
+
+    size_t write(uint8_t value) override
+    {
+        if(freeSpace == 0U) { return 0; }
+        if(received < sizeof(data)) { data[received] = value; }
+        received++;
+        freeSpace--;
+        return 1;
+    }
+    using Print::write;
+
+    uint8_t data[REALDASH_FRAME_SIZE * 8U];
+    uint16_t received;
+    uint16_t freeSpace;
+};
+
+static CaptureStream capture;
+
+static void encodeDashMessage(uint16_t id, byte *buffer)
+{
+    dash_frame_t frame;
+    buildDashMessage(id, frame);
+    encodeRealDashFrame(frame, buffer);
+}
+
+static void test_realDash_encodeHaltechData1(void)
+{
+    currentStatus.RPM = 3000;
+    currentStatus.MAP = 100;
+    currentStatus.TPS = 50;
+    const byte expected[REALDASH_FRAME_SIZE] = { 0x44, 0x33, 0x22, 0x11, 0x60, 0x03, 0x00, 0x00, 0x0B, 0xB8, 0x03, 0xE8, 0x00, 0xFA, 0x00, 0x00 };
+    byte buffer[REALDASH_FRAME_SIZE];
+    encodeDashMessage(CAN_HALTECH_DATA1, buffer);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, buffer, REALDASH_FRAME_SIZE);
+}
+
+static void test_realDash_encodeShortFrame(void)
+{
+    //The BMW DME4 frame only has 5 bytes, the rest are sent as 0
+    currentStatus.coolant = 90;
+    const byte expected[REALDASH_FRAME_SIZE] = { 0x44, 0x33, 0x22, 0x11, 0x45, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7E, 0x00, 0x00, 0x00 };
+    byte buffer[REALDASH_FRAME_SIZE];
+    memset(buffer, 0xFF, sizeof(buffer));
+    encodeDashMessage(CAN_BMW_DME4, buffer);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, buffer, REALDASH_FRAME_SIZE);
+}
+
+static void test_dashMessageIDs(void)
+{
+    uint16_t ids[DASH_FRAMES_PER_RATE_MAX];
+    TEST_ASSERT_EQUAL_UINT8(4, getDashMessageIDs(CAN_BROADCAST_PROTOCOL_HALTECH, 50, ids));
+    TEST_ASSERT_EQUAL_HEX16(CAN_HALTECH_DATA1, ids[0]);
+    TEST_ASSERT_EQUAL_HEX16(CAN_HALTECH_PW, ids[3]);
+    TEST_ASSERT_EQUAL_UINT8(1, getDashMessageIDs(CAN_BROADCAST_PROTOCOL_BMW, 10, ids));
+    TEST_ASSERT_EQUAL_HEX16(CAN_BMW_DME4, ids[0]);
+    TEST_ASSERT_EQUAL_UINT8(0, getDashMessageIDs(CAN_BROADCAST_PROTOCOL_VAG, 50, ids));
+    TEST_ASSERT_EQUAL_UINT8(0, getDashMessageIDs(CAN_BROADCAST_PROTOCOL_OFF, 30, ids));
+}
+
+static void test_realDash_stream(void)
+{
+    configPage9.enable_secondarySerial = 1;
+    configPage9.secondarySerialProtocol = SECONDARY_SERIAL_PROTO_REALDASH_CAN;
+    configPage4.CANBroadcastProtocol = CAN_BROADCAST_PROTOCOL_HALTECH;
+    configPage2.stoich = 147;
+
+    //A frame that is already waiting is not queued again
+    secondserial_queueDashFrames(50);
+    secondserial_queueDashFrames(50);
+    secondserial_queueDashFrames(15);
+
+    //Only whole frames are written, and only if they fit without blocking
+    capture.begin((REALDASH_FRAME_SIZE * 2U) + 10U);
+    secondserial_sendDashFrames(capture);
+    TEST_ASSERT_EQUAL_UINT16(REALDASH_FRAME_SIZE * 2U, capture.received);
+    TEST_ASSERT_EQUAL_HEX8(0x60, capture.data[4]); //DATA1
+    TEST_ASSERT_EQUAL_HEX8(0x61, capture.data[REALDASH_FRAME_SIZE + 4U]); //DATA2
+
+    capture.begin(UINT8_MAX);
+    secondserial_sendDashFrames(capture);
+    TEST_ASSERT_EQUAL_UINT16(REALDASH_FRAME_SIZE * 5U, capture.received);
+    TEST_ASSERT_EQUAL_HEX8(0x62, capture.data[4]); //DATA3
+    TEST_ASSERT_EQUAL_HEX8(0x70, capture.data[(REALDASH_FRAME_SIZE * 4U) + 4U]); //VSS
+
+    //Nothing left
+    capture.begin(UINT8_MAX);
+    secondserial_sendDashFrames(capture);
+    TEST_ASSERT_EQUAL_UINT16(0, capture.received);
+
+    //Nothing is queued when another protocol is selected
+    configPage9.secondarySerialProtocol = SECONDARY_SERIAL_PROTO_GENERIC_FIXED;
+    secondserial_queueDashFrames(50);
+    secondserial_sendDashFrames(capture);
+    TEST_ASSERT_EQUAL_UINT16(0, capture.received);
+}
+
+void testDashFrames(void)
+{
+    SET_UNITY_FILENAME() {
+        RUN_TEST_P(test_realDash_encodeHaltechData1);
+        RUN_TEST_P(test_realDash_encodeShortFrame);
+        RUN_TEST_P(test_dashMessageIDs);
+        RUN_TEST_P(test_realDash_stream);
+    }
+}
@@ -0,0 +1,93 @@
+#include <unity.h>
+#include "globals.h"
+#include "logger.h"
+#include "../test_utils.h"
+
+// Every byte of the packet must belong to the channel that the byte table says it does
+static void test_outputChannels_byteTable(void)
+{
+    uint16_t channelBytes = 0;
+    for(uint16_t byteNum = 0; byteNum < LOG_CHANNEL_BYTES; byteNum++)
+    {
+        const log_channel_t &channel = logChannels[pgm_read_byte(&logChannelBytes[byteNum])];
+        uint8_t offset = pgm_read_byte(&channel.offset);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT16(byteNum, offset);
+        TEST_ASSERT_GREATER_THAN_UINT16(byteNum, offset + pgm_read_byte(&channel.size));
+    }
+    for(uint8_t x = 0; x < LOG_CHANNEL_COUNT; x++) { channelBytes += pgm_read_byte(&logChannels[x].size); }
+    TEST_ASSERT_EQUAL_UINT16(LOG_ENTRY_SIZE, channelBytes);
+}
+
+static void test_outputChannels_tsLogEntry(void)
+{
+    currentStatus.MAP = 0x1234;
+    currentStatus.IAT = -20;
+    currentStatus.AEamount = 300;
+    currentStatus.boostDuty = 5678;
+    currentStatus.rpmDOT = -2;
+    TEST_ASSERT_EQUAL_HEX8(0x34, getTSLogEntry(4));
+    TEST_ASSERT_EQUAL_HEX8(0x12, getTSLogEntry(5));
+    TEST_ASSERT_EQUAL_UINT8(20, getTSLogEntry(6)); //Offset by CALIBRATION_TEMPERATURE_OFFSET
+    TEST_ASSERT_EQUAL_UINT8(150, getTSLogEntry(16)); //Halved
+    TEST_ASSERT_EQUAL_UINT8(56, getTSLogEntry(31)); //Divided by 100
+    TEST_ASSERT_EQUAL_HEX8(0xFE, getTSLogEntry(33));
+    TEST_ASSERT_EQUAL_HEX8(0xFF, getTSLogEntry(34));
+    TEST_ASSERT_EQUAL_UINT8(0, getTSLogEntry(LOG_CHANNEL_BYTES));
+
+    currentStatus.loopsPerSecond = 70000;
+    (void)getTSLogEntry(26);
+    TEST_ASSERT_EQUAL_UINT32(60000, currentStatus.loopsPerSecond);
+}
+
+static void test_outputChannels_readableLogEntry(void)
+{
+    currentStatus.IAT = -20;
+    currentStatus.AEamount = 300;
+    currentStatus.PW1 = 4321;
+    TEST_ASSERT_EQUAL_INT16(-20, getReadableLogEntry(5)); //No offset
+    TEST_ASSERT_EQUAL_INT16(300, getReadableLogEntry(14)); //Not halved
+    TEST_ASSERT_EQUAL_INT16(4321, getReadableLogEntry(53));
+    TEST_ASSERT_EQUAL_INT16(0, getReadableLogEntry(59)); //Unused field
+    TEST_ASSERT_EQUAL_INT16(0, getReadableLogEntry(LOG_READABLE_FIELDS));
+}
+
+static void test_outputChannels_is2ByteEntry(void)
+{
+    TEST_ASSERT_TRUE(is2ByteEntry(4));
+    TEST_ASSERT_FALSE(is2ByteEntry(5));
+    TEST_ASSERT_FALSE(is2ByteEntry(6));
+    TEST_ASSERT_TRUE(is2ByteEntry(135));
+    TEST_ASSERT_FALSE(is2ByteEntry(LOG_CHANNEL_BYTES));
+}
+
+static void test_outputChannels_liveSnapshot(void)
+{
+    currentStatus.MAP = 0x1234;
+    currentStatus.IAT = -20;
+    currentStatus.rpmDOT = -2;
+    expireLiveSnapshot();
+    const live_snapshot_t &snapshot = getLiveSnapshot();
+    for(uint16_t byteNum = 0; byteNum < LOG_CHANNEL_BYTES; byteNum++) { TEST_ASSERT_EQUAL_HEX8(getTSLogEntry(byteNum), snapshot.values[byteNum]); }
+    TEST_ASSERT_EQUAL_UINT8(0, getLiveSnapshotEntry(LOG_CHANNEL_BYTES));
+
+    //Every request in the same loop gets the same values, even if they change in between
+    currentStatus.MAP = 0x5678;
+    TEST_ASSERT_EQUAL_HEX8(0x34, getLiveSnapshotEntry(4));
+    TEST_ASSERT_EQUAL_HEX8(0x12, getLiveSnapshotEntry(5));
+
+    //A new loop takes a new snapshot
+    expireLiveSnapshot();
+    TEST_ASSERT_EQUAL_HEX8(0x78, getLiveSnapshotEntry(4));
+    TEST_ASSERT_EQUAL_HEX8(0x56, getLiveSnapshotEntry(5));
+}
+
+void testOutputChannels(void)
+{
+    SET_UNITY_FILENAME() {
+        RUN_TEST_P(test_outputChannels_byteTable);
+        RUN_TEST_P(test_outputChannels_tsLogEntry);
+        RUN_TEST_P(test_outputChannels_readableLogEntry);
+        RUN_TEST_P(test_outputChannels_is2ByteEntry);
+        RUN_TEST_P(test_outputChannels_liveSnapshot);
+    }
+}
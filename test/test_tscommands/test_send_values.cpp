@@ -0,0 +1,154 @@
+#include <unity.h>
+#include "globals.h"
+#include "comms.h"
+#include "comms_legacy.h"
+#include "logger.h"
+#include "../test_utils.h"
+
+// A UART with a transmit FIFO that drains at the baud rate (10 bits per byte), as measured by micros()
+class MockUart : public Stream
+{
+public:
+    void begin(uint32_t baud, uint8_t fifoSize)
+    {
+        bytesPerSec = baud / 10UL;
+        fifoLength = fifoSize;
+        queued = 0;
+        received = 0;
+        blockWrites = 0;
+        fullWrites = 0;
+        lastDrain = micros();
+    }
+
+    int available(void) override { return 0; }
+    int read(void) override { return -1; }
+    int peek(void) override { return -1; }
+    int availableForWrite(void) override { drain(); return fifoLength - queued; }
+
+    size_t write(uint8_t value) override
+    {
+        drain();
+        if(queued >= fifoLength) { fullWrites++; return 0; } //A real UART would block here
+        if(received < sizeof(data)) { data[received] = value; }
+        received++;
+        queued++;
+        return 1;
+    }
+    size_t write(const uint8_t *buffer, size_t size) override
+    {
+        blockWrites++;
+        size_t written = 0;
+        while( (written < size) && (write(buffer[written]) == 1U) ) { written++; }
+        return written;
+    }
+
+    uint8_t waiting(void) { drain(); return queued; }
+
+    uint8_t data[LOG_ENTRY_SIZE];
+    uint16_t received;
+    uint16_t blockWrites;
+    uint16_t fullWrites;
+
+private:
+    void drain(void)
+    {
+        uint32_t now = micros();
+        if(queued == 0U) { lastDrain = now; return; }
+        uint32_t elapsed = min(now - lastDrain, 100000UL);
+        uint32_t sent = (elapsed * (bytesPerSec / 100UL)) / 10000UL;
+        if(sent == 0U) { return; }
+        if(sent >= queued) { queued = 0; lastDrain = now; }
+        else
+        {
+            queued -= (uint8_t)sent;
+            lastDrain += (sent * 10000UL) / (bytesPerSec / 100UL);
+        }
+    }
+
+    uint32_t bytesPerSec;
+    uint32_t lastDrain;
+    uint8_t fifoLength;
+    uint8_t queued;
+};
+
+static MockUart mockUart;
+
+static uint8_t testLogEntry(uint16_t byteNum) { return (uint8_t)((byteNum * 7U) + 3U); }
+
+struct sendValuesRun {
+    uint32_t totalMicros; ///< From the request until the last byte has left the UART
+    uint32_t maxCallMicros; ///< The longest that any call stopped the main loop for
+    uint16_t calls;
+};
+
+static sendValuesRun runSendValues(uint32_t baud)
+{
+    sendValuesRun run = { 0, 0, 0 };
+    SerialStatus status = SERIAL_INACTIVE;
+    mockUart.begin(baud, 64);
+
+    uint32_t startTime = micros();
+    sendValues(0, LOG_ENTRY_SIZE, 0x31, mockUart, status, &testLogEntry);
+    run.maxCallMicros = micros() - startTime;
+    run.calls = 1;
+    while(status == SERIAL_TRANSMIT_INPROGRESS_LEGACY)
+    {
+        uint32_t callTime = micros();
+        sendValuesContinue(status);
+        run.maxCallMicros = max(run.maxCallMicros, micros() - callTime);
+        run.calls++;
+    }
+    while(mockUart.waiting() > 0U) { }
+    run.totalMicros = micros() - startTime;
+
+    TEST_ASSERT_EQUAL(SERIAL_INACTIVE, status);
+    TEST_ASSERT_EQUAL_UINT16(LOG_ENTRY_SIZE, mockUart.received);
+    for(uint16_t x = 0; x < LOG_ENTRY_SIZE; x++) { TEST_ASSERT_EQUAL_UINT8(testLogEntry(x), mockUart.data[x]); }
+    TEST_ASSERT_EQUAL_UINT16(0, mockUart.fullWrites); //Nothing was written that would have had to wait
+
+    char msg[96];
+    sprintf_P(msg, PSTR("%" PRIu32 " baud: %" PRIu32 " bytes/S, longest call %" PRIu32 "uS, %" PRIu16 " calls, %" PRIu16 " block writes"),
+        baud, (uint32_t)(((uint32_t)LOG_ENTRY_SIZE * 1000000UL) / run.totalMicros), run.maxCallMicros, run.calls, mockUart.blockWrites);
+    TEST_MESSAGE(msg);
+    return run;
+}
+
+static void test_sendValues_115200(void)
+{
+    sendValuesRun run = runSendValues(115200UL);
+    //The packet is larger than the FIFO, so it must have been sent over several calls in blocks rather than a byte at a time
+    TEST_ASSERT_GREATER_THAN_UINT16(1, run.calls);
+    TEST_ASSERT_LESS_THAN_UINT16(LOG_ENTRY_SIZE, mockUart.blockWrites);
+    //No call may wait for the 73 bytes that don't fit in the FIFO to be sent (~6mS)
+    TEST_ASSERT_LESS_THAN_UINT32(3000UL, run.maxCallMicros);
+    //Close to the line rate of 11520 bytes/S
+    TEST_ASSERT_LESS_THAN_UINT32(((uint32_t)LOG_ENTRY_SIZE * 1000000UL) / 10000UL, run.totalMicros);
+}
+
+static void test_sendValues_1M(void)
+{
+    sendValuesRun run = runSendValues(1000000UL);
+    TEST_ASSERT_LESS_THAN_UINT16(LOG_ENTRY_SIZE, mockUart.blockWrites);
+    TEST_ASSERT_LESS_THAN_UINT32(3000UL, run.maxCallMicros);
+}
+
+static void test_sendValues_clamped(void)
+{
+    //A request for more values than the buffer can hold is cut short rather than overrunning it
+    SerialStatus status = SERIAL_INACTIVE;
+    mockUart.begin(1000000UL, 64);
+    sendValues(0, UINT16_MAX, 0x31, mockUart, status, &testLogEntry);
+    while(status == SERIAL_TRANSMIT_INPROGRESS_LEGACY) { sendValuesContinue(status); }
+    uint16_t bufferSize;
+    (void)getSerialPayloadBuffer(bufferSize);
+    TEST_ASSERT_EQUAL_UINT16(bufferSize, mockUart.received);
+}
+
+void testSendValues(void)
+{
+    SET_UNITY_FILENAME() {
+        RUN_TEST_P(test_sendValues_115200);
+        RUN_TEST_P(test_sendValues_1M);
+        RUN_TEST_P(test_sendValues_clamped);
+    }
+}